@@ -897,8 +897,10 @@ def mk_hpp_from_pyg(pyg_file, output_dir):
         out.write('  %s(params_ref const & _p = params_ref::get_empty()):\n' % class_name)
         out.write('     p(_p)')
         if export:
-            out.write(', g(gparams::get_module("%s"))' % module_name)
+            out.write(', g(module_params())')
         out.write(' {}\n')
+        if export:
+            out.write('  static params_ref const & module_params() { static thread_local gparams::module_snapshot s; return gparams::get_module(s, "%s"); }\n' % module_name)
         out.write('  static void collect_param_descrs(param_descrs & d) {\n')
         for param in params:
             out.write('    d.insert("%s", %s, "%s", "%s","%s");\n' % (param[0], TYPE2CPK[param[1]], param[3], pyg_default(param), module_name))
@@ -342,6 +342,10 @@ def Z3_set_error_handler(ctx, hndlr, _elems=Elementaries(_lib.Z3_set_error_handl
 def Z3_solver_register_on_clause(ctx, s, user_ctx, on_clause_eh, _elems = Elementaries(_lib.Z3_solver_register_on_clause)):
     _elems.f(ctx, s, user_ctx, on_clause_eh)
     _elems.Check(ctx)
+
+def Z3_solver_register_stats_callback(ctx, s, interval_ms, user_ctx, stats_eh, _elems = Elementaries(_lib.Z3_solver_register_stats_callback)):
+    _elems.f(ctx, s, interval_ms, user_ctx, stats_eh)
+    _elems.Check(ctx)
     
 def Z3_solver_propagate_init(ctx, s, user_ctx, push_eh, pop_eh, fresh_eh, _elems = Elementaries(_lib.Z3_solver_propagate_init)):
     _elems.f(ctx, s, user_ctx, push_eh, pop_eh, fresh_eh)
@@ -363,6 +367,10 @@ def Z3_solver_propagate_diseq(ctx, s, diseq_eh, _elems = Elementaries(_lib.Z3_so
     _elems.f(ctx, s, diseq_eh)
     _elems.Check(ctx)
 
+def Z3_solver_propagate_batch(ctx, s, batch_eh, _elems = Elementaries(_lib.Z3_solver_propagate_batch)):
+    _elems.f(ctx, s, batch_eh)
+    _elems.Check(ctx)
+
 def Z3_optimize_register_model_eh(ctx, o, m, user_ctx, on_model_eh, _elems = Elementaries(_lib.Z3_optimize_register_model_eh)):
     _elems.f(ctx, o, m, user_ctx, on_model_eh)
     _elems.Check(ctx)
@@ -1066,6 +1074,11 @@ def def_API(name, result, params):
                 log_c.write(" }\n")
                 log_c.write("  Au(%s);\n" % sz_e)
                 exe_c.write("in.get_uint_array(%s)" % i)
+            elif ty == UINT64:
+                log_c.write("U(0);")
+                log_c.write(" }\n")
+                log_c.write("  Au(%s);\n" % sz_e)
+                exe_c.write("in.get_uint64_array(%s)" % i)
             else:
                 error ("unsupported parameter for %s, %s" % (name, p))
         elif kind == OUT_MANAGED_ARRAY:
@@ -1318,9 +1331,11 @@ z3_ml_callbacks = frozenset([
     'Z3_solver_propagate_final',
     'Z3_solver_propagate_eq',
     'Z3_solver_propagate_diseq',
+    'Z3_solver_propagate_batch',
     'Z3_solver_propagate_created',
     'Z3_solver_propagate_decide',
-    'Z3_solver_register_on_clause'
+    'Z3_solver_register_on_clause',
+    'Z3_solver_register_stats_callback'
     ])
 
 def mk_ml(ml_src_dir, ml_output_dir):
@@ -1850,6 +1865,7 @@ _lib.Z3_set_error_handler.restype  = None
 _lib.Z3_set_error_handler.argtypes = [ContextObj, _error_handler_type]
 
 Z3_on_clause_eh = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p)
+Z3_stats_eh = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p)
 Z3_push_eh  = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p)
 Z3_pop_eh   = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint)
 Z3_fresh_eh = ctypes.CFUNCTYPE(ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p)
@@ -1857,15 +1873,18 @@ Z3_fresh_eh = ctypes.CFUNCTYPE(ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p
 Z3_fixed_eh = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p)
 Z3_final_eh = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p)
 Z3_eq_eh    = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p)
+Z3_batch_eh = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint, ctypes.POINTER(ctypes.c_void_p), ctypes.POINTER(ctypes.c_void_p), ctypes.c_uint, ctypes.POINTER(ctypes.c_void_p), ctypes.POINTER(ctypes.c_void_p))
 
 Z3_created_eh = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p)
 Z3_decide_eh = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p)
 
 _lib.Z3_solver_register_on_clause.restype = None
+_lib.Z3_solver_register_stats_callback.restype = None
 _lib.Z3_solver_propagate_init.restype = None
 _lib.Z3_solver_propagate_final.restype = None
 _lib.Z3_solver_propagate_fixed.restype = None
 _lib.Z3_solver_propagate_eq.restype = None
+_lib.Z3_solver_propagate_batch.restype = None
 _lib.Z3_solver_propagate_diseq.restype = None
 _lib.Z3_solver_propagate_decide.restype = None
 
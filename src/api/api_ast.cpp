@@ -18,6 +18,7 @@ Revision History:
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
 #include "api/api_util.h"
+#include "api/api_ast_vector.h"
 #include "ast/well_sorted.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -29,6 +30,7 @@ Revision History:
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_smt_pp.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/canonical_hash.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/rewriter/var_subst.h"
 #include "ast/rewriter/expr_safe_replace.h"
@@ -189,6 +191,51 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_ast_vector Z3_API Z3_mk_ast_batch(Z3_context c,
+                                         unsigned num_decls, Z3_func_decl const decls[],
+                                         unsigned num_inputs, Z3_ast const inputs[],
+                                         unsigned code_size, unsigned const code[]) {
+        Z3_TRY;
+        LOG_Z3_mk_ast_batch(c, num_decls, decls, num_inputs, inputs, code_size, code);
+        RESET_ERROR_CODE();
+        for (unsigned i = 0; i < num_inputs; ++i) {
+            CHECK_IS_EXPR(inputs[i], nullptr);
+        }
+        unsigned num_nodes = num_inputs;
+        for (unsigned pc = 0; pc < code_size; pc += 2 + code[pc + 1], ++num_nodes) {
+            if (pc + 2 > code_size || code[pc] >= num_decls || code[pc + 1] > code_size - pc - 2) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "malformed batch code");
+                RETURN_Z3(nullptr);
+            }
+            for (unsigned j = 0; j < code[pc + 1]; ++j) {
+                if (code[pc + 2 + j] >= num_nodes) {
+                    SET_ERROR_CODE(Z3_IOB, "batch code refers to a node that is not yet created");
+                    RETURN_Z3(nullptr);
+                }
+            }
+        }
+        ast_manager& m = mk_c(c)->m();
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), m);
+        mk_c(c)->save_object(v);
+        ptr_buffer<expr> nodes, args;
+        for (unsigned i = 0; i < num_inputs; ++i) 
+            nodes.push_back(to_expr(inputs[i]));
+        for (unsigned pc = 0; pc < code_size; ) {
+            func_decl* d = to_func_decl(decls[code[pc]]);
+            unsigned n = code[pc + 1];
+            args.reset();
+            for (unsigned j = 0; j < n; ++j) 
+                args.push_back(nodes[code[pc + 2 + j]]);
+            pc += 2 + n;
+            app* a = m.mk_app(d, n, args.data());
+            v->m_ast_vector.push_back(a);
+            check_sorts(c, a);
+            nodes.push_back(a);
+        }
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_ast Z3_API Z3_mk_const(Z3_context c, Z3_symbol s, Z3_sort ty) {
         Z3_TRY;
         LOG_Z3_mk_const(c, s, ty);
@@ -394,6 +441,18 @@ extern "C" {
         return to_ast(a)->hash();
     }
 
+    void Z3_API Z3_get_canonical_hash(Z3_context c, Z3_ast a, uint64_t* lo, uint64_t* hi) {
+        Z3_TRY;
+        LOG_Z3_get_canonical_hash(c, a, lo, hi);
+        RESET_ERROR_CODE();
+        CHECK_IS_EXPR(a, );
+        canonical_hash ch(mk_c(c)->m());
+        hash128 h = ch(to_expr(a));
+        *lo = h.m_lo;
+        *hi = h.m_hi;
+        Z3_CATCH;
+    }
+
     bool Z3_API Z3_is_app(Z3_context c, Z3_ast a) {
         LOG_Z3_is_app(c, a);
         RESET_ERROR_CODE();
@@ -21,6 +21,8 @@ Revision History:
 #include "api/api_ast_vector.h"
 #include "ast/ast_translation.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_binary.h"
+#include <fstream>
 
 extern "C" {
 
@@ -73,6 +75,22 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    void Z3_API Z3_ast_vector_to_array(Z3_context c, Z3_ast_vector v, unsigned sz, Z3_ast result[]) {
+        Z3_TRY;
+        LOG_Z3_ast_vector_to_array(c, v, sz, result);
+        RESET_ERROR_CODE();
+        ast_ref_vector const& vec = to_ast_vector_ref(v);
+        if (sz != vec.size()) {
+            SET_ERROR_CODE(Z3_IOB, nullptr);
+            return;
+        }
+        // Remark: Don't need to invoke save_object.
+        for (unsigned i = 0; i < sz; ++i)
+            result[i] = of_ast(vec.get(i));
+        RETURN_Z3_ast_vector_to_array;
+        Z3_CATCH;
+    }
+
     void Z3_API Z3_ast_vector_set(Z3_context c, Z3_ast_vector v, unsigned i, Z3_ast a) {
         Z3_TRY;
         LOG_Z3_ast_vector_set(c, v, i, a);
@@ -135,4 +153,27 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    void Z3_API Z3_ast_vector_serialize(Z3_context c, Z3_ast_vector v, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_ast_vector_serialize(c, v, file_name);
+        RESET_ERROR_CODE();
+        ptr_vector<expr> es;
+        for (ast * a : to_ast_vector_ref(v)) {
+            if (!is_expr(a)) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "ast vector contains non-expressions");
+                return;
+            }
+            es.push_back(to_expr(a));
+        }
+        std::ofstream out(file_name, std::ios::binary);
+        if (!out) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        ast_binary_write(mk_c(c)->m(), es.size(), es.data(), out);
+        if (!out)
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+        Z3_CATCH;
+    }
+
 };
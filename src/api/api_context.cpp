@@ -54,10 +54,8 @@ namespace api {
         if (!o)
             return;
 #ifndef SINGLE_THREAD
-        if (m_concurrent_dec_ref) {
-            lock_guard lock(m_mux);
-            m_objects_to_flush.push_back(o);
-        }
+        if (m_concurrent_dec_ref)
+            defer_dec_ref(nullptr, o);
         else
 #endif
         {
@@ -69,35 +67,48 @@ namespace api {
 
     void context::dec_ref(ast* a) {
 #ifndef SINGLE_THREAD
-        if (m_concurrent_dec_ref) {
-            lock_guard lock(m_mux);
-            m_asts_to_flush.push_back(a);
-        }
+        if (m_concurrent_dec_ref)
+            defer_dec_ref(a, nullptr);
         else
 #endif
             m().dec_ref(a);
     }
 
-    void context::flush_objects() {
+#ifndef SINGLE_THREAD
+    void context::defer_dec_ref(ast* a, api::object* o) {
+        deferred_dec_ref* d = alloc(deferred_dec_ref);
+        d->m_ast = a;
+        d->m_obj = o;
+        d->m_next = m_to_flush.load(std::memory_order_relaxed);
+        while (!m_to_flush.compare_exchange_weak(d->m_next, d, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+#endif
+
+    void context::flush_objects(bool all) {
 #ifndef SINGLE_THREAD
         if (!m_concurrent_dec_ref)
-            return;        
-        {
-            lock_guard lock(m_mux);
-            if (m_asts_to_flush.empty() && m_objects_to_flush.empty())
-                return;
-            m_asts_to_flush2.swap(m_asts_to_flush);
-            m_objects_to_flush2.swap(m_objects_to_flush);
-        }
-        for (ast* a : m_asts_to_flush2)
-            m().dec_ref(a);
-        for (auto* o : m_objects_to_flush2) {
-            m_free_object_ids.push_back(o->id());
-            m_allocated_objects.remove(o->id());
-            dealloc(o);
+            return;
+        unsigned n = 0;
+        while (all || n < m_flush_batch) {
+            if (!m_flushing) {
+                if (!m_to_flush.load(std::memory_order_relaxed))
+                    return;
+                m_flushing = m_to_flush.exchange(nullptr, std::memory_order_acquire);
+            }
+            for (; m_flushing && (all || n < m_flush_batch); ++n) {
+                deferred_dec_ref* d = m_flushing;
+                m_flushing = d->m_next;
+                if (d->m_ast)
+                    m().dec_ref(d->m_ast);
+                if (d->m_obj) {
+                    m_free_object_ids.push_back(d->m_obj->id());
+                    m_allocated_objects.remove(d->m_obj->id());
+                    dealloc(d->m_obj);
+                }
+                dealloc(d);
+            }
         }
-        m_objects_to_flush2.reset();
-        m_asts_to_flush2.reset();
 #endif
     }
 
@@ -107,7 +118,7 @@ namespace api {
     }
 
     context::add_plugins::add_plugins(ast_manager & m) {
-        reg_decl_plugins(m);
+        reg_decl_plugins(m, true);
     }
 
     // ------------------------
@@ -122,11 +133,7 @@ namespace api {
         m_manager(m_params.mk_ast_manager()),
         m_plugins(m()),
         m_arith_util(m()),
-        m_bv_util(m()),
         m_datalog_util(m()),
-        m_fpa_util(m()),
-        m_sutil(m()),
-        m_recfun(m()),
         m_ast_trail(m()),
         m_pmanager(m_limit) {
 
@@ -144,7 +151,6 @@ namespace api {
         m_seq_fid   = m().mk_family_id("seq");
 	    m_char_fid   = m().mk_family_id("char");
         m_special_relations_fid   = m().mk_family_id("specrels");
-        m_dt_plugin = static_cast<datatype_decl_plugin*>(m().get_plugin(m_dt_fid));
     
         install_tactics(*this);
     }
@@ -154,7 +160,7 @@ namespace api {
         if (m_parser)
             smt2::free_parser(m_parser);
         m_last_obj = nullptr;
-        flush_objects();
+        flush_objects(true);
         for (auto& kv : m_allocated_objects) {
             api::object* val = kv.m_value;
             DEBUG_CODE(if (!m_concurrent_dec_ref) warning_msg("Uncollected memory: %d: %s", kv.m_key, typeid(*val).name()););
@@ -224,7 +230,7 @@ namespace api {
             e = m_arith_util.mk_numeral(n, s);
         }
         else if (fid == m_bv_fid) {
-            e = m_bv_util.mk_numeral(n, s);
+            e = bvutil().mk_numeral(n, s);
         }
         else if (fid == get_datalog_fid() && n.is_uint64()) {
             uint64_t sz;
@@ -89,19 +89,30 @@ namespace api {
         mutex                      m_mux;
 
         arith_util                 m_arith_util;
-        bv_util                    m_bv_util;
         datalog::dl_decl_util      m_datalog_util;
-        fpa_util                   m_fpa_util;
-        seq_util                   m_sutil;
-        recfun::util               m_recfun;
+        // the plugins are registered lazily, the utilities that fetch
+        // their plugin on construction are created on first use.
+        scoped_ptr<bv_util>        m_bv_util;
+        scoped_ptr<fpa_util>       m_fpa_util;
+        scoped_ptr<seq_util>       m_sutil;
+        scoped_ptr<recfun::util>   m_recfun;
 
         // Support for old solver API
         smt_params                 m_fparams;
         // -------------------------------
 
 #ifndef SINGLE_THREAD
-        ptr_vector<ast>            m_asts_to_flush, m_asts_to_flush2;
-        ptr_vector<api::object>    m_objects_to_flush, m_objects_to_flush2;
+        // dec_refs from other threads are pushed on a lock-free stack and
+        // performed by the thread that owns the context, in batches.
+        struct deferred_dec_ref {
+            ast*               m_ast;
+            api::object*       m_obj;
+            deferred_dec_ref*  m_next;
+        };
+        std::atomic<deferred_dec_ref*> m_to_flush { nullptr };
+        deferred_dec_ref*          m_flushing = nullptr;  // taken from m_to_flush, not yet performed
+        static const unsigned      m_flush_batch = 1 << 14;
+        void defer_dec_ref(ast* a, api::object* o);
 #endif
 
         ast_ref_vector             m_ast_trail;        
@@ -118,7 +129,6 @@ namespace api {
         family_id                  m_seq_fid;
         family_id                  m_char_fid;
         family_id                  m_special_relations_fid;
-        datatype_decl_plugin *     m_dt_plugin;
         
         std::string                m_string_buffer; // temporary buffer used to cache strings sent to the "external" world.
 
@@ -157,12 +167,12 @@ namespace api {
         unsigned get_timeout() const { return m_params.m_timeout; }
         unsigned get_rlimit() const { return m_params.rlimit(); }
         arith_util & autil() { return m_arith_util; }
-        bv_util & bvutil() { return m_bv_util; }
+        bv_util & bvutil() { if (!m_bv_util) m_bv_util = alloc(bv_util, m()); return *m_bv_util; }
         datalog::dl_decl_util & datalog_util() { return m_datalog_util; }
-        fpa_util & fpautil() { return m_fpa_util; }
-        datatype_util& dtutil() { return m_dt_plugin->u(); }
-        seq_util& sutil() { return m_sutil; }
-        recfun::util& recfun() { return m_recfun; }
+        fpa_util & fpautil() { if (!m_fpa_util) m_fpa_util = alloc(fpa_util, m()); return *m_fpa_util; }
+        datatype_util& dtutil() { return get_dt_plugin()->u(); }
+        seq_util& sutil() { if (!m_sutil) m_sutil = alloc(seq_util, m()); return *m_sutil; }
+        recfun::util& recfun() { if (!m_recfun) m_recfun = alloc(recfun::util, m()); return *m_recfun; }
         family_id get_basic_fid() const { return basic_family_id; }
         family_id get_array_fid() const { return m_array_fid; }
         family_id get_arith_fid() const { return arith_family_id; }
@@ -173,7 +183,7 @@ namespace api {
         family_id get_fpa_fid() const { return m_fpa_fid; }
         family_id get_seq_fid() const { return m_seq_fid; }
         family_id get_char_fid() const { return m_char_fid; }
-        datatype_decl_plugin * get_dt_plugin() const { return m_dt_plugin; }
+        datatype_decl_plugin * get_dt_plugin() const { return static_cast<datatype_decl_plugin*>(m().get_plugin(m_dt_fid)); }
         family_id get_special_relations_fid() const { return m_special_relations_fid; }
 
         Z3_error_code get_error_code() const { return m_error_code; }
@@ -192,7 +202,12 @@ namespace api {
         unsigned add_object(api::object* o);
         void del_object(api::object* o);
         void dec_ref(ast* a);
-        void flush_objects();
+        /**
+           \brief perform dec_refs deferred by other threads. At most a batch
+           is performed unless all is true, so a large backlog is worked off
+           over several API calls.
+         */
+        void flush_objects(bool all = false);
 
         Z3_ast_print_mode get_print_mode() const { return m_print_mode; }
         void set_print_mode(Z3_ast_print_mode m) { m_print_mode = m; }
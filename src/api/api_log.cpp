@@ -22,7 +22,11 @@ Revision History:
 #include "util/util.h"
 #include "util/z3_version.h"
 #include "util/mutex.h"
+#include "util/writeback_stream.h"
 
+// Records are not flushed one by one: the log is written in large blocks
+// by a background thread, and flushed when it is closed or the process exits.
+static std::ofstream * g_z3_log_file = nullptr;
 static std::ostream * g_z3_log = nullptr;
 atomic<bool> g_z3_log_enabled;
 
@@ -73,12 +77,12 @@ std::ostream & operator<<(std::ostream & out, ll_escaped const & d) {
 }
 }
 
-void R()              { *g_z3_log << 'R' << std::endl; }
-void P(void * obj)    { *g_z3_log << "P " << obj <<std::endl; }
-void I(int64_t i)     { *g_z3_log << "I " << i << std::endl; }
-void U(uint64_t u)    { *g_z3_log << "U " << u << std::endl; }
-void D(double d)      { *g_z3_log << "D " << d << std::endl; }
-void S(Z3_string str) { *g_z3_log << "S \"" << ll_escaped{str} << '"' << std::endl; }
+void R()              { *g_z3_log << 'R' << '\n'; }
+void P(void * obj)    { *g_z3_log << "P " << obj  << '\n'; }
+void I(int64_t i)     { *g_z3_log << "I " << i << '\n'; }
+void U(uint64_t u)    { *g_z3_log << "U " << u << '\n'; }
+void D(double d)      { *g_z3_log << "D " << d << '\n'; }
+void S(Z3_string str) { *g_z3_log << "S \"" << ll_escaped{str} << '"' << '\n'; }
 void Sy(Z3_symbol sym) {
     symbol s = symbol::c_api_ext2symbol(sym);
     if (s.is_null()) {
@@ -90,14 +94,14 @@ void Sy(Z3_symbol sym) {
     else {
         *g_z3_log << "$ |" << ll_escaped{s.str().c_str()} << '|';
     }
-    *g_z3_log << std::endl;
+    *g_z3_log << '\n';
 }
-void Ap(unsigned sz)  { *g_z3_log << "p " << sz << std::endl; }
-void Au(unsigned sz)  { *g_z3_log << "u " << sz << std::endl; }
-void Ai(unsigned sz)  { *g_z3_log << "i " << sz << std::endl; }
-void Asy(unsigned sz) { *g_z3_log << "s " << sz << std::endl; }
-void C(unsigned id)   { *g_z3_log << "C " << id << std::endl; }
-static void _Z3_append_log(char const * msg) { *g_z3_log << "M \"" << ll_escaped{msg} << '"' << std::endl; }
+void Ap(unsigned sz)  { *g_z3_log << "p " << sz << '\n'; }
+void Au(unsigned sz)  { *g_z3_log << "u " << sz << '\n'; }
+void Ai(unsigned sz)  { *g_z3_log << "i " << sz << '\n'; }
+void Asy(unsigned sz) { *g_z3_log << "s " << sz << '\n'; }
+void C(unsigned id)   { *g_z3_log << "C " << id << '\n'; }
+static void _Z3_append_log(char const * msg) { *g_z3_log << "M \"" << ll_escaped{msg} << '"' << '\n'; }
 
 void ctx_enable_logging() {
     SCOPED_LOCK();
@@ -109,10 +113,19 @@ static void Z3_close_log_unsafe(void) {
     if (g_z3_log != nullptr) {
         g_z3_log_enabled = false;
         dealloc(g_z3_log);
+        dealloc(g_z3_log_file);
         g_z3_log = nullptr;
+        g_z3_log_file = nullptr;
     }
 }
 
+namespace {
+    struct log_finalizer {
+        ~log_finalizer() { Z3_close_log_unsafe(); }
+    };
+    log_finalizer g_log_finalizer;
+}
+
 extern "C" {
     bool Z3_API Z3_open_log(Z3_string filename) {
         bool res;
@@ -120,13 +133,14 @@ extern "C" {
         SCOPED_LOCK();
         Z3_close_log_unsafe();
 
-        g_z3_log = alloc(std::ofstream, filename);
-        if (g_z3_log->bad() || g_z3_log->fail()) {
-            dealloc(g_z3_log);
-            g_z3_log = nullptr;
+        g_z3_log_file = alloc(std::ofstream, filename);
+        if (g_z3_log_file->bad() || g_z3_log_file->fail()) {
+            dealloc(g_z3_log_file);
+            g_z3_log_file = nullptr;
             res = false;
         }
         else {
+            g_z3_log = alloc(writeback_ostream, *g_z3_log_file);
             *g_z3_log << "V \"" << Z3_MAJOR_VERSION << "." << Z3_MINOR_VERSION << "." << Z3_BUILD_NUMBER << "." << Z3_REVISION_NUMBER << '"' << std::endl;
             res = true;
         }
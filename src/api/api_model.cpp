@@ -20,8 +20,11 @@ Revision History:
 #include "api/api_context.h"
 #include "api/api_model.h"
 #include "api/api_ast_vector.h"
+#include "ast/arith_decl_plugin.h"
 #include "ast/array_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
 #include "model/model.h"
+#include "model/model_batch_evaluator.h"
 #include "model/model_v2_pp.h"
 #include "model/model_smt2_pp.h"
 #include "model/model_params.hpp"
@@ -121,6 +124,29 @@ extern "C" {
         }
         Z3_CATCH_RETURN(nullptr);
     }
+
+    void Z3_API Z3_model_get_const_interps(Z3_context c, Z3_model m, unsigned num_consts, Z3_func_decl decls[], Z3_ast values[]) {
+        Z3_TRY;
+        LOG_Z3_model_get_const_interps(c, m, num_consts, decls, values);
+        RESET_ERROR_CODE();
+        if (!m) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "model is null");
+            return;
+        }
+        model * _m = to_model_ref(m);
+        if (num_consts != _m->get_num_constants()) {
+            SET_ERROR_CODE(Z3_IOB, nullptr);
+            return;
+        }
+        // Remark: the declarations and values are owned by the model.
+        for (unsigned i = 0; i < num_consts; ++i) {
+            func_decl * f = _m->get_constant(i);
+            decls[i] = of_func_decl(f);
+            values[i] = of_expr(_m->get_const_interp(f));
+        }
+        RETURN_Z3_model_get_const_interps;
+        Z3_CATCH;
+    }
     
     unsigned Z3_API Z3_model_get_num_funcs(Z3_context c, Z3_model m) {
         Z3_TRY;
@@ -172,6 +198,77 @@ extern "C" {
         Z3_CATCH_RETURN(false);
     }
 
+    Z3_ast_vector Z3_API Z3_model_eval_batch(Z3_context c, unsigned num_models, Z3_model const models[], Z3_ast t, bool model_completion) {
+        Z3_TRY;
+        LOG_Z3_model_eval_batch(c, num_models, models, t, model_completion);
+        RESET_ERROR_CODE();
+        CHECK_IS_EXPR(t, nullptr);
+        params_ref p;
+        ast_manager& mgr = mk_c(c)->m();
+        ptr_buffer<model> mdls;
+        for (unsigned i = 0; i < num_models; ++i) {
+            CHECK_NON_NULL(models[i], nullptr);
+            model * _m = to_model_ref(models[i]);
+            if (!_m->has_solver()) {
+                _m->set_solver(alloc(api::seq_expr_solver, mgr, p));
+            }
+            mdls.push_back(_m);
+        }
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), mgr);
+        mk_c(c)->save_object(v);
+        model_batch_evaluator ev(mgr, to_expr(t));
+        expr_ref_vector vals(mgr);
+        ev(mdls.size(), mdls.data(), model_completion, vals);
+        for (expr* val : vals)
+            v->m_ast_vector.push_back(val);
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
+    bool Z3_API Z3_model_eval_to_uint64_array(Z3_context c, Z3_model m, unsigned num_terms, Z3_ast const terms[], bool model_completion, uint64_t values[]) {
+        Z3_TRY;
+        LOG_Z3_model_eval_to_uint64_array(c, m, num_terms, terms, model_completion, values);
+        RESET_ERROR_CODE();
+        CHECK_NON_NULL(m, false);
+        for (unsigned i = 0; i < num_terms; ++i) {
+            CHECK_IS_EXPR(terms[i], false);
+        }
+        model * _m = to_model_ref(m);
+        params_ref p;
+        ast_manager& mgr = mk_c(c)->m();
+        if (!_m->has_solver()) {
+            _m->set_solver(alloc(api::seq_expr_solver, mgr, p));
+        }
+        arith_util a(mgr);
+        bv_util bv(mgr);
+        model::scoped_model_completion _scm(*_m, model_completion);
+        expr_ref val(mgr);
+        rational r;
+        unsigned sz;
+        bool all_values = true;
+        for (unsigned i = 0; i < num_terms; ++i) {
+            expr * t = to_expr(terms[i]);
+            // assigned constants are looked up directly, other terms go through the evaluator
+            expr * v = is_uninterp_const(t) ? _m->get_const_interp(to_app(t)->get_decl()) : nullptr;
+            if (!v) {
+                val = (*_m)(t);
+                v = val;
+            }
+            if (mgr.is_true(v))
+                values[i] = 1;
+            else if (mgr.is_false(v))
+                values[i] = 0;
+            else if ((bv.is_numeral(v, r, sz) || (a.is_numeral(v, r) && r.is_int())) && r.is_uint64())
+                values[i] = r.get_uint64();
+            else {
+                values[i] = 0;
+                all_values = false;
+            }
+        }
+        return all_values;
+        Z3_CATCH_RETURN(false);
+    }
+
     unsigned Z3_API Z3_model_get_num_sorts(Z3_context c, Z3_model m) {
         Z3_TRY;
         LOG_Z3_model_get_num_sorts(c, m);
@@ -24,6 +24,7 @@ Revision History:
 #include "smt/smt_solver.h"
 #include "smt/smt2_extra_cmds.h"
 #include "parsers/smt2/smt2parser.h"
+#include "ast/ast_binary.h"
 #include "solver/solver_na2as.h"
 #include "muz/fp/dl_cmds.h"
 #include "opt/opt_cmds.h"
@@ -216,7 +217,7 @@ extern "C" {
                                         Z3_func_decl const decls[]) {
         Z3_TRY;
         LOG_Z3_parse_smtlib2_string(c, file_name, num_sorts, sort_names, sorts, num_decls, decl_names, decls);
-        std::ifstream is(file_name);
+        std::ifstream is(file_name, std::ios::in | std::ios::binary);
         if (!is) {
             SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
             return nullptr;
@@ -226,6 +227,26 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_ast_vector Z3_API Z3_parse_binary(Z3_context c, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_parse_binary(c, file_name);
+        RESET_ERROR_CODE();
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), mk_c(c)->m());
+        mk_c(c)->save_object(v);
+        expr_ref_vector fmls(mk_c(c)->m());
+        try {
+            ast_binary_read_file(mk_c(c)->m(), file_name, fmls);
+        }
+        catch (z3_exception & ex) {
+            SET_ERROR_CODE(Z3_PARSER_ERROR, ex.msg());
+            return of_ast_vector(v);
+        }
+        for (expr * e : fmls)
+            v->m_ast_vector.push_back(e);
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_string Z3_API Z3_eval_smtlib2_string(Z3_context c, Z3_string str) {
         std::stringstream ous;
         Z3_TRY;
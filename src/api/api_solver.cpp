@@ -135,6 +135,13 @@ extern "C" {
         m_solver->assert_expr(e);
     }
 
+    void Z3_solver_ref::assert_expr(unsigned n, expr * const * es) {
+        if (m_pp) 
+            for (unsigned i = 0; i < n; ++i) 
+                m_pp->assert_expr(es[i]);
+        m_solver->assert_expr(n, es);
+    }
+
     void Z3_solver_ref::assert_expr(expr * e, expr* t) {
         if (m_pp) m_pp->assert_expr(e, t);
         m_solver->assert_expr(e, t);
@@ -248,6 +255,21 @@ extern "C" {
     }
 
 
+    Z3_solver Z3_API Z3_solver_fork(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_fork(c, s);
+        RESET_ERROR_CODE();
+        params_ref const& p = to_solver(s)->m_params; 
+        Z3_solver_ref * sr = alloc(Z3_solver_ref, *mk_c(c), nullptr);
+        init_solver(c, s);
+        sr->m_solver = to_solver(s)->m_solver->fork(p);
+        mk_c(c)->save_object(sr);
+        Z3_solver r = of_solver(sr);
+        init_solver_log(c, r);
+        RETURN_Z3(r);
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     void Z3_API Z3_solver_import_model_converter(Z3_context c, Z3_solver src, Z3_solver dst) {
         Z3_TRY;
         LOG_Z3_solver_import_model_converter(c, src, dst);
@@ -467,6 +489,7 @@ extern "C" {
         Z3_TRY;
         LOG_Z3_solver_reset(c, s);
         RESET_ERROR_CODE();
+        to_solver(s)->m_cube_generator = nullptr;
         to_solver(s)->m_solver = nullptr;
         if (to_solver(s)->m_pp) to_solver(s)->m_pp->reset();
         Z3_CATCH;
@@ -491,6 +514,22 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_solver_assert_vector(Z3_context c, Z3_solver s, Z3_ast_vector v) {
+        Z3_TRY;
+        LOG_Z3_solver_assert_vector(c, s, v);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        ast_ref_vector const& fmls = to_ast_vector_ref(v);
+        for (ast* a : fmls) {
+            if (!is_expr(a) || !mk_c(c)->m().is_bool(to_expr(a))) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "Boolean expression expected");
+                return;
+            }
+        }
+        to_solver(s)->assert_expr(fmls.size(), (expr* const*) fmls.data());
+        Z3_CATCH;
+    }
+
     void Z3_API Z3_solver_assert_and_track(Z3_context c, Z3_solver s, Z3_ast a, Z3_ast p) {
         Z3_TRY;
         LOG_Z3_solver_assert_and_track(c, s, a, p);
@@ -572,6 +611,40 @@ extern "C" {
         Z3_CATCH;
     }
 
+    Z3_ast_vector Z3_API Z3_solver_export_hints(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_export_hints(c, s);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), mk_c(c)->m());
+        mk_c(c)->save_object(v);
+        expr_ref_vector hints(mk_c(c)->m());
+        to_solver_ref(s)->get_hints(hints);
+        for (expr* h : hints) {
+            v->m_ast_vector.push_back(h);
+        }
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
+    void Z3_API Z3_solver_import_hints(Z3_context c, Z3_solver s, Z3_ast_vector hints) {
+        Z3_TRY;
+        LOG_Z3_solver_import_hints(c, s, hints);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        ast_manager& m = mk_c(c)->m();
+        expr_ref_vector _hints(m);
+        for (ast* a : to_ast_vector_ref(hints)) {
+            if (!is_expr(a) || !m.is_bool(to_expr(a))) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "hints must be Boolean expressions");
+                return;
+            }
+            _hints.push_back(to_expr(a));
+        }
+        to_solver_ref(s)->set_hints(_hints);
+        Z3_CATCH;
+    }
+
     Z3_ast_vector Z3_API Z3_solver_get_trail(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_trail(c, s);
@@ -743,6 +816,8 @@ extern "C" {
         init_solver(c, s);
         Z3_stats_ref * st = alloc(Z3_stats_ref, *mk_c(c));
         to_solver_ref(s)->collect_statistics(st->m_stats);
+        if (to_solver(s)->m_cube_generator)
+            to_solver(s)->m_cube_generator->collect_statistics(st->m_stats);
         get_memory_statistics(st->m_stats);
         get_rlimit_statistics(mk_c(c)->m().limit(), st->m_stats);
         to_solver_ref(s)->collect_timer_stats(st->m_stats);
@@ -903,6 +978,79 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_ast_vector Z3_API Z3_solver_next_cube(Z3_context c, Z3_solver s, Z3_ast_vector vs) {
+        Z3_TRY;
+        LOG_Z3_solver_next_cube(c, s, vs);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        ast_manager& m = mk_c(c)->m();
+        expr_ref_vector cube(m);
+        if (!to_solver(s)->m_cube_generator) {
+            expr_ref_vector vars(m);
+            for (ast* a : to_ast_vector_ref(vs)) {
+                if (!is_expr(a)) {
+                    SET_ERROR_CODE(Z3_INVALID_USAGE, "cube contains a non-expression");
+                    RETURN_Z3(nullptr);
+                }
+                vars.push_back(to_expr(a));
+            }
+            to_solver(s)->m_cube_generator = alloc(cube_generator, *to_solver_ref(s), vars);
+        }
+        unsigned timeout     = to_solver(s)->m_params.get_uint("timeout", mk_c(c)->get_timeout());
+        unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
+        bool     use_ctrl_c  = to_solver(s)->m_params.get_bool("ctrl_c", true);
+        cancel_eh<reslimit> eh(m.limit());
+        to_solver(s)->set_eh(&eh);
+        api::context::set_interruptable si(*(mk_c(c)), eh);
+        lbool r = l_false;
+        {
+            scoped_ctrl_c ctrlc(eh, false, use_ctrl_c);
+            scoped_timer timer(timeout, &eh);
+            scoped_rlimit _rlimit(m.limit(), rlimit);
+            try {
+                r = to_solver(s)->m_cube_generator->next(m, cube);
+            }
+            catch (z3_exception & ex) {
+                to_solver(s)->set_eh(nullptr);
+                mk_c(c)->handle_exception(ex);
+                RETURN_Z3(nullptr);
+            }
+        }
+        to_solver(s)->set_eh(nullptr);
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), m);
+        mk_c(c)->save_object(v);
+        if (r == l_undef)
+            for (expr* e : cube)
+                v->m_ast_vector.push_back(e);
+        else
+            v->m_ast_vector.push_back(m.mk_bool_val(r == l_true));
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
+    bool Z3_API Z3_solver_refute_cube(Z3_context c, Z3_solver s, Z3_ast_vector cube) {
+        Z3_TRY;
+        LOG_Z3_solver_refute_cube(c, s, cube);
+        RESET_ERROR_CODE();
+        auto* g = to_solver(s)->m_cube_generator.get();
+        if (!g) {
+            SET_ERROR_CODE(Z3_INVALID_USAGE, "no cubes were generated for the solver");
+            return false;
+        }
+        ast_manager& m = mk_c(c)->m();
+        expr_ref_vector lits(m);
+        for (ast* a : to_ast_vector_ref(cube)) {
+            if (!is_expr(a)) {
+                SET_ERROR_CODE(Z3_INVALID_USAGE, "cube contains a non-expression");
+                return false;
+            }
+            lits.push_back(to_expr(a));
+        }
+        g->refuted(m, lits);
+        return g->is_done();
+        Z3_CATCH_RETURN(false);
+    }
+
     class api_context_obj : public user_propagator::context_obj {
         api::context* c;
     public:
@@ -949,6 +1097,27 @@ extern "C" {
         Z3_CATCH;   
     }
 
+    void Z3_API Z3_solver_register_stats_callback(
+        Z3_context  c,
+        Z3_solver   s,
+        unsigned    interval_ms,
+        void*       user_context,
+        Z3_stats_eh stats_eh) {
+        Z3_TRY;
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        ::stats_eh _stats = [=](statistics const& st) {
+            Z3_stats_ref * r = alloc(Z3_stats_ref, *mk_c(c));
+            r->m_stats.copy(st);
+            mk_c(c)->save_object(r);
+            r->inc_ref();
+            stats_eh(user_context, of_stats(r));
+            r->dec_ref();
+        };
+        to_solver_ref(s)->register_stats_callback(stats_eh ? interval_ms : 0, _stats);
+        Z3_CATCH;
+    }
+
     void Z3_API Z3_solver_propagate_init(
         Z3_context  c, 
         Z3_solver   s, 
@@ -1016,6 +1185,17 @@ extern "C" {
         Z3_CATCH;        
     }
 
+    void Z3_API Z3_solver_propagate_batch(
+        Z3_context  c, 
+        Z3_solver   s,
+        Z3_batch_eh batch_eh) {
+        Z3_TRY;
+        RESET_ERROR_CODE();
+        user_propagator::batch_eh_t _batch = (void(*)(void*,user_propagator::callback*,unsigned,expr* const*,expr* const*,unsigned,expr* const*,expr* const*))batch_eh;
+        to_solver_ref(s)->user_propagate_register_batch(_batch);
+        Z3_CATCH;        
+    }
+
     void Z3_API Z3_solver_propagate_register(Z3_context c, Z3_solver s, Z3_ast e) {
         Z3_TRY;
         LOG_Z3_solver_propagate_register(c, s, e);
@@ -1043,6 +1223,31 @@ extern "C" {
         Z3_CATCH;        
     }
 
+    void Z3_API Z3_solver_propagate_consequences(Z3_context c, Z3_solver_callback s, unsigned n, Z3_ast const* conseqs,
+                                                 unsigned const* num_fixed, unsigned total_fixed, Z3_ast const* fixed,
+                                                 unsigned const* num_eqs, unsigned total_eqs, Z3_ast const* eq_lhs, Z3_ast const* eq_rhs) {
+        Z3_TRY;
+        LOG_Z3_solver_propagate_consequences(c, s, n, conseqs, num_fixed, total_fixed, fixed, num_eqs, total_eqs, eq_lhs, eq_rhs);
+        RESET_ERROR_CODE();
+        unsigned nf = 0, ne = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            nf += num_fixed[i];
+            ne += num_eqs[i];
+        }
+        if (nf != total_fixed || ne != total_eqs) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "justification sizes do not add up to the number of fixed terms and equalities");
+            return;
+        }
+        auto* cb = reinterpret_cast<user_propagator::callback*>(s);
+        nf = ne = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            cb->propagate_cb(num_fixed[i], (expr* const*)fixed + nf, num_eqs[i], (expr* const*)eq_lhs + ne, (expr* const*)eq_rhs + ne, to_expr(conseqs[i]));
+            nf += num_fixed[i];
+            ne += num_eqs[i];
+        }
+        Z3_CATCH;        
+    }
+
     void Z3_API Z3_solver_propagate_created(Z3_context c, Z3_solver s, Z3_created_eh created_eh) {
         Z3_TRY;
         RESET_ERROR_CODE();
@@ -20,6 +20,7 @@ Revision History:
 #include "util/mutex.h"
 #include "api/api_util.h"
 #include "solver/solver.h"
+#include "solver/cube_generator.h"
 
 struct solver2smt2_pp {
     ast_pp_util     m_pp_util;
@@ -41,6 +42,7 @@ struct solver2smt2_pp {
 struct Z3_solver_ref : public api::object {
     scoped_ptr<solver_factory> m_solver_factory;
     ref<solver>                m_solver;
+    scoped_ptr<cube_generator> m_cube_generator;     // uses the cube state of m_solver
     params_ref                 m_params;
     param_descrs               m_param_descrs;
     symbol                     m_logic;
@@ -53,6 +55,7 @@ struct Z3_solver_ref : public api::object {
         api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr) {}
 
     void assert_expr(expr* e);
+    void assert_expr(unsigned n, expr* const* es);
     void assert_expr(expr* e, expr* t);
     void set_eh(event_handler* eh);
     void set_cancel();
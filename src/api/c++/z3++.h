@@ -574,6 +574,20 @@ namespace z3 {
         operator Z3_ast_vector() const { return m_vector; }
         unsigned size() const { return Z3_ast_vector_size(ctx(), m_vector); }
         T operator[](unsigned i) const { Z3_ast r = Z3_ast_vector_get(ctx(), m_vector, i); check_error(); return cast_ast<T>()(ctx(), r); }
+        /**
+           \brief elements of the vector, retrieved with a single API call.
+        */
+        std::vector<T> to_vector() const {
+            unsigned sz = size();
+            std::vector<Z3_ast> asts(sz);
+            Z3_ast_vector_to_array(ctx(), m_vector, sz, asts.data());
+            check_error();
+            std::vector<T> result;
+            result.reserve(sz);
+            for (Z3_ast a : asts)
+                result.push_back(cast_ast<T>()(ctx(), a));
+            return result;
+        }
         void push_back(T const & e) { Z3_ast_vector_push(ctx(), m_vector, e); check_error(); }
         void resize(unsigned sz) { Z3_ast_vector_resize(ctx(), m_vector, sz); check_error(); }
         T back() const { return operator[](size() - 1); }
@@ -2576,6 +2590,24 @@ namespace z3 {
         unsigned num_funcs() const { return Z3_model_get_num_funcs(ctx(), m_model); }
         func_decl get_const_decl(unsigned i) const { Z3_func_decl r = Z3_model_get_const_decl(ctx(), m_model, i); check_error(); return func_decl(ctx(), r); }
         func_decl get_func_decl(unsigned i) const { Z3_func_decl r = Z3_model_get_func_decl(ctx(), m_model, i); check_error(); return func_decl(ctx(), r); }
+        /**
+           \brief constants of the model and their values, retrieved with a single API call.
+        */
+        void get_const_interps(std::vector<func_decl> & decls, std::vector<expr> & values) const {
+            unsigned n = num_consts();
+            std::vector<Z3_func_decl> ds(n);
+            std::vector<Z3_ast> vs(n);
+            Z3_model_get_const_interps(ctx(), m_model, n, ds.data(), vs.data());
+            check_error();
+            decls.clear();
+            values.clear();
+            decls.reserve(n);
+            values.reserve(n);
+            for (unsigned i = 0; i < n; ++i) {
+                decls.push_back(func_decl(ctx(), ds[i]));
+                values.push_back(expr(ctx(), vs[i]));
+            }
+        }
         unsigned size() const { return num_consts() + num_funcs(); }
         func_decl operator[](int i) const {
             assert(0 <= i);
@@ -2675,6 +2707,7 @@ namespace z3 {
         solver(context & c, Z3_solver s):object(c) { init(s); }
         solver(context & c, char const * logic):object(c) { init(Z3_mk_solver_for_logic(c, c.str_symbol(logic))); check_error(); }
         solver(context & c, solver const& src, translate): object(c) { Z3_solver s = Z3_solver_translate(src.ctx(), src, c); check_error(); init(s); }
+        solver fork() const { Z3_solver s = Z3_solver_fork(ctx(), m_solver); check_error(); return solver(ctx(), s); }
         solver(solver const & s):object(s) { init(s.m_solver); }
         ~solver() { Z3_solver_dec_ref(ctx(), m_solver); }
         operator Z3_solver() const { return m_solver; }
@@ -2705,8 +2738,8 @@ namespace z3 {
         }        
         void add(expr_vector const& v) { 
             check_context(*this, v); 
-            for (unsigned i = 0; i < v.size(); ++i) 
-                add(v[i]); 
+            Z3_solver_assert_vector(ctx(), m_solver, v); 
+            check_error(); 
         }
         void from_file(char const* file) { Z3_solver_from_file(ctx(), m_solver, file); ctx().check_parser_error(); }
         void from_string(char const* s) { Z3_solver_from_string(ctx(), m_solver, s); ctx().check_parser_error(); }
@@ -2756,6 +2789,8 @@ namespace z3 {
             check_error(); 
             return result; 
         }
+        expr_vector export_hints() const { Z3_ast_vector r = Z3_solver_export_hints(ctx(), m_solver); check_error(); return expr_vector(ctx(), r); }
+        void import_hints(expr_vector const& hints) { Z3_solver_import_hints(ctx(), m_solver, hints); check_error(); }
         expr proof() const { Z3_ast r = Z3_solver_get_proof(ctx(), m_solver); check_error(); return expr(ctx(), r); }
         friend std::ostream & operator<<(std::ostream & out, solver const & s);
 
@@ -111,15 +111,25 @@ public class ASTVector extends Z3Object {
         getContext().getASTVectorDRQ().storeReference(getContext(), this);
     }
 
+    /**
+     * The native objects of the vector, retrieved with a single call.
+     **/
+    private long[] getNativeArray()
+    {
+        long[] res = new long[size()];
+        Native.astVectorToArray(getContext().nCtx(), getNativeObject(), res.length, res);
+        return res;
+    }
+
     /**
      * Translates the AST vector into an AST[]
      * */
     public AST[] ToArray()
     {
-        int n = size();
-        AST[] res = new AST[n];
-        for (int i = 0; i < n; i++)
-            res[i] = AST.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        AST[] res = new AST[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = AST.create(getContext(), objs[i]);
         return res;
     }
     
@@ -127,10 +137,10 @@ public class ASTVector extends Z3Object {
      * Translates the AST vector into an Expr[]
      * */
     public Expr<?>[] ToExprArray() {
-        int n = size();
-        Expr<?>[] res = new Expr[n];
-        for (int i = 0; i < n; i++)
-            res[i] = Expr.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        Expr<?>[] res = new Expr[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = Expr.create(getContext(), objs[i]);
         return res;    
     }
 
@@ -139,10 +149,10 @@ public class ASTVector extends Z3Object {
      * */  
     public BoolExpr[] ToBoolExprArray()
     {
-        int n = size();
-        BoolExpr[] res = new BoolExpr[n];
-        for (int i = 0; i < n; i++)
-            res[i] = (BoolExpr) Expr.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        BoolExpr[] res = new BoolExpr[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = (BoolExpr) Expr.create(getContext(), objs[i]);
         return res;
     }
 
@@ -151,10 +161,10 @@ public class ASTVector extends Z3Object {
      * */    
     public BitVecExpr[] ToBitVecExprArray()
     {
-        int n = size();
-        BitVecExpr[] res = new BitVecExpr[n];
-        for (int i = 0; i < n; i++)
-            res[i] = (BitVecExpr)Expr.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        BitVecExpr[] res = new BitVecExpr[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = (BitVecExpr)Expr.create(getContext(), objs[i]);
         return res;
     }
 
@@ -163,10 +173,10 @@ public class ASTVector extends Z3Object {
      * */   
     public ArithExpr<?>[] ToArithExprExprArray()
     {
-        int n = size();
-        ArithExpr<?>[] res = new ArithExpr[n];
-        for (int i = 0; i < n; i++)
-            res[i] = (ArithExpr<?>)Expr.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        ArithExpr<?>[] res = new ArithExpr[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = (ArithExpr<?>)Expr.create(getContext(), objs[i]);
         return res;
     }
 
@@ -175,10 +185,10 @@ public class ASTVector extends Z3Object {
      * */  
     public ArrayExpr<?, ?>[] ToArrayExprArray()
     {
-        int n = size();
-        ArrayExpr<?, ?>[] res = new ArrayExpr[n];
-        for (int i = 0; i < n; i++)
-            res[i] = (ArrayExpr<?, ?>)Expr.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        ArrayExpr<?, ?>[] res = new ArrayExpr[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = (ArrayExpr<?, ?>)Expr.create(getContext(), objs[i]);
         return res;
     }
 
@@ -187,10 +197,10 @@ public class ASTVector extends Z3Object {
      * */ 
     public DatatypeExpr<?>[] ToDatatypeExprArray()
     {
-        int n = size();
-        DatatypeExpr<?>[] res = new DatatypeExpr[n];
-        for (int i = 0; i < n; i++)
-            res[i] = (DatatypeExpr<?>)Expr.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        DatatypeExpr<?>[] res = new DatatypeExpr[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = (DatatypeExpr<?>)Expr.create(getContext(), objs[i]);
         return res;
     }
 
@@ -199,10 +209,10 @@ public class ASTVector extends Z3Object {
      * */   
     public FPExpr[] ToFPExprArray()
     {
-        int n = size();
-        FPExpr[] res = new FPExpr[n];
-        for (int i = 0; i < n; i++)
-            res[i] = (FPExpr)Expr.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        FPExpr[] res = new FPExpr[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = (FPExpr)Expr.create(getContext(), objs[i]);
         return res;
     }
 
@@ -211,10 +221,10 @@ public class ASTVector extends Z3Object {
      * */
     public FPRMExpr[] ToFPRMExprArray()
     {
-        int n = size();
-        FPRMExpr[] res = new FPRMExpr[n];
-        for (int i = 0; i < n; i++)
-            res[i] = (FPRMExpr)Expr.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        FPRMExpr[] res = new FPRMExpr[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = (FPRMExpr)Expr.create(getContext(), objs[i]);
         return res;
     }
 
@@ -223,10 +233,10 @@ public class ASTVector extends Z3Object {
      * */ 
     public IntExpr[] ToIntExprArray()
     {
-        int n = size();
-        IntExpr[] res = new IntExpr[n];
-        for (int i = 0; i < n; i++)
-            res[i] = (IntExpr)Expr.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        IntExpr[] res = new IntExpr[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = (IntExpr)Expr.create(getContext(), objs[i]);
         return res;
     }
 
@@ -235,10 +245,10 @@ public class ASTVector extends Z3Object {
      * */   
     public RealExpr[] ToRealExprArray()
     {
-        int n = size();
-        RealExpr[] res = new RealExpr[n];
-        for (int i = 0; i < n; i++)
-            res[i] = (RealExpr)Expr.create(getContext(), get(i).getNativeObject());
+        long[] objs = getNativeArray();
+        RealExpr[] res = new RealExpr[objs.length];
+        for (int i = 0; i < objs.length; i++)
+            res[i] = (RealExpr)Expr.create(getContext(), objs[i]);
         return res;
     }
 }
\ No newline at end of file
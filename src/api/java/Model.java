@@ -127,10 +127,29 @@ public class Model extends Z3Object {
     public FuncDecl<?>[] getConstDecls()
     {
         int n = getNumConsts();
+        long[] decls = new long[n];
+        Native.modelGetConstInterps(getContext().nCtx(), getNativeObject(), n, decls, new long[n]);
         FuncDecl<?>[] res = new FuncDecl[n];
         for (int i = 0; i < n; i++)
-            res[i] = new FuncDecl<>(getContext(), Native.modelGetConstDecl(getContext()
-                    .nCtx(), getNativeObject(), i));
+            res[i] = new FuncDecl<>(getContext(), decls[i]);
+        return res;
+    }
+
+    /**
+     * The interpretations of the constants in the model, the i-th element
+     * is the value of the i-th element of {@code getConstDecls()}.
+     * The values of all constants are retrieved with a single native call.
+     *
+     * @throws Z3Exception
+     **/
+    public Expr<?>[] getConstInterps()
+    {
+        int n = getNumConsts();
+        long[] values = new long[n];
+        Native.modelGetConstInterps(getContext().nCtx(), getNativeObject(), n, new long[n], values);
+        Expr<?>[] res = new Expr[n];
+        for (int i = 0; i < n; i++)
+            res[i] = Expr.create(getContext(), values[i]);
         return res;
     }
 
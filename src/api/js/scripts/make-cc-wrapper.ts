@@ -21,12 +21,30 @@ export function makeCCWrapper() {
       throw new Error(`async function with unknown return type ${fn.cRet}`);
     }
 
+    // the caller frees input arrays and strings when the call returns, which is before the thread
+    // runs, so the thread works on copies
+    let copies = [];
+    let args = fn.params.map(p => {
+      if (p.kind === 'in_array') {
+        copies.push(`std::vector<${p.cType}> ${p.name}_copy(${p.name}, ${p.name} + ${fn.params[p.sizeIndex!].name});`);
+        return { capture: `${p.name}_copy = std::move(${p.name}_copy)`, use: `${p.name}_copy.data()` };
+      }
+      if (p.cType === 'Z3_string' && !p.isPtr && !p.isArray) {
+        copies.push(`std::string ${p.name}_copy(${p.name});`);
+        return { capture: `${p.name}_copy = std::move(${p.name}_copy)`, use: `${p.name}_copy.c_str()` };
+      }
+      return { capture: p.name, use: p.name };
+    });
+
     wrappers.push(
       `
 extern "C" void async_${fn.name}(${fn.params
         .map(p => `${p.isConst ? 'const ' : ''}${p.cType}${p.isPtr ? '*' : ''} ${p.name}${p.isArray ? '[]' : ''}`)
         .join(', ')}) {
-  ${wrapper}<decltype(&${fn.name}), &${fn.name}>(${fn.params.map(p => `${p.name}`).join(', ')});
+  ${copies.join('\n  ')}
+  ${wrapper}([${args.map(a => a.capture).join(', ')}]() mutable {
+    return ${fn.name}(${args.map(a => a.use).join(', ')});
+  });
 }
 `.trim(),
     );
@@ -35,49 +53,60 @@ extern "C" void async_${fn.name}(${fn.params
   return `// THIS FILE IS AUTOMATICALLY GENERATED BY ${path.basename(__filename)}
 // DO NOT EDIT IT BY HAND
 
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <emscripten.h>
 
 #include "../../z3.h"
 
-template<typename Fn, Fn fn, typename... Args>
-void wrapper(Args&&... args) {
-  std::thread t([...args = std::forward<Args>(args)] {
+// id of the pending promise of the call that is being started, see async-wrapper.js
+static int current_async_id() {
+  return MAIN_THREAD_EM_ASM_INT({
+    return current_async_id;
+  });
+}
+
+template<typename Fn>
+void wrapper(Fn&& fn) {
+  int id = current_async_id();
+  std::thread t([id, fn = std::forward<Fn>(fn)]() mutable {
     try {
-      auto result = fn(args...);
+      auto result = fn();
       MAIN_THREAD_ASYNC_EM_ASM({
-        resolve_async($0);
-      }, result);
+        resolve_async($0, $1);
+      }, id, result);
     } catch (std::exception& e) {
       MAIN_THREAD_ASYNC_EM_ASM({
-        reject_async(new Error(UTF8ToString($0)));
-      }, e.what());
+        reject_async($0, new Error(UTF8ToString($1)));
+      }, id, e.what());
     } catch (...) {
       MAIN_THREAD_ASYNC_EM_ASM({
-        reject_async('failed with unknown exception');
-      });
+        reject_async($0, 'failed with unknown exception');
+      }, id);
     }
   });
   t.detach();
 }
 
-template<typename Fn, Fn fn, typename... Args>
-void wrapper_str(Args&&... args) {
-  std::thread t([...args = std::forward<Args>(args)] {
+template<typename Fn>
+void wrapper_str(Fn&& fn) {
+  int id = current_async_id();
+  std::thread t([id, fn = std::forward<Fn>(fn)]() mutable {
     try {
-      auto result = fn(args...);
+      auto result = fn();
       MAIN_THREAD_ASYNC_EM_ASM({
-        resolve_async(UTF8ToString($0));
-      }, result);
+        resolve_async($0, UTF8ToString($1));
+      }, id, result);
     } catch (std::exception& e) {
       MAIN_THREAD_ASYNC_EM_ASM({
-        reject_async(new Error(UTF8ToString($0)));
-      }, e.what());
+        reject_async($0, new Error(UTF8ToString($1)));
+      }, id, e.what());
     } catch (...) {
       MAIN_THREAD_ASYNC_EM_ASM({
-        reject_async(new Error('failed with unknown exception'));
-      });
+        reject_async($0, new Error('failed with unknown exception'));
+      }, id);
     }
   });
   t.detach();
@@ -57,6 +57,8 @@ const types = {
   Z3_created_eh: 'Z3_created_eh',
   Z3_decide_eh: 'Z3_decide_eh',
   Z3_on_clause_eh: 'Z3_on_clause_eh',
+  Z3_stats_eh: 'Z3_stats_eh',
+  Z3_batch_eh: 'Z3_batch_eh',
 } as unknown as Record<string, string>;
 
 export type ApiParam = { kind: string; sizeIndex?: number; type: string };
@@ -539,6 +539,29 @@ describe('high-level', () => {
         });
       expect(results).toStrictEqual([1n, 2n, 3n, 4n, 5n]);
     });
+
+    it('can check solvers of different contexts concurrently', async () => {
+      const checks = ['a', 'b', 'c'].map(name => {
+        const { Solver, Int } = api.Context(name);
+        const solver = new Solver();
+        const x = Int.const('x');
+        solver.add(x.gt(0), x.lt(2));
+        return solver.check(x.eq(1));
+      });
+      expect(await Promise.all(checks)).toStrictEqual(['sat', 'sat', 'sat']);
+    });
+
+    it('can cancel a check that has not started', async () => {
+      const { Solver, Int } = api.Context('main');
+      const solver = new Solver();
+      const x = Int.const('x');
+      solver.add(x.gt(0));
+      const first = solver.check();
+      const second = solver.check();
+      second.cancel();
+      expect(await first).toStrictEqual('sat');
+      expect(await second).toStrictEqual('unknown');
+    });
   });
 
   describe('AstVector', () => {
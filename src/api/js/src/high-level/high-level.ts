@@ -48,6 +48,7 @@ import {
   BitVecSort,
   Bool,
   BoolSort,
+  CancellablePromise,
   CheckSatResult, CoercibleFromMap,
   CoercibleRational,
   CoercibleToBitVec,
@@ -76,8 +77,6 @@ import { allSatisfy, assert, assertExhaustive } from './utils';
 
 const FALLBACK_PRECISION = 17;
 
-const asyncMutex = new Mutex();
-
 function isCoercibleRational(obj: any): obj is CoercibleRational {
   // prettier-ignore
   const r = (
@@ -160,6 +159,9 @@ export function createApi(Z3: Z3Core): Z3HighLevel {
     Z3.set_ast_print_mode(contextPtr, Z3_ast_print_mode.Z3_PRINT_SMTLIB2_COMPLIANT);
     Z3.del_config(cfg);
 
+    // a context can only be used by one thread at a time, different contexts run concurrently
+    const asyncMutex = new Mutex();
+
     function _assertContext(...ctxs: (Context<Name> | { ctx: Context<Name> })[]) {
       ctxs.forEach(other => assert('ctx' in other ? ctx === other.ctx : ctx === other, 'Context mismatch'));
     }
@@ -1058,24 +1060,45 @@ export function createApi(Z3: Z3Core): Z3HighLevel {
         return new AstVectorImpl(check(Z3.solver_get_assertions(contextPtr, this.ptr)));
       }
 
-      async check(...exprs: (Bool<Name> | AstVector<Name, Bool<Name>>)[]): Promise<CheckSatResult> {
+      check(...exprs: (Bool<Name> | AstVector<Name, Bool<Name>>)[]): CancellablePromise<CheckSatResult> {
         const assumptions = _flattenArgs(exprs).map(expr => {
           _assertContext(expr);
           return expr.ast;
         });
-        const result = await asyncMutex.runExclusive(() =>
-          check(Z3.solver_check_assumptions(contextPtr, this.ptr, assumptions)),
-        );
-        switch (result) {
-          case Z3_lbool.Z3_L_FALSE:
-            return 'unsat';
-          case Z3_lbool.Z3_L_TRUE:
-            return 'sat';
-          case Z3_lbool.Z3_L_UNDEF:
-            return 'unknown';
-          default:
-            assertExhaustive(result);
-        }
+        let cancelled = false;
+        let running = false;
+        const promise = asyncMutex
+          .runExclusive(async () => {
+            if (cancelled) {
+              return Z3_lbool.Z3_L_UNDEF;
+            }
+            running = true;
+            try {
+              return check(await Z3.solver_check_assumptions(contextPtr, this.ptr, assumptions));
+            } finally {
+              running = false;
+            }
+          })
+          .then((result): CheckSatResult => {
+            switch (result) {
+              case Z3_lbool.Z3_L_FALSE:
+                return 'unsat';
+              case Z3_lbool.Z3_L_TRUE:
+                return 'sat';
+              case Z3_lbool.Z3_L_UNDEF:
+                return 'unknown';
+              default:
+                assertExhaustive(result);
+            }
+          });
+        return Object.assign(promise, {
+          cancel() {
+            cancelled = true;
+            if (running) {
+              interrupt();
+            }
+          },
+        });
       }
 
       model() {
@@ -111,6 +111,16 @@ export class Z3AssertionError extends Z3Error {
 /** @category Global */
 export type CheckSatResult = 'sat' | 'unsat' | 'unknown';
 
+/**
+ * Result of a computation that runs in a worker thread.
+ *
+ * `cancel` interrupts the computation with {@link Context.interrupt}, a cancelled check resolves to `'unknown'`.
+ * @category Global
+ */
+export interface CancellablePromise<T> extends Promise<T> {
+  cancel(): void;
+}
+
 /** @hidden */
 export interface ContextCtor {
   <Name extends string>(name: Name, options?: Record<string, any>): Context<Name>;
@@ -520,7 +530,11 @@ export interface Solver<Name extends string = 'main'> {
 
   fromString(s: string): void;
 
-  check(...exprs: (Bool<Name> | AstVector<Name, Bool<Name>>)[]): Promise<CheckSatResult>;
+  /**
+   * Checks the assertions of the solver in a worker thread. Checks of solvers of different contexts run
+   * concurrently, checks within the same context are run one after the other.
+   */
+  check(...exprs: (Bool<Name> | AstVector<Name, Bool<Name>>)[]): CancellablePromise<CheckSatResult>;
 
   model(): Model<Name>;
 }
@@ -1,39 +1,46 @@
 // this wrapper works with async-fns to provide promise-based off-thread versions of some functions
 // It's prepended directly by emscripten to the resulting z3-built.js
+//
+// Every call gets its own id, so several calls can be pending at the same time,
+// e.g. solvers of different contexts running in parallel worker threads.
+// The C wrapper reads the id of the call through `current_async_id` before it starts its thread.
 
-let capability = null;
-function resolve_async(val) {
-  // setTimeout is a workaround for https://github.com/emscripten-core/emscripten/issues/15900
-  if (capability == null) {
+let capabilities = new Map();
+let next_async_id = 0;
+let current_async_id = -1;
+
+function settle_async(id, fn) {
+  let cap = capabilities.get(id);
+  if (cap === undefined) {
     return;
   }
-  let cap = capability;
-  capability = null;
+  capabilities.delete(id);
 
-  setTimeout(() => {
-    cap.resolve(val);
-  }, 0);
+  // setTimeout is a workaround for https://github.com/emscripten-core/emscripten/issues/15900
+  setTimeout(() => fn(cap), 0);
 }
 
-function reject_async(val) {
-  if (capability == null) {
-    return;
-  }
-  let cap = capability;
-  capability = null;
+function resolve_async(id, val) {
+  settle_async(id, cap => cap.resolve(val));
+}
 
-  setTimeout(() => {
-    cap.reject(val);
-  }, 0);
+function reject_async(id, val) {
+  settle_async(id, cap => cap.reject(val));
 }
 
 Module.async_call = function (f, ...args) {
-  if (capability !== null) {
-    throw new Error(`you can't execute multiple async functions at the same time; let the previous one finish first`);
-  }
+  let id = next_async_id++;
   let promise = new Promise((resolve, reject) => {
-    capability = { resolve, reject };
+    capabilities.set(id, { resolve, reject });
   });
-  f(...args);
+  current_async_id = id;
+  try {
+    f(...args);
+  } catch (e) {
+    capabilities.delete(id);
+    throw e;
+  } finally {
+    current_async_id = -1;
+  }
   return promise;
 };
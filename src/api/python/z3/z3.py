@@ -522,9 +522,7 @@ def _to_func_decl_array(args):
 
 def _to_ast_array(args):
     sz = len(args)
-    _args = (Ast * sz)()
-    for i in range(sz):
-        _args[i] = args[i].as_ast()
+    _args = (Ast * sz)(*[a.as_ast() for a in args])
     return _args, sz
 
 
@@ -1222,6 +1220,16 @@ def _reduce(func, sequence, initial):
     return result
 
 
+def _is_arith_list(alist):
+    """Return `True` if all elements of `alist` are arithmetic expressions.
+    Such lists need no coercion: integer arguments of real operators are
+    converted by Z3 itself."""
+    for a in alist:
+        if not isinstance(a, ArithRef):
+            return False
+    return True
+
+
 def _coerce_expr_list(alist, ctx=None):
     has_expr = False
     for a in alist:
@@ -5996,6 +6004,11 @@ class AstVector(Z3PPObject):
         """Return a textual representation of the s-expression representing the vector."""
         return Z3_ast_vector_to_string(self.ctx.ref(), self.vector)
 
+    def serialize(self, file_name):
+        """Write the expressions in the vector to `file_name` in binary format.
+        The file can be loaded using parse_binary_file()."""
+        Z3_ast_vector_serialize(self.ctx.ref(), self.vector, file_name)
+
 #########################################
 #
 # AST Map
@@ -7225,6 +7238,36 @@ class Solver(Z3PPObject):
             if (len(r) == 0):
                 return
 
+    def next_cube(self, vars=None):
+        """Return the next open cube of a streaming cube generator.
+        Unlike `cube`, cubes can be requested in any order together with
+        `refute_cube`, and the generator skips cubes below refuted ones.
+        The variables are only used when the generator is created by the first call.
+        The result is a cube, the singleton `[False]` if no cubes remain, or
+        `[True]` if the solver found the assertions satisfiable.
+
+        >>> x, y = Bools('x y')
+        >>> s = Solver()
+        >>> s.add(Or(x, y))
+        >>> c = s.next_cube()
+        >>> len(c) <= 1
+        True
+        """
+        vs = AstVector(None, self.ctx)
+        if vars is not None:
+            for v in vars:
+                vs.push(v)
+        return AstVector(Z3_solver_next_cube(self.ctx.ref(), self.solver, vs.vector), self.ctx)
+
+    def refute_cube(self, cube):
+        """Report a cube returned by `next_cube`, or a prefix of it, as unsatisfiable.
+        Return True if all cubes are refuted.
+        """
+        vs = AstVector(None, self.ctx)
+        for lit in cube:
+            vs.push(lit)
+        return Z3_solver_refute_cube(self.ctx.ref(), self.solver, vs.vector)
+
     def cube_vars(self):
         """Access the set of variables that were touched by the most recently generated cube.
         This set of variables can be used as a starting point for additional cubes.
@@ -7273,6 +7316,33 @@ class Solver(Z3PPObject):
         """
         return AstVector(Z3_solver_get_trail(self.ctx.ref(), self.solver), self.ctx)
 
+    def export_hints(self):
+        """Return hints for starting a solver on a similar problem after a check() call:
+        learned units, literals of atoms in their saved phase by decreasing activity,
+        and short learned clauses.
+        """
+        return AstVector(Z3_solver_export_hints(self.ctx.ref(), self.solver), self.ctx)
+
+    def import_hints(self, hints):
+        """Use hints from export_hints() of a solver on a similar problem for the next check() call.
+        The hints guide phases and case splits, they are not asserted.
+
+        >>> x, y = Bools('x y')
+        >>> s = Solver()
+        >>> s.add(Or(x, y))
+        >>> s.check()
+        sat
+        >>> t = Solver()
+        >>> t.add(Or(x, y), Or(Not(x), y))
+        >>> t.import_hints(s.export_hints())
+        >>> t.check()
+        sat
+        """
+        v = AstVector(None, self.ctx)
+        for h in hints:
+            v.push(h)
+        Z3_solver_import_hints(self.ctx.ref(), self.solver, v.vector)
+
     def statistics(self):
         """Return statistics for the last `check()`.
 
@@ -7329,6 +7399,21 @@ class Solver(Z3PPObject):
         solver = Z3_solver_translate(self.ctx.ref(), self.solver, target.ref())
         return Solver(solver, target)
 
+    def fork(self):
+        """Return a copy of `self` in the same context that retains learned clauses and lemmas.
+
+        >>> x = Int('x')
+        >>> s1 = Solver()
+        >>> s1.add(x > 0)
+        >>> s2 = s1.fork()
+        >>> s2.add(x < 0)
+        >>> s2.check()
+        unsat
+        >>> s1.check()
+        sat
+        """
+        return Solver(Z3_solver_fork(self.ctx.ref(), self.solver), self.ctx)
+
     def __copy__(self):
         return self.translate(self.ctx)
 
@@ -8871,6 +8956,9 @@ def Sum(*args):
     ctx = _ctx_from_ast_arg_list(args)
     if ctx is None:
         return _reduce(lambda a, b: a + b, args, 0)
+    if _is_arith_list(args):
+        _args, sz = _to_ast_array(args)
+        return ArithRef(Z3_mk_add(ctx.ref(), sz, _args), ctx)
     args = _coerce_expr_list(args, ctx)
     if is_bv(args[0]):
         return _reduce(lambda a, b: a + b, args, 0)
@@ -8897,6 +8985,9 @@ def Product(*args):
     ctx = _ctx_from_ast_arg_list(args)
     if ctx is None:
         return _reduce(lambda a, b: a * b, args, 1)
+    if _is_arith_list(args):
+        _args, sz = _to_ast_array(args)
+        return ArithRef(Z3_mk_mul(ctx.ref(), sz, _args), ctx)
     args = _coerce_expr_list(args, ctx)
     if is_bv(args[0]):
         return _reduce(lambda a, b: a * b, args, 1)
@@ -8952,7 +9043,27 @@ def _reorder_pb_arg(arg):
     return arg
 
 
-def _pb_args_coeffs(args, default_ctx=None):
+def _to_int_array(coeffs):
+    coeffs = [int(c) for c in coeffs]
+    for c in coeffs:
+        _z3_check_cint_overflow(c, "coefficient")
+    return (ctypes.c_int * len(coeffs))(*coeffs)
+
+
+def _pb_args_coeffs(args, default_ctx=None, coeffs=None):
+    if coeffs is not None:
+        # args is a sequence of Boolean expressions and coeffs a sequence,
+        # such as a numpy array, of the same length.
+        args = list(args)
+        if z3_debug():
+            _z3_assert(len(args) == len(coeffs), "Number of arguments and coefficients must agree")
+        ctx = _ctx_from_ast_arg_list(args, default_ctx)
+        if z3_debug():
+            _z3_assert(ctx is not None, "At least one of the arguments must be a Z3 expression")
+        if not all(isinstance(a, BoolRef) for a in args):
+            args = _coerce_expr_list(args, ctx)
+        _args, sz = _to_ast_array(args)
+        return ctx, sz, _args, _to_int_array(coeffs), args
     args = _get_args_ast_list(args)
     if len(args) == 0:
         return _get_ctx(default_ctx), 0, (Ast * 0)(), (ctypes.c_int * 0)()
@@ -8972,39 +9083,75 @@ def _pb_args_coeffs(args, default_ctx=None):
     return ctx, sz, _args, _coeffs, args
 
 
-def PbLe(args, k):
+def PbLe(args, k, coeffs=None):
     """Create a Pseudo-Boolean inequality k constraint.
 
+    The arguments are a sequence of pairs of a Boolean and its coefficient,
+    or, when `coeffs` is given, a sequence of Booleans.
+
     >>> a, b, c = Bools('a b c')
     >>> f = PbLe(((a,1),(b,3),(c,2)), 3)
+    >>> g = PbLe([a, b, c], 3, coeffs=[1, 3, 2])
     """
     _z3_check_cint_overflow(k, "k")
-    ctx, sz, _args, _coeffs, args = _pb_args_coeffs(args)
+    ctx, sz, _args, _coeffs, args = _pb_args_coeffs(args, coeffs=coeffs)
     return BoolRef(Z3_mk_pble(ctx.ref(), sz, _args, _coeffs, k), ctx)
 
 
-def PbGe(args, k):
+def PbGe(args, k, coeffs=None):
     """Create a Pseudo-Boolean inequality k constraint.
 
+    The arguments are a sequence of pairs of a Boolean and its coefficient,
+    or, when `coeffs` is given, a sequence of Booleans.
+
     >>> a, b, c = Bools('a b c')
     >>> f = PbGe(((a,1),(b,3),(c,2)), 3)
+    >>> g = PbGe([a, b, c], 3, coeffs=[1, 3, 2])
     """
     _z3_check_cint_overflow(k, "k")
-    ctx, sz, _args, _coeffs, args = _pb_args_coeffs(args)
+    ctx, sz, _args, _coeffs, args = _pb_args_coeffs(args, coeffs=coeffs)
     return BoolRef(Z3_mk_pbge(ctx.ref(), sz, _args, _coeffs, k), ctx)
 
 
-def PbEq(args, k, ctx=None):
+def PbEq(args, k, ctx=None, coeffs=None):
     """Create a Pseudo-Boolean inequality k constraint.
 
+    The arguments are a sequence of pairs of a Boolean and its coefficient,
+    or, when `coeffs` is given, a sequence of Booleans.
+
     >>> a, b, c = Bools('a b c')
     >>> f = PbEq(((a,1),(b,3),(c,2)), 3)
+    >>> g = PbEq([a, b, c], 3, coeffs=[1, 3, 2])
     """
     _z3_check_cint_overflow(k, "k")
-    ctx, sz, _args, _coeffs, args = _pb_args_coeffs(args)
+    ctx, sz, _args, _coeffs, args = _pb_args_coeffs(args, ctx, coeffs)
     return BoolRef(Z3_mk_pbeq(ctx.ref(), sz, _args, _coeffs, k), ctx)
 
 
+def BatchApps(decls, inputs, code, ctx=None):
+    """Create many applications in one call.
+
+    `code` is a flat sequence of integers that describes the applications
+    one after the other: the index of the declaration in `decls`, the number
+    of arguments `n`, and the indices of the `n` arguments. The indices
+    `0` to `len(inputs) - 1` refer to the expressions in `inputs`, the index
+    `len(inputs) + i` to the `i`-th application. The result is a vector
+    with all applications, the last one is the root of the term.
+
+    >>> x, y = Ints('x y')
+    >>> add, mul = (x + y).decl(), (x * y).decl()
+    >>> r = BatchApps([add, mul], [x, y], [0, 2, 0, 1,  1, 2, 2, 1])
+    >>> r[1]
+    (x + y)*y
+    """
+    ctx = _get_ctx(_ctx_from_ast_arg_list(list(decls) + list(inputs), ctx))
+    num_decls = len(decls)
+    _decls = (FuncDecl * num_decls)(*[d.as_func_decl() for d in decls])
+    _inputs, num_inputs = _to_ast_array(inputs)
+    _code = (ctypes.c_uint * len(code))(*[int(c) for c in code])
+    return AstVector(Z3_mk_ast_batch(ctx.ref(), num_decls, _decls, num_inputs, _inputs, len(code), _code), ctx)
+
+
 def solve(*args, **keywords):
     """Solve the constraints `*args`.
 
@@ -9249,6 +9396,15 @@ def parse_smt2_file(f, sorts={}, decls={}, ctx=None):
     return AstVector(Z3_parse_smtlib2_file(ctx.ref(), f, ssz, snames, ssorts, dsz, dnames, ddecls), ctx)
 
 
+def parse_binary_file(f, ctx=None):
+    """Load the expressions stored in a file created by AstVector.serialize().
+
+    This function is similar to parse_smt2_file(), but it does not parse or type check the input.
+    """
+    ctx = _get_ctx(ctx)
+    return AstVector(Z3_parse_binary(ctx.ref(), f), ctx)
+
+
 #########################################
 #
 # Floating-Point Arithmetic
@@ -1434,6 +1434,8 @@ Z3_DECLARE_CLOSURE(Z3_final_eh,   void, (void* ctx, Z3_solver_callback cb));
 Z3_DECLARE_CLOSURE(Z3_created_eh, void, (void* ctx, Z3_solver_callback cb, Z3_ast t));
 Z3_DECLARE_CLOSURE(Z3_decide_eh,  void, (void* ctx, Z3_solver_callback cb, Z3_ast* t, unsigned* idx, Z3_lbool* phase));
 Z3_DECLARE_CLOSURE(Z3_on_clause_eh, void, (void* ctx, Z3_ast proof_hint, Z3_ast_vector literals));
+Z3_DECLARE_CLOSURE(Z3_stats_eh, void, (void* ctx, Z3_stats stats));
+Z3_DECLARE_CLOSURE(Z3_batch_eh,   void, (void* ctx, Z3_solver_callback cb, unsigned num_fixed, Z3_ast const* fixed, Z3_ast const* values, unsigned num_eqs, Z3_ast const* eq_lhs, Z3_ast const* eq_rhs));
 
 
 /**
@@ -2231,6 +2233,28 @@ extern "C" {
         unsigned num_args,
         Z3_ast const args[]);
 
+    /**
+       \brief Create many applications in one call.
+
+       The nodes of the batch are numbered. The nodes \c 0 to \c num_inputs - 1
+       are the expressions \c inputs. The array \c code describes the
+       applications to create in order: each one is given by the index of its
+       declaration in \c decls, the number of arguments \c n, and the indices
+       of its \c n argument nodes, which must be smaller than its own index.
+       The k-th application gets the node index \c num_inputs + k.
+
+       Return the vector of the created applications in order.
+
+       \sa Z3_mk_app
+
+       def_API('Z3_mk_ast_batch', AST_VECTOR, (_in(CONTEXT), _in(UINT), _in_array(1, FUNC_DECL), _in(UINT), _in_array(3, AST), _in(UINT), _in_array(5, UINT)))
+    */
+    Z3_ast_vector Z3_API Z3_mk_ast_batch(
+        Z3_context c,
+        unsigned num_decls, Z3_func_decl const decls[],
+        unsigned num_inputs, Z3_ast const inputs[],
+        unsigned code_size, unsigned const code[]);
+
     /**
        \brief Declare and create a constant.
 
@@ -4888,6 +4912,18 @@ extern "C" {
     */
     unsigned Z3_API Z3_get_ast_hash(Z3_context c, Z3_ast a);
 
+    /**
+       \brief Return a 128-bit hash of the given expression in \c lo and \c hi.
+       Unlike \c Z3_get_ast_hash the hash does not depend on the context: it is
+       the same for expressions of different contexts and processes that have the
+       same structure. Uninterpreted functions and sorts are numbered in the order
+       they occur in \c a, so renaming them or declaring them in a different order
+       does not change the hash.
+
+       def_API('Z3_get_canonical_hash', VOID, (_in(CONTEXT), _in(AST), _out(UINT64), _out(UINT64)))
+    */
+    void Z3_API Z3_get_canonical_hash(Z3_context c, Z3_ast a, uint64_t* lo, uint64_t* hi);
+
     /**
        \brief Return the sort of an AST node.
 
@@ -5401,6 +5437,38 @@ extern "C" {
     */
     bool Z3_API Z3_model_eval(Z3_context c, Z3_model m, Z3_ast t, bool model_completion, Z3_ast * v);
 
+    /**
+       \brief Evaluate the AST node \c t in each of the models \c models.
+       Return a vector with the value of \c t in \c models[i] at position \c i.
+
+       The expression is compiled once when it uses only Boolean, bit-vector
+       (up to 64 bits) and integer operations over constants, and the compiled
+       form is run over the models in batches. Other expressions, and models
+       that do not assign a value to every constant of \c t, are evaluated as by
+       \c Z3_model_eval.
+
+       \sa Z3_model_eval
+
+       def_API('Z3_model_eval_batch', AST_VECTOR, (_in(CONTEXT), _in(UINT), _in_array(1, MODEL), _in(AST), _in(BOOL)))
+    */
+    Z3_ast_vector Z3_API Z3_model_eval_batch(Z3_context c, unsigned num_models, Z3_model const models[], Z3_ast t, bool model_completion);
+
+    /**
+       \brief Evaluate the Boolean, bit-vector and integer terms \c terms in the
+       model \c m and store their values as machine integers in \c values.
+       Boolean values are stored as 0 and 1.
+
+       Return \c false if the value of some term is not a numeral that fits in
+       64 bits, e.g., when it is a negative integer or when \c model_completion
+       is \c false and the term is not assigned by \c m. The corresponding
+       entries of \c values are set to 0.
+
+       \sa Z3_model_eval
+
+       def_API('Z3_model_eval_to_uint64_array', BOOL, (_in(CONTEXT), _in(MODEL), _in(UINT), _in_array(2, AST), _in(BOOL), _out_array(2, UINT64)))
+    */
+    bool Z3_API Z3_model_eval_to_uint64_array(Z3_context c, Z3_model m, unsigned num_terms, Z3_ast const terms[], bool model_completion, uint64_t values[]);
+
     /**
        \brief Return the interpretation (i.e., assignment) of constant \c a in the model \c m.
        Return \c NULL, if the model does not assign an interpretation for \c a.
@@ -5454,6 +5522,21 @@ extern "C" {
     */
     Z3_func_decl Z3_API Z3_model_get_const_decl(Z3_context c, Z3_model m, unsigned i);
 
+    /**
+       \brief Store the constants of the model \c m with their values, the
+       i-th constant in \c decls is \c Z3_model_get_const_decl(c, m, i) and
+       its value in \c values is its interpretation in \c m. The
+       declarations and values are owned by \c m.
+
+       \pre num_consts == Z3_model_get_num_consts(c, m)
+
+       \sa Z3_model_get_const_decl
+       \sa Z3_model_get_const_interp
+
+       def_API('Z3_model_get_const_interps', VOID, (_in(CONTEXT), _in(MODEL), _in(UINT), _out_array(2, FUNC_DECL), _out_array(2, AST)))
+    */
+    void Z3_API Z3_model_get_const_interps(Z3_context c, Z3_model m, unsigned num_consts, Z3_func_decl decls[], Z3_ast values[]);
+
     /**
        \brief Return the number of function interpretations in the given model.
 
@@ -5867,6 +5950,15 @@ extern "C" {
                                         Z3_symbol const decl_names[],
                                         Z3_func_decl const decls[]);
 
+    /**
+       \brief Load the expressions stored in \c file_name by #Z3_ast_vector_serialize.
+       The file is memory mapped and the expressions are rebuilt directly
+       from the stored DAG.
+
+       def_API('Z3_parse_binary', AST_VECTOR, (_in(CONTEXT), _in(STRING)))
+    */
+    Z3_ast_vector Z3_API Z3_parse_binary(Z3_context c, Z3_string file_name);
+
 
     /**
        \brief Parse and evaluate and SMT-LIB2 command sequence. The state from a previous call is saved so the next
@@ -6674,6 +6766,22 @@ extern "C" {
     */
     Z3_solver Z3_API Z3_solver_translate(Z3_context source, Z3_solver s, Z3_context target);
 
+    /**
+       \brief Create a copy of the solver \c s in the same context.
+
+       Unlike #Z3_solver_translate, the copy retains state learned by \c s where the
+       underlying solver supports it: learned clauses, phases and activities of the SAT solver,
+       and lemmas learned by the SMT core. The copy can be used to explore a branch without
+       re-learning conflicts that \c s has already found.
+
+       \remark The solver \c s must be at the base scope level.
+
+       \sa Z3_solver_translate
+
+       def_API('Z3_solver_fork', SOLVER, (_in(CONTEXT), _in(SOLVER)))
+    */
+    Z3_solver Z3_API Z3_solver_fork(Z3_context c, Z3_solver s);
+
     /**
        \brief Ad-hoc method for importing model conversion from solver.
 
@@ -6802,6 +6910,20 @@ extern "C" {
     */
     void Z3_API Z3_solver_assert(Z3_context c, Z3_solver s, Z3_ast a);
 
+    /**
+       \brief Assert all constraints of the vector \c v into the solver.
+
+       This has the same effect as asserting the elements of \c v one by one
+       using #Z3_solver_assert, but the solver receives them in one call.
+
+       \pre all elements of \c v are Boolean expressions
+
+       \sa Z3_solver_assert
+
+       def_API('Z3_solver_assert_vector', VOID, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR)))
+    */
+    void Z3_API Z3_solver_assert_vector(Z3_context c, Z3_solver s, Z3_ast_vector v);
+
     /**
        \brief Assert a constraint \c a into the solver, and track it (in the unsat) core using
        the Boolean constant \c p.
@@ -6878,6 +7000,32 @@ extern "C" {
     */
     void Z3_API Z3_solver_get_levels(Z3_context c, Z3_solver s, Z3_ast_vector literals, unsigned sz,  unsigned levels[]);
 
+    /**
+       \brief Return hints for starting a solver on a similar problem from the search state of \c s.
+       The hints are learned units, followed by literals of the Boolean atoms in their saved phase
+       in decreasing order of activity, followed by short learned clauses.
+       Atoms are identified by their structure, so the hints can be stored, for example with
+       \c Z3_ast_vector_to_string, and used for a modified version of the problem with
+       \c Z3_solver_import_hints.
+
+       \sa Z3_solver_import_hints
+
+       def_API('Z3_solver_export_hints', AST_VECTOR, (_in(CONTEXT), _in(SOLVER)))
+    */
+    Z3_ast_vector Z3_API Z3_solver_export_hints(Z3_context c, Z3_solver s);
+
+    /**
+       \brief Use hints obtained from \c Z3_solver_export_hints for the next check of \c s.
+       A literal sets the phase of its atom, and atoms of earlier hints are preferred for case splits.
+       Clauses only prefer their atoms. Neither units nor clauses are asserted, since they need not
+       follow from the assertions of \c s. Hints on atoms that do not occur in \c s are ignored.
+
+       \sa Z3_solver_export_hints
+
+       def_API('Z3_solver_import_hints', VOID, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR)))
+    */
+    void Z3_API Z3_solver_import_hints(Z3_context c, Z3_solver s, Z3_ast_vector hints);
+
     /**
        \brief register a callback to that retrieves assumed, inferred and deleted clauses during search.
        
@@ -6897,6 +7045,30 @@ extern "C" {
         void*       user_context,
         Z3_on_clause_eh on_clause_eh);
 
+    /**
+       \brief register a callback that receives the statistics of a running check.
+
+       The SAT and SMT cores invoke the callback about every \c interval_ms milliseconds
+       during search, on the thread of the check. Besides the solver statistics, the
+       statistics include the elapsed time, the memory in use and the number of conflicts
+       per second since the previous report. An interval of 0 removes the callback.
+       Solvers that do not search with the SAT or SMT core do not invoke the callback.
+
+       \param c - context.
+       \param s - solver object.
+       \param interval_ms - milliseconds between reports.
+       \param user_context - a context passed to the callback.
+       \param stats_eh - the callback.
+
+       def_API('Z3_solver_register_stats_callback', VOID, (_in(CONTEXT), _in(SOLVER), _in(UINT), _in(VOID_PTR), _fnptr(Z3_stats_eh)))
+    */
+    void Z3_API Z3_solver_register_stats_callback(
+        Z3_context  c,
+        Z3_solver   s,
+        unsigned    interval_ms,
+        void*       user_context,
+        Z3_stats_eh stats_eh);
+
     /**
        \brief register a user-properator with the solver.
 
@@ -6960,6 +7132,21 @@ extern "C" {
     */
     void Z3_API Z3_solver_propagate_diseq(Z3_context c, Z3_solver s, Z3_eq_eh eq_eh);
 
+    /**
+       \brief register a callback that receives the fixed and equality events in batches.
+       
+       The callback is invoked with all fixed values and equalities the solver
+       found since the previous invocation, so a client pays the cost of crossing
+       into its own runtime once per batch rather than once per event. The
+       callback replaces the callbacks registered with \ref Z3_solver_propagate_fixed and
+       \ref Z3_solver_propagate_eq. Events are delivered before the solver backtracks
+       over them, so they are seen under the same push and pop callbacks as the
+       single events.
+
+       def_API('Z3_solver_propagate_batch', VOID, (_in(CONTEXT), _in(SOLVER), _fnptr(Z3_batch_eh)))
+    */
+    void Z3_API Z3_solver_propagate_batch(Z3_context c, Z3_solver s, Z3_batch_eh batch_eh);
+
     /**
        \brief register a callback when a new expression with a registered function is used by the solver 
        The registered function appears at the top level and is created using \ref Z3_solver_propagate_declare.
@@ -7027,6 +7214,20 @@ extern "C" {
     
     void Z3_API Z3_solver_propagate_consequence(Z3_context c, Z3_solver_callback, unsigned num_fixed, Z3_ast const* fixed, unsigned num_eqs, Z3_ast const* eq_lhs, Z3_ast const* eq_rhs, Z3_ast conseq);
 
+    /**
+       \brief propagate several consequences in one call.
+       It has the same effect as invoking \ref Z3_solver_propagate_consequence for
+       each of the \c n consequences in order. The justification of consequence \c i
+       consists of the next \c num_fixed[i] terms of \c fixed and the next \c num_eqs[i]
+       pairs of \c eq_lhs and \c eq_rhs, where \c total_fixed and \c total_eqs are the sums
+       of \c num_fixed and \c num_eqs.
+
+       def_API('Z3_solver_propagate_consequences', VOID, (_in(CONTEXT), _in(SOLVER_CALLBACK), _in(UINT), _in_array(2, AST), _in_array(2, UINT), _in(UINT), _in_array(5, AST), _in_array(2, UINT), _in(UINT), _in_array(8, AST), _in_array(8, AST)))
+    */
+    void Z3_API Z3_solver_propagate_consequences(Z3_context c, Z3_solver_callback cb, unsigned n, Z3_ast const* conseqs,
+                                                 unsigned const* num_fixed, unsigned total_fixed, Z3_ast const* fixed,
+                                                 unsigned const* num_eqs, unsigned total_eqs, Z3_ast const* eq_lhs, Z3_ast const* eq_rhs);
+
     /**
        \brief Check whether the assertions in a given solver are consistent or not.
 
@@ -7118,6 +7319,34 @@ extern "C" {
 
     Z3_ast_vector Z3_API Z3_solver_cube(Z3_context c, Z3_solver s, Z3_ast_vector vars, unsigned backtrack_level);
 
+    /**
+       \brief retrieve the next open cube of a streaming cube generator for the solver.
+       The generator is created by the first call, which also fixes the vector of
+       variables used for cubing. An empty vector lets the cuber choose among all variables.
+       Unlike #Z3_solver_cube, the caller does not track backtrack levels: cubes that
+       were reported refuted by #Z3_solver_refute_cube, or that extend a refuted cube,
+       are not returned, and the cuber backtracks past them.
+
+       The result is a cube to solve, or the single constant \c false if there are no
+       further cubes, or the single constant \c true if the cuber found the assertions
+       satisfiable. If the cuber cannot split, the empty cube is returned once.
+       Assertions should be added before the first call.
+
+       def_API('Z3_solver_next_cube', AST_VECTOR, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR)))
+    */
+    Z3_ast_vector Z3_API Z3_solver_next_cube(Z3_context c, Z3_solver s, Z3_ast_vector vars);
+
+    /**
+       \brief report a cube, or a prefix of a cube, returned by #Z3_solver_next_cube
+       as unsatisfiable. The generator closes it and every cube below it, and closes
+       a cube whose extensions by a literal and its negation are both closed.
+       Returns true if all cubes of the generator are closed, that is, the assertions
+       are unsatisfiable.
+
+       def_API('Z3_solver_refute_cube', BOOL, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR)))
+    */
+    bool Z3_API Z3_solver_refute_cube(Z3_context c, Z3_solver s, Z3_ast_vector cube);
+
     /**
        \brief Retrieve the model for the last #Z3_solver_check or #Z3_solver_check_assumptions
 
@@ -67,6 +67,18 @@ extern "C" {
     */
     Z3_ast Z3_API Z3_ast_vector_get(Z3_context c, Z3_ast_vector v, unsigned i);
 
+    /**
+       \brief Store the ASTs of the AST vector \c v in \c result.
+
+       The ASTs are owned by \c v, they remain valid as long as \c v is not
+       modified or deleted.
+
+       \pre sz == Z3_ast_vector_size(c, v)
+
+       def_API('Z3_ast_vector_to_array', VOID, (_in(CONTEXT), _in(AST_VECTOR), _in(UINT), _out_array(2, AST)))
+    */
+    void Z3_API Z3_ast_vector_to_array(Z3_context c, Z3_ast_vector v, unsigned sz, Z3_ast result[]);
+
     /**
        \brief Update position \c i of the AST vector \c v with the AST \c a.
 
@@ -104,6 +116,16 @@ extern "C" {
     */
     Z3_string Z3_API Z3_ast_vector_to_string(Z3_context c, Z3_ast_vector v);
 
+    /**
+       \brief Write the expressions in the AST vector to \c file_name in a compact binary format.
+       The file can be loaded using #Z3_parse_binary, without re-parsing or type checking.
+
+       Algebraic datatypes, recursive functions and lambda expressions are not supported.
+
+       def_API('Z3_ast_vector_serialize', VOID, (_in(CONTEXT), _in(AST_VECTOR), _in(STRING)))
+    */
+    void Z3_API Z3_ast_vector_serialize(Z3_context c, Z3_ast_vector v, Z3_string file_name);
+
     /**@}*/
 
     /** @name AST maps */
@@ -36,7 +36,7 @@ void throw_invalid_reference() {
 
 struct z3_replayer::imp {
     z3_replayer &            m_owner;
-    std::istream &           m_stream;
+    std::streambuf *         m_buf;        // characters are read directly from the buffer of the input stream
     int                      m_curr;  // current char;
     int                      m_line;  // line
     svector<char>            m_string;
@@ -111,10 +111,11 @@ struct z3_replayer::imp {
     vector<svector<Z3_symbol> > m_sym_arrays;
     vector<unsigned_vector>     m_unsigned_arrays;
     vector<svector<int> >       m_int_arrays;
+    mutable vector<svector<uint64_t> > m_uint64_arrays;
 
     imp(z3_replayer & o, std::istream & in):
         m_owner(o),
-        m_stream(in),
+        m_buf(in.rdbuf()),
         m_curr(0),
         m_line(1) {
         next();
@@ -163,7 +164,7 @@ struct z3_replayer::imp {
 
     int curr() const { return m_curr; }
     void new_line() { m_line++; }
-    void next() { m_curr = m_stream.get(); }
+    void next() { m_curr = m_buf->sbumpc(); }
 
     void read_string_core(char delimiter) {
         if (curr() != delimiter)
@@ -632,6 +633,16 @@ struct z3_replayer::imp {
         return m_unsigned_arrays[idx].data();
     }
 
+    // uint64 arrays are only used as output arrays, they are logged as unsigned arrays
+    uint64_t * get_uint64_array(unsigned pos) const {
+        check_arg(pos, UINT_ARRAY);
+        unsigned idx = static_cast<unsigned>(m_args[pos].m_uint);
+        m_uint64_arrays.push_back(svector<uint64_t>());
+        for (unsigned u : m_unsigned_arrays[idx])
+            m_uint64_arrays.back().push_back(u);
+        return m_uint64_arrays.back().data();
+    }
+
     int * get_int_array(unsigned pos) const {
         check_arg(pos, INT_ARRAY);
         unsigned idx = static_cast<unsigned>(m_args[pos].m_uint);
@@ -709,6 +720,7 @@ struct z3_replayer::imp {
         m_sym_arrays.reset();
         m_unsigned_arrays.reset();
         m_int_arrays.reset();
+        m_uint64_arrays.reset();
     }
 
 
@@ -771,6 +783,10 @@ unsigned * z3_replayer::get_uint_array(unsigned pos) const {
     return m_imp->get_uint_array(pos);
 }
 
+uint64_t * z3_replayer::get_uint64_array(unsigned pos) const {
+    return m_imp->get_uint64_array(pos);
+}
+
 int * z3_replayer::get_int_array(unsigned pos) const {
     return m_imp->get_int_array(pos);
 }
@@ -341,7 +341,8 @@ app_flags app::g_constant_flags = mk_const_flags();
 app::app(func_decl * decl, unsigned num_args, expr * const * args):
     expr(AST_APP),
     m_decl(decl),
-    m_num_args(num_args) {
+    m_num_args(num_args),
+    m_flags(g_constant_flags) {
     for (unsigned i = 0; i < num_args; i++)
         m_args[i] = args[i];
 }
@@ -1307,7 +1308,7 @@ decl_plugin * user_sort_plugin::mk_fresh() {
 ast_manager::ast_manager(proof_gen_mode m, char const * trace_file, bool is_format_manager):
     m_alloc("ast_manager"),
     m_expr_array_manager(*this, m_alloc),
-    m_expr_dependency_manager(*this, m_alloc),
+    m_expr_dependency_manager(*this, m_alloc, true),
     m_expr_dependency_array_manager(*this, m_alloc),
     m_proof_mode(m),
     m_trace_stream(nullptr),
@@ -1330,7 +1331,7 @@ ast_manager::ast_manager(proof_gen_mode m, char const * trace_file, bool is_form
 ast_manager::ast_manager(proof_gen_mode m, std::fstream * trace_stream, bool is_format_manager):
     m_alloc("ast_manager"),
     m_expr_array_manager(*this, m_alloc),
-    m_expr_dependency_manager(*this, m_alloc),
+    m_expr_dependency_manager(*this, m_alloc, true),
     m_expr_dependency_array_manager(*this, m_alloc),
     m_proof_mode(m),
     m_trace_stream(trace_stream),
@@ -1347,7 +1348,7 @@ ast_manager::ast_manager(proof_gen_mode m, std::fstream * trace_stream, bool is_
 ast_manager::ast_manager(ast_manager const & src, bool disable_proofs):
     m_alloc("ast_manager"),
     m_expr_array_manager(*this, m_alloc),
-    m_expr_dependency_manager(*this, m_alloc),
+    m_expr_dependency_manager(*this, m_alloc, true),
     m_expr_dependency_array_manager(*this, m_alloc),
     m_proof_mode(disable_proofs ? PGM_DISABLED : src.m_proof_mode),
     m_trace_stream(src.m_trace_stream),
@@ -1416,11 +1417,16 @@ static void mark_array_ref(ast_mark& mark, unsigned sz, parameter const * a) {
 ast_manager::~ast_manager() {
     SASSERT(is_format_manager() || !m_family_manager.has_family(symbol("format")));
 
+    set_rewrite_cache(nullptr);
+    while (!m_generation_lim.empty())
+        pop_generation();
+
     dec_ref(m_bool_sort);
     dec_ref(m_proof_sort);
     dec_ref(m_true);
     dec_ref(m_false);
     dec_ref(m_undef_proof);
+    m_lazy_plugins.reset();
     for (decl_plugin* p : m_plugins) {
         if (p)
             p->finalize();
@@ -1576,6 +1582,12 @@ void ast_manager::copy_families_plugins(ast_manager const & from) {
               if (m_family_manager.has_family(fid)) tout << get_family_id(fid_name) << "\n";);
         TRACE("copy_families_plugins", tout << "target fid: " << get_family_id(fid_name) << "\n";);
         SASSERT(fid == get_family_id(fid_name));
+        if (!from.m_plugins.get(fid, nullptr) && from.m_lazy_plugins.get(fid, nullptr)) {
+            // the plugin was never used in from, so there is nothing to inherit
+            if (!m_plugins.get(fid, nullptr))
+                m_lazy_plugins.setx(fid, from.m_lazy_plugins[fid], nullptr);
+            continue;
+        }
         if (from.has_plugin(fid) && !has_plugin(fid)) {
             decl_plugin * new_p = from.get_plugin(fid)->mk_fresh();
             register_plugin(fid, new_p);
@@ -1621,8 +1633,20 @@ void ast_manager::register_plugin(symbol const & s, decl_plugin * plugin) {
     register_plugin(id, plugin);
 }
 
+void ast_manager::register_lazy_plugin(symbol const & s, decl_plugin * (*mk)()) {
+    family_id id = m_family_manager.mk_family_id(s);
+    if (m_plugins.get(id, nullptr) || m_lazy_plugins.get(id, nullptr))
+        return;
+    m_lazy_plugins.setx(id, mk, nullptr);
+}
+
 decl_plugin * ast_manager::get_plugin(family_id fid) const {
-    return m_plugins.get(fid, 0);
+    decl_plugin * p = m_plugins.get(fid, nullptr);
+    if (!p && fid >= 0 && m_lazy_plugins.get(fid, nullptr)) {
+        p = m_lazy_plugins[fid]();
+        const_cast<ast_manager*>(this)->register_plugin(fid, p);
+    }
+    return p;
 }
 
 
@@ -1687,6 +1711,8 @@ quantifier* ast_manager::is_lambda_def(func_decl* f) {
 
 void ast_manager::register_plugin(family_id id, decl_plugin * plugin) {
     SASSERT(m_plugins.get(id, 0) == 0);
+    if (id < static_cast<int>(m_lazy_plugins.size()))
+        m_lazy_plugins[id] = nullptr;
     m_plugins.setx(id, plugin, 0);
     plugin->set_manager(this, id);
 }
@@ -1728,6 +1754,7 @@ static void track_id(ast_manager& m, ast* n, unsigned id) {
 #endif
 
 ast * ast_manager::register_node_core(ast * n) {
+    SASSERT(!m_frozen);
     unsigned h = get_node_hash(n);
     n->m_hash = h;
 #ifdef Z3DEBUG
@@ -1846,6 +1873,37 @@ ast * ast_manager::register_node_core(ast * n) {
 }
 
 
+void ast_manager::defer_node(ast * n) {
+    // the generation holds one reference, so n is deferred at most once
+    n->inc_ref();
+    m_deferred.push_back(n);
+    if (m_deferred.size() > m_generation_lim.back() + (1u << 16))
+        release_deferred(m_generation_lim.back());
+}
+
+void ast_manager::release_deferred(unsigned lim) {
+    ast * last = nullptr;
+    for (unsigned i = m_deferred.size(); i-- > lim; ) {
+        ast * n = m_deferred[i];
+        n->dec_ref();
+        if (n->get_ref_count() > 0)
+            continue;
+        if (last)
+            m_ast_table.push_erase(last);
+        last = n;
+    }
+    m_deferred.shrink(lim);
+    if (last)
+        delete_node(last);
+}
+
+void ast_manager::pop_generation() {
+    SASSERT(!m_generation_lim.empty());
+    unsigned lim = m_generation_lim.back();
+    m_generation_lim.pop_back();
+    release_deferred(lim);
+}
+
 void ast_manager::delete_node(ast * n) {
     TRACE("delete_node_bug", tout << mk_ll_pp(n, *this) << "\n";);
 
@@ -705,18 +705,18 @@ class app : public expr {
 
     func_decl *  m_decl;
     unsigned     m_num_args;
+    app_flags    m_flags;       // fills the padding between m_num_args and m_args on 64-bit platforms
     expr *       m_args[0];
 
     static app_flags g_constant_flags;
 
-    // remark: store term depth in the end of the app. the depth is only stored if the num_args > 0
     static unsigned get_obj_size(unsigned num_args) {
-        return num_args == 0 ? sizeof(app) : sizeof(app) + num_args * sizeof(expr *) + sizeof(app_flags);
+        return sizeof(app) + num_args * sizeof(expr *);
     }
 
     friend class tmp_app;
 
-    app_flags * flags() const { return m_num_args == 0 ? &g_constant_flags : reinterpret_cast<app_flags*>(const_cast<expr**>(m_args + m_num_args)); }
+    app_flags * flags() const { return const_cast<app_flags*>(&m_flags); }
 
     app(func_decl * decl, unsigned num_args, expr * const * args);
 public:
@@ -1434,6 +1434,16 @@ enum proof_gen_mode {
     PGM_ENABLED
 };
 
+/**
+   \brief An object whose lifetime is bound to an ast_manager, such as a
+   cache of rewrite results shared by several rewriters. It is deleted
+   before the ASTs of the manager are reclaimed.
+*/
+class ast_manager_extension {
+public:
+    virtual ~ast_manager_extension() = default;
+};
+
 // -----------------------------------
 //
 // ast_manager
@@ -1495,6 +1505,7 @@ protected:
     expr_dependency_manager   m_expr_dependency_manager;
     expr_dependency_array_manager m_expr_dependency_array_manager;
     ptr_vector<decl_plugin>   m_plugins;
+    svector<decl_plugin*(*)()> m_lazy_plugins;   // family id -> constructor of a plugin that is created on first use
     proof_gen_mode            m_proof_mode;
     bool                      m_int_real_coercions; // If true, use hack that automatically introduces to_int/to_real when needed.
     ast_table                 m_ast_table;
@@ -1508,6 +1519,9 @@ protected:
     proof *                   m_undef_proof;
     unsigned                  m_fresh_id;
     bool                      m_debug_ref_count;
+    bool                      m_frozen = false;
+    ptr_vector<ast>           m_deferred;       // nodes kept alive by the open generations
+    unsigned_vector           m_generation_lim;
     u_map<unsigned>           m_debug_free_indices;
     std::fstream*             m_trace_stream;
     bool                      m_trace_stream_owner;
@@ -1516,6 +1530,7 @@ protected:
 #endif
     ast_manager *             m_format_manager; // hack for isolating format objects in a different manager.
     symbol                    m_lambda_def;
+    ast_manager_extension *   m_rewrite_cache = nullptr;
 
     void init();
 
@@ -1532,6 +1547,9 @@ public:
 
     // propagate cancellation signal to decl_plugins
 
+    ast_manager_extension * get_rewrite_cache() const { return m_rewrite_cache; }
+    void set_rewrite_cache(ast_manager_extension * c) { dealloc(m_rewrite_cache); m_rewrite_cache = c; }
+
     bool has_trace_stream() const { return m_trace_stream != nullptr; }
     std::ostream & trace_stream() { SASSERT(has_trace_stream()); return *m_trace_stream; }
     struct suspend_trace {
@@ -1589,6 +1607,13 @@ public:
 
     void register_plugin(family_id id, decl_plugin * plugin);
 
+    /**
+       \brief register the family s, and create its plugin with mk the
+       first time it is requested by get_plugin. Nothing is done if the
+       family already has a plugin.
+    */
+    void register_lazy_plugin(symbol const & s, decl_plugin * (*mk)());
+
     decl_plugin * get_plugin(family_id fid) const;
 
     bool has_plugin(family_id fid) const { return get_plugin(fid) != nullptr; }
@@ -1638,19 +1663,46 @@ public:
 
     void debug_ref_count() { m_debug_ref_count = true; }
 
+    /**
+       \brief freeze or thaw the manager.
+       A frozen manager does not create or delete nodes and ignores reference
+       counting, so several threads can read, traverse and translate its
+       nodes at once. New terms are created in a manager of each thread, see
+       model_scratch. References to nodes of the manager that are taken
+       while it is frozen must be released before it is thawed.
+     */
+    void freeze(bool f) { m_frozen = f; }
+    bool is_frozen() const { return m_frozen; }
+
     void inc_ref(ast* n) {
-        if (n) 
+        if (n && !m_frozen)
             n->inc_ref();
     }
     
     void dec_ref(ast* n) {
-        if (n) {
+        if (n && !m_frozen) {
             n->dec_ref();
-            if (n->get_ref_count() == 0)
-                delete_node(n);
+            if (n->get_ref_count() == 0) {
+                if (m_generation_lim.empty())
+                    delete_node(n);
+                else
+                    defer_node(n);
+            }
         }
     }
 
+    /**
+       \brief open a generation of scratch terms.
+       Nodes released while a generation is open are not deleted right
+       away: a temporary that is built again before the generation is
+       closed is found by hash-consing instead of being allocated and
+       internalized anew, and the released nodes are deleted together when
+       the generation is closed. Generations nest. A generation that
+       accumulates too many released nodes deletes them early.
+     */
+    void push_generation() { m_generation_lim.push_back(m_deferred.size()); }
+    void pop_generation();
+
     template<typename T>
     void inc_array_ref(unsigned sz, T * const * a) {
         for(unsigned i = 0; i < sz; i++) {
@@ -1682,6 +1734,8 @@ protected:
     }
 
     void delete_node(ast * n);
+    void defer_node(ast * n);
+    void release_deferred(unsigned lim);
 
     void * allocate_node(unsigned size) {
         return m_alloc.allocate(size);
@@ -2623,6 +2677,16 @@ public:
     void pop_scope(unsigned num_scopes);
 };
 
+/**
+   \brief generation of scratch terms, see ast_manager::push_generation.
+*/
+class scoped_ast_generation {
+    ast_manager & m;
+public:
+    scoped_ast_generation(ast_manager & m): m(m) { m.push_generation(); }
+    ~scoped_ast_generation() { m.pop_generation(); }
+};
+
 // -------------------------------------
 //
 // inc_ref & dec_ref functors
@@ -0,0 +1,688 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.cpp
+
+Abstract:
+
+    Compact binary serialization of expression DAGs.
+
+--*/
+
+#include <fstream>
+#include <cstring>
+#include "util/map.h"
+#include "ast/ast_binary.h"
+
+#ifndef _WINDOWS
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    const unsigned char ast_binary_version = 1;
+
+    enum node_kind {
+        N_SORT,
+        N_FUNC_DECL,
+        N_VAR,
+        N_APP,
+        N_QUANTIFIER
+    };
+
+    enum symbol_kind {
+        S_NULL,
+        S_NUM,
+        S_STR
+    };
+
+    enum sort_size_kind {
+        SZ_FINITE,
+        SZ_VERY_BIG,
+        SZ_INFINITE
+    };
+
+    enum decl_flags {
+        F_LEFT_ASSOC    = 1 << 0,
+        F_RIGHT_ASSOC   = 1 << 1,
+        F_FLAT_ASSOC    = 1 << 2,
+        F_COMMUTATIVE   = 1 << 3,
+        F_CHAINABLE     = 1 << 4,
+        F_PAIRWISE      = 1 << 5,
+        F_INJECTIVE     = 1 << 6,
+        F_SKOLEM        = 1 << 7,
+        F_IDEMPOTENT    = 1 << 8,
+        F_HAS_INFO      = 1 << 9
+    };
+
+    class writer {
+        typedef map<symbol, unsigned, symbol_hash_proc, symbol_eq_proc> symbol2idx;
+        ast_manager &          m;
+        obj_map<ast, unsigned> m_ids;
+        symbol2idx             m_symbol2idx;
+        svector<symbol>        m_symbols;
+        std::string            m_nodes;
+        ptr_vector<ast>        m_todo;
+
+        static void put_u32(std::string & out, unsigned v) {
+            for (unsigned i = 0; i < 4; ++i, v >>= 8)
+                out.push_back(static_cast<char>(v & 0xFF));
+        }
+
+        static void put_u64(std::string & out, uint64_t v) {
+            put_u32(out, static_cast<unsigned>(v));
+            put_u32(out, static_cast<unsigned>(v >> 32));
+        }
+
+        void u8(unsigned char v) { m_nodes.push_back(static_cast<char>(v)); }
+        void u32(unsigned v) { put_u32(m_nodes, v); }
+        void u64(uint64_t v) { put_u64(m_nodes, v); }
+        void bytes(std::string const & s) { u32(static_cast<unsigned>(s.size())); m_nodes.append(s); }
+        void id(ast * n) { u32(m_ids[n]); }
+
+        void sym(symbol const & s) {
+            unsigned idx;
+            if (!m_symbol2idx.find(s, idx)) {
+                idx = m_symbols.size();
+                m_symbols.push_back(s);
+                m_symbol2idx.insert(s, idx);
+            }
+            u32(idx);
+        }
+
+        void check_family(family_id fid) {
+            if (fid == null_family_id)
+                return;
+            symbol const & name = m.get_family_name(fid);
+            if (name == "datatype" || name == "recfun")
+                throw default_exception(std::string("binary format does not support ") + name.str());
+        }
+
+        void visit(ast * n) {
+            if (!m_ids.contains(n))
+                m_todo.push_back(n);
+        }
+
+        void visit_params(decl * d) {
+            for (parameter const & p : d->parameters())
+                if (p.is_ast())
+                    visit(p.get_ast());
+        }
+
+        void visit_children(ast * n) {
+            switch (n->get_kind()) {
+            case AST_SORT:
+                visit_params(to_sort(n));
+                break;
+            case AST_FUNC_DECL: {
+                func_decl * f = to_func_decl(n);
+                visit_params(f);
+                for (sort * s : *f)
+                    visit(s);
+                visit(f->get_range());
+                break;
+            }
+            case AST_VAR:
+                visit(to_var(n)->get_sort());
+                break;
+            case AST_APP:
+                visit(to_app(n)->get_decl());
+                for (expr * arg : *to_app(n))
+                    visit(arg);
+                break;
+            case AST_QUANTIFIER: {
+                quantifier * q = to_quantifier(n);
+                for (unsigned i = 0; i < q->get_num_decls(); ++i)
+                    visit(q->get_decl_sort(i));
+                visit(q->get_expr());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    visit(q->get_pattern(i));
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    visit(q->get_no_pattern(i));
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+        }
+
+        void params(decl * d) {
+            u32(d->get_num_parameters());
+            for (parameter const & p : d->parameters()) {
+                u8(static_cast<unsigned char>(p.get_kind()));
+                switch (p.get_kind()) {
+                case parameter::PARAM_INT:
+                    u32(static_cast<unsigned>(p.get_int()));
+                    break;
+                case parameter::PARAM_AST:
+                    id(p.get_ast());
+                    break;
+                case parameter::PARAM_SYMBOL:
+                    sym(p.get_symbol());
+                    break;
+                case parameter::PARAM_ZSTRING: {
+                    zstring const & s = p.get_zstring();
+                    u32(s.length());
+                    for (unsigned i = 0; i < s.length(); ++i)
+                        u32(s[i]);
+                    break;
+                }
+                case parameter::PARAM_RATIONAL:
+                    bytes(p.get_rational().to_string());
+                    break;
+                case parameter::PARAM_DOUBLE: {
+                    double d = p.get_double();
+                    uint64_t v;
+                    memcpy(&v, &d, sizeof(v));
+                    u64(v);
+                    break;
+                }
+                default:
+                    throw default_exception("binary format does not support plugin specific parameters");
+                }
+            }
+        }
+
+        void emit_sort(sort * s) {
+            sort_info * si = s->get_info();
+            u8(N_SORT);
+            sym(s->get_name());
+            if (!si || si->get_family_id() == null_family_id) {
+                sym(symbol::null);
+                return;
+            }
+            check_family(si->get_family_id());
+            sym(m.get_family_name(si->get_family_id()));
+            u32(static_cast<unsigned>(si->get_decl_kind()));
+            sort_size const & sz = si->get_num_elements();
+            if (sz.is_finite()) {
+                u8(SZ_FINITE);
+                u64(sz.size());
+            }
+            else
+                u8(sz.is_very_big() ? SZ_VERY_BIG : SZ_INFINITE);
+            u8(si->private_parameters());
+            params(s);
+        }
+
+        void emit_func_decl(func_decl * f) {
+            func_decl_info * fi = f->get_info();
+            unsigned flags = 0;
+            if (fi) {
+                if (fi->is_lambda())
+                    throw default_exception("binary format does not support lambda declarations");
+                check_family(fi->get_family_id());
+                flags |= F_HAS_INFO;
+                if (fi->is_left_associative())  flags |= F_LEFT_ASSOC;
+                if (fi->is_right_associative()) flags |= F_RIGHT_ASSOC;
+                if (fi->is_flat_associative())  flags |= F_FLAT_ASSOC;
+                if (fi->is_commutative())       flags |= F_COMMUTATIVE;
+                if (fi->is_chainable())         flags |= F_CHAINABLE;
+                if (fi->is_pairwise())          flags |= F_PAIRWISE;
+                if (fi->is_injective())         flags |= F_INJECTIVE;
+                if (fi->is_skolem())            flags |= F_SKOLEM;
+                if (fi->is_idempotent())        flags |= F_IDEMPOTENT;
+            }
+            u8(N_FUNC_DECL);
+            sym(f->get_name());
+            u32(f->get_arity());
+            for (sort * s : *f)
+                id(s);
+            id(f->get_range());
+            u32(flags);
+            if (fi) {
+                sym(m.get_family_name(fi->get_family_id()));
+                u32(static_cast<unsigned>(fi->get_decl_kind()));
+                params(f);
+            }
+        }
+
+        void emit(ast * n) {
+            switch (n->get_kind()) {
+            case AST_SORT:
+                emit_sort(to_sort(n));
+                break;
+            case AST_FUNC_DECL:
+                emit_func_decl(to_func_decl(n));
+                break;
+            case AST_VAR:
+                u8(N_VAR);
+                u32(to_var(n)->get_idx());
+                id(to_var(n)->get_sort());
+                break;
+            case AST_APP:
+                u8(N_APP);
+                id(to_app(n)->get_decl());
+                u32(to_app(n)->get_num_args());
+                for (expr * arg : *to_app(n))
+                    id(arg);
+                break;
+            case AST_QUANTIFIER: {
+                quantifier * q = to_quantifier(n);
+                if (q->get_kind() == lambda_k)
+                    throw default_exception("binary format does not support lambda expressions");
+                u8(N_QUANTIFIER);
+                u8(q->get_kind() == forall_k ? 0 : 1);
+                u32(q->get_num_decls());
+                for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+                    sym(q->get_decl_name(i));
+                    id(q->get_decl_sort(i));
+                }
+                id(q->get_expr());
+                u32(static_cast<unsigned>(q->get_weight()));
+                sym(q->get_qid());
+                sym(q->get_skid());
+                u32(q->get_num_patterns());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    id(q->get_pattern(i));
+                u32(q->get_num_no_patterns());
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    id(q->get_no_pattern(i));
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+            unsigned idx = m_ids.size();
+            m_ids.insert(n, idx);
+        }
+
+        void process(ast * root) {
+            visit(root);
+            while (!m_todo.empty()) {
+                ast * n = m_todo.back();
+                if (m_ids.contains(n)) {
+                    m_todo.pop_back();
+                    continue;
+                }
+                unsigned sz = m_todo.size();
+                visit_children(n);
+                if (sz == m_todo.size()) {
+                    m_todo.pop_back();
+                    emit(n);
+                }
+            }
+        }
+
+    public:
+        writer(ast_manager & m): m(m) {}
+
+        void operator()(unsigned n, expr * const * es, std::ostream & out) {
+            for (unsigned i = 0; i < n; ++i)
+                process(es[i]);
+
+            std::string header("Z3B");
+            header.push_back(static_cast<char>(ast_binary_version));
+            put_u32(header, m_symbols.size());
+            put_u32(header, m_ids.size());
+            put_u32(header, n);
+            for (symbol const & s : m_symbols) {
+                if (s.is_null())
+                    header.push_back(S_NULL);
+                else if (s.is_numerical()) {
+                    header.push_back(S_NUM);
+                    put_u32(header, s.get_num());
+                }
+                else {
+                    std::string str = s.str();
+                    header.push_back(S_STR);
+                    put_u32(header, static_cast<unsigned>(str.size()));
+                    header.append(str);
+                }
+            }
+            out.write(header.data(), header.size());
+            out.write(m_nodes.data(), m_nodes.size());
+            std::string roots;
+            for (unsigned i = 0; i < n; ++i)
+                put_u32(roots, m_ids[es[i]]);
+            out.write(roots.data(), roots.size());
+        }
+    };
+
+    class reader {
+        ast_manager &     m;
+        unsigned char const * m_pos;
+        unsigned char const * m_end;
+        svector<symbol>   m_symbols;
+        ast_ref_vector    m_nodes;
+        vector<parameter> m_params;
+        ptr_vector<sort>  m_sorts;
+        ptr_vector<expr>  m_args;
+        svector<symbol>   m_names;
+        ptr_vector<expr>  m_patterns;
+        ptr_vector<expr>  m_no_patterns;
+
+        [[noreturn]] static void fail(char const * msg = "invalid binary AST file") {
+            throw default_exception(msg);
+        }
+
+        void need(size_t n) {
+            if (static_cast<size_t>(m_end - m_pos) < n)
+                fail();
+        }
+
+        unsigned u8() {
+            need(1);
+            return *m_pos++;
+        }
+
+        unsigned u32() {
+            need(4);
+            unsigned v = m_pos[0] | (m_pos[1] << 8) | (m_pos[2] << 16) | (static_cast<unsigned>(m_pos[3]) << 24);
+            m_pos += 4;
+            return v;
+        }
+
+        uint64_t u64() {
+            uint64_t lo = u32();
+            uint64_t hi = u32();
+            return lo | (hi << 32);
+        }
+
+        std::string bytes() {
+            unsigned len = u32();
+            need(len);
+            std::string r(reinterpret_cast<char const *>(m_pos), len);
+            m_pos += len;
+            return r;
+        }
+
+        symbol sym() {
+            unsigned idx = u32();
+            if (idx >= m_symbols.size())
+                fail();
+            return m_symbols[idx];
+        }
+
+        ast * node() {
+            unsigned idx = u32();
+            if (idx >= m_nodes.size())
+                fail();
+            return m_nodes.get(idx);
+        }
+
+        sort * srt() {
+            ast * n = node();
+            if (!is_sort(n))
+                fail();
+            return to_sort(n);
+        }
+
+        expr * exp() {
+            ast * n = node();
+            if (!is_expr(n))
+                fail();
+            return to_expr(n);
+        }
+
+        family_id family() {
+            symbol name = sym();
+            if (name.is_null())
+                return null_family_id;
+            if (!m.has_plugin(name))
+                fail("binary AST file uses an unknown theory");
+            return m.get_family_id(name);
+        }
+
+        void params() {
+            m_params.reset();
+            unsigned n = u32();
+            for (unsigned i = 0; i < n; ++i) {
+                switch (u8()) {
+                case parameter::PARAM_INT:
+                    m_params.push_back(parameter(static_cast<int>(u32())));
+                    break;
+                case parameter::PARAM_AST:
+                    m_params.push_back(parameter(node()));
+                    break;
+                case parameter::PARAM_SYMBOL:
+                    m_params.push_back(parameter(sym()));
+                    break;
+                case parameter::PARAM_ZSTRING: {
+                    unsigned len = u32();
+                    need(4ull * len);
+                    unsigned_vector chars;
+                    for (unsigned j = 0; j < len; ++j) {
+                        unsigned ch = u32();
+                        if (ch > zstring::unicode_max_char())
+                            fail();
+                        chars.push_back(ch);
+                    }
+                    m_params.push_back(parameter(zstring(len, chars.data())));
+                    break;
+                }
+                case parameter::PARAM_RATIONAL:
+                    m_params.push_back(parameter(rational(bytes().c_str())));
+                    break;
+                case parameter::PARAM_DOUBLE: {
+                    uint64_t v = u64();
+                    double d;
+                    memcpy(&d, &v, sizeof(d));
+                    m_params.push_back(parameter(d));
+                    break;
+                }
+                default:
+                    fail();
+                }
+            }
+        }
+
+        sort * read_sort() {
+            symbol name = sym();
+            symbol fam = sym();
+            if (fam.is_null())
+                return m.mk_uninterpreted_sort(name);
+            if (!m.has_plugin(fam))
+                fail("binary AST file uses an unknown theory");
+            family_id fid = m.get_family_id(fam);
+            decl_kind k = static_cast<decl_kind>(u32());
+            sort_size sz;
+            switch (u8()) {
+            case SZ_FINITE:   sz = sort_size::mk_finite(u64()); break;
+            case SZ_VERY_BIG: sz = sort_size::mk_very_big(); break;
+            case SZ_INFINITE: sz = sort_size::mk_infinite(); break;
+            default: fail();
+            }
+            bool private_params = u8() != 0;
+            params();
+            if (fid == user_sort_family_id)
+                return m.mk_uninterpreted_sort(name, m_params.size(), m_params.data());
+            return m.mk_sort(name, sort_info(fid, k, sz, m_params.size(), m_params.data(), private_params));
+        }
+
+        func_decl * read_func_decl() {
+            symbol name = sym();
+            unsigned arity = u32();
+            need(4ull * arity);
+            m_sorts.reset();
+            for (unsigned i = 0; i < arity; ++i)
+                m_sorts.push_back(srt());
+            sort * range = srt();
+            unsigned flags = u32();
+            if (!(flags & F_HAS_INFO))
+                return m.mk_func_decl(name, arity, m_sorts.data(), range);
+            family_id fid = family();
+            decl_kind k = static_cast<decl_kind>(u32());
+            params();
+            func_decl_info fi(fid, k, m_params.size(), m_params.data());
+            fi.set_left_associative(0 != (flags & F_LEFT_ASSOC));
+            fi.set_right_associative(0 != (flags & F_RIGHT_ASSOC));
+            fi.set_flat_associative(0 != (flags & F_FLAT_ASSOC));
+            fi.set_commutative(0 != (flags & F_COMMUTATIVE));
+            fi.set_chainable(0 != (flags & F_CHAINABLE));
+            fi.set_pairwise(0 != (flags & F_PAIRWISE));
+            fi.set_injective(0 != (flags & F_INJECTIVE));
+            fi.set_skolem(0 != (flags & F_SKOLEM));
+            fi.set_idempotent(0 != (flags & F_IDEMPOTENT));
+            return m.mk_func_decl(name, arity, m_sorts.data(), range, fi);
+        }
+
+        app * read_app() {
+            ast * f = node();
+            if (!is_func_decl(f))
+                fail();
+            unsigned n = u32();
+            need(4ull * n);
+            m_args.reset();
+            for (unsigned i = 0; i < n; ++i)
+                m_args.push_back(exp());
+            return m.mk_app(to_func_decl(f), n, m_args.data());
+        }
+
+        quantifier * read_quantifier() {
+            quantifier_kind k = u8() == 0 ? forall_k : exists_k;
+            unsigned n = u32();
+            need(8ull * n);
+            m_names.reset();
+            m_sorts.reset();
+            for (unsigned i = 0; i < n; ++i) {
+                m_names.push_back(sym());
+                m_sorts.push_back(srt());
+            }
+            expr * body = exp();
+            int weight = static_cast<int>(u32());
+            symbol qid = sym();
+            symbol skid = sym();
+            m_patterns.reset();
+            m_no_patterns.reset();
+            unsigned np = u32();
+            need(4ull * np);
+            for (unsigned i = 0; i < np; ++i)
+                m_patterns.push_back(exp());
+            unsigned nnp = u32();
+            need(4ull * nnp);
+            for (unsigned i = 0; i < nnp; ++i)
+                m_no_patterns.push_back(exp());
+            return m.mk_quantifier(k, n, m_sorts.data(), m_names.data(), body, weight, qid, skid,
+                                   np, m_patterns.data(), nnp, m_no_patterns.data());
+        }
+
+    public:
+        reader(ast_manager & m, char const * data, size_t size):
+            m(m),
+            m_pos(reinterpret_cast<unsigned char const *>(data)),
+            m_end(reinterpret_cast<unsigned char const *>(data) + size),
+            m_nodes(m) {}
+
+        void operator()(expr_ref_vector & result) {
+            need(4);
+            if (memcmp(m_pos, "Z3B", 3) != 0)
+                fail();
+            m_pos += 3;
+            if (u8() != ast_binary_version)
+                fail("unsupported version of binary AST file");
+            unsigned num_symbols = u32();
+            unsigned num_nodes = u32();
+            unsigned num_roots = u32();
+            need(num_symbols);
+            for (unsigned i = 0; i < num_symbols; ++i) {
+                switch (u8()) {
+                case S_NULL: m_symbols.push_back(symbol::null); break;
+                case S_NUM:  m_symbols.push_back(symbol(u32())); break;
+                case S_STR:  m_symbols.push_back(symbol(bytes().c_str())); break;
+                default: fail();
+                }
+            }
+            need(num_nodes);
+            for (unsigned i = 0; i < num_nodes; ++i) {
+                ast * n = nullptr;
+                switch (u8()) {
+                case N_SORT:
+                    n = read_sort();
+                    break;
+                case N_FUNC_DECL:
+                    n = read_func_decl();
+                    break;
+                case N_VAR: {
+                    unsigned idx = u32();
+                    n = m.mk_var(idx, srt());
+                    break;
+                }
+                case N_APP:
+                    n = read_app();
+                    break;
+                case N_QUANTIFIER:
+                    n = read_quantifier();
+                    break;
+                default:
+                    fail();
+                }
+                m_nodes.push_back(n);
+            }
+            need(4ull * num_roots);
+            for (unsigned i = 0; i < num_roots; ++i)
+                result.push_back(exp());
+            if (m_pos != m_end)
+                fail();
+        }
+    };
+
+#ifndef _WINDOWS
+    class mapped_file {
+        void * m_data = MAP_FAILED;
+        size_t m_size = 0;
+    public:
+        mapped_file(char const * file_name) {
+            int fd = open(file_name, O_RDONLY);
+            if (fd < 0)
+                return;
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size > 0) {
+                m_size = static_cast<size_t>(st.st_size);
+                m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            close(fd);
+        }
+        ~mapped_file() {
+            if (m_data != MAP_FAILED)
+                munmap(m_data, m_size);
+        }
+        bool ok() const { return m_data != MAP_FAILED; }
+        char const * data() const { return static_cast<char const *>(m_data); }
+        size_t size() const { return m_size; }
+    };
+#else
+    class mapped_file {
+        std::string m_buffer;
+        bool        m_ok = false;
+    public:
+        mapped_file(char const * file_name) {
+            std::ifstream in(file_name, std::ios::binary);
+            if (!in)
+                return;
+            m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            m_ok = !in.bad();
+        }
+        bool ok() const { return m_ok; }
+        char const * data() const { return m_buffer.data(); }
+        size_t size() const { return m_buffer.size(); }
+    };
+#endif
+
+}
+
+void ast_binary_write(ast_manager & m, unsigned n, expr * const * es, std::ostream & out) {
+    writer w(m);
+    w(n, es, out);
+}
+
+void ast_binary_read(ast_manager & m, char const * data, size_t size, expr_ref_vector & result) {
+    reader r(m, data, size);
+    r(result);
+}
+
+void ast_binary_read_file(ast_manager & m, char const * file_name, expr_ref_vector & result) {
+    mapped_file f(file_name);
+    if (!f.ok())
+        throw default_exception(std::string("could not read file ") + file_name);
+    ast_binary_read(m, f.data(), f.size(), result);
+}
+
+bool is_ast_binary(char const * data, size_t size) {
+    return size >= 4 && memcmp(data, "Z3B", 3) == 0;
+}
@@ -0,0 +1,57 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.h
+
+Abstract:
+
+    Compact binary serialization of expression DAGs.
+
+    The format stores a symbol table followed by the DAG of sorts,
+    function declarations and expressions in post-order. Every node
+    refers to its children by index, so loading a file is a single
+    linear pass over a memory mapped buffer that rebuilds the nodes
+    bottom up. Sorts and declarations are re-created directly from
+    their sort_info/func_decl_info (as ast_translation does), so no
+    parsing, name resolution or type inference is performed.
+
+    Layout (all integers are little endian):
+
+        header   : "Z3B" version:u8 num_symbols:u32 num_nodes:u32 num_roots:u32
+        symbols  : (kind:u8 [num:u32 | len:u32 bytes])*
+        nodes    : (kind:u8 payload)*
+        roots    : node-index:u32*
+
+    Algebraic datatypes, recursive functions, lambda declarations and
+    plugin specific (external) parameters are not supported.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+
+/**
+   \brief Write the expressions es[0], ..., es[n-1] to out in binary format.
+   Throws default_exception if an expression cannot be represented.
+*/
+void ast_binary_write(ast_manager & m, unsigned n, expr * const * es, std::ostream & out);
+
+/**
+   \brief Load expressions from an in-memory buffer created by ast_binary_write.
+   Throws default_exception if the buffer is malformed.
+*/
+void ast_binary_read(ast_manager & m, char const * data, size_t size, expr_ref_vector & result);
+
+/**
+   \brief Memory map file_name and load the expressions it contains.
+   Throws default_exception if the file cannot be read or is malformed.
+*/
+void ast_binary_read_file(ast_manager & m, char const * file_name, expr_ref_vector & result);
+
+/**
+   \brief Return true if the buffer starts with the binary format signature.
+*/
+bool is_ast_binary(char const * data, size_t size);
+
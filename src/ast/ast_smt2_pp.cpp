@@ -1199,6 +1199,259 @@ void mk_smt2_format(expr * n, smt2_pp_environment & env, params_ref const & p,
     pr(n, num_vars, var_prefix, r, var_names);
 }
 
+/**
+   \brief print a large term directly to a stream, without building a format.
+
+   A first traversal counts the parents of the subterms and their size,
+   capped at pp.min_alias_size. A second traversal binds the shared
+   subterms that reach that size with a let, in post-order, so every
+   binding only refers to earlier ones. The bindings are printed on
+   separate lines and the body on one line.
+   Terms with variables, quantifiers or labels are left to smt2_printer.
+*/
+class smt2_stream_printer {
+    ast_manager &                    m;
+    smt2_pp_environment &            m_env;
+    params_ref const &               m_params;
+    std::ostream &                   m_out;
+    expr *                           m_root = nullptr;
+    unsigned                         m_min_alias_size;
+    bool                             m_pp_decimal;
+    unsigned                         m_pp_decimal_precision;
+    bool                             m_pp_bv_lits;
+    bool                             m_pp_float_real_lits;
+    bool                             m_pp_bv_neg;
+    svector<uint8_t>                 m_occs;     // id -> number of parents, at most 2
+    unsigned_vector                  m_weight;   // id -> capped size, 0 if not visited
+    unsigned_vector                  m_alias;    // id -> 1 + index in m_alias_names, 0 if not bound
+    bool_vector                      m_bound;    // id -> the bindings of the subterms were printed
+    vector<std::string>              m_alias_names;
+    obj_map<func_decl, unsigned>     m_head2idx;
+    vector<std::string>              m_heads;
+    unsigned                         m_next_alias_idx = 0;
+
+    template<typename T>
+    static void ensure(T & v, unsigned id) {
+        if (id >= v.size())
+            v.resize(id + 1, 0);
+    }
+
+    unsigned weight(expr * e) const { return m_weight.get(e->get_id(), 0); }
+
+    bool is_alias(expr * e) const {
+        return e != m_root &&
+            to_app(e)->get_num_args() > 0 &&
+            m_occs[e->get_id()] >= 2 &&
+            m_weight[e->get_id()] >= m_min_alias_size;
+    }
+
+    static bool is_supported(ast_manager & m, expr * e) {
+        buffer<symbol> names;
+        return is_app(e) && !m.is_label_lit(e, names) && to_app(e)->get_family_id() != label_family_id;
+    }
+
+    bool count(expr * root) {
+        ptr_buffer<expr> todo;
+        todo.push_back(root);
+        while (!todo.empty()) {
+            expr * e = todo.back();
+            if (weight(e) != 0) {
+                todo.pop_back();
+                continue;
+            }
+            if (!is_supported(m, e))
+                return false;
+            bool visited = true;
+            for (expr * arg : *to_app(e)) {
+                if (weight(arg) == 0) {
+                    todo.push_back(arg);
+                    visited = false;
+                }
+            }
+            if (!visited)
+                continue;
+            todo.pop_back();
+            unsigned w = 1;
+            for (expr * arg : *to_app(e)) {
+                w += weight(arg);
+                uint8_t & o = m_occs[arg->get_id()];
+                if (o < 2)
+                    ++o;
+            }
+            unsigned id = e->get_id();
+            ensure(m_weight, id);
+            ensure(m_occs, id);
+            m_weight[id] = std::min(w, m_min_alias_size);
+        }
+        return true;
+    }
+
+    std::string const & head(func_decl * f) {
+        unsigned idx;
+        if (m_head2idx.find(f, idx))
+            return m_heads[idx];
+        unsigned len;
+        format_ref fn(m_env.pp_fdecl(f, len), fm(m));
+        std::ostringstream strm;
+        pp(strm, fn.get(), m, m_params);
+        m_head2idx.insert(f, m_heads.size());
+        m_heads.push_back(strm.str());
+        return m_heads.back();
+    }
+
+    void display_const(app * c) {
+        format_ref f(fm(m));
+        if (m_env.get_autil().is_numeral(c) || m_env.get_autil().is_irrational_algebraic_numeral(c))
+            f = m_env.pp_arith_literal(c, m_pp_decimal, m_pp_decimal_precision);
+        else if (m_env.get_sutil().str.is_string(c))
+            f = m_env.pp_string_literal(c);
+        else if (m_env.get_bvutil().is_numeral(c))
+            f = m_env.pp_bv_literal(c, m_pp_bv_lits, m_pp_bv_neg);
+        else if (m_env.get_futil().is_numeral(c))
+            f = m_env.pp_float_literal(c, m_pp_bv_lits, m_pp_float_real_lits);
+        else if (m_env.get_dlutil().is_numeral(c))
+            f = m_env.pp_datalog_literal(c);
+        else {
+            m_out << head(c->get_decl());
+            return;
+        }
+        pp(m_out, f.get(), m, m_params);
+    }
+
+    void display_term(app * t) {
+        svector<std::pair<app *, unsigned>> todo;
+        todo.push_back({ t, 0 });
+        while (!todo.empty()) {
+            auto & [e, idx] = todo.back();
+            if (idx == 0) {
+                if (e->get_num_args() == 0) {
+                    display_const(e);
+                    todo.pop_back();
+                    continue;
+                }
+                m_out << "(" << head(e->get_decl());
+            }
+            if (idx == e->get_num_args()) {
+                m_out << ")";
+                todo.pop_back();
+                continue;
+            }
+            app * arg = to_app(e->get_arg(idx++));
+            m_out << " ";
+            if (m_alias.get(arg->get_id(), 0) != 0)
+                m_out << m_alias_names[m_alias[arg->get_id()] - 1];
+            else
+                todo.push_back({ arg, 0 });
+        }
+    }
+
+    symbol next_alias() {
+        while (true) {
+            symbol r((std::string(ALIAS_PREFIX "!") + std::to_string(m_next_alias_idx++)).c_str());
+            if (!m_env.uses(r))
+                return r;
+        }
+    }
+
+    void newline(unsigned indent) {
+        m_out << "\n";
+        for (unsigned i = 0; i < indent; ++i)
+            m_out << " ";
+    }
+
+    // print the bindings of the aliases below root in post-order
+    unsigned display_lets(expr * root, unsigned indent) {
+        unsigned num_lets = 0;
+        ptr_buffer<app> todo;
+        todo.push_back(to_app(root));
+        while (!todo.empty()) {
+            app * e = todo.back();
+            if (m_bound.get(e->get_id(), false)) {
+                todo.pop_back();
+                continue;
+            }
+            bool visited = true;
+            for (expr * arg : *e) {
+                if (to_app(arg)->get_num_args() > 0 && !m_bound.get(arg->get_id(), false)) {
+                    todo.push_back(to_app(arg));
+                    visited = false;
+                }
+            }
+            if (!visited)
+                continue;
+            todo.pop_back();
+            m_bound.setx(e->get_id(), true, false);
+            if (!is_alias(e))
+                continue;
+            symbol a = next_alias();
+            m_out << "(let ((" << a << " ";
+            display_term(e);
+            m_out << "))";
+            newline(indent);
+            ensure(m_alias, e->get_id());
+            m_alias_names.push_back(a.str());
+            m_alias[e->get_id()] = m_alias_names.size();
+            ++num_lets;
+        }
+        return num_lets;
+    }
+
+public:
+    smt2_stream_printer(smt2_pp_environment & env, params_ref const & params, std::ostream & out):
+        m(env.get_manager()),
+        m_env(env),
+        m_params(params),
+        m_out(out) {
+        pp_params p(params);
+        m_pp_decimal = p.decimal();
+        m_pp_decimal_precision = p.decimal_precision();
+        m_pp_bv_lits = p.bv_literals();
+        m_pp_float_real_lits = p.fp_real_literals();
+        m_pp_bv_neg = p.bv_neg();
+        m_min_alias_size = std::max(1u, p.min_alias_size());
+    }
+
+    /**
+       \brief return true if n has at least min_size distinct subterms.
+    */
+    static bool is_large(ast_manager & m, expr * n, unsigned min_size) {
+        if (!is_app(n) || to_app(n)->get_num_args() == 0)
+            return false;
+        ptr_buffer<expr> todo;
+        obj_hashtable<expr> visited;
+        todo.push_back(n);
+        while (!todo.empty()) {
+            expr * e = todo.back();
+            todo.pop_back();
+            if (visited.contains(e))
+                continue;
+            if (!is_supported(m, e))
+                return false;
+            visited.insert(e);
+            if (visited.size() >= min_size)
+                return true;
+            for (expr * arg : *to_app(e))
+                todo.push_back(arg);
+        }
+        return false;
+    }
+
+    /**
+       \brief print n, or return false without output if n contains
+       terms that are not supported.
+    */
+    bool operator()(expr * n, unsigned indent) {
+        m_root = n;
+        if (!count(n))
+            return false;
+        unsigned num_lets = display_lets(n, indent);
+        display_term(to_app(n));
+        for (unsigned i = 0; i < num_lets; ++i)
+            m_out << ")";
+        return true;
+    }
+};
+
 void mk_smt2_format(sort * s, smt2_pp_environment & env, params_ref const & p, format_ref & r) {
     smt2_printer pr(env, p);
     pr(s, r);
@@ -1233,6 +1486,11 @@ std::ostream & ast_smt2_pp(std::ostream & out, expr * n, smt2_pp_environment & e
                             unsigned num_vars, char const * var_prefix) {
     if (!n) return out << "null";
     ast_manager & m = env.get_manager();
+    if (num_vars == 0 && smt2_stream_printer::is_large(m, n, pp_params(p).stream_size())) {
+        smt2_stream_printer pr(env, p, out);
+        if (pr(n, indent))
+            return out;
+    }
     format_ref r(fm(m));
     sbuffer<symbol> var_names;
     mk_smt2_format(n, env, p, num_vars, var_prefix, r, var_names);
@@ -95,6 +95,12 @@ public:
 
     void reset_cache();
     void cleanup();
+
+    /**
+       \brief Force the source node s to be translated to t.
+       Only shared nodes (reference count > 1) are looked up in the cache.
+    */
+    void insert(ast * s, ast * t) { if (!m_cache.contains(s)) cache(s, t); }
     
     unsigned loop_count() const { return m_loop_count; }
     unsigned hit_count() const { return m_hit_count; }
@@ -0,0 +1,226 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    canonical_hash.cpp
+
+Abstract:
+
+    128-bit hash of expressions that is stable across managers and
+    processes.
+
+--*/
+#include <cstring>
+#include "ast/canonical_hash.h"
+
+// the two halves are independent 64-bit multiply-xorshift mixes
+static uint64_t mix_lane(uint64_t h, uint64_t v, uint64_t k) {
+    h ^= v + k + (h << 6) + (h >> 2);
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 29;
+    return h;
+}
+
+enum canonical_tag : uint64_t {
+    CH_UNINTERP_SORT = 1,
+    CH_UNINTERP_DECL,
+    CH_SORT,
+    CH_DECL,
+    CH_APP,
+    CH_VAR,
+    CH_FORALL,
+    CH_EXISTS,
+    CH_LAMBDA,
+    CH_PARAM
+};
+
+void canonical_hash::add(hash128& h, uint64_t v) const {
+    h.m_lo = mix_lane(h.m_lo, v, 0x9e3779b97f4a7c15ull);
+    h.m_hi = mix_lane(h.m_hi, v, 0x632be59bd9b4e019ull);
+}
+
+void canonical_hash::add(hash128& h, hash128 const& v) const {
+    add(h, v.m_lo);
+    add(h, v.m_hi);
+}
+
+void canonical_hash::add(hash128& h, char const* s) const {
+    uint64_t len = 0;
+    for (; *s; ++s, ++len)
+        add(h, static_cast<uint64_t>(static_cast<unsigned char>(*s)));
+    add(h, len);
+}
+
+void canonical_hash::add(hash128& h, symbol const& s) const {
+    if (s.is_numerical())
+        add(h, static_cast<uint64_t>(s.get_num()));
+    else
+        add(h, s.str().c_str());
+}
+
+void canonical_hash::add(hash128& h, parameter const& p) {
+    add(h, CH_PARAM);
+    add(h, static_cast<uint64_t>(p.get_kind()));
+    switch (p.get_kind()) {
+    case parameter::PARAM_INT:
+        add(h, static_cast<uint64_t>(p.get_int()));
+        break;
+    case parameter::PARAM_AST: {
+        ast* a = p.get_ast();
+        if (is_sort(a))
+            add(h, hash_sort(to_sort(a)));
+        else if (is_func_decl(a))
+            add(h, hash_decl(to_func_decl(a)));
+        else
+            add(h, (*this)(to_expr(a)));
+        break;
+    }
+    case parameter::PARAM_SYMBOL:
+        add(h, p.get_symbol());
+        break;
+    case parameter::PARAM_ZSTRING:
+        add(h, p.get_zstring().encode().c_str());
+        break;
+    case parameter::PARAM_RATIONAL:
+        add(h, p.get_rational().to_string().c_str());
+        break;
+    case parameter::PARAM_DOUBLE: {
+        double d = p.get_double();
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        add(h, bits);
+        break;
+    }
+    default:
+        // external parameters are ids of the plugin of the manager, they
+        // only contribute their kind.
+        break;
+    }
+}
+
+hash128 canonical_hash::uninterpreted(ast* a, unsigned kind) {
+    unsigned idx;
+    if (!m_uninterp.find(a, idx)) {
+        idx = m_uninterp.size();
+        m_uninterp.insert(a, idx);
+        m_pinned.push_back(a);
+    }
+    hash128 h;
+    add(h, kind);
+    add(h, idx);
+    return h;
+}
+
+hash128 canonical_hash::hash_sort(sort* s) {
+    hash128 h;
+    if (m_cache.find(s, h))
+        return h;
+    if (s->get_family_id() == null_family_id)
+        h = uninterpreted(s, CH_UNINTERP_SORT);
+    else {
+        add(h, CH_SORT);
+        add(h, m.get_family_name(s->get_family_id()));
+        add(h, static_cast<uint64_t>(s->get_decl_kind()));
+        for (parameter const& p : s->parameters())
+            add(h, p);
+    }
+    m_cache.insert(s, h);
+    m_pinned.push_back(s);
+    return h;
+}
+
+hash128 canonical_hash::hash_decl(func_decl* f) {
+    hash128 h;
+    if (m_cache.find(f, h))
+        return h;
+    if (f->get_family_id() == null_family_id)
+        h = uninterpreted(f, CH_UNINTERP_DECL);
+    else {
+        add(h, CH_DECL);
+        add(h, m.get_family_name(f->get_family_id()));
+        add(h, static_cast<uint64_t>(f->get_decl_kind()));
+        for (parameter const& p : f->parameters())
+            add(h, p);
+    }
+    add(h, f->get_arity());
+    for (sort* s : *f)
+        add(h, hash_sort(s));
+    add(h, hash_sort(f->get_range()));
+    m_cache.insert(f, h);
+    m_pinned.push_back(f);
+    return h;
+}
+
+bool canonical_hash::visit(expr* e) {
+    if (m_cache.contains(e))
+        return true;
+    m_todo.push_back(e);
+    return false;
+}
+
+void canonical_hash::hash_expr(expr* e) {
+    hash128 h;
+    switch (e->get_kind()) {
+    case AST_APP: {
+        app* a = to_app(e);
+        add(h, CH_APP);
+        add(h, hash_decl(a->get_decl()));
+        for (expr* arg : *a)
+            add(h, m_cache[arg]);
+        break;
+    }
+    case AST_VAR:
+        add(h, CH_VAR);
+        add(h, to_var(e)->get_idx());
+        add(h, hash_sort(e->get_sort()));
+        break;
+    case AST_QUANTIFIER: {
+        quantifier* q = to_quantifier(e);
+        add(h, is_forall(q) ? CH_FORALL : is_exists(q) ? CH_EXISTS : CH_LAMBDA);
+        add(h, q->get_num_decls());
+        for (unsigned i = 0; i < q->get_num_decls(); ++i)
+            add(h, hash_sort(q->get_decl_sort(i)));
+        add(h, m_cache[q->get_expr()]);
+        break;
+    }
+    default:
+        UNREACHABLE();
+    }
+    m_cache.insert(e, h);
+    m_pinned.push_back(e);
+}
+
+hash128 canonical_hash::operator()(expr* e) {
+    unsigned sz = m_todo.size();
+    visit(e);
+    while (m_todo.size() > sz) {
+        expr* t = m_todo.back();
+        if (m_cache.contains(t)) {
+            m_todo.pop_back();
+            continue;
+        }
+        bool visited = true;
+        if (is_app(t)) {
+            // children are pushed in reverse so that they are finished left to right
+            for (unsigned i = to_app(t)->get_num_args(); i-- > 0; )
+                visited &= visit(to_app(t)->get_arg(i));
+        }
+        else if (is_quantifier(t))
+            visited = visit(to_quantifier(t)->get_expr());
+        if (visited) {
+            m_todo.pop_back();
+            hash_expr(t);
+        }
+    }
+    return m_cache[e];
+}
+
+void canonical_hash::reset() {
+    m_cache.reset();
+    m_uninterp.reset();
+    m_pinned.reset();
+    m_todo.reset();
+}
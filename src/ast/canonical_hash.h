@@ -0,0 +1,66 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    canonical_hash.h
+
+Abstract:
+
+    128-bit hash of expressions that is stable across managers and
+    processes.
+
+    The hash of ast::hash depends on the symbols and on the order in
+    which terms are created in a manager. The canonical hash only uses
+    the structure of a term: interpreted symbols are identified by the
+    name of their family, their kind and their parameters, uninterpreted
+    function symbols and sorts by the order in which they are first
+    reached in a left to right traversal of the term. Renaming the
+    uninterpreted symbols or declaring them in a different order
+    therefore does not change the hash. Bound variables are de Bruijn
+    indices, the names of bound variables and patterns are ignored.
+
+    The hashes of sub-terms are cached, so the hash is computed in time
+    linear in the size of the DAG. The numbering of uninterpreted symbols
+    is shared by the calls to the same object, so several terms hashed
+    with the same object are hashed as if they were one term.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/obj_hashtable.h"
+
+struct hash128 {
+    uint64_t m_lo = 0;
+    uint64_t m_hi = 0;
+    bool operator==(hash128 const& other) const { return m_lo == other.m_lo && m_hi == other.m_hi; }
+    bool operator!=(hash128 const& other) const { return !(*this == other); }
+};
+
+class canonical_hash {
+    ast_manager&              m;
+    obj_map<ast, hash128>     m_cache;
+    obj_map<ast, unsigned>    m_uninterp;     // uninterpreted decls and sorts by order of occurrence
+    ast_ref_vector            m_pinned;
+    ptr_vector<expr>          m_todo;
+
+    void add(hash128& h, char const* s) const;
+    void add(hash128& h, symbol const& s) const;
+    void add(hash128& h, parameter const& p);
+    hash128 uninterpreted(ast* a, unsigned kind);
+    hash128 hash_sort(sort* s);
+    hash128 hash_decl(func_decl* f);
+    bool visit(expr* e);
+    void hash_expr(expr* e);
+
+public:
+    canonical_hash(ast_manager& m): m(m), m_pinned(m) {}
+
+    hash128 operator()(expr* e);
+
+    void add(hash128& h, uint64_t v) const;
+    void add(hash128& h, hash128 const& v) const;
+
+    void reset();
+};
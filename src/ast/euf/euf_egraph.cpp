@@ -54,11 +54,35 @@ namespace euf {
             m_tmp_node->m_args[i] = args[i];
         m_tmp_node->m_num_args = n;
         m_tmp_node->m_expr = e;
+        m_tmp_node->m_id = e->get_id();
         m_tmp_node->m_table_id = UINT_MAX;
         return m_table.find(m_tmp_node);
     }
 
 
+    egraph::shared_find::~shared_find() {
+        if (m_tmp)
+            memory::deallocate(m_tmp);
+    }
+
+    bool egraph::shared_find::operator()(expr* e, unsigned n, enode* const* args, enode*& r) {
+        if (m_tmp && m_capacity < n) {
+            memory::deallocate(m_tmp);
+            m_tmp = nullptr;
+        }
+        if (!m_tmp) {
+            m_tmp = enode::mk_tmp(n);
+            m_capacity = n;
+        }
+        for (unsigned i = 0; i < n; ++i)
+            m_tmp->m_args[i] = args[i];
+        m_tmp->m_num_args = n;
+        m_tmp->m_expr = e;
+        m_tmp->m_id = e->get_id();
+        m_tmp->m_table_id = UINT_MAX;
+        return g.m_table.find_shared(m_tmp, r);
+    }
+
     enode_vector const& egraph::enodes_of(func_decl* f) {
         unsigned id = f->get_small_id();
         if (id < m_decl2enodes.size())
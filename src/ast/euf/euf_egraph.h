@@ -250,6 +250,21 @@ namespace euf {
         ~egraph();
         enode* find(expr* f) const { return m_expr2enode.get(f->get_id(), nullptr); }
         enode* find(expr* f, unsigned n, enode* const* args);
+
+        /**
+           \brief find(f, n, args) for concurrent readers of an egraph that is
+           not being updated. Each reader owns its temporary node. The lookup
+           returns false if it cannot be done without updating shared state.
+        */
+        class shared_find {
+            egraph const& g;
+            enode*        m_tmp = nullptr;
+            unsigned      m_capacity = 0;
+        public:
+            shared_find(egraph const& g): g(g) {}
+            ~shared_find();
+            bool operator()(expr* f, unsigned n, enode* const* args, enode*& r);
+        };
         enode* mk(expr* f, unsigned generation, unsigned n, enode *const* args);
         enode_vector const& enodes_of(func_decl* f);
         void push() { if (!m_to_merge.empty()) propagate(); ++m_num_scopes; }
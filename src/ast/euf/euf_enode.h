@@ -42,7 +42,18 @@ namespace euf {
     const theory_id null_theory_id = -1;
 
     class enode {
+        // The fields read while merging classes and maintaining the congruence
+        // table come first, so that walking parent lists and hashing the roots
+        // of arguments stays within the head of each enode.
         expr*         m_expr = nullptr;
+        enode*        m_root   = nullptr;
+        enode*        m_next   = nullptr;
+        enode*        m_cg     = nullptr;
+        enode_vector  m_parents;
+        unsigned      m_id = UINT_MAX;          // the id of m_expr, cached for hashing roots
+        unsigned      m_table_id = UINT_MAX;       
+        unsigned      m_class_size = 1;         // Size of the equivalence class if the enode is the root.
+        unsigned      m_num_args = 0;
         bool          m_mark1 = false;
         bool          m_mark2 = false;
         bool          m_mark3 = false;
@@ -53,20 +64,13 @@ namespace euf {
         bool          m_is_equality = false;    // Does the expression represent an equality
         bool          m_is_relevant = false;
         lbool         m_value = l_undef;        // Assignment by SAT solver for Boolean node
+        signed char   m_lbl_hash = -1;  // It is different from -1, if enode is used in a pattern
         sat::bool_var m_bool_var = sat::null_bool_var;    // SAT solver variable associated with Boolean node
-        unsigned      m_class_size = 1;         // Size of the equivalence class if the enode is the root.
-        unsigned      m_table_id = UINT_MAX;       
         unsigned      m_generation = 0;         // Tracks how many quantifier instantiation rounds were needed to generate this enode.
-        enode_vector  m_parents;
-        enode*        m_next   = nullptr;
-        enode*        m_root   = nullptr;
         enode*        m_target = nullptr;
-        enode*        m_cg     = nullptr;
         th_var_list   m_th_vars;
         justification m_justification;
         justification m_lit_justification;
-        unsigned      m_num_args = 0;
-        signed char   m_lbl_hash = -1;  // It is different from -1, if enode is used in a pattern
         approx_set    m_lbls;
         approx_set    m_plbls;
         enode*        m_args[0];
@@ -87,6 +91,7 @@ namespace euf {
             void* mem = r.allocate(get_enode_size(num_args));
             enode* n = new (mem) enode();
             n->m_expr = f;
+            n->m_id = f->get_id();
             n->m_next = n;
             n->m_root = n;
             n->m_generation = generation, 
@@ -163,7 +168,7 @@ namespace euf {
         bool merge_tf() const { return m_merge_tf_enabled && (class_size() > 1 || num_parents() > 0 || num_args() > 0); }
 
         enode* get_arg(unsigned i) const { SASSERT(i < num_args()); return m_args[i]; }        
-        unsigned hash() const { return m_expr->get_id(); }
+        unsigned hash() const { return m_id; }
 
         unsigned get_table_id() const { return m_table_id; }
         void     set_table_id(unsigned t) { m_table_id = t; }
@@ -204,10 +209,10 @@ namespace euf {
         sort*  get_sort() const { return m_expr->get_sort(); }
         app*  get_app() const { return to_app(m_expr); }
         func_decl* get_decl() const { return is_app(m_expr) ? to_app(m_expr)->get_decl() : nullptr; }
-        unsigned get_expr_id() const { return m_expr->get_id(); }
-        unsigned get_id() const { return m_expr->get_id(); }
+        unsigned get_expr_id() const { return m_id; }
+        unsigned get_id() const { return m_id; }
         unsigned get_small_id() const { return m_expr->get_small_id(); }
-        unsigned get_root_id() const { return m_root->m_expr->get_id(); }
+        unsigned get_root_id() const { return m_root->m_id; }
         bool children_are_roots() const;
         enode* get_next() const { return m_next; }
 
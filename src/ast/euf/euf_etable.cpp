@@ -254,6 +254,28 @@ namespace euf {
         }
     }
 
+    bool etable::find_shared(enode* n, enode*& r) const {
+        SASSERT(n->num_args() > 0);
+        r = nullptr;
+        unsigned tid;
+        if (!m_func_decl2id.find(decl_info(n->get_decl(), n->num_args()), tid))
+            return true;
+        void* t = m_tables[tid];
+        switch (static_cast<table_kind>(GET_TAG(t))) {
+        case UNARY:
+            UNTAG(unary_table*, t)->find(n, r);
+            return true;
+        case BINARY:
+            UNTAG(binary_table*, t)->find(n, r);
+            return true;
+        case BINARY_COMM:
+            return false;
+        default:
+            UNTAG(table*, t)->find(n, r);
+            return true;
+        }
+    }
+
     enode* etable::find(enode* n) const {
         SASSERT(n->num_args() > 0);
         enode* r = nullptr;
@@ -171,6 +171,14 @@ namespace euf {
 
         enode* find(enode* n) const;
 
+        /**
+           \brief Variant of find that does not update the table, so it can be
+           used by concurrent readers while the table is not modified.
+           It returns false, without a result, for commutative symbols since
+           their lookup records whether the match used commutativity.
+        */
+        bool find_shared(enode* n, enode*& r) const;
+
         bool contains_ptr(enode* n) const;
 
         void reset();
@@ -41,7 +41,9 @@ fpa2bv_converter::fpa2bv_converter(ast_manager & m) :
     m_mpf_manager(m_util.fm()),
     m_mpz_manager(m_mpf_manager.mpz_manager()),
     m_hi_fp_unspecified(true),
-    m_extra_assertions(m) {
+    m_extra_assertions(m),
+    m_lazy_ops(m),
+    m_lazy_values(m) {
     m_plugin = static_cast<fpa_decl_plugin*>(m.get_plugin(m.mk_family_id("fpa")));
 }
 
@@ -3549,6 +3551,50 @@ void fpa2bv_converter::split_fp(expr * e, expr_ref & sgn, expr_ref & exp, expr_r
     sig = e_sig;
 }
 
+bool fpa2bv_converter::is_lazy(func_decl * f) const {
+    if (!m_lazy || f->get_family_id() != m_util.get_family_id())
+        return false;
+    switch (f->get_decl_kind()) {
+    case OP_FPA_MUL:
+    case OP_FPA_DIV:
+    case OP_FPA_FMA:
+    case OP_FPA_SQRT:
+    case OP_FPA_REM:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void fpa2bv_converter::mk_lazy(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+    SASSERT(is_lazy(f));
+    sort * s = f->get_range();
+    unsigned ebits = m_util.get_ebits(s);
+    unsigned sbits = m_util.get_sbits(s);
+    unsigned bv_sz = ebits + sbits;
+    app_ref bv(mk_fresh_const("fpa2bv_lazy", bv_sz), m);
+    result = m_util.mk_fp(m_bv_util.mk_extract(bv_sz - 1, bv_sz - 1, bv),
+                          m_bv_util.mk_extract(bv_sz - 2, sbits - 1, bv),
+                          m_bv_util.mk_extract(sbits - 2, 0, bv));
+    m_lazy_ops.push_back(m.mk_app(f, num, args));
+    m_lazy_values.push_back(result);
+}
+
+void fpa2bv_converter::mk_eager(app * a, expr_ref & result) {
+    func_decl * f = a->get_decl();
+    unsigned num = a->get_num_args();
+    expr * const * args = a->get_args();
+    flet<bool> _lazy(m_lazy, false);
+    switch (f->get_decl_kind()) {
+    case OP_FPA_MUL: mk_mul(f, num, args, result); break;
+    case OP_FPA_DIV: mk_div(f, num, args, result); break;
+    case OP_FPA_FMA: mk_fma(f, num, args, result); break;
+    case OP_FPA_SQRT: mk_sqrt(f, num, args, result); break;
+    case OP_FPA_REM: mk_rem(f, num, args, result); break;
+    default: UNREACHABLE(); break;
+    }
+}
+
 void fpa2bv_converter::join_fp(expr * e, expr_ref & res) {
     expr_ref sgn(m), exp(m), sig(m);
     split_fp(e, sgn, exp, sig);
@@ -4298,6 +4344,8 @@ void fpa2bv_converter::reset() {
     m_uf2bvuf.reset();
     m_min_max_ufs.reset();
     m_extra_assertions.reset();
+    m_lazy_ops.reset();
+    m_lazy_values.reset();
 }
 
 func_decl * fpa2bv_converter::mk_bv_uf(func_decl * f, sort * const * domain, sort * range) {
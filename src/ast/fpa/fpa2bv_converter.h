@@ -49,6 +49,7 @@ protected:
     unsynch_mpz_manager      & m_mpz_manager;
     fpa_decl_plugin          * m_plugin;
     bool                       m_hi_fp_unspecified;
+    bool                       m_lazy = false;
 
     const2bv_t                 m_const2bv;
     const2bv_t                 m_rm_const2bv;
@@ -162,6 +163,20 @@ public:
     void dbg_decouple(const char * prefix, expr_ref & e);
     expr_ref_vector m_extra_assertions;
 
+    /**
+       \brief in lazy mode multiplication, division, fused multiply-add,
+       square root and remainder are converted into fresh bit-vectors.
+       The operations over converted arguments are recorded in lazy_ops
+       and their fresh values in lazy_values; mk_eager produces the circuit
+       that defines them.
+     */
+    void set_lazy(bool f) { m_lazy = f; }
+    bool is_lazy(func_decl * f) const;
+    void mk_lazy(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
+    void mk_eager(app * a, expr_ref & result);
+    expr_ref_vector const & lazy_ops() const { return m_lazy_ops; }
+    expr_ref_vector const & lazy_values() const { return m_lazy_values; }
+
     special_t const & get_min_max_specials() const { return m_min_max_ufs; };
     const2bv_t const & get_const2bv() const { return m_const2bv; };
     const2bv_t const & get_rm_const2bv() const { return m_rm_const2bv; };
@@ -229,6 +244,9 @@ private:
 
     expr_ref nan_wrap(expr * n);
 
+    expr_ref_vector            m_lazy_ops;
+    expr_ref_vector            m_lazy_values;
+
     expr_ref extra_quantify(expr * e);
 };
 
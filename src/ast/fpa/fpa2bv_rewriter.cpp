@@ -103,6 +103,10 @@ br_status fpa2bv_rewriter_cfg::reduce_app(func_decl * f, unsigned num, expr * co
     }
 
     if (m_conv.is_float_family(f)) {
+        if (m_conv.is_lazy(f)) {
+            m_conv.mk_lazy(f, num, args, result);
+            return BR_DONE;
+        }
         switch (f->get_decl_kind()) {
         case OP_FPA_RM_NEAREST_TIES_TO_AWAY:
         case OP_FPA_RM_NEAREST_TIES_TO_EVEN:
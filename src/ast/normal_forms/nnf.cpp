@@ -397,7 +397,13 @@ struct nnf::imp {
         }
     }
 
-    bool visit(expr * t, bool pol, bool in_q) {
+    /**
+       \brief visit t in polarity pol. The parent of a mixed t visits it in
+       both polarities, so its results are cached even if t is not shared:
+       otherwise nested equivalences, xors and ite conditions are converted
+       again for every combination of polarities of their ancestors.
+    */
+    bool visit(expr * t, bool pol, bool in_q, bool mixed = false) {
         SASSERT(m.is_bool(t));
 
         if (m_mode == NNF_SKOLEM || (m_mode == NNF_QUANT && !in_q)) {
@@ -407,7 +413,7 @@ struct nnf::imp {
             }
         }
 
-        bool cache_res = t->get_ref_count() > 1;
+        bool cache_res = mixed || t->get_ref_count() > 1;
 
         if (cache_res) {
             expr * r = get_cached(t, pol, in_q);
@@ -538,11 +544,11 @@ struct nnf::imp {
         switch (fr.m_i) {
         case 0:
             fr.m_i = 1;
-            if (!visit(t->get_arg(0), true, fr.m_in_q))
+            if (!visit(t->get_arg(0), true, fr.m_in_q, true))
                 return false;
         case 1:
             fr.m_i = 2;
-            if (!visit(t->get_arg(0), false, fr.m_in_q))
+            if (!visit(t->get_arg(0), false, fr.m_in_q, true))
                 return false;
         case 2:
             fr.m_i = 3;
@@ -582,19 +588,19 @@ struct nnf::imp {
         switch (fr.m_i) {
         case 0:
             fr.m_i = 1;
-            if (!visit(t->get_arg(0), true, fr.m_in_q))
+            if (!visit(t->get_arg(0), true, fr.m_in_q, true))
                 return false;
         case 1:
             fr.m_i = 2;
-            if (!visit(t->get_arg(0), false, fr.m_in_q))
+            if (!visit(t->get_arg(0), false, fr.m_in_q, true))
                 return false;
         case 2:
             fr.m_i = 3;
-            if (!visit(t->get_arg(1), true, fr.m_in_q))
+            if (!visit(t->get_arg(1), true, fr.m_in_q, true))
                 return false;
         case 3:
             fr.m_i = 4;
-            if (!visit(t->get_arg(1), false, fr.m_in_q))
+            if (!visit(t->get_arg(1), false, fr.m_in_q, true))
                 return false;
         default:
             break;
@@ -854,7 +860,7 @@ struct nnf::imp {
             frame & fr = m_frame_stack.back();
             expr * t   = fr.m_curr;
 
-            if (fr.m_i == 0 && t->get_ref_count() > 1 && process_cached(t, fr.m_pol, fr.m_in_q))
+            if (fr.m_i == 0 && fr.m_cache_result && process_cached(t, fr.m_pol, fr.m_in_q))
                 continue;
 
             bool status;
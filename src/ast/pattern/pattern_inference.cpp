@@ -26,6 +26,8 @@ Revision History:
 #include "ast/normal_forms/pull_quant.h"
 #include "ast/well_sorted.h"
 #include "ast/for_each_expr.h"
+#include "ast/canonical_hash.h"
+#include "util/mutex.h"
 #include "ast/rewriter/rewriter_def.h"
 
 void smaller_pattern::save(expr * p1, expr * p2) {
@@ -573,57 +575,146 @@ void pattern_inference_cfg::mk_patterns(unsigned num_bindings,
 }
 
 
-bool pattern_inference_cfg::reduce_quantifier(
-    quantifier * q, 
-    expr * new_body, 
-    expr * const *, // new_patterns 
-    expr * const * new_no_patterns,
-    expr_ref & result,
-    proof_ref & result_pr) {
+/**
+   Patterns inferred for a quantifier are stored by the canonical hash of
+   the quantifier and of the parameters of the inference. A pattern is
+   stored as the positions of its arguments in the pre-order of the
+   sub-terms of the body, which is the same for all quantifiers with the
+   same canonical hash.
+*/
+namespace {
+    struct cached_patterns {
+        unsigned                m_num_nodes;
+        int                     m_weight;
+        vector<unsigned_vector> m_patterns;
+    };
 
-    TRACE("pattern_inference", tout << "processing:\n" << mk_pp(q, m) << "\n";);
-    if (!is_forall(q)) {
-        return false;
-    }
+    struct hash128_hash {
+        unsigned operator()(hash128 const& h) const { return static_cast<unsigned>(h.m_lo); }
+    };
 
-    int weight = q->get_weight();
+    typedef map<hash128, cached_patterns*, hash128_hash, default_eq<hash128>> pattern_cache;
 
-    if (m_params.m_pi_use_database) {
-        app_ref_vector new_patterns(m);
-        m_database.initialize(g_pattern_database);
-        unsigned new_weight;
-        if (m_database.match_quantifier(q, new_patterns, new_weight)) {
-            DEBUG_CODE(for (unsigned i = 0; i < new_patterns.size(); i++) { SASSERT(is_well_sorted(m, new_patterns.get(i))); });
-            if (q->get_num_patterns() > 0) {
-                // just update the weight...
-                TRACE("pattern_inference", tout << "updating weight to: " << new_weight << "\n" << mk_pp(q, m) << "\n";);
-                result = m.update_quantifier_weight(q, new_weight);
-            }
-            else {
-                quantifier_ref tmp(m);
-                tmp    = m.update_quantifier(q, new_patterns.size(), (expr**) new_patterns.data(), q->get_expr());
-                result = m.update_quantifier_weight(tmp, new_weight);
-                TRACE("pattern_inference", tout << "found patterns in database, weight: " << new_weight << "\n" << mk_pp(result, m) << "\n";);
-            }
-            if (m.proofs_enabled())
-                result_pr = m.mk_rewrite(q, result);
-            return true;
-        }
+    // the cache is cleared when it reaches this number of quantifiers
+    const unsigned max_cached_quantifiers = 100000;
+}
+
+static pattern_cache* g_pattern_cache = nullptr;
+static mutex g_pattern_cache_mux;
+
+// sub-terms of body in pre-order, nested quantifiers are not entered
+static void collect_nodes(expr * body, ptr_vector<expr> & nodes) {
+    expr_mark visited;
+    ptr_buffer<expr> todo;
+    todo.push_back(body);
+    while (!todo.empty()) {
+        expr * e = todo.back();
+        todo.pop_back();
+        if (visited.is_marked(e))
+            continue;
+        visited.mark(e);
+        nodes.push_back(e);
+        if (is_app(e))
+            for (unsigned i = to_app(e)->get_num_args(); i-- > 0; )
+                todo.push_back(to_app(e)->get_arg(i));
     }
+}
 
-    if (q->get_num_patterns() > 0) {
+bool pattern_inference_cfg::find_cached_patterns(quantifier * q, expr * new_body, expr * const * new_no_patterns, hash128 & key, app_ref_buffer & result, int & weight) {
+    canonical_hash ch(m);
+    key = hash128();
+    ch.add(key, m_params.m_pi_max_multi_patterns);
+    ch.add(key, m_params.m_pi_block_loop_patterns);
+    ch.add(key, m_params.m_pi_arith);
+    ch.add(key, m_params.m_pi_arith_weight);
+    ch.add(key, m_params.m_pi_non_nested_arith_weight);
+    ch.add(key, m_params.m_pi_avoid_skolems);
+    ch.add(key, static_cast<uint64_t>(static_cast<int64_t>(weight)));
+    ch.add(key, q->get_num_decls());
+    for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+        expr_ref v(m.mk_var(i, q->get_decl_sort(i)), m);
+        ch.add(key, ch(v));
+    }
+    ch.add(key, ch(new_body));
+    ch.add(key, q->get_num_no_patterns());
+    for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+        ch.add(key, ch(new_no_patterns[i]));
+
+    lock_guard lock(g_pattern_cache_mux);
+    cached_patterns* c = nullptr;
+    if (!g_pattern_cache || !g_pattern_cache->find(key, c))
+        return false;
+    ptr_vector<expr> nodes;
+    collect_nodes(new_body, nodes);
+    if (nodes.size() != c->m_num_nodes)
         return false;
+    ptr_buffer<expr> args;
+    for (unsigned_vector const& pat : c->m_patterns) {
+        args.reset();
+        for (unsigned idx : pat)
+            args.push_back(nodes[idx]);
+        result.push_back(m.mk_pattern(args.size(), reinterpret_cast<app * const *>(args.data())));
     }
+    weight = c->m_weight;
+    TRACE("pattern_inference", tout << "cached patterns for " << q->get_qid() << "\n";);
+    return true;
+}
 
-    if (m_params.m_pi_nopat_weight >= 0)
-        weight = m_params.m_pi_nopat_weight;
+void pattern_inference_cfg::cache_patterns(hash128 const & key, expr * new_body, app_ref_buffer const & patterns, int weight) {
+    ptr_vector<expr> nodes;
+    collect_nodes(new_body, nodes);
+    obj_map<expr, unsigned> pos;
+    for (unsigned i = 0; i < nodes.size(); ++i)
+        pos.insert(nodes[i], i);
+    cached_patterns* c = alloc(cached_patterns);
+    c->m_num_nodes = nodes.size();
+    c->m_weight = weight;
+    for (app * p : patterns) {
+        c->m_patterns.push_back(unsigned_vector());
+        for (expr * arg : *p) {
+            unsigned idx;
+            if (!pos.find(arg, idx)) {
+                dealloc(c);
+                return;
+            }
+            c->m_patterns.back().push_back(idx);
+        }
+    }
+    lock_guard lock(g_pattern_cache_mux);
+    if (!g_pattern_cache)
+        g_pattern_cache = alloc(pattern_cache);
+    if (g_pattern_cache->size() >= max_cached_quantifiers)
+        finalize_cache_core();
+    if (!g_pattern_cache)
+        g_pattern_cache = alloc(pattern_cache);
+    cached_patterns* old = nullptr;
+    if (g_pattern_cache->find(key, old))
+        dealloc(old);
+    g_pattern_cache->insert(key, c);
+}
 
-    SASSERT(q->get_num_patterns() == 0);
+void pattern_inference_cfg::finalize_cache_core() {
+    if (!g_pattern_cache)
+        return;
+    for (auto const& kv : *g_pattern_cache)
+        dealloc(kv.m_value);
+    dealloc(g_pattern_cache);
+    g_pattern_cache = nullptr;
+}
+
+void pattern_inference_cfg::finalize_cache() {
+    lock_guard lock(g_pattern_cache_mux);
+    finalize_cache_core();
+}
 
+/**
+   \brief infer the patterns of q with body new_body, when the heuristics
+   resort to arithmetic patterns, weight is increased.
+*/
+void pattern_inference_cfg::infer_patterns(quantifier * q, expr * new_body, expr * const * new_no_patterns, app_ref_buffer & new_patterns, int & weight) {
     if (m_params.m_pi_arith == AP_CONSERVATIVE)
         m_forbidden.push_back(m_afid);
 
-    app_ref_buffer new_patterns(m);
     unsigned num_no_patterns = q->get_num_no_patterns();
     mk_patterns(q->get_num_decls(), new_body, num_no_patterns, new_no_patterns, new_patterns);
 
@@ -669,6 +760,63 @@ bool pattern_inference_cfg::reduce_quantifier(
             }
         }
     }
+}
+
+bool pattern_inference_cfg::reduce_quantifier(
+    quantifier * q, 
+    expr * new_body, 
+    expr * const *, // new_patterns 
+    expr * const * new_no_patterns,
+    expr_ref & result,
+    proof_ref & result_pr) {
+
+    TRACE("pattern_inference", tout << "processing:\n" << mk_pp(q, m) << "\n";);
+    if (!is_forall(q)) {
+        return false;
+    }
+
+    int weight = q->get_weight();
+
+    if (m_params.m_pi_use_database) {
+        app_ref_vector new_patterns(m);
+        m_database.initialize(g_pattern_database);
+        unsigned new_weight;
+        if (m_database.match_quantifier(q, new_patterns, new_weight)) {
+            DEBUG_CODE(for (unsigned i = 0; i < new_patterns.size(); i++) { SASSERT(is_well_sorted(m, new_patterns.get(i))); });
+            if (q->get_num_patterns() > 0) {
+                // just update the weight...
+                TRACE("pattern_inference", tout << "updating weight to: " << new_weight << "\n" << mk_pp(q, m) << "\n";);
+                result = m.update_quantifier_weight(q, new_weight);
+            }
+            else {
+                quantifier_ref tmp(m);
+                tmp    = m.update_quantifier(q, new_patterns.size(), (expr**) new_patterns.data(), q->get_expr());
+                result = m.update_quantifier_weight(tmp, new_weight);
+                TRACE("pattern_inference", tout << "found patterns in database, weight: " << new_weight << "\n" << mk_pp(result, m) << "\n";);
+            }
+            if (m.proofs_enabled())
+                result_pr = m.mk_rewrite(q, result);
+            return true;
+        }
+    }
+
+    if (q->get_num_patterns() > 0) {
+        return false;
+    }
+
+    if (m_params.m_pi_nopat_weight >= 0)
+        weight = m_params.m_pi_nopat_weight;
+
+    SASSERT(q->get_num_patterns() == 0);
+
+    app_ref_buffer new_patterns(m);
+    hash128 key;
+    bool cached = m_params.m_pi_cache && find_cached_patterns(q, new_body, new_no_patterns, key, new_patterns, weight);
+    if (!cached) {
+        infer_patterns(q, new_body, new_no_patterns, new_patterns, weight);
+        if (m_params.m_pi_cache)
+            cache_patterns(key, new_body, new_patterns, weight);
+    }
 
     quantifier_ref new_q(m.update_quantifier(q, new_patterns.size(), (expr**) new_patterns.data(), new_body), m);
     if (weight != q->get_weight())
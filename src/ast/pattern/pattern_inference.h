@@ -28,6 +28,7 @@ Revision History:
 #include "util/obj_pair_hashtable.h"
 #include "util/map.h"
 #include "ast/pattern/expr_pattern_match.h"
+#include "ast/canonical_hash.h"
 
 /**
    \brief A pattern p_1 is smaller than a pattern p_2 iff 
@@ -205,6 +206,11 @@ class pattern_inference_cfg :  public default_rewriter_cfg {
        patterns are created.  If there are no unary pattern, then at
        most 1 + num_extra_multi_patterns multi_patterns are created.
     */
+    void infer_patterns(quantifier * q, expr * new_body, expr * const * new_no_patterns, app_ref_buffer & new_patterns, int & weight);
+    bool find_cached_patterns(quantifier * q, expr * new_body, expr * const * new_no_patterns, hash128 & key, app_ref_buffer & result, int & weight);
+    void cache_patterns(hash128 const & key, expr * new_body, app_ref_buffer const & patterns, int weight);
+    static void finalize_cache_core();
+
     void mk_patterns(unsigned num_bindings,              // IN number of bindings.
                      expr * n,                           // IN node where the patterns are going to be extracted.
                      unsigned num_no_patterns,           // IN num. patterns that should not be used.
@@ -244,8 +250,14 @@ public:
     }
 
     bool is_forbidden(app * n) const;
+
+    static void finalize_cache();
 };
 
+/*
+  ADD_FINALIZER('pattern_inference_cfg::finalize_cache();')
+*/
+
 class pattern_inference_rw : public rewriter_tpl<pattern_inference_cfg> {
     pattern_inference_cfg m_cfg;
 public:
@@ -32,7 +32,10 @@ namespace q {
         m_num_instances_curr_search(0),
         m_num_instances_curr_branch(0),
         m_max_generation(0),
-        m_max_cost(0.0f) {
+        m_max_cost(0.0f),
+        m_num_matches(0),
+        m_num_conflicts(0),
+        m_match_time(0.0) {
     }
 
     quantifier_stat_gen::quantifier_stat_gen(ast_manager & m, region & r):
@@ -115,5 +118,25 @@ namespace q {
         return r;
     }
 
+    static char const * profile_key(quantifier * q, char const * counter) {
+        std::string key = "qi-profile ";
+        key += q->get_qid().str();
+        key += " ";
+        key += counter;
+        // symbols are never freed, so the key outlives the statistics object
+        return symbol(key.c_str()).bare_str();
+    }
+
+    void collect_profile(quantifier * q, quantifier_stat const & s, statistics & st) {
+        if (s.get_num_matches() == 0 && s.get_num_instances() == 0)
+            return;
+        st.update(profile_key(q, "matches"), s.get_num_matches());
+        st.update(profile_key(q, "instances"), s.get_num_instances());
+        st.update(profile_key(q, "redundant"), s.get_num_instances_simplify_true() + s.get_num_instances_checker_sat());
+        st.update(profile_key(q, "max generation"), s.get_max_generation());
+        st.update(profile_key(q, "conflicts"), s.get_num_conflicts());
+        st.update(profile_key(q, "match time"), s.get_match_time());
+    }
+
 };
 
@@ -22,6 +22,7 @@ Revision History:
 #include "util/obj_hashtable.h"
 #include "util/approx_nat.h"
 #include "util/region.h"
+#include "util/statistics.h"
 
 namespace q {
     
@@ -42,6 +43,9 @@ namespace q {
         unsigned m_num_instances_curr_branch; //!< only updated if QI_TRACK_INSTANCES is true
         unsigned m_max_generation; //!< max. generation of an instance
         float    m_max_cost;
+        unsigned m_num_matches;    //!< matches found by E-matching, including duplicates of existing instances
+        unsigned m_num_conflicts;  //!< instances used to derive a conflict, only updated if qi.profile is true
+        double   m_match_time;     //!< seconds spent matching the patterns, only updated if qi.profile is true
 
         friend class quantifier_stat_gen;
 
@@ -124,8 +128,39 @@ namespace q {
         float get_max_cost() const {
             return m_max_cost;
         }
+
+        void inc_num_matches() {
+            m_num_matches++;
+        }
+
+        unsigned get_num_matches() const {
+            return m_num_matches;
+        }
+
+        void inc_num_conflicts() {
+            m_num_conflicts++;
+        }
+
+        unsigned get_num_conflicts() const {
+            return m_num_conflicts;
+        }
+
+        void add_match_time(double seconds) {
+            m_match_time += seconds;
+        }
+
+        double get_match_time() const {
+            return m_match_time;
+        }
     };
 
+    /**
+       \brief Add the instantiation profile of q to st. The entries are
+       named "qi-profile <qid> <counter>", quantifiers that were never
+       matched are skipped.
+    */
+    void collect_profile(quantifier * q, quantifier_stat const & s, statistics & st);
+
     /**
        \brief Functor used to generate quantifier statistics.
     */
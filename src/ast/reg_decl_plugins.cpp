@@ -30,7 +30,26 @@ Revision History:
 #include "ast/fpa_decl_plugin.h"
 #include "ast/special_relations_decl_plugin.h"
 
-void reg_decl_plugins(ast_manager & m) {
+template<typename P>
+static decl_plugin * mk_plugin() {
+    return alloc(P);
+}
+
+void reg_decl_plugins(ast_manager & m, bool lazy) {
+    if (lazy) {
+        m.register_lazy_plugin(symbol("arith"), mk_plugin<arith_decl_plugin>);
+        m.register_lazy_plugin(symbol("bv"), mk_plugin<bv_decl_plugin>);
+        m.register_lazy_plugin(symbol("array"), mk_plugin<array_decl_plugin>);
+        m.register_lazy_plugin(symbol("datatype"), mk_plugin<datatype_decl_plugin>);
+        m.register_lazy_plugin(symbol("recfun"), mk_plugin<recfun::decl::plugin>);
+        m.register_lazy_plugin(symbol("datalog_relation"), mk_plugin<datalog::dl_decl_plugin>);
+        m.register_lazy_plugin(symbol("char"), mk_plugin<char_decl_plugin>);
+        m.register_lazy_plugin(symbol("seq"), mk_plugin<seq_decl_plugin>);
+        m.register_lazy_plugin(symbol("fpa"), mk_plugin<fpa_decl_plugin>);
+        m.register_lazy_plugin(symbol("pb"), mk_plugin<pb_decl_plugin>);
+        m.register_lazy_plugin(symbol("specrels"), mk_plugin<special_relations_decl_plugin>);
+        return;
+    }
     if (!m.get_plugin(m.mk_family_id(symbol("arith")))) {
         m.register_plugin(symbol("arith"), alloc(arith_decl_plugin));
     }
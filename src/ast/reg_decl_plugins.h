@@ -21,5 +21,10 @@ Revision History:
 
 class ast_manager;
 
-void reg_decl_plugins(ast_manager & m);
+/**
+   \brief register the plugins of all theories in m. If lazy is true, a
+   plugin is only created when it is first used, which makes the creation
+   of managers that only use a few theories cheaper.
+*/
+void reg_decl_plugins(ast_manager & m, bool lazy = false);
 
@@ -219,41 +219,72 @@ br_status array_rewriter::mk_select_core(unsigned num_args, expr * const * args,
             return BR_REWRITE1;
         }
         default: {
-            auto are_values = [&]() {
+            auto are_values = [&](app* st) {
                 for (unsigned i = 1; i < num_args; ++i) {
                     if (!m().is_value(args[i]))
                         return false;
-                    if (!m().is_value(to_app(args[0])->get_arg(i)))
+                    if (!m().is_value(st->get_arg(i)))
                         return false;
                 }
                 return true;
             };
-            bool should_expand =
-                m_blast_select_store ||
-                are_values() ||
-                (m_expand_select_store && to_app(args[0])->get_arg(0)->get_ref_count() == 1);
-            if (should_expand) {
-                // select(store(a, I, v), J) --> ite(I=J, v, select(a, J))
-                ptr_buffer<expr> new_args;
-                new_args.push_back(to_app(args[0])->get_arg(0));
-                new_args.append(num_args-1, args+1);
-                expr * sel_a_j = m().mk_app(get_fid(), OP_SELECT, num_args, new_args.data());
-                expr * v       = to_app(args[0])->get_arg(num_args);
-                ptr_buffer<expr> eqs;
-                unsigned num_indices = num_args-1;
-                for (unsigned i = 0; i < num_indices; i++) {
-                    eqs.push_back(m().mk_eq(to_app(args[0])->get_arg(i+1), args[i+1]));
-                }
-                if (num_indices == 1) {
-                    result = m().mk_ite(eqs[0], v, sel_a_j);
-                    return BR_REWRITE2;
+            auto should_expand = [&](app* st) {
+                return
+                    m_blast_select_store ||
+                    are_values(st) ||
+                    (m_expand_select_store && st->get_arg(0)->get_ref_count() == 1);
+            };
+            if (!should_expand(to_app(args[0])))
+                return BR_FAILED;
+            // select(store(...store(a, I1, v1)..., In, vn), J) --> 
+            // ite(In = J, vn, ... ite(I1 = J, v1, select(a, J)))
+            // The store chain is flattened into its writes in one pass. Writes to
+            // indices that are distinct from J or that are overwritten by a later
+            // write to the same index are left out, and the chain stops at a write
+            // to J. So long chains of stores produce one ite per live write
+            // instead of one rewrite step per store.
+            ptr_buffer<app> writes;
+            obj_hashtable<expr> written;
+            unsigned num_indices = num_args - 1;
+            expr* arr = args[0];
+            expr* base = nullptr;
+            while (m_util.is_store(arr) && (writes.empty() || should_expand(to_app(arr)))) {
+                app* st = to_app(arr);
+                lbool cmp = compare_args(num_indices, args + 1, st->get_args() + 1);
+                if (cmp == l_true) {
+                    base = st->get_arg(num_args);
+                    break;
                 }
-                else {
-                    result = m().mk_ite(m().mk_and(eqs), v, sel_a_j);
-                    return BR_REWRITE3;
+                if (cmp == l_undef && (num_indices > 1 || !written.contains(st->get_arg(1)))) {
+                    writes.push_back(st);
+                    if (num_indices == 1)
+                        written.insert(st->get_arg(1));
                 }
+                arr = st->get_arg(0);
+            }
+            expr_ref r(m());
+            if (base)
+                r = base;
+            else {
+                ptr_buffer<expr> new_args;
+                new_args.push_back(arr);
+                new_args.append(num_indices, args + 1);
+                r = m().mk_app(get_fid(), OP_SELECT, num_args, new_args.data());
+            }
+            for (unsigned k = writes.size(); k-- > 0; ) {
+                app* st = writes[k];
+                ptr_buffer<expr> eqs;
+                for (unsigned i = 0; i < num_indices; i++) 
+                    eqs.push_back(m().mk_eq(st->get_arg(i + 1), args[i + 1]));
+                expr* cond = num_indices == 1 ? eqs[0] : m().mk_and(eqs);
+                r = m().mk_ite(cond, st->get_arg(num_args), r);
             }
-            return BR_FAILED;
+            result = r;
+            if (writes.size() > 1 || base)
+                return BR_REWRITE_FULL;
+            if (writes.empty())
+                return BR_REWRITE1;
+            return num_indices == 1 ? BR_REWRITE2 : BR_REWRITE3;
         }
         }
     }
@@ -135,6 +135,7 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
         m_blast_full     = p.get_bool("blast_full", false);
         m_blast_quant    = p.get_bool("blast_quant", false);
         m_blaster.set_max_memory(m_max_memory);
+        m_blaster.set_mul_tree_size(p.get_uint("blast_mul_tree_size", UINT_MAX));
     }
 
     bool rewrite_patterns() const { return true; }
@@ -724,6 +725,7 @@ unsigned bit_blaster_rewriter::get_num_steps() const {
 
 void bit_blaster_rewriter::cleanup() {
     m_imp->cleanup();
+    m_imp->m_blaster.reset_circuits();
 }
 
 obj_map<func_decl, expr*> const & bit_blaster_rewriter::const2bits() const {
@@ -19,6 +19,9 @@ Revision History:
 #pragma once
 
 #include "util/rational.h"
+#include "util/map.h"
+#include "util/scoped_ptr_vector.h"
+#include "ast/ast.h"
 
 template<typename Cfg>
 class bit_blaster_tpl : public Cfg {
@@ -35,8 +38,60 @@ protected:
     void mk_ext_rotate_left_right(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
 
     unsigned long long m_max_memory;
+    unsigned           m_mul_tree_size { UINT_MAX };
     void checkpoint();
 
+    /**
+       \brief Cache of multiplier and divider circuits keyed by the operand bits.
+       Occurrences with the same operands (modulo commutativity for multiplication)
+       share one circuit, and the quotient and remainder of the same division 
+       are produced by one divider.
+    */
+    enum circuit_kind { MUL_CIRCUIT, UDIV_UREM_CIRCUIT };
+    struct circuit {
+        circuit_kind    m_kind;
+        unsigned        m_sz;
+        expr_ref_vector m_args;  // a_bits followed by b_bits
+        expr_ref_vector m_out1, m_out2;
+        circuit(ast_manager & m, circuit_kind k, unsigned sz, expr * const * a_bits, expr * const * b_bits):
+            m_kind(k), m_sz(sz), m_args(m), m_out1(m), m_out2(m) {
+            m_args.append(sz, a_bits);
+            m_args.append(sz, b_bits);
+        }
+    };
+    struct circuit_key {
+        circuit_kind       m_kind;
+        unsigned           m_sz;
+        expr * const *     m_args;
+        struct hash_proc {
+            unsigned operator()(circuit_key const & k) const {
+                unsigned h = k.m_kind + 17 * k.m_sz;
+                for (unsigned i = 0; i < 2 * k.m_sz; ++i)
+                    h = combine_hash(h, k.m_args[i]->get_id());
+                return h;
+            }
+        };
+        struct eq_proc {
+            bool operator()(circuit_key const & a, circuit_key const & b) const {
+                if (a.m_kind != b.m_kind || a.m_sz != b.m_sz)
+                    return false;
+                for (unsigned i = 0; i < 2 * a.m_sz; ++i)
+                    if (a.m_args[i] != b.m_args[i])
+                        return false;
+                return true;
+            }
+        };
+    };
+    scoped_ptr_vector<circuit>                                                     m_circuits;
+    map<circuit_key, circuit *, typename circuit_key::hash_proc, typename circuit_key::eq_proc> m_circuit_table;
+    ptr_buffer<expr, 128>                                                          m_key_args;
+
+    circuit * find_circuit(circuit_kind k, unsigned sz, expr * const * a_bits, expr * const * b_bits);
+    circuit * mk_circuit(circuit_kind k, unsigned sz, expr * const * a_bits, expr * const * b_bits);
+    void mk_array_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
+    void mk_tree_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
+    void mk_udiv_urem_core(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & q_bits, expr_ref_vector & r_bits);
+
 public:
     bit_blaster_tpl(Cfg const & cfg = Cfg(), unsigned long long max_memory = UINT64_MAX):
         Cfg(cfg),
@@ -47,6 +102,16 @@ public:
         m_max_memory = max_memory;
     }
 
+    // multipliers of at least this width use a Wallace tree of carry-save adders.
+    void set_mul_tree_size(unsigned sz) {
+        m_mul_tree_size = sz;
+    }
+
+    void reset_circuits() {
+        m_circuit_table.reset();
+        m_circuits.reset();
+    }
+
     
     // Cfg required API
     ast_manager & m() const { return Cfg::m(); }
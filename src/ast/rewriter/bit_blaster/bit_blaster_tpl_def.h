@@ -202,12 +202,100 @@ void bit_blaster_tpl<Cfg>::mk_multiplier(unsigned sz, expr * const * a_bits, exp
         return;
     }
     out_bits.reset();
-#if 0
-    static unsigned counter = 0;
-    counter++;
-    verbose_stream() << "MK_MULTIPLIER: " << counter << std::endl;
-#endif
 
+    // multiplication is commutative: order the operands by the ids of their bits.
+    for (unsigned i = 0; i < sz; ++i) {
+        if (a_bits[i] != b_bits[i]) {
+            if (a_bits[i]->get_id() > b_bits[i]->get_id())
+                std::swap(a_bits, b_bits);
+            break;
+        }
+    }
+    circuit * c = find_circuit(MUL_CIRCUIT, sz, a_bits, b_bits);
+    if (c) {
+        out_bits.append(c->m_out1);
+        return;
+    }
+    if (sz >= m_mul_tree_size)
+        mk_tree_multiplier(sz, a_bits, b_bits, out_bits);
+    else
+        mk_array_multiplier(sz, a_bits, b_bits, out_bits);
+    c = mk_circuit(MUL_CIRCUIT, sz, a_bits, b_bits);
+    c->m_out1.append(out_bits);
+}
+
+template<typename Cfg>
+typename bit_blaster_tpl<Cfg>::circuit * bit_blaster_tpl<Cfg>::find_circuit(circuit_kind k, unsigned sz, expr * const * a_bits, expr * const * b_bits) {
+    m_key_args.reset();
+    m_key_args.append(sz, a_bits);
+    m_key_args.append(sz, b_bits);
+    circuit_key key = { k, sz, m_key_args.data() };
+    circuit * c = nullptr;
+    m_circuit_table.find(key, c);
+    return c;
+}
+
+template<typename Cfg>
+typename bit_blaster_tpl<Cfg>::circuit * bit_blaster_tpl<Cfg>::mk_circuit(circuit_kind k, unsigned sz, expr * const * a_bits, expr * const * b_bits) {
+    circuit * c = alloc(circuit, m(), k, sz, a_bits, b_bits);
+    m_circuits.push_back(c);
+    circuit_key key = { k, sz, c->m_args.data() };
+    m_circuit_table.insert(key, c);
+    return c;
+}
+
+/**
+   \brief Multiplier that sums the partial products a[i]&b[j] column by column
+   with full adders (3:2 compressors) until at most two bits remain in each 
+   column, and adds the two remaining rows with a ripple carry adder.
+   The depth is logarithmic in sz instead of linear.
+*/
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::mk_tree_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits) {
+    vector<expr_ref_vector> cols;
+    for (unsigned k = 0; k < sz; ++k)
+        cols.push_back(expr_ref_vector(m()));
+    expr_ref t(m()), sum(m()), carry(m());
+    for (unsigned i = 0; i < sz; ++i) {
+        for (unsigned j = 0; i + j < sz; ++j) {
+            mk_and(a_bits[i], b_bits[j], t);
+            if (!m().is_false(t))
+                cols[i + j].push_back(t);
+        }
+    }
+    bool reduced = true;
+    while (reduced) {
+        checkpoint();
+        reduced = false;
+        vector<expr_ref_vector> next;
+        for (unsigned k = 0; k < sz; ++k)
+            next.push_back(expr_ref_vector(m()));
+        for (unsigned k = 0; k < sz; ++k) {
+            expr_ref_vector const & col = cols[k];
+            unsigned i = 0;
+            for (; i + 3 <= col.size(); i += 3) {
+                mk_full_adder(col.get(i), col.get(i + 1), col.get(i + 2), sum, carry);
+                next[k].push_back(sum);
+                if (k + 1 < sz)
+                    next[k + 1].push_back(carry);
+                reduced = true;
+            }
+            for (; i < col.size(); ++i)
+                next[k].push_back(col.get(i));
+        }
+        cols.swap(next);
+    }
+    ptr_buffer<expr, 128> row1, row2;
+    for (unsigned k = 0; k < sz; ++k) {
+        SASSERT(cols[k].size() <= 2);
+        row1.push_back(cols[k].size() > 0 ? cols[k].get(0) : m().mk_false());
+        row2.push_back(cols[k].size() > 1 ? cols[k].get(1) : m().mk_false());
+    }
+    mk_adder(sz, row1.data(), row2.data(), out_bits);
+}
+
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::mk_array_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits) {
     expr_ref_vector cins(m()), couts(m());
     expr_ref out(m()), cout(m());
 
@@ -381,6 +469,21 @@ void bit_blaster_tpl<Cfg>::mk_smul_no_underflow(unsigned sz, expr * const * a_bi
 template<typename Cfg>
 void bit_blaster_tpl<Cfg>::mk_udiv_urem(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & q_bits, expr_ref_vector & r_bits) {
     SASSERT(sz > 0);
+    circuit * c = find_circuit(UDIV_UREM_CIRCUIT, sz, a_bits, b_bits);
+    if (c) {
+        q_bits.append(c->m_out1);
+        r_bits.append(c->m_out2);
+        return;
+    }
+    mk_udiv_urem_core(sz, a_bits, b_bits, q_bits, r_bits);
+    c = mk_circuit(UDIV_UREM_CIRCUIT, sz, a_bits, b_bits);
+    c->m_out1.append(q_bits);
+    c->m_out2.append(r_bits);
+}
+
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::mk_udiv_urem_core(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & q_bits, expr_ref_vector & r_bits) {
+    SASSERT(sz > 0);
 
     // p is the residual of each stage of the division.
     expr_ref_vector & p = r_bits;
@@ -91,6 +91,7 @@ public:
     bool elim_and() const { return m_elim_and; }
     void set_elim_and(bool f) { m_elim_and = f; }
     void reset_local_ctx_cost() { m_local_ctx_cost = 0; }
+    bool order_eq() const { return m_order_eq; }
     void set_order_eq(bool f) { m_order_eq = f; }
     
     void updt_params(params_ref const & p);
@@ -7,7 +7,7 @@ Module Name:
 
 Abstract:
 
-    <abstract>
+    Cache of quantifier instances.
 
 Author:
 
@@ -33,7 +33,8 @@ bool cached_var_subst::key_eq_proc::operator()(cached_var_subst::key * k1, cache
 cached_var_subst::cached_var_subst(ast_manager & _m):
     m(_m),
     m_proc(m),
-    m_refs(m) {
+    m_refs(m),
+    m_pinned(m) {
 }
 
 void cached_var_subst::reset() {
@@ -42,6 +43,101 @@ void cached_var_subst::reset() {
     m_region.reset();
     m_new_keys.reset();
     m_key = nullptr;
+    m_templates.reset();
+    m_template_store.reset();
+}
+
+cached_var_subst::inst_template & cached_var_subst::get_template(quantifier * q) {
+    inst_template * t = nullptr;
+    if (m_templates.find(q, t))
+        return *t;
+    t = alloc(inst_template);
+    m_template_store.push_back(t);
+    m_templates.insert(q, t);
+    m_refs.push_back(q);
+    expr * body = q->get_expr();
+    if (has_quantifiers(body)) {
+        t->m_valid = false;
+        return *t;
+    }
+    // post-order traversal of the sub-terms with variables
+    obj_map<expr, unsigned> node_of;
+    ptr_buffer<expr> todo;
+    todo.push_back(body);
+    while (!todo.empty()) {
+        expr * e = todo.back();
+        if (node_of.contains(e)) {
+            todo.pop_back();
+            continue;
+        }
+        if (is_var(e)) {
+            t->m_max_var = std::max(t->m_max_var, to_var(e)->get_idx());
+            node_of.insert(e, t->m_nodes.size());
+            t->m_nodes.push_back(e);
+            t->m_arg_begin.push_back(t->m_args.size());
+            todo.pop_back();
+            continue;
+        }
+        app * a = to_app(e);
+        bool visited = true;
+        for (expr * arg : *a)
+            if (!is_ground(arg) && !node_of.contains(arg)) {
+                todo.push_back(arg);
+                visited = false;
+            }
+        if (!visited)
+            continue;
+        todo.pop_back();
+        node_of.insert(e, t->m_nodes.size());
+        t->m_nodes.push_back(e);
+        t->m_arg_begin.push_back(t->m_args.size());
+        for (expr * arg : *a)
+            t->m_args.push_back(is_ground(arg) ? UINT_MAX : node_of[arg]);
+    }
+    t->m_arg_begin.push_back(t->m_args.size());
+    return *t;
+}
+
+/**
+   \brief instance of the body of q in the standard order of var_subst:
+   (VAR 0) is bound to the last binding.
+*/
+expr_ref cached_var_subst::instantiate(quantifier * q, unsigned num_bindings, expr * const * bindings) {
+    expr * body = q->get_expr();
+    if (is_ground(body) || num_bindings == 0)
+        return expr_ref(body, m);
+    inst_template & t = get_template(q);
+    if (!t.m_valid || t.m_max_var >= num_bindings)
+        return m_proc(body, num_bindings, bindings);
+    for (unsigned i = 0; i < num_bindings; ++i)
+        if (!bindings[i])
+            return m_proc(body, num_bindings, bindings);
+    unsigned sz = t.m_nodes.size();
+    m_values.reset();
+    m_pinned.reset();
+    for (unsigned i = 0; i < sz; ++i) {
+        expr * e = t.m_nodes[i];
+        if (is_var(e)) {
+            m_values.push_back(bindings[num_bindings - to_var(e)->get_idx() - 1]);
+            continue;
+        }
+        app * a = to_app(e);
+        m_app_args.reset();
+        bool same = true;
+        unsigned b = t.m_arg_begin[i];
+        for (unsigned j = 0; j < a->get_num_args(); ++j) {
+            unsigned n = t.m_args[b + j];
+            expr * arg = n == UINT_MAX ? a->get_arg(j) : m_values[n];
+            same &= arg == a->get_arg(j);
+            m_app_args.push_back(arg);
+        }
+        expr * r = same ? a : m.mk_app(a->get_decl(), m_app_args.size(), m_app_args.data());
+        m_pinned.push_back(r);
+        m_values.push_back(r);
+    }
+    expr_ref result(m_values.back(), m);
+    m_pinned.reset();
+    return result;
 }
 
 expr** cached_var_subst::operator()(quantifier* qa, unsigned num_bindings) {
@@ -75,7 +171,7 @@ expr_ref cached_var_subst::operator()() {
 
     SASSERT(entry->get_data().m_value == 0);
     try {
-        result = m_proc(m_key->m_qa->get_expr(), m_key->m_num_bindings, m_key->m_bindings);
+        result = instantiate(m_key->m_qa, m_key->m_num_bindings, m_key->m_bindings);
     }
     catch (...) {
         // CMW: The var_subst reducer was interrupted and m_instances is
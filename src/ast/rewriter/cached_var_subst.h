@@ -7,7 +7,14 @@ Module Name:
 
 Abstract:
 
-    <abstract>
+    Cache of quantifier instances.
+
+    The quantifier-free bodies of quantifiers are compiled into an
+    instantiation template on their first instance: the sub-terms that
+    contain variables, in post-order, with the positions of their
+    arguments that contain variables. Ground sub-terms are shared by all
+    instances, so an instance is assembled with one mk_app per sub-term
+    of the template, without traversing the body.
 
 Author:
 
@@ -20,6 +27,8 @@ Revision History:
 
 #include "ast/rewriter/var_subst.h"
 #include "util/map.h"
+#include "util/obj_hashtable.h"
+#include "util/scoped_ptr_vector.h"
 
 class cached_var_subst {
     struct key {
@@ -36,6 +45,15 @@ class cached_var_subst {
         bool operator()(key * k1, key * k2) const;
     };
     typedef map<key *, expr *, key_hash_proc, key_eq_proc> instances;
+
+    struct inst_template {
+        ptr_vector<expr> m_nodes;      // sub-terms with variables in post-order, the body is last
+        unsigned_vector  m_arg_begin;  // node -> position of its first argument in m_args
+        unsigned_vector  m_args;       // argument -> node of the argument, UINT_MAX for ground arguments
+        unsigned         m_max_var = 0;
+        bool             m_valid = true;  // false if the body has quantifiers
+    };
+
     ast_manager&     m;
     var_subst        m_proc;
     expr_ref_vector  m_refs;
@@ -43,6 +61,15 @@ class cached_var_subst {
     region           m_region;
     ptr_vector<key>  m_new_keys; // mapping from num_bindings -> next key
     key*             m_key { nullptr };
+    obj_map<quantifier, inst_template*> m_templates;
+    scoped_ptr_vector<inst_template>    m_template_store;
+    ptr_vector<expr>                    m_values;
+    expr_ref_vector                     m_pinned;
+    ptr_buffer<expr>                    m_app_args;
+
+    inst_template & get_template(quantifier * q);
+    expr_ref instantiate(quantifier * q, unsigned num_bindings, expr * const * bindings);
+
 public:
     cached_var_subst(ast_manager & m);
     expr** operator()(quantifier * qa, unsigned num_bindings);
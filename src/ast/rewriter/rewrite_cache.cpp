@@ -0,0 +1,44 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    rewrite_cache.cpp
+
+Abstract:
+
+    Cache of rewrite results shared by the th_rewriter instances of an
+    ast_manager.
+
+--*/
+
+#include "ast/rewriter/rewrite_cache.h"
+
+rewrite_cache& rewrite_cache::get(ast_manager& m, unsigned max_size) {
+    auto* c = static_cast<rewrite_cache*>(m.get_rewrite_cache());
+    if (!c) {
+        c = alloc(rewrite_cache, m, max_size);
+        m.set_rewrite_cache(c);
+    }
+    c->m_max_size = max_size;
+    return *c;
+}
+
+void rewrite_cache::insert(expr* t, unsigned cfg, expr* r) {
+    if (m_cache.size() >= m_max_size)
+        reset();
+    auto& e = m_cache.insert_if_not_there(key(t, cfg), nullptr);
+    if (e)
+        return;
+    m.inc_ref(t);
+    m.inc_ref(r);
+    e = r;
+}
+
+void rewrite_cache::reset() {
+    for (auto const& kv : m_cache) {
+        m.dec_ref(kv.m_key.first);
+        m.dec_ref(kv.m_value);
+    }
+    m_cache.reset();
+}
@@ -0,0 +1,60 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    rewrite_cache.h
+
+Abstract:
+
+    Cache of rewrite results shared by the th_rewriter instances of an
+    ast_manager.
+
+    The cache of a rewriter lives as long as the rewriter, so tactics that
+    create rewriters for every goal simplify the same sub-terms again and
+    again. This cache is owned by the ast_manager and maps a term and a
+    hash of the rewriter configuration to the rewritten term. It is bounded
+    by the number of entries and cleared when it reaches the bound.
+
+--*/
+#pragma once
+
+#include "util/map.h"
+#include "ast/ast.h"
+
+class rewrite_cache : public ast_manager_extension {
+    typedef std::pair<expr*, unsigned> key;
+    struct key_hash {
+        unsigned operator()(key const& k) const { return combine_hash(k.first->hash(), k.second); }
+    };
+    typedef map<key, expr*, key_hash, default_eq<key>> key2expr;
+
+    ast_manager& m;
+    key2expr     m_cache;
+    unsigned     m_max_size;
+    unsigned     m_num_hits = 0;
+
+public:
+    rewrite_cache(ast_manager& m, unsigned max_size): m(m), m_max_size(max_size) {}
+
+    ~rewrite_cache() override { reset(); }
+
+    /**
+       \brief Return the cache of m. It is created if it does not exist, its bound is set to max_size.
+    */
+    static rewrite_cache& get(ast_manager& m, unsigned max_size);
+
+    bool find(expr* t, unsigned cfg, expr*& r) {
+        if (!m_cache.find(key(t, cfg), r))
+            return false;
+        ++m_num_hits;
+        return true;
+    }
+
+    void insert(expr* t, unsigned cfg, expr* r);
+
+    void reset();
+
+    unsigned size() const { return m_cache.size(); }
+    unsigned num_hits() const { return m_num_hits; }
+};
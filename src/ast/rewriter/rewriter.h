@@ -115,6 +115,7 @@ protected:
     
     void elim_reflex_prs(unsigned spos);
     void block(expr* t) { m_blocked.insert(t); }
+    void reset_blocked() { m_blocked.reset(); }
     bool is_blocked(expr* t) const { return m_blocked.contains(t); }
 public:
     rewriter_core(ast_manager & m, bool proof_gen);
@@ -221,6 +222,8 @@ protected:
     };
     Config &                   m_cfg;
     unsigned                   m_num_steps;
+    unsigned                   m_num_cache_checks = 0;
+    unsigned                   m_num_cache_hits = 0;
     ptr_vector<expr>           m_bindings;
     var_shifter                m_shifter;
     inv_var_shifter            m_inv_shifter;
@@ -228,6 +231,8 @@ protected:
     proof_ref                  m_pr;
     proof_ref                  m_pr2;
     unsigned_vector            m_shifts;
+    // rewriter for the expansions of constants, it is kept to reuse its stacks and caches.
+    scoped_ptr<rewriter_tpl>   m_const_rw;
 
     svector<frame> & frame_stack() { return this->m_frame_stack; }
     svector<frame> const & frame_stack() const { return this->m_frame_stack; }
@@ -313,8 +318,10 @@ protected:
     template<bool ProofGen>
     void cache_result(expr * t, expr * new_t, proof * pr, bool c) {
         if (c) {
-            if (!ProofGen)
+            if (!ProofGen) {
                 rewriter_core::cache_result(t, new_t);
+                m_cfg.cache_result_eh(t, new_t);
+            }
             else
                 rewriter_core::cache_result(t, new_t, pr);
         }
@@ -372,6 +379,9 @@ public:
 
     // Return the number of steps performed by the rewriter in the last call to operator().
     unsigned get_num_steps() const { return m_num_steps; }
+    // Return the number of cache lookups and cache hits in the last call to operator().
+    unsigned get_num_cache_checks() const { return m_num_cache_checks; }
+    unsigned get_num_cache_hits() const { return m_num_cache_hits; }
 };
 
 struct default_rewriter_cfg {
@@ -396,6 +406,8 @@ struct default_rewriter_cfg {
     bool get_macro(func_decl * d, expr * & def, quantifier * & q, proof * & def_pr) { return false; }
     bool reduce_macro() { return false; }
     bool get_subst(expr * s, expr * & t, proof * & t_pr) { return false; }
+    // invoked when the result of rewriting t is cached, without proofs
+    void cache_result_eh(expr * t, expr * new_t) {}
     void reset() {}
     void cleanup() {}
 };
@@ -171,8 +171,10 @@ bool rewriter_tpl<Config>::visit(expr * t, unsigned max_depth) {
         if (checked_cache % 100000 == 0)
             std::cerr << "[rewriter] num-cache-checks: " << checked_cache << std::endl;
 #endif
+        ++m_num_cache_checks;
         expr * r = get_cached(t);
         if (r) {
+            ++m_num_cache_hits;
             SASSERT(r->get_sort() == t->get_sort());
             result_stack().push_back(r);
             set_new_child_flag(t, r);
@@ -198,7 +200,12 @@ bool rewriter_tpl<Config>::visit(expr * t, unsigned max_depth) {
                 return true;
             TRACE("rewriter_const", tout << "process const: " << mk_bounded_pp(t, m()) << " -> " << mk_bounded_pp(m_r, m()) << "\n";);
             if (!is_blocked(t)) {
-                rewriter_tpl rw(m(), false, m_cfg);
+                if (!m_const_rw)
+                    m_const_rw = alloc(rewriter_tpl, m(), false, m_cfg);
+                rewriter_tpl& rw = *m_const_rw;
+                // the configuration is shared, only the state of rw is reset.
+                rw.rewriter_core::reset();
+                rw.reset_blocked();
                 for (auto* s : m_blocked)
                     rw.block(s);
                 rw.block(t);
@@ -658,6 +665,7 @@ template<typename Config>
 void rewriter_tpl<Config>::cleanup() {
     m_cfg.cleanup();
     rewriter_core::cleanup();
+    m_const_rw = nullptr;
     m_bindings.finalize();
     m_shifter.cleanup();
     m_shifts.finalize();
@@ -730,6 +738,8 @@ void rewriter_tpl<Config>::main_loop(expr * t, expr_ref & result, proof_ref & re
     m_root      = t;
     m_num_qvars = 0;
     m_num_steps = 0;    
+    m_num_cache_checks = 0;
+    m_num_cache_hits = 0;
     if (visit<ProofGen>(t, RW_UNBOUNDED_DEPTH)) {
         result = result_stack().back();
         result_stack().pop_back();
@@ -3138,11 +3138,22 @@ bool seq_rewriter::check_deriv_normal_form(expr* r, int level) {
 #endif
 
 expr_ref seq_rewriter::mk_derivative(expr* r) {
+    expr* d = nullptr;
+    if (m_derivatives.find(r, d))
+        return expr_ref(d, m());
     sort* seq_sort = nullptr, * ele_sort = nullptr;
     VERIFY(m_util.is_re(r, seq_sort));
     VERIFY(m_util.is_seq(seq_sort, ele_sort));
     expr_ref v(m().mk_var(0, ele_sort), m());
-    return mk_antimirov_deriv(v, r, m().mk_true());
+    expr_ref result = mk_antimirov_deriv(v, r, m().mk_true());
+    if (m_derivatives.size() >= m_max_derivatives) {
+        m_derivatives.reset();
+        m_derivative_trail.reset();
+    }
+    m_derivative_trail.push_back(r);
+    m_derivative_trail.push_back(result);
+    m_derivatives.insert(r, result);
+    return result;
 }
 
 expr_ref seq_rewriter::mk_derivative(expr* ele, expr* r) {
@@ -4494,6 +4505,9 @@ br_status seq_rewriter::mk_str_in_regexp(expr* a, expr* b, expr_ref& result) {
        result = m_br.mk_eq_rw(a, b_s);
        return BR_REWRITE_FULL;
     }
+    zstring s;
+    if (str().is_string(a, s) && s.length() > 1 && is_ground(b) && mk_ground_in_re(s, b, result))
+        return BR_DONE;
     expr* b1 = nullptr;
     expr* eps = nullptr;
     if (re().is_opt(b, b1) ||
@@ -4579,6 +4593,118 @@ br_status seq_rewriter::mk_str_in_regexp(expr* a, expr* b, expr_ref& result) {
     return BR_FAILED;
 }
 
+/**
+   \brief decide membership of the string literal s in the ground regex r.
+
+   The states of a DFA for r are the derivatives of r. Its transitions are
+   computed on demand and kept in m_ground_delta, so matching a string
+   walks a table and creates terms only for transitions it has not seen
+   before. Returns false if a derivative or the nullability of a state
+   cannot be evaluated, for example because r contains regex constants.
+*/
+bool seq_rewriter::mk_ground_in_re(zstring const& s, expr* r, expr_ref& result) {
+    expr_ref state(r, m()), next(m());
+    for (unsigned i = 0; i < s.length(); ++i) {
+        if (re().is_empty(state)) {
+            result = m().mk_false();
+            return true;
+        }
+        if (re().is_full_seq(state)) {
+            result = m().mk_true();
+            return true;
+        }
+        if (!mk_ground_delta(state, u().mk_char(s[i]), next))
+            return false;
+        state = next;
+    }
+    result = is_nullable(state);
+    return m().is_true(result) || m().is_false(result);
+}
+
+bool seq_rewriter::mk_ground_delta(expr* r, expr* ch, expr_ref& next) {
+    expr* n = nullptr;
+    if (m_ground_delta.find(r, ch, n)) {
+        next = n;
+        return true;
+    }
+    expr_ref d = mk_antimirov_deriv(ch, r, m().mk_true());
+    if (!ground_deriv2re(d, next))
+        return false;
+    if (m_ground_delta.size() >= m_max_derivatives) {
+        m_ground_delta.reset();
+        m_ground_trail.reset();
+    }
+    m_ground_trail.push_back(r);
+    m_ground_trail.push_back(ch);
+    m_ground_trail.push_back(next);
+    m_ground_delta.insert(r, ch, next);
+    return true;
+}
+
+/**
+   \brief turn a derivative with respect to a character literal into a
+   regex by evaluating the conditions of its ite-nodes.
+*/
+bool seq_rewriter::ground_deriv2re(expr* d, expr_ref& result) {
+    expr* c = nullptr, * d1 = nullptr, * d2 = nullptr;
+    if (m().is_ite(d, c, d1, d2)) {
+        switch (eval_char_cond(c)) {
+        case l_true: return ground_deriv2re(d1, result);
+        case l_false: return ground_deriv2re(d2, result);
+        default: return false;
+        }
+    }
+    if (re().is_union(d, d1, d2)) {
+        expr_ref r1(m()), r2(m());
+        if (!ground_deriv2re(d1, r1) || !ground_deriv2re(d2, r2))
+            return false;
+        result = mk_regex_union_normalize(r1, r2);
+        return true;
+    }
+    if (re().is_derivative(d))
+        return false;
+    result = d;
+    return true;
+}
+
+lbool seq_rewriter::eval_char_cond(expr* c) {
+    expr* c1 = nullptr, * c2 = nullptr;
+    unsigned ch1 = 0, ch2 = 0;
+    if (m().is_true(c))
+        return l_true;
+    if (m().is_false(c))
+        return l_false;
+    if (m().is_not(c, c1))
+        return ~eval_char_cond(c1);
+    if (m().is_and(c)) {
+        lbool r = l_true;
+        for (expr* arg : *to_app(c)) {
+            lbool v = eval_char_cond(arg);
+            if (v == l_false)
+                return l_false;
+            if (v == l_undef)
+                r = l_undef;
+        }
+        return r;
+    }
+    if (m().is_or(c)) {
+        lbool r = l_false;
+        for (expr* arg : *to_app(c)) {
+            lbool v = eval_char_cond(arg);
+            if (v == l_true)
+                return l_true;
+            if (v == l_undef)
+                r = l_undef;
+        }
+        return r;
+    }
+    if (m().is_eq(c, c1, c2) && u().is_const_char(c1, ch1) && u().is_const_char(c2, ch2))
+        return ch1 == ch2 ? l_true : l_false;
+    if (u().is_char_le(c, c1, c2) && u().is_const_char(c1, ch1) && u().is_const_char(c2, ch2))
+        return ch1 <= ch2 ? l_true : l_false;
+    return l_undef;
+}
+
 bool seq_rewriter::has_fixed_length_constraint(expr* a, unsigned& len) {
     unsigned minl = re().min_length(a), maxl = re().max_length(a);
     len = minl;
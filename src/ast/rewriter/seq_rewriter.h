@@ -26,6 +26,7 @@ Notes:
 #include "util/params.h"
 #include "util/lbool.h"
 #include "util/sign.h"
+#include "util/obj_pair_hashtable.h"
 #include "math/automata/automaton.h"
 #include "math/automata/symbolic_automata.h"
 
@@ -152,6 +153,16 @@ class seq_rewriter {
     bool_rewriter  m_br;
     re2automaton   m_re2aut;
     op_cache       m_op_cache;
+    // symbolic derivatives of regexes with respect to (:var 0). They are
+    // kept apart from m_op_cache, which is flushed when it gets full, so
+    // the derivative automaton of a regex is built only once per rewriter.
+    obj_map<expr, expr*> m_derivatives;
+    expr_ref_vector m_derivative_trail;
+    unsigned       m_max_derivatives = 100000;
+    // transitions (regex, character) -> regex of the lazily built DFA
+    // used for membership of string literals in ground regexes.
+    obj_pair_map<expr, expr, expr*> m_ground_delta;
+    expr_ref_vector m_ground_trail;
     expr_ref_vector m_es, m_lhs, m_rhs;
     bool           m_coalesce_chars;    
 
@@ -266,6 +277,10 @@ class seq_rewriter {
     br_status mk_str_ubv2s(expr* a, expr_ref& result);
     br_status mk_str_sbv2s(expr* a, expr_ref& result);
     br_status mk_str_in_regexp(expr* a, expr* b, expr_ref& result);
+    bool mk_ground_in_re(zstring const& s, expr* r, expr_ref& result);
+    bool mk_ground_delta(expr* r, expr* ch, expr_ref& next);
+    bool ground_deriv2re(expr* d, expr_ref& result);
+    lbool eval_char_cond(expr* c);
     br_status mk_str_to_regexp(expr* a, expr_ref& result);
     br_status mk_str_le(expr* a, expr* b, expr_ref& result);
     br_status mk_str_lt(expr* a, expr* b, expr_ref& result);
@@ -354,7 +369,7 @@ class seq_rewriter {
 
 public:
     seq_rewriter(ast_manager & m, params_ref const & p = params_ref()):
-        m_util(m), m_autil(m), m_br(m, p), m_re2aut(m), m_op_cache(m), m_es(m), 
+        m_util(m), m_autil(m), m_br(m, p), m_re2aut(m), m_op_cache(m), m_derivative_trail(m), m_ground_trail(m), m_es(m), 
         m_lhs(m), m_rhs(m), m_coalesce_chars(true) {
     }
     ast_manager & m() const { return m_util.get_manager(); }
@@ -16,6 +16,7 @@ Author:
 Notes:
 
 --*/
+#include "util/gparams.h"
 #include "params/rewriter_params.hpp"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/rewriter/bool_rewriter.h"
@@ -30,6 +31,7 @@ Notes:
 #include "ast/rewriter/recfun_rewriter.h"
 #include "ast/rewriter/seq_rewriter.h"
 #include "ast/rewriter/rewriter_def.h"
+#include "ast/rewriter/rewrite_cache.h"
 #include "ast/rewriter/var_subst.h"
 #include "ast/rewriter/expr_safe_replace.h"
 #include "ast/expr_substitution.h"
@@ -72,7 +74,11 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
     bool                m_push_ite_bv = true;
     bool                m_ignore_patterns_on_ground_qbody = true;
     bool                m_rewrite_patterns = true;
-
+    bool                m_has_solver = false;
+    unsigned            m_global_cache_size = 0;
+    unsigned            m_params_hash = 0;
+    unsigned            m_cfg_hash = 0;
+    rewrite_cache *     m_global_cache = nullptr; // shared with the other rewriters of m() if global_cache_size > 0
 
     ast_manager & m() const { return m_b_rw.m(); }
 
@@ -87,6 +93,29 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         m_push_ite_bv    = p.push_ite_bv();
         m_ignore_patterns_on_ground_qbody = p.ignore_patterns_on_ground_qbody();
         m_rewrite_patterns = p.rewrite_patterns();
+        m_global_cache_size = p.global_cache_size();
+        updt_global_cache(_p);
+    }
+
+    /**
+       \brief results are shared through the global cache only between rewriters
+       that use the same parameters and settings.
+    */
+    void updt_global_cache(params_ref const & p) {
+        m_global_cache = nullptr;
+        if (m_global_cache_size == 0 || m().proofs_enabled() || m_has_solver)
+            return;
+        std::ostringstream strm;
+        p.display(strm);
+        gparams::get_module("rewriter").display(strm);
+        std::string str = strm.str();
+        m_params_hash = string_hash(str.c_str(), static_cast<unsigned>(str.length()), 17);
+        updt_cfg_hash();
+        m_global_cache = &rewrite_cache::get(m(), m_global_cache_size);
+    }
+
+    void updt_cfg_hash() {
+        m_cfg_hash = combine_hash(m_params_hash, (m_b_rw.flat_and_or() ? 1 : 0) + (m_b_rw.order_eq() ? 2 : 0));
     }
 
     void updt_params(params_ref const & p) {
@@ -888,7 +917,7 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
 
     bool get_subst(expr * s, expr * & t, proof * & pr) {
         if (m_subst == nullptr)
-            return false;
+            return m_global_cache && is_ground(s) && m_global_cache->find(s, m_cfg_hash, t);
         expr_dependency * d = nullptr;
         if (m_subst->find(s, t, pr, d)) {
             m_used_dependencies = m().mk_join(m_used_dependencies, d);
@@ -897,6 +926,10 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         return false;
     }
 
+    void cache_result_eh(expr * t, expr * new_t) {
+        if (m_global_cache && !m_subst && is_ground(t))
+            m_global_cache->insert(t, m_cfg_hash, new_t);
+    }
 
 };
 }
@@ -917,6 +950,10 @@ struct th_rewriter::imp : public rewriter_tpl<th_rewriter_cfg> {
 
     void set_solver(expr_solver* solver) {
         m_cfg.m_seq_rw.set_solver(solver);
+        // the results may depend on the solver
+        m_cfg.m_has_solver = solver != nullptr;
+        if (m_cfg.m_has_solver)
+            m_cfg.m_global_cache = nullptr;
     }
 };
 
@@ -944,10 +981,12 @@ void th_rewriter::get_param_descrs(param_descrs & r) {
 
 void th_rewriter::set_flat_and_or(bool f) {
     m_imp->cfg().m_b_rw.set_flat_and_or(f);
+    m_imp->cfg().updt_cfg_hash();
 }
 
 void th_rewriter::set_order_eq(bool f) {
     m_imp->cfg().m_b_rw.set_order_eq(f);
+    m_imp->cfg().updt_cfg_hash();
 }
 
 th_rewriter::~th_rewriter() {
@@ -962,6 +1001,14 @@ unsigned th_rewriter::get_num_steps() const {
     return m_imp->get_num_steps();
 }
 
+unsigned th_rewriter::get_num_cache_checks() const {
+    return m_imp->get_num_cache_checks();
+}
+
+unsigned th_rewriter::get_num_cache_hits() const {
+    return m_imp->get_num_cache_hits();
+}
+
 void th_rewriter::cleanup() {
     ast_manager & m = m_imp->m();
     m_imp->~imp();
@@ -981,6 +1028,7 @@ void th_rewriter::operator()(expr_ref & term) {
 
 void th_rewriter::operator()(expr * t, expr_ref & result) {
     m_imp->operator()(t, result);
+    m_imp->cfg().cache_result_eh(t, result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr) {
@@ -988,6 +1036,7 @@ void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr)
 }
 
 expr_ref th_rewriter::operator()(expr * n, unsigned num_bindings, expr * const * bindings) {
+    flet<rewrite_cache*> _no_global_cache(m_imp->cfg().m_global_cache, nullptr);
     return m_imp->operator()(n, num_bindings, bindings);
 }
 
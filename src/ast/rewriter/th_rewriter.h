@@ -44,6 +44,8 @@ public:
 
     unsigned get_cache_size() const;
     unsigned get_num_steps() const;
+    unsigned get_num_cache_checks() const;
+    unsigned get_num_cache_hits() const;
    
     void operator()(expr_ref& term);
     void operator()(expr * t, expr_ref & result);
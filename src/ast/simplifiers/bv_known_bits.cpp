@@ -0,0 +1,675 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bv_known_bits.cpp
+
+Abstract:
+
+    simplifier that propagates known bits of bit-vector terms.
+
+    The known bits of terms other than leaves are used only while
+    propagating facts. The rewrite uses the bits that follow from the
+    leaves by the transfer functions, so that the formulas that record the
+    known bits of the leaves justify every replacement.
+
+--*/
+
+#include "ast/simplifiers/bv_known_bits.h"
+
+namespace bv {
+
+    void known_bits::reduce() {
+        m_conflict = false;
+        m_dep = nullptr;
+        m_eqs.reset();
+        for (unsigned i = m_qhead; i < m_fmls.size(); ++i) {
+            auto const [f, d] = m_fmls[i]();
+            expr* x, * y;
+            if (m.is_eq(f, x, y) && m_bv.is_bv(x)) {
+                m_eqs.push_back(f);
+                m_dep = m.mk_join(m_dep, d);
+            }
+        }
+        propagate();
+        if (m_conflict)
+            m_fmls.add(dependent_expr(m, m.mk_false(), m_dep));
+        else
+            rewrite();
+        reset_values();
+        m_fact2idx.reset();
+        m_facts.reset();
+        m_fact_terms.reset();
+        m_eqs.reset();
+        m_dep = nullptr;
+        advance_qhead(m_fmls.size());
+    }
+
+    bool known_bits::is_bv_op(expr* e) const {
+        if (!is_app(e))
+            return false;
+        if (m.is_ite(e))
+            return m_bv.is_bv(e);
+        app* a = to_app(e);
+        if (a->get_family_id() != m_bv.get_fid())
+            return false;
+        switch (a->get_decl_kind()) {
+        case OP_BV_NUM:
+        case OP_BNOT:
+        case OP_BAND:
+        case OP_BOR:
+        case OP_BXOR:
+        case OP_CONCAT:
+        case OP_EXTRACT:
+        case OP_ZERO_EXT:
+        case OP_SIGN_EXT:
+        case OP_BSHL:
+        case OP_BLSHR:
+        case OP_BASHR:
+        case OP_BADD:
+        case OP_BSUB:
+        case OP_BNEG:
+        case OP_BMUL:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    known_bits::bits const* known_bits::fact(expr* e) const {
+        unsigned idx;
+        if (m_fact2idx.find(e, idx))
+            return &m_facts[idx];
+        return nullptr;
+    }
+
+    unsigned known_bits::num_significant(bits const& b) {
+        unsigned n = b.size();
+        while (n > 0 && b[n - 1] == l_false)
+            --n;
+        return n;
+    }
+
+    bool known_bits::all_known(bits const& b) {
+        return all_of(b, [](lbool v) { return v != l_undef; });
+    }
+
+    bool known_bits::any_known(bits const& b) {
+        return any_of(b, [](lbool v) { return v != l_undef; });
+    }
+
+    rational known_bits::to_value(bits const& b, unsigned lo, unsigned hi) const {
+        rational r(0), p(1);
+        for (unsigned i = lo; i <= hi; ++i) {
+            if (b[i] == l_true)
+                r += p;
+            p *= rational(2);
+        }
+        return r;
+    }
+
+    void known_bits::reset_values() {
+        m_val2idx.reset();
+        m_vals.reset();
+    }
+
+    /**
+     * Compute the bits of e and its bit-vector sub-terms bottom-up.
+     */
+    void known_bits::eval(expr* e) {
+        if (has_value(e))
+            return;
+        m_todo.push_back(e);
+        while (!m_todo.empty()) {
+            expr* t = m_todo.back();
+            if (has_value(t)) {
+                m_todo.pop_back();
+                continue;
+            }
+            unsigned sz = m_todo.size();
+            if (is_bv_op(t))
+                for (expr* arg : *to_app(t))
+                    if (m_bv.is_bv(arg) && !has_value(arg))
+                        m_todo.push_back(arg);
+            if (sz != m_todo.size())
+                continue;
+            m_todo.pop_back();
+            m_tmp.reset();
+            m_tmp.resize(m_bv.get_bv_size(t), l_undef);
+            if (is_bv_op(t))
+                compute(to_app(t), m_tmp);
+            bits const* f = fact(t);
+            if (f && (m_use_facts || is_leaf(t))) {
+                for (unsigned i = 0; i < m_tmp.size(); ++i) {
+                    if ((*f)[i] == l_undef)
+                        continue;
+                    if (m_tmp[i] == l_undef)
+                        m_tmp[i] = (*f)[i];
+                    else if (m_tmp[i] != (*f)[i])
+                        m_conflict = true;
+                }
+            }
+            m_val2idx.setx(t->get_id(), m_vals.size() + 1, 0);
+            m_vals.push_back(m_tmp);
+        }
+    }
+
+    /**
+     * Transfer functions. The bits of the arguments of e are computed.
+     */
+    void known_bits::compute(app* e, bits& r) {
+        unsigned w = r.size();
+        auto arg = [&](unsigned i) -> bits const& { return value(e->get_arg(i)); };
+        if (m.is_ite(e)) {
+            bits const& a = arg(1), & b = arg(2);
+            for (unsigned i = 0; i < w; ++i)
+                if (a[i] == b[i])
+                    r[i] = a[i];
+            return;
+        }
+        rational v;
+        unsigned sz;
+        switch (e->get_decl_kind()) {
+        case OP_BV_NUM:
+            VERIFY(m_bv.is_numeral(e, v, sz));
+            for (unsigned i = 0; i < w; ++i) {
+                r[i] = v.is_odd() ? l_true : l_false;
+                v = div(v, rational(2));
+            }
+            break;
+        case OP_BNOT:
+            for (unsigned i = 0; i < w; ++i)
+                r[i] = ~arg(0)[i];
+            break;
+        case OP_BAND:
+            r = arg(0);
+            for (unsigned j = 1; j < e->get_num_args(); ++j) {
+                bits const& b = arg(j);
+                for (unsigned i = 0; i < w; ++i)
+                    r[i] = (r[i] == l_false || b[i] == l_false) ? l_false : (r[i] == l_true && b[i] == l_true) ? l_true : l_undef;
+            }
+            break;
+        case OP_BOR:
+            r = arg(0);
+            for (unsigned j = 1; j < e->get_num_args(); ++j) {
+                bits const& b = arg(j);
+                for (unsigned i = 0; i < w; ++i)
+                    r[i] = (r[i] == l_true || b[i] == l_true) ? l_true : (r[i] == l_false && b[i] == l_false) ? l_false : l_undef;
+            }
+            break;
+        case OP_BXOR:
+            r = arg(0);
+            for (unsigned j = 1; j < e->get_num_args(); ++j) {
+                bits const& b = arg(j);
+                for (unsigned i = 0; i < w; ++i)
+                    r[i] = (r[i] == l_undef || b[i] == l_undef) ? l_undef : (r[i] != b[i]) ? l_true : l_false;
+            }
+            break;
+        case OP_CONCAT: {
+            unsigned k = 0;
+            for (unsigned j = e->get_num_args(); j-- > 0; )
+                for (lbool b : arg(j))
+                    r[k++] = b;
+            break;
+        }
+        case OP_EXTRACT: {
+            unsigned lo = m_bv.get_extract_low(e);
+            for (unsigned i = 0; i < w; ++i)
+                r[i] = arg(0)[lo + i];
+            break;
+        }
+        case OP_ZERO_EXT:
+        case OP_SIGN_EXT: {
+            bits const& a = arg(0);
+            for (unsigned i = 0; i < w; ++i)
+                r[i] = i < a.size() ? a[i] : e->get_decl_kind() == OP_ZERO_EXT ? l_false : a.back();
+            break;
+        }
+        case OP_BSHL:
+        case OP_BLSHR:
+        case OP_BASHR: {
+            bits const& a = arg(0), & s = arg(1);
+            decl_kind k = e->get_decl_kind();
+            if (all_known(s)) {
+                v = to_value(s, 0, w - 1);
+                unsigned n = v >= rational(w) ? w : v.get_unsigned();
+                for (unsigned i = 0; i < w; ++i) {
+                    if (k == OP_BSHL)
+                        r[i] = i < n ? l_false : a[i - n];
+                    else
+                        r[i] = i + n < w ? a[i + n] : k == OP_BLSHR ? l_false : a[w - 1];
+                }
+            }
+            else if (k == OP_BSHL)
+                for (unsigned i = 0; i < w && a[i] == l_false; ++i)
+                    r[i] = l_false;
+            else if (a[w - 1] != l_undef && (k == OP_BASHR || a[w - 1] == l_false))
+                for (unsigned i = w; i-- > 0 && a[i] == a[w - 1]; )
+                    r[i] = a[w - 1];
+            break;
+        }
+        case OP_BADD:
+            r = arg(0);
+            for (unsigned j = 1; j < e->get_num_args(); ++j)
+                add(r, arg(j), l_false, r);
+            break;
+        case OP_BSUB: {
+            r = arg(0);
+            bits nb;
+            for (unsigned j = 1; j < e->get_num_args(); ++j) {
+                nb.reset();
+                for (lbool b : arg(j))
+                    nb.push_back(~b);
+                add(r, nb, l_true, r);
+            }
+            break;
+        }
+        case OP_BNEG: {
+            bits nb, zero(w, l_false);
+            for (lbool b : arg(0))
+                nb.push_back(~b);
+            add(nb, zero, l_true, r);
+            break;
+        }
+        case OP_BMUL: {
+            r = arg(0);
+            bits a;
+            for (unsigned j = 1; j < e->get_num_args(); ++j) {
+                a = r;
+                mul(a, arg(j), r);
+            }
+            break;
+        }
+        default:
+            UNREACHABLE();
+            break;
+        }
+    }
+
+    /**
+     * Ripple carry addition. r may be the same vector as a.
+     */
+    void known_bits::add(bits const& a, bits const& b, lbool carry, bits& r) {
+        for (unsigned i = 0; i < a.size(); ++i) {
+            lbool x = a[i], y = b[i];
+            unsigned num_true = (x == l_true) + (y == l_true) + (carry == l_true);
+            unsigned num_false = (x == l_false) + (y == l_false) + (carry == l_false);
+            r[i] = num_true + num_false == 3 ? (num_true % 2 == 1 ? l_true : l_false) : l_undef;
+            carry = num_true >= 2 ? l_true : num_false >= 2 ? l_false : l_undef;
+        }
+    }
+
+    /**
+     * The low bits of a product follow from the low bits of the arguments,
+     * trailing zeros add up, and the product has at most as many significant
+     * bits as the arguments together.
+     */
+    void known_bits::mul(bits const& a, bits const& b, bits& r) {
+        unsigned w = a.size();
+        r.reset();
+        r.resize(w, l_undef);
+        unsigned ka = 0, kb = 0, za = 0, zb = 0;
+        while (ka < w && a[ka] != l_undef)
+            ++ka;
+        while (kb < w && b[kb] != l_undef)
+            ++kb;
+        unsigned k = std::min(ka, kb);
+        if (k > 0) {
+            rational p = mod(to_value(a, 0, k - 1) * to_value(b, 0, k - 1), rational::power_of_two(k));
+            for (unsigned i = 0; i < k; ++i) {
+                r[i] = p.is_odd() ? l_true : l_false;
+                p = div(p, rational(2));
+            }
+        }
+        while (za < w && a[za] == l_false)
+            ++za;
+        while (zb < w && b[zb] == l_false)
+            ++zb;
+        for (unsigned i = 0; i < std::min(w, za + zb); ++i)
+            r[i] = l_false;
+        for (unsigned i = num_significant(a) + num_significant(b); i < w; ++i)
+            r[i] = l_false;
+    }
+
+    bool known_bits::add_fact_core(expr* e, bits const& b) {
+        if (!any_known(b))
+            return false;
+        unsigned idx;
+        if (!m_fact2idx.find(e, idx)) {
+            idx = m_facts.size();
+            m_fact2idx.insert(e, idx);
+            m_facts.push_back(bits(b.size(), l_undef));
+            m_fact_terms.push_back(e);
+        }
+        bits& f = m_facts[idx];
+        bool is_new = false;
+        for (unsigned i = 0; i < b.size(); ++i) {
+            if (b[i] == l_undef)
+                continue;
+            if (f[i] == l_undef) {
+                f[i] = b[i];
+                is_new = true;
+            }
+            else if (f[i] != b[i])
+                m_conflict = true;
+        }
+        m_changed |= is_new;
+        return is_new;
+    }
+
+    /**
+     * Record the known bits b of e and push them to the arguments of e.
+     * Arguments are restricted using the bits computed in the current round.
+     */
+    void known_bits::add_fact(expr* e, bits const& b) {
+        vector<std::pair<expr*, bits>> todo;
+        todo.push_back({ e, b });
+        bits ab;
+        while (!todo.empty() && !m_conflict) {
+            auto [t, tb] = todo.back();
+            todo.pop_back();
+            if (!add_fact_core(t, tb))
+                continue;
+            if (!is_bv_op(t) || m.is_ite(t))
+                continue;
+            app* a = to_app(t);
+            unsigned w = tb.size();
+            switch (a->get_decl_kind()) {
+            case OP_CONCAT: {
+                unsigned k = 0;
+                for (unsigned j = a->get_num_args(); j-- > 0; ) {
+                    expr* arg = a->get_arg(j);
+                    unsigned sz = m_bv.get_bv_size(arg);
+                    ab.reset();
+                    for (unsigned i = 0; i < sz; ++i)
+                        ab.push_back(tb[k + i]);
+                    k += sz;
+                    todo.push_back({ arg, ab });
+                }
+                break;
+            }
+            case OP_EXTRACT: {
+                expr* arg = a->get_arg(0);
+                unsigned lo = m_bv.get_extract_low(a);
+                ab.reset();
+                ab.resize(m_bv.get_bv_size(arg), l_undef);
+                for (unsigned i = 0; i < w; ++i)
+                    ab[lo + i] = tb[i];
+                todo.push_back({ arg, ab });
+                break;
+            }
+            case OP_BNOT:
+                ab.reset();
+                for (lbool v : tb)
+                    ab.push_back(~v);
+                todo.push_back({ a->get_arg(0), ab });
+                break;
+            case OP_ZERO_EXT:
+            case OP_SIGN_EXT: {
+                expr* arg = a->get_arg(0);
+                unsigned sz = m_bv.get_bv_size(arg);
+                ab.reset();
+                for (unsigned i = 0; i < sz; ++i)
+                    ab.push_back(tb[i]);
+                if (a->get_decl_kind() == OP_SIGN_EXT)
+                    for (unsigned i = sz; i < w; ++i)
+                        if (tb[i] != l_undef)
+                            ab[sz - 1] = tb[i];
+                todo.push_back({ arg, ab });
+                break;
+            }
+            case OP_BAND:
+            case OP_BOR: {
+                // every argument of an and is true where the and is true, dually for or
+                lbool v = a->get_decl_kind() == OP_BAND ? l_true : l_false;
+                ab.reset();
+                for (unsigned i = 0; i < w; ++i)
+                    ab.push_back(tb[i] == v ? v : l_undef);
+                for (expr* arg : *a)
+                    todo.push_back({ arg, ab });
+                break;
+            }
+            case OP_BXOR:
+            case OP_BADD: {
+                // solve for the only argument whose bits are not all known
+                unsigned j = UINT_MAX, num_unknown = 0;
+                for (unsigned i = 0; i < a->get_num_args(); ++i) {
+                    expr* arg = a->get_arg(i);
+                    if (has_value(arg) && all_known(value(arg)))
+                        continue;
+                    ++num_unknown;
+                    j = i;
+                }
+                if (num_unknown != 1)
+                    break;
+                if (a->get_decl_kind() == OP_BXOR) {
+                    ab = tb;
+                    for (unsigned i = 0; i < a->get_num_args(); ++i)
+                        if (i != j)
+                            for (unsigned k = 0; k < w; ++k)
+                                if (ab[k] != l_undef && value(a->get_arg(i))[k] == l_true)
+                                    ab[k] = ~ab[k];
+                }
+                else {
+                    // the low bits of the argument follow from the known low bits of the sum
+                    unsigned n = 0;
+                    while (n < w && tb[n] != l_undef)
+                        ++n;
+                    if (n == 0)
+                        break;
+                    rational s = to_value(tb, 0, n - 1);
+                    for (unsigned i = 0; i < a->get_num_args(); ++i)
+                        if (i != j)
+                            s -= to_value(value(a->get_arg(i)), 0, n - 1);
+                    s = mod(s, rational::power_of_two(n));
+                    ab.reset();
+                    ab.resize(w, l_undef);
+                    for (unsigned i = 0; i < n; ++i) {
+                        ab[i] = s.is_odd() ? l_true : l_false;
+                        s = div(s, rational(2));
+                    }
+                }
+                todo.push_back({ a->get_arg(j), ab });
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+
+    /**
+     * Exchange the known bits of the sides of equalities until a fixed-point
+     * or the bound on rounds is reached.
+     */
+    void known_bits::propagate() {
+        m_use_facts = true;
+        expr* x, * y;
+        for (unsigned round = 0; round < m_max_rounds && !m_conflict && !m_eqs.empty(); ++round) {
+            ++m_stats.m_num_rounds;
+            m_changed = false;
+            reset_values();
+            for (expr* f : m_eqs) {
+                VERIFY(m.is_eq(f, x, y));
+                eval(x);
+                eval(y);
+            }
+            for (unsigned i = 0; i < m_eqs.size() && !m_conflict; ++i) {
+                VERIFY(m.is_eq(m_eqs[i], x, y));
+                bits b(value(x));
+                bits const& c = value(y);
+                for (unsigned k = 0; k < b.size(); ++k) {
+                    if (b[k] == l_undef)
+                        b[k] = c[k];
+                    else if (c[k] != l_undef && c[k] != b[k])
+                        m_conflict = true;
+                }
+                add_fact(x, b);
+                add_fact(y, b);
+            }
+            if (!m_changed)
+                break;
+        }
+    }
+
+    expr_ref known_bits::mk_extract(unsigned hi, unsigned lo, expr* x) {
+        app_ref e(m_bv.mk_extract(hi, lo, x), m);
+        return m_rewriter.mk_app(e->get_decl(), 1, &x);
+    }
+
+    expr_ref known_bits::mk_leaf(expr* e, expr* r) {
+        bits b(value(e));
+        unsigned w = b.size();
+        expr_ref_vector xs(m);
+        for (unsigned lo = 0; lo < w; ) {
+            bool known = b[lo] != l_undef;
+            unsigned hi = lo;
+            while (hi + 1 < w && (b[hi + 1] != l_undef) == known)
+                ++hi;
+            if (known)
+                xs.push_back(m_bv.mk_numeral(to_value(b, lo, hi), hi - lo + 1));
+            else
+                xs.push_back(mk_extract(hi, lo, r));
+            lo = hi + 1;
+        }
+        xs.reverse();
+        return expr_ref(m_bv.mk_concat(xs), m);
+    }
+
+    /**
+     * A sum of n arguments with at most k significant bits has at most
+     * k + log2(n) significant bits, and a product has at most as many
+     * significant bits as its arguments together.
+     */
+    expr_ref known_bits::mk_shortened(app* e, expr* r, ptr_vector<expr> const& args) {
+        if (!is_app_of(r, m_bv.get_fid(), e->get_decl_kind()))
+            return expr_ref(r, m);
+        unsigned w = m_bv.get_bv_size(e);
+        unsigned k = 0;
+        if (m_bv.is_bv_add(e)) {
+            for (expr* arg : *e)
+                k = std::max(k, num_significant(value(arg)));
+            unsigned n = e->get_num_args();
+            for (unsigned c = 1; c < n; c *= 2)
+                ++k;
+        }
+        else
+            for (expr* arg : *e)
+                k += num_significant(value(arg));
+        if (k == 0 || k >= w)
+            return expr_ref(r, m);
+        ++m_stats.m_num_shortened;
+        expr_ref_vector xs(m);
+        for (expr* arg : args)
+            xs.push_back(mk_extract(k - 1, 0, arg));
+        app_ref s(m.mk_app(m_bv.get_fid(), e->get_decl_kind(), xs.size(), xs.data()), m);
+        expr_ref t = m_rewriter.mk_app(s->get_decl(), xs.size(), xs.data());
+        return expr_ref(m_bv.mk_zero_extend(w - k, t), m);
+    }
+
+    expr_ref known_bits::mk_fact(expr* x, bits const& b, unsigned lo, unsigned hi) {
+        expr_ref e(x, m);
+        if (lo > 0 || hi + 1 < b.size())
+            e = m_bv.mk_extract(hi, lo, x);
+        return expr_ref(m.mk_eq(e, m_bv.mk_numeral(to_value(b, lo, hi), hi - lo + 1)), m);
+    }
+
+    void known_bits::rewrite() {
+        m_use_facts = false;
+        reset_values();
+        expr_ref_vector cache(m), pin(m);
+        ptr_vector<expr> todo, args;
+        expr* c, * x, * y;
+        expr_ref r(m);
+        bool change_any = false;
+        for (unsigned i = m_qhead; i < m_fmls.size(); ++i) {
+            auto const [f, d] = m_fmls[i]();
+            todo.push_back(f);
+            pin.push_back(f);
+            while (!todo.empty()) {
+                expr* e = todo.back();
+                c = cache.get(e->get_id(), nullptr);
+                if (c) {
+                    todo.pop_back();
+                    continue;
+                }
+                if (!is_app(e)) {
+                    cache.setx(e->get_id(), e);
+                    todo.pop_back();
+                    continue;
+                }
+                args.reset();
+                unsigned sz = todo.size();
+                bool change = false;
+                for (expr* arg : *to_app(e)) {
+                    c = cache.get(arg->get_id(), nullptr);
+                    if (c) {
+                        args.push_back(c);
+                        change |= c != arg;
+                    }
+                    else
+                        todo.push_back(arg);
+                }
+                if (sz != todo.size())
+                    continue;
+                todo.pop_back();
+                if (change)
+                    r = m_rewriter.mk_app(to_app(e)->get_decl(), args);
+                else
+                    r = e;
+                if (m_bv.is_bv(e) && !m_bv.is_numeral(e)) {
+                    eval(e);
+                    if (all_known(value(e))) {
+                        ++m_stats.m_num_folded;
+                        r = m_bv.mk_numeral(to_value(value(e), 0, m_bv.get_bv_size(e) - 1), m_bv.get_bv_size(e));
+                    }
+                    else if (is_leaf(e) && any_known(value(e))) {
+                        ++m_stats.m_num_leaves;
+                        r = mk_leaf(e, r);
+                    }
+                    else if (m_bv.is_bv_add(e) || m_bv.is_bv_mul(e))
+                        r = mk_shortened(to_app(e), r, args);
+                }
+                else if (m.is_eq(e, x, y) && m_bv.is_bv(x)) {
+                    eval(x);
+                    eval(y);
+                    bits const& bx = value(x), & by = value(y);
+                    for (unsigned k = 0; k < bx.size(); ++k)
+                        if (bx[k] != l_undef && by[k] != l_undef && bx[k] != by[k])
+                            r = m.mk_false();
+                }
+                pin.push_back(r);
+                cache.setx(e->get_id(), r);
+            }
+            c = cache.get(f->get_id());
+            if (c != f) {
+                change_any = true;
+                m_fmls.update(i, dependent_expr(m, c, m.mk_join(d, m_dep)));
+            }
+        }
+        if (!change_any)
+            return;
+        // record the bits of the leaves that justify the rewrites
+        for (expr* t : m_fact_terms) {
+            if (!is_leaf(t))
+                continue;
+            bits b(*fact(t));
+            for (unsigned lo = 0; lo < b.size(); ) {
+                unsigned hi = lo;
+                while (hi + 1 < b.size() && (b[hi + 1] != l_undef) == (b[lo] != l_undef))
+                    ++hi;
+                if (b[lo] != l_undef)
+                    m_fmls.add(dependent_expr(m, mk_fact(t, b, lo, hi), m_dep));
+                lo = hi + 1;
+            }
+        }
+    }
+
+    void known_bits::collect_statistics(statistics& st) const {
+        st.update("bv-known-bits-rounds", m_stats.m_num_rounds);
+        st.update("bv-known-bits-folded", m_stats.m_num_folded);
+        st.update("bv-known-bits-leaves", m_stats.m_num_leaves);
+        st.update("bv-known-bits-shortened", m_stats.m_num_shortened);
+    }
+}
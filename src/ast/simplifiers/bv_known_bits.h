@@ -0,0 +1,106 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bv_known_bits.h
+
+Abstract:
+
+    simplifier that propagates known bits of bit-vector terms.
+
+    Every bit-vector term is abstracted by a vector of tri-state bits.
+    The bits of a term are computed from the bits of its arguments with
+    transfer functions for the bit-wise operations, concatenation,
+    extraction, extensions, shifts, addition and multiplication.
+
+    Bit-vector equalities of the formulas are facts: the bits known for
+    one side are known for the other side, and they are pushed down
+    through concatenation, extraction, negation and the bit-wise
+    operations until they reach the leaves, that is, the terms that are
+    not bit-vector operations. This is iterated until no new bit becomes
+    known.
+
+    The formulas are then rewritten using only the bits known for the
+    leaves: terms with all bits known become numerals, leaves with some
+    bits known become concatenations of numerals and extracts, and
+    additions and multiplications whose arguments have known leading
+    zeros are computed on fewer bits and zero extended. The known bits
+    of the leaves are added as new formulas.
+
+--*/
+
+
+#pragma once
+
+#include "ast/bv_decl_plugin.h"
+#include "ast/simplifiers/dependent_expr_state.h"
+#include "ast/rewriter/th_rewriter.h"
+
+
+namespace bv {
+
+    class known_bits : public dependent_expr_simplifier {
+        typedef svector<lbool> bits;
+
+        struct stats {
+            unsigned m_num_rounds = 0;
+            unsigned m_num_folded = 0;
+            unsigned m_num_leaves = 0;
+            unsigned m_num_shortened = 0;
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
+        bv_util                 m_bv;
+        th_rewriter             m_rewriter;
+        obj_map<expr, unsigned> m_fact2idx;          // term -> index into m_facts
+        vector<bits>            m_facts;
+        ptr_vector<expr>        m_fact_terms;
+        unsigned_vector         m_val2idx;           // expr id -> 1 + index into m_vals, 0 if not evaluated
+        vector<bits>            m_vals;
+        ptr_vector<expr>        m_eqs;
+        ptr_vector<expr>        m_todo;
+        bits                    m_tmp;
+        expr_dependency_ref     m_dep;
+        bool                    m_use_facts = true;  // the bits of non-leaves are restricted by their facts
+        bool                    m_changed = false;
+        bool                    m_conflict = false;
+        unsigned                m_max_rounds = 8;
+        stats                   m_stats;
+
+        bool is_bv_op(expr* e) const;
+        bool is_leaf(expr* e) const { return !is_bv_op(e); }
+        bool has_value(expr* e) const { return e->get_id() < m_val2idx.size() && m_val2idx[e->get_id()] != 0; }
+        bits const& value(expr* e) const { return m_vals[m_val2idx[e->get_id()] - 1]; }
+        bits const* fact(expr* e) const;
+        static unsigned num_significant(bits const& b);
+        static bool all_known(bits const& b);
+        static bool any_known(bits const& b);
+
+        void reset_values();
+        void eval(expr* e);
+        void compute(app* e, bits& r);
+        void add(bits const& a, bits const& b, lbool carry, bits& r);
+        void mul(bits const& a, bits const& b, bits& r);
+        void add_fact(expr* e, bits const& b);
+        bool add_fact_core(expr* e, bits const& b);
+        void propagate();
+
+        rational to_value(bits const& b, unsigned lo, unsigned hi) const;
+        expr_ref mk_extract(unsigned hi, unsigned lo, expr* x);
+        expr_ref mk_leaf(expr* e, expr* r);
+        expr_ref mk_shortened(app* e, expr* r, ptr_vector<expr> const& args);
+        expr_ref mk_fact(expr* x, bits const& b, unsigned lo, unsigned hi);
+        void rewrite();
+
+    public:
+
+        known_bits(ast_manager& m, dependent_expr_state& fmls) : dependent_expr_simplifier(m, fmls), m_bv(m), m_rewriter(m), m_dep(m) {}
+
+        void push() override { dependent_expr_simplifier::push(); }
+        void pop(unsigned n) override { dependent_expr_simplifier::pop(n); }
+        void reduce() override;
+        void collect_statistics(statistics& st) const override;
+        void reset_statistics() override { m_stats.reset(); }
+    };
+}
@@ -0,0 +1,157 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    component_simplifier.cpp
+
+Abstract:
+
+    Run a pipeline of simplifiers on the independent components of a
+    dependent_expr_state.
+
+--*/
+
+#include "util/union_find.h"
+#include "ast/for_each_expr.h"
+#include "ast/simplifiers/component_simplifier.h"
+
+
+void component_simplifier::component_state::update(unsigned i, dependent_expr const& j) {
+    unsigned idx = m_indices[i];
+    dependent_expr d(j);
+    dependent_expr const& old = m_fmls[idx];
+    if (old.fml() != d.fml() || old.dep() != d.dep())
+        ++m_num_updates;
+    m_fmls.update(idx, d);
+}
+
+void component_simplifier::component_state::add(dependent_expr const& j) {
+    unsigned sz = m_fmls.size();
+    m_fmls.add(j);
+    // the state may drop trivial formulas, only track what was added
+    for (unsigned i = sz; i < m_fmls.size(); ++i)
+        m_indices.push_back(i);
+    ++m_num_updates;
+}
+
+component_simplifier::component_simplifier(ast_manager& m, params_ref const& p, dependent_expr_state& fmls,
+                                           unsigned num_factories, dependent_expr_simplifier_factory* const* factories):
+    dependent_expr_simplifier(m, fmls),
+    m_params(p) {
+    m_factories.append(num_factories, factories);
+    updt_params(p);
+}
+
+namespace {
+    struct collect_uninterp_proc {
+        ptr_vector<func_decl>& m_decls;
+        collect_uninterp_proc(ptr_vector<func_decl>& decls) : m_decls(decls) {}
+        void operator()(var* v) {}
+        void operator()(quantifier* q) {}
+        void operator()(app* a) {
+            if (is_uninterp(a))
+                m_decls.push_back(a->get_decl());
+        }
+    };
+}
+
+/**
+   \brief partition the formulas from m_qhead by the uninterpreted symbols they share.
+   Formulas without uninterpreted symbols are grouped in a single component.
+*/
+void component_simplifier::partition(vector<unsigned_vector>& components) {
+    basic_union_find uf;
+    obj_map<func_decl, unsigned> decl2fml;
+    ptr_vector<func_decl> decls;
+    collect_uninterp_proc proc(decls);
+    unsigned ground = UINT_MAX;
+    unsigned n = m_fmls.size() - m_qhead;
+    for (unsigned k = 0; k < n; ++k)
+        uf.mk_var();
+    for (unsigned k = 0; k < n; ++k) {
+        decls.reset();
+        for_each_expr(proc, m_fmls[m_qhead + k].fml());
+        if (decls.empty()) {
+            if (ground == UINT_MAX)
+                ground = k;
+            uf.merge(k, ground);
+        }
+        for (func_decl* f : decls) {
+            unsigned j;
+            if (decl2fml.find(f, j))
+                uf.merge(k, j);
+            else
+                decl2fml.insert(f, k);
+        }
+    }
+    unsigned_vector root2component(n, UINT_MAX);
+    for (unsigned k = 0; k < n; ++k) {
+        unsigned r = uf.find(k);
+        if (root2component[r] == UINT_MAX) {
+            root2component[r] = components.size();
+            components.push_back(unsigned_vector());
+        }
+        components[root2component[r]].push_back(m_qhead + k);
+    }
+}
+
+/**
+   \brief run the simplifiers on s until a round leaves it unchanged.
+   The simplifiers only process the formulas after their queue head,
+   so every round uses fresh instances.
+*/
+void component_simplifier::reduce(component_state& s) {
+    for (unsigned r = 0; r < m_max_rounds && !m_fmls.inconsistent(); ++r) {
+        ++m_stats.m_num_rounds;
+        unsigned num_updates = s.num_updates();
+        for (auto* f : m_factories) {
+            if (m_fmls.inconsistent())
+                break;
+            scoped_ptr<dependent_expr_simplifier> simp = f->mk(m, m_params, s);
+            simp->updt_params(m_params);
+            simp->reduce();
+            simp->collect_statistics(m_st);
+        }
+        if (num_updates == s.num_updates())
+            break;
+    }
+}
+
+void component_simplifier::reduce() {
+    if (m_qhead == m_fmls.size())
+        return;
+    vector<unsigned_vector> components;
+    partition(components);
+    TRACE("simplifier", tout << "components " << components.size() << "\n";);
+    m_stats.m_num_components += components.size();
+    for (auto const& c : components) {
+        if (m_fmls.inconsistent())
+            break;
+        component_state s(m_fmls);
+        for (unsigned i : c)
+            s.add_index(i);
+        reduce(s);
+    }
+    advance_qhead(m_fmls.size());
+}
+
+void component_simplifier::collect_statistics(statistics& st) const {
+    st.copy(m_st);
+    st.update("components", m_stats.m_num_components);
+    st.update("component-rounds", m_stats.m_num_rounds);
+}
+
+void component_simplifier::updt_params(params_ref const& p) {
+    m_params.append(p);
+    m_max_rounds = m_params.get_uint("max_component_rounds", 4);
+}
+
+void component_simplifier::collect_param_descrs(param_descrs& r) {
+    component_state s(m_fmls);
+    for (auto* f : m_factories) {
+        scoped_ptr<dependent_expr_simplifier> simp = f->mk(m, m_params, s);
+        simp->collect_param_descrs(r);
+    }
+    r.insert("max_component_rounds", CPK_UINT, "(default: 4) maximal number of rounds of the simplifiers on a component.");
+}
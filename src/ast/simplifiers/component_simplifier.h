@@ -0,0 +1,84 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    component_simplifier.h
+
+Abstract:
+
+    Run a pipeline of simplifiers on the independent components of a
+    dependent_expr_state.
+
+    Formulas are partitioned by the uninterpreted symbols they share.
+    Every component is exposed to the simplifiers as a dependent_expr_state
+    of its own, so the occurrence counts, shared sub-terms and substitutions
+    they compute only range over the formulas that can interact. The
+    pipeline is repeated on a component until a round leaves it unchanged,
+    which lets small, settled components drop out early while the others
+    continue.
+
+    The components do not share symbols, but they share the ast_manager,
+    which is not thread safe. They are therefore processed one after another.
+
+--*/
+
+#pragma once
+
+#include "util/ref_vector.h"
+#include "ast/simplifiers/dependent_expr_state.h"
+
+
+class component_simplifier : public dependent_expr_simplifier {
+
+    /**
+       \brief view of the formulas of one component.
+     */
+    class component_state : public dependent_expr_state {
+        dependent_expr_state& m_fmls;
+        unsigned_vector       m_indices;
+        unsigned              m_num_updates = 0;
+    public:
+        component_state(dependent_expr_state& fmls) : m_fmls(fmls) {}
+        void add_index(unsigned i) { m_indices.push_back(i); }
+        unsigned num_updates() const { return m_num_updates; }
+        unsigned size() const override { return m_indices.size(); }
+        dependent_expr const& operator[](unsigned i) override { return m_fmls[m_indices[i]]; }
+        void update(unsigned i, dependent_expr const& j) override;
+        void add(dependent_expr const& j) override;
+        bool inconsistent() override { return m_fmls.inconsistent(); }
+        model_reconstruction_trail& model_trail() override { return m_fmls.model_trail(); }
+        using dependent_expr_state::frozen;
+        bool frozen(func_decl* f) const override { return m_fmls.frozen(f); }
+    };
+
+    struct stats {
+        unsigned m_num_components = 0;
+        unsigned m_num_rounds = 0;
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+
+    sref_vector<dependent_expr_simplifier_factory> m_factories;
+    params_ref                                     m_params;
+    unsigned                                       m_max_rounds = 4;
+    stats                                          m_stats;
+    statistics                                     m_st;    // statistics of the simplifiers of processed components
+
+    void partition(vector<unsigned_vector>& components);
+    void reduce(component_state& s);
+
+public:
+
+    /**
+       \brief the simplifiers are created by the factories, in order, for
+       every component.
+     */
+    component_simplifier(ast_manager& m, params_ref const& p, dependent_expr_state& fmls,
+                         unsigned num_factories, dependent_expr_simplifier_factory* const* factories);
+
+    void reduce() override;
+    void collect_statistics(statistics& st) const override;
+    void reset_statistics() override { m_stats.reset(); m_st.reset(); }
+    void updt_params(params_ref const& p) override;
+    void collect_param_descrs(param_descrs& r) override;
+};
@@ -0,0 +1,40 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    dependent_expr_state.cpp
+
+Abstract:
+
+    Freezing symbols of a dependent_expr_state.
+
+--*/
+
+#include "ast/for_each_expr.h"
+#include "ast/simplifiers/dependent_expr_state.h"
+
+void dependent_expr_state::freeze(func_decl* f) {
+    if (m_frozen.contains(f))
+        return;
+    m_frozen.insert(f);
+    m_trail.push(insert_obj_trail(m_frozen, f));
+}
+
+namespace {
+    struct freeze_proc {
+        dependent_expr_state& s;
+        freeze_proc(dependent_expr_state& s) : s(s) {}
+        void operator()(var* v) {}
+        void operator()(quantifier* q) {}
+        void operator()(app* a) {
+            if (is_uninterp(a))
+                s.freeze(a->get_decl());
+        }
+    };
+}
+
+void dependent_expr_state::freeze(expr* term) {
+    freeze_proc proc(*this);
+    for_each_expr(proc, term);
+}
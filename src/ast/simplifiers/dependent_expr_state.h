@@ -32,6 +32,7 @@ Author:
 #include "util/trail.h"
 #include "util/statistics.h"
 #include "util/params.h"
+#include "util/obj_hashtable.h"
 #include "ast/converters/model_converter.h"
 #include "ast/simplifiers/dependent_expr.h"
 #include "ast/simplifiers/model_reconstruction_trail.h"
@@ -54,7 +55,16 @@ public:
     void push() { m_trail.push_scope(); }
     void pop(unsigned n) { m_trail.pop_scope(n); }
 
-
+    /**
+       Frozen symbols must not be eliminated by simplifiers. Incremental
+       clients freeze the symbols of formulas they have already passed on
+       and of assumptions. Freezing is undone on pop.
+     */
+    obj_hashtable<func_decl> m_frozen;
+    void freeze(func_decl* f);
+    void freeze(expr* term);
+    virtual bool frozen(func_decl* f) const { return m_frozen.contains(f); }
+    bool frozen(expr* e) const { return is_app(e) && frozen(to_app(e)->get_decl()); }
 };
 
 /**
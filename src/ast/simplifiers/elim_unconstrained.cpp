@@ -27,9 +27,11 @@ Abstract:
    - orig - original term, the orig->get_id() is the index to the node
    - term - current term representing the node after rewriting
    - parents - list of parents where orig occurs.
+     The parents of all nodes are stored contiguously, ordered by node.
 
   Subterms have reference counts
-  Elegible variables are inserted into a heap ordered by reference counts.
+  Variables are queued when their reference count drops to 1 or less,
+  decrements of reference counts only append to the queue.
   Variables that have reference count 1 are examined for invertibility.
 
 Author:
@@ -46,37 +48,29 @@ Author:
 #include "ast/simplifiers/elim_unconstrained.h"
 
 elim_unconstrained::elim_unconstrained(ast_manager& m, dependent_expr_state& fmls) :
-    dependent_expr_simplifier(m, fmls), m_inverter(m), m_lt(*this), m_heap(1024, m_lt), m_trail(m) {
+    dependent_expr_simplifier(m, fmls), m_inverter(m), m_trail(m) {
     std::function<bool(expr*)> is_var = [&](expr* e) {
-        return is_uninterp_const(e) && !m_frozen.is_marked(e) && get_node(e).m_refcount <= 1;
+        return is_uninterp_const(e) && !m_frozen.is_marked(e) && !m_fmls.frozen(e) && get_node(e).m_refcount <= 1;
     };
     m_inverter.set_is_var(is_var);
 }
 
-bool elim_unconstrained::is_var_lt(int v1, int v2) const {
-    node const& n1 = get_node(v1);
-    node const& n2 = get_node(v2);
-    return n1.m_refcount < n2.m_refcount;
-}
-
 void elim_unconstrained::eliminate() {
 
-    while (!m_heap.empty()) {
-        expr_ref r(m), side_cond(m);
-        int v = m_heap.erase_min();
+    expr_ref r(m), side_cond(m);
+    for (unsigned i = 0; i < m_vars.size(); ++i) {
+        unsigned v = m_vars[i];
         node& n = get_node(v);
         IF_VERBOSE(11, verbose_stream() << mk_bounded_pp(n.m_orig, m) << " @ " << n.m_refcount << "\n");
-        if (n.m_refcount == 0)
+        if (n.m_refcount != 1)
             continue;
-        if (n.m_refcount > 1)
-            return;
 
-        if (n.m_parents.empty()) {
+        if (num_parents(v) == 0) {
             n.m_refcount = 0;
             continue;
         }
         expr* e = get_parent(v);
-        IF_VERBOSE(11, for (expr* p : n.m_parents) verbose_stream() << "parent " << mk_bounded_pp(p, m) << " @ " << get_node(p).m_refcount << "\n";);
+        IF_VERBOSE(11, for (unsigned j = 0; j < num_parents(v); ++j) verbose_stream() << "parent " << mk_bounded_pp(parents(v)[j], m) << " @ " << get_node(parents(v)[j]).m_refcount << "\n";);
         if (!e || !is_app(e) || !is_ground(e)) {
             n.m_refcount = 0;
             continue;
@@ -101,20 +95,22 @@ void elim_unconstrained::eliminate() {
         get_node(e).m_term = r;
         get_node(e).m_refcount++;
         IF_VERBOSE(11, verbose_stream() << mk_bounded_pp(e, m) << "\n");
-        SASSERT(!m_heap.contains(root(e)));
         if (is_uninterp_const(r)) 
-            m_heap.insert(root(e));                    
+            m_vars.push_back(root(e));
 
         IF_VERBOSE(11, verbose_stream() << mk_bounded_pp(n.m_orig, m) << " " << mk_bounded_pp(t, m) << " -> " << r << " " << get_node(e).m_refcount << "\n";);
 
         SASSERT(!side_cond && "not implemented to add side conditions\n");
     }
+    m_vars.reset();
 }
 
 expr* elim_unconstrained::get_parent(unsigned n) const {
-    for (expr* p : get_node(n).m_parents)
+    for (unsigned i = 0; i < num_parents(n); ++i) {
+        expr* p = parents(n)[i];
         if (get_node(p).m_refcount > 0 && get_node(p).m_term == get_node(p).m_orig)
             return p;
+    }
     return nullptr;
 }
 /**
@@ -125,7 +121,7 @@ void elim_unconstrained::init_nodes() {
     for (unsigned i = 0; i < m_fmls.size(); ++i)
         terms.push_back(m_fmls[i].fml());
     m_trail.append(terms);
-    m_heap.reset();
+    m_vars.reset();
     m_frozen.reset();
     m_root.reset();
 
@@ -159,39 +155,53 @@ void elim_unconstrained::init_nodes() {
 */
 void elim_unconstrained::init_terms(expr_ref_vector const& terms) {
     unsigned max_id = 0;
-    for (expr* e : subterms::all(terms))
+    m_todo.reset();
+    for (expr* e : subterms_postorder::all(terms)) {
         max_id = std::max(max_id, e->get_id());
+        m_todo.push_back(e);
+    }
 
-    m_nodes.reserve(max_id + 1);
-    m_heap.reserve(max_id + 1);
+    m_nodes.reset();
+    m_nodes.resize(max_id + 1);
     m_root.reserve(max_id + 1, UINT_MAX);
 
-    for (expr* e : subterms_postorder::all(terms)) {
+    // the reference count of a node is initially its number of parents
+    for (expr* e : m_todo) {
         m_root.setx(e->get_id(), e->get_id(), UINT_MAX);
         node& n = get_node(e);
-        if (n.m_term)
-            continue;        
         n.m_orig = e;
         n.m_term = e;
-        n.m_refcount = 0;
         if (is_uninterp_const(e))
-            m_heap.insert(root(e));
-        if (is_quantifier(e)) {
-            expr* body = to_quantifier(e)->get_expr();
-            get_node(body).m_parents.push_back(e);
-            inc_ref(body);
-        }
-        else if (is_app(e)) {
-            for (expr* arg : *to_app(e)) {
-                get_node(arg).m_parents.push_back(e);
+            m_vars.push_back(root(e));
+        if (is_quantifier(e))
+            inc_ref(to_quantifier(e)->get_expr());
+        else if (is_app(e))
+            for (expr* arg : *to_app(e))
                 inc_ref(arg);
-            }
-        }
     }
+
+    m_parent_begin.reset();
+    m_parent_begin.resize(max_id + 2, 0);
+    for (unsigned i = 0; i <= max_id; ++i)
+        m_parent_begin[i + 1] = m_parent_begin[i] + m_nodes[i].m_refcount;
+    m_parents.reset();
+    m_parents.resize(m_parent_begin[max_id + 1], nullptr);
+    unsigned_vector next(m_parent_begin);
+    auto add_parent = [&](expr* arg, expr* p) {
+        m_parents[next[arg->get_id()]++] = p;
+    };
+    for (expr* e : m_todo) {
+        if (is_quantifier(e))
+            add_parent(to_quantifier(e)->get_expr(), e);
+        else if (is_app(e))
+            for (expr* arg : *to_app(e))
+                add_parent(arg, e);
+    }
+    m_todo.reset();
 }
 
 void elim_unconstrained::gc(expr* t) {
-    ptr_vector<expr> todo;
+    ptr_vector<expr>& todo = m_todo;
     todo.push_back(t);
     while (!todo.empty()) {
         t = todo.back();
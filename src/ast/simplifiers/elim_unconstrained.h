@@ -14,7 +14,6 @@ Author:
 
 #pragma once
 
-#include "util/heap.h"
 #include "ast/simplifiers/dependent_expr_state.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/converters/expr_inverter.h"
@@ -26,14 +25,6 @@ class elim_unconstrained : public dependent_expr_simplifier {
         unsigned         m_refcount = 0;
         expr*            m_term = nullptr;
         expr*            m_orig = nullptr;
-        ptr_vector<expr> m_parents;
-    };
-    struct var_lt {
-        elim_unconstrained& s;
-        var_lt(elim_unconstrained& s) : s(s) {}
-        bool operator()(int v1, int v2) const {
-            return s.is_var_lt(v1, v2);
-        }
     };
     struct stats {
         unsigned m_num_eliminated = 0;
@@ -41,23 +32,26 @@ class elim_unconstrained : public dependent_expr_simplifier {
     };
     expr_inverter            m_inverter;
     vector<node>             m_nodes;
-    var_lt                   m_lt;
-    heap<var_lt>             m_heap;
+    unsigned_vector          m_parent_begin;      // node |-> start of its parents in m_parents
+    ptr_vector<expr>         m_parents;           // parents of the nodes, contiguous per node
+    unsigned_vector          m_vars;              // variables whose reference count dropped to at most 1
     expr_ref_vector          m_trail;
     ptr_vector<expr>         m_args;
+    ptr_vector<expr>         m_todo;
     expr_mark                m_frozen;
     stats                    m_stats;
     unsigned_vector          m_root;
 
-    bool is_var_lt(int v1, int v2) const;
     node& get_node(unsigned n) { return m_nodes[n]; }
     node const& get_node(unsigned n) const { return m_nodes[n]; }
     node& get_node(expr* t) { return m_nodes[root(t)]; }
     unsigned root(expr* t) const { return m_root[t->get_id()]; }
     node const& get_node(expr* t) const { return m_nodes[root(t)]; }
     unsigned get_refcount(expr* t) const { return get_node(t).m_refcount; }
-    void inc_ref(expr* t) { ++get_node(t).m_refcount; if (is_uninterp_const(t)) m_heap.increased(root(t)); }
-    void dec_ref(expr* t) { --get_node(t).m_refcount; if (is_uninterp_const(t)) m_heap.decreased(root(t)); }
+    void inc_ref(expr* t) { ++get_node(t).m_refcount; }
+    void dec_ref(expr* t) { if (--get_node(t).m_refcount <= 1 && is_uninterp_const(t)) m_vars.push_back(root(t)); }
+    unsigned num_parents(unsigned n) const { return m_parent_begin[n + 1] - m_parent_begin[n]; }
+    expr* const* parents(unsigned n) const { return m_parents.data() + m_parent_begin[n]; }
     void gc(expr* t);
     expr* get_parent(unsigned n) const;
     void init_terms(expr_ref_vector const& terms);
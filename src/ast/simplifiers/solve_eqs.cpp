@@ -38,11 +38,81 @@ namespace euf {
                 ex->get_eqs(m_fmls[i], eqs);
     }
 
+    /**
+    * Merge variables that are equal to other variables into classes.
+    * root maps the id of a variable to the id of the representative of its class,
+    * root_dep to the dependencies of a path of equations from the variable to the
+    * representative.
+    */
+    void solve_eqs::merge_var_eqs(dep_eq_vector const& eqs, unsigned_vector& root, vector<expr_dependency*>& root_dep) {
+        unsigned n = m_id2var.size();
+        root.reset();
+        for (unsigned i = 0; i < n; ++i)
+            root.push_back(i);
+        root_dep.reset();
+        root_dep.resize(n, nullptr);
+
+        auto find = [&](unsigned i) {
+            while (root[i] != i) {
+                root[i] = root[root[i]];
+                i = root[i];
+            }
+            return i;
+        };
+
+        vector<unsigned_vector> edges(n); // id |-> equations to other variables
+        bool merged = false;
+        for (unsigned i = 0; i < eqs.size(); ++i) {
+            auto const& [orig, v, t, d] = eqs[i];
+            if (!is_var(v) || !is_var(t))
+                continue;
+            unsigned a = var2id(v), b = var2id(t);
+            edges[a].push_back(i);
+            edges[b].push_back(i);
+            a = find(a);
+            b = find(b);
+            if (a != b) {
+                root[a] = b;
+                merged = true;
+            }
+        }
+        for (unsigned i = 0; i < n; ++i)
+            root[i] = find(i);
+        if (!merged)
+            return;
+
+        // dependencies along a spanning tree of each class rooted at its representative
+        bool_vector visited(n, false);
+        unsigned_vector todo;
+        for (unsigned r = 0; r < n; ++r) {
+            if (root[r] != r || edges[r].empty())
+                continue;
+            visited[r] = true;
+            todo.push_back(r);
+            for (unsigned k = 0; k < todo.size(); ++k) {
+                unsigned i = todo[k];
+                for (unsigned e : edges[i]) {
+                    auto const& [orig, v, t, d] = eqs[e];
+                    unsigned j = var2id(v) == i ? var2id(t) : var2id(v);
+                    if (visited[j])
+                        continue;
+                    visited[j] = true;
+                    root_dep[j] = m.mk_join(root_dep[i], d);
+                    m_member_deps.push_back(root_dep[j]);
+                    todo.push_back(j);
+                }
+            }
+            todo.reset();
+        }
+    }
+
     // initialize graph that maps variable ids to next ids
     void solve_eqs::extract_dep_graph(dep_eq_vector& eqs) {
         m_var2id.reset();
         m_id2var.reset();
         m_next.reset();
+        m_members.reset();
+        m_member_deps.reset();
         unsigned sz = 0;
         for (auto const& [orig, v, t, d] : eqs)
             sz = std::max(sz, v->get_id());
@@ -53,11 +123,43 @@ namespace euf {
             m_var2id[v->get_id()] = m_id2var.size();
             m_id2var.push_back(v);
         }
-        m_next.resize(m_id2var.size());
 
-        for (auto const& eq : eqs)
-            if (can_be_var(eq.var))
-                m_next[var2id(eq.var)].push_back(eq);
+        // Equalities between variables are solved by union-find: only representatives
+        // are solved for, and the other members of a class are replaced in one step by
+        // the solution of the representative, instead of through a chain of substitutions.
+        unsigned_vector root;
+        vector<expr_dependency*> root_dep;
+        merge_var_eqs(eqs, root, root_dep);
+        ptr_vector<app> vars;
+        vars.swap(m_id2var);
+        unsigned_vector new_id(vars.size(), UINT_MAX);
+        for (unsigned i = 0; i < vars.size(); ++i) {
+            if (root[i] == i) {
+                new_id[i] = m_id2var.size();
+                m_id2var.push_back(vars[i]);
+            }
+        }
+        m_next.resize(m_id2var.size());
+        m_members.resize(m_id2var.size());
+        for (auto const& eq : eqs) {
+            if (!can_be_var(eq.var) || is_var(eq.term))
+                continue;
+            unsigned i = var2id(eq.var);
+            unsigned r = new_id[root[i]];
+            if (root[i] == i)
+                m_next[r].push_back(eq);
+            else {
+                expr_dependency* d = m.mk_join(eq.dep, root_dep[i]);
+                m_member_deps.push_back(d);
+                m_next[r].push_back(dependent_eq(eq.orig, m_id2var[r], eq.term, d));
+            }
+        }
+        for (unsigned i = 0; i < vars.size(); ++i) {
+            unsigned r = new_id[root[i]];
+            m_var2id[vars[i]->get_id()] = r;
+            if (root[i] != i)
+                m_members[r].push_back(dependent_eq(nullptr, vars[i], expr_ref(m_id2var[r], m), root_dep[i]));
+        }
     }
 
     /**
@@ -68,6 +170,8 @@ namespace euf {
     void solve_eqs::extract_subst() {
         m_id2level.reset();
         m_id2level.resize(m_id2var.size(), UINT_MAX);
+        m_solved.reset();
+        m_solved.resize(m_id2var.size(), false);
         m_subst_ids.reset();
         m_subst = alloc(expr_substitution, m, true, false);        
 
@@ -137,6 +241,7 @@ namespace euf {
                     }
                     SASSERT(!occurs(v, t));
                     m_next[j][0] = eq;
+                    m_solved[j] = true;
                     m_subst_ids.push_back(j);                   
                     break;
                 }
@@ -145,6 +250,10 @@ namespace euf {
     }
 
     void solve_eqs::normalize() {
+        // representatives that are not solved still replace the other members of their class
+        for (unsigned id = 0; id < m_id2var.size(); ++id)
+            if (!m_solved[id] && !m_members[id].empty() && m_id2level[id] != UINT_MAX)
+                m_subst_ids.push_back(id);
         if (m_subst_ids.empty())
             return;
         scoped_ptr<expr_replacer> rp = mk_default_expr_replacer(m, false);
@@ -155,14 +264,25 @@ namespace euf {
         for (unsigned id : m_subst_ids) {
             if (!m.inc())
                 return;
-            auto const& [orig, v, def, dep] = m_next[id][0];
-            auto [new_def, new_dep] = rp->replace_with_dep(def);
-            m_stats.m_num_steps += rp->get_num_steps() + 1;
-            ++m_stats.m_num_elim_vars;
-            new_dep = m.mk_join(dep, new_dep);
-            IF_VERBOSE(11, verbose_stream() << mk_bounded_pp(v, m) << " -> " << mk_bounded_pp(new_def, m) << "\n");
-            m_subst->insert(v, new_def, new_dep);
-            SASSERT(can_be_var(v));
+            expr* root_def = m_id2var[id];
+            expr_dependency* root_dep = nullptr;
+            if (m_solved[id]) {
+                auto const& [orig, v, def, dep] = m_next[id][0];
+                auto [new_def, new_dep] = rp->replace_with_dep(def);
+                m_stats.m_num_steps += rp->get_num_steps() + 1;
+                ++m_stats.m_num_elim_vars;
+                new_dep = m.mk_join(dep, new_dep);
+                IF_VERBOSE(11, verbose_stream() << mk_bounded_pp(v, m) << " -> " << mk_bounded_pp(new_def, m) << "\n");
+                m_subst->insert(v, new_def, new_dep);
+                SASSERT(can_be_var(v));
+                root_def = new_def;
+                root_dep = new_dep;
+            }
+            for (auto const& [orig, v, r, dep] : m_members[id]) {
+                ++m_stats.m_num_steps;
+                ++m_stats.m_num_elim_vars;
+                m_subst->insert(v, root_def, m.mk_join(dep, root_dep));
+            }
             // we updated the substitution, but we don't need to reset rp
             // because all cached values there do not depend on v.
         }
@@ -170,6 +290,8 @@ namespace euf {
         TRACE("solve_eqs",
             tout << "after normalizing variables\n";
         for (unsigned id : m_subst_ids) {
+            if (!m_solved[id])
+                continue;
             auto const& eq = m_next[id][0];
             expr* def = m_subst->find(eq.var);
             tout << mk_pp(eq.var, m) << "\n----->\n" << mk_pp(def, m) << "\n\n";
@@ -254,7 +376,7 @@ namespace euf {
     }
 
     solve_eqs::solve_eqs(ast_manager& m, dependent_expr_state& fmls) : 
-        dependent_expr_simplifier(m, fmls), m_rewriter(m) {
+        dependent_expr_simplifier(m, fmls), m_rewriter(m), m_member_deps(m) {
         register_extract_eqs(m, m_extract_plugins);
         m_rewriter.set_flat_and_or(false);
     }
@@ -48,6 +48,9 @@ namespace euf {
         unsigned_vector               m_id2level;      // small numeral |-> level in substitution ordering
         unsigned_vector               m_subst_ids;     // sorted list of small numeral by level
         vector<dep_eq_vector>         m_next;          // adjacency list for solved equations
+        vector<dep_eq_vector>         m_members;       // small numeral |-> equations of the other variables of its class to it
+        expr_dependency_ref_vector    m_member_deps;   // dependencies of the equations to representatives
+        bool_vector                   m_solved;        // small numeral |-> m_next[id][0] is its solution
         scoped_ptr<expr_substitution> m_subst;         // current substitution
         expr_mark                     m_unsafe_vars;   // expressions that cannot be replaced
         ptr_vector<expr>              m_todo;
@@ -55,11 +58,12 @@ namespace euf {
 
         bool is_var(expr* e) const { return e->get_id() < m_var2id.size() && m_var2id[e->get_id()] != UINT_MAX; }
         unsigned var2id(expr* v) const { return m_var2id[v->get_id()]; }
-        bool can_be_var(expr* e) const { return is_uninterp_const(e) && !m_unsafe_vars.is_marked(e); }
+        bool can_be_var(expr* e) const { return is_uninterp_const(e) && !m_unsafe_vars.is_marked(e) && !m_fmls.frozen(e); }
         void get_eqs(dep_eq_vector& eqs);
         void filter_unsafe_vars();        
         void extract_subst();
         void extract_dep_graph(dep_eq_vector& eqs);
+        void merge_var_eqs(dep_eq_vector const& eqs, unsigned_vector& root, vector<expr_dependency*>& root_dep);
         void normalize();
         void apply_subst(vector<dependent_expr>& old_fmls);
         void save_subst(vector<dependent_expr> const& old_fmls);
@@ -657,6 +657,7 @@ class get_info_cmd : public cmd {
     symbol   m_status;
     symbol   m_reason_unknown;
     symbol   m_all_statistics;
+    symbol   m_quantifier_profile;
     symbol   m_assertion_stack_levels;
     symbol   m_rlimit;
 public:
@@ -669,6 +670,7 @@ public:
         m_status(":status"),
         m_reason_unknown(":reason-unknown"),
         m_all_statistics(":all-statistics"),
+        m_quantifier_profile(":quantifier-profile"),
         m_assertion_stack_levels(":assertion-stack-levels"),
         m_rlimit(":rlimit") {
     }
@@ -708,6 +710,9 @@ public:
         else if (opt == m_all_statistics) {
             ctx.display_statistics();
         }
+        else if (opt == m_quantifier_profile) {
+            ctx.display_quantifier_profile();
+        }
         else if (opt == m_assertion_stack_levels) {
             ctx.regular_stream() << "(:assertion-stack-levels " << ctx.num_scopes() << ")" << std::endl;
         }
@@ -2185,6 +2185,11 @@ void cmd_context::display_statistics(bool show_total_time, double total_time) {
     st.update("time", get_seconds());
     get_memory_statistics(st);
     get_rlimit_statistics(m().limit(), st);
+    collect_solver_statistics(st);
+    st.display_smt2(regular_stream());
+}
+
+void cmd_context::collect_solver_statistics(statistics & st) {
     if (m_check_sat_result) {
         m_check_sat_result->collect_statistics(st);
     }
@@ -2194,7 +2199,25 @@ void cmd_context::display_statistics(bool show_total_time, double total_time) {
     else if (m_opt) {
         m_opt->collect_statistics(st);
     }
-    st.display_smt2(regular_stream());
+}
+
+void cmd_context::display_quantifier_profile() {
+    statistics st, profile;
+    collect_solver_statistics(st);
+    char const * prefix = "qi-profile ";
+    size_t len = strlen(prefix);
+    for (unsigned i = 0; i < st.size(); ++i) {
+        char const * key = st.get_key(i);
+        if (strncmp(key, prefix, len) != 0)
+            continue;
+        if (st.is_uint(i))
+            profile.update(key + len, st.get_uint_value(i));
+        else
+            profile.update(key + len, st.get_double_value(i));
+    }
+    regular_stream() << "(:quantifier-profile ";
+    profile.display_smt2(regular_stream());
+    regular_stream() << ")" << std::endl;
 }
 
 
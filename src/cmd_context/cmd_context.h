@@ -203,7 +203,7 @@ public:
         cmd_context &   m_ctx;
     public:
         scoped_watch(cmd_context & ctx):m_ctx(ctx) { m_ctx.m_watch.reset(); m_ctx.m_watch.start(); }
-        ~scoped_watch() { m_ctx.m_watch.stop(); }
+        ~scoped_watch() { m_ctx.m_watch.stop(); m_ctx.m_commands_seconds += m_ctx.m_watch.get_seconds(); }
     };
 
     struct scoped_redirect {
@@ -294,6 +294,7 @@ protected:
     ref<opt_wrapper>             m_opt;
 
     stopwatch                    m_watch;
+    double                       m_commands_seconds = 0; // accumulated time of the timed commands
 
     class dt_eh : public new_datatype_eh {
         cmd_context &             m_owner;
@@ -494,6 +495,8 @@ public:
 
     void display_assertions();
     void display_statistics(bool show_total_time = false, double total_time = 0.0);
+    void collect_solver_statistics(statistics & st);
+    void display_quantifier_profile();
     void display_dimacs();
     void reset(bool finalize = false);
     void assert_expr(expr * t);
@@ -518,6 +521,8 @@ public:
     bool is_model_available(model_ref& md) const;
 
     double get_seconds() const { return m_watch.get_seconds(); }
+    // time spent in check-sat, apply, simplify, eval and query commands.
+    double get_commands_seconds() const { return m_commands_seconds; }
 
     ptr_vector<expr> const& assertions() const { return m_assertions; }
     ptr_vector<expr> const& assertion_names() const { return m_assertion_names; }
@@ -83,6 +83,7 @@ namespace dd {
     bdd_manager::BDD bdd_manager::apply(BDD arg1, BDD arg2, bdd_op op) {
         bool first = true;
         SASSERT(well_formed());
+        maybe_reorder();
         scoped_push _sp(*this);
         while (true) {
             try {
@@ -113,9 +114,11 @@ namespace dd {
             SASSERT(e2->m_result != null_bdd);
             push_entry(e1);
             e1 = nullptr;
+            ++m_stats.m_cache_hits;
             return true;            
         }
         else {
+            ++m_stats.m_cache_misses;
             e1->m_bdd1 = a;
             e1->m_bdd2 = b;
             e1->m_op = c;
@@ -263,7 +266,22 @@ namespace dd {
         m_cost_bdd = 0;
     }    
 
+    /**
+       \brief called before top-level operations, where only nodes with a
+       reference count are live.
+     */
+    void bdd_manager::maybe_reorder() {
+        if (m_op_cache.size() > m_max_cache_size)
+            flush_cache();
+        if (!m_auto_reorder || num_live_nodes() < m_reorder_threshold)
+            return;
+        try_reorder();
+        m_reorder_threshold = std::max(m_reorder_threshold, 2 * num_live_nodes());
+    }
+
     void bdd_manager::try_reorder() {
+        ++m_stats.m_num_reorders;
+        IF_VERBOSE(12, verbose_stream() << "(bdd :reorder " << num_live_nodes() << ")\n";);
         gc();        
         for (auto* e : m_op_cache) {
             m_alloc.deallocate(sizeof(*e), e);
@@ -546,6 +564,7 @@ namespace dd {
 
     bdd bdd_manager::mk_not(bdd b) {
         bool first = true;
+        maybe_reorder();
         scoped_push _sp(*this);
         while (true) {
             try {
@@ -581,6 +600,7 @@ namespace dd {
 
     bdd bdd_manager::mk_cofactor(bdd const& a, bdd const& b) {
 	bool first = true;
+        maybe_reorder();
         scoped_push _sp(*this);
         SASSERT(!b.is_const() && b.lo().is_const() && b.hi().is_const());
         while (true) {
@@ -632,6 +652,7 @@ namespace dd {
 
     bdd bdd_manager::mk_ite(bdd const& c, bdd const& t, bdd const& e) {         
         bool first = true;
+        maybe_reorder();
         scoped_push _sp(*this);
         while (true) {
             try {
@@ -702,6 +723,7 @@ namespace dd {
     }
 
     bdd_manager::BDD bdd_manager::mk_quant(unsigned n, unsigned const* vars, BDD b, bdd_op op) {
+        maybe_reorder();
         BDD result = b;
         // TODO: should this method catch mem_out like the other non-rec mk_ methods?
         for (unsigned i = 0; i < n; ++i) {
@@ -806,6 +828,8 @@ namespace dd {
     }
 
     void bdd_manager::gc() {
+        ++m_stats.m_num_gc;
+        m_stats.m_max_live_nodes = std::max(m_stats.m_max_live_nodes, num_live_nodes());
         m_free_nodes.reset();
         IF_VERBOSE(13, verbose_stream() << "(bdd :gc " << m_nodes.size() << ")\n";);
         bool_vector reachable(m_nodes.size(), false);
@@ -844,6 +868,25 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
+        flush_cache();
+
+        m_node_table.reset();
+        // re-populate node cache
+        for (unsigned i = m_nodes.size(); i-- > 2; ) {
+            if (reachable[i]) {
+                SASSERT(m_nodes[i].m_index == i);
+                m_node_table.insert(m_nodes[i]);
+            }
+        }
+        SASSERT(well_formed());
+    }
+
+    /**
+       \brief remove the completed entries of the operation cache.
+       Entries of operations that are still being computed are kept.
+     */
+    void bdd_manager::flush_cache() {
+        ++m_stats.m_num_cache_flushes;
         ptr_vector<op_entry> to_delete, to_keep;
         for (auto* e : m_op_cache) {            
             if (e->m_result != null_bdd) {
@@ -860,16 +903,15 @@ namespace dd {
         for (op_entry* e : to_keep) {
             m_op_cache.insert(e);
         }
+    }
 
-        m_node_table.reset();
-        // re-populate node cache
-        for (unsigned i = m_nodes.size(); i-- > 2; ) {
-            if (reachable[i]) {
-                SASSERT(m_nodes[i].m_index == i);
-                m_node_table.insert(m_nodes[i]);
-            }
-        }
-        SASSERT(well_formed());
+    void bdd_manager::collect_statistics(statistics& st) const {
+        st.update("bdd reorders", m_stats.m_num_reorders);
+        st.update("bdd gc", m_stats.m_num_gc);
+        st.update("bdd cache flushes", m_stats.m_num_cache_flushes);
+        st.update("bdd cache hits", m_stats.m_cache_hits);
+        st.update("bdd cache misses", m_stats.m_cache_misses);
+        st.update("bdd max live nodes", m_stats.m_max_live_nodes);
     }
 
     void bdd_manager::init_mark() {
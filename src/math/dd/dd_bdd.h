@@ -22,6 +22,7 @@ Revision History:
 #include "util/map.h"
 #include "util/small_object_allocator.h"
 #include "util/rational.h"
+#include "util/statistics.h"
 
 namespace dd {
 
@@ -107,7 +108,7 @@ namespace dd {
 
         struct eq_entry {
             bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_bdd1 == b->m_bdd2 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
+                return a->m_bdd1 == b->m_bdd1 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
             }
         };
 
@@ -135,6 +136,19 @@ namespace dd {
         unsigned_vector            m_reorder_rc;
         cost_metric                m_cost_metric;
         BDD                        m_cost_bdd;
+        bool                       m_auto_reorder = false;
+        unsigned                   m_reorder_threshold = 1 << 14;  // live nodes that trigger the next automatic reorder
+        unsigned                   m_max_cache_size = 1 << 20;
+
+        struct stats {
+            unsigned m_num_reorders = 0;
+            unsigned m_num_gc = 0;
+            unsigned m_num_cache_flushes = 0;
+            unsigned m_cache_hits = 0;
+            unsigned m_cache_misses = 0;
+            unsigned m_max_live_nodes = 0;
+        };
+        stats                      m_stats;
 
         BDD make_node(unsigned level, BDD l, BDD r);
         bool is_new_node() const { return m_is_new_node; }
@@ -164,6 +178,9 @@ namespace dd {
         void set_mark(unsigned i) { m_mark[i] = m_mark_level; }
         bool is_marked(unsigned i) { return m_mark[i] == m_mark_level; }
 
+        unsigned num_live_nodes() const { return m_nodes.size() - m_free_nodes.size(); }
+        void maybe_reorder();
+        void flush_cache();
         void init_reorder();
         void reorder_incref(unsigned n);
         void reorder_decref(unsigned n);
@@ -218,6 +235,19 @@ namespace dd {
 
         void set_max_num_nodes(unsigned n) { m_max_num_bdd_nodes = n; }
 
+        /**
+           \brief sift the variable order when the number of nodes doubled
+           since the last reorder, and at least n nodes are live.
+         */
+        void set_auto_reorder(bool f, unsigned n = 1 << 14) { m_auto_reorder = f; m_reorder_threshold = n; }
+
+        /**
+           \brief bound the number of entries of the operation cache.
+         */
+        void set_max_cache_size(unsigned n) { m_max_cache_size = n; }
+
+        void collect_statistics(statistics& st) const;
+
         bdd mk_var(unsigned i);
         bdd mk_nvar(unsigned i);
 
@@ -557,6 +557,51 @@ namespace dd {
         return res;
     }
 
+    /**
+     * Copy p from another manager with the same semantics into this manager.
+     * The source manager is only read, so several managers can copy from it
+     * concurrently as long as nobody modifies it.
+     */
+    pdd pdd_manager::translate(pdd const& p) {
+        pdd_manager& src = p.m;
+        if (&src == this)
+            return p;
+        SASSERT(m_semantics == src.m_semantics);
+        SASSERT(m_power_of_2 == src.m_power_of_2);
+        u_map<unsigned> cache;
+        vector<pdd> result;
+        unsigned_vector todo;
+        todo.push_back(p.root);
+        while (!todo.empty()) {
+            PDD n = todo.back();
+            if (cache.contains(n)) {
+                todo.pop_back();
+                continue;
+            }
+            if (src.is_val(n)) {
+                todo.pop_back();
+                cache.insert(n, result.size());
+                result.push_back(mk_val(src.val(n)));
+                continue;
+            }
+            unsigned l = 0, h = 0;
+            bool ready = cache.find(src.lo(n), l);
+            ready &= cache.find(src.hi(n), h);
+            if (!ready) {
+                if (!cache.contains(src.lo(n)))
+                    todo.push_back(src.lo(n));
+                if (!cache.contains(src.hi(n)))
+                    todo.push_back(src.hi(n));
+                continue;
+            }
+            todo.pop_back();
+            pdd r = mk_var(src.var(n)) * result[h] + result[l];
+            cache.insert(n, result.size());
+            result.push_back(r);
+        }
+        return result[cache[p.root]];
+    }
+
     pdd pdd_manager::pow(pdd const &p, unsigned j) {
         return pdd(pow(p.root, j), this);
     }
@@ -347,6 +347,7 @@ namespace dd {
         pdd reduce(unsigned v, pdd const& a, pdd const& b);
         void quot_rem(pdd const& a, pdd const& b, pdd& q, pdd& r);
         pdd pow(pdd const& p, unsigned j);
+        pdd translate(pdd const& p);
 
         bool is_linear(PDD p) { return degree(p) == 1; }
         bool is_linear(pdd const& p);
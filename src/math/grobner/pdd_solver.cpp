@@ -14,6 +14,7 @@
 #include "util/uint_set.h"
 #include "math/grobner/pdd_solver.h"
 #include "math/grobner/pdd_simplifier.h"
+#include "util/thread_pool.h"
 #include <math.h>
 
 
@@ -211,12 +212,80 @@ namespace dd {
     }
 
     void solver::simplify_using(equation_vector& set, equation const& eq) {    
+        if (m_config.m_threads > 1 && set.size() >= 16 * m_config.m_threads) {
+            simplify_using_parallel(set, eq);
+            return;
+        }
         std::function<bool(equation&, bool&)> simplifier = [&](equation& target, bool& changed_leading_term) {
             return try_simplify_using(target, eq, changed_leading_term);
         };
         simplify_using(set, simplifier);
     }    
 
+    /*
+      Use the given equation to simplify equations in set: the reductions
+      run in parallel and are applied in order afterwards. pdd managers are
+      not thread-safe, so each thread copies eq and its share of set into a
+      manager of its own. The managers of the solver are only read while the
+      threads run.
+    */
+    void solver::simplify_using_parallel(equation_vector& set, equation const& eq) {
+#ifdef SINGLE_THREAD
+        std::function<bool(equation&, bool&)> simplifier = [&](equation& target, bool& changed_leading_term) {
+            return try_simplify_using(target, eq, changed_leading_term);
+        };
+        simplify_using(set, simplifier);
+#else
+        unsigned num_threads = m_config.m_threads;
+        while (m_workers.size() < num_threads)
+            m_workers.push_back(alloc(pdd_manager, m.num_vars(), m.get_semantics(), m.power_of_2()));
+        for (unsigned k = 0; k < num_threads; ++k)
+            if (m_workers[k]->get_level2var() != m.get_level2var())
+                m_workers[k]->reset(m.get_level2var());
+
+        unsigned sz = set.size();
+        unsigned_vector reduced(sz, UINT_MAX);
+        vector<vector<std::pair<unsigned, pdd>>> results(num_threads);
+        auto reduce = [&](unsigned k) {
+            pdd_manager& wm = *m_workers[k];
+            try {
+                pdd t = wm.translate(eq.poly());
+                for (unsigned i = k; i < sz && !canceled(); i += num_threads) {
+                    if (set[i] == &eq)
+                        continue;
+                    pdd p = wm.translate(set[i]->poly());
+                    pdd r = p.reduce(t);
+                    if (r != p)
+                        results[k].push_back({ i, r });
+                }
+            }
+            catch (pdd_manager::mem_out) {
+                // the remaining equations are not reduced
+            }
+        };
+        thread_pool::run(num_threads, reduce);
+
+        vector<pdd> polys;
+        for (auto& rs : results) {
+            for (auto const& [i, r] : rs) {
+                reduced[i] = polys.size();
+                polys.push_back(m.translate(r));
+            }
+            rs.reset();
+        }
+
+        std::function<bool(equation&, bool&)> simplifier = [&](equation& target, bool& changed_leading_term) {
+            if (&target == &eq)
+                return false;
+            m_stats.incr_simplified();
+            SASSERT(set[target.idx()] == &target);
+            unsigned j = reduced[target.idx()];
+            return j != UINT_MAX && update_reduced(target, eq, polys[j], changed_leading_term);
+        };
+        simplify_using(set, simplifier);
+#endif
+    }
+
     /*
       simplify target using source.
       return true if the target was simplified. 
@@ -232,13 +301,20 @@ namespace dd {
         if (r == dst.poly()){
             return false;
         }
+        return update_reduced(dst, src, r, changed_leading_term);
+    }
+
+    /*
+      replace dst by its reduction r by src.
+     */
+    bool solver::update_reduced(equation& dst, equation const& src, pdd const& r, bool& changed_leading_term) {
         if (is_too_complex(r)) {
             m_too_complex = true;
             return false;
         }
         TRACE("dd.solver", 
               tout << "reduce: " << dst.poly() << "\n";
-              tout << "using:  " << t << "\n";
+              tout << "using:  " << src.poly() << "\n";
               tout << "to:     " << r << "\n";);
         changed_leading_term = dst.state() == processed && m.different_leading_term(r, dst.poly());
         dst = r;
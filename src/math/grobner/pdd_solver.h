@@ -24,6 +24,7 @@
 #include "util/region.h"
 #include "util/rlimit.h"
 #include "util/statistics.h"
+#include "util/scoped_ptr_vector.h"
 #include "math/dd/dd_pdd.h"
 #include <cstring>
 
@@ -60,6 +61,7 @@ public:
         unsigned m_expr_size_growth;
         unsigned m_expr_degree_growth;
         unsigned m_number_of_conflicts_to_report;
+        unsigned m_threads;
         config() :
             m_eqs_threshold(UINT_MAX),
             m_expr_size_limit(UINT_MAX),
@@ -71,7 +73,8 @@ public:
             m_eqs_growth(10),
             m_expr_size_growth(10),
             m_expr_degree_growth(5),
-            m_number_of_conflicts_to_report(1)
+            m_number_of_conflicts_to_report(1),
+            m_threads(1)
         {}
     };
 
@@ -123,6 +126,7 @@ private:
     equation_vector                              m_all_eqs;
     equation*                                    m_conflict = nullptr;   
     bool                                         m_too_complex;
+    scoped_ptr_vector<pdd_manager>               m_workers; // managers of the threads reducing equations in parallel
 public:
     solver(reslimit& lim, pdd_manager& m);
     ~solver();
@@ -163,9 +167,11 @@ private:
     void superpose(equation const& eq);
     void simplify_using(equation& eq, equation_vector const& eqs);
     void simplify_using(equation_vector& set, equation const& eq);
+    void simplify_using_parallel(equation_vector& set, equation const& eq);
     void simplify_using(equation & dst, equation const& src, bool& changed_leading_term);
     void simplify_using(equation_vector& set, std::function<bool(equation&, bool&)>& simplifier);
     bool try_simplify_using(equation& target, equation const& source, bool& changed_leading_term);
+    bool update_reduced(equation& dst, equation const& src, pdd const& r, bool& changed_leading_term);
 
     bool is_trivial(equation const& eq) const { return eq.poly().is_zero(); }    
     bool is_simpler(equation const& eq1, equation const& eq2) { return m.lm_lt(eq1.poly(), eq2.poly()); }
@@ -909,14 +909,26 @@ lbool hilbert_basis::saturate(num_vector const& ineq, bool is_eq) {
     m_passive2->reset();
     m_sos.reset();
     TRACE("hilbert_basis", display_ineq(tout, ineq, is_eq););
+    unsigned_vector support;
+    for (unsigned i = 0; i < get_num_vars(); ++i) {
+        if (!ineq[i].is_zero()) {
+            support.push_back(i);
+        }
+    }
     unsigned init_basis_size = 0;
     for (unsigned i = 0; i < m_basis.size(); ++i) {
         offset_t idx = m_basis[i];
         values v = vec(idx);
-        v.weight() = get_weight(v, ineq);
-        for (unsigned k = 0; k < m_current_ineq; ++k) {
-            v.weight(k) = get_weight(v, m_ineqs[k]);        
+        // the weights of the earlier inequalities are maintained by resolve,
+        // the weight of the previous inequality is the current weight.
+        if (m_current_ineq > 0) {
+            v.weight(m_current_ineq - 1) = v.weight();
         }
+        v.weight() = get_weight(v, ineq, support);
+        DEBUG_CODE(
+            for (unsigned k = 0; k < m_current_ineq; ++k) {
+                SASSERT(v.weight(k) == get_weight(v, m_ineqs[k]));
+            });
         m_index->insert(idx, v);
         if (v.weight().is_zero()) {
             m_zero.push_back(idx);
@@ -1178,6 +1190,16 @@ hilbert_basis::numeral hilbert_basis::get_weight(values const & val, num_vector
     numeral result(0);
     unsigned num_vars = get_num_vars();
     for (unsigned i = 0; i < num_vars; ++i) {
+        if (!ineq[i].is_zero()) {
+            result += val[i]*ineq[i];
+        }
+    }
+    return result;
+}
+
+hilbert_basis::numeral hilbert_basis::get_weight(values const & val, num_vector const& ineq, unsigned_vector const& support) const {
+    numeral result(0);
+    for (unsigned i : support) {
         result += val[i]*ineq[i];
     }
     return result;
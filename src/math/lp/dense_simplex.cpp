@@ -0,0 +1,108 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    dense_simplex.cpp
+
+Abstract:
+
+    Floating point feasibility search on a dense copy of a small tableau.
+
+--*/
+
+#include "math/lp/dense_simplex.h"
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace lp {
+
+    // dst := dst + f * src, over n doubles.
+    static void axpy(double * dst, double const * src, double f, unsigned n) {
+        unsigned i = 0;
+#ifdef __AVX__
+        __m256d vf = _mm256_set1_pd(f);
+        for (; i + 4 <= n; i += 4) {
+            __m256d d = _mm256_loadu_pd(dst + i);
+            __m256d s = _mm256_loadu_pd(src + i);
+            _mm256_storeu_pd(dst + i, _mm256_add_pd(d, _mm256_mul_pd(vf, s)));
+        }
+#endif
+        for (; i < n; ++i)
+            dst[i] += f * src[i];
+    }
+
+    static void scale(double * dst, double f, unsigned n) {
+        unsigned i = 0;
+#ifdef __AVX__
+        __m256d vf = _mm256_set1_pd(f);
+        for (; i + 4 <= n; i += 4)
+            _mm256_storeu_pd(dst + i, _mm256_mul_pd(vf, _mm256_loadu_pd(dst + i)));
+#endif
+        for (; i < n; ++i)
+            dst[i] *= f;
+    }
+
+    dense_simplex::dense_simplex(core_solver const & s, double delta):
+        float_simplex(s, delta),
+        m_stride((m_columns + 3) & ~3u) {
+        m_tableau.resize(static_cast<size_t>(m_rows) * m_stride, 0.0);
+        for (unsigned i = 0; i < m_rows; ++i) {
+            double * r = row(i);
+            for (auto const & c : s.m_A.m_rows[i])
+                r[c.var()] = c.coeff().get_double();
+        }
+    }
+
+    bool dense_simplex::is_applicable(core_solver const & s, unsigned max_cells, double min_density) {
+        unsigned m = s.m_A.row_count(), n = s.m_A.column_count();
+        if (m == 0 || static_cast<uint64_t>(m) * n > max_cells)
+            return false;
+        unsigned nnz = 0;
+        for (unsigned i = 0; i < m; ++i)
+            nnz += s.m_A.m_rows[i].size();
+        return nnz >= min_density * m * n;
+    }
+
+    unsigned dense_simplex::find_entering(unsigned r, bool increase) const {
+        double const * a = row(r);
+        double eps = m_s.m_settings.pivot_epsilon;
+        for (unsigned j = 0; j < m_columns; ++j) {
+            if (m_basis_heading[j] >= 0 || std::abs(a[j]) <= eps)
+                continue;
+            if (can_fix_row(j, a[j], increase))
+                return j;
+        }
+        return UINT_MAX;
+    }
+
+    void dense_simplex::update_and_pivot(unsigned r, unsigned entering, double target) {
+        unsigned leaving = m_basis[r];
+        double * pr = row(r);
+        double a = pr[entering];
+        double d = (m_x[leaving] - target) / a;
+        m_x[entering] += d;
+        for (unsigned i = 0; i < m_rows; ++i) {
+            double c = row(i)[entering];
+            if (c != 0)
+                m_x[m_basis[i]] -= c * d;
+        }
+        m_x[leaving] = target;
+
+        scale(pr, 1 / a, m_stride);
+        pr[entering] = 1;
+        for (unsigned i = 0; i < m_rows; ++i) {
+            if (i == r)
+                continue;
+            double * pi = row(i);
+            double c = pi[entering];
+            if (c == 0)
+                continue;
+            axpy(pi, pr, -c, m_stride);
+            pi[entering] = 0;
+        }
+        change_basis(r, entering);
+    }
+
+}
@@ -0,0 +1,46 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    dense_simplex.h
+
+Abstract:
+
+    Floating point feasibility search on a dense copy of a small tableau.
+
+    When the tableau of lar_core_solver is small and dense, the sparse
+    row/column representation spends most of its time on bookkeeping.
+    This kernel copies the tableau into a row major array of doubles,
+    padded for vector loads, and pivots with vectorized row operations.
+    The search and the exact repair are shared with float_simplex.
+
+--*/
+#pragma once
+
+#include "math/lp/float_simplex.h"
+
+namespace lp {
+
+class dense_simplex : public float_simplex {
+    unsigned            m_stride;      // the row length in m_tableau
+    svector<double>     m_tableau;     // row major, the basic column of a row has coefficient 1
+
+    double * row(unsigned i) { return m_tableau.data() + static_cast<size_t>(i) * m_stride; }
+    double const * row(unsigned i) const { return m_tableau.data() + static_cast<size_t>(i) * m_stride; }
+
+    unsigned find_entering(unsigned r, bool increase) const override;
+    void update_and_pivot(unsigned r, unsigned entering, double target) override;
+
+public:
+
+    dense_simplex(core_solver const & s, double delta);
+
+    /**
+       \brief Return true if the tableau of s has at most max_cells cells and
+       at least min_density of them are non-zero.
+    */
+    static bool is_applicable(core_solver const & s, unsigned max_cells, double min_density);
+};
+
+}
@@ -50,6 +50,7 @@ void emonics::push() {
 void emonics::pop(unsigned n) {
     TRACE("nla_solver_mons", tout << "pop: " << n << "\n";);
     SASSERT(invariant());
+    ++m_version;
     for (unsigned j = 0; j < n; ++j) {
         unsigned old_sz = m_lim[m_lim.size() - 1];
         for (unsigned i = m_monics.size(); i-- > old_sz; ) {
@@ -326,6 +327,7 @@ void emonics::add(lpvar v, unsigned sz, lpvar const* vs) {
     SASSERT(m_ve.is_root(v));
     SASSERT(!is_monic_var(v));
     SASSERT(invariant());
+    ++m_version;
     m_ve.push();
     unsigned idx = m_monics.size();
     m_monics.push_back(monic(v, sz, vs, idx));
@@ -434,6 +436,7 @@ void emonics::merge_eh(signed_var r2, signed_var r1, signed_var v2, signed_var v
 
 void emonics::after_merge_eh(signed_var r2, signed_var r1, signed_var v2, signed_var v1) {
     TRACE("nla_solver_mons", tout << v2 << " <- " << v1 << " : " << r2 << " <- " << r1 << "\n";);
+    ++m_version;
     if (r1.var() == r2.var() || m_ve.find(~r1) == m_ve.find(~r2)) { // the other sign has also been merged
         TRACE("nla_solver_mons", 
               display_uf(tout << r2 << " <- " << r1 << "\n");
@@ -445,6 +448,7 @@ void emonics::after_merge_eh(signed_var r2, signed_var r1, signed_var v2, signed
 }
 
 void emonics::unmerge_eh(signed_var r2, signed_var r1) {
+    ++m_version;
     if (r1.var() == r2.var() || m_ve.find(~r1) != m_ve.find(~r2)) { // the other sign has also been unmerged
         TRACE("nla_solver_mons", tout << r2 << " -> " << r1 << "\n";);
         unmerge_cells(m_use_lists[r2.var()], m_use_lists[r1.var()]);            
@@ -90,6 +90,7 @@ class emonics {
     unsigned_vector              m_lim;           // backtracking point
     mutable unsigned             m_visited;       // timestamp of visited monics during pf_iterator
     region                       m_region;        // region for allocating linked lists
+    unsigned                     m_version = 0;   // incremented when monics or variable equivalences change
     mutable svector<head_tail>   m_use_lists;     // use list of monics where variables occur.
     hash_canonical               m_cg_hash;
     eq_canonical                 m_cg_eq;
@@ -117,6 +118,13 @@ class emonics {
     std::ostream& display(std::ostream& out, cell* c) const;
 public:
     unsigned number_of_monics() const { return m_monics.size(); }
+
+    /**
+       \brief the version changes whenever a monic is added or removed, or
+       variables are merged or unmerged. Data derived from the monics and
+       their canonical forms can be reused while the version is unchanged.
+    */
+    unsigned version() const { return m_version; }
     /**
        \brief emonics builds on top of var_eqs.
        push and pop on emonics calls push/pop on var_eqs, so no 
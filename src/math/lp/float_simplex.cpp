@@ -0,0 +1,169 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    float_simplex.cpp
+
+Abstract:
+
+    Floating point feasibility search with exact repair.
+
+--*/
+
+#include "math/lp/float_simplex.h"
+
+namespace lp {
+
+    float_simplex::float_simplex(core_solver const & s, double delta):
+        m_s(s),
+        m_rows(s.m_A.row_count()),
+        m_columns(s.m_A.column_count()),
+        m_basis(s.m_basis),
+        m_basis_heading(s.m_basis_heading),
+        m_position(m_columns, not_at_bound),
+        m_iterations(0) {
+        m_x.resize(m_columns, 0.0);
+        m_lower.resize(m_columns, 0.0);
+        m_upper.resize(m_columns, 0.0);
+        for (unsigned j = 0; j < m_columns; ++j) {
+            m_x[j] = to_double(s.m_x[j], delta);
+            if (s.column_has_lower_bound(j))
+                m_lower[j] = to_double(s.m_lower_bounds[j], delta);
+            if (s.column_has_upper_bound(j))
+                m_upper[j] = to_double(s.m_upper_bounds[j], delta);
+        }
+    }
+
+    bool float_simplex::below_lower(unsigned j) const {
+        return m_s.column_has_lower_bound(j) && m_x[j] < m_lower[j] - tolerance(m_lower[j]);
+    }
+
+    bool float_simplex::above_upper(unsigned j) const {
+        return m_s.column_has_upper_bound(j) && m_x[j] > m_upper[j] + tolerance(m_upper[j]);
+    }
+
+    bool float_simplex::can_increase(unsigned j) const {
+        return !m_s.column_has_upper_bound(j) || m_x[j] < m_upper[j] - tolerance(m_upper[j]);
+    }
+
+    bool float_simplex::can_decrease(unsigned j) const {
+        return !m_s.column_has_lower_bound(j) || m_x[j] > m_lower[j] + tolerance(m_lower[j]);
+    }
+
+    // Bland's rule: the row of the infeasible basic column with the smallest index.
+    unsigned float_simplex::find_infeasible_row() const {
+        unsigned best = UINT_MAX, best_j = UINT_MAX;
+        for (unsigned i = 0; i < m_rows; ++i) {
+            unsigned j = m_basis[i];
+            if (j < best_j && (below_lower(j) || above_upper(j))) {
+                best = i;
+                best_j = j;
+            }
+        }
+        return best;
+    }
+
+    void float_simplex::change_basis(unsigned r, unsigned entering) {
+        unsigned leaving = m_basis[r];
+        m_basis[r] = entering;
+        m_basis_heading[entering] = r;
+        m_basis_heading[leaving] = -1;
+        m_trace.push_back(entering);
+        m_trace.push_back(leaving);
+    }
+
+    lbool float_simplex::find_feasible_solution(lp_settings & settings, unsigned max_iterations) {
+        while (true) {
+            if (settings.get_cancel_flag())
+                return l_undef;
+            unsigned r = find_infeasible_row();
+            if (r == UINT_MAX)
+                return l_true;
+            if (m_iterations >= max_iterations)
+                return l_undef;
+            unsigned b = m_basis[r];
+            bool increase = below_lower(b);
+            unsigned e = find_entering(r, increase);
+            if (e == UINT_MAX)
+                return l_false;
+            if (m_s.column_is_fixed(b))
+                m_position[b] = at_fixed;
+            else
+                m_position[b] = increase ? at_lower_bound : at_upper_bound;
+            update_and_pivot(r, e, increase ? m_lower[b] : m_upper[b]);
+            ++m_iterations;
+        }
+    }
+
+    void float_simplex::get_signature(lar_solution_signature & signature) const {
+        signature.clear();
+        for (unsigned j = 0; j < m_columns; ++j)
+            if (m_basis_heading[j] < 0 && m_s.m_basis_heading[j] >= 0)
+                signature[j] = m_position[j];
+    }
+
+    sparse_float_simplex::sparse_float_simplex(core_solver const & s, double delta):
+        float_simplex(s, delta),
+        m_A(m_rows, m_columns),
+        m_drop_tolerance(s.m_settings.drop_tolerance) {
+        for (unsigned i = 0; i < m_rows; ++i)
+            for (auto const & c : s.m_A.m_rows[i])
+                m_A.add_new_element(i, c.var(), c.coeff().get_double());
+    }
+
+    unsigned sparse_float_simplex::find_entering(unsigned r, bool increase) const {
+        double eps = m_s.m_settings.pivot_epsilon;
+        unsigned best = UINT_MAX;
+        for (auto const & c : m_A.m_rows[r]) {
+            unsigned j = c.var();
+            if (j >= best || m_basis_heading[j] >= 0 || std::abs(c.coeff()) <= eps)
+                continue;
+            if (can_fix_row(j, c.coeff(), increase))
+                best = j;
+        }
+        return best;
+    }
+
+    void sparse_float_simplex::update_and_pivot(unsigned r, unsigned entering, double target) {
+        unsigned leaving = m_basis[r];
+        auto & pivot_row = m_A.m_rows[r];
+        double a = 0;
+        for (auto const & c : pivot_row)
+            if (c.var() == entering)
+                a = c.coeff();
+        SASSERT(a != 0);
+        double d = (m_x[leaving] - target) / a;
+        m_x[entering] += d;
+        for (auto const & c : m_A.m_columns[entering])
+            m_x[m_basis[c.var()]] -= m_A.get_val(c) * d;
+        m_x[leaving] = target;
+
+        for (auto & c : pivot_row)
+            c.coeff() = c.var() == entering ? 1 : c.coeff() / a;
+
+        // move the cell of the pivot row to the head of the column, as pivot_column_tableau does
+        auto & column = m_A.m_columns[entering];
+        for (unsigned k = 1; k < column.size(); ++k) {
+            if (column[k].var() != r)
+                continue;
+            auto c = column[0];
+            column[0] = column[k];
+            column[k] = c;
+            pivot_row[column[0].offset()].offset() = 0;
+            m_A.m_rows[c.var()][c.offset()].offset() = k;
+            break;
+        }
+        while (column.size() > 1) {
+            unsigned i = column.back().var();
+            m_A.pivot_row_to_row_given_cell(r, column.back(), entering);
+            // drop the rounding noise so that the rows stay sparse
+            auto & ri = m_A.m_rows[i];
+            for (unsigned k = ri.size(); k-- > 0; )
+                if (std::abs(ri[k].coeff()) < m_drop_tolerance && ri[k].var() != m_basis[i])
+                    m_A.remove_element(ri, ri[k]);
+        }
+        change_basis(r, entering);
+    }
+
+}
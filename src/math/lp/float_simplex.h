@@ -0,0 +1,105 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    float_simplex.h
+
+Abstract:
+
+    Floating point feasibility search with exact repair.
+
+    The rational tableau of lar_core_solver is copied into doubles and the
+    bounded variable feasibility loop (Bland's rule, as in the rational
+    tableau solver) runs on the copy. The result is only a hint: the trace
+    of basis changes and the bound positions of the columns that left the
+    basis are replayed on the exact solver, which verifies the candidate
+    basis and repairs it where rounding made the floating point search go
+    astray. This is the scheme of SoPlex and QSopt_ex, restricted to the
+    feasibility problems solved by lar_solver.
+
+    float_simplex holds the search, the tableau representation is provided
+    by a subclass: sparse_float_simplex below keeps the sparse row/column
+    layout of static_matrix, dense_simplex (dense_simplex.h) a row major
+    array for small and dense tableaux.
+
+--*/
+#pragma once
+
+#include "util/lbool.h"
+#include "math/lp/lp_core_solver_base.h"
+#include "math/lp/lar_solution_signature.h"
+
+namespace lp {
+
+class float_simplex {
+protected:
+    typedef lp_core_solver_base<mpq, numeric_pair<mpq>> core_solver;
+
+    core_solver const & m_s;
+    unsigned            m_rows;
+    unsigned            m_columns;
+    svector<double>     m_x;
+    svector<double>     m_lower;
+    svector<double>     m_upper;
+    vector<unsigned>    m_basis;
+    vector<int>         m_basis_heading;
+    vector<unsigned>    m_trace;       // the even positions are entering, the odd positions are leaving
+    vector<non_basic_column_value_position> m_position; // the bound a column was moved to when it left the basis
+    unsigned            m_iterations;
+
+    static double to_double(numeric_pair<mpq> const & v, double delta) { return v.x.get_double() + delta * v.y.get_double(); }
+    double tolerance(double bound) const { return 1e-9 * std::max(1.0, std::abs(bound)); }
+    bool below_lower(unsigned j) const;
+    bool above_upper(unsigned j) const;
+    bool can_increase(unsigned j) const;
+    bool can_decrease(unsigned j) const;
+    // Every row reads x_b + sum a_j x_j = 0, so x_b grows when a non-basic x_j
+    // with a negative coefficient grows or one with a positive coefficient decreases.
+    bool can_fix_row(unsigned j, double a, bool increase) const {
+        return ((a < 0) == increase) ? can_increase(j) : can_decrease(j);
+    }
+    unsigned find_infeasible_row() const;
+    void change_basis(unsigned r, unsigned entering);
+
+    // Bland's rule: the smallest column of row r that moves its basic column in the requested direction.
+    virtual unsigned find_entering(unsigned r, bool increase) const = 0;
+    // bring the basic column of row r to target by moving entering and pivot entering into the basis
+    virtual void update_and_pivot(unsigned r, unsigned entering, double target) = 0;
+
+public:
+
+    float_simplex(core_solver const & s, double delta);
+
+    virtual ~float_simplex() = default;
+
+    /**
+       \brief Search for a feasible basis. Returns l_true if one was found,
+       l_false if some row cannot be repaired (the exact solver is expected
+       to confirm the conflict) and l_undef if the iteration limit was
+       reached or the search was canceled.
+    */
+    lbool find_feasible_solution(lp_settings & settings, unsigned max_iterations);
+
+    /**
+       \brief Record the bound position of the non-basic columns that left the original basis.
+    */
+    void get_signature(lar_solution_signature & signature) const;
+
+    vector<unsigned> const & trace() const { return m_trace; }
+    vector<int> const & basis_heading() const { return m_basis_heading; }
+    unsigned iterations() const { return m_iterations; }
+};
+
+class sparse_float_simplex : public float_simplex {
+    static_matrix<double, double> m_A;
+    double                        m_drop_tolerance;
+
+    unsigned find_entering(unsigned r, bool increase) const override;
+    void update_and_pivot(unsigned r, unsigned entering, double target) override;
+
+public:
+    sparse_float_simplex(core_solver const & s, double delta);
+};
+
+}
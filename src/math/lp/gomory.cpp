@@ -400,8 +400,119 @@ int gomory::find_basic_var() {
     return result;
 }
     
+// the distance of the current solution to the cut t >= k
+double gomory::efficacy(lar_term const& t, mpq const& k) const {
+    double norm = 0;
+    for (lar_term::ival p : t) {
+        double c = p.coeff().get_double();
+        norm += c * c;
+    }
+    if (norm == 0)
+        return 0;
+    double violation = (impq(k) - t.apply(lra.r_x())).x.get_double();
+    return violation / sqrt(norm);
+}
+
+// the cosine of the angle between the normals of two cuts
+double gomory::parallelism(lar_term const& a, lar_term const& b) {
+    double dot = 0, na = 0, nb = 0;
+    for (lar_term::ival p : a) {
+        double c = p.coeff().get_double();
+        na += c * c;
+        auto const* e = b.coeffs<u_map<mpq>>().find_core(p.column().index());
+        if (e)
+            dot += c * e->get_data().m_value.get_double();
+    }
+    for (lar_term::ival p : b) {
+        double c = p.coeff().get_double();
+        nb += c * c;
+    }
+    if (na == 0 || nb == 0)
+        return 1;
+    return std::abs(dot) / sqrt(na * nb);
+}
+
+// Separate cuts from the candidate rows with the shortest rows first, keep
+// the cut with the best efficacy and then greedily the next best ones that
+// are not almost parallel to a kept cut. The best cut is returned through
+// lia.m_t, lia.m_k and lia.m_ex, the others are left in lia.m_cuts.
+lia_move gomory::cut_pool(unsigned max_cuts) {
+    // cuts whose normals are closer than this are considered parallel
+    const double max_parallelism = 0.9;
+    svector<unsigned> basics;
+    for (unsigned j : lra.r_basis()) {
+        if (!lia.column_is_int_inf(j))
+            continue;
+        if (is_gomory_cut_target(lra.get_row(lia.row_of_basic_column(j))))
+            basics.push_back(j);
+    }
+    if (basics.empty())
+        return lia_move::undef;
+    std::stable_sort(basics.begin(), basics.end(), [&](unsigned a, unsigned b) {
+        return lra.get_row(lia.row_of_basic_column(a)).size() < lra.get_row(lia.row_of_basic_column(b)).size(); });
+    if (basics.size() > 4 * max_cuts)
+        basics.shrink(4 * max_cuts);
+
+    explanation* ex = lia.m_ex;
+    vector<int_solver::cut> pool;
+    svector<double> scores;
+    lia.m_upper = false;
+    for (unsigned j : basics) {
+        int_solver::cut c;
+        lia.m_ex = &c.m_ex;
+        const row_strip<mpq>& row = lra.get_row(lia.row_of_basic_column(j));
+        SASSERT(lra.row_is_correct(lia.row_of_basic_column(j)));
+        lia_move r = cut(lia.m_t, lia.m_k, lia.m_ex, j, row);
+        if (r == lia_move::conflict) {
+            lia.m_ex = ex;
+            ex->clear();
+            ex->add_expl(c.m_ex);
+            return r;
+        }
+        if (r != lia_move::cut)
+            continue;
+        c.m_t = lia.m_t;
+        c.m_k = lia.m_k;
+        scores.push_back(efficacy(c.m_t, c.m_k));
+        pool.push_back(c);
+    }
+    lia.m_ex = ex;
+    if (pool.empty())
+        return lia_move::undef;
+
+    unsigned_vector order;
+    for (unsigned i = 0; i < pool.size(); ++i)
+        order.push_back(i);
+    std::stable_sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return scores[a] > scores[b]; });
+    unsigned_vector selected;
+    for (unsigned i : order) {
+        if (selected.size() >= max_cuts)
+            break;
+        bool parallel = false;
+        for (unsigned s : selected)
+            if (parallelism(pool[i].m_t, pool[s].m_t) > max_parallelism) {
+                parallel = true;
+                break;
+            }
+        if (!parallel)
+            selected.push_back(i);
+    }
+    TRACE("gomory_cut", tout << "pool: " << pool.size() << ", selected: " << selected.size() << "\n";);
+    auto& best = pool[selected[0]];
+    lia.m_t = best.m_t;
+    lia.m_k = best.m_k;
+    ex->clear();
+    ex->add_expl(best.m_ex);
+    for (unsigned i = 1; i < selected.size(); ++i)
+        lia.m_cuts.push_back(pool[selected[i]]);
+    lia.settings().stats().m_gomory_pool_cuts += selected.size() - 1;
+    return lia_move::cut;
+}
+
 lia_move gomory::operator()() {
     lra.move_non_basic_columns_to_bounds(true);
+    if (lia.settings().gomory_cuts() > 1)
+        return cut_pool(lia.settings().gomory_cuts());
     int j = find_basic_var();
     if (j == -1)
         return lia_move::undef;
@@ -30,6 +30,9 @@ namespace lp {
         int find_basic_var();
         bool is_gomory_cut_target(const row_strip<mpq>& row);
         lia_move cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j, const row_strip<mpq>& row);
+        double efficacy(lar_term const& t, mpq const& k) const;
+        static double parallelism(lar_term const& a, lar_term const& b);
+        lia_move cut_pool(unsigned max_cuts);
     public:
         gomory(int_solver& lia);
         lia_move operator()();
@@ -146,6 +146,7 @@ lia_move int_solver::check(lp::explanation * e) {
 
     m_t.clear();
     m_k.reset();
+    m_cuts.reset();
     m_ex = e;
     m_ex->clear();
     m_upper = false;
@@ -40,6 +40,15 @@ class int_solver {
     friend class int_gcd_test;
     friend class hnf_cutter;
 
+public:
+    // a cut t >= k implied by the constraints in ex
+    struct cut {
+        lar_term    m_t;
+        mpq         m_k;
+        explanation m_ex;
+    };
+private:
+
     class patcher {
         int_solver&         lia;
         lar_solver&         lra;
@@ -66,6 +75,7 @@ class int_solver {
     mpq                 m_k;               // the right side of the cut
     explanation         *m_ex;             // the conflict explanation
     bool                m_upper;           // we have a cut m_t*x <= k if m_upper is true nad m_t*x >= k otherwise
+    vector<cut>         m_cuts;            // additional cuts returned together with m_t, m_k
     hnf_cutter          m_hnf_cutter;
     unsigned            m_hnf_cut_period;
 public:
@@ -77,6 +87,7 @@ public:
     lar_term const& get_term() const { return m_t; }
     mpq const& get_offset() const { return m_k; }
     bool is_upper() const { return m_upper; }
+    vector<cut> const& additional_cuts() const { return m_cuts; }
     bool is_base(unsigned j) const;
     bool is_real(unsigned j) const;
     const impq & lower_bound(unsigned j) const;
@@ -128,6 +128,10 @@ public:
 
     void solve();
 
+    bool need_to_solve_with_float_simplex() const;
+
+    void solve_with_float_simplex();
+
     bool lower_bounds_are_set() const { return true; }
 
     const indexed_vector<mpq> & get_pivot_row() const {
@@ -15,6 +15,7 @@ Revision History:
 #include "util/vector.h"
 #include "math/lp/lar_core_solver.h"
 #include "math/lp/lar_solution_signature.h"
+#include "math/lp/dense_simplex.h"
 namespace lp {
 lar_core_solver::lar_core_solver(
     lp_settings & settings,
@@ -138,6 +139,55 @@ unsigned lar_core_solver::get_number_of_non_ints() const {
     return n;
 }
 
+bool lar_core_solver::need_to_solve_with_float_simplex() const {
+    if (settings().simplex_strategy() != simplex_strategy_enum::tableau_rows ||
+        !m_r_solver.m_look_for_feasible_solution_only)
+        return false;
+    switch (settings().simplex_engine()) {
+    case simplex_engine_enum::exact:
+        return false;
+    case simplex_engine_enum::hybrid:
+        return true;
+    default:
+        return settings().dense_simplex_max_cells > 0 &&
+            dense_simplex::is_applicable(m_r_solver, settings().dense_simplex_max_cells, settings().dense_simplex_min_density);
+    }
+}
+
+// Replay the basis found by the floating point search on the rational tableau,
+// move the columns that left the basis to their bounds and let the exact
+// solver verify the result, pivoting further where rounding misled the search.
+void lar_core_solver::solve_with_float_simplex() {
+    double delta = find_delta_for_strict_boxed_bounds().get_double();
+    if (delta > 0.000001)
+        delta = 0.000001;
+    scoped_ptr<float_simplex> fs;
+    if (settings().dense_simplex_max_cells > 0 &&
+        dense_simplex::is_applicable(m_r_solver, settings().dense_simplex_max_cells, settings().dense_simplex_min_density)) {
+        fs = alloc(dense_simplex, m_r_solver, delta);
+        ++settings().stats().m_float_simplex_dense;
+    }
+    else
+        fs = alloc(sparse_float_simplex, m_r_solver, delta);
+    ++settings().stats().m_float_simplex;
+    // rounding may defeat Bland's rule, so the floating point search gets a modest budget
+    lbool r = fs->find_feasible_solution(settings(), 64 * (m_r_A.row_count() + m_r_A.column_count()));
+    TRACE("lar_solver", tout << "float simplex: " << r << " after " << fs->iterations() << " iterations\n";);
+    if (settings().get_cancel_flag()) {
+        m_r_solver.set_status(lp_status::CANCELLED);
+        return;
+    }
+    lar_solution_signature signature;
+    fs->get_signature(signature);
+    bool replayed = catch_up_in_lu_tableau(fs->trace(), fs->basis_heading());
+    fs = nullptr;
+    prepare_solver_x_with_signature_tableau(signature);
+    unsigned iters = m_r_solver.total_iterations();
+    m_r_solver.find_feasible_solution();
+    if (!replayed || m_r_solver.total_iterations() != iters)
+        ++settings().stats().m_float_simplex_repairs;
+}
+
 void lar_core_solver::solve() {
     TRACE("lar_solver", tout << m_r_solver.get_status() << "\n";);
     lp_assert(m_r_solver.non_basic_columns_are_set_correctly());
@@ -166,6 +216,9 @@ void lar_core_solver::solve() {
             solve_on_signature(solution_signature, changes_of_basis);
 
         lp_assert(!settings().use_tableau() || r_basis_is_OK());
+    } else if (need_to_solve_with_float_simplex()) {
+        solve_with_float_simplex();
+        lp_assert(r_basis_is_OK());
     } else {
         if (!settings().use_tableau()) {
             TRACE("lar_solver", tout << "no tablau\n";);
@@ -242,6 +242,44 @@ namespace lp {
         m_term_count.push();
         m_constraints.push();
         m_usage_in_terms.push();
+        push_warm_start();
+    }
+
+    // Bounds only get looser on pop, so a solution that was feasible when the
+    // scope was entered is feasible again after the scope is left. Pivoting
+    // keeps the solution space of the rows, so the saved values remain a
+    // solution of the tableau even if the basis changed in between.
+    void lar_solver::push_warm_start() {
+        m_warm_start_x.push_back(vector<impq>());
+        if (!m_settings.warm_start() || !use_tableau() || use_tableau_costs())
+            return;
+        if (get_status() != lp_status::OPTIMAL && get_status() != lp_status::FEASIBLE)
+            return;
+        if (!m_mpq_lar_core_solver.m_r_solver.current_x_is_feasible() || !m_incorrect_columns.empty())
+            return;
+        m_warm_start_x.back() = m_mpq_lar_core_solver.m_r_x;
+    }
+
+    void lar_solver::pop_warm_start(unsigned k) {
+        unsigned lvl = m_warm_start_x.size() - k;
+        vector<impq> x;
+        x.swap(m_warm_start_x[lvl]);
+        m_warm_start_x.shrink(lvl);
+        auto& rslv = m_mpq_lar_core_solver.m_r_solver;
+        if (x.size() != A_r().column_count() || !use_tableau() || use_tableau_costs())
+            return;
+        x.swap(m_mpq_lar_core_solver.m_r_x);
+        for (unsigned j = 0; j < A_r().column_count(); j++) {
+            if (!rslv.column_is_feasible(j)) {
+                // bounds were tightened after the solution was saved
+                x.swap(m_mpq_lar_core_solver.m_r_x);
+                return;
+            }
+        }
+        rslv.clear_inf_set();
+        m_incorrect_columns.clear();
+        m_settings.stats().m_warm_starts++;
+        TRACE("lar_solver", tout << "restored the solution of level " << lvl << "\n";);
     }
     
     void lar_solver::clean_popped_elements(unsigned n, u_set& set) {
@@ -304,6 +342,7 @@ namespace lp {
         lp_assert(sizes_are_correct());
         lp_assert((!m_settings.use_tableau()) || m_mpq_lar_core_solver.m_r_solver.reduced_costs_are_correct_tableau());
         m_usage_in_terms.pop(k);
+        pop_warm_start(k);
         set_status(lp_status::UNKNOWN);
     }
 
@@ -90,6 +90,7 @@ class lar_solver : public column_namer {
     // the set of column indices j such that bounds have changed for j
     u_set                                               m_columns_with_changed_bounds;
     u_set                                               m_rows_with_changed_bounds;
+    unsigned_vector                                     m_deferred_rows;     // rows left over by the bound propagation budget
     unsigned_vector                                     m_row_bounds_to_replay;
     
     u_set                                               m_basic_columns_with_changed_cost;
@@ -104,6 +105,8 @@ class lar_solver : public column_namer {
     std::unordered_map<lar_term, std::pair<mpq, unsigned>, term_hasher, term_comparer>
     m_normalized_terms_to_columns;
     vector<impq>                                        m_backup_x;
+    // m_warm_start_x[i] is the feasible solution at the i-th push, if there was one
+    vector<vector<impq>>                                m_warm_start_x;
     stacked_vector<unsigned>                            m_usage_in_terms;
     // ((x[j], is_int(j))->j)  for fixed j, used in equalities propagation
     // maps values to integral fixed vars
@@ -264,6 +267,8 @@ class lar_solver : public column_namer {
     void remove_last_column_from_tableau();
     void pop_tableau();
     void clean_inf_set_of_r_solver_after_pop();
+    void push_warm_start();
+    void pop_warm_start(unsigned k);
     void shrink_explanation_to_minimum(vector<std::pair<mpq, constraint_index>> & explanation) const;
     inline bool column_value_is_integer(unsigned j) const { return get_column_value(j).is_int(); }
     bool model_is_int_feasible() const;
@@ -384,7 +389,14 @@ public:
     template <typename T>
     void propagate_bounds_for_touched_rows(lp_bound_propagator<T> & bp) {
         SASSERT(use_tableau());
+        // analyze the changed rows until the budget of row entries is used up
+        unsigned budget = settings().bound_propagation_budget;
+        unsigned num_rows = 0, work = 0;
         for (unsigned i : m_rows_with_changed_bounds) {
+            if (budget > 0 && work >= budget)
+                break;
+            work += A_r().m_rows[i].size();
+            ++num_rows;
             calculate_implied_bounds_for_row(i, bp);
             if (settings().get_cancel_flag())
                 return;
@@ -394,7 +406,8 @@ public:
         // and add fixed columns this way
         if (settings().propagate_eqs()) {
             bp.clear_for_eq();
-            for (unsigned i : m_rows_with_changed_bounds) {
+            for (unsigned k = 0; k < num_rows; ++k) {
+                unsigned i = m_rows_with_changed_bounds[k];
                 unsigned offset_eqs = stats().m_offset_eqs;
                 bp.cheap_eq_tree(i);                
                 if (settings().get_cancel_flag())
@@ -403,7 +416,18 @@ public:
                     m_row_bounds_to_replay.push_back(i);
             }
         }
+        if (num_rows == m_rows_with_changed_bounds.size()) {
+            m_rows_with_changed_bounds.clear();
+            return;
+        }
+        // the remaining rows are analyzed in the next round
+        m_deferred_rows.reset();
+        for (unsigned k = num_rows; k < m_rows_with_changed_bounds.size(); ++k)
+            m_deferred_rows.push_back(m_rows_with_changed_bounds[k]);
         m_rows_with_changed_bounds.clear();
+        for (unsigned i : m_deferred_rows)
+            m_rows_with_changed_bounds.insert(i);
+        stats().m_bprop_deferred_rows += m_deferred_rows.size();
     }
     
     bool is_fixed(column_index const& j) const { return column_is_fixed(j); }
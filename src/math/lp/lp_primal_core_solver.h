@@ -61,12 +61,14 @@ public:
     unsigned          m_bland_mode_threshold;
     unsigned          m_left_basis_repeated;
     vector<unsigned>  m_leaving_candidates;
+    bool_vector       m_benefitial;          // computed in parallel for the columns of m_nbasis
     //    T m_converted_harris_eps = convert_struct<T, double>::convert(this->m_settings.harris_feasibility_tolerance);
     std::list<unsigned> m_non_basis_list;
     void sort_non_basis();
     void sort_non_basis_rational();
     int choose_entering_column(unsigned number_of_benefitial_columns_to_go_over);
     int choose_entering_column_tableau();
+    bool price_in_parallel();
     int choose_entering_column_presize(unsigned number_of_benefitial_columns_to_go_over);
     int find_leaving_and_t_with_breakpoints(unsigned entering, X & t);
     // int find_inf_row() {
@@ -492,6 +494,24 @@ public:
         return j;
     }
 
+    // the leaving column of the dual simplex: the basic column with the largest bound violation,
+    // ties are broken by the smallest index
+    int find_most_inf_column() {
+        int j = -1;
+        X max_inf, inf;
+        for (unsigned k : this->inf_set()) {
+            if (this->column_has_lower_bound(k) && this->x_below_low_bound(k))
+                inf = this->m_lower_bounds[k] - this->m_x[k];
+            else
+                inf = this->m_x[k] - this->m_upper_bounds[k];
+            if (j == -1 || inf > max_inf || (inf == max_inf && k < static_cast<unsigned>(j))) {
+                max_inf = inf;
+                j = k;
+            }
+        }
+        return j;
+    }
+
     const X& get_val_for_leaving(unsigned j) const {
         lp_assert(!this->column_is_feasible(j));
         switch (this->m_column_types[j]) {
@@ -515,7 +535,7 @@ public:
     
     
     void one_iteration_tableau_rows() {
-        int leaving = find_smallest_inf_column();
+        int leaving = this->m_settings.dual_pricing() && !m_bland_mode_tableau ? find_most_inf_column() : find_smallest_inf_column();
         if (leaving == -1) {
             this->set_status(lp_status::OPTIMAL);
             return;
@@ -21,6 +21,7 @@ Revision History:
 
 // this is a part of lp_primal_core_solver that deals with the tableau
 #include "math/lp/lp_primal_core_solver.h"
+#include "util/thread_pool.h"
 namespace lp {
 template <typename T, typename X> void lp_primal_core_solver<T, X>::one_iteration_tableau() {
     int entering = choose_entering_column_tableau();
@@ -51,6 +52,28 @@ template <typename T, typename X> int lp_primal_core_solver<T, X>::choose_enteri
     return find_shortest_beneficial_column_in_row(i);
  }
 */
+/*
+  Decide for every non-basic column whether it may enter the basis, with the
+  columns of m_nbasis split into consecutive chunks over the threads.
+  The tests only read the solver state.
+*/
+template <typename T, typename X> bool lp_primal_core_solver<T, X>::price_in_parallel() {
+    unsigned num_threads = this->m_settings.pricing_threads;
+    unsigned sz = this->m_nbasis.size();
+    if (num_threads <= 1 || sz < 10000)
+        return false;
+    m_benefitial.reserve(this->m_n(), false);
+    unsigned chunk = (sz + num_threads - 1) / num_threads;
+    thread_pool::run(num_threads, [&](unsigned k) {
+        unsigned end = std::min(sz, (k + 1) * chunk);
+        for (unsigned i = k * chunk; i < end; ++i) {
+            unsigned j = this->m_nbasis[i];
+            m_benefitial[j] = column_is_benefitial_for_entering_basis(j);
+        }
+    });
+    return true;
+}
+
  template <typename T, typename X> int lp_primal_core_solver<T, X>::choose_entering_column_tableau() {
     //this moment m_y = cB * B(-1)
     unsigned number_of_benefitial_columns_to_go_over =  get_number_of_non_basic_column_to_try_for_enter();
@@ -66,10 +89,11 @@ template <typename T, typename X> int lp_primal_core_solver<T, X>::choose_enteri
         this->m_basis_sort_counter--;
     }
     unsigned j_nz = this->m_m() + 1; // this number is greater than the max column size
+    bool priced = price_in_parallel();
     std::list<unsigned>::iterator entering_iter = m_non_basis_list.end();
     for (auto non_basis_iter = m_non_basis_list.begin(); number_of_benefitial_columns_to_go_over && non_basis_iter != m_non_basis_list.end(); ++non_basis_iter) {
         unsigned j = *non_basis_iter;
-        if (!column_is_benefitial_for_entering_basis(j))
+        if (priced ? !m_benefitial[j] : !column_is_benefitial_for_entering_basis(j))
             continue;
 
         // if we are here then j is a candidate to enter the basis
@@ -33,4 +33,11 @@ void lp::lp_settings::updt_params(params_ref const& _p) {
     report_frequency = p.arith_rep_freq();
     m_simplex_strategy = static_cast<lp::simplex_strategy_enum>(p.arith_simplex_strategy());
     m_nlsat_delay = p.arith_nl_delay();
+    m_warm_start = p.arith_warm_start();
+    m_gomory_cuts = std::max(1u, p.arith_gomory_cuts());
+    m_simplex_engine = static_cast<lp::simplex_engine_enum>(std::min(2u, p.arith_simplex_engine()));
+    dense_simplex_max_cells = p.arith_dense_simplex_max_cells();
+    bound_propagation_budget = p.arith_bprop_budget();
+    pricing_threads = p.arith_pricing_threads();
+    m_dual_pricing = p.arith_dual_pricing();
 }
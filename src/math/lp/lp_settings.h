@@ -59,6 +59,13 @@ enum class simplex_strategy_enum {
     lu = 2
 };
 
+// the arithmetic used by the feasibility search on the tableau
+enum class simplex_engine_enum {
+    exact = 0,      // rational arithmetic only
+    automatic = 1,  // floating point search with exact repair for small and dense tableaux
+    hybrid = 2      // floating point search with exact repair for every tableau
+};
+
 std::string column_type_to_string(column_type t);
 
 enum class lp_status {
@@ -126,7 +133,14 @@ struct statistics {
     unsigned m_cross_nested_forms;
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
+    unsigned m_grobner_reused;
     unsigned m_offset_eqs;
+    unsigned m_float_simplex;
+    unsigned m_float_simplex_dense;
+    unsigned m_float_simplex_repairs;
+    unsigned m_warm_starts;
+    unsigned m_gomory_pool_cuts;
+    unsigned m_bprop_deferred_rows;
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
     void collect_statistics(::statistics& st) const {
@@ -147,7 +161,14 @@ struct statistics {
         st.update("arith-horner-cross-nested-forms", m_cross_nested_forms);
         st.update("arith-grobner-calls", m_grobner_calls);
         st.update("arith-grobner-conflicts", m_grobner_conflicts);
+        st.update("arith-grobner-reused", m_grobner_reused);
         st.update("arith-offset-eqs", m_offset_eqs);
+        st.update("arith-float-simplex", m_float_simplex);
+        st.update("arith-float-simplex-dense", m_float_simplex_dense);
+        st.update("arith-float-simplex-repairs", m_float_simplex_repairs);
+        st.update("arith-warm-starts", m_warm_starts);
+        st.update("arith-gomory-pool-cuts", m_gomory_pool_cuts);
+        st.update("arith-bprop-deferred-rows", m_bprop_deferred_rows);
 
     }
 };
@@ -219,6 +240,7 @@ public:
     bool                   m_bound_propagation { true };
     bool                   presolve_with_double_solver_for_lar { true };
     simplex_strategy_enum  m_simplex_strategy;
+    simplex_engine_enum    m_simplex_engine { simplex_engine_enum::automatic };
     
     int              report_frequency { 1000 };
     bool             print_statistics { false };
@@ -227,8 +249,14 @@ public:
     double           density_threshold { 0.7 };
     bool             use_breakpoints_in_feasibility_search { false };
     unsigned         max_row_length_for_bound_propagation { 300 };
+    unsigned         bound_propagation_budget { 0 };  // row entries analyzed per round, 0 - no limit
+    unsigned         pricing_threads { 1 };
     bool             backup_costs { true };
     unsigned         column_number_threshold_for_using_lu_in_lar_solver { 4000 };
+    // tableaux with at most that many cells and at least the given fraction
+    // of non-zeroes are searched with the dense floating point kernel
+    unsigned         dense_simplex_max_cells { 4096 };
+    double           dense_simplex_min_density { 0.3 };
     unsigned         m_int_gomory_cut_period { 4 };
     unsigned         m_int_find_cube_period { 4 };
 private:
@@ -242,9 +270,15 @@ private:
     bool             m_enable_hnf { true };
     bool             m_print_external_var_name { false };
     bool             m_propagate_eqs { false };
+    bool             m_warm_start { false };
+    bool             m_dual_pricing { false };
+    unsigned         m_gomory_cuts { 1 };
 public:
+    bool dual_pricing() const { return m_dual_pricing; }
     bool print_external_var_name() const { return m_print_external_var_name; }
     bool propagate_eqs() const { return m_propagate_eqs;}
+    bool warm_start() const { return m_warm_start; }
+    unsigned gomory_cuts() const { return m_gomory_cuts; }
     unsigned hnf_cut_period() const { return m_hnf_cut_period; }
     void set_hnf_cut_period(unsigned period) { m_hnf_cut_period = period;  }
     unsigned random_next() { return m_rand(); }
@@ -340,6 +374,8 @@ public:
         return m_simplex_strategy;
     }
 
+    simplex_engine_enum simplex_engine() const { return m_simplex_engine; }
+
     bool use_lu() const {
         return m_simplex_strategy == simplex_strategy_enum::lu;
     }
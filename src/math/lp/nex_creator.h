@@ -9,6 +9,7 @@
 #include <map>
 #include <set>
 #include "util/map.h"
+#include "util/region.h"
 #include "math/lp/nex.h"
 namespace nla {
 
@@ -25,9 +26,12 @@ struct occ {
 
 
 // the purpose of this class is to create nex objects, keep them,
-// sort them, and delete them
+// sort them, and delete them.
+// The nex objects live in a region that is reset by clear(); pop() runs their
+// destructors, the memory of popped objects is reclaimed by clear().
 
 class nex_creator {
+    region                                       m_region;
     ptr_vector<nex>                              m_allocated;
     std::unordered_map<lpvar, occ>               m_occurences_map;
     std::unordered_map<lpvar, unsigned>          m_powers;
@@ -57,12 +61,17 @@ private:
     svector<unsigned>& active_vars_weights() { return m_active_vars_weights; }
     const svector<unsigned>& active_vars_weights() const { return m_active_vars_weights; }
 
-    nex_mul* mk_mul(const vector<nex_pow>& v) {
-        auto r = alloc(nex_mul, rational::zero(), v);
+    template <typename T, typename ...Args>
+    T* mk_nex(Args&& ... args) {
+        T* r = new (m_region) T(std::forward<Args>(args)...);
         add_to_allocated(r);
         return r;
     }
 
+    nex_mul* mk_mul(const vector<nex_pow>& v) {
+        return mk_nex<nex_mul>(rational::zero(), v);
+    }
+
     void mul_args() { }
 
     template <typename K>
@@ -136,19 +145,19 @@ public:
         CTRACE("grobner_stats_d", m_allocated.size() % 1000 == 0, tout << "m_allocated.size() = " << m_allocated.size() << "\n";);
     }
 
-    // NSB: we can use region allocation, but still need to invoke destructor 
-    // because of 'rational' (and m_children in nex_mul unless we get rid of this)
+    // the destructors are still needed because of 'rational' and m_children in nex_mul
     void pop(unsigned sz) {
         for (unsigned j = sz; j < m_allocated.size(); j++)
-            dealloc(m_allocated[j]);
+            m_allocated[j]->~nex();
         m_allocated.resize(sz);
         TRACE("grobner_stats_d", tout << "m_allocated.size() = " << m_allocated.size() << "\n";);
     }
 
     void clear() {
         for (auto e : m_allocated)
-            dealloc(e);
+            e->~nex();
         m_allocated.clear();
+        m_region.reset();
     }
 
     nex_creator() : m_mk_mul(*this) {}
@@ -170,9 +179,7 @@ public:
         void operator*=(nex const* n) { m_args.push_back(nex_pow(n, 1)); }
         bool empty() const { return m_args.empty(); }
         nex_mul* mk() {
-            auto r = alloc(nex_mul, m_coeff, m_args);
-            c.add_to_allocated(r); 
-            return r;  
+            return c.mk_nex<nex_mul>(m_coeff, m_args);
         }
         nex* mk_reduced() {
             if (m_args.empty()) return c.mk_scalar(m_coeff);
@@ -201,9 +208,7 @@ public:
     }
 
     nex_sum* mk_sum(const ptr_vector<nex>& v) {  
-        auto r = alloc(nex_sum, v);
-        add_to_allocated(r);
-        return r;
+        return mk_nex<nex_sum>(v);
     }
     
     template <typename K, typename...Args>
@@ -215,15 +220,11 @@ public:
     }
 
     nex_var* mk_var(lpvar j) {
-        auto r = alloc(nex_var, j);
-        add_to_allocated(r);
-        return r;
+        return mk_nex<nex_var>(j);
     }
     
     nex_mul* mk_mul() {
-        auto r = alloc(nex_mul);
-        add_to_allocated(r);
-        return r;
+        return mk_nex<nex_mul>();
     }
 
     template <typename K, typename...Args>
@@ -235,9 +236,7 @@ public:
     }
     
     nex_scalar* mk_scalar(const rational& v) {
-        auto r = alloc(nex_scalar, v);
-        add_to_allocated(r);
-        return r;
+        return mk_nex<nex_scalar>(v);
     }
 
     nex * mk_div(const nex& a, lpvar j);
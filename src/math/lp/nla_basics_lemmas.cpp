@@ -9,7 +9,6 @@
 
 #include "math/lp/nla_basics_lemmas.h"
 #include "math/lp/nla_core.h"
-#include "math/lp/factorization_factory_imp.h"
 namespace nla {
 
 typedef lp::lar_term term;
@@ -268,9 +267,7 @@ void basics::basic_lemma_for_mon(const monic& rm, bool derived) {
 }
 bool basics::basic_lemma_for_mon_derived(const monic& rm) {
     if (c().var_is_fixed_to_zero(var(rm))) {
-        for (auto factorization : factorization_factory_imp(rm, c())) {
-            if (factorization.is_empty())
-                continue;            
+        for (auto const& factorization : c().factorizations(rm)) {
             if (basic_lemma_for_mon_zero(rm, factorization))
                 return true;
             if (basic_lemma_for_mon_neutral_derived(rm, factorization))
@@ -278,9 +275,7 @@ bool basics::basic_lemma_for_mon_derived(const monic& rm) {
         }
     } 
     else {
-        for (auto factorization : factorization_factory_imp(rm, c())) {
-            if (factorization.is_empty())
-                continue;
+        for (auto const& factorization : c().factorizations(rm)) {
             if (basic_lemma_for_mon_non_zero_derived(rm, factorization))
                 return true;
             if (basic_lemma_for_mon_neutral_derived(rm, factorization))
@@ -477,16 +472,12 @@ void basics::basic_lemma_for_mon_zero_model_based(const monic& rm, const factori
 void basics::basic_lemma_for_mon_model_based(const monic& rm) {
     TRACE("nla_solver_bl", tout << "rm = " << pp_mon(_(), rm) << "\n";);
     if (var_val(rm).is_zero()) {
-        for (auto factorization : factorization_factory_imp(rm, c())) {
-            if (factorization.is_empty())
-                continue;
+        for (auto const& factorization : c().factorizations(rm)) {
             basic_lemma_for_mon_zero_model_based(rm, factorization);
             basic_lemma_for_mon_neutral_model_based(rm, factorization); // todo - the same call is made in the else branch
         }
     } else {
-        for (auto factorization : factorization_factory_imp(rm, c())) {
-            if (factorization.is_empty())
-                continue;
+        for (auto const& factorization : c().factorizations(rm)) {
             basic_lemma_for_mon_non_zero_model_based(rm, factorization);
             basic_lemma_for_mon_neutral_model_based(rm, factorization);
             proportion_lemma_model_based(rm, factorization) ;
@@ -618,6 +618,23 @@ bool core::find_canonical_monic_of_vars(const svector<lpvar>& vars, lpvar & i) c
     return sv && (i = sv->var(), true);
 }
 
+const vector<factorization>& core::factorizations(const monic& m) const {
+    m_factorizations.reserve(m.var() + 1);
+    cached_factorizations* c = m_factorizations[m.var()];
+    if (!c) {
+        c = alloc(cached_factorizations);
+        m_factorizations.set(m.var(), c);
+    }
+    if (c->m_version != m_emons.version()) {
+        c->m_factorizations.reset();
+        for (auto const& f : factorization_factory_imp(m, *this))
+            if (!f.is_empty())
+                c->m_factorizations.push_back(f);
+        c->m_version = m_emons.version();
+    }
+    return c->m_factorizations;
+}
+
 bool core::is_canonical_monic(lpvar j) const {
     return m_emons.is_canonical_monic(j);
 }
@@ -980,7 +997,7 @@ bool core::rm_check(const monic& rm) const {
 
     
 bool core::find_bfc_to_refine_on_monic(const monic& m, factorization & bf) {
-    for (auto f : factorization_factory_imp(m, *this)) {
+    for (auto const& f : factorizations(m)) {
         if (f.size() == 2) {
             auto a = f[0];
             auto b = f[1];
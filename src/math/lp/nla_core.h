@@ -11,6 +11,7 @@
 
 --*/
 #pragma once
+#include "util/scoped_ptr_vector.h"
 #include "math/lp/factorization.h"
 #include "math/lp/lp_types.h"
 #include "math/lp/var_eqs.h"
@@ -193,6 +194,12 @@ class core {
     svector<lpvar>           m_add_buffer;
     mutable lp::u_set        m_active_var_set;
 
+    struct cached_factorizations {
+        unsigned              m_version = UINT_MAX;   // version of m_emons when the factorizations were computed
+        vector<factorization> m_factorizations;
+    };
+    mutable scoped_ptr_vector<cached_factorizations> m_factorizations; // monic var -> its factorizations
+
     reslimit                 m_nra_lim;
 
     bool                     m_use_nra_model = false;
@@ -392,6 +399,13 @@ public:
     bool var_is_free(lpvar j) const;
         
     bool find_canonical_monic_of_vars(const svector<lpvar>& vars, lpvar & i) const;
+
+    /**
+       \brief the non-empty factorizations of m, in the order they are
+       enumerated by factorization_factory_imp. They are computed once and
+       reused until the monics or the variable equivalences change.
+    */
+    const vector<factorization>& factorizations(const monic& m) const;
     bool is_canonical_monic(lpvar) const;
     bool elists_are_consistent(bool check_in_model) const;
     bool elist_is_consistent(const std::unordered_set<lpvar>&) const;
@@ -12,7 +12,6 @@ Author:
 --*/
 #include "util/uint_set.h"
 #include "math/lp/nla_core.h"
-#include "math/lp/factorization_factory_imp.h"
 #include "math/lp/nex.h"
 #include "math/grobner/pdd_solver.h"
 #include "math/dd/pdd_interval.h"
@@ -39,8 +38,8 @@ namespace nla {
 
         lp_settings().stats().m_grobner_calls++;
         find_nl_cluster();        
-        configure();
-        m_solver.saturate();
+        if (configure())
+            m_solver.saturate();
 
         if (is_conflicting())
             return;
@@ -200,10 +199,27 @@ namespace nla {
         lemma &= ex;
     }
 
-    void grobner::configure() {
-        m_solver.reset();
+    /**
+       \brief set up the equations of the current cluster.
+
+       The basis of the previous call is kept if the variable order is the
+       same and it was saturated from a subset of the current equations:
+       its equations follow from the current ones. Only the new equations
+       are added to it then. Otherwise the basis is rebuilt, which also
+       drops the equations of constraints that were popped.
+
+       Return true if the basis has to be saturated.
+    */
+    bool grobner::configure() {
+        m_new_inputs.reset();
         try {
-            set_level2var();
+            unsigned_vector l2v;
+            get_level2var(l2v);
+            if (l2v != m_pdd_manager.get_level2var()) {
+                m_solver.reset();
+                m_inputs.reset();
+                m_pdd_manager.reset(l2v);
+            }
             TRACE("grobner",
                   tout << "base vars: ";
                   for (lpvar j : c().active_var_set())
@@ -220,9 +236,45 @@ namespace nla {
         }
         catch (...) {
             IF_VERBOSE(2, verbose_stream() << "pdd throw\n");
-            return;
+            m_solver.reset();
+            m_inputs.reset();
+            m_new_inputs.reset();
+            return false;
+        }
+
+        bool_vector is_new;
+        bool incremental = !m_inputs.empty() && extends_basis(is_new);
+        if (!incremental) {
+            m_solver.reset();
+            is_new.reset();
+            is_new.resize(m_new_inputs.size(), true);
         }
+        unsigned num_new = 0;
+        try {
+            for (unsigned i = 0; i < m_new_inputs.size(); ++i) {
+                if (!is_new[i])
+                    continue;
+                dd::pdd p = m_new_inputs[i].m_poly;
+                add_eq(p, m_new_inputs[i].m_dep);
+                ++num_new;
+            }
+        }
+        catch (...) {
+            IF_VERBOSE(2, verbose_stream() << "pdd throw\n");
+            m_inputs.reset();
+            m_new_inputs.reset();
+            return true;
+        }
+        m_inputs.swap(m_new_inputs);
+        m_new_inputs.reset();
         TRACE("grobner", m_solver.display(tout));
+
+        if (incremental) {
+            lp_settings().stats().m_grobner_reused++;
+            // the step and simplification limits apply to each call
+            m_solver.get_stats().reset();
+            return num_new > 0;
+        }
     
 #if 0
         IF_VERBOSE(2, m_pdd_grobner.display(verbose_stream()));
@@ -244,9 +296,52 @@ namespace nla {
         cfg.m_expr_size_growth = c().m_nla_settings.grobner_expr_size_growth;
         cfg.m_expr_degree_growth = c().m_nla_settings.grobner_expr_degree_growth;
         cfg.m_number_of_conflicts_to_report = c().m_nla_settings.grobner_number_of_conflicts_to_report;
+        cfg.m_threads = c().m_nla_settings.grobner_threads;
         m_solver.set(cfg);
         m_solver.adjust_cfg();
         m_pdd_manager.set_max_num_nodes(10000); // or something proportional to the number of initial nodes.
+        return true;
+    }
+
+
+    /**
+       \brief check if the equations of the basis are among the current
+       ones, and mark the current equations that are not.
+    */
+    bool grobner::extends_basis(bool_vector& is_new) {
+        u_map<unsigned_vector> poly2inputs;
+        for (unsigned i = 0; i < m_inputs.size(); ++i)
+            poly2inputs.insert_if_not_there(m_inputs[i].m_poly.index(), unsigned_vector()).push_back(i);
+        bool_vector found(m_inputs.size(), false);
+        is_new.reset();
+        for (auto const& in : m_new_inputs) {
+            bool fresh = true;
+            if (auto* e = poly2inputs.find_core(in.m_poly.index())) {
+                for (unsigned i : e->get_data().m_value) {
+                    if (!found[i] && m_inputs[i].m_cis == in.m_cis) {
+                        found[i] = true;
+                        fresh = false;
+                        break;
+                    }
+                }
+            }
+            is_new.push_back(fresh);
+        }
+        for (bool f : found)
+            if (!f)
+                return false;
+        return true;
+    }
+
+    void grobner::add_input(dd::pdd const& p, u_dependency* dep) {
+        u_dependency_manager dm;
+        vector<unsigned, false> lv;
+        dm.linearize(dep, lv);
+        unsigned_vector cis;
+        for (unsigned ci : lv)
+            cis.push_back(ci);
+        std::sort(cis.begin(), cis.end());
+        m_new_inputs.push_back({ p, dep, cis });
     }
 
     std::ostream& grobner::diagnose_pdd_miss(std::ostream& out) {
@@ -332,7 +427,7 @@ namespace nla {
         c().insert_to_active_var_set(j);
         if (c().is_monic_var(j)) {
             const monic& m = c().emons()[j];
-            for (auto fcn : factorization_factory_imp(m, m_core)) 
+            for (auto const& fcn : m_core.factorizations(m)) 
                 for (const factor& fc: fcn) 
                     q.push_back(var(fc));        
         }
@@ -464,7 +559,7 @@ namespace nla {
         for (lpvar k : c().emons()[j].vars())
             r *= pdd_expr(rational::one(), k, dep);
         r -= val_of_fixed_var_with_deps(j, dep);
-        add_eq(r, dep);
+        add_input(r, dep);
     }
 
     void grobner::add_row(const vector<lp::row_cell<rational>> & row) {
@@ -474,7 +569,7 @@ namespace nla {
         for (const auto &p : row) 
             sum += pdd_expr(p.coeff(), p.var(), dep);
         TRACE("grobner", c().print_row(row, tout) << " " << sum << "\n");
-        add_eq(sum, dep);
+        add_input(sum, dep);
     }
 
 
@@ -512,7 +607,7 @@ namespace nla {
             c().print_row(r, out) << std::endl;
     }
     
-    void grobner::set_level2var() {
+    void grobner::get_level2var(unsigned_vector& l2v) {
         unsigned n = m_lar_solver.column_count();
         unsigned_vector sorted_vars(n), weighted_vars(n);
         for (unsigned j = 0; j < n; j++) {
@@ -535,11 +630,9 @@ namespace nla {
             unsigned wb = weighted_vars[b];
             return wa < wb || (wa == wb && a < b); });
 
-        unsigned_vector l2v(n);
+        l2v.reset();
         for (unsigned j = 0; j < n; j++)
-            l2v[j] = sorted_vars[j];
-
-        m_pdd_manager.reset(l2v);
+            l2v.push_back(sorted_vars[j]);
 
         TRACE("grobner",
             for (auto v : sorted_vars)
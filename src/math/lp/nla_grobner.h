@@ -19,10 +19,18 @@ namespace nla {
     class core;
 
     class grobner : common {
+        struct input {
+            dd::pdd         m_poly;
+            u_dependency*   m_dep;
+            unsigned_vector m_cis;   // sorted constraints of m_dep
+        };
+
         dd::pdd_manager          m_pdd_manager;
         dd::solver               m_solver;
         lp::lar_solver&          m_lar_solver;
         lp::u_set                m_rows;
+        vector<input>            m_inputs;      // equations the basis in m_solver was saturated from
+        vector<input>            m_new_inputs;  // equations of the current call
 
         lp::lp_settings& lp_settings();
 
@@ -42,8 +50,10 @@ namespace nla {
         void add_dependencies(new_lemma& lemma, const dd::solver::equation& eq);
 
         // setup
-        void configure();
-        void set_level2var();
+        bool configure();
+        bool extends_basis(bool_vector& is_new);
+        void get_level2var(unsigned_vector& l2v);
+        void add_input(dd::pdd const& p, u_dependency* dep);
         void find_nl_cluster();
         void prepare_rows_and_active_vars();
         void add_var_and_its_factors_to_q_and_collect_new_rows(lpvar j, svector<lpvar>& q);           
@@ -9,7 +9,6 @@
 #include "math/lp/nla_order_lemmas.h"
 #include "math/lp/nla_core.h"
 #include "math/lp/nla_common.h"
-#include "math/lp/factorization_factory_imp.h"
 
 namespace nla {
 
@@ -40,7 +39,7 @@ void order::order_lemma() {
 void order::order_lemma_on_monic(const monic& m) {
     TRACE("nla_solver_details",
           tout << "m = " << pp_mon(c(), m););
-    for (auto ac : factorization_factory_imp(m, _())) {
+    for (auto const& ac : _().factorizations(m)) {
         if (ac.size() != 2)
             continue;
         if (ac.is_mon())
@@ -25,6 +25,13 @@ struct solver::imp {
     u_map<polynomial::var>    m_lp2nl;  // map from lar_solver variables to nlsat::solver variables        
     lp::u_set                 m_term_set;
     scoped_ptr<nlsat::solver> m_nlsat;
+    // definitions asserted to m_nlsat by check(). The solver is reused for the next
+    // check as long as these definitions still hold in the lar_solver.
+    bool                      m_incremental = false;
+    u_map<svector<lp::lpvar>> m_monic_defs;    // monic variable -> its factors
+    u_map<vector<std::pair<rational, lp::lpvar>>> m_term_defs; // term column -> coefficients
+    bool_vector               m_is_int;        // integrality of mapped variables, by nlsat variable
+    u_map<unsigned>           m_lit2constraint; // assumption literal -> constraint index
     scoped_ptr<scoped_anum>   m_zero;
     mutable variable_map_type m_variable_values; // current model        
     nla::core&                m_nla_core;    
@@ -50,32 +57,87 @@ struct solver::imp {
        TBD: use partial model from lra_solver to prime the state of nlsat_solver.
        TBD: explore more incremental ways of applying nlsat (using assumptions)
     */
-    lbool check() {        
-        SASSERT(need_check());
+    void reset_nlsat(bool incremental) {
         m_zero = nullptr;
-        m_nlsat = alloc(nlsat::solver, m_limit, m_params, false);
+        m_nlsat = alloc(nlsat::solver, m_limit, m_params, incremental);
         m_zero = alloc(scoped_anum, am());
         m_term_set.clear();
         m_lp2nl.reset();
+        m_incremental = incremental;
+        m_monic_defs.reset();
+        m_term_defs.reset();
+        m_is_int.reset();
+    }
+
+    static bool same_term(lp::lar_term const& t, vector<std::pair<rational, lp::lpvar>> const& def) {
+        if (t.size() != def.size())
+            return false;
+        rational c;
+        for (auto const& [coeff, j] : def)
+            if (!t.coeffs<u_map<rational>>().find(j, c) || c != coeff)
+                return false;
+        return true;
+    }
+
+    /**
+       \brief check if the definitions asserted to m_nlsat still hold.
+       Scopes of the lar_solver and emonics may have been popped since the
+       last check, and their columns reused for other monics or terms.
+    */
+    bool definitions_hold() {
+        if (!m_nlsat || !m_incremental)
+            return false;
+        for (auto const& [v, w] : m_lp2nl) 
+            if (v >= s.number_of_vars() || is_int(v) != m_is_int.get(w, false))
+                return false;
+        auto const& emons = m_nla_core.emons();
+        for (auto const& [v, vars] : m_monic_defs) 
+            if (!emons.is_monic_var(v) || emons[v].vars() != vars)
+                return false;
+        for (auto const& [j, def] : m_term_defs) 
+            if (!s.column_corresponds_to_term(j) || 
+                !same_term(s.get_term(lp::tv::raw(s.column_to_reported_index(j))), def))
+                return false;
+        return true;
+    }
+
+    lbool check() {        
+        SASSERT(need_check());
+        // Monic and term definitions are asserted as clauses to a solver that
+        // is kept between checks, so clauses learned from the definitions
+        // alone are reused. The linear constraints of the lar_solver change
+        // between checks and are passed as assumptions.
+        if (definitions_hold()) 
+            m_nlsat->updt_params(m_params);
+        else
+            reset_nlsat(true);
         vector<nlsat::assumption, false> core;
 
         // add linear inequalities from lra_solver
+        nlsat::literal_vector asms;
+        m_lit2constraint.reset();
         for (lp::constraint_index ci : s.constraints().indices()) {
-            add_constraint(ci);
+            nlsat::literal lit = mk_constraint_literal(ci);
+            asms.push_back(lit);
+            m_lit2constraint.insert_if_not_there(lit.index(), ci);
         }
 
-        // add polynomial definitions.
+        // add new polynomial definitions.
         for (auto const& m : m_nla_core.emons()) 
-             add_monic_eq(m);
+            if (!m_monic_defs.contains(m.var()))
+                add_monic_eq(m);
         for (unsigned i : m_term_set) 
-            add_term(i);
+            if (!m_term_defs.contains(i))
+                add_term(i);
         // TBD: add variable bounds?
 
         lbool r = l_undef;
         try {
-            r = m_nlsat->check(); 
+            r = m_nlsat->check(asms); 
         }
         catch (z3_exception&) {
+            // the solver may still hold the assumptions of the interrupted check.
+            m_incremental = false;
             if (m_limit.is_canceled()) {
                 r = l_undef;
             }
@@ -95,9 +157,8 @@ struct solver::imp {
             break;
         case l_false: {
             lp::explanation ex;
-            m_nlsat->get_core(core);
-            for (auto c : core) {
-                unsigned idx = static_cast<unsigned>(static_cast<imp*>(c) - this);
+            for (nlsat::literal lit : asms) {
+                unsigned idx = m_lit2constraint[lit.index()];
                 ex.push_back(idx);
                 TRACE("arith", tout << "ex: " << idx << "\n";);
             }
@@ -113,6 +174,7 @@ struct solver::imp {
     }                
 
     void add_monic_eq(mon_eq const& m) {
+        m_monic_defs.insert(m.var(), m.vars());
         polynomial::manager& pm = m_nlsat->pm();
         svector<polynomial::var> vars;
         for (auto v : m.vars()) {
@@ -131,7 +193,7 @@ struct solver::imp {
         m_nlsat->mk_clause(1, &lit, nullptr);
     }
 
-    void add_constraint(unsigned idx) {
+    nlsat::literal mk_constraint_literal(unsigned idx) {
         auto& c = s.constraints()[idx];
         auto& pm = m_nlsat->pm();
         auto k = c.kind();
@@ -153,7 +215,6 @@ struct solver::imp {
         polynomial::polynomial* ps[1] = { p };
         bool is_even[1] = { false };
         nlsat::literal lit;
-        nlsat::assumption a = this + idx;
         switch (k) {
         case lp::lconstraint_kind::LE:
             lit = ~m_nlsat->mk_ineq_literal(nlsat::atom::kind::GT, 1, ps, is_even);
@@ -173,16 +234,12 @@ struct solver::imp {
         default:
             lp_assert(false); // unreachable
         }
-        m_nlsat->mk_clause(1, &lit, a);
+        return lit;
     }
 
 
     lbool check(vector<dd::pdd> const& eqs) {
-        m_zero = nullptr;
-        m_nlsat = alloc(nlsat::solver, m_limit, m_params, false);
-        m_zero = alloc(scoped_anum, am());
-        m_lp2nl.reset();
-        m_term_set.clear();
+        reset_nlsat(false);
         for (auto const& eq : eqs)
             add_eq(eq);
         for (auto const& [v, w] : m_lp2nl) {
@@ -282,6 +339,7 @@ struct solver::imp {
         if (!m_lp2nl.find(v, r)) {
             r = m_nlsat->mk_var(is_int(v));
             m_lp2nl.insert(v, r);
+            m_is_int.setx(r, is_int(v), false);
             if (!m_term_set.contains(v) && s.column_corresponds_to_term(v)) {
                 if (v >= m_term_set.data_size())
                     m_term_set.resize(v + 1);
@@ -294,6 +352,7 @@ struct solver::imp {
     void add_term(unsigned term_column) {
         lp::tv ti = lp::tv::raw(s.column_to_reported_index(term_column));
         const lp::lar_term& t = s.get_term(ti); 
+        m_term_defs.insert(term_column, t.coeffs_as_vector());
         //  code that creates a polynomial equality between the linear coefficients and
         // variable representing the term.
         svector<polynomial::var> vars;
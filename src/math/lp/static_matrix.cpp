@@ -31,6 +31,8 @@ Revision History:
 namespace lp {
 template void static_matrix<double, double>::add_columns_at_the_end(unsigned int);
 template void static_matrix<double, double>::clear();
+template void static_matrix<double, double>::add_new_element(unsigned int, unsigned int, double const&);
+template void static_matrix<double, double>::remove_element(vector<row_cell<double>>&, row_cell<double>&);
 #ifdef Z3DEBUG
 template bool static_matrix<double, double>::is_correct() const;
 #endif
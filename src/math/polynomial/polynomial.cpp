@@ -2753,6 +2753,13 @@ namespace polynomial {
         }
 
         polynomial * mul(polynomial const * p1, polynomial const * p2) {
+            if (is_zero(p1) || is_zero(p2))
+                return mk_zero();
+            if (static_cast<uint64_t>(p1->size()) * p2->size() >= 64) {
+                polynomial * r = kronecker_mul(p1, p2);
+                if (r)
+                    return r;
+            }
             numeral zero(0);
             return muladd(p1, p2, zero);
         }
@@ -3296,6 +3303,168 @@ namespace polynomial {
             });
         }
 
+        /**
+           \brief Kronecker substitution for products.
+           Each variable x of p1*p2 is assigned the radix deg(p1, x) + deg(p2, x) + 1.
+           A monomial is then encoded as a number in the mixed radix system, 
+           and the code of m1*m2 is the sum of the codes of m1 and m2.
+           
+           Store the variables in increasing order in xs and their weights in ws.
+           Return false if the codes do not fit in 64 bits.
+        */
+        bool kronecker_weights(polynomial const * p1, polynomial const * p2, power_buffer & xs, svector<uint64_t> & ws, uint64_t & range) {
+            power_buffer d2;
+            var_degrees<true>(p1, xs);
+            var_degrees<true>(p2, d2);
+            unsigned_vector & var2pos = m_var_degrees_tmp;
+            for (unsigned i = 0; i < xs.size(); i++) 
+                var2pos[xs[i].get_var()] = i;
+            for (power const & pw : d2) {
+                unsigned pos = var2pos[pw.get_var()];
+                if (pos == UINT_MAX) 
+                    xs.push_back(pw);
+                else 
+                    xs[pos].degree() += pw.degree();
+            }
+            for (power const & pw : xs) 
+                var2pos[pw.get_var()] = UINT_MAX;
+            std::sort(xs.begin(), xs.end(), power::lt_var());
+            ws.reset();
+            range = 1;
+            for (power const & pw : xs) {
+                uint64_t radix = static_cast<uint64_t>(pw.degree()) + 1;
+                ws.push_back(range);
+                if (range > std::numeric_limits<uint64_t>::max() / radix)
+                    return false;
+                range *= radix;
+            }
+            return true;
+        }
+
+        void kronecker_encode(polynomial const * p, power_buffer const & xs, svector<uint64_t> const & ws, svector<uint64_t> & codes) {
+            unsigned_vector & var2pos = m_var_degrees_tmp;
+            for (unsigned i = 0; i < xs.size(); i++) 
+                var2pos[xs[i].get_var()] = i;
+            codes.reset();
+            for (unsigned i = 0; i < p->size(); i++) {
+                monomial * m = p->m(i);
+                uint64_t code = 0;
+                for (unsigned j = 0; j < m->size(); j++) 
+                    code += m->degree(j) * ws[var2pos[m->get_var(j)]];
+                codes.push_back(code);
+            }
+            for (power const & pw : xs) 
+                var2pos[pw.get_var()] = UINT_MAX;
+        }
+
+        monomial * kronecker_decode(uint64_t code, power_buffer const & xs, svector<uint64_t> const & ws) {
+            power_buffer pws;
+            for (unsigned i = xs.size(); i-- > 0; ) {
+                uint64_t k = code / ws[i];
+                code %= ws[i];
+                if (k > 0)
+                    pws.push_back(power(xs[i].get_var(), static_cast<unsigned>(k)));
+            }
+            if (pws.empty())
+                return mk_unit();
+            std::reverse(pws.begin(), pws.end());
+            return mk_monomial(pws.size(), pws.data());
+        }
+
+        /**
+           \brief Return p1*p2 using Kronecker substitution, or nullptr if the codes 
+           of the monomials do not fit in 64 bits.
+
+           When the range of codes is small compared to the number of products, the 
+           coefficients are accumulated in a dense array indexed by codes. Otherwise, 
+           the products are enumerated in increasing order of codes using a heap 
+           with one entry per monomial of the smaller polynomial.
+           Neither method creates monomials for the intermediate products.
+        */
+        polynomial * kronecker_mul(polynomial const * p1, polynomial const * p2) {
+            if (p1->size() > p2->size())
+                std::swap(p1, p2);
+            power_buffer xs;
+            svector<uint64_t> ws, c1, c2;
+            uint64_t range;
+            if (!kronecker_weights(p1, p2, xs, ws, range))
+                return nullptr;
+            kronecker_encode(p1, xs, ws, c1);
+            kronecker_encode(p2, xs, ws, c2);
+            unsigned sz1 = p1->size(), sz2 = p2->size();
+            scoped_numeral_vector as(m_manager);
+            svector<uint64_t> codes;
+            if (range <= (1u << 20) && range <= 4 * static_cast<uint64_t>(sz1) * sz2) {
+                scoped_numeral_vector dense(m_manager);
+                dense.resize(static_cast<unsigned>(range));
+                for (unsigned i = 0; i < sz1; i++) {
+                    checkpoint();
+                    for (unsigned j = 0; j < sz2; j++) {
+                        numeral & c = dense[static_cast<unsigned>(c1[i] + c2[j])];
+                        m_manager.addmul(c, p1->a(i), p2->a(j), c);
+                    }
+                }
+                for (unsigned k = 0; k < dense.size(); k++) {
+                    if (m_manager.is_zero(dense[k]))
+                        continue;
+                    as.push_back(numeral());
+                    swap(as.back(), dense[k]);
+                    codes.push_back(k);
+                }
+            }
+            else {
+                // sort p2 by codes, the heap then only needs to advance each row
+                unsigned_vector perm;
+                for (unsigned j = 0; j < sz2; j++) 
+                    perm.push_back(j);
+                std::sort(perm.begin(), perm.end(), [&](unsigned a, unsigned b) { return c2[a] < c2[b]; });
+                struct entry {
+                    uint64_t m_code;
+                    unsigned m_i, m_j;
+                };
+                auto gt = [](entry const & a, entry const & b) { return a.m_code > b.m_code; };
+                svector<entry> heap;
+                for (unsigned i = 0; i < sz1; i++) 
+                    heap.push_back({ c1[i] + c2[perm[0]], i, 0 });
+                std::make_heap(heap.begin(), heap.end(), gt);
+                scoped_numeral c(m_manager);
+                uint64_t code = 0;
+                unsigned num_products = 0;
+                while (!heap.empty()) {
+                    if (++num_products % sz1 == 0)
+                        checkpoint();
+                    std::pop_heap(heap.begin(), heap.end(), gt);
+                    entry e = heap.back();
+                    heap.pop_back();
+                    if (e.m_code != code) {
+                        if (!m_manager.is_zero(c)) {
+                            as.push_back(numeral());
+                            swap(as.back(), c.get());
+                            codes.push_back(code);
+                        }
+                        code = e.m_code;
+                    }
+                    m_manager.addmul(c, p1->a(e.m_i), p2->a(perm[e.m_j]), c.get());
+                    if (e.m_j + 1 < sz2) {
+                        heap.push_back({ c1[e.m_i] + c2[perm[e.m_j + 1]], e.m_i, e.m_j + 1 });
+                        std::push_heap(heap.begin(), heap.end(), gt);
+                    }
+                }
+                if (!m_manager.is_zero(c)) {
+                    as.push_back(numeral());
+                    swap(as.back(), c.get());
+                    codes.push_back(code);
+                }
+            }
+            monomial_vector ms;
+            for (uint64_t code : codes) {
+                monomial * m = kronecker_decode(code, xs, ws);
+                inc_ref(m);
+                ms.push_back(m);
+            }
+            return mk_polynomial_core(as.size(), as.data(), ms.data());
+        }
+
         void var_max_degrees(polynomial const * p, power_buffer & pws) {
             var_degrees<true>(p, pws);
         }
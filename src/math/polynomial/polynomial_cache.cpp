@@ -85,8 +85,16 @@ namespace polynomial {
     typedef chashtable<psc_chain_entry*, psc_chain_entry::hash_proc, psc_chain_entry::eq_proc> psc_chain_cache;
     typedef chashtable<factor_entry*, factor_entry::hash_proc, factor_entry::eq_proc> factor_cache;
     
+    struct cache_stats {
+        unsigned m_psc_hits = 0;
+        unsigned m_psc_misses = 0;
+        unsigned m_factor_hits = 0;
+        unsigned m_factor_misses = 0;
+    };
+
     struct cache::imp { 
         manager &                m;
+        cache_stats              m_stats;
         polynomial_table         m_poly_table;
         psc_chain_cache          m_psc_chain_cache;
         factor_cache             m_factor_cache;
@@ -155,6 +163,7 @@ namespace polynomial {
             psc_chain_entry * entry = new (m_allocator.allocate(sizeof(psc_chain_entry))) psc_chain_entry(p, q, x, h);
             psc_chain_entry * old_entry = m_psc_chain_cache.insert_if_not_there(entry); 
             if (entry != old_entry) {
+                ++m_stats.m_psc_hits;
                 entry->~psc_chain_entry();
                 m_allocator.deallocate(sizeof(psc_chain_entry), entry);
                 S.reset();
@@ -163,6 +172,7 @@ namespace polynomial {
                 }
             }
             else {
+                ++m_stats.m_psc_misses;
                 m.psc_chain(p, q, x, S);
                 unsigned sz = S.size();
                 entry->m_result_sz = sz;
@@ -182,6 +192,7 @@ namespace polynomial {
             factor_entry * entry = new (m_allocator.allocate(sizeof(factor_entry))) factor_entry(p, h);
             factor_entry * old_entry = m_factor_cache.insert_if_not_there(entry); 
             if (entry != old_entry) {
+                ++m_stats.m_factor_hits;
                 entry->~factor_entry();
                 m_allocator.deallocate(sizeof(factor_entry), entry);
                 distinct_factors.reset();
@@ -190,6 +201,7 @@ namespace polynomial {
                 }
             }
             else {
+                ++m_stats.m_factor_misses;
                 factors fs(m);
                 m.factor(p, fs);
                 unsigned sz = fs.distinct_factors();
@@ -230,7 +242,16 @@ namespace polynomial {
     
     void cache::reset() {
         manager & _m = m();
+        cache_stats st = m_imp->m_stats;
         dealloc(m_imp);
         m_imp = alloc(imp, _m);
+        m_imp->m_stats = st;
+    }
+
+    void cache::collect_statistics(statistics & st) const {
+        st.update("polynomial psc cache hits", m_imp->m_stats.m_psc_hits);
+        st.update("polynomial psc cache misses", m_imp->m_stats.m_psc_misses);
+        st.update("polynomial factor cache hits", m_imp->m_stats.m_factor_hits);
+        st.update("polynomial factor cache misses", m_imp->m_stats.m_factor_misses);
     }
 };
@@ -19,6 +19,7 @@ Notes:
 #pragma once
 
 #include "math/polynomial/polynomial.h"
+#include "util/statistics.h"
 
 namespace polynomial {
 
@@ -36,7 +37,11 @@ namespace polynomial {
         polynomial * mk_unique(polynomial * p);
         void psc_chain(polynomial const * p, polynomial const * q, var x, polynomial_ref_vector & S);
         void factor(polynomial const * p, polynomial_ref_vector & distinct_factors);
+        /**
+           \brief reset the cache. The statistics are kept.
+        */
         void reset();
+        void collect_statistics(statistics & st) const;
     };
 };
 
@@ -5691,17 +5691,39 @@ namespace realclosure {
                 else
                     return qm().lt(to_mpq(a), to_mpq(b)) ? -1 : 1;
             }
+            else if (a == b) 
+                return 0;
             else {
-                // FUTURE: try to refine interval before switching to sub+sign approach
+                int r = compare_approx(a, b);
+                if (r != 0)
+                    return r;
+                value_ref diff(*this);
+                sub(a, b, diff);
+                return sign(diff);
+            }
+        }
+
+        /**
+           \brief Try to separate the intervals of a and b by refining them, doubling the 
+           precision up to m_max_precision. The refined intervals are stored in a and b, 
+           so later comparisons involving them start from the better approximations.
+
+           Return 0 if the intervals still overlap, or a value depends on infinitesimals
+           and cannot be refined.
+        */
+        int compare_approx(value * a, value * b) {
+            unsigned prec = std::max(m_ini_precision, 1u);
+            while (true) {
                 if (bqim().before(interval(a), interval(b)))
                     return -1;
-                else if (bqim().before(interval(b), interval(a)))
+                if (bqim().before(interval(b), interval(a)))
                     return 1;
-                else {
-                    value_ref diff(*this);
-                    sub(a, b, diff);
-                    return sign(diff);
-                }
+                if (prec > m_max_precision)
+                    return 0;
+                checkpoint();
+                if (!refine_interval(a, prec) || !refine_interval(b, prec))
+                    return 0;
+                prec = prec == m_max_precision ? prec + 1 : std::min(2 * prec, m_max_precision);
             }
         }
 
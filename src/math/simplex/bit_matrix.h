@@ -52,6 +52,7 @@ public:
         void set(unsigned i) { SASSERT((i >> 6) < m.m_num_chunks); r[i >> 6] |= (1ull << (i & 63)); }
         void unset(unsigned i) { SASSERT((i >> 6) < m.m_num_chunks); r[i >> 6] &= ~(1ull << (i & 63)); }
         row& operator+=(row const& other);
+        uint64_t* data() const { return r; }
 
         // using pointer equality:
         bool operator==(row const& other) const { return r == other.r; }
@@ -98,6 +99,10 @@ public:
     row_iterator end() { return row_iterator(*this, false); }
                 
     row add_row();
+    row get_row(unsigned i) { return row(*this, m_rows[i]); }
+    unsigned num_rows() const { return m_rows.size(); }
+    unsigned num_columns() const { return m_num_columns; }
+    unsigned num_chunks() const { return m_num_chunks; }
     void solve();
     std::ostream& display(std::ostream& out);
 
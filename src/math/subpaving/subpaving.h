@@ -107,6 +107,12 @@ public:
 
     virtual void operator()() = 0;
 
+    /**
+       \brief Return true if operator() showed that the constraints are
+       infeasible: every leaf of the paving tree is inconsistent.
+    */
+    virtual bool is_infeasible() const = 0;
+
     virtual void display_bounds(std::ostream & out) const = 0;
 };
 
@@ -819,6 +819,12 @@ public:
        \brief Store in the given vector all leaves of the paving tree.
     */
     void collect_leaves(ptr_vector<node> & leaves) const;
+
+    /**
+       \brief Return true if the paving tree has been built and all its
+       leaves are inconsistent, that is, the constraints are infeasible.
+    */
+    bool is_infeasible() const;
     
     /**
        \brief Display constraints asserted in the subpaving.
@@ -1038,6 +1038,15 @@ void context_t<C>::rebuild_leaf_dlist(node * n) {
     }
 }
 
+template<typename C>
+bool context_t<C>::is_infeasible() const {
+    if (m_root == nullptr)
+        return false;
+    ptr_vector<node> leaves;
+    collect_leaves(leaves);
+    return leaves.empty();
+}
+
 template<typename C>
 void context_t<C>::remove_from_leaf_dlist(node * n) {
     node * prev = n->prev();
@@ -7,7 +7,9 @@ Module Name:
 
 Abstract:
 
-    "Fake" tactic used to test subpaving module.
+    "Fake" tactic used to test subpaving module, and interval
+    constraint propagation with double precision intervals that
+    discharges infeasible nonlinear arithmetic goals.
 
 Author:
 
@@ -187,6 +189,31 @@ class subpaving_tactic : public tactic {
             }
         }
 
+        /**
+           \brief Build the paving tree of the formulas of g that can be
+           internalized and return true if it shows them infeasible.
+           The other formulas are ignored, so the subpaving is a relaxation
+           of g and an infeasible subpaving implies that g is unsatisfiable.
+        */
+        bool is_infeasible(goal const & g) {
+            for (unsigned i = 0; i < g.size(); i++) {
+                try {
+                    process_clause(g.form(i));
+                }
+                catch (const tactic_exception &) {
+                }
+                catch (const subpaving::exception &) {
+                }
+            }
+            try {
+                (*m_ctx)();
+            }
+            catch (const subpaving::exception &) {
+                return false;
+            }
+            return m_ctx->is_infeasible();
+        }
+
         void process(goal const & g) {
             internalize(g);
             m_proc = alloc(display_var_proc, m_e2v);
@@ -208,26 +235,64 @@ class subpaving_tactic : public tactic {
     imp *       m_imp;
     params_ref  m_params;
     statistics  m_stats;
+    tactic_ref  m_simp;      // put the goal in the form expected by the subpaving module, only used by icp
+    unsigned    m_num_infeasible = 0;
+
+    /**
+       \brief Interval constraint propagation on a copy of the goal.
+       The goal is replaced by false if the subpaving shows it infeasible,
+       and is left unchanged otherwise.
+    */
+    void icp(goal_ref const & in, goal_ref_buffer & result) {
+        result.reset();
+        result.push_back(in.get());
+        if (in->inconsistent() || in->proofs_enabled() || in->unsat_core_enabled())
+            return;
+        goal_ref g = alloc(goal, *in);
+        goal_ref_buffer simp;
+        try {
+            (*m_simp)(g, simp);
+        }
+        catch (const tactic_exception &) {
+            return;
+        }
+        if (simp.size() != 1)
+            return;
+        cleanup();
+        bool infeasible = simp[0]->inconsistent() || m_imp->is_infeasible(*simp[0]);
+        m_imp->collect_statistics(m_stats);
+        if (!infeasible)
+            return;
+        TRACE("subpaving_tactic", tout << "infeasible goal\n"; in->display(tout););
+        m_num_infeasible++;
+        m_stats.update("icp infeasible", m_num_infeasible);
+        in->reset();
+        in->assert_expr(in->m().mk_false());
+    }
+
 public:
 
-    subpaving_tactic(ast_manager & m, params_ref const & p):
+    subpaving_tactic(ast_manager & m, params_ref const & p, tactic * simp = nullptr):
         m_imp(alloc(imp, m, p)),
-        m_params(p) {
+        m_params(p),
+        m_simp(simp) {
     }
 
     ~subpaving_tactic() override {
         dealloc(m_imp);
     }
 
-    char const* name() const override { return "subpaving"; }
+    char const* name() const override { return m_simp ? "icp" : "subpaving"; }
 
     tactic * translate(ast_manager & m) override {
-        return alloc(subpaving_tactic, m, m_params);
+        return alloc(subpaving_tactic, m, m_params, m_simp ? m_simp->translate(m) : nullptr);
     }
 
     void updt_params(params_ref const & p) override {
         m_params.append(p);
         m_imp->updt_params(m_params);
+        if (m_simp)
+            m_simp->updt_params(p);
     }
 
     void collect_param_descrs(param_descrs & r) override {
@@ -240,10 +305,15 @@ public:
 
     void reset_statistics() override {
         m_stats.reset();
+        m_num_infeasible = 0;
     }
 
     void operator()(goal_ref const & in, 
                     goal_ref_buffer & result) override {
+        if (m_simp) {
+            icp(in, result);
+            return;
+        }
         try {
             m_imp->process(*in);
             m_imp->collect_statistics(m_stats);
@@ -269,7 +339,7 @@ tactic * mk_subpaving_tactic_core(ast_manager & m, params_ref const & p) {
     return alloc(subpaving_tactic, m, p);
 }
 
-tactic * mk_subpaving_tactic(ast_manager & m, params_ref const & p) {
+static tactic * mk_subpaving_simplifier(ast_manager & m, params_ref const & p) {
     params_ref simp_p  = p;
     simp_p.set_bool("arith_lhs", true);
     simp_p.set_bool("expand_power", true);
@@ -285,8 +355,19 @@ tactic * mk_subpaving_tactic(ast_manager & m, params_ref const & p) {
     return and_then(using_params(mk_simplify_tactic(m, p),
                                  simp_p),
                     using_params(mk_simplify_tactic(m, p),
-                                 simp2_p),
+                                 simp2_p));
+}
+
+tactic * mk_subpaving_tactic(ast_manager & m, params_ref const & p) {
+    return and_then(mk_subpaving_simplifier(m, p),
                     mk_subpaving_tactic_core(m, p));
 }
 
+tactic * mk_icp_tactic(ast_manager & m, params_ref const & p) {
+    params_ref icp_p = p;
+    icp_p.set_sym("numeral", symbol("hwf"));
+    icp_p.set_uint("max_nodes", p.get_uint("max_nodes", 256));
+    return alloc(subpaving_tactic, m, icp_p, mk_subpaving_simplifier(m, p));
+}
+
 
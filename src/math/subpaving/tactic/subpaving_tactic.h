@@ -7,7 +7,8 @@ Module Name:
 
 Abstract:
 
-    "Fake" tactic used to test subpaving module.
+    "Fake" tactic used to test subpaving module, and interval
+    constraint propagation pre-solver for nonlinear arithmetic.
 
 Author:
 
@@ -23,7 +24,9 @@ class ast_manager;
 class tactic;
 
 tactic * mk_subpaving_tactic(ast_manager & m, params_ref const & p = params_ref());
+tactic * mk_icp_tactic(ast_manager & m, params_ref const & p = params_ref());
 /*
   ADD_TACTIC("subpaving", "tactic for testing subpaving module.", "mk_subpaving_tactic(m, p)")
+  ADD_TACTIC("icp", "replace nonlinear arithmetic goals that interval constraint propagation shows infeasible by false.", "mk_icp_tactic(m, p)")
 */
 
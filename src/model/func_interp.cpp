@@ -175,7 +175,44 @@ bool func_interp::is_constant() const {
    If such entry does not exist then return 0, and store set
    args_are_values to true if for all entries e e.args_are_values() is true.
 */
+bool func_interp::has_unique_args(expr * const * args) const {
+    for (unsigned i = 0; i < m_arity; ++i)
+        if (!m().is_unique_value(args[i]))
+            return false;
+    return true;
+}
+
+void func_interp::index_entry(func_entry * e) const {
+    if (has_unique_args(e->get_args()))
+        m_index->insert(entry_key{ e->get_args(), m_arity }, e);
+    else
+        ++m_num_unindexed;
+}
+
+void func_interp::init_index() const {
+    m_index = alloc(entry_index);
+    m_num_unindexed = 0;
+    for (func_entry * curr : m_entries)
+        index_entry(curr);
+}
+
+bool func_interp::has_no_entry(expr * const * args) const {
+    if (!m_index && m_entries.size() >= index_threshold)
+        init_index();
+    return m_index && m_num_unindexed == 0 && has_unique_args(args) && !m_index->contains(entry_key{ args, m_arity });
+}
+
 func_entry * func_interp::get_entry(expr * const * args) const {
+    if (!m_index && m_entries.size() >= index_threshold)
+        init_index();
+    if (m_index && has_unique_args(args)) {
+        // unique values are equal only if they are the same term
+        func_entry * e = nullptr;
+        if (m_index->find(entry_key{ args, m_arity }, e))
+            return e;
+        if (m_num_unindexed == 0)
+            return nullptr;
+    }
     for (func_entry* curr : m_entries) {
         if (curr->eq_args(m(), m_arity, args))
             return curr;
@@ -213,9 +250,12 @@ void func_interp::insert_new_entry(expr * const * args, expr * r) {
     if (!new_entry->args_are_values())
         m_args_are_values = false;
     m_entries.push_back(new_entry);
+    if (m_index)
+        index_entry(new_entry);
 }
 
 void func_interp::del_entry(unsigned idx) {
+    m_index = nullptr;
     auto* e = m_entries[idx];
     m_entries[idx] = m_entries.back();
     m_entries.pop_back();
@@ -260,6 +300,7 @@ expr * func_interp::get_max_occ_result() const {
 void func_interp::compress() {
     if (m_else == nullptr || m_entries.empty())
         return; // nothing to be done
+    m_index = nullptr;
     if (!is_ground(m_else))
         return; // forall entries e in m_entries e.get_result() is ground
     unsigned j = 0;
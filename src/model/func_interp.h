@@ -31,6 +31,8 @@ Revision History:
 
 #include "ast/ast.h"
 #include "ast/ast_translation.h"
+#include "util/map.h"
+#include "util/util.h"
 
 class func_interp;
 
@@ -64,9 +66,37 @@ public:
 };
 
 class func_interp {
+    // the arguments of an entry, or of a lookup
+    struct entry_key {
+        expr * const * m_args;
+        unsigned       m_arity;
+    };
+    struct entry_key_hash {
+        unsigned operator()(entry_key const & k) const {
+            unsigned h = k.m_arity;
+            for (unsigned i = 0; i < k.m_arity; ++i)
+                h = combine_hash(h, k.m_args[i]->get_id());
+            return h;
+        }
+    };
+    struct entry_key_eq {
+        bool operator()(entry_key const & a, entry_key const & b) const {
+            for (unsigned i = 0; i < a.m_arity; ++i)
+                if (a.m_args[i] != b.m_args[i])
+                    return false;
+            return true;
+        }
+    };
+    typedef map<entry_key, func_entry *, entry_key_hash, entry_key_eq> entry_index;
+    static const unsigned  index_threshold = 16;  // min. number of entries for creating m_index
+
     ast_manager &          m_manager;
     unsigned               m_arity;
     ptr_vector<func_entry> m_entries;
+    // Index of the entries whose arguments are unique values. It is
+    // created by the first lookup in a large interpretation.
+    mutable scoped_ptr<entry_index> m_index;
+    mutable unsigned       m_num_unindexed = 0;  // entries that are not in m_index
     expr *                 m_else;
     bool                   m_args_are_values; //!< true if forall e in m_entries e.args_are_values() == true
 
@@ -76,6 +106,10 @@ class func_interp {
 
     void reset_interp_cache();
 
+    bool has_unique_args(expr * const * args) const;
+    void init_index() const;
+    void index_entry(func_entry * e) const;
+
     expr * get_interp_core() const;
 
     expr_ref get_array_interp_core(func_decl * f) const;
@@ -103,6 +137,11 @@ public:
     void insert_entry(expr * const * args, expr * r);
     void insert_new_entry(expr * const * args, expr * r);
     func_entry * get_entry(expr * const * args) const;
+    /**
+       \brief return true if the index of the entries shows that no entry
+       matches args. A false result means that args may have an entry.
+    */
+    bool has_no_entry(expr * const * args) const;
     bool eval_else(expr * const * args, expr_ref & result) const;
     unsigned num_entries() const { return m_entries.size(); }
     ptr_vector<func_entry>::const_iterator begin() const { return m_entries.begin(); }
@@ -0,0 +1,378 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    model_batch_evaluator.cpp
+
+Abstract:
+
+    Evaluation of one expression in many models.
+
+--*/
+
+#include "model/model_batch_evaluator.h"
+
+static inline uint64_t mask_of(unsigned sz) {
+    return sz >= 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << sz) - 1;
+}
+
+static inline int64_t sext(uint64_t v, unsigned sz) {
+    if (sz >= 64)
+        return static_cast<int64_t>(v);
+    return static_cast<int64_t>(v << (64 - sz)) >> (64 - sz);
+}
+
+model_batch_evaluator::model_batch_evaluator(ast_manager& m, expr* e):
+    m(m), a(m), bv(m), m_expr(e, m) {
+    m_compiled = compile();
+    if (!m_compiled)
+        m_code.reset();
+    m_expr2reg.reset();
+    m_regs.resize(m_num_regs * lanes, 0);
+    TRACE("model_batch", tout << "compiled: " << m_compiled << " instructions: " << m_code.size() << "\n";);
+}
+
+bool model_batch_evaluator::is_supported_sort(sort* s) const {
+    return m.is_bool(s) || a.is_int(s) || (bv.is_bv_sort(s) && bv.get_bv_size(s) <= 64);
+}
+
+unsigned model_batch_evaluator::emit(opcode op, unsigned x, unsigned y, unsigned z, unsigned sz, uint64_t imm) {
+    instr i(op, mk_reg());
+    i.m_a = x;
+    i.m_b = y;
+    i.m_c = z;
+    i.m_sz = sz;
+    i.m_imm = imm;
+    m_code.push_back(i);
+    return i.m_dst;
+}
+
+unsigned model_batch_evaluator::emit_nary(opcode op, app* e, unsigned sz) {
+    unsigned r = m_expr2reg[e->get_arg(0)];
+    for (unsigned i = 1; i < e->get_num_args(); ++i)
+        r = emit(op, r, m_expr2reg[e->get_arg(i)], 0, sz);
+    return r;
+}
+
+bool model_batch_evaluator::compile() {
+    if (!is_app(m_expr) || !is_supported_sort(m_expr->get_sort()))
+        return false;
+    sort* s = m_expr->get_sort();
+    m_kind = m.is_bool(s) ? k_bool : a.is_int(s) ? k_int : k_bv;
+    if (m_kind == k_bv)
+        m_size = bv.get_bv_size(s);
+    ptr_buffer<expr> todo;
+    todo.push_back(m_expr);
+    while (!todo.empty()) {
+        expr* e = todo.back();
+        if (m_expr2reg.contains(e)) {
+            todo.pop_back();
+            continue;
+        }
+        if (!is_app(e) || !is_supported_sort(e->get_sort()))
+            return false;
+        app* t = to_app(e);
+        bool ready = true;
+        for (expr* arg : *t) {
+            if (!m_expr2reg.contains(arg)) {
+                todo.push_back(arg);
+                ready = false;
+            }
+        }
+        if (!ready)
+            continue;
+        todo.pop_back();
+        if (!compile(t))
+            return false;
+    }
+    m_result = m_expr2reg[m_expr];
+    return true;
+}
+
+bool model_batch_evaluator::compile(app* e) {
+    rational val;
+    unsigned sz = 0;
+    unsigned r = UINT_MAX;
+    auto arg = [&](unsigned i) { return m_expr2reg[e->get_arg(i)]; };
+    unsigned n = e->get_num_args();
+    if (is_uninterp_const(e)) {
+        instr i(op_load, mk_reg());
+        i.m_decl = e->get_decl();
+        m_code.push_back(i);
+        r = i.m_dst;
+    }
+    else if (m.is_true(e))
+        r = emit(op_const, 0, 0, 0, 0, 1);
+    else if (m.is_false(e))
+        r = emit(op_const, 0, 0, 0, 0, 0);
+    else if (bv.is_numeral(e, val, sz))
+        r = emit(op_const, 0, 0, 0, 0, val.get_uint64());
+    else if (a.is_numeral(e, val)) {
+        if (!val.is_int64())
+            return false;
+        r = emit(op_const, 0, 0, 0, 0, static_cast<uint64_t>(val.get_int64()));
+    }
+    else if (e->get_family_id() == basic_family_id) {
+        switch (e->get_decl_kind()) {
+        case OP_NOT: r = emit(op_not, arg(0)); break;
+        case OP_AND: r = emit_nary(op_and, e); break;
+        case OP_OR: r = emit_nary(op_or, e); break;
+        case OP_XOR: r = emit(op_xor, arg(0), arg(1)); break;
+        case OP_IMPLIES: r = emit(op_or, emit(op_not, arg(0)), arg(1)); break;
+        case OP_ITE: r = emit(op_ite, arg(0), arg(1), arg(2)); break;
+        case OP_EQ: r = emit(op_eq, arg(0), arg(1)); break;
+        default: return false;
+        }
+    }
+    else if (e->get_family_id() == bv.get_fid() && n > 0) {
+        sz = bv.get_bv_size(e->get_arg(0));
+        switch (e->get_decl_kind()) {
+        case OP_BNOT: r = emit(op_bnot, arg(0), 0, 0, sz); break;
+        case OP_BNEG: r = emit(op_bneg, arg(0), 0, 0, sz); break;
+        case OP_BADD: r = emit_nary(op_badd, e, sz); break;
+        case OP_BSUB: r = emit_nary(op_bsub, e, sz); break;
+        case OP_BMUL: r = emit_nary(op_bmul, e, sz); break;
+        case OP_BAND: r = emit_nary(op_band, e, sz); break;
+        case OP_BOR: r = emit_nary(op_bor, e, sz); break;
+        case OP_BXOR: r = emit_nary(op_bxor, e, sz); break;
+        case OP_BUDIV:
+        case OP_BUDIV_I: r = emit(op_budiv, arg(0), arg(1), 0, sz); break;
+        case OP_BUREM:
+        case OP_BUREM_I: r = emit(op_burem, arg(0), arg(1), 0, sz); break;
+        case OP_BSHL: r = emit(op_bshl, arg(0), arg(1), 0, sz); break;
+        case OP_BLSHR: r = emit(op_blshr, arg(0), arg(1), 0, sz); break;
+        case OP_BASHR: r = emit(op_bashr, arg(0), arg(1), 0, sz); break;
+        case OP_ULEQ: r = emit(op_bule, arg(0), arg(1), 0, sz); break;
+        case OP_UGEQ: r = emit(op_bule, arg(1), arg(0), 0, sz); break;
+        case OP_ULT: r = emit(op_bult, arg(0), arg(1), 0, sz); break;
+        case OP_UGT: r = emit(op_bult, arg(1), arg(0), 0, sz); break;
+        case OP_SLEQ: r = emit(op_bsle, arg(0), arg(1), 0, sz); break;
+        case OP_SGEQ: r = emit(op_bsle, arg(1), arg(0), 0, sz); break;
+        case OP_SLT: r = emit(op_bslt, arg(0), arg(1), 0, sz); break;
+        case OP_SGT: r = emit(op_bslt, arg(1), arg(0), 0, sz); break;
+        case OP_CONCAT:
+            r = arg(0);
+            for (unsigned i = 1; i < n; ++i)
+                r = emit(op_concat, r, arg(i), 0, 0, bv.get_bv_size(e->get_arg(i)));
+            break;
+        case OP_EXTRACT:
+            r = emit(op_extract, arg(0), 0, 0, bv.get_bv_size(e), bv.get_extract_low(e));
+            break;
+        case OP_ZERO_EXT:
+            r = arg(0);
+            break;
+        case OP_SIGN_EXT:
+            r = emit(op_sign_extend, arg(0), 0, 0, sz, bv.get_bv_size(e));
+            break;
+        default:
+            return false;
+        }
+    }
+    else if (e->get_family_id() == a.get_family_id() && n > 0 && a.is_int(e->get_arg(0))) {
+        switch (e->get_decl_kind()) {
+        case OP_ADD: r = emit_nary(op_iadd, e); break;
+        case OP_SUB: r = emit_nary(op_isub, e); break;
+        case OP_MUL: r = emit_nary(op_imul, e); break;
+        case OP_UMINUS: r = emit(op_ineg, arg(0)); break;
+        case OP_LE: r = emit(op_ile, arg(0), arg(1)); break;
+        case OP_GE: r = emit(op_ile, arg(1), arg(0)); break;
+        case OP_LT: r = emit(op_ilt, arg(0), arg(1)); break;
+        case OP_GT: r = emit(op_ilt, arg(1), arg(0)); break;
+        default: return false;
+        }
+    }
+    else
+        return false;
+    m_expr2reg.insert(e, r);
+    return true;
+}
+
+bool model_batch_evaluator::load(model& mdl, func_decl* d, uint64_t& val) {
+    expr* v = mdl.get_const_interp(d);
+    rational r;
+    unsigned sz = 0;
+    if (!v)
+        return false;
+    if (m.is_true(v))
+        val = 1;
+    else if (m.is_false(v))
+        val = 0;
+    else if (bv.is_numeral(v, r, sz))
+        val = r.get_uint64();
+    else if (a.is_numeral(v, r) && r.is_int64())
+        val = static_cast<uint64_t>(r.get_int64());
+    else
+        return false;
+    return true;
+}
+
+void model_batch_evaluator::run(unsigned n) {
+    for (instr const& i : m_code) {
+        uint64_t* d = reg(i.m_dst);
+        uint64_t const* x = reg(i.m_a);
+        uint64_t const* y = reg(i.m_b);
+        uint64_t const* z = reg(i.m_c);
+        uint64_t const mask = mask_of(i.m_sz);
+        unsigned const sz = i.m_sz;
+        switch (i.m_op) {
+        case op_load:
+            break;
+        case op_const:
+            for (unsigned l = 0; l < n; ++l) d[l] = i.m_imm;
+            break;
+        case op_not:
+            for (unsigned l = 0; l < n; ++l) d[l] = x[l] ^ 1;
+            break;
+        case op_and:
+        case op_band:
+            for (unsigned l = 0; l < n; ++l) d[l] = x[l] & y[l];
+            break;
+        case op_or:
+        case op_bor:
+            for (unsigned l = 0; l < n; ++l) d[l] = x[l] | y[l];
+            break;
+        case op_xor:
+        case op_bxor:
+            for (unsigned l = 0; l < n; ++l) d[l] = x[l] ^ y[l];
+            break;
+        case op_ite:
+            for (unsigned l = 0; l < n; ++l) d[l] = x[l] ? y[l] : z[l];
+            break;
+        case op_eq:
+            for (unsigned l = 0; l < n; ++l) d[l] = x[l] == y[l];
+            break;
+        case op_bnot:
+            for (unsigned l = 0; l < n; ++l) d[l] = ~x[l] & mask;
+            break;
+        case op_bneg:
+            for (unsigned l = 0; l < n; ++l) d[l] = (0 - x[l]) & mask;
+            break;
+        case op_badd:
+            for (unsigned l = 0; l < n; ++l) d[l] = (x[l] + y[l]) & mask;
+            break;
+        case op_bsub:
+            for (unsigned l = 0; l < n; ++l) d[l] = (x[l] - y[l]) & mask;
+            break;
+        case op_bmul:
+            for (unsigned l = 0; l < n; ++l) d[l] = (x[l] * y[l]) & mask;
+            break;
+        case op_budiv:
+            // division by zero follows the hardware interpretation of the rewriter
+            for (unsigned l = 0; l < n; ++l) d[l] = y[l] == 0 ? mask : x[l] / y[l];
+            break;
+        case op_burem:
+            for (unsigned l = 0; l < n; ++l) d[l] = y[l] == 0 ? x[l] : x[l] % y[l];
+            break;
+        case op_bshl:
+            for (unsigned l = 0; l < n; ++l) d[l] = y[l] >= sz ? 0 : (x[l] << y[l]) & mask;
+            break;
+        case op_blshr:
+            for (unsigned l = 0; l < n; ++l) d[l] = y[l] >= sz ? 0 : x[l] >> y[l];
+            break;
+        case op_bashr:
+            for (unsigned l = 0; l < n; ++l) {
+                int64_t s = sext(x[l], sz);
+                d[l] = y[l] >= sz ? (s < 0 ? mask : 0) : static_cast<uint64_t>(s >> y[l]) & mask;
+            }
+            break;
+        case op_bule:
+            for (unsigned l = 0; l < n; ++l) d[l] = x[l] <= y[l];
+            break;
+        case op_bult:
+            for (unsigned l = 0; l < n; ++l) d[l] = x[l] < y[l];
+            break;
+        case op_bsle:
+            for (unsigned l = 0; l < n; ++l) d[l] = sext(x[l], sz) <= sext(y[l], sz);
+            break;
+        case op_bslt:
+            for (unsigned l = 0; l < n; ++l) d[l] = sext(x[l], sz) < sext(y[l], sz);
+            break;
+        case op_concat:
+            for (unsigned l = 0; l < n; ++l) d[l] = (x[l] << i.m_imm) | y[l];
+            break;
+        case op_extract:
+            for (unsigned l = 0; l < n; ++l) d[l] = (x[l] >> i.m_imm) & mask;
+            break;
+        case op_sign_extend: {
+            uint64_t const m2 = mask_of(static_cast<unsigned>(i.m_imm));
+            for (unsigned l = 0; l < n; ++l) d[l] = static_cast<uint64_t>(sext(x[l], sz)) & m2;
+            break;
+        }
+        case op_iadd:
+            for (unsigned l = 0; l < n; ++l) {
+                int64_t u = static_cast<int64_t>(x[l]), v = static_cast<int64_t>(y[l]);
+                if ((v > 0 && u > INT64_MAX - v) || (v < 0 && u < INT64_MIN - v))
+                    m_failed[l] = true;
+                d[l] = x[l] + y[l];
+            }
+            break;
+        case op_isub:
+            for (unsigned l = 0; l < n; ++l) {
+                int64_t u = static_cast<int64_t>(x[l]), v = static_cast<int64_t>(y[l]);
+                if ((v < 0 && u > INT64_MAX + v) || (v > 0 && u < INT64_MIN + v))
+                    m_failed[l] = true;
+                d[l] = x[l] - y[l];
+            }
+            break;
+        case op_imul:
+            for (unsigned l = 0; l < n; ++l) {
+                int64_t u = static_cast<int64_t>(x[l]), v = static_cast<int64_t>(y[l]);
+                uint64_t p = x[l] * y[l];
+                if (u == -1 ? v == INT64_MIN : (u != 0 && static_cast<int64_t>(p) / u != v))
+                    m_failed[l] = true;
+                d[l] = p;
+            }
+            break;
+        case op_ineg:
+            for (unsigned l = 0; l < n; ++l) {
+                if (static_cast<int64_t>(x[l]) == INT64_MIN)
+                    m_failed[l] = true;
+                d[l] = 0 - x[l];
+            }
+            break;
+        case op_ile:
+            for (unsigned l = 0; l < n; ++l) d[l] = static_cast<int64_t>(x[l]) <= static_cast<int64_t>(y[l]);
+            break;
+        case op_ilt:
+            for (unsigned l = 0; l < n; ++l) d[l] = static_cast<int64_t>(x[l]) < static_cast<int64_t>(y[l]);
+            break;
+        }
+    }
+}
+
+expr* model_batch_evaluator::mk_value(uint64_t v) {
+    switch (m_kind) {
+    case k_bool:
+        return v ? m.mk_true() : m.mk_false();
+    case k_int:
+        return a.mk_int(rational(static_cast<int64_t>(v), rational::i64()));
+    default:
+        return bv.mk_numeral(rational(v, rational::ui64()), m_size);
+    }
+}
+
+void model_batch_evaluator::operator()(unsigned n, model* const* models, bool model_completion, expr_ref_vector& result) {
+    for (unsigned i = 0; i < n; i += lanes) {
+        unsigned k = std::min(lanes, n - i);
+        if (m_compiled) {
+            m_failed.reset();
+            m_failed.resize(lanes, false);
+            for (instr const& in : m_code)
+                if (in.m_op == op_load)
+                    for (unsigned l = 0; l < k; ++l)
+                        if (!load(*models[i + l], in.m_decl, reg(in.m_dst)[l]))
+                            m_failed[l] = true;
+            run(k);
+        }
+        for (unsigned l = 0; l < k; ++l) {
+            if (m_compiled && !m_failed[l])
+                result.push_back(mk_value(reg(m_result)[l]));
+            else {
+                model& mdl = *models[i + l];
+                model::scoped_model_completion _scm(mdl, model_completion);
+                result.push_back(mdl(m_expr));
+            }
+        }
+    }
+}
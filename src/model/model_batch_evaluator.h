@@ -0,0 +1,95 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    model_batch_evaluator.h
+
+Abstract:
+
+    Evaluation of one expression in many models.
+
+    The expression is compiled once into a register program over 64-bit
+    words. Instructions run over a batch of models at a time, with one
+    lane per model, so the inner loops are plain loops over arrays that
+    the compiler can vectorize.
+
+    The program covers Booleans, bit-vectors of at most 64 bits and
+    integers that fit in 64 bits. Its inputs are uninterpreted constants.
+    Expressions with other operators are evaluated by the model evaluator,
+    and so are the models that do not assign a numeral to every input or
+    where an integer operation overflows.
+
+--*/
+#pragma once
+
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "model/model.h"
+
+class model_batch_evaluator {
+    enum opcode {
+        op_load,        // m_dst := value of m_decl in the model
+        op_const,       // m_dst := m_imm
+        op_not, op_and, op_or, op_xor, op_ite, op_eq,
+        op_bnot, op_bneg, op_badd, op_bsub, op_bmul, op_band, op_bor, op_bxor,
+        op_budiv, op_burem, op_bshl, op_blshr, op_bashr,
+        op_bule, op_bult, op_bsle, op_bslt,
+        op_concat, op_extract, op_sign_extend,
+        op_iadd, op_isub, op_imul, op_ineg, op_ile, op_ilt
+    };
+
+    enum kind { k_bool, k_bv, k_int };
+
+    struct instr {
+        opcode     m_op;
+        unsigned   m_dst;
+        unsigned   m_a = 0, m_b = 0, m_c = 0;
+        unsigned   m_sz = 0;           // bit-width of the arguments
+        uint64_t   m_imm = 0;          // constant, or shift of concat and extract
+        func_decl* m_decl = nullptr;
+        instr(opcode op, unsigned dst): m_op(op), m_dst(dst) {}
+    };
+
+    static const unsigned lanes = 64;
+
+    ast_manager&       m;
+    arith_util         a;
+    bv_util            bv;
+    expr_ref           m_expr;
+    bool               m_compiled = false;
+    kind               m_kind = k_bool;
+    unsigned           m_size = 0;     // bit-width of the result if it is a bit-vector
+    vector<instr>      m_code;
+    unsigned           m_num_regs = 0;
+    unsigned           m_result = 0;
+    obj_map<expr, unsigned> m_expr2reg;
+    svector<uint64_t>  m_regs;         // m_regs[r * lanes + l] is register r in lane l
+    bool_vector        m_failed;       // lane is evaluated by the model evaluator
+
+    bool compile();
+    bool compile(app* e);
+    unsigned mk_reg() { return m_num_regs++; }
+    unsigned emit(opcode op, unsigned a, unsigned b = 0, unsigned c = 0, unsigned sz = 0, uint64_t imm = 0);
+    unsigned emit_nary(opcode op, app* e, unsigned sz = 0);
+    bool is_supported_sort(sort* s) const;
+    bool load(model& mdl, func_decl* d, uint64_t& val);
+    void run(unsigned n);
+    expr* mk_value(uint64_t v);
+    uint64_t* reg(unsigned r) { return m_regs.data() + r * lanes; }
+
+public:
+
+    model_batch_evaluator(ast_manager& m, expr* e);
+
+    /**
+       \brief true if the expression was compiled into a register program.
+     */
+    bool is_compiled() const { return m_compiled; }
+
+    /**
+       \brief evaluate the expression in models[0], ..., models[n-1] and
+       append the values to result.
+     */
+    void operator()(unsigned n, model* const* models, bool model_completion, expr_ref_vector& result);
+};
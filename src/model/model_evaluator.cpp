@@ -105,19 +105,19 @@ struct evaluator_cfg : public default_rewriter_cfg {
         m_array_as_stores  = p.array_as_stores();
     }
 
-    bool evaluate(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+    br_status evaluate(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
         func_interp * fi = m_model.get_func_interp(f);
-        bool r = (fi != nullptr) && eval_fi(fi, num, args, result);
-        CTRACE("model_evaluator", r, tout << "reduce_app " << f->get_name() << "\n";
+        br_status st = fi != nullptr ? eval_fi(fi, num, args, result) : BR_FAILED;
+        CTRACE("model_evaluator", st != BR_FAILED, tout << "reduce_app " << f->get_name() << "\n";
                for (unsigned i = 0; i < num; i++) tout << mk_ismt2_pp(args[i], m) << "\n";
                tout << "---->\n" << mk_ismt2_pp(result, m) << "\n";);
-        return r;
+        return st;
     }
 
     // Try to use the entries to quickly evaluate the fi
-    bool eval_fi(func_interp * fi, unsigned num, expr * const * args, expr_ref & result) {
+    br_status eval_fi(func_interp * fi, unsigned num, expr * const * args, expr_ref & result) {
         if (fi->num_entries() == 0)
-            return false; // let get_macro handle it.
+            return BR_FAILED; // let get_macro handle it.
 
         SASSERT(fi->get_arity() == num);
 
@@ -127,15 +127,19 @@ struct evaluator_cfg : public default_rewriter_cfg {
             actuals_are_values = m.is_value(args[i]);
 
         if (!actuals_are_values)
-            return false; // let get_macro handle it
+            return BR_FAILED; // let get_macro handle it
 
         func_entry * entry = fi->get_entry(args);
         if (entry != nullptr) {
             result = entry->get_result();
-            return true;
+            return BR_REWRITE1;
         }
 
-        return false;
+        // skip the ite over all entries that get_macro would produce
+        if (!fi->is_partial() && fi->has_no_entry(args) && fi->eval_else(args, result))
+            return BR_REWRITE_FULL;
+
+        return BR_FAILED;
     }
 
     bool reduce_quantifier(quantifier * old_q,
@@ -287,14 +291,15 @@ struct evaluator_cfg : public default_rewriter_cfg {
             result = args[0];
             st = BR_DONE;
         }
-        else if (evaluate(f, num, args, result)) 
-            st = BR_REWRITE1;        
+        else
+            st = evaluate(f, num, args, result);
         if (st == BR_FAILED && !m.is_builtin_family_id(fid)) 
             st = evaluate_partial_theory_func(f, num, args, result, result_pr);        
         if (st == BR_DONE && is_app(result)) {
             app* a = to_app(result);
-            if (evaluate(a->get_decl(), a->get_num_args(), a->get_args(), result))
-                st = BR_REWRITE1;              
+            br_status st2 = evaluate(a->get_decl(), a->get_num_args(), a->get_args(), result);
+            if (st2 != BR_FAILED)
+                st = st2;
         }
 
         if (st == BR_DONE && is_app(result) && expand_as_array(to_app(result)->get_decl(), result))
@@ -0,0 +1,27 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    model_scratch.cpp
+
+Abstract:
+
+    Thread local copy of a model for concurrent queries.
+
+--*/
+
+#include "model/model_scratch.h"
+
+model_scratch::model_scratch(model& mdl):
+    m(mdl.get_manager(), true),
+    m_tr(mdl.get_manager(), m, false) {
+    SASSERT(mdl.get_manager().is_frozen());
+    m_model = mdl.translate(m_tr);
+}
+
+expr_ref model_scratch::eval(expr* e, bool model_completion) {
+    expr_ref t = (*this)(e);
+    model::scoped_model_completion _scm(*m_model, model_completion);
+    return (*m_model)(t);
+}
@@ -0,0 +1,46 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    model_scratch.h
+
+Abstract:
+
+    Thread local copy of a model for concurrent queries.
+
+    The model is translated from a frozen manager, see
+    ast_manager::freeze, into a manager owned by the scratch copy.
+    Several threads can create scratch copies of one model at once and
+    evaluate and print expressions of the frozen manager in them.
+
+--*/
+#pragma once
+
+#include "ast/ast_translation.h"
+#include "model/model.h"
+
+class model_scratch {
+    ast_manager       m;
+    ast_translation   m_tr;
+    model_ref         m_model;
+
+public:
+
+    model_scratch(model& mdl);
+
+    ast_manager& get_manager() { return m; }
+
+    model& get_model() { return *m_model; }
+
+    /**
+       \brief copy e from the frozen manager into the scratch manager.
+     */
+    expr_ref operator()(expr* e) { return expr_ref(m_tr(e), m); }
+
+    /**
+       \brief evaluate e, an expression of the frozen manager. The value
+       is returned in the scratch manager.
+     */
+    expr_ref eval(expr* e, bool model_completion = false);
+};
@@ -230,6 +230,7 @@ namespace datalog {
         rule_manager & get_rule_manager() { return m_rule_manager; }
         smt_params & get_fparams() const { return m_fparams; }
         fp_params const&  get_params() const { return *m_params; }
+        params_ref const& get_params_ref() const { return m_params_ref; }
         DL_ENGINE get_engine(expr* e = nullptr) { configure_engine(e); return m_engine_type; }
         register_engine_base& get_register_engine() { return m_register_engine; }
         th_rewriter& get_rewriter() { return m_rewriter; }
@@ -257,6 +258,9 @@ namespace datalog {
         symbol print_aig() const;
         symbol tab_selection() const;
         unsigned similarity_compressor_threshold() const;
+        bool incremental() const;
+        bool reuse_transformations() const;
+        unsigned join_threads() const;
         unsigned soft_timeout() const;
         unsigned initial_restart_timeout() const;
         bool generate_explanations() const;
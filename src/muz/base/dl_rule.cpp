@@ -259,7 +259,7 @@ namespace datalog {
     }
 
 
-    func_decl* rule_manager::mk_query(expr* query, rule_set& rules) {
+    func_decl* rule_manager::mk_query(expr* query, rule_set& rules, func_decl* qpred) {
         TRACE("dl", tout << mk_pp(query, m) << "\n";);
 
         ptr_vector<sort> vars;
@@ -319,7 +319,10 @@ namespace datalog {
         }
         vars.reverse();
         names.reverse();
-        func_decl* qpred = m_ctx.mk_fresh_head_predicate(symbol("query"), symbol(), vars.size(), vars.data(), body_pred);
+        if (!qpred) {
+            qpred = m_ctx.mk_fresh_head_predicate(symbol("query"), symbol(), vars.size(), vars.data(), body_pred);
+        }
+        SASSERT(qpred->get_arity() == vars.size());
         m_ctx.register_predicate(qpred, false);
         rules.set_output_predicate(qpred);
 
@@ -211,8 +211,10 @@ namespace datalog {
         /**
            \brief Create a Datalog query from an expression.
            The formula is of the form (exists (...) (exists (...) (and ...))
+           If \c qpred is given, it is used as the query predicate instead of
+           a fresh predicate; it must come from an earlier call for the same query.
         */
-        func_decl* mk_query(expr* query, rule_set& rules);
+        func_decl* mk_query(expr* query, rule_set& rules, func_decl* qpred = nullptr);
 
         /**
            \brief Create a Datalog rule head :- tail[0], ..., tail[n-1].
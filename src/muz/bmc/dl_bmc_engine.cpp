@@ -32,6 +32,10 @@ Revision History:
 #include "muz/bmc/dl_bmc_engine.h"
 #include "muz/transforms/dl_mk_slice.h"
 #include "model/model_smt2_pp.h"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
+#include <mutex>
 #include "muz/transforms/dl_transforms.h"
 #include "muz/transforms/dl_mk_rule_inliner.h"
 #include "muz/base/fp_params.hpp"
@@ -1165,6 +1169,10 @@ namespace datalog {
         lbool check() {
             setup();
             unsigned max_depth = b.m_ctx.get_params().bmc_linear_unrolling_depth();
+            unsigned num_threads = b.m_ctx.get_params().bmc_threads();
+            if (num_threads > 1) {
+                return check_parallel(max_depth, num_threads);
+            }
             for (unsigned i = 0; i < max_depth; ++i) {
                 IF_VERBOSE(1, verbose_stream() << "level: " << i << "\n";);
                 b.checkpoint();
@@ -1183,16 +1191,109 @@ namespace datalog {
 
     private:
 
+        /**
+           \brief check the levels in batches of num_threads, each level of a batch on its own
+           solver. The solvers keep their unrolling between batches and receive the levels 
+           compiled for a batch. A counterexample at a level cancels the checks of the deeper 
+           levels of the batch; the shallowest counterexample is returned.
+        */
+        lbool check_parallel(unsigned max_depth, unsigned num_threads) {
+            scoped_ptr_vector<ast_manager> managers;
+            vector<solver_ref> solvers;
+            scoped_limits scl(m.limit());
+            for (unsigned i = 0; i < num_threads; ++i) {
+                ast_manager* new_m = alloc(ast_manager, m, !m.proof_mode());
+                managers.push_back(new_m);
+                solvers.push_back(solver_ref(b.m_solver->translate(*new_m, solver_params())));
+                scl.push_child(&new_m->limit());
+            }
+            unsigned num_sent = b.m_solver->get_num_assertions();
+            std::mutex mux;
+            for (unsigned lo = 0; lo < max_depth; lo += num_threads) {
+                unsigned n = std::min(num_threads, max_depth - lo);
+                IF_VERBOSE(1, verbose_stream() << "levels: " << lo << " - " << (lo + n - 1) << "\n";);
+                b.checkpoint();
+                for (unsigned i = 0; i < n; ++i) {
+                    compile(lo + i);
+                }
+                unsigned sz = b.m_solver->get_num_assertions();
+                vector<expr_ref> queries;
+                for (unsigned i = 0; i < num_threads; ++i) {
+                    ast_translation tr(m, *managers[i]);
+                    for (unsigned j = num_sent; j < sz; ++j) {
+                        solvers[i]->assert_expr(tr(b.m_solver->get_assertion(j)));
+                    }
+                    if (i < n) {
+                        queries.push_back(expr_ref(tr(mk_level_predicate(b.m_query_pred, lo + i).get()), *managers[i]));
+                    }
+                }
+                num_sent = sz;
+
+                svector<lbool> results(n, l_undef);
+                vector<std::string> errors(n);
+                unsigned first_sat = UINT_MAX;
+                auto check_level = [&](unsigned i) {
+                    try {
+                        expr* q = queries[i];
+                        results[i] = solvers[i]->check_sat(1, &q);
+                    }
+                    catch (z3_exception& ex) {
+                        results[i] = l_undef;
+                        errors[i] = ex.msg();
+                    }
+                    if (results[i] != l_true) {
+                        return;
+                    }
+                    std::lock_guard<std::mutex> lock(mux);
+                    if (i < first_sat) {
+                        first_sat = i;
+                        for (unsigned j = i + 1; j < n; ++j) {
+                            managers[j]->limit().cancel();
+                        }
+                    }
+                };
+                thread_pool::run(n, check_level);
+                for (unsigned i = 0; i < num_threads; ++i) {
+                    managers[i]->limit().reset_cancel();
+                }
+
+                for (unsigned i = 0; i < n; ++i) {
+                    if (results[i] == l_true) {
+                        model_ref md;
+                        solvers[i]->get_model(md);
+                        ast_translation tr(*managers[i], m);
+                        model_ref md1 = md->translate(tr);
+                        get_model(lo + i, md1);
+                        return l_true;
+                    }
+                    if (results[i] == l_undef) {
+                        if (!errors[i].empty()) {
+                            throw default_exception(std::move(errors[i]));
+                        }
+                        return l_undef;
+                    }
+                }
+            }
+            return l_undef;
+        }
+
         void get_model(unsigned level) {
+            if (!m.inc()) {
+                return;
+            }
+            model_ref md;
+            b.m_solver->get_model(md);
+            get_model(level, md);
+        }
+
+        void get_model(unsigned level, model_ref& md) {
             if (!m.inc()) {
                 return;
             }
             rule_manager& rm = b.m_ctx.get_rule_manager();
             expr_ref level_query = mk_level_predicate(b.m_query_pred, level);
-            model_ref md;
             proof_ref pr(m);
             rule_unifier unifier(b.m_ctx);
-            b.m_solver->get_model(md);
             func_decl* pred = b.m_query_pred;
             SASSERT(m.is_true(md->get_const_interp(to_app(level_query)->get_decl())));
 
@@ -1291,11 +1392,15 @@ namespace datalog {
         }
 
 
-        void setup() {
+        static params_ref solver_params() {
             params_ref p;
             p.set_uint("smt.relevancy", 0ul);
             p.set_bool("smt.mbqi", false);
-            b.m_solver->updt_params(p);
+            return p;
+        }
+
+        void setup() {
+            b.m_solver->updt_params(solver_params());
             b.m_rule_trace.reset();
         }
 
@@ -1099,7 +1099,7 @@ namespace datalog {
 
     void compiler::compile_loop(const func_decl_vector & head_preds, const func_decl_set & widened_preds,
             const pred2idx & global_head_deltas, const pred2idx & global_tail_deltas, 
-            const pred2idx & local_deltas, instruction_block & acc) {
+            const pred2idx & local_deltas, instruction_block & acc, const pred2idx * accumulated) {
         instruction_block * loop_body = alloc(instruction_block);
         loop_body->set_observer(&m_instruction_observer);
 
@@ -1113,6 +1113,12 @@ namespace datalog {
         //deltas generated earlier in the same iteration.
         compile_preds(head_preds, widened_preds, &all_tail_deltas, all_head_deltas, *loop_body);
 
+        if (accumulated) {
+            for (auto const& kv : global_head_deltas) {
+                make_union(kv.m_value, accumulated->find(kv.m_key), execution_context::void_register, false, *loop_body);
+            }
+        }
+
         svector<reg_idx> loop_control_regs; //loop is controlled by global src regs
         collect_map_range(loop_control_regs, global_tail_deltas);
         //move target deltas into source deltas at the end of the loop
@@ -1243,6 +1249,105 @@ namespace datalog {
         }
     }
 
+    void compiler::compile_stratum_incremental(const func_decl_set & preds, pred2idx & changed, 
+            instruction_block & acc) {
+        func_decl_vector preds_vector;
+        func_decl_set global_deltas_dummy;
+        detect_chains(preds, preds_vector, global_deltas_dummy);
+
+        pred2idx d_src;
+        get_fresh_registers(preds, d_src);
+        for (func_decl * p : preds) {
+            reg_idx added;
+            if (changed.find(p, added)) {
+                make_union(added, d_src.find(p), execution_context::void_register, false, acc);
+            }
+        }
+
+        //the rules evaluated with one of their tails replaced by the tuples added to it 
+        //give the first delta of the stratum
+        for (func_decl * head_pred : preds_vector) {
+            for (rule * r : m_rule_set.get_predicate_rules(head_pred)) {
+                compile_rule_evaluation(r, &changed, d_src.find(head_pred), false, acc);
+            }
+        }
+
+        if (is_nonrecursive_stratum(preds)) {
+            for (func_decl * p : preds) {
+                changed.insert(p, d_src.find(p));
+            }
+        }
+        else {
+            //the usual semi-naive loop continues from there, the tuples of all its
+            //iterations are collected for the strata above
+            pred2idx d_tgt, d_local, d_new;
+            get_fresh_registers(preds, d_tgt);
+            get_fresh_registers(preds, d_new);
+            for (func_decl * p : preds) {
+                make_union(d_src.find(p), d_new.find(p), execution_context::void_register, false, acc);
+            }
+            func_decl_set empty_func_decl_set;
+            compile_loop(preds_vector, empty_func_decl_set, d_tgt, d_src, d_local, acc, &d_new);
+            for (func_decl * p : preds) {
+                changed.insert(p, d_new.find(p));
+            }
+        }
+
+        for (func_decl * p : preds) {
+            acc.push_back(instruction::mk_mark_saturated(m_context.get_manager(), p));
+        }
+    }
+
+    void compiler::compile_strats_incremental(const rule_stratifier & stratifier, instruction_block & acc) {
+        pred2idx changed; //predicate -> register with the tuples added to it since the last evaluation
+        for (auto const& kv : *m_new_facts) {
+            reg_idx pred_reg;
+            if (!m_pred_regs.find(kv.m_key, pred_reg)) {
+                continue; //not used by the rules
+            }
+            relation_signature sig = m_reg_signatures[pred_reg];
+            reg_idx reg = get_fresh_register(sig);
+            acc.push_back(instruction::mk_load(m_context.get_manager(), kv.m_value, reg));
+            changed.insert(kv.m_key, reg);
+        }
+
+        pred2idx empty_pred2idx_map;
+        for (func_decl_set * strat : stratifier.get_strats()) {
+            func_decl_set & strat_preds = *strat;
+            if (all_saturated(strat_preds)) {
+                continue;
+            }
+            bool up_to_date = true;
+            for (func_decl * p : strat_preds) {
+                if (!m_rule_set.get_predicate_rules(p).empty() && !m_fixpoint->contains(p)) {
+                    up_to_date = false;
+                }
+            }
+            if (up_to_date) {
+                compile_stratum_incremental(strat_preds, changed, acc);
+                continue;
+            }
+
+            //evaluate the stratum from scratch, all its tuples are new for the strata above
+            if (is_nonrecursive_stratum(strat_preds)) {
+                compile_nonrecursive_stratum(strat_preds, nullptr, empty_pred2idx_map, true, acc);
+            }
+            else {
+                compile_dependent_rules(strat_preds, nullptr, empty_pred2idx_map, true, acc);
+            }
+            for (func_decl * p : strat_preds) {
+                if (m_rule_set.get_predicate_rules(p).empty()) {
+                    continue;
+                }
+                reg_idx pred_reg = m_pred_regs.find(p);
+                relation_signature sig = m_reg_signatures[pred_reg];
+                reg_idx reg = get_fresh_register(sig);
+                acc.push_back(instruction::mk_clone(pred_reg, reg));
+                changed.insert(p, reg);
+            }
+        }
+    }
+
     bool compiler::all_saturated(const func_decl_set & preds) const {
         func_decl_set::iterator fdit = preds.begin();
         func_decl_set::iterator fdend = preds.end();
@@ -1315,8 +1420,13 @@ namespace datalog {
         
         pred2idx empty_pred2idx_map;
 
-        compile_strats(m_rule_set.get_stratifier(), static_cast<pred2idx *>(nullptr),
-            empty_pred2idx_map, true, execution_code);
+        if (m_fixpoint) {
+            compile_strats_incremental(m_rule_set.get_stratifier(), execution_code);
+        }
+        else {
+            compile_strats(m_rule_set.get_stratifier(), static_cast<pred2idx *>(nullptr),
+                empty_pred2idx_map, true, execution_code);
+        }
 
 
 
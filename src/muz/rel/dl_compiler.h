@@ -116,6 +116,9 @@ namespace datalog {
         obj_map<decl, reg_idx>            m_empty_tables_registers;
         instruction_observer              m_instruction_observer;
         expr_free_vars                    m_free_vars;
+        // incremental compilation, see compile_incremental
+        func_decl_set const *             m_fixpoint { nullptr };
+        obj_map<func_decl, func_decl*> const * m_new_facts { nullptr };
 
 
         /**
@@ -224,9 +227,13 @@ namespace datalog {
 
         void make_inloop_delta_transition(const pred2idx & global_head_deltas, 
             const pred2idx & global_tail_deltas, const pred2idx & local_deltas, instruction_block & acc);
+        /**
+           \brief Generate the semi-naive loop of a stratum. If \c accumulated is not null, the new
+           tuples of every iteration are also added to the registers it assigns to the head predicates.
+        */
         void compile_loop(const func_decl_vector & head_preds, const func_decl_set & widened_preds,
             const pred2idx & global_head_deltas, const pred2idx & global_tail_deltas, 
-            const pred2idx & local_deltas, instruction_block & acc);
+            const pred2idx & local_deltas, instruction_block & acc, const pred2idx * accumulated = nullptr);
         void compile_dependent_rules(const func_decl_set & head_preds,
             const pred2idx * input_deltas, const pred2idx & output_deltas, 
             bool add_saturation_marks, instruction_block & acc);
@@ -250,6 +257,16 @@ namespace datalog {
             const pred2idx * input_deltas, const pred2idx & output_deltas, 
             bool add_saturation_marks, instruction_block & acc);
 
+        /**
+           \brief Generate code that adds to the predicates of the stratum the tuples that follow
+           from the tuples in \c changed, and assign to the predicates registers with the tuples
+           added to them in \c changed. The relations of the predicates must be a fixpoint of the
+           rules for the content of the lower strata before the tuples in \c changed were added.
+        */
+        void compile_stratum_incremental(const func_decl_set & preds, pred2idx & changed, instruction_block & acc);
+
+        void compile_strats_incremental(const rule_stratifier & stratifier, instruction_block & acc);
+
         bool all_saturated(const func_decl_set & preds) const;
 
         void reset();
@@ -276,6 +293,24 @@ namespace datalog {
                 .do_compilation(execution_code, termination_code);
         }
 
+        /**
+           \brief Compile \c rules for an incremental evaluation.
+
+           The relations of the predicates in \c fixpoint are saturated with respect to the
+           rules and the content their inputs had before the facts in \c new_facts were added.
+           \c new_facts maps a predicate to the predicate whose relation holds the facts added
+           to it since. Strata of \c fixpoint predicates only propagate the new tuples, the
+           other strata are evaluated from scratch.
+        */
+        static void compile_incremental(context & ctx, rule_set const & rules, func_decl_set const & fixpoint,
+                obj_map<func_decl, func_decl*> const & new_facts, instruction_block & execution_code, 
+                instruction_block & termination_code) {
+            compiler c(ctx, rules, execution_code);
+            c.m_fixpoint = &fixpoint;
+            c.m_new_facts = &new_facts;
+            c.do_compilation(execution_code, termination_code);
+        }
+
     };
 
 
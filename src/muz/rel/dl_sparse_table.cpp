@@ -18,9 +18,15 @@ Revision History:
 --*/
 
 #include<utility>
+#include<atomic>
+#include<functional>
+#ifndef SINGLE_THREAD
+#include<thread>
+#endif
 #include "muz/base/dl_context.h"
 #include "muz/base/dl_util.h"
 #include "muz/rel/dl_sparse_table.h"
+#include "util/thread_pool.h"
 
 namespace datalog {
 
@@ -683,6 +689,11 @@ namespace datalog {
             return;
         }
 
+        unsigned num_threads = result.get_plugin().get_context().join_threads();
+        if (partitioned_join_project(t1, t2, joined_col_cnt, t1_joined_cols, t2_joined_cols, 
+                                     removed_cols, tables_swapped, num_threads, result))
+            return;
+
         key_value t1_key;
         t1_key.resize(joined_col_cnt);
         key_indexer& t2_indexer = t2.get_key_indexer(joined_col_cnt, t2_joined_cols);
@@ -729,6 +740,142 @@ namespace datalog {
         }
     }
 
+    bool sparse_table::partitioned_join_project(const sparse_table & t1, const sparse_table & t2,
+            unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
+            const unsigned * removed_cols, bool tables_swapped, unsigned num_threads, sparse_table & result) {
+        // below these sizes the threads, respectively the partitioning, cost more than they save
+        const unsigned min_parallel_rows = 1 << 14;
+        const unsigned min_partitioned_rows = 1 << 16;
+        // rows of t2 per partition, so that a partition and its index stay in cache
+        const unsigned partition_rows = 1 << 12;
+        unsigned n1 = t1.row_count();
+        unsigned n2 = t2.row_count();
+#ifdef SINGLE_THREAD
+        num_threads = 1;
+#else
+        num_threads = std::min(num_threads, std::max(1u, std::thread::hardware_concurrency()));
+#endif
+        bool parallel = num_threads > 1 && n1 + n2 >= min_parallel_rows;
+        if (!parallel && n2 < min_partitioned_rows)
+            return false;
+        // The partitions are rebuilt on every join, while the key indexes of t2 persist and
+        // only absorb the new rows. Small deltas joined with large relations stay with the index.
+        if (4ull * n1 < n2)
+            return false;
+        if (!parallel)
+            num_threads = 1;
+
+        verbose_action _va("partitioned_join_project", 1);
+        unsigned t1_entry_size = t1.m_fact_size;
+        unsigned t2_entry_size = t2.m_fact_size;
+        unsigned res_entry_size = result.m_fact_size;
+        unsigned num_parts = next_power_of_two(std::max(num_threads, n2 / partition_rows));
+        unsigned part_shift = 32 - log2(num_parts);
+
+        auto run = [&](std::function<void(unsigned)> const & f) {
+#ifndef SINGLE_THREAD
+            if (num_threads > 1) {
+                thread_pool::run(num_threads, f);
+                return;
+            }
+#endif
+            f(0);
+        };
+
+        auto key_hash = [&](const char * rec, const column_layout & layout, const unsigned * cols) {
+            unsigned h = 17;
+            for (unsigned i = 0; i < joined_col_cnt; ++i)
+                h = combine_hash(h, hash_ull(layout.get(rec, cols[i])));
+            return h;
+        };
+        // the partition is taken from the high bits, the index of a partition hashes the low bits
+        auto part_of = [&](unsigned h) { return num_parts == 1 ? 0 : h >> part_shift; };
+
+        // hash the join keys of both tables, every thread takes a slice of the rows
+        unsigned_vector h1(n1, 0u), h2(n2, 0u);
+        run([&](unsigned w) {
+            for (unsigned r = w; r < n2; r += num_threads)
+                h2[r] = key_hash(t2.get_at_offset(static_cast<store_offset>(r) * t2_entry_size), t2.m_column_layout, t2_joined_cols);
+            for (unsigned r = w; r < n1; r += num_threads)
+                h1[r] = key_hash(t1.get_at_offset(static_cast<store_offset>(r) * t1_entry_size), t1.m_column_layout, t1_joined_cols);
+        });
+
+        vector<unsigned_vector> parts1(num_parts), parts2(num_parts);
+        for (unsigned r = 0; r < n2; ++r)
+            parts2[part_of(h2[r])].push_back(r);
+        for (unsigned r = 0; r < n1; ++r)
+            parts1[part_of(h1[r])].push_back(r);
+
+        // join every partition into a private buffer. The buffers keep 8 bytes of
+        // zero padding at the end, since column_layout::set reads and writes whole
+        // 64 bit words.
+        vector<svector<char, size_t>> buffers(num_parts);
+        std::atomic<bool> out_of_memory(false);
+        vector<std::string> failures(num_threads);
+        run([&](unsigned w) {
+            try {
+                u_map<unsigned_vector> index;
+                unsigned steps = 0;
+                for (unsigned p = w; p < num_parts; p += num_threads) {
+                    index.reset();
+                    for (unsigned r : parts2[p])
+                        index.insert_if_not_there(h2[r], unsigned_vector()).push_back(r);
+                    svector<char, size_t> & out = buffers[p];
+                    out.resize(sizeof(uint64_t), 0);
+                    for (unsigned r1 : parts1[p]) {
+                        auto * e = index.find_core(h1[r1]);
+                        if (!e)
+                            continue;
+                        char const * t1ptr = t1.get_at_offset(static_cast<store_offset>(r1) * t1_entry_size);
+                        for (unsigned r2 : e->get_data().m_value) {
+                            char const * t2ptr = t2.get_at_offset(static_cast<store_offset>(r2) * t2_entry_size);
+                            unsigned i = 0;
+                            for (; i < joined_col_cnt; ++i)
+                                if (t1.m_column_layout.get(t1ptr, t1_joined_cols[i]) != t2.m_column_layout.get(t2ptr, t2_joined_cols[i]))
+                                    break;
+                            if (i < joined_col_cnt)
+                                continue;
+                            if (++steps % 1024 == 0 && (out_of_memory || memory::above_high_watermark())) {
+                                out_of_memory = true;
+                                return;
+                            }
+                            size_t pos = out.size() - sizeof(uint64_t);
+                            out.resize(out.size() + res_entry_size, 0);
+                            if (tables_swapped) 
+                                concatenate_rows(t2.m_column_layout, t1.m_column_layout, result.m_column_layout,
+                                    t2ptr, t1ptr, out.data() + pos, removed_cols);
+                            else 
+                                concatenate_rows(t1.m_column_layout, t2.m_column_layout, result.m_column_layout,
+                                    t1ptr, t2ptr, out.data() + pos, removed_cols);
+                        }
+                    }
+                }
+            }
+            catch (out_of_memory_error &) {
+                out_of_memory = true;
+            }
+            catch (z3_exception & ex) {
+                failures[w] = ex.msg();
+            }
+        });
+        if (out_of_memory)
+            throw out_of_memory_error();
+        for (auto & f : failures)
+            if (!f.empty())
+                throw default_exception(std::move(f));
+
+        // merge in partition order, so that the result does not depend on scheduling
+        for (auto & out : buffers) {
+            size_t end = out.size() - sizeof(uint64_t);
+            for (size_t pos = 0; pos < end; pos += res_entry_size) {
+                result.garbage_collect();
+                result.add_fact(out.data() + pos);
+            }
+            out.finalize();
+        }
+        return true;
+    }
+
 
     // -----------------------------------
     //
@@ -451,6 +451,20 @@ namespace datalog {
             unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
             const unsigned * removed_cols, bool tables_swapped, sparse_table & result);
 
+        /**
+           \brief Radix partitioned join-project for large tables.
+
+           The rows of both tables are partitioned by the high bits of the hash of their join key,
+           into partitions small enough for a partition of \c t2 and its hash index to stay in
+           cache. The partitions are joined into private buffers, by \c num_threads threads if
+           it is larger than 1, and the buffers are merged into \c result in partition order.
+           Return false, leaving \c result unchanged, if the tables are too small or too
+           unbalanced for the partitioning to pay off.
+        */
+        static bool partitioned_join_project(const sparse_table & t1, const sparse_table & t2,
+            unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
+            const unsigned * removed_cols, bool tables_swapped, unsigned num_threads, sparse_table & result);
+
 
         /**
            If the fact at \c data (in table's native representation) is not in the table,
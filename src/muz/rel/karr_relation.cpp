@@ -254,6 +254,10 @@ namespace datalog {
                 m_basis.b.push_back(M.b[i]);
                 m_basis.eq.push_back(true);
             }
+            // projection makes rows dependent
+            vector<vector<rational> > echelon;
+            unsigned_vector pivots;
+            reduce_basis(m_basis, echelon, pivots);
             m_basis_valid = true;
             m_ineqs_valid = false;
             m_empty = false;
@@ -308,23 +312,20 @@ namespace datalog {
                 return;
             }
             matrix& N = get_basis();
+            vector<vector<rational> > echelon;
+            unsigned_vector pivots;
+            reduce_basis(N, echelon, pivots);
             unsigned N_size = N.size();
             for (unsigned i = 0; i < M.size(); ++i) {
-                bool found = false;
-                for (unsigned j = 0; !found && j < N_size; ++j) {
-                    found = 
-                        same_row(M.A[i], N.A[j]) &&
-                        M.b[i] == N.b[j] &&
-                        M.eq[i] == N.eq[j];
-                }
-                if (!found) {
+                SASSERT(M.eq[i]);
+                if (add_to_span(M.A[i], M.b[i], echelon, pivots)) {
                     N.A.push_back(M.A[i]);
                     N.b.push_back(M.b[i]);
-                    N.eq.push_back(M.eq[i]);
+                    N.eq.push_back(true);
                 }
             }
-            m_ineqs_valid = false;
             if (N_size != N.size()) {
+                m_ineqs_valid = false;
                 if (delta) {
                     delta->copy(*this);
                 }
@@ -361,16 +362,65 @@ namespace datalog {
             m_empty = other.m_empty;
         }
 
-        bool same_row(vector<rational> const& r1, vector<rational> const& r2) const {
-            SASSERT(r1.size() == r2.size());
-            for (unsigned i = 0; i < r1.size(); ++i) {
-                if (r1[i] != r2[i]) {
-                    return false;
+        /**
+           \brief The inequalities of a basis only depend on the span of its rows extended 
+           by b. echelon holds the extended rows of a span in echelon form: the pivots[i]'th
+           entry of echelon[i] is one and the entries of the later rows at pivots[i] are zero.
+           Add row to the span unless it is already in it.
+        */
+        static bool add_to_span(vector<rational> const& row, rational const& b, 
+                                vector<vector<rational> >& echelon, unsigned_vector& pivots) {
+            vector<rational> r(row);
+            r.push_back(b);
+            for (unsigned i = 0; i < echelon.size(); ++i) {
+                rational c = r[pivots[i]];
+                if (c.is_zero()) {
+                    continue;
+                }
+                vector<rational> const& e = echelon[i];
+                for (unsigned j = pivots[i]; j < r.size(); ++j) {
+                    if (!e[j].is_zero()) {
+                        r[j] -= c * e[j];
+                    }
                 }
             }
+            unsigned p = 0;
+            while (p < r.size() && r[p].is_zero()) {
+                ++p;
+            }
+            if (p == r.size()) {
+                return false;
+            }
+            rational c = r[p];
+            for (unsigned j = p; j < r.size(); ++j) {
+                r[j] /= c;
+            }
+            echelon.push_back(r);
+            pivots.push_back(p);
             return true;
         }
 
+        /**
+           \brief remove the rows of the basis that are in the span of the other rows.
+        */
+        static void reduce_basis(matrix& N, vector<vector<rational> >& echelon, unsigned_vector& pivots) {
+            unsigned j = 0;
+            for (unsigned i = 0; i < N.size(); ++i) {
+                SASSERT(N.eq[i]);
+                if (!add_to_span(N.A[i], N.b[i], echelon, pivots)) {
+                    continue;
+                }
+                if (i != j) {
+                    N.A[j] = N.A[i];
+                    N.b[j] = N.b[i];
+                }
+                ++j;
+            }
+            N.A.shrink(j);
+            N.b.shrink(j);
+            N.eq.shrink(j);
+        }
+
         void mk_rename(matrix& M, unsigned col_cnt, unsigned const* cols) {
             for (unsigned j = 0; j < M.size(); ++j) {
                 vector<rational> & row = M.A[j];
@@ -98,7 +98,13 @@ namespace datalog {
           m_answer(m), 
           m_last_result_relation(nullptr),
           m_ectx(ctx),
-          m_sw(0) {
+          m_sw(0),
+          m_fixpoint_src(ctx.get_rule_manager()),
+          m_new_fact_decls(ctx.get_manager()),
+          m_query_pred(ctx.get_manager()),
+          m_xform(ctx),
+          m_magic_xform(ctx),
+          m_last_query(ctx.get_manager()) {
 
         // register plugins for builtin tables
 
@@ -126,10 +132,145 @@ namespace datalog {
     }
 
     lbool rel_context::saturate() {
+        m_query_pred = nullptr;
         scoped_query sq(m_context);
         return saturate(sq);
     }
 
+    void rel_context::collect_source_rules(rule_ref_vector& src) const {
+        rule_set const& rules = m_context.get_rules();
+        for (unsigned i = 0; i < rules.get_num_rules(); ++i) {
+            rule* r = rules.get_rule(i);
+            if (r->get_decl() != m_query_pred) {
+                src.push_back(r);
+            }
+        }
+    }
+
+    /**
+       \brief Replace the rules of the context by the fixpoint rules and the query rules
+       if the relations still hold a fixpoint of the source rules. The query rules are
+       compiled as they are, so they are only accepted when they are simple joins of
+       predicates whose relations are up to date.
+    */
+    bool rel_context::install_fixpoint_rules(rule_ref_vector const& src) {
+        if (!m_fixpoint_rules || m_fixpoint_src.size() != src.size()) {
+            return false;
+        }
+        for (unsigned i = 0; i < src.size(); ++i) {
+            if (m_fixpoint_src.get(i) != src.get(i)) {
+                return false;
+            }
+        }
+        for (auto const& kv : m_new_facts) {
+            if (!m_fixpoint_preds.contains(kv.m_key) || !try_get_relation(kv.m_value)) {
+                return false;
+            }
+        }
+        rule_set const& current = m_context.get_rules();
+        rule_set rules(m_context);
+        rules.add_rules(*m_fixpoint_rules);
+        for (unsigned i = 0; i < current.get_num_rules(); ++i) {
+            rule* r = current.get_rule(i);
+            if (r->get_decl() != m_query_pred) {
+                continue;
+            }
+            unsigned psz = r->get_positive_tail_size();
+            if (psz != r->get_uninterpreted_tail_size() || psz > 2) {
+                return false;
+            }
+            for (unsigned j = 0; j < psz; ++j) {
+                func_decl* q = r->get_decl(j);
+                if (!m_fixpoint_preds.contains(q) && !current.get_predicate_rules(q).empty()) {
+                    return false;
+                }
+            }
+            rules.add_rule(r);
+        }
+        if (m_query_pred) {
+            rules.set_output_predicate(m_query_pred);
+        }
+        m_context.reopen();
+        m_context.replace_rules(rules);
+        m_context.close();
+        IF_VERBOSE(10, verbose_stream() << "(datalog.incremental :new-facts " << m_new_facts.size() << ")\n";);
+        return true;
+    }
+
+    void rel_context::save_fixpoint(rule_ref_vector const& src) {
+        reset_fixpoint();
+        if (m_context.generate_explanations() || m_context.magic_sets_for_queries() || m_context.xform_bit_blast()) {
+            return;
+        }
+        rule_set const& rules = m_context.get_rules();
+        ptr_vector<func_decl> todo;
+        for (rule* r : src) {
+            func_decl* p = rules.get_pred(r->get_decl());
+            if (!m_fixpoint_preds.contains(p)) {
+                m_fixpoint_preds.insert(p);
+                todo.push_back(p);
+            }
+        }
+        while (!todo.empty()) {
+            func_decl* p = todo.back();
+            todo.pop_back();
+            rule_vector const& p_rules = rules.get_predicate_rules(p);
+            if (p_rules.empty()) {
+                continue;
+            }
+            relation_base* rel = try_get_relation(p);
+            if (!rel || !rel->is_precise()) {
+                reset_fixpoint();
+                return;
+            }
+            m_fixpoint_heads.insert(p);
+            for (rule* r : p_rules) {
+                unsigned psz = r->get_positive_tail_size();
+                if (psz != r->get_uninterpreted_tail_size()) {
+                    // deltas do not propagate through negation
+                    reset_fixpoint();
+                    return;
+                }
+                for (unsigned j = 0; j < psz; ++j) {
+                    func_decl* q = r->get_decl(j);
+                    if (!m_fixpoint_preds.contains(q)) {
+                        m_fixpoint_preds.insert(q);
+                        todo.push_back(q);
+                    }
+                }
+            }
+        }
+        m_fixpoint_rules = alloc(rule_set, m_context);
+        for (func_decl* p : m_fixpoint_heads) {
+            for (rule* r : rules.get_predicate_rules(p)) {
+                m_fixpoint_rules->add_rule(r);
+            }
+        }
+        m_fixpoint_rules->inherit_predicates(rules);
+        m_fixpoint_src.append(src);
+    }
+
+    void rel_context::reset_fixpoint() {
+        m_fixpoint_rules = nullptr;
+        m_fixpoint_preds.reset();
+        m_fixpoint_heads.reset();
+        m_fixpoint_src.reset();
+    }
+
+    relation_base* rel_context::get_new_facts(func_decl* pred) {
+        if (!m_fixpoint_rules) {
+            return nullptr;
+        }
+        func_decl* d = nullptr;
+        if (!m_new_facts.find(pred, d)) {
+            d = m.mk_fresh_func_decl(pred->get_name(), symbol("delta"), pred->get_arity(), pred->get_domain(), pred->get_range());
+            m_new_fact_decls.push_back(d);
+            inherit_predicate_kind(d, pred);
+            m_new_facts.insert(pred, d);
+        }
+        return &get_relation(d);
+    }
+
     lbool rel_context::saturate(scoped_query& sq) {
         m_context.ensure_closed();        
         unsigned remaining_time_limit = m_context.soft_timeout();
@@ -142,12 +283,28 @@ namespace datalog {
 
         TRACE("dl", m_context.display(tout););
 
+        bool incremental = m_context.incremental();
+        rule_ref_vector src(m_context.get_rule_manager());
+        if (incremental) {
+            collect_source_rules(src);
+        }
+        bool use_fixpoint = incremental && install_fixpoint_rules(src);
+
         while (true) {
             m_ectx.reset();
             m_code.reset();
             termination_code.reset();
             m_context.ensure_closed();
-            transform_rules();
+            if (!use_fixpoint) {
+                if (incremental) {
+                    // the fixpoint is kept for later queries, so it is computed for all predicates
+                    rule_set const& rules = m_context.get_rules();
+                    for (unsigned i = 0; i < rules.get_num_rules(); ++i) {
+                        m_context.set_output_predicate(rules.get_rule(i)->get_decl());
+                    }
+                }
+                transform_rules();
+            }
             if (m_context.canceled()) {
                 TRACE("dl", tout << "canceled\n";);
                 result = l_undef;
@@ -167,7 +324,13 @@ namespace datalog {
             ::stopwatch sw;
             sw.start();
 
-            compiler::compile(m_context, m_context.get_rules(), m_code, termination_code);
+            if (use_fixpoint) {
+                compiler::compile_incremental(m_context, m_context.get_rules(), m_fixpoint_heads, m_new_facts, 
+                                              m_code, termination_code);
+            }
+            else {
+                compiler::compile(m_context, m_context.get_rules(), m_code, termination_code);
+            }
 
             bool timeout_after_this_round = time_limit && (restart_time==0 || remaining_time_limit<=restart_time);
 
@@ -197,6 +360,9 @@ namespace datalog {
             if (!early_termination) {
                 m_context.set_status(OK);
                 result = l_true;
+                if (incremental && !use_fixpoint) {
+                    save_fixpoint(src);
+                }
                 break;
             }
             if (memory::above_high_watermark()) {
@@ -223,13 +389,22 @@ namespace datalog {
                 restart_time = static_cast<unsigned>(new_restart_time);
             }
             sq.reset();
+            use_fixpoint = false;
+            reset_fixpoint();
+        }
+        if (result == l_undef) {
+            reset_fixpoint();
         }
+        // the relations of the new facts are removed with the other temporary relations
+        m_new_facts.reset();
+        m_new_fact_decls.reset();
         m_context.record_transformed_rules();
         TRACE("dl", display_profile(tout););
         return result;
     }
  
     lbool rel_context::query(unsigned num_rels, func_decl * const* rels) {
+        m_query_pred = nullptr;
         setup_default_relation();
         get_rmanager().reset_saturated_marks();
         scoped_query _scoped_query(m_context);
@@ -316,7 +491,121 @@ namespace datalog {
             transf.register_plugin(alloc(mk_bit_blast, m_context, 22000));
             transf.register_plugin(alloc(mk_interp_tail_simplifier, m_context, 21000));
         }
+        transform_rules(transf, m_xform);
+    }
+
+    /**
+       \brief the transformations depend only on the rules and on the non-empty relations,
+       unless they produce explanations or proofs.
+    */
+    bool rel_context::can_reuse_transformation() const {
+        return m_context.reuse_transformations() && 
+            !m_context.generate_explanations() && 
+            !m_context.generate_proof_trace();
+    }
+
+    static bool is_same_rule(rule const& r1, rule const& r2) {
+        if (&r1 == &r2) {
+            return true;
+        }
+        unsigned sz = r1.get_tail_size();
+        if (r1.get_head() != r2.get_head() || 
+            sz != r2.get_tail_size() ||
+            r1.get_uninterpreted_tail_size() != r2.get_uninterpreted_tail_size() ||
+            r1.get_positive_tail_size() != r2.get_positive_tail_size()) {
+            return false;
+        }
+        for (unsigned i = 0; i < sz; ++i) {
+            if (r1.get_tail(i) != r2.get_tail(i) || r1.is_neg_tail(i) != r2.is_neg_tail(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool is_same_rule_set(rule_set const& rs1, rule_set const& rs2) {
+        if (rs1.get_num_rules() != rs2.get_num_rules() ||
+            rs1.get_output_predicates().size() != rs2.get_output_predicates().size()) {
+            return false;
+        }
+        for (func_decl* p : rs1.get_output_predicates()) {
+            if (!rs2.is_output_predicate(p)) {
+                return false;
+            }
+        }
+        for (unsigned i = 0; i < rs1.get_num_rules(); ++i) {
+            if (!is_same_rule(*rs1.get_rule(i), *rs2.get_rule(i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool is_same_set(func_decl_set const& s1, func_decl_set const& s2) {
+        if (s1.size() != s2.size()) {
+            return false;
+        }
+        for (func_decl* p : s1) {
+            if (!s2.contains(p)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+       \brief Apply transf to the rules of the context, or install the rules of xf 
+       if they were obtained by transforming the same rules with the same non-empty relations.
+       The model converter added by the transformation is kept with the rules.
+    */
+    void rel_context::transform_rules(rule_transformer& transf, transformation& xf) {
+        model_converter_ref mc = m_context.get_model_converter();
+        if (!mc || !can_reuse_transformation()) {
+            xf.reset();
+            m_context.transform_rules(transf);
+            return;
+        }
+        func_decl_set non_empty;
+        collect_non_empty_predicates(non_empty);
+        if (xf.m_valid && is_same_rule_set(m_context.get_rules(), xf.m_src) && is_same_set(non_empty, xf.m_non_empty)) {
+            // the predicates introduced by the transformation were removed after the earlier query
+            for (rule* r : xf.m_dst) {
+                m_context.register_predicate(r->get_decl(), false);
+                for (unsigned i = 0; i < r->get_uninterpreted_tail_size(); ++i) {
+                    m_context.register_predicate(r->get_decl(i), false);
+                }
+            }
+            for (func_decl* p : xf.m_dst.get_output_predicates()) {
+                m_context.register_predicate(p, false);
+            }
+            m_context.reopen();
+            m_context.replace_rules(xf.m_dst);
+            m_context.close();
+            m_context.add_model_converter(xf.m_mc.get());
+            ++m_num_reused_xforms;
+            IF_VERBOSE(10, verbose_stream() << "(datalog.reuse_transformations :rules " << xf.m_dst.get_num_rules() << ")\n";);
+            return;
+        }
+        xf.reset();
+        xf.m_src.replace_rules(m_context.get_rules());
+        m_context.get_model_converter() = mk_skip_model_converter();
         m_context.transform_rules(transf);
+        xf.m_mc = m_context.get_model_converter();
+        m_context.get_model_converter() = mc;
+        m_context.add_model_converter(xf.m_mc.get());
+        rule_set const& dst = m_context.get_rules();
+        for (rule* r : dst) {
+            for (unsigned i = 0; i < r->get_uninterpreted_tail_size(); ++i) {
+                if (get_rmanager().is_saturated(r->get_decl(i))) {
+                    // the relation was filled by the transformation and is removed after the query
+                    xf.reset();
+                    return;
+                }
+            }
+        }
+        xf.m_dst.replace_rules(dst);
+        xf.m_non_empty.swap(non_empty);
+        xf.m_valid = true;
     }
 
     bool rel_context::try_get_size(func_decl* p, unsigned& rel_size) const {
@@ -336,13 +625,19 @@ namespace datalog {
         scoped_query _scoped_query(m_context);
         rule_manager& rm = m_context.get_rule_manager();
         func_decl_ref query_pred(m);
+        if (m_query_pred && m_last_query.get() == query && can_reuse_transformation()) {
+            // the same query produces the same rules if it keeps its predicate
+            query_pred = m_query_pred;
+        }
         try {
-            query_pred = rm.mk_query(query, m_context.get_rules());
+            query_pred = rm.mk_query(query, m_context.get_rules(), query_pred);
         }
         catch (default_exception& exn) {
             m_context.set_status(INPUT_ERROR);
             throw exn;
         }
+        m_query_pred = query_pred;
+        m_last_query = query;
         
         m_context.close();
         reset_negated_tables();
@@ -354,7 +649,10 @@ namespace datalog {
         query_pred = m_context.get_rules().get_pred(query_pred);
 
         if (m_context.magic_sets_for_queries()) {
-            m_context.transform_rules(alloc(mk_magic_sets, m_context, query_pred));
+            flet<bool> _enable_bv(m_context.bind_vars_enabled(), false);
+            rule_transformer transf(m_context);
+            transf.register_plugin(alloc(mk_magic_sets, m_context, query_pred));
+            transform_rules(transf, m_magic_xform);
             query_pred = m_context.get_rules().get_pred(query_pred);
         }
 
@@ -447,7 +745,22 @@ namespace datalog {
     }
 
     void rel_context::restrict_predicates(func_decl_set const& predicates) {
-        get_rmanager().restrict_predicates(predicates);
+        if (!m_fixpoint_rules && m_new_facts.empty()) {
+            get_rmanager().restrict_predicates(predicates);
+            return;
+        }
+        // keep the relations of the auxiliary predicates of the fixpoint and of the new facts
+        func_decl_set preds;
+        for (func_decl* p : predicates) {
+            preds.insert(p);
+        }
+        for (func_decl* p : m_fixpoint_preds) {
+            preds.insert(p);
+        }
+        for (auto const& kv : m_new_facts) {
+            preds.insert(kv.m_value);
+        }
+        get_rmanager().restrict_predicates(preds);
     }
 
     relation_base & rel_context::get_relation(func_decl * pred)  { return get_rmanager().get_relation(pred); }
@@ -552,6 +865,9 @@ namespace datalog {
     void rel_context::add_fact(func_decl* pred, relation_fact const& fact) {
         get_rmanager().reset_saturated_marks();
         get_relation(pred).add_fact(fact);
+        if (relation_base* new_facts = get_new_facts(pred)) {
+            new_facts->add_fact(fact);
+        }
         if (!m_context.print_aig().is_null()) {
             m_table_facts.push_back(std::make_pair(pred, fact));
         }
@@ -563,6 +879,9 @@ namespace datalog {
         if (rel0.from_table()) {
             table_relation & rel = static_cast<table_relation &>(rel0);
             rel.add_table_fact(fact);
+            if (relation_base* new_facts = get_new_facts(pred)) {
+                static_cast<table_relation &>(*new_facts).add_table_fact(fact);
+            }
             // TODO: table facts?
         }
         else {
@@ -585,11 +904,16 @@ namespace datalog {
 
     void rel_context::collect_statistics(statistics& st) const {
         st.update("saturation time", m_sw);
+        if (m_num_reused_xforms > 0) {
+            st.update("datalog reused transformations", m_num_reused_xforms);
+        }
         m_code.collect_statistics(st);
         m_ectx.collect_statistics(st);
     }
 
     void rel_context::updt_params() {
+        m_xform.reset();
+        m_magic_xform.reset();
         if (m_context.check_relation() != symbol::null &&
             m_context.check_relation() != symbol("null")) {
             symbol cr("check_relation");
@@ -42,9 +42,44 @@ namespace datalog {
         instruction_block  m_code;
         double             m_sw;
 
+        // datalog.incremental: the relations of m_fixpoint_heads are a fixpoint of m_fixpoint_rules,
+        // that were obtained from m_fixpoint_src, for the facts added before those in m_new_facts.
+        scoped_ptr<rule_set> m_fixpoint_rules;
+        func_decl_set      m_fixpoint_preds;
+        func_decl_set      m_fixpoint_heads;
+        rule_ref_vector    m_fixpoint_src;
+        obj_map<func_decl, func_decl*> m_new_facts;    // predicate -> predicate of the facts added since
+        func_decl_ref_vector m_new_fact_decls;
+        func_decl_ref      m_query_pred;
+
+        // datalog.reuse_transformations: m_dst and the model converter m_mc were obtained by
+        // transforming m_src while the relations of m_non_empty were the non-empty relations.
+        struct transformation {
+            bool                m_valid = false;
+            rule_set            m_src;
+            rule_set            m_dst;
+            func_decl_set       m_non_empty;
+            model_converter_ref m_mc;
+            transformation(context& ctx): m_src(ctx), m_dst(ctx) {}
+            void reset() { m_valid = false; m_src.reset(); m_dst.reset(); m_non_empty.reset(); m_mc = nullptr; }
+        };
+        transformation     m_xform;
+        transformation     m_magic_xform;
+        expr_ref           m_last_query;
+        unsigned           m_num_reused_xforms = 0;
+
         class scoped_query;
 
         void reset_negated_tables();
+
+        void collect_source_rules(rule_ref_vector& src) const;
+        bool install_fixpoint_rules(rule_ref_vector const& src);
+        void save_fixpoint(rule_ref_vector const& src);
+        void reset_fixpoint();
+        relation_base* get_new_facts(func_decl* pred);
+
+        bool can_reuse_transformation() const;
+        void transform_rules(rule_transformer& transf, transformation& xf);
         
         relation_plugin & get_ordinary_relation_plugin(symbol relation_name);
         
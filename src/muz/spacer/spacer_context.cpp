@@ -757,6 +757,7 @@ void pred_transformer::collect_statistics(statistics& st) const
     // -- number of times a lemma has been propagated to a higher level
     // -- during push
     st.update("SPACER num propagations", m_stats.m_num_propagations);
+    st.update("SPACER num subsumed lemmas", m_stats.m_num_subsumed_lemmas);
     // -- number of lemmas in all current frames
     st.update("SPACER num active lemmas", m_frames.lemma_size ());
     // -- number of lemmas that are inductive invariants
@@ -1346,7 +1347,8 @@ bool pred_transformer::is_qblocked (pob &n) {
 void pred_transformer::mbp(app_ref_vector &vars, expr_ref &fml, model &mdl,
                            bool reduce_all_selects, bool force) {
     scoped_watch _t_(m_mbp_watch);
-    qe_project(m, vars, fml, mdl, reduce_all_selects, use_native_mbp(), !force);
+    qe_project(m, vars, fml, mdl, reduce_all_selects, use_native_mbp(), !force,
+               &ctx.get_mbp());
 }
 
 //
@@ -2008,62 +2010,74 @@ bool pred_transformer::frames::add_lemma(lemma *new_lemma)
         return true;
     }
 
-    unsigned i = 0;
-    for (auto *old_lemma : m_lemmas) {
-        if (old_lemma->get_expr() == new_lemma->get_expr()) {
-            m_pt.get_context().new_lemma_eh(m_pt, new_lemma);
+    lemma *old_lemma = nullptr;
+    if (m_expr2lemma.find(new_lemma->get_expr(), old_lemma)) {
+        m_pt.get_context().new_lemma_eh(m_pt, new_lemma);
 
-            // register existing lemma with the pob
-            if (new_lemma->has_pob()) {
-                pob_ref &pob = new_lemma->get_pob();
-                if (!pob->lemmas().contains(old_lemma))
-                    pob->add_lemma(old_lemma);
-            }
+        // register existing lemma with the pob
+        if (new_lemma->has_pob()) {
+            pob_ref &pob = new_lemma->get_pob();
+            if (!pob->lemmas().contains(old_lemma))
+                pob->add_lemma(old_lemma);
+        }
 
-            // extend bindings if needed
+        // extend bindings if needed
+        if (!new_lemma->get_bindings().empty()) {
+            old_lemma->add_binding(new_lemma->get_bindings());
+        }
+        // if the lemma is at a higher level, skip it,
+        if (old_lemma->level() >= new_lemma->level()) {
+            TRACE("spacer", tout << "Already at a higher level: "
+                  << pp_level(old_lemma->level()) << "\n";);
+            // but, since the instances might be new, assert the
+            // instances that have been copied into m_lemmas[i]
             if (!new_lemma->get_bindings().empty()) {
-                old_lemma->add_binding(new_lemma->get_bindings());
+                m_pt.add_lemma_core(old_lemma, true);
             }
-            // if the lemma is at a higher level, skip it,
-            if (old_lemma->level() >= new_lemma->level()) {
-                TRACE("spacer", tout << "Already at a higher level: "
-                      << pp_level(old_lemma->level()) << "\n";);
-                // but, since the instances might be new, assert the
-                // instances that have been copied into m_lemmas[i]
-                if (!new_lemma->get_bindings().empty()) {
-                    m_pt.add_lemma_core(old_lemma, true);
+            if (is_infty_level(old_lemma->level())) {
+                old_lemma->bump();
+                if (old_lemma->get_bumped() >= 100) {
+                    IF_VERBOSE(1, verbose_stream() << "Adding lemma to oo "
+                               << old_lemma->get_bumped() << " "
+                               << mk_pp(old_lemma->get_expr(),
+                                        m_pt.get_ast_manager()) << "\n";);
+                    throw default_exception("Stuck on a lemma");
                 }
-                if (is_infty_level(old_lemma->level())) {
-                    old_lemma->bump();
-                    if (old_lemma->get_bumped() >= 100) {
-                        IF_VERBOSE(1, verbose_stream() << "Adding lemma to oo "
-                                   << old_lemma->get_bumped() << " "
-                                   << mk_pp(old_lemma->get_expr(),
-                                            m_pt.get_ast_manager()) << "\n";);
-                        throw default_exception("Stuck on a lemma");
-                    }
-                }
-                // no new lemma added
-                return false;
             }
+            // no new lemma added
+            return false;
+        }
 
-            // update level of the existing lemma
-            old_lemma->set_level(new_lemma->level());
-            // assert lemma in the solver
-            m_pt.add_lemma_core(old_lemma, false);
-            // move the lemma to its new place to maintain sortedness
-            unsigned sz = m_lemmas.size();
-            for (unsigned j = i;
-                 (j + 1) < sz && m_lt(m_lemmas[j + 1], m_lemmas[j]); ++j) {
-                m_lemmas.swap (j, j+1);
-            }
-            return true;
+        // update level of the existing lemma
+        unsigned i = m_sorted ? find_position(old_lemma) : 0;
+        old_lemma->set_level(new_lemma->level());
+        // assert lemma in the solver
+        m_pt.add_lemma_core(old_lemma, false);
+        // move the lemma to its new place to maintain sortedness
+        unsigned sz = m_sorted ? m_lemmas.size() : 0;
+        for (unsigned j = i;
+             (j + 1) < sz && m_lt(m_lemmas[j + 1], m_lemmas[j]); ++j) {
+            m_lemmas.swap (j, j+1);
         }
-        i++;
+        return true;
+    }
+
+    old_lemma = find_subsuming(new_lemma);
+    if (old_lemma) {
+        TRACE("spacer", tout << "Subsumed by: " << pp_level(old_lemma->level()) << " "
+              << mk_pp(old_lemma->get_expr(), m_pt.get_ast_manager()) << "\n";);
+        if (new_lemma->has_pob()) {
+            pob_ref &pob = new_lemma->get_pob();
+            if (!pob->lemmas().contains(old_lemma))
+                pob->add_lemma(old_lemma);
+        }
+        ++m_pt.m_stats.m_num_subsumed_lemmas;
+        return false;
     }
 
     // new_lemma is really new
     m_lemmas.push_back(new_lemma);
+    index_lemma(new_lemma);
     // XXX because m_lemmas is reduced, keep secondary vector of all lemmas
     // XXX so that pob can refer to its lemmas without creating reference cycles
     m_pinned_lemmas.push_back(new_lemma);
@@ -2079,6 +2093,62 @@ bool pred_transformer::frames::add_lemma(lemma *new_lemma)
 }
 
 
+void pred_transformer::frames::index_lemma(lemma *lem)
+{
+    m_expr2lemma.insert(lem->get_expr(), lem);
+    if (lem->is_ground()) {
+        expr_ref_vector const &cube = lem->get_cube();
+        if (!cube.empty()) {
+            m_watch.insert_if_not_there(cube.get(0), ptr_vector<lemma>()).push_back(lem);
+        }
+    }
+}
+
+void pred_transformer::frames::reindex()
+{
+    m_expr2lemma.reset();
+    m_watch.reset();
+    for (lemma *lem : m_lemmas) { index_lemma(lem); }
+}
+
+/// Find a ground lemma at the same or a higher level whose cube is a subset
+/// of the cube of new_lemma. Such a lemma implies new_lemma. Every ground
+/// lemma is watched by one literal of its cube, so only the lemmas watched by
+/// a literal of new_lemma have to be checked.
+lemma *pred_transformer::frames::find_subsuming(lemma *new_lemma)
+{
+    if (m_watch.empty() || !new_lemma->is_ground()) { return nullptr; }
+    expr_ref_vector const &cube = new_lemma->get_cube();
+    expr_fast_mark1 lits;
+    for (expr *e : cube) { lits.mark(e); }
+    lemma *result = nullptr;
+    for (unsigned i = 0; !result && i < cube.size(); ++i) {
+        auto *e = m_watch.find_core(cube.get(i));
+        if (!e) { continue; }
+        for (lemma *old_lemma : e->get_data().m_value) {
+            if (old_lemma->level() < new_lemma->level()) { continue; }
+            if (all_of(old_lemma->get_cube(),
+                       [&](expr *l) { return lits.is_marked(l); })) {
+                result = old_lemma;
+                break;
+            }
+        }
+    }
+    lits.reset();
+    return result;
+}
+
+/// position of lem in the sorted m_lemmas
+unsigned pred_transformer::frames::find_position(lemma *lem)
+{
+    SASSERT(m_sorted);
+    lemma *const *begin = m_lemmas.data();
+    unsigned i = std::lower_bound(begin, begin + m_lemmas.size(), lem, m_lt) - begin;
+    if (i < m_lemmas.size() && m_lemmas.get(i) == lem) { return i; }
+    UNREACHABLE();
+    return m_lemmas.size();
+}
+
 void pred_transformer::frames::propagate_to_infinity (unsigned level)
 {
     for (unsigned i = 0, sz = m_lemmas.size (); i < sz; ++i)
@@ -2108,7 +2178,12 @@ bool pred_transformer::frames::propagate_to_next_level (unsigned level)
     unsigned tgt_level = next_level (level);
     m_pt.ensure_level (tgt_level);
 
-    for (unsigned i = 0, sz = m_lemmas.size(); i < sz && m_lemmas [i]->level() <= level;) {
+    // skip the lemmas of the lower levels
+    lemma *const *begin = m_lemmas.data();
+    unsigned first = std::lower_bound(begin, begin + m_lemmas.size(), level,
+                                      [](lemma *l, unsigned lvl) { return l->level() < lvl; }) - begin;
+
+    for (unsigned i = first, sz = m_lemmas.size(); i < sz && m_lemmas [i]->level() <= level;) {
         if (m_lemmas [i]->level () < level) {++i; continue;}
 
         unsigned solver_level;
@@ -2230,6 +2305,7 @@ void pred_transformer::frames::simplify_formulas ()
         m_lemmas.append(new_lemmas);
         m_sorted = false;
         sort();
+        reindex();
     }
 }
 
@@ -2300,6 +2376,7 @@ context::context(fp_params const& params, ast_manager& m) :
     m_expanded_lvl(0),
     m_global_gen(nullptr),
     m_expand_bnd_gen(nullptr),
+    m_mbp(m),
     m_trace_stream(nullptr) {
 
     params_ref p;
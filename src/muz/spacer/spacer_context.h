@@ -32,6 +32,7 @@ Notes:
 #include "muz/spacer/spacer_prop_solver.h"
 #include "muz/spacer/spacer_sem_matcher.h"
 #include "util/scoped_ptr_vector.h"
+#include "qe/qe_mbp.h"
 
 #include "muz/base/fp_params.hpp"
 
@@ -222,6 +223,8 @@ class pred_transformer {
         unsigned m_num_lemma_level_jump; // lemma learned at higher level than
                                          // expected
         unsigned m_num_reach_queries;
+        unsigned m_num_subsumed_lemmas;  // num of lemmas subsumed by a lemma
+                                         // at the same or a higher level
         // clang-format on
         // clang-format off
 
@@ -242,10 +245,16 @@ class pred_transformer {
 
         bool m_sorted;                     // true if m_lemmas is sorted by m_lt
         lemma_lt_proc m_lt;                // sort order for m_lemmas
+        obj_map<expr, lemma*> m_expr2lemma; // m_lemmas by their expression
+        obj_map<expr, ptr_vector<lemma>> m_watch; // ground m_lemmas by the first literal of their cube
         // clang-format on
         // clang-format off
 
         void sort();
+        void index_lemma(lemma *lem);
+        void reindex();
+        lemma *find_subsuming(lemma *new_lemma);
+        unsigned find_position(lemma *lem);
 
       public:
         frames(pred_transformer &pt) : m_pt(pt), m_size(0), m_sorted(true) {}
@@ -1153,6 +1162,7 @@ class context {
     stats                m_stats;
     model_converter_ref  m_mc;
     proof_converter_ref  m_pc;
+    qe::mbproj           m_mbp;          // projection session shared by all MBP calls
     bool                 m_use_native_mbp;
     bool                 m_instantiate;
     bool                 m_use_qlemmas;
@@ -1271,6 +1281,7 @@ class context {
     const fp_params &get_params() const { return m_params; }
     bool use_eq_prop() const { return m_use_eq_prop; }
     bool use_native_mbp() const { return m_use_native_mbp; }
+    qe::mbproj &get_mbp() { return m_mbp; }
     bool use_ground_pob() const { return m_ground_pob; }
     bool use_instantiate() const { return m_instantiate; }
     bool weak_abs() const { return m_weak_abs; }
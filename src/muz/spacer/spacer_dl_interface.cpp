@@ -35,16 +35,110 @@ Revision History:
 #include "ast/scoped_proof.h"
 #include "muz/transforms/dl_transforms.h"
 #include "muz/spacer/spacer_callback.h"
+#include "ast/ast_translation.h"
+#include "util/mutex.h"
+#include "util/thread_pool.h"
 
 using namespace spacer;
 
+namespace {
+
+    // The workers only use the datalog context to hold their rules.
+    class no_engines : public datalog::register_engine_base {
+    public:
+        datalog::engine_base* mk_engine(datalog::DL_ENGINE engine_type) override { return nullptr; }
+        void set_context(datalog::context* ctx) override {}
+    };
+
+    /**
+       Lemmas learned by the parallel workers. The lemmas are kept in the manager
+       of the main context, that is only used under the lock while workers solve.
+    */
+    class lemma_exchange {
+        mutex      m_mux;
+        ast_manager&    m;
+        expr_ref_vector m_lemmas;
+        unsigned_vector m_levels;
+        unsigned_vector m_origins;
+    public:
+        lemma_exchange(ast_manager& m): m(m), m_lemmas(m) {}
+
+        void publish(unsigned id, ast_manager& src, expr* lemma, unsigned lvl) {
+            lock_guard lock(m_mux);
+            ast_translation tr(src, m);
+            m_lemmas.push_back(tr(lemma));
+            m_levels.push_back(lvl);
+            m_origins.push_back(id);
+        }
+
+        // retrieve the lemmas of the other workers published since lim
+        void collect(unsigned id, ast_manager& dst, unsigned& lim, expr_ref_vector& lemmas, unsigned_vector& levels) {
+            lock_guard lock(m_mux);
+            ast_translation tr(m, dst);
+            for (; lim < m_lemmas.size(); ++lim) {
+                if (m_origins[lim] != id) {
+                    lemmas.push_back(tr(m_lemmas.get(lim)));
+                    levels.push_back(m_levels[lim]);
+                }
+            }
+        }
+
+        unsigned size() const { return m_lemmas.size(); }
+    };
+
+    // Publishes the lemmas of a worker and imports the lemmas of the others when a level is unfolded.
+    class lemma_exchange_callback : public spacer_callback {
+        lemma_exchange& m_exchange;
+        unsigned        m_id;
+        unsigned        m_lim;
+    public:
+        lemma_exchange_callback(context& ctx, lemma_exchange& ex, unsigned id):
+            spacer_callback(ctx), m_exchange(ex), m_id(id), m_lim(0) {}
+
+        bool new_lemma() override { return true; }
+
+        void new_lemma_eh(expr* lemma, unsigned level) override {
+            m_exchange.publish(m_id, m_context.get_ast_manager(), lemma, level);
+        }
+
+        bool unfold() override { return true; }
+
+        void unfold_eh() override {
+            ast_manager& m = m_context.get_ast_manager();
+            expr_ref_vector lemmas(m);
+            unsigned_vector levels;
+            m_exchange.collect(m_id, m, m_lim, lemmas, levels);
+            for (unsigned i = 0; i < lemmas.size(); ++i) {
+                m_context.add_constraint(lemmas.get(i), levels[i]);
+            }
+        }
+    };
+
+    struct spacer_worker {
+        ast_manager                     m;
+        smt_params                      m_fparams;
+        no_engines                      m_engines;
+        datalog::context                m_dctx;
+        scoped_ptr<datalog::rule_set>   m_rules;
+        scoped_ptr<context>             m_spacer;
+        lbool                           m_result;
+
+        spacer_worker(ast_manager& src, params_ref const& p):
+            m(src, true),
+            m_dctx(m, m_engines, m_fparams, p),
+            m_result(l_undef) {}
+    };
+}
+
 dl_interface::dl_interface(datalog::context& ctx) :
     engine_base(ctx.get_manager(), "spacer"),
     m_ctx(ctx),
     m_spacer_rules(ctx),
     m_old_rules(ctx),
     m_context(nullptr),
-    m_refs(ctx.get_manager())
+    m_refs(ctx.get_manager()),
+    m_par_solved(false),
+    m_par_answer(ctx.get_manager())
 {
     m_context = alloc(spacer::context, ctx.get_params(), ctx.get_manager());
 }
@@ -164,7 +258,7 @@ lbool dl_interface::query(expr * query)
         return l_false;
     }
 
-    return m_context->solve(m_ctx.get_params().spacer_min_level());
+    return solve(query_pred, m_ctx.get_params().spacer_min_level());
 
 }
 
@@ -257,8 +351,130 @@ lbool dl_interface::query_from_lvl(expr * query, unsigned lvl)
         return l_false;
     }
 
+    return solve(query_pred, lvl);
+
+}
+
+lbool dl_interface::solve(func_decl* query_pred, unsigned lvl)
+{
+    m_par_solved = false;
+    m_par_model = nullptr;
+    m_par_answer = nullptr;
+    m_par_stats.reset();
+    unsigned num_threads = m_ctx.get_params().spacer_threads();
+#ifdef SINGLE_THREAD
+    num_threads = 1;
+#endif
+    ast_manager& m = m_ctx.get_manager();
+    if (num_threads <= 1 || m.proofs_enabled() || m.has_trace_stream() || m_ctx.get_params().spacer_gpdr()) {
+        return m_context->solve(lvl);
+    }
+    return solve_parallel(query_pred, lvl, num_threads);
+}
+
+/**
+   Run num_threads Spacer instances on copies of the rules in their own managers.
+   The instances differ in their random seed and in the order in which they
+   enqueue the children of non-linear rules. Lemmas are valid for a level
+   independently of the instance that learned them, so every instance
+   publishes its lemmas and imports the lemmas of the others. The first
+   instance that solves the query cancels the others.
+*/
+lbool dl_interface::solve_parallel(func_decl* query_pred, unsigned lvl, unsigned num_threads)
+{
+#ifdef SINGLE_THREAD
     return m_context->solve(lvl);
+#else
+    ast_manager& m = m_ctx.get_manager();
+    scoped_ptr_vector<spacer_worker> workers;
+    lemma_exchange exchange(m);
+    unsigned seed = m_ctx.get_params().spacer_random_seed();
+    for (unsigned i = 0; i < num_threads; ++i) {
+        params_ref p(m_ctx.get_params_ref());
+        p.set_uint("spacer.random_seed", seed + i);
+        p.set_uint("spacer.order_children", (m_ctx.get_params().spacer_order_children() + i) % 3);
+        p.set_bool("spacer.p3.share_lemmas", true);
+        p.set_bool("spacer.p3.share_invariants", true);
+        workers.push_back(alloc(spacer_worker, m, p));
+        spacer_worker& w = *workers.back();
+        ast_translation tr(m, w.m);
+        datalog::rule_manager& rm = w.m_dctx.get_rule_manager();
+        w.m_rules = alloc(datalog::rule_set, w.m_dctx);
+        for (datalog::rule* r : m_spacer_rules) {
+            app_ref head(tr(r->get_head()), w.m);
+            app_ref_vector tail(w.m);
+            bool_vector neg;
+            for (unsigned j = 0; j < r->get_tail_size(); ++j) {
+                tail.push_back(tr(r->get_tail(j)));
+                neg.push_back(r->is_neg_tail(j));
+            }
+            w.m_rules->add_rule(rm.mk(head, tail.size(), tail.data(), neg.data(), r->name(), false));
+        }
+        func_decl_ref q(tr(query_pred), w.m);
+        w.m_rules->set_output_predicate(q);
+        w.m_rules->close();
+        w.m_spacer = alloc(context, w.m_dctx.get_params(), w.m);
+        if (m_ctx.get_model_converter()) {
+            model_converter_ref mc = m_ctx.get_model_converter()->translate(tr);
+            w.m_spacer->set_model_converter(mc);
+        }
+        w.m_spacer->set_query(q);
+        w.m_spacer->update_rules(*w.m_rules);
+        w.m_spacer->callbacks().push_back(alloc(lemma_exchange_callback, *w.m_spacer, exchange, i));
+    }
 
+    scoped_limits sl(m.limit());
+    for (spacer_worker* w : workers) {
+        sl.push_child(&(w->m.limit()));
+    }
+
+    mutex mux;
+    unsigned winner = UINT_MAX;
+    std::string ex_msg;
+    auto run = [&](unsigned i) {
+        spacer_worker& w = *workers[i];
+        try {
+            w.m_result = w.m_spacer->solve(lvl);
+        }
+        catch (z3_exception& ex) {
+            lock_guard lock(mux);
+            if (winner == UINT_MAX && ex_msg.empty()) {
+                ex_msg = ex.msg();
+            }
+            return;
+        }
+        lock_guard lock(mux);
+        if (w.m_result != l_undef && winner == UINT_MAX) {
+            winner = i;
+            for (unsigned j = 0; j < workers.size(); ++j) {
+                if (j != i) {
+                    workers[j]->m.limit().cancel();
+                }
+            }
+        }
+    };
+    thread_pool::run(num_threads, run);
+
+    IF_VERBOSE(1, verbose_stream() << "(spacer.threads :winner " << (int)winner << " :lemmas " << exchange.size() << ")\n";);
+    if (winner == UINT_MAX) {
+        if (!ex_msg.empty()) {
+            throw default_exception(std::move(ex_msg));
+        }
+        return l_undef;
+    }
+    spacer_worker& w = *workers[winner];
+    ast_translation tr(w.m, m);
+    m_par_solved = true;
+    m_par_answer = tr(w.m_spacer->get_answer().get());
+    if (w.m_result == l_false) {
+        model_ref md = w.m_spacer->get_model();
+        if (md) {
+            m_par_model = md->translate(tr);
+        }
+    }
+    w.m_spacer->collect_statistics(m_par_stats);
+    return w.m_result;
+#endif
 }
 
 expr_ref dl_interface::get_cover_delta(int level, func_decl* pred_orig)
@@ -303,6 +519,10 @@ unsigned dl_interface::get_num_levels(func_decl* pred)
 
 void dl_interface::collect_statistics(statistics& st) const
 {
+    if (m_par_solved) {
+        st.copy(m_par_stats);
+        return;
+    }
     m_context->collect_statistics(st);
 }
 
@@ -313,11 +533,18 @@ void dl_interface::reset_statistics()
 
 void dl_interface::display_certificate(std::ostream& out) const
 {
+    if (m_par_solved) {
+        out << mk_pp(m_par_answer, m_ctx.get_manager()) << "\n";
+        return;
+    }
     m_context->display_certificate(out);
 }
 
 expr_ref dl_interface::get_answer()
 {
+    if (m_par_solved) {
+        return m_par_answer;
+    }
     return m_context->get_answer();
 }
 
@@ -339,6 +566,9 @@ void dl_interface::updt_params()
 
 model_ref dl_interface::get_model()
 {
+    if (m_par_solved) {
+        return m_par_model;
+    }
     return m_context->get_model();
 }
 
@@ -39,9 +39,17 @@ class dl_interface : public datalog::engine_base {
     context*          m_context;
     obj_map<func_decl, func_decl*> m_pred2slice;
     ast_ref_vector    m_refs;
+    // result of the last query when it was solved by a parallel worker
+    bool              m_par_solved;
+    model_ref         m_par_model;
+    expr_ref          m_par_answer;
+    statistics        m_par_stats;
 
     void check_reset();
 
+    lbool solve(func_decl* query_pred, unsigned lvl);
+    lbool solve_parallel(func_decl* query_pred, unsigned lvl, unsigned num_threads);
+
 public:
     dl_interface(datalog::context& ctx);
     ~dl_interface() override;
@@ -130,7 +130,7 @@ bool all_same_sz(ast_manager &m, const substitution &sub, unsigned sz) {
 namespace spacer {
 lemma_global_generalizer::subsumer::subsumer(ast_manager &a_m, bool ground_pob)
     : m(a_m), m_arith(m), m_bv(m), m_tags(m), m_used_tags(0), m_col_names(m),
-      m_ground_pob(ground_pob) {
+      m_ground_pob(ground_pob), m_mbp(m) {
     scoped_ptr<solver_factory> factory(
         mk_smt_strategic_solver_factory(symbol::null));
     m_solver = (*factory)(m, params_ref::get_empty(), false, true, false,
@@ -399,7 +399,8 @@ bool lemma_global_generalizer::subsumer::subsume(const lemma_cluster &lc,
         conj = mk_and(vec);
         vars.append(alphas.size(),
                     reinterpret_cast<app *const *>(alphas.data()));
-        qe_project(m, vars, conj, *mdl.get(), true, true, !m_ground_pob);
+        qe_project(m, vars, conj, *mdl.get(), true, true, !m_ground_pob,
+               &m_mbp);
 
         // mbp failed, not expected, bail out
         if (!vars.empty()) return false;
@@ -429,7 +430,8 @@ bool lemma_global_generalizer::subsumer::subsume(const lemma_cluster &lc,
     vars.append(m_col_names.size(),
                 reinterpret_cast<app *const *>(m_col_names.data()));
     conj = mk_and(vec);
-    qe_project(m, vars, conj, *mdl.get(), true, true, !m_ground_pob);
+    qe_project(m, vars, conj, *mdl.get(), true, true, !m_ground_pob,
+               &m_mbp);
 
     // failed
     if (!vars.empty()) return false;
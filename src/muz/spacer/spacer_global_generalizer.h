@@ -66,6 +66,9 @@ class lemma_global_generalizer : public lemma_generalizer {
         // cvx_cls  ==> mbp
         ref<solver> m_solver;
 
+        // projection session reused by the mbp calls of the subsumer
+        qe::mbproj m_mbp;
+
         /// Return a fresh boolean variable
         app *mk_fresh_tag();
 
@@ -132,11 +132,16 @@ void to_mbp_benchmark(std::ostream &out, expr *fml,
 
 void qe_project_z3(ast_manager &m, app_ref_vector &vars, expr_ref &fml,
                    model &mdl, bool reduce_all_selects, bool use_native_mbp,
-                   bool dont_sub) {
+                   bool dont_sub, qe::mbproj *session) {
     params_ref p;
     p.set_bool("reduce_all_selects", reduce_all_selects);
     p.set_bool("dont_sub", dont_sub);
 
+    if (session) {
+        session->updt_params(p);
+        session->spacer(vars, mdl, fml);
+        return;
+    }
     qe::mbproj mbp(m, p);
     mbp.spacer(vars, mdl, fml);
 }
@@ -148,7 +153,7 @@ void qe_project_z3(ast_manager &m, app_ref_vector &vars, expr_ref &fml,
  */
 void qe_project_spacer(ast_manager &m, app_ref_vector &vars, expr_ref &fml,
                        model &mdl, bool reduce_all_selects, bool use_native_mbp,
-                       bool dont_sub) {
+                       bool dont_sub, qe::mbproj *session) {
     th_rewriter rw(m);
     TRACE("spacer_mbp", tout << "Before projection:\n"; tout << fml << "\n";
           tout << "Vars:\n"
@@ -237,11 +242,15 @@ void qe_project_spacer(ast_manager &m, app_ref_vector &vars, expr_ref &fml,
         TRACE("spacer_mbp", tout << "Arith vars:\n" << arith_vars;);
 
         if (use_native_mbp) {
-            qe::mbproj mbp(m);
+            scoped_ptr<qe::mbproj> local;
+            if (!session) {
+                local = alloc(qe::mbproj, m);
+                session = local.get();
+            }
             expr_ref_vector fmls(m);
             flatten_and(fml, fmls);
 
-            mbp(true, arith_vars, mdl, fmls);
+            (*session)(true, arith_vars, mdl, fmls);
             fml = mk_and(fmls);
             SASSERT(arith_vars.empty());
         } else {
@@ -286,13 +295,14 @@ static expr *apply_accessor(ast_manager &m, ptr_vector<func_decl> const &acc,
 }
 
 void qe_project(ast_manager &m, app_ref_vector &vars, expr_ref &fml, model &mdl,
-                bool reduce_all_selects, bool use_native_mbp, bool dont_sub) {
+                bool reduce_all_selects, bool use_native_mbp, bool dont_sub,
+                qe::mbproj *mbp) {
     if (use_native_mbp)
         qe_project_z3(m, vars, fml, mdl, reduce_all_selects, use_native_mbp,
-                      dont_sub);
+                      dont_sub, mbp);
     else
         qe_project_spacer(m, vars, fml, mdl, reduce_all_selects, use_native_mbp,
-                          dont_sub);
+                          dont_sub, mbp);
 }
 
 void expand_literals(ast_manager &m, expr_ref_vector &conjs) {
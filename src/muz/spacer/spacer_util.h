@@ -40,6 +40,10 @@ Revision History:
 class model;
 class model_core;
 
+namespace qe {
+class mbproj;
+}
+
 namespace spacer {
 
 inline unsigned infty_level() { return UINT_MAX; }
@@ -90,10 +94,13 @@ void to_mbp_benchmark(std::ostream &out, const expr *fml,
  * 2. for remaining boolean vars, substitute using M
  * 3. use MBP for remaining array and arith variables
  * 4. for any remaining arith variables, substitute using M
+ *
+ * If mbp is given, the projection runs in that session and reuses its
+ * state instead of setting up a fresh projector for each call.
  */
 void qe_project(ast_manager &m, app_ref_vector &vars, expr_ref &fml, model &mdl,
                 bool reduce_all_selects = false, bool native_mbp = false,
-                bool dont_sub = false);
+                bool dont_sub = false, qe::mbproj *mbp = nullptr);
 
 // deprecate
 void qe_project(ast_manager &m, app_ref_vector &vars, expr_ref &fml,
@@ -30,14 +30,23 @@ namespace nlsat {
     class assignment : public polynomial::var2anum {
         scoped_anum_vector m_values;
         bool_vector      m_assigned;
+        // time stamps of updates, used by clients that cache results depending on values.
+        uint64_t         m_time = 0;
+        uint64_t         m_reset_time = 0;   // last update of all variables
+        svector<uint64_t> m_stamps;          // last update of each variable
+        void touch(var x) { m_stamps.setx(x, ++m_time, 0); }
+        void touch_all() { m_reset_time = ++m_time; }
     public:
         assignment(anum_manager & _m):m_values(_m) {}
         anum_manager & am() const { return m_values.m(); }
         void swap(assignment & other) {
             m_values.swap(other.m_values);
             m_assigned.swap(other.m_assigned);
+            touch_all();
+            other.touch_all();
         }
         void copy(assignment const& other) {
+            touch_all();
             m_assigned.reset();
             m_assigned.append(other.m_assigned);
             m_values.reserve(m_assigned.size(), anum());
@@ -53,15 +62,23 @@ namespace nlsat {
             m_assigned.reserve(x+1, false); 
             m_assigned[x] = true;
             am().swap(m_values[x], v); 
+            touch(x);
         }
         void set(var x, anum const & v) {
             m_values.reserve(x+1, anum());
             m_assigned.reserve(x+1, false); 
             m_assigned[x] = true;
             am().set(m_values[x], v); 
+            touch(x);
         }
-        void reset(var x) { if (x < m_assigned.size()) m_assigned[x] = false; }
-        void reset() { m_assigned.reset(); }
+        void reset(var x) { if (x < m_assigned.size()) m_assigned[x] = false; touch(x); }
+        void reset() { m_assigned.reset(); touch_all(); }
+        /**
+           \brief current time. A result computed at time t that depends on the
+           value of x is still valid if last_update(x) <= t.
+        */
+        uint64_t time() const { return m_time; }
+        uint64_t last_update(var x) const { return std::max(m_reset_time, m_stamps.get(x, 0)); }
         bool is_assigned(var x) const { return m_assigned.get(x, false); }
         anum const & value(var x) const { return m_values[x]; }
         anum_manager & m() const override { return am(); }
@@ -71,6 +88,8 @@ namespace nlsat {
             SASSERT(x < m_values.size() && y < m_values.size());
             std::swap(m_assigned[x], m_assigned[y]);
             std::swap(m_values[x], m_values[y]);
+            touch(x);
+            touch(y);
         }
         void display(std::ostream& out) const {
             for (unsigned i = 0; i < m_assigned.size(); ++i) {
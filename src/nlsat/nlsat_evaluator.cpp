@@ -17,6 +17,7 @@ Author:
 Revision History:
 
 --*/
+#include "util/scoped_ptr_vector.h"
 #include "nlsat/nlsat_evaluator.h"
 #include "nlsat/nlsat_solver.h"
 
@@ -29,8 +30,6 @@ namespace nlsat {
         small_object_allocator & m_allocator;
         anum_manager &           m_am;
         interval_set_manager     m_ism;
-        scoped_anum_vector       m_tmp_values;
-        scoped_anum_vector       m_add_roots_tmp;
         scoped_anum_vector       m_inf_tmp;
         
         // sign tables: light version
@@ -360,6 +359,24 @@ namespace nlsat {
 
         sign_table m_sign_table_tmp;
 
+        /**
+           \brief roots (and signs between the roots) of p in x for the values
+           the other variables of p had at time m_time. The values of the lower
+           variables are fixed while nlsat works on x, so the roots of a
+           polynomial shared by several atoms are isolated only once.
+        */
+        struct root_info {
+            polynomial_ref     m_p;
+            var                m_x = null_var;
+            uint64_t           m_time = 0;
+            bool               m_has_signs = false;
+            scoped_anum_vector m_roots;
+            svector<sign>      m_signs;
+            root_info(pmanager & pm, anum_manager & am): m_p(pm), m_roots(am) {}
+        };
+        scoped_ptr_vector<root_info> m_root_cache;   // indexed by polynomial id
+        polynomial::var_vector       m_root_vars;
+
         imp(solver& s, assignment const & x2v, pmanager & pm, small_object_allocator & allocator):
             m_solver(s),
             m_assignment(x2v),
@@ -367,8 +384,6 @@ namespace nlsat {
             m_allocator(allocator),
             m_am(m_assignment.am()),
             m_ism(m_am, allocator),
-            m_tmp_values(m_am),
-            m_add_roots_tmp(m_am),
             m_inf_tmp(m_am),
             m_sign_table_tmp(m_am) {
         }
@@ -377,6 +392,46 @@ namespace nlsat {
             return m_pm.max_var(p);
         }
 
+        bool is_valid(root_info const & r, poly * p, var x) {
+            if (r.m_p.get() != p || r.m_x != x)
+                return false;
+            m_root_vars.reset();
+            m_pm.vars(p, m_root_vars);
+            for (var y : m_root_vars)
+                if (y != x && m_assignment.last_update(y) > r.m_time)
+                    return false;
+            return true;
+        }
+
+        /**
+           \brief isolate the roots of p in x, with x unassigned.
+           If with_signs, also compute the signs of p in the sectors between the roots.
+        */
+        root_info & isolate_roots(poly * p, var x, bool with_signs) {
+            unsigned id = m_pm.id(p);
+            m_root_cache.reserve(id + 1);
+            root_info * r = m_root_cache[id];
+            if (r && is_valid(*r, p, x) && (r->m_has_signs || !with_signs))
+                return *r;
+            if (!r) {
+                r = alloc(root_info, m_pm, m_am);
+                m_root_cache.set(id, r);
+            }
+            r->m_x = null_var;
+            r->m_p = p;
+            r->m_time = m_assignment.time();
+            r->m_roots.reset();
+            r->m_signs.reset();
+            polynomial_ref _p(p, m_pm);
+            if (with_signs)
+                m_am.isolate_roots(_p, undef_var_assignment(m_assignment, x), r->m_roots, r->m_signs);
+            else
+                m_am.isolate_roots(_p, undef_var_assignment(m_assignment, x), r->m_roots);
+            r->m_has_signs = with_signs;
+            r->m_x = x;
+            return *r;
+        }
+
         /**
            \brief Return the sign of the polynomial in the current interpretation.
            
@@ -421,9 +476,7 @@ namespace nlsat {
             SASSERT(m_assignment.is_assigned(a->max_var()));
             // all variables of a were already assigned... 
             atom::kind k = a->get_kind();
-            scoped_anum_vector & roots = m_tmp_values;
-            roots.reset();
-            m_am.isolate_roots(polynomial_ref(a->p(), m_pm), undef_var_assignment(m_assignment, a->x()), roots);
+            scoped_anum_vector & roots = isolate_roots(a->p(), a->x(), false).m_roots;
             TRACE("nlsat_evaluator",
                   m_solver.display(tout << (neg?"!":""), *a); tout << "\n";
                   if (roots.empty()) {
@@ -450,7 +503,6 @@ namespace nlsat {
             return a->is_ineq_atom() ? eval_ineq(to_ineq_atom(a), neg) : eval_root(to_root_atom(a), neg);
         }
 
-        svector<sign> m_add_signs_tmp;
         void add(poly * p, var x, sign_table & t) {
             SASSERT(m_pm.max_var(p) <= x);
             if (m_pm.max_var(p) < x) {
@@ -458,15 +510,11 @@ namespace nlsat {
             }
             else {
                 // isolate roots of p
-                scoped_anum_vector & roots = m_add_roots_tmp;
-                svector<sign> & signs = m_add_signs_tmp;
-                roots.reset();
-                signs.reset();
                 TRACE("nlsat_evaluator", tout << "x: " << x << " max_var(p): " << m_pm.max_var(p) << "\n";);
                 // Note: I added undef_var_assignment in the following statement, to allow us to obtain the infeasible interval sets
                 // even when the maximal variable is assigned. I need this feature to minimize conflict cores.
-                m_am.isolate_roots(polynomial_ref(p, m_pm), undef_var_assignment(m_assignment, x), roots, signs);
-                t.add(roots, signs);
+                root_info & r = isolate_roots(p, x, true);
+                t.add(r.m_roots, r.m_signs);
             }
         }
 
@@ -599,12 +647,10 @@ namespace nlsat {
             SASSERT(i > 0);
             literal jst(a->bvar(), neg);
             anum dummy;
-            scoped_anum_vector & roots = m_tmp_values;
-            roots.reset();
             var x = a->max_var();
             // Note: I added undef_var_assignment in the following statement, to allow us to obtain the infeasible interval sets
             // even when the maximal variable is assigned. I need this feature to minimize conflict cores.
-            m_am.isolate_roots(polynomial_ref(a->p(), m_pm), undef_var_assignment(m_assignment, x), roots);
+            scoped_anum_vector & roots = isolate_roots(a->p(), x, false).m_roots;
             interval_set_ref result(m_ism);
 
             if (i > roots.size()) {
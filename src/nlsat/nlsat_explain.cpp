@@ -229,10 +229,16 @@ namespace nlsat {
            \brief Wrapper for psc chain computation
         */
         void psc_chain(polynomial_ref & p, polynomial_ref & q, unsigned x, polynomial_ref_vector & result) {
-            // TODO caching
             SASSERT(max_var(p) == max_var(q));
             SASSERT(max_var(p) == x);
-            m_cache.psc_chain(p, q, x, result);
+            // psc(q, p) and psc(p, q) agree up to the signs of their elements, which 
+            // does not affect the projection. Use one order of p and q, so that
+            // both orders share an entry in the cache.
+            poly * p1 = m_cache.mk_unique(p);
+            poly * q1 = m_cache.mk_unique(q);
+            if (m_pm.id(q1) < m_pm.id(p1))
+                std::swap(p1, q1);
+            m_cache.psc_chain(p1, q1, x, result);
         }
         
         /**
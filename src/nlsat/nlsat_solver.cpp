@@ -2228,6 +2228,7 @@ namespace nlsat {
             st.update("nlsat decisions", m_decisions);
             st.update("nlsat stages", m_stages);
             st.update("nlsat irrational assignments", m_irrational_assignments);
+            m_cache.collect_statistics(st);
         }
 
         void reset_statistics() {
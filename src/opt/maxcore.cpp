@@ -74,7 +74,15 @@ Notes:
 #include "opt/maxsmt.h"
 #include "opt/maxcore.h"
 #include "opt/totalizer.h"
+#include "opt/pb_sls.h"
+#include "util/mutex.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
+#include "ast/ast_translation.h"
 #include <iostream>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 using namespace opt;
 
@@ -91,6 +99,8 @@ private:
     struct stats {
         unsigned m_num_cores;
         unsigned m_num_cs;
+        unsigned m_num_parallel_rounds;
+        unsigned m_num_sls_models;
         stats() { reset(); }
         void reset() {
             memset(this, 0, sizeof(*this));
@@ -107,6 +117,71 @@ private:
         expr_ref_vector const& soft() override { return i.m_asms; }
     };
 
+    /**
+       \brief worker that extracts cores in parallel with the other workers.
+       It keeps a copy of the assertions of s(), including the relaxations
+       and totalizers added so far, in an ast_manager of its own.
+     */
+    struct core_worker {
+        scoped_ptr<ast_manager> m_manager;
+        ref<solver>             m_solver;
+        unsigned                m_num_synced = 0;  // assertions of s() copied to m_solver
+        expr_ref_vector         m_asms;
+        obj_map<expr, expr*>    m_asm2main;        // assumption of m_solver -> assumption of s()
+        vector<expr_ref_vector> m_cores;
+        lbool                   m_result = l_undef;
+        core_worker(ast_manager& m): m_manager(alloc(ast_manager, m, true)), m_asms(*m_manager) {}
+    };
+
+    /**
+       \brief local search on a copy of a propositional MaxSAT problem.
+       It runs next to the core-guided search and publishes the
+       assignments it finds to the Boolean constants in m_sls_vars.
+     */
+    struct sls_worker {
+        scoped_ptr<ast_manager> m_manager;
+        scoped_ptr<smt::pb_sls> m_sls;
+        func_decl_ref_vector    m_vars;
+        mutex                   m_mux;
+        bool_vector             m_assignment;     // last assignment found, guarded by m_mux
+        bool                    m_new_assignment = false;
+#ifndef SINGLE_THREAD
+        std::thread             m_thread;
+#endif
+        sls_worker(ast_manager& m): m_manager(alloc(ast_manager, m, true)), m_vars(*m_manager) {
+            m_sls = alloc(smt::pb_sls, *m_manager);
+        }
+        ~sls_worker() {
+#ifndef SINGLE_THREAD
+            if (m_thread.joinable()) {
+                m_manager->limit().cancel();
+                m_thread.join();
+            }
+#endif
+        }
+        void run() {
+            try {
+                for (unsigned i = 0; i < 16 && m_manager->inc(); ++i) {
+                    if ((*m_sls)() != l_true)
+                        return;
+                    model_ref mdl;
+                    m_sls->get_model(mdl);
+                    bool_vector assignment;
+                    for (func_decl* f : m_vars)
+                        assignment.push_back(m_manager->is_true(mdl->get_const_interp(f)));
+                    {
+                        lock_guard lock(m_mux);
+                        m_assignment.swap(assignment);
+                        m_new_assignment = true;
+                    }
+                    m_sls->set_model(mdl);
+                }
+            }
+            catch (z3_exception&) {
+            }
+        }
+    };
+
     stats            m_stats;
     expr_ref_vector  m_B;
     expr_ref_vector  m_asms;
@@ -135,6 +210,11 @@ private:
     unsigned         m_lns_conflicts = 1000;           // number of conflicts used for LNS improvement
     bool             m_enable_core_rotate = false;     // enable core rotation
     bool             m_use_totalizer = true;           // use totalizer instead of cardinality encoding
+    unsigned         m_threads = 1;                    // number of workers extracting cores
+    scoped_ptr_vector<core_worker> m_workers;
+    bool             m_portfolio = false;              // run local search next to the core-guided search
+    scoped_ptr<sls_worker> m_sls_worker;
+    func_decl_ref_vector m_sls_vars;
     std::string      m_trace_id;
     typedef ptr_vector<expr> exprs;
 
@@ -149,7 +229,8 @@ public:
         m_trail(m),
         m_st(st),
         m_lnsctx(*this),
-        m_lns(s(), m_lnsctx)
+        m_lns(s(), m_lnsctx),
+        m_sls_vars(m)
     {
         switch(st) {
         case s_primal:
@@ -234,7 +315,9 @@ public:
         trace();
         improve_model();
         if (is_sat != l_true) return is_sat;
+        start_sls();
         while (m_lower < m_upper) {
+            import_sls_model();
             TRACE("opt_verbose",
                   s().display(tout << m_asms << "\n") << "\n";
                   display(tout););
@@ -277,7 +360,9 @@ public:
         trace();
         exprs cs;
         if (is_sat != l_true) return is_sat;
+        start_sls();
         while (m_lower < m_upper) {
+            import_sls_model();
             is_sat = check_sat_hill_climb(m_asms);
             if (!m.inc()) {
                 return l_undef;
@@ -367,23 +452,112 @@ public:
     }
 
 
+    /**
+       \brief start local search on a copy of the problem, if it is propositional.
+     */
+    void start_sls() {
+#ifndef SINGLE_THREAD
+        if (!m_portfolio)
+            return;
+        struct collect_proc {
+            ast_manager& m;
+            func_decl_ref_vector& vars;
+            ast_mark visited;
+            bool propositional = true;
+            collect_proc(ast_manager& m, func_decl_ref_vector& vars): m(m), vars(vars) {}
+            void operator()(var*) { propositional = false; }
+            void operator()(quantifier*) { propositional = false; }
+            void operator()(app* a) {
+                if (!is_uninterp(a) || visited.is_marked(a->get_decl()))
+                    return;
+                visited.mark(a->get_decl(), true);
+                if (a->get_num_args() > 0 || !m.is_bool(a))
+                    propositional = false;
+                else
+                    vars.push_back(a->get_decl());
+            }
+        };
+        m_sls_vars.reset();
+        collect_proc proc(m, m_sls_vars);
+        expr_fast_mark1 visited;
+        for (unsigned i = 0; i < s().get_num_assertions(); ++i)
+            quick_for_each_expr(proc, visited, s().get_assertion(i));
+        for (auto const& sf : m_soft)
+            quick_for_each_expr(proc, visited, sf.s);
+        if (!proc.propositional)
+            return;
+        m_sls_worker = alloc(sls_worker, m);
+        sls_worker& w = *m_sls_worker;
+        ast_translation tr(m, *w.m_manager);
+        for (func_decl* f : m_sls_vars)
+            w.m_vars.push_back(tr(f));
+        for (unsigned i = 0; i < s().get_num_assertions(); ++i)
+            w.m_sls->add(tr(s().get_assertion(i)));
+        for (auto const& sf : m_soft)
+            w.m_sls->add(tr(sf.s.get()), sf.weight);
+        w.m_thread = std::thread([&w]() { w.run(); });
+#endif
+    }
+
+    void stop_sls() {
+        m_sls_worker = nullptr;
+    }
+
+    /**
+       \brief use the last assignment of the local search if it satisfies
+       the hard constraints. The definitions of the soft constraints are
+       evaluated, the local search does not need to respect them.
+     */
+    void import_sls_model() {
+        if (!m_sls_worker)
+            return;
+        bool_vector assignment;
+        {
+            lock_guard lock(m_sls_worker->m_mux);
+            if (!m_sls_worker->m_new_assignment)
+                return;
+            m_sls_worker->m_new_assignment = false;
+            assignment.swap(m_sls_worker->m_assignment);
+        }
+        model_ref mdl = alloc(model, m);
+        for (unsigned i = 0; i < m_sls_vars.size(); ++i)
+            mdl->register_decl(m_sls_vars.get(i), assignment[i] ? m.mk_true() : m.mk_false());
+        expr* a = nullptr, *e = nullptr;
+        for (expr* d : m_defs)
+            if (m.is_iff(d, a, e) && is_uninterp_const(a))
+                mdl->register_decl(to_app(a)->get_decl(), (*mdl)(e));
+        for (unsigned i = 0; i < s().get_num_assertions(); ++i)
+            if (!mdl->is_true(s().get_assertion(i)))
+                return;
+        ++m_stats.m_num_sls_models;
+        update_assignment(mdl);
+    }
+
     lbool operator()() override {
         m_defs.reset();
+        lbool r = l_undef;
         switch(m_st) {
         case s_primal:
         case s_primal_binary:
         case s_rc2:
         case s_primal_binary_rc2:
-            return mus_solver();
+            r = mus_solver();
+            break;
         case s_primal_dual:
-            return primal_dual_solver();
+            r = primal_dual_solver();
+            break;
         }
-        return l_undef;
+        stop_sls();
+        return r;
     }
 
     void collect_statistics(statistics& st) const override {
         st.update("maxsat-cores", m_stats.m_num_cores);
         st.update("maxsat-correction-sets", m_stats.m_num_cs);
+        if (m_stats.m_num_parallel_rounds > 0)
+            st.update("maxsat-parallel-rounds", m_stats.m_num_parallel_rounds);
+        if (m_portfolio)
+            st.update("maxsat-sls-models", m_stats.m_num_sls_models);
     }
 
     lbool get_cores(vector<weighted_core>& cores) {
@@ -437,6 +611,134 @@ public:
         return is_sat;
     }
 
+    /**
+       \brief copy the assertions added to s() since the last round to the worker.
+     */
+    void sync_worker(core_worker& w, unsigned i) {
+        unsigned n = s().get_num_assertions();
+        if (!w.m_solver || n < w.m_num_synced) {
+            params_ref p(m_params);
+            p.set_uint("random_seed", p.get_uint("random_seed", 0) + i);
+            w.m_solver = mk_smt_solver(*w.m_manager, p, symbol::null);
+            w.m_num_synced = 0;
+        }
+        ast_translation tr(m, *w.m_manager);
+        for (; w.m_num_synced < n; ++w.m_num_synced)
+            w.m_solver->assert_expr(tr(s().get_assertion(w.m_num_synced)));
+    }
+
+    /**
+       \brief extract disjoint cores of the worker's assumptions until
+       the remaining assumptions are satisfiable or max_core_size cores
+       were found.
+     */
+    static void run_worker(core_worker& w, unsigned max_cores) {
+        w.m_cores.reset();
+        w.m_result = l_undef;
+        try {
+            expr_ref_vector asms(w.m_asms);
+            while (w.m_cores.size() < max_cores) {
+                w.m_result = w.m_solver->check_sat(asms);
+                if (w.m_result != l_false)
+                    return;
+                expr_ref_vector core(*w.m_manager);
+                w.m_solver->get_unsat_core(core);
+                w.m_cores.push_back(core);
+                if (core.empty())
+                    return;
+                unsigned j = 0;
+                for (expr* a : asms)
+                    if (!core.contains(a))
+                        asms[j++] = a;
+                asms.shrink(j);
+            }
+        }
+        catch (z3_exception&) {
+            w.m_result = l_undef;
+        }
+    }
+
+    /**
+       \brief find cores with several workers at the same time.
+       s() is unsat under the current assumptions. The workers use their
+       own copies of the assertions and differently shuffled assumptions,
+       so they find different cores. The cores that are pairwise disjoint
+       are minimized and relaxed together, their weights add up to the
+       lower bound as for the cores found one after another by get_cores.
+    */
+    lbool get_cores_parallel(vector<weighted_core>& cores) {
+#ifdef SINGLE_THREAD
+        return get_cores(cores);
+#else
+        cores.reset();
+        ++m_stats.m_num_parallel_rounds;
+        vector<exprs> candidates;
+        expr_ref_vector _core(m);
+        s().get_unsat_core(_core);
+        candidates.push_back(exprs(_core.size(), _core.data()));
+
+        unsigned num_workers = m_threads - 1;
+        while (m_workers.size() < num_workers)
+            m_workers.push_back(alloc(core_worker, m));
+        scoped_limits sl(m.limit());
+        for (unsigned i = 0; i < num_workers; ++i) {
+            core_worker& w = *m_workers[i];
+            sync_worker(w, i + 1);
+            random_gen rand(i + 1);
+            exprs asms(m_asms.size(), m_asms.data());
+            shuffle(asms.size(), asms.data(), rand);
+            ast_translation tr(m, *w.m_manager);
+            w.m_asms.reset();
+            w.m_asm2main.reset();
+            for (expr* a : asms) {
+                expr* b = tr(a);
+                w.m_asms.push_back(b);
+                w.m_asm2main.insert(b, a);
+            }
+            sl.push_child(&w.m_manager->limit());
+        }
+        unsigned max_cores = std::max(1u, m_max_core_size);
+        thread_pool::run(num_workers, [&](unsigned i) { run_worker(*m_workers[i], max_cores); });
+        if (!m.inc())
+            return l_undef;
+
+        for (auto* w : m_workers) {
+            for (auto const& wcore : w->m_cores) {
+                exprs core;
+                for (expr* b : wcore)
+                    core.push_back(w->m_asm2main[b]);
+                candidates.push_back(core);
+            }
+        }
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](exprs const& a, exprs const& b) { return a.size() < b.size(); });
+        obj_hashtable<expr> used;
+        for (auto const& c : candidates) {
+            if (c.empty()) {
+                cores.reset();
+                m_lower = m_upper;
+                return l_true;
+            }
+            if (any_of(c, [&](expr* a) { return used.contains(a); }))
+                continue;
+            for (expr* a : c)
+                used.insert(a);
+            _core.reset();
+            _core.append(c.size(), c.data());
+            lbool is_sat = minimize_core(_core);
+            if (is_sat != l_true)
+                return is_sat;
+            exprs core(_core.size(), _core.data());
+            ++m_stats.m_num_cores;
+            cores.push_back(weighted_core(core, core_weight(core)));
+            remove_soft(core, m_asms);
+            split_core(core);
+        }
+        IF_VERBOSE(3, verbose_stream() << "(opt.maxres :parallel-cores " << cores.size() << " :candidates " << candidates.size() << ")\n";);
+        return l_true;
+#endif
+    }
+
     void get_current_correction_set(exprs& cs) {
         model_ref mdl;
         s().get_model(mdl);
@@ -504,7 +806,7 @@ public:
             return core_rotate();
 
         vector<weighted_core> cores;
-        lbool is_sat = get_cores(cores);
+        lbool is_sat = m_threads > 1 ? get_cores_parallel(cores) : get_cores(cores);
         if (is_sat != l_true) {
             return is_sat;
         }
@@ -1062,12 +1364,16 @@ public:
         m_enable_core_rotate =      p.enable_core_rotate();
         m_lns_conflicts =           p.lns_conflicts();
         m_use_totalizer =           p.rc2_totalizer();
+        m_threads =                 p.maxres_threads();
+        m_portfolio =               p.maxsat_portfolio();
+        m_enable_lns |=             m_portfolio;
 	if (m_c.num_objectives() > 1)
 	  m_add_upper_bound_block = false;
     }
 
     lbool init_local() {
         m_trail.reset();
+        m_workers.reset();
         for (auto const& [e, w, t] : m_soft)
             add_soft(e, w);
         m_max_upper = m_upper;
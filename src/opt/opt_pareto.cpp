@@ -19,16 +19,33 @@ Notes:
 --*/
 
 #include "opt/opt_pareto.h"
+#include "opt/opt_params.hpp"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
+#include "ast/ast_translation.h"
 #include "model/model_smt2_pp.h"
+#include "smt/smt_solver.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
 
 namespace opt {
 
     // ---------------------
     // GIA pareto algorithm
+
+    gia_pareto::gia_pareto(ast_manager & m, pareto_callback& cb, solver* s, params_ref & p):
+        pareto_base(m, cb, s, p) {
+        m_threads = opt_params(p).pareto_threads();
+    }
+
+    void gia_pareto::updt_params(params_ref & p) {
+        pareto_base::updt_params(p);
+        m_threads = opt_params(p).pareto_threads();
+    }
    
     lbool gia_pareto::operator()() {
+        if (m_threads > 1)
+            return next_parallel();
         expr_ref fml(m);
         lbool is_sat = m_solver->check_sat(0, nullptr);
         if (is_sat == l_true) {
@@ -63,16 +80,124 @@ namespace opt {
         return is_sat;
     }
 
-    void pareto_base::mk_dominates() {
+    /**
+       \brief return the next point not yet returned, searching new points
+       with the workers when the points of the last round are used up.
+    */
+    lbool gia_pareto::next_parallel() {
+        while (true) {
+            while (!m_found.empty()) {
+                model_ref mdl = m_found.back();
+                m_found.pop_back();
+                // workers of the same round may have found the same point
+                if (any_of(m_blocks, [&](expr* b) { return !mdl->is_true(b); }))
+                    continue;
+                m_model = mdl;
+                m_labels.reset();
+                mk_not_dominated_by();
+                return l_true;
+            }
+            lbool is_sat = find_parallel();
+            if (is_sat != l_true)
+                return is_sat;
+        }
+    }
+
+    /**
+       \brief run the guided improvement with m_threads workers at the same time.
+       Each worker has a copy of the assertions, including the blocking constraints 
+       of the points returned so far, in an ast_manager of its own, and a different
+       random seed. In each step the workers check satisfiability in parallel, and the
+       constraints requiring a dominating model are added between the steps.
+       A worker whose constraints become unsatisfiable has found a Pareto point.
+    */
+    lbool gia_pareto::find_parallel() {
+#ifdef SINGLE_THREAD
+        m_threads = 1;
+        return (*this)();
+#else
+        struct worker {
+            scoped_ptr<ast_manager> m_manager;
+            ref<solver>             m_solver;
+            model_ref               m_model;        // last model, in m_manager
+            model_ref               m_best;         // last model, in m
+            lbool                   m_result = l_undef;
+            bool                    m_done = false;
+        };
+        scoped_ptr_vector<worker> workers;
+        scoped_limits sl(m.limit());
+        for (unsigned i = 0; i < m_threads; ++i) {
+            worker* w = alloc(worker);
+            workers.push_back(w);
+            w->m_manager = alloc(ast_manager, m, true);
+            params_ref p(m_params);
+            p.set_uint("random_seed", p.get_uint("random_seed", 0) + i);
+            w->m_solver = mk_smt_solver(*w->m_manager, p, symbol::null);
+            ast_translation tr(m, *w->m_manager);
+            for (unsigned j = 0; j < m_solver->get_num_assertions(); ++j)
+                w->m_solver->assert_expr(tr(m_solver->get_assertion(j)));
+            sl.push_child(&w->m_manager->limit());
+        }
+        ptr_vector<worker> active;
+        for (worker* w : workers)
+            active.push_back(w);
+        while (!active.empty()) {
+            thread_pool::run(active.size(), [&](unsigned i) {
+                worker& w = *active[i];
+                try {
+                    w.m_result = w.m_solver->check_sat(0, nullptr);
+                    if (w.m_result == l_true)
+                        w.m_solver->get_model(w.m_model);
+                }
+                catch (z3_exception&) {
+                    w.m_result = l_undef;
+                }
+            });
+            if (!m.inc())
+                return l_undef;
+            unsigned j = 0;
+            for (worker* w : active) {
+                if (w->m_result == l_true && w->m_model) {
+                    ast_translation to_main(*w->m_manager, m);
+                    w->m_best = w->m_model->translate(to_main);
+                    w->m_best->set_model_completion(true);
+                    expr_ref fml = dominates(w->m_best);
+                    ast_translation to_worker(m, *w->m_manager);
+                    w->m_solver->assert_expr(to_worker(fml.get()));
+                    active[j++] = w;
+                }
+                else {
+                    w->m_done = w->m_result == l_false;
+                }
+            }
+            active.shrink(j);
+        }
+        bool unsat = true;
+        for (worker* w : workers) {
+            if (w->m_done && w->m_best) 
+                m_found.push_back(w->m_best);
+            unsat &= w->m_done && !w->m_best;
+        }
+        IF_VERBOSE(2, verbose_stream() << "(opt.pareto :parallel-points " << m_found.size() << ")\n";);
+        if (!m_found.empty())
+            return l_true;
+        return unsat ? l_false : l_undef;
+#endif
+    }
+
+    expr_ref pareto_base::dominates(model_ref& mdl) {
         unsigned sz = cb.num_objectives();
-        expr_ref fml(m);
         expr_ref_vector gt(m), fmls(m);
         for (unsigned i = 0; i < sz; ++i) {
-            fmls.push_back(cb.mk_ge(i, m_model));
-            gt.push_back(cb.mk_gt(i, m_model));
+            fmls.push_back(cb.mk_ge(i, mdl));
+            gt.push_back(cb.mk_gt(i, mdl));
         }
         fmls.push_back(mk_or(gt));
-        fml = mk_and(fmls);
+        return mk_and(fmls);
+    }
+
+    void pareto_base::mk_dominates() {
+        expr_ref fml = dominates(m_model);
         IF_VERBOSE(10, verbose_stream() << "dominates: " << fml << "\n";);
         TRACE("opt", model_smt2_pp(tout << fml << "\n", m, *m_model, 0););
         m_solver->assert_expr(fml);        
@@ -88,6 +213,7 @@ namespace opt {
         fml = m.mk_not(mk_and(le));
         IF_VERBOSE(10, verbose_stream() << "not dominated by: " << fml << "\n";);
         TRACE("opt", tout << fml << "\n";);
+        m_blocks.push_back(fml);
         m_solver->assert_expr(fml);        
     }
 
@@ -41,6 +41,7 @@ namespace opt {
         params_ref       m_params;
         model_ref        m_model;
         svector<symbol>  m_labels;
+        expr_ref_vector  m_blocks;   // points returned so far are blocked by these formulas
     public:
         pareto_base(
             ast_manager & m, 
@@ -50,7 +51,8 @@ namespace opt {
             m(m),
             cb(cb),            
             m_solver(s),
-            m_params(p) {
+            m_params(p),
+            m_blocks(m) {
         }
         virtual ~pareto_base() = default;
         virtual void updt_params(params_ref & p) {
@@ -75,18 +77,32 @@ namespace opt {
 
     protected:
 
+        expr_ref dominates(model_ref& mdl);
+
         void mk_dominates();
 
         void mk_not_dominated_by();            
     };
+
+    /**
+       \brief guided improvement algorithm.
+       With pareto.threads > 1, several workers climb to Pareto points at the 
+       same time from different initial models. The points found by a round 
+       are returned by the following calls before the next round starts.
+    */
     class gia_pareto : public pareto_base {
+        unsigned          m_threads;
+        vector<model_ref> m_found;      // Pareto points found by workers that were not yet returned
+
+        lbool find_parallel();
+        lbool next_parallel();
     public:
         gia_pareto(ast_manager & m, 
                    pareto_callback& cb, 
                    solver* s, 
-                   params_ref & p):
-            pareto_base(m, cb, s, p) {            
-        }
+                   params_ref & p);
+
+        void updt_params(params_ref & p) override;
 
         lbool operator()() override;
     };
@@ -282,6 +282,77 @@ namespace opt {
         return l_true;
     }
 
+    /*
+        Binary search for the optimum of an integer objective.
+        lo is the best value of a model so far, hi the tightest bound
+        whose improvement was refuted. Each round asks for a model with
+        a value of at least the midpoint, or doubles the step while no
+        bound is refuted yet. Models found are maximized locally before
+        the next round.
+    */
+    lbool optsmt::bisect_lex(unsigned obj_index, bool is_maximize) {
+        TRACE("opt", tout << "index: " << obj_index << " is-max: " << is_maximize << "\n";);
+        arith_util arith(m);
+        if (!arith.is_int(m_objs.get(obj_index)))
+            return geometric_lex(obj_index, is_maximize);
+        for (unsigned i = 0; i < obj_index; ++i) 
+            commit_assignment(i);
+
+        expr_ref bound(m);
+        rational hi, delta(1);
+        bool has_hi = false;
+        unsigned num_scopes = 0;
+        lbool is_sat = m_s->check_sat(0, nullptr);
+        while (is_sat == l_true && m.inc()) {
+            m_s->maximize_objective(obj_index, bound);
+            m_s->get_model(m_model);
+            SASSERT(m_model);
+            update_lower_lex(obj_index, m_s->saved_objective_value(obj_index), is_maximize);
+            if (!m_lower[obj_index].is_finite())
+                break;
+            while (true) {
+                rational lo = ceil(m_lower[obj_index].get_rational());
+                if (has_hi && hi <= lo) {
+                    is_sat = l_false;
+                    break;
+                }
+                rational target = has_hi ? lo + ceil((hi - lo) / rational(2)) : lo + delta;
+                TRACE("opt", tout << "lo: " << lo << " target: " << target << "\n";);
+                m_s->push();
+                m_s->assert_expr(m_s->mk_ge(obj_index, inf_eps(target)));
+                is_sat = m_s->check_sat(0, nullptr);
+                if (is_sat == l_true) {
+                    ++num_scopes;
+                    if (!has_hi)
+                        delta *= rational(2);
+                    break;
+                }
+                m_s->pop(1);
+                if (is_sat != l_false)
+                    break;
+                has_hi = true;
+                hi = target - rational(1);
+                update_upper(obj_index, inf_eps(hi));
+            }
+        }
+        m_s->pop(num_scopes);
+
+        if (is_sat == l_false && !m_model) {
+            return l_false;
+        }
+        
+        if (!m.inc() || is_sat == l_undef) {
+            return l_undef;
+        }
+
+        // set the solution tight.
+        m_upper[obj_index] = m_lower[obj_index];    
+        for (unsigned i = obj_index+1; i < m_lower.size(); ++i) {
+            m_lower[i] = inf_eps(rational(-1), inf_rational(0));
+        }
+        return l_true;
+    }
+
     bool optsmt::can_increment_delta(vector<inf_eps> const& lower, unsigned i) {
         arith_util arith(m);
         inf_eps max_delta;
@@ -505,6 +576,9 @@ namespace opt {
         if (is_maximize && m_optsmt_engine == symbol("symba")) {
             return symba_opt();
         }
+        else if (m_optsmt_engine == symbol("bisect")) {
+            return bisect_lex(obj_index, is_maximize);
+        }
         else {
             return geometric_lex(obj_index, is_maximize);
         }
@@ -18,26 +18,34 @@ Notes:
 --*/
 #include "opt/maxsmt.h"
 #include "util/uint_set.h"
+#include "ast/ast_util.h"
 #include "ast/ast_pp.h"
 #include "model/model_smt2_pp.h"
 #include "smt/smt_theory.h"
 #include "smt/smt_context.h"
 #include "opt/opt_context.h"
-#include "util/sorting_network.h"
+#include "opt/totalizer.h"
 #include "ast/converters/generic_model_converter.h"
 
 namespace opt {
 
+    /**
+       \brief MaxSAT by a cardinality constraint over the soft constraints,
+       where a soft constraint of weight w counts w times. The lower bound
+       on the number of satisfied soft constraints is raised one at a time.
+       The constraint is encoded by a totalizer over the negated soft
+       constraints, and tightening the bound only adds the clauses of the
+       outputs that were not encoded before.
+     */
     class sortmax : public maxsmt_solver_base {
     public:
-        typedef expr* pliteral;
-        typedef ptr_vector<expr> pliteral_vector;
-        psort_nw<sortmax> m_sort;
-        expr_ref_vector   m_trail;
-        func_decl_ref_vector m_fresh;
+        expr_ref_vector              m_trail;
         ref<generic_model_converter> m_filter;
+        scoped_ptr<totalizer>        m_totalizer;
+        unsigned                     m_num_inputs = 0;
+
         sortmax(maxsat_context& c, vector<soft>& s, unsigned index): 
-            maxsmt_solver_base(c, s, index), m_sort(*this), m_trail(m), m_fresh(m) {}
+            maxsmt_solver_base(c, s, index), m_trail(m) {}
 
         lbool operator()() override {
             if (!init()) 
@@ -46,49 +54,48 @@ namespace opt {
             lbool is_sat = l_true;
             m_filter = alloc(generic_model_converter, m, "sortmax");
             expr_ref_vector in(m);
-            expr_ref tmp(m);
-            ptr_vector<expr> out;
             for (auto const & [e, w, t] : m_soft) {
                 if (!w.is_unsigned()) {
                     throw default_exception("sortmax can only handle unsigned weights. Use a different heuristic.");
                 }
                 unsigned n = w.get_unsigned();
                 while (n > 0) {
-                    in.push_back(e);
+                    in.push_back(mk_not(m, e));
                     --n;
                 }
             }
-            m_sort.sorting(in.size(), in.data(), out);
+            m_num_inputs = in.size();
+            if (in.empty())
+                return l_true;
+            m_totalizer = alloc(totalizer, in);
 
-            // initialize sorting network outputs using the initial assignment.
+            // initialize the bound using the initial assignment.
             unsigned first = 0;
-            for (auto const & [e, w, t] : m_soft) {
-                if (t == l_true) {
-                    unsigned n = w.get_unsigned();
-                    while (n > 0) {
-                        s().assert_expr(out[first]);
-                        ++first;
-                        --n;
-                    }
-                }
-            }
-            while (l_true == is_sat && first < out.size() && m_lower < m_upper) {
+            for (auto const & [e, w, t] : m_soft) 
+                if (t == l_true) 
+                    first += w.get_unsigned();
+            if (first > 0)
+                s().assert_expr(at_least(first));
+            
+            while (l_true == is_sat && first < m_num_inputs && m_lower < m_upper) {
                 trace_bounds("sortmax");
-                s().assert_expr(out[first]);
+                s().assert_expr(at_least(first + 1));
                 is_sat = s().check_sat(0, nullptr);
                 TRACE("opt", tout << is_sat << "\n"; s().display(tout); tout << "\n";);
                 if (!m.inc()) {
                     is_sat = l_undef;
                 }
                 if (is_sat == l_true) {
-                    ++first;
                     s().get_model(m_model);
                     update_assignment();
-                    for (; first < out.size() && is_true(out[first]); ++first) { 
-                        s().assert_expr(out[first]);
-                    }
+                    unsigned num_true = 0;
+                    for (auto const & [e, w, t] : m_soft)
+                        if (is_true(e))
+                            num_true += w.get_unsigned();
+                    SASSERT(num_true > first);
+                    first = num_true;
                     TRACE("opt", model_smt2_pp(tout, m, *m_model.get(), 0););
-                    m_upper = m_lower + rational(out.size() - first);
+                    m_upper = m_lower + rational(m_num_inputs - first);
                     (*m_filter)(m_model);
                 }
             }
@@ -100,6 +107,22 @@ namespace opt {
             return is_sat;
         }
 
+        /**
+           \brief literal that holds if at least k soft constraints are
+           satisfied, that is, at most n - k of the negated inputs hold.
+         */
+        expr* at_least(unsigned k) {
+            SASSERT(k <= m_num_inputs);
+            expr* r = m_totalizer->at_least(m_num_inputs - k + 1);
+            for (expr* clause : m_totalizer->clauses())
+                s().assert_expr(clause);
+            m_totalizer->clauses().reset();
+            for (auto const& [v, d] : m_totalizer->defs())
+                m_filter->hide(to_app(v)->get_decl());
+            m_totalizer->defs().reset();
+            return trail(mk_not(m, r));
+        }
+
         void update_assignment() {
             for (soft& s : m_soft) s.set_value(is_true(s.s));
         }
@@ -108,31 +131,10 @@ namespace opt {
             return m_model->is_true(e);
         }
 
-        // definitions used for sorting network
-        pliteral mk_false() { return m.mk_false(); }
-        pliteral mk_true() { return m.mk_true(); }
-        pliteral mk_max(unsigned n, pliteral const* as) { return trail(m.mk_or(n, as)); }
-        pliteral mk_min(unsigned n, pliteral const* as) { return trail(m.mk_and(n, as)); }
-        pliteral mk_not(pliteral a) { if (m.is_not(a,a)) return a; return trail(m.mk_not(a)); }
-
-        std::ostream& pp(std::ostream& out, pliteral lit) {  return out << mk_pp(lit, m);  }
-        
-        pliteral trail(pliteral l) {
-            m_trail.push_back(l);
-            return l;
-        }
-        pliteral fresh(char const* n) {
-            expr_ref fr(m.mk_fresh_const(n, m.mk_bool_sort()), m);
-            func_decl* f = to_app(fr)->get_decl();
-            m_fresh.push_back(f);
-            m_filter->hide(f);
-            return trail(fr);
+        expr* trail(expr* e) {
+            m_trail.push_back(e);
+            return e;
         }
-        
-        void mk_clause(unsigned n, pliteral const* lits) {
-            s().assert_expr(mk_or(m, n, lits));
-        }        
-        
     };
     
     
@@ -29,10 +29,11 @@ namespace opt {
             return;
         auto* l = n->m_left;
         auto* r = n->m_right;
+        // children with fewer than k inputs need all of their outputs.
         if (l)
-            ensure_bound(l, k);
+            ensure_bound(l, std::min(k, l->size()));
         if (r)
-            ensure_bound(r, k);
+            ensure_bound(r, std::min(k, r->size()));
 
         expr_ref c(m), def(m);
         expr_ref_vector ors(m), clause(m);
@@ -101,10 +102,32 @@ namespace opt {
         }
         m_root = trees.back();
     }
+
+    void totalizer::add_literals(expr_ref_vector const& literals) {
+        if (literals.empty())
+            return;
+        totalizer t(literals);
+        node* right = t.m_root;
+        t.m_root = nullptr;
+        expr_ref_vector ls(m);
+        ls.resize(m_root->size() + right->size());
+        node* n = alloc(node, ls);
+        n->m_left = m_root;
+        n->m_right = right;
+        m_root = n;
+        m_literals.append(literals);
+    }
         
     totalizer::~totalizer() {
         dealloc(m_root);
     }
+
+    unsigned totalizer::num_encoded() const {
+        unsigned k = 0;
+        while (k < m_root->size() && m_root->m_literals.get(k))
+            ++k;
+        return k;
+    }
     
     expr* totalizer::at_least(unsigned k) {
         if (k == 0)
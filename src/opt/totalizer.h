@@ -46,6 +46,20 @@ namespace opt {
         totalizer(expr_ref_vector const& literals);
         ~totalizer();
         expr* at_least(unsigned k);
+
+        /**
+           \brief extend the totalizer by literals. The outputs that were
+           encoded already remain valid for the original literals and are
+           reused when the outputs of the extended tree are encoded, so only
+           clauses for the merge with the new literals are added.
+         */
+        void add_literals(expr_ref_vector const& literals);
+
+        /**
+           \brief number of outputs at_least(1), .., at_least(k) that are encoded.
+         */
+        unsigned num_encoded() const;
+        unsigned size() const { return m_literals.size(); }
         expr_ref_vector& clauses() { return m_clauses; }
         vector<std::pair<expr_ref, expr_ref>>& defs() { return m_defs; }
     };   
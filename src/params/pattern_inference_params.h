@@ -37,6 +37,7 @@ struct pattern_inference_params {
     int                           m_pi_nopat_weight;
     bool                          m_pi_avoid_skolems;
     bool                          m_pi_warnings;
+    bool                          m_pi_cache;
     
     pattern_inference_params(params_ref const & p = params_ref()):
         m_pi_nopat_weight(-1),
@@ -17,6 +17,8 @@ Revision History:
 
 --*/
 #include "util/stack.h"
+#include "util/prefetch_stream.h"
+#include "util/gzip_stream.h"
 #include "ast/datatype_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
 #include "ast/arith_decl_plugin.h"
@@ -32,6 +34,7 @@ Revision History:
 #include "parsers/util/pattern_validation.h"
 #include "parsers/util/parser_params.hpp"
 #include<sstream>
+#include<fstream>
 
 namespace smt2 {
     typedef cmd_exception parser_exception;
@@ -3213,6 +3216,30 @@ namespace smt2 {
 };
 
 bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & ps, char const * filename) {
+    if (!interactive && is_gzip_stream(is)) {
+        // compressed input is inflated while it is parsed
+        if (!gzip_supported()) {
+            ctx.regular_stream() << "(error \"gzip compressed input is not supported, build Z3 with Z3_USE_LIB_ZLIB\")" << std::endl;
+            return false;
+        }
+        gzip_istream gis(is);
+        bool r = parse_smt2_commands(ctx, gis, interactive, ps, filename);
+        if (!gis.error().empty()) {
+            ctx.regular_stream() << "(error \"" << gis.error() << "\")" << std::endl;
+            r = false;
+        }
+        return r;
+    }
+#ifndef SINGLE_THREAD
+    // Commands are executed as soon as they are parsed. For file input, reading
+    // ahead on a separate thread lets I/O overlap with solving.
+    parser_params pp(ps);
+    if (!interactive && pp.prefetch() && (dynamic_cast<std::ifstream*>(&is) || dynamic_cast<gzip_istream*>(&is))) {
+        prefetch_istream pis(is, pp.prefetch_block_size(), pp.prefetch_blocks());
+        smt2::parser p(ctx, pis, interactive, ps, filename);
+        return p();
+    }
+#endif
     smt2::parser p(ctx, is, interactive, ps, filename);
     return p();
 }
@@ -19,8 +19,55 @@ Revision History:
 #include "parsers/smt2/smt2scanner.h"
 #include "parsers/util/parser_params.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SMT2_SCANNER_SSE2
+#endif
+
 namespace smt2 {
 
+#ifdef SMT2_SCANNER_SSE2
+    static inline __m128i in_range(__m128i v, char lo, char hi) {
+        return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8(hi + 1)));
+    }
+#endif
+
+    /**
+       \brief Return the length of the longest prefix of [begin, end) consisting of
+       characters that may occur inside simple symbols (m_normalized is 'a', '0' or '-').
+
+       These are the printable ASCII characters 0x21-0x7E, except " # ' ( ) : ; [ \ ] ` { | }.
+       With SSE2 the characters are classified 16 at a time.
+    */
+    unsigned scanner::symbol_prefix_length(char const * begin, char const * end) const {
+        char const * p = begin;
+#ifdef SMT2_SCANNER_SSE2
+        while (end - p >= 16) {
+            __m128i v  = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+            __m128i ok = in_range(v, 0x21, 0x7E);
+            __m128i bad = _mm_or_si128(in_range(v, '"', '#'), in_range(v, '\'', ')'));
+            bad = _mm_or_si128(bad, in_range(v, ':', ';'));
+            bad = _mm_or_si128(bad, in_range(v, '[', ']'));
+            bad = _mm_or_si128(bad, _mm_cmpeq_epi8(v, _mm_set1_epi8('`')));
+            bad = _mm_or_si128(bad, in_range(v, '{', '}'));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_andnot_si128(bad, ok)));
+            if (mask != 0xFFFF) {
+                unsigned i = 0;
+                while (mask & (1u << i))
+                    ++i;
+                return static_cast<unsigned>(p - begin) + i;
+            }
+            p += 16;
+        }
+#endif
+        for (; p < end; ++p) {
+            signed char n = m_normalized[static_cast<unsigned char>(*p)];
+            if (n != 'a' && n != '0' && n != '-')
+                break;
+        }
+        return static_cast<unsigned>(p - begin);
+    }
+
     void scanner::next() {
         if (m_cache_input)
             m_cache.push_back(m_curr);
@@ -114,6 +161,19 @@ namespace smt2 {
 
     scanner::token scanner::read_symbol_core() {
         while (!m_at_eof) {
+            if (!m_interactive && !m_cache_input && m_bpos > 0) {
+                // fast path: consume the run of symbol characters in the buffer at once.
+                // m_curr is m_buffer[m_bpos - 1].
+                char const * begin = m_buffer + m_bpos - 1;
+                unsigned n = symbol_prefix_length(begin, m_buffer + m_bend);
+                if (n > 0) {
+                    m_string.append(n, begin);
+                    m_spos += n - 1;
+                    m_bpos += n - 1;
+                    next();
+                    continue;
+                }
+            }
             char c = curr();
             signed char n = m_normalized[static_cast<unsigned char>(c)];
             if (n == 'a' || n == '0' || n == '-') {
@@ -145,17 +205,27 @@ namespace smt2 {
 
     scanner::token scanner::read_number() {
         SASSERT('0' <= curr() && curr() <= '9');
-        rational q(1);
-        m_number = rational(curr() - '0');
+        // digits are accumulated in machine words and flushed into m_number
+        // once the word is full, instead of using rational arithmetic per digit.
+        uint64_t digits = curr() - '0';
+        uint64_t scale  = 10;
+        unsigned num_decimals = 0;
+        m_number.reset();
         next();
         bool is_float = false;
 
         while (!m_at_eof) {
             char c = curr();
             if ('0' <= c && c <= '9') {
-                m_number = rational(10)*m_number + rational(c - '0');
+                if (scale == 1000000000000000000ull) {
+                    m_number = m_number * rational(scale, rational::ui64()) + rational(digits, rational::ui64());
+                    digits = 0;
+                    scale  = 1;
+                }
+                digits = 10 * digits + (c - '0');
+                scale *= 10;
                 if (is_float)
-                    q *= rational(10);
+                    ++num_decimals;
                 next();
             }
             else if (c == '.') {
@@ -168,8 +238,9 @@ namespace smt2 {
                 break;
             }
         }
+        m_number = m_number * rational(scale, rational::ui64()) + rational(digits, rational::ui64());
         if (is_float)
-            m_number /= q;
+            m_number /= power(rational(10), num_decimals);
         TRACE("scanner", tout << "new number: " << m_number << "\n";);
         return is_float ? FLOAT_TOKEN : INT_TOKEN;
     }
@@ -59,6 +59,7 @@ namespace smt2 {
         char curr() const { return m_curr; }
         void new_line() { m_line++; m_spos = 0; }
         void next();
+        unsigned symbol_prefix_length(char const * begin, char const * end) const;
         
     public:
         
@@ -2269,6 +2269,27 @@ private:
     th_rewriter  m_rewriter;
 
     bool m_use_array_der;
+
+    // Results of earlier calls, keyed by the abstracted quantifier and by 
+    // the input formula. Callers such as model based projection apply
+    // qe_lite to overlapping formulas, the results only depend on the key.
+    obj_map<quantifier, expr*> m_der_cache;
+    obj_map<expr, expr*>       m_elim_cache;
+    expr_ref_vector            m_cache_pinned;
+
+    void cache_insert(obj_map<quantifier, expr*>& c, quantifier* k, expr* v) { pin(k, v); c.insert(k, v); }
+    void cache_insert(obj_map<expr, expr*>& c, expr* k, expr* v) { pin(k, v); c.insert(k, v); }
+
+    void pin(expr* k, expr* v) {
+        if (m_cache_pinned.size() > 100000) {
+            m_der_cache.reset();
+            m_elim_cache.reset();
+            m_cache_pinned.reset();
+        }
+        m_cache_pinned.push_back(k);
+        m_cache_pinned.push_back(v);
+    }
+
     bool has_unique_non_ground(expr_ref_vector const& fmls, unsigned& index) {
         index = fmls.size();
         if (index <= 1) {
@@ -2293,7 +2314,8 @@ public:
         m_array_der(m),
         m_elim_star(*this),
         m_rewriter(m),
-        m_use_array_der(use_array_der) {}
+        m_use_array_der(use_array_der),
+        m_cache_pinned(m) {}
 
     void operator()(app_ref_vector& vars, expr_ref& fml) {
         if (vars.empty()) {
@@ -2311,7 +2333,13 @@ public:
             names.push_back(vars[i]->get_decl()->get_name());
         }
         q = m.mk_exists(vars.size(), sorts.data(), names.data(), tmp, 1, qe_lite);
-        m_der.reduce_quantifier(q, tmp, pr);
+        expr* cached = nullptr;
+        if (m_der_cache.find(q, cached))
+            tmp = cached;
+        else {
+            m_der.reduce_quantifier(q, tmp, pr);
+            cache_insert(m_der_cache, q, tmp);
+        }
         // assumes m_der just updates the quantifier and does not change things more.
         if (is_exists(tmp) && to_quantifier(tmp)->get_qid() == qe_lite) {
             used_vars used;
@@ -2336,7 +2364,14 @@ public:
 
     void operator()(expr_ref& fml, proof_ref& pr) {
         expr_ref tmp(m);
+        expr* cached = nullptr;
+        if (!m.proofs_enabled() && m_elim_cache.find(fml, cached)) {
+            fml = cached;
+            return;
+        }
         m_elim_star(fml, tmp, pr);
+        if (!m.proofs_enabled())
+            cache_insert(m_elim_cache, fml, tmp);
         if (m.proofs_enabled()) {
             pr = m.mk_rewrite(fml, tmp);
         }
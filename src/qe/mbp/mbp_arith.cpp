@@ -39,9 +39,19 @@ namespace mbp {
         bool              m_check_purified = true;  // check that variables are properly pure 
         bool              m_apply_projection = false;
 
+        // Linear forms of model independent sub-terms, kept across projections.
+        struct linear_form {
+            rational                          m_const;
+            vector<std::pair<expr*, rational>> m_terms;
+        };
+        obj_map<expr, unsigned> m_linear_index;
+        vector<linear_form>     m_linear_forms;
+        expr_ref_vector         m_linear_pinned;
+        unsigned                m_max_linear_forms = 10000;
+
 
         imp(ast_manager& m) :
-            m(m), a(m) {}
+            m(m), a(m), m_linear_pinned(m) {}
 
         ~imp() {}
 
@@ -214,6 +224,8 @@ namespace mbp {
 
             if (tids.contains(t))
                 insert_mul(t, mul, ts);
+            else if (is_linear_node(t) && linearize_cached(mul, t, c, ts))
+                ;
             else if (a.is_mul(t, t1, t2) && is_numeral(t1, mul1))
                 linearize(mbo, eval, mul * mul1, t2, c, fmls, ts, tids);
             else if (a.is_mul(t, t1, t2) && is_numeral(t2, mul1))
@@ -285,6 +297,77 @@ namespace mbp {
             return a.is_extended_numeral(t, r);
         }
 
+        bool is_linear_node(expr* t) {
+            expr* t1, * t2;
+            rational r;
+            return a.is_add(t) || a.is_sub(t) || a.is_uminus(t) ||
+                (a.is_mul(t, t1, t2) && (is_numeral(t1, r) || is_numeral(t2, r)));
+        }
+
+        //
+        // Compute the linear form of t if it does not depend on the model:
+        // the same case split as linearize, failing on the conditionals,
+        // mod and div that introduce side conditions or definitions.
+        // Sub-terms that are compound linear terms are never in tids while
+        // literals are linearized, so the form is valid for every projection.
+        //
+        bool mk_linear_form(rational const& mul, expr* t, rational& c, obj_map<expr, rational>& ts) {
+            expr* t1, * t2, * t3;
+            rational mul1;
+            if (a.is_mul(t, t1, t2) && is_numeral(t1, mul1))
+                return mk_linear_form(mul * mul1, t2, c, ts);
+            if (a.is_mul(t, t1, t2) && is_numeral(t2, mul1))
+                return mk_linear_form(mul * mul1, t1, c, ts);
+            if (a.is_uminus(t, t1))
+                return mk_linear_form(-mul, t1, c, ts);
+            if (a.is_numeral(t, mul1)) {
+                c += mul * mul1;
+                return true;
+            }
+            if (a.is_add(t)) {
+                for (expr* arg : *to_app(t))
+                    if (!mk_linear_form(mul, arg, c, ts))
+                        return false;
+                return true;
+            }
+            if (a.is_sub(t, t1, t2))
+                return mk_linear_form(mul, t1, c, ts) && mk_linear_form(-mul, t2, c, ts);
+            if (m.is_ite(t, t1, t2, t3) || a.is_mod(t) || a.is_idiv(t))
+                return false;
+            insert_mul(t, mul, ts);
+            return true;
+        }
+
+        bool linearize_cached(rational const& mul, expr* t, rational& c, obj_map<expr, rational>& ts) {
+            unsigned idx;
+            if (!m_linear_index.find(t, idx)) {
+                if (m_linear_pinned.size() >= m_max_linear_forms) {
+                    m_linear_index.reset();
+                    m_linear_forms.reset();
+                    m_linear_pinned.reset();
+                }
+                linear_form f;
+                obj_map<expr, rational> ts0;
+                // model dependent terms are remembered with UINT_MAX
+                idx = UINT_MAX;
+                if (mk_linear_form(rational::one(), t, f.m_const, ts0)) {
+                    for (auto const& [x, k] : ts0)
+                        f.m_terms.push_back({ x, k });
+                    idx = m_linear_forms.size();
+                    m_linear_forms.push_back(f);
+                }
+                m_linear_index.insert(t, idx);
+                m_linear_pinned.push_back(t);
+            }
+            if (idx == UINT_MAX)
+                return false;
+            linear_form const& f = m_linear_forms[idx];
+            c += mul * f.m_const;
+            for (auto const& [x, k] : f.m_terms)
+                insert_mul(x, mul * k, ts);
+            return true;
+        }
+
         struct compare_second {
             bool operator()(std::pair<expr*, rational> const& a,
                 std::pair<expr*, rational> const& b) const {
@@ -162,6 +162,49 @@ namespace mbp {
         return true;
     }
 
+    /**
+     * Values of index terms under the model of a projection session.
+     *
+     * The reduction of selects and the ackermannization evaluate the same
+     * index terms, and so do the projections of the array variables one
+     * at a time. The values are kept until the session is reset or the
+     * projection is invoked with another model. Extending the model with
+     * fresh constants does not change the values of the cached terms.
+     */
+    class index_value_cache {
+        model*               m_model = nullptr;
+        obj_map<expr, expr*> m_values;
+        expr_ref_vector      m_pinned;
+    public:
+        index_value_cache(ast_manager& m): m_pinned(m) {}
+
+        void reset() {
+            m_model = nullptr;
+            m_values.reset();
+            m_pinned.reset();
+        }
+
+        void set_model(model& mdl) {
+            if (m_model != &mdl) {
+                reset();
+                m_model = &mdl;
+            }
+        }
+
+        expr* operator()(model_evaluator& mev, expr* e) {
+            expr* v = nullptr;
+            if (m_values.find(e, v))
+                return v;
+            expr_ref val = mev(e);
+            m_pinned.push_back(e);
+            m_pinned.push_back(val);
+            m_values.insert(e, val);
+            return val;
+        }
+
+        unsigned size() const { return m_values.size(); }
+    };
+
     static expr_ref mk_eq(expr_ref_vector const& xs, expr_ref_vector const& ys) {
         ast_manager& m = xs.get_manager();
         expr_ref_vector eqs(m);
@@ -676,6 +719,7 @@ namespace mbp {
     class array_select_reducer {
         ast_manager&                m;
         array_util                  m_arr_u;
+        index_value_cache&          m_values;
         obj_map<expr, expr*>        m_cache;
         expr_ref_vector             m_pinned;   // to ensure a reference
         expr_ref_vector             m_idx_lits;
@@ -698,7 +742,7 @@ namespace mbp {
         }
 
         bool is_equals (expr *e1, expr *e2) {
-            return e1 == e2 || (*m_mev)(e1) == (*m_mev)(e2);
+            return e1 == e2 || m_values(*m_mev, e1) == m_values(*m_mev, e2);
         }
 
         bool is_equals (unsigned arity, expr * const* xs, expr * const * ys) {
@@ -844,9 +888,10 @@ namespace mbp {
 
     public:
 
-        array_select_reducer (ast_manager& m):
+        array_select_reducer (ast_manager& m, index_value_cache& values):
             m (m),
             m_arr_u (m),
+            m_values (values),
             m_pinned (m),
             m_idx_lits (m),
             m_rw (m),
@@ -861,6 +906,7 @@ namespace mbp {
             mev.set_model_completion(true);
             M = &mdl;
             m_mev = &mev;
+            m_values.set_model(mdl);
             m_reduce_all_selects = reduce_all_selects;
 
             // mark vars to eliminate
@@ -906,6 +952,7 @@ namespace mbp {
         array_util                  m_arr_u;
         arith_util                  m_ari_u;
         bv_util                     m_bv_u;
+        index_value_cache&          m_values;
         sel_map                     m_sel_terms;
         // representative indices for eliminating selects
         vector<idx_val>             m_idxs;
@@ -1028,11 +1075,19 @@ namespace mbp {
             }
 
             unsigned start = m_idxs.size (); // append at the end
+            // equivalence classes of the index values, bucketed by the hash of the values
+            u_map<unsigned_vector> classes;
             for (app * a : sel_terms) {
                 expr_ref_vector idxs(m, arity, a->get_args() + 1);
-                expr_ref_vector vals = (*m_mev)(idxs);
+                expr_ref_vector vals(m);
+                unsigned h = arity;
+                for (expr* idx : idxs) {
+                    vals.push_back(m_values(*m_mev, idx));
+                    h = combine_hash(h, vals.back()->get_id());
+                }
+                unsigned_vector& bucket = classes.insert_if_not_there(h, unsigned_vector());
                 bool is_new = true;
-                for (unsigned j = start; j < m_idxs.size (); j++) {
+                for (unsigned j : bucket) {
                     if (!is_eq(m_idxs[j].val, vals)) continue;
                     // idx belongs to the jth equivalence class;
                     // substitute sel term with ith sel const
@@ -1045,6 +1100,7 @@ namespace mbp {
                 }
                 if (is_new) {
                     // new repr, val, and sel const
+                    bucket.push_back(m_idxs.size());
                     m_idxs.push_back(idx_val(std::move(idxs), std::move(vals), to_num(vals)));
                     app_ref c (m.mk_fresh_const ("sel", val_sort), m);
                     m_sel_consts.push_back (c);
@@ -1128,11 +1184,12 @@ namespace mbp {
 
     public:
 
-        array_project_selects_util (ast_manager& m):
+        array_project_selects_util (ast_manager& m, index_value_cache& values):
             m (m),
             m_arr_u (m),
             m_ari_u (m),
             m_bv_u (m),
+            m_values (values),
             m_sel_consts (m),
             m_idx_lits (m),
             m_sub (m)
@@ -1145,6 +1202,7 @@ namespace mbp {
             mev.set_model_completion(true);
             M = &mdl;
             m_mev = &mev;
+            m_values.set_model(mdl);
 
             // mark vars to eliminate
             // alloc empty map from array var to sel terms over it
@@ -1190,8 +1248,9 @@ namespace mbp {
         ast_manager& m;
         array_util   a;
         scoped_ptr<contains_app> m_var;
+        index_value_cache m_index_values;
 
-        imp(ast_manager& m): m(m), a(m), m_stores(m) {}
+        imp(ast_manager& m): m(m), a(m), m_index_values(m), m_stores(m) {}
         ~imp() {}
 
         bool solve(model& model, app_ref_vector& vars, expr_ref_vector& lits) {
@@ -1609,13 +1668,13 @@ namespace mbp {
               );
 
         // 2. reduce selects
-        array_select_reducer rs (m);
+        array_select_reducer rs (m, m_imp->m_index_values);
         rs (mdl, arr_vars, fml, reduce_all_selects);
 
         TRACE ("qe", tout << "Reduced selects:\n" << fml << "\n"; );
 
         // 3. project selects using model based ackermannization
-        array_project_selects_util ps (m);
+        array_project_selects_util ps (m, m_imp->m_index_values);
         ps (mdl, arr_vars, fml, aux_vars);
 
         TRACE ("qe",
@@ -1624,6 +1683,10 @@ namespace mbp {
               );
     }
 
+    void array_project_plugin::reset_cache() {
+        m_imp->m_index_values.reset();
+    }
+
     bool array_project_plugin::project(model& model, app_ref_vector& vars, expr_ref_vector& lits, vector<def>& defs) {
         return true;
     }
@@ -38,6 +38,13 @@ namespace mbp {
         bool project(model& model, app_ref_vector& vars, expr_ref_vector& lits, vector<def>& defs) override;
         void saturate(model& model, func_decl_ref_vector const& shared, expr_ref_vector& lits) override;
 
+        /**
+           \brief forget the values of index terms kept for the current model.
+           Projections that reuse the model keep the values of the indices
+           they have already evaluated.
+        */
+        void reset_cache();
+
     };
 
 };
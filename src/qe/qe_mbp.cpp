@@ -43,6 +43,8 @@ class mbproj::impl {
     params_ref                      m_params;
     th_rewriter                     m_rw;
     ptr_vector<mbp::project_plugin> m_plugins;
+    mbp::array_project_plugin*      m_arrays = nullptr;   // owned by m_plugins
+    scoped_ptr<qe_lite>             m_qe_lite;  // created on demand, reused across projections
 
     // parameters
     bool m_reduce_all_selects;
@@ -241,7 +243,8 @@ public:
     impl(ast_manager& m, params_ref const& p) :m(m), m_params(p), m_rw(m) {
         add_plugin(alloc(mbp::arith_project_plugin, m));
         add_plugin(alloc(mbp::datatype_project_plugin, m));
-        add_plugin(alloc(mbp::array_project_plugin, m));
+        m_arrays = alloc(mbp::array_project_plugin, m);
+        add_plugin(m_arrays);
         updt_params(p);
     }
 
@@ -281,6 +284,7 @@ public:
         app_ref var(m);
         expr_ref_vector unused_fmls(m);
         bool progress = true;
+        m_arrays->reset_cache();
         preprocess_solve(model, vars, fmls);
         filter_variables(model, vars, fmls, unused_fmls);
         project_bools(model, vars, fmls);
@@ -325,6 +329,8 @@ public:
                 preprocess_solve(model, vars, fmls);
             }
         }
+        // the model may not outlive the projection
+        m_arrays->reset_cache();
         if (fmls.empty()) {
             vars.reset();
         }
@@ -334,8 +340,9 @@ public:
     }
 
     void do_qe_lite(app_ref_vector& vars, expr_ref& fml) {
-        qe_lite qe(m, m_params, false);
-        qe(vars, fml);
+        if (!m_qe_lite)
+            m_qe_lite = alloc(qe_lite, m, m_params, false);
+        (*m_qe_lite)(vars, fml);
         m_rw(fml);
         TRACE("qe", tout << "After qe_lite:\n" << fml << "\n" << "Vars: " << vars << "\n";);
         SASSERT(!m.is_false(fml));
@@ -360,6 +367,8 @@ public:
 
         flatten_and(fml);
 
+        // the rounds of array projection share the values of indices under mdl
+        mbp::array_project_plugin ap(m);
         while (!vars.empty()) {
 
             do_qe_lite(vars, fml);
@@ -381,7 +390,6 @@ public:
             vars.reset();
 
             // project arrays
-            mbp::array_project_plugin ap(m);
             ap(mdl, array_vars, fml, vars, m_reduce_all_selects);
             SASSERT(array_vars.empty());
             m_rw(fml);
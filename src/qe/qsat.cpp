@@ -35,6 +35,7 @@ Notes:
 #include "smt/smt_solver.h"
 #include "solver/solver.h"
 #include "solver/mus.h"
+#include "tactic/tactical.h"
 #include "qe/qsat.h"
 #include "qe/qe_mbp.h"
 #include "qe/qe.h"
@@ -546,6 +547,10 @@ namespace qe {
         void init() {
             m_solver = mk_smt_solver(m, m_params, symbol::null);
         }
+
+        void set_random_seed(unsigned seed) {
+            m_params.set_uint("random_seed", seed);
+        }
         void collect_statistics(statistics & st) const {
             if (m_solver) 
                 m_solver->collect_statistics(st);
@@ -609,6 +614,7 @@ namespace qe {
         model_ref                  m_model_save;
         expr_ref                   m_gt;
         opt::inf_eps               m_value_save;
+        unsigned                   m_threads = 1;
 
         
         /**
@@ -1236,6 +1242,7 @@ namespace qe {
             m_was_sat(false),
             m_gt(m)
         {
+            updt_params(p);
         }
         
         ~qsat() override {
@@ -1245,13 +1252,42 @@ namespace qe {
         char const* name() const override { return "qsat"; }
         
         void updt_params(params_ref const & p) override {
+            m_params.append(p);
+            m_threads = std::max(1u, m_params.get_uint("threads", 1));
+            unsigned seed = m_params.get_uint("random_seed", 0);
+            m_fa.set_random_seed(seed);
+            m_ex.set_random_seed(seed);
         }
         
         void collect_param_descrs(param_descrs & r) override {
+            r.insert("threads", CPK_UINT, "number of qsat instances with different random seeds that run in parallel, the first result is used", "1");
+        }
+
+        /**
+           \brief run copies of qsat with different random seeds in parallel. 
+           The copies choose different candidates and therefore refine 
+           their abstractions along different strategies.
+        */
+        void run_parallel(goal_ref const & in, goal_ref_buffer & result) {
+            unsigned seed = m_params.get_uint("random_seed", 0);
+            ptr_vector<tactic> ts;
+            for (unsigned i = 0; i < m_threads; ++i) {
+                params_ref p(m_params);
+                p.set_uint("threads", 1);
+                p.set_uint("random_seed", seed + i);
+                ts.push_back(alloc(qsat, m, p, m_mode));
+            }
+            tactic_ref t = par(ts.size(), ts.data());
+            (*t)(in, result);
+            t->collect_statistics(m_st);
         }
         
         void operator()(/* in */  goal_ref const & in, 
                         /* out */ goal_ref_buffer & result) override {
+            if (m_threads > 1 && m_mode == qsat_sat) {
+                run_parallel(in, result);
+                return;
+            }
             tactic_report report("qsat-tactic", *in);
             model_evaluator_params mp(m_params);
             if (!mp.array_equalities())
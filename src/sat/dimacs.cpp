@@ -20,6 +20,8 @@ Revision History:
 #undef max
 #undef min
 #include "sat/sat_solver.h"
+#include "util/thread_pool.h"
+#include <string>
 
 template<typename Buffer>
 static bool is_whitespace(Buffer & in) {
@@ -77,7 +79,7 @@ static int parse_int(Buffer & in, std::ostream& err) {
 }
 
 template<typename Buffer>
-static void read_clause(Buffer & in, std::ostream& err, sat::solver & solver, sat::literal_vector & lits) {
+static void read_clause(Buffer & in, std::ostream& err, sat::literal_vector & lits) {
     int     parsed_lit;
     int     var;
     
@@ -89,62 +91,135 @@ static void read_clause(Buffer & in, std::ostream& err, sat::solver & solver, sa
             break;
         var = abs(parsed_lit);
         SASSERT(var > 0);
-        while (static_cast<unsigned>(var) >= solver.num_vars())
-            solver.mk_var();
         lits.push_back(sat::literal(var, parsed_lit < 0));
     }
 }
 
-template<typename Buffer>
-static void read_clause(Buffer & in, std::ostream& err, sat::literal_vector & lits) {
-    int     parsed_lit;
-    int     var;
-    
-    lits.reset();
 
-    while (true) { 
-        parsed_lit = parse_int(in, err);
-        if (parsed_lit == 0)
-            break;
-        var = abs(parsed_lit);
-        SASSERT(var > 0);
-        lits.push_back(sat::literal(var, parsed_lit < 0));
-    }
-}
 
+/**
+   The input is read in blocks that end at a line break. Blocks are
+   tokenized in parallel into a sequence of literals where 0 ends a clause;
+   a clause can continue in the next block. The clauses are then added to
+   the solver in the order of the input.
+*/
+namespace {
+
+    const unsigned dimacs_block_size = 1 << 22;
+
+    struct dimacs_block {
+        std::string  m_text;
+        svector<int> m_lits;
+        unsigned     m_num_lines = 0;
+        unsigned     m_max_var = 0;
+        bool         m_error = false;
+        unsigned     m_error_line = 0;      // lines of the block before the error
+        int          m_error_char = 0;
+
+        /**
+           \brief fill m_text with the next block of in, extended to the end
+           of the line. Return false if in has no more input.
+        */
+        bool read(std::istream & in) {
+            m_text.resize(dimacs_block_size);
+            in.read(&m_text[0], dimacs_block_size);
+            m_text.resize(static_cast<size_t>(in.gcount()));
+            if (!m_text.empty() && m_text.back() != '\n' && in) {
+                std::string rest;
+                std::getline(in, rest);
+                m_text += rest;
+                if (in)
+                    m_text.push_back('\n');
+            }
+            return !m_text.empty();
+        }
 
+        void parse() {
+            m_lits.reset();
+            m_num_lines = 0;
+            m_max_var = 0;
+            m_error = false;
+            char const * p = m_text.data();
+            char const * end = p + m_text.size();
+            while (p < end) {
+                char c = *p;
+                if ((c >= 9 && c <= 13) || c == 32) {
+                    if (c == '\n')
+                        ++m_num_lines;
+                    ++p;
+                    continue;
+                }
+                if (c == 'c' || c == 'p') {
+                    while (p < end && *p != '\n')
+                        ++p;
+                    continue;
+                }
+                bool neg = false;
+                if (c == '-' || c == '+') {
+                    neg = c == '-';
+                    ++p;
+                }
+                if (p == end || *p < '0' || *p > '9') {
+                    m_error = true;
+                    m_error_line = m_num_lines;
+                    m_error_char = p == end ? EOF : static_cast<unsigned char>(*p);
+                    return;
+                }
+                int val = 0;
+                while (p < end && *p >= '0' && *p <= '9')
+                    val = val * 10 + (*p++ - '0');
+                if (static_cast<unsigned>(val) > m_max_var)
+                    m_max_var = val;
+                m_lits.push_back(neg ? -val : val);
+            }
+        }
+    };
+}
 
-template<typename Buffer>
-static bool parse_dimacs_core(Buffer & in, std::ostream& err, sat::solver & solver) {
+bool parse_dimacs(std::istream & in, std::ostream& err, sat::solver & solver) {
+    unsigned num_blocks = std::max(1u, thread_pool::max_threads());
+    vector<dimacs_block> blocks;
+    blocks.resize(num_blocks);
     sat::literal_vector lits;
-    try {
-        while (true) {
-            skip_whitespace(in);
-            if (*in == EOF) {
-                break;
-            }
-            else if (*in == 'c' || *in == 'p') {
-                skip_line(in);
+    unsigned line = 0;
+    bool more = true;
+    while (more) {
+        unsigned n = 0;
+        while (n < num_blocks && blocks[n].read(in))
+            ++n;
+        more = n == num_blocks;
+        thread_pool::run(n, [&](unsigned i) { blocks[i].parse(); });
+        for (unsigned i = 0; i < n; ++i) {
+            dimacs_block const & b = blocks[i];
+            while (b.m_max_var >= solver.num_vars())
+                solver.mk_var();
+            for (int l : b.m_lits) {
+                if (l == 0) {
+                    solver.mk_clause(lits.size(), lits.data());
+                    lits.reset();
+                }
+                else
+                    lits.push_back(sat::literal(abs(l), l < 0));
             }
-            else {
-                read_clause(in, err, solver, lits);
-                solver.mk_clause(lits.size(), lits.data());
+            if (b.m_error) {
+                int c = b.m_error_char;
+                if (20 <= c && c < 128)
+                    err << "(error, \"unexpected char: " << ((char)c) << " line: " << line + b.m_error_line << "\")\n";
+                else
+                    err << "(error, \"unexpected char: " << c << " line: " << line + b.m_error_line << "\")\n";
+                return false;
             }
+            line += b.m_num_lines;
         }
     }
-    catch (dimacs::lex_error) {
+    if (!lits.empty()) {
+        err << "(error, \"unexpected char: " << EOF << " line: " << line << "\")\n";
         return false;
     }
     return true;
 }
 
 
-bool parse_dimacs(std::istream & in, std::ostream& err, sat::solver & solver) {
-    dimacs::stream_buffer _in(in);
-    return parse_dimacs_core(_in, err, solver);
-}
-
-
 namespace dimacs {
 
     std::ostream& operator<<(std::ostream& out, drat_record const& r) {
@@ -19,8 +19,42 @@
 #include "sat/sat_aig_cuts.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_lut_finder.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 namespace sat {
+
+    // dst := dst op (sign ? ~src : src) for op in { and, xor }, over n words.
+    static void and_words(uint64_t* dst, uint64_t const* src, bool sign, unsigned n) {
+        unsigned i = 0;
+#ifdef __AVX2__
+        __m256i mask = _mm256_set1_epi64x(sign ? -1 : 0);
+        for (; i + 4 <= n; i += 4) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(dst + i));
+            __m256i b = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i)), mask);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_and_si256(a, b));
+        }
+#endif
+        uint64_t m = sign ? ~0ull : 0ull;
+        for (; i < n; ++i)
+            dst[i] &= src[i] ^ m;
+    }
+
+    static void xor_words(uint64_t* dst, uint64_t const* src, bool sign, unsigned n) {
+        unsigned i = 0;
+#ifdef __AVX2__
+        __m256i mask = _mm256_set1_epi64x(sign ? -1 : 0);
+        for (; i + 4 <= n; i += 4) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(dst + i));
+            __m256i b = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i)), mask);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(a, b));
+        }
+#endif
+        uint64_t m = sign ? ~0ull : 0ull;
+        for (; i < n; ++i)
+            dst[i] ^= src[i] ^ m;
+    }
         
     aig_cuts::aig_cuts() {
         m_cut_set1.init(m_region, m_config.m_max_cutset_size + 1, UINT_MAX);
@@ -598,6 +632,123 @@ namespace sat {
     }
 
 
+    uint64_t aig_cuts::random_word() {
+        return 
+            (uint64_t)m_rand() + ((uint64_t)m_rand() << 16ull) + 
+            ((uint64_t)m_rand() << 32ull) + ((uint64_t)m_rand() << 48ull);
+    }
+
+    void aig_cuts::eval(node const& n, unsigned num_words, uint64_t* sigs, uint64_t* dst) const {
+        auto sig = [&](literal u) { return sigs + u.var() * num_words; };
+        switch (n.op()) {
+        case and_op:
+            for (unsigned w = 0; w < num_words; ++w)
+                dst[w] = ~0ull;
+            for (unsigned i = 0; i < n.size(); ++i) {
+                literal u = m_literals[n.offset() + i];
+                and_words(dst, sig(u), u.sign(), num_words);
+            }
+            break;
+        case xor_op:
+            for (unsigned w = 0; w < num_words; ++w)
+                dst[w] = 0ull;
+            for (unsigned i = 0; i < n.size(); ++i) {
+                literal u = m_literals[n.offset() + i];
+                xor_words(dst, sig(u), u.sign(), num_words);
+            }
+            break;
+        case ite_op: {
+            literal u = m_literals[n.offset() + 0]; 
+            literal v = m_literals[n.offset() + 1]; 
+            literal w = m_literals[n.offset() + 2]; 
+            for (unsigned i = 0; i < num_words; ++i) {
+                uint64_t uv = sig(u)[i], vv = sig(v)[i], wv = sig(w)[i];
+                if (u.sign()) uv = ~uv;
+                if (v.sign()) vv = ~vv;
+                if (w.sign()) wv = ~wv;
+                dst[i] = (uv & vv) | (~uv & wv);
+            }
+            break;
+        }
+        case lut_op:
+            // disjunction of the minterms of the table.
+            for (unsigned w = 0; w < num_words; ++w)
+                dst[w] = 0ull;
+            for (unsigned m = 0; m < (1u << n.size()); ++m) {
+                if (!(n.lut() & (1ull << m)))
+                    continue;
+                for (unsigned w = 0; w < num_words; ++w) {
+                    uint64_t r = ~0ull;
+                    for (unsigned i = 0; i < n.size(); ++i) {
+                        literal u = m_literals[n.offset() + i];
+                        uint64_t uv = sig(u)[w];
+                        r &= (0 != (m & (1u << i))) != u.sign() ? uv : ~uv;
+                    }
+                    dst[w] |= r;
+                }
+            }
+            break;
+        default:
+            UNREACHABLE();
+        }
+        if (n.sign())
+            for (unsigned w = 0; w < num_words; ++w)
+                dst[w] = ~dst[w];
+    }
+
+    void aig_cuts::simulate(unsigned num_words, svector<uint64_t>& sigs) {
+        unsigned num_vars = m_aig.size();
+        sigs.reset();
+        sigs.resize(num_vars * num_words, 0ull);
+        auto def = [&](unsigned v) -> node const* {
+            if (m_aig[v].empty() || m_aig[v][0].is_var() || !m_aig[v][0].is_valid())
+                return nullptr;
+            return &m_aig[v][0];
+        };
+        // 0: not visited, 1: on stack, 2: simulated
+        svector<char> state(num_vars, (char)0);
+        unsigned_vector todo;
+        for (unsigned r = 0; r < num_vars; ++r) {
+            if (state[r] == 0)
+                todo.push_back(r);
+            while (!todo.empty()) {
+                unsigned v = todo.back();
+                if (state[v] == 2) {
+                    todo.pop_back();
+                    continue;
+                }
+                node const* n = def(v);
+                bool ready = true;
+                if (n && state[v] == 0) {
+                    state[v] = 1;
+                    for (unsigned i = 0; i < n->size(); ++i) {
+                        unsigned w = child(*n, i).var();
+                        if (w < num_vars && state[w] == 0) {
+                            todo.push_back(w);
+                            ready = false;
+                        }
+                    }
+                }
+                if (!ready)
+                    continue;
+                todo.pop_back();
+                bool cyclic = false;
+                if (n)
+                    for (unsigned i = 0; i < n->size(); ++i) {
+                        unsigned w = child(*n, i).var();
+                        cyclic |= w >= num_vars || state[w] != 2;
+                    }
+                uint64_t* dst = sigs.data() + v * num_words;
+                if (n && !cyclic) 
+                    eval(*n, num_words, sigs.data(), dst);
+                else 
+                    for (unsigned w = 0; w < num_words; ++w)
+                        dst[w] = random_word();
+                state[v] = 2;
+            }
+        }
+    }
+
     void aig_cuts::on_node_add(unsigned v, node const& n) {
         if (m_on_clause_add) {
             node2def(m_on_clause_add, n, literal(v, false));
@@ -179,6 +179,8 @@ namespace sat {
         void flush_roots(to_root const& to_root, cut_set& cs);
 
         cut_val eval(node const& n, cut_eval const& env) const;
+        void eval(node const& n, unsigned num_words, uint64_t* sigs, uint64_t* dst) const;
+        uint64_t random_word();
         lbool get_value(bool_var v) const;
 
         std::ostream& display(std::ostream& out, node const& n) const;
@@ -227,6 +229,13 @@ namespace sat {
 
         cut_eval simulate(unsigned num_rounds);
 
+        /**
+         * \brief bit-parallel simulation on 64*num_words random patterns.
+         * Nodes are evaluated once, in topological order of their first definition.
+         * sigs holds num_words words for each variable.
+         */
+        void simulate(unsigned num_words, svector<uint64_t>& sigs);
+
         void simplify();
 
         std::ostream& display(std::ostream& out) const;
@@ -204,6 +204,79 @@ namespace sat {
 
     }
 
+    struct glue_size_lt {
+        bool operator()(clause const * c1, clause const * c2) const {
+            if (c1->glue() != c2->glue()) return c1->glue() < c2->glue();
+            return c1->size() < c2->size();
+        }
+    };
+
+    /**
+       \brief vivify learned clauses whose glue is at most max_glue.
+       Clauses are visited by increasing glue, so the core tier is
+       processed before the second tier, until the propagation budget
+       is exhausted.
+    */
+    void asymm_branch::vivify(unsigned max_glue, unsigned budget) {
+        s.propagate(false); // must propagate, since it uses s.push()
+        if (s.m_inconsistent || budget == 0)
+            return;
+        CASSERT("asymm_branch", s.check_invariant());
+        unsigned elim0 = m_elim_learned_literals;
+        bool_vector saved_phase(s.m_phase);
+        flet<bool> _is_probing(s.m_is_probing, true);
+        flet<int64_t> _counter(m_counter, budget);
+        flet<unsigned> _touch_index(m_touch_index, 0); // every variable counts as touched
+        clause_vector& clauses = s.m_learned;
+        std::stable_sort(clauses.begin(), clauses.end(), glue_size_lt());
+        unsigned i = 0, j = 0, sz = clauses.size();
+        try {
+            for (; i < sz; ++i) {
+                clause& c = *clauses[i];
+                if (m_counter > 0 && !s.inconsistent() && !c.was_removed() && 
+                    !c.frozen() && c.glue() <= max_glue) {
+                    s.checkpoint();
+                    if (!vivify(c))
+                        continue; // clause was removed
+                }
+                clauses[j++] = &c;
+            }
+            clauses.shrink(j);
+        }
+        catch (solver_exception &) {
+            // put m_learned in a consistent state...
+            for (; i < sz; ++i) 
+                clauses[j++] = clauses[i];
+            clauses.shrink(j);
+            s.m_phase = saved_phase;
+            throw;
+        }
+        s.m_phase = saved_phase;
+        m_vivified_literals += m_elim_learned_literals - elim0;
+        IF_VERBOSE(2, verbose_stream() << " (sat-vivify :elim-learned-literals " << (m_elim_learned_literals - elim0)
+                   << " :cost " << (budget - m_counter) << ")\n";);
+        CASSERT("asymm_branch", s.check_invariant());
+    }
+
+    bool asymm_branch::vivify(clause & c) {
+        SASSERT(c.is_learned());
+        SASSERT(s.scope_lvl() == 0);
+        for (literal l : c) {
+            switch (s.value(l)) {
+            case l_true:
+                s.detach_clause(c);
+                s.del_clause(c);
+                return false;
+            case l_false:
+                return true; // leave it to the clause cleanup
+            default:
+                break;
+            }
+        }
+        m_counter -= c.size();
+        return process_all(c);
+    }
+
     /**
        \brief try asymmetric branching on all literals in clause.        
     */
@@ -489,12 +562,14 @@ namespace sat {
     void asymm_branch::collect_statistics(statistics & st) const {
         st.update("sat elim literals", m_elim_literals);
         st.update("sat tr", m_tr);
+        st.update("sat vivified literals", m_vivified_literals);
     }
 
     void asymm_branch::reset_statistics() {
         m_elim_literals = 0;
         m_elim_learned_literals = 0;
         m_tr = 0;
+        m_vivified_literals = 0;
     }
 
 };
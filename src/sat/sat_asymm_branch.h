@@ -49,6 +49,7 @@ namespace sat {
         unsigned   m_elim_literals;
         unsigned   m_elim_learned_literals;
         unsigned   m_tr;
+        unsigned   m_vivified_literals;
 
         literal_vector m_pos, m_neg; // literals (complements of literals) in clauses sorted by discovery time (m_left in BIG).
         svector<std::pair<literal, unsigned>> m_pos1, m_neg1;
@@ -82,6 +83,8 @@ namespace sat {
         
         bool process_all(clause & c);
 
+        bool vivify(clause & c);
+
         void process_bin(big& big);
         
         bool flip_literal_at(clause const& c, unsigned flip_index, unsigned& new_sz);
@@ -95,6 +98,8 @@ namespace sat {
 
         void operator()(bool force);
 
+        void vivify(unsigned max_glue, unsigned budget);
+
         void updt_params(params_ref const & p);
         static void collect_param_descrs(param_descrs & d);
 
@@ -69,6 +69,8 @@ namespace sat {
             throw sat_param_exception("invalid phase selection strategy: always_false, always_true, basic_caching, caching, random");
 
         m_rephase_base      = p.rephase_base();
+        m_rephase_walk      = p.rephase_walk();
+        m_phase_target      = p.phase_target();
         m_reorder_base      = p.reorder_base();
         m_reorder_itau      = p.reorder_itau();
         m_activity_scale  = p.reorder_activity_scale();
@@ -93,6 +95,7 @@ namespace sat {
         m_enable_pre_simplify  = p.enable_pre_simplify();
         
         m_max_conflicts   = p.max_conflicts();
+        m_backbone_chunk_size = p.backbone_chunk_size();
         m_num_threads     = p.threads();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
@@ -118,6 +121,7 @@ namespace sat {
         m_cut_dont_cares    = p.cut_dont_cares();
         m_cut_redundancies  = p.cut_redundancies();
         m_cut_force         = p.cut_force();
+        m_cut_simulate      = p.cut_simulate();
         m_lookahead_simplify = p.lookahead_simplify();
         m_lookahead_double = p.lookahead_double();
         m_lookahead_simplify_bca = p.lookahead_simplify_bca();
@@ -155,6 +159,7 @@ namespace sat {
         m_lookahead_global_autarky = p.lookahead_global_autarky();
         m_lookahead_delta_fraction = p.lookahead_delta_fraction();
         m_lookahead_use_learned = p.lookahead_use_learned();
+        m_lookahead_threads = p.lookahead_threads();
         if (m_lookahead_delta_fraction < 0 || m_lookahead_delta_fraction > 1.0) {
             throw sat_param_exception("invalid value for delta fraction. It should be a number in the interval 0 to 1"); 
         }
@@ -185,6 +190,12 @@ namespace sat {
         m_gc_k            = std::min(255u, p.gc_k());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
+        m_gc_tier1_glue   = p.gc_tier1_glue();
+        m_gc_tier2_glue   = std::max(m_gc_tier1_glue, p.gc_tier2_glue());
+        m_gc_pop_retain_glue = p.gc_pop_retain_glue();
+
+        m_vivify          = p.vivify();
+        m_vivify_budget   = p.vivify_budget();
 
         m_force_cleanup   = p.force_cleanup();
 
@@ -244,10 +255,10 @@ namespace sat {
         s = p.pb_resolve();
         if (s == "cardinality") 
             m_pb_resolve = PB_CARDINALITY;
-        else if (s == "rounding") 
+        else if (s == "rounding" || s == "cutting_planes") 
             m_pb_resolve = PB_ROUNDING;
         else 
-            throw sat_param_exception("invalid PB resolve: 'cardinality' or 'rounding' expected");
+            throw sat_param_exception("invalid PB resolve: 'cardinality', 'rounding' or 'cutting_planes' expected");
 
         s = p.pb_lemma_format();
         if (s == "cardinality") 
@@ -256,9 +267,17 @@ namespace sat {
             m_pb_lemma_format = PB_LEMMA_PB;
         else
             throw sat_param_exception("invalid PB lemma format: 'cardinality' or 'pb' expected");
+        // cutting planes learns the PB constraints derived by rounding
+        if (p.pb_resolve() == "cutting_planes")
+            m_pb_lemma_format = PB_LEMMA_PB;
         
         m_card_solver = p.cardinality_solver();
-        m_xor_solver = false; // prevent users from playing with this option
+        m_card_counting = p.cardinality_counting();
+        m_xor_solver = p.xor_solver();
+        m_symmetry = p.symmetry();
+        m_symmetry_budget = p.symmetry_budget();
+        m_symmetry_max_generators = p.symmetry_max_generators();
+        m_symmetry_max_support = p.symmetry_max_support();
 
         sat_simplifier_params ssp(_p);
         m_elim_vars = ssp.elim_vars();
@@ -90,6 +90,8 @@ namespace sat {
         unsigned           m_search_unsat_conflicts;
         bool               m_phase_sticky;
         unsigned           m_rephase_base;
+        unsigned           m_rephase_walk;
+        bool               m_phase_target;
         unsigned           m_reorder_base;
         double             m_reorder_itau;
         unsigned           m_reorder_activity_scale;
@@ -110,6 +112,7 @@ namespace sat {
         unsigned           m_burst_search;
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
+        unsigned           m_backbone_chunk_size;
         unsigned           m_num_threads;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
@@ -128,6 +131,7 @@ namespace sat {
         bool               m_cut_dont_cares;
         bool               m_cut_redundancies;
         bool               m_cut_force;
+        bool               m_cut_simulate;
         bool               m_anf_simplify;
         unsigned           m_anf_delay;
         bool               m_anf_exlin;
@@ -145,6 +149,7 @@ namespace sat {
         bool               m_lookahead_global_autarky;
         double             m_lookahead_delta_fraction;
         bool               m_lookahead_use_learned;
+        unsigned           m_lookahead_threads;
 
         bool               m_incremental;
         unsigned           m_next_simplify1;
@@ -161,6 +166,12 @@ namespace sat {
         unsigned           m_gc_k;
         bool               m_gc_burst;
         bool               m_gc_defrag;
+        unsigned           m_gc_tier1_glue;
+        unsigned           m_gc_tier2_glue;
+        unsigned           m_gc_pop_retain_glue;
+
+        bool               m_vivify;
+        unsigned           m_vivify_budget;
 
         bool               m_force_cleanup;
 
@@ -185,7 +196,12 @@ namespace sat {
         bool               m_drat_activity;
         
         bool               m_card_solver;
+        unsigned           m_card_counting;
         bool               m_xor_solver;
+        bool               m_symmetry;
+        unsigned           m_symmetry_budget;
+        unsigned           m_symmetry_max_generators;
+        unsigned           m_symmetry_max_support;
         pb_resolve         m_pb_resolve;
         pb_lemma_format    m_pb_lemma_format;
         
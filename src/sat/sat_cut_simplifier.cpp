@@ -474,33 +474,48 @@ namespace sat {
     }
 
     void cut_simplifier::simulate_eqs() {
-        if (!m_config.m_simulate_eqs) return;
-        auto var2val = m_aig_cuts.simulate(4);
+        if (!m_config.m_simulate_eqs && !s.m_config.m_cut_simulate) return;
+        // 256 random patterns per variable
+        unsigned const num_words = 4;
+        svector<uint64_t> sigs;
+        m_aig_cuts.simulate(num_words, sigs);
+        unsigned_vector vars;
+        for (unsigned v = 0; v < sigs.size() / num_words; ++v) 
+            if (!s.was_eliminated(v) && s.value(v) == l_undef)
+                vars.push_back(v);
+
+        // bucket variables by signature modulo complementation.
+        auto sig = [&](unsigned v, unsigned w) {
+            uint64_t val = sigs[v * num_words + w];
+            return (sigs[v * num_words] & 1) ? ~val : val;
+        };
+        auto lt = [&](unsigned u, unsigned v) {
+            for (unsigned w = 0; w < num_words; ++w)
+                if (sig(u, w) != sig(v, w))
+                    return sig(u, w) < sig(v, w);
+            return u < v;
+        };
+        auto eq = [&](unsigned u, unsigned v) {
+            for (unsigned w = 0; w < num_words; ++w)
+                if (sig(u, w) != sig(v, w))
+                    return false;
+            return true;
+        };
+        std::sort(vars.begin(), vars.end(), lt);
 
         // Assign higher cutset budgets to equality candidates that come from simulation
         // touch them to trigger recomputation of cutsets.
-        u64_map<literal> val2lit;
-        unsigned i = 0, num_eqs = 0;
-        for (cut_val val : var2val) {
-            if (!s.was_eliminated(i) && s.value(i) == l_undef) {
-                literal u(i, false), v;
-                if (val2lit.find(val.m_t, v)) {
-                    
-                    m_aig_cuts.inc_max_cutset_size(i);
-                    m_aig_cuts.inc_max_cutset_size(v.var());
-                    num_eqs++;
-                }
-                else if (val2lit.find(val.m_f, v)) {
-                    m_aig_cuts.inc_max_cutset_size(i);
-                    m_aig_cuts.inc_max_cutset_size(v.var());
-                    num_eqs++;
-                }
-                else {
-                    val2lit.insert(val.m_t, u);
-                    val2lit.insert(val.m_f, ~u);
-                }
+        unsigned num_eqs = 0;
+        for (unsigned i = 0; i < vars.size(); ) {
+            unsigned j = i + 1;
+            while (j < vars.size() && eq(vars[i], vars[j]))
+                ++j;
+            if (j > i + 1) {
+                for (unsigned k = i; k < j; ++k)
+                    m_aig_cuts.inc_max_cutset_size(vars[k]);
+                num_eqs += j - i - 1;
             }
-            ++i;
+            i = j;
         }
         IF_VERBOSE(2, verbose_stream() << "(sat.cut-simplifier num simulated eqs " << num_eqs << ")\n");
     }
@@ -85,36 +85,47 @@ namespace sat {
         return false;
     }
 
+    /**
+     * The rewards of the candidates are gathered into a contiguous buffer once per step.
+     * The weight of all candidates with positive reward is then summed in a
+     * branch-free loop the compiler vectorizes, and the selection scans the buffer
+     * instead of the strided var_info records. It relies on score being the identity.
+     */
     bool_var ddfw::pick_var() {
-        double sum_pos = 0;
-        unsigned n = 1;
-        bool_var v0 = null_bool_var;
-        for (bool_var v : m_unsat_vars) {
-            int r = reward(v);
-            if (r > 0) {                
-                sum_pos += score(r);
-            }
-            else if (r == 0 && sum_pos == 0 && (m_rand() % (n++)) == 0) {
-                v0 = v;
-            }
+        unsigned sz = m_unsat_vars.size();
+        m_candidate_rewards.reserve(sz);
+        m_candidate_rewards.reset();
+        for (bool_var v : m_unsat_vars) 
+            m_candidate_rewards.push_back(reward(v));
+        int const* rewards = m_candidate_rewards.data();
+        uint64_t sum_pos = 0;
+        unsigned num_zero = 0;
+        for (unsigned i = 0; i < sz; ++i) {
+            int r = rewards[i];
+            sum_pos += r > 0 ? static_cast<uint64_t>(r) : 0;
+            num_zero += r == 0;
         }
         if (sum_pos > 0) {
             double lim_pos = ((double) m_rand() / (1.0 + m_rand.max_value())) * sum_pos;                
-            for (bool_var v : m_unsat_vars) {
-                int r = reward(v);
+            for (unsigned i = 0; i < sz; ++i) {
+                int r = rewards[i];
                 if (r > 0) {
                     lim_pos -= score(r);
                     if (lim_pos <= 0) {
+                        bool_var v = m_unsat_vars.elem_at(i);
                         if (m_par) update_reward_avg(v);
                         return v;
                     }
                 }
             }
         }
-        if (v0 != null_bool_var) {
-            return v0;
+        if (num_zero > 0) {
+            unsigned k = m_rand(num_zero);
+            for (unsigned i = 0; i < sz; ++i) 
+                if (rewards[i] == 0 && k-- == 0)
+                    return m_unsat_vars.elem_at(i);
         }
-        return m_unsat_vars.elem_at(m_rand(m_unsat_vars.size()));
+        return m_unsat_vars.elem_at(m_rand(sz));
     }
 
     /**
@@ -181,7 +192,10 @@ namespace sat {
         add_assumptions();
         for (unsigned v = 0; v < num_vars(); ++v) {
             literal lit(v, false), nlit(v, true);
-            value(v) = (m_rand() % 2) == 0; // m_use_list[lit.index()].size() >= m_use_list[nlit.index()].size();
+            if (v < m_initial_phases.size())
+                value(v) = m_initial_phases[v];
+            else
+                value(v) = (m_rand() % 2) == 0; // m_use_list[lit.index()].size() >= m_use_list[nlit.index()].size();
         }
         init_clause_data();
         flatten_use_list();
@@ -420,6 +434,9 @@ namespace sat {
                 }
             }
         }
+        m_best_values.reserve(num_vars());
+        for (unsigned v = 0; v < num_vars(); ++v)
+            m_best_values[v] = value(v);
         unsigned h = value_hash();
         if (!m_models.contains(h)) {
             for (unsigned v = 0; v < num_vars(); ++v) {
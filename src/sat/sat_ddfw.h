@@ -81,7 +81,10 @@ namespace sat {
         svector<var_info>    m_vars;        // var -> info
         svector<double>      m_probs;       // var -> probability of flipping
         svector<double>      m_scores;      // reward -> score
+        svector<int>         m_candidate_rewards; // rewards of m_unsat_vars, in order, for pick_var
         model                m_model;       // var -> best assignment
+        bool_vector          m_initial_phases;
+        bool_vector          m_best_values; // assignment with the fewest unsatisfied clauses
         
         vector<unsigned_vector> m_use_list;
         unsigned_vector  m_flat_use_list;
@@ -209,6 +212,13 @@ namespace sat {
 
         void set_seed(unsigned n) override { m_rand.set_seed(n); }
 
+        // initial values of the variables instead of random values
+        void set_initial_phases(bool_vector const& phases) { m_initial_phases = phases; }
+
+        // values of the assignment with the fewest unsatisfied clauses
+        bool has_best_value(bool_var v) const { return v < m_best_values.size(); }
+        bool get_best_value(bool_var v) const { return m_best_values[v]; }
+
         void add(solver const& s) override;
        
         std::ostream& display(std::ostream& out) const;
@@ -21,6 +21,7 @@ Notes:
 --*/
 
 #include "util/rational.h"
+#include "util/writeback_stream.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_drat.h"
 
@@ -31,7 +32,9 @@ namespace sat {
     {
         if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
-            m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
+            m_file = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
+            // proof steps are written to the file by a background thread
+            m_out = alloc(writeback_ostream, *m_file);
             if (s.get_config().m_drat_binary) 
                 std::swap(m_out, m_bout);            
         }
@@ -42,6 +45,7 @@ namespace sat {
         if (m_bout) m_bout->flush();
         dealloc(m_out);
         dealloc(m_bout);
+        dealloc(m_file);
         for (auto & [c, st] : m_proof) 
             m_alloc.del_clause(&c);            
         m_proof.reset();
@@ -50,6 +50,7 @@ namespace sat {
         typedef svector<unsigned> watch;
         solver& s;
         clause_allocator        m_alloc;
+        std::ostream*           m_file = nullptr;
         std::ostream*           m_out = nullptr;
         std::ostream*           m_bout = nullptr;
         svector<std::pair<clause&, status>> m_proof;
@@ -75,6 +75,33 @@ namespace sat {
         CASSERT("sat_gc_bug", check_invariant());
     }
 
+    /**
+       \brief The memory governor reports pressure when the allocated memory
+       approaches the memory limit. Learned clauses are then collected four
+       times as often, regardless of the gc strategy, so that search slows
+       down before it runs out of memory.
+    */
+    bool solver::should_reduce_memory() const {
+        return
+            m_conflicts_since_gc > m_gc_threshold / 4 &&
+            !m_learned.empty() &&
+            memory::get_pressure(m_config.m_max_memory) != memory::NO_PRESSURE;
+    }
+
+    void solver::reduce_memory() {
+        unsigned gc = m_stats.m_gc_clause;
+        m_conflicts_since_gc = 0;
+        m_stats.m_memory_reductions++;
+        CASSERT("sat_gc_bug", check_invariant());
+        gc_glue_psm();
+        if (m_ext) m_ext->gc();
+        if (gc < m_stats.m_gc_clause && should_defrag()) 
+            defrag_clauses();
+        IF_VERBOSE(2, verbose_stream() << "(sat.reduce-memory :deleted " << (m_stats.m_gc_clause - gc)
+                   << " :memory " << mem_stat() << ")\n";);
+        CASSERT("sat_gc_bug", check_invariant());
+    }
+
     /**
        \brief Lex on (glue, size)
     */
@@ -155,15 +182,22 @@ namespace sat {
 
     /**
        \brief GC (the second) half of the clauses in the database.
+       Clauses in the core tier (glue <= gc.tier1_glue) are kept, and clauses
+       in the second tier (glue <= gc.tier2_glue) are kept if they were used
+       in conflict analysis since the previous gc round.
     */
     void solver::gc_half(char const * st_name) {
         TRACE("sat", tout << "gc\n";);
         unsigned sz     = m_learned.size();
         unsigned new_sz = sz/2; // std::min(sz/2, m_clauses.size()*2);
         unsigned j      = new_sz;
+        for (unsigned i = 0; i < new_sz; i++) 
+            m_learned[i]->unmark_used();
         for (unsigned i = new_sz; i < sz; i++) {
             clause & c = *(m_learned[i]);
-            if (can_delete(c)) {
+            bool keep = c.glue() <= m_config.m_gc_tier1_glue || (c.glue() <= m_config.m_gc_tier2_glue && c.was_used());
+            c.unmark_used();
+            if (!keep && can_delete(c)) {
                 detach_clause(c);
                 del_clause(c);
             }
@@ -445,8 +479,12 @@ namespace sat {
             }
             clauses.shrink(j);
         };
+        unsigned num_learned = m_learned.size();
         gc_clauses(m_learned);
         gc_clauses(m_clauses);
+        m_stats.m_pop_deleted_learned += num_learned - m_learned.size();
+        m_stats.m_pop_retained_learned += m_learned.size();
+        retain_base_learned();
 
         if (m_ext)
             m_ext->gc_vars(max_var);
@@ -461,6 +499,33 @@ namespace sat {
         shrink_vars(max_var);
     }
 
+    /**
+       \brief Move the learned clauses that are justified by clauses outside
+       of user scopes to the core tier, so that glue based garbage collection
+       keeps them along the following scopes. Clauses added in a user scope
+       contain the literals of all the open scopes, and conflict resolution
+       keeps them in the clauses it learns from them, so a learned clause
+       without scope literals follows from the base clauses alone.
+    */
+    void solver::retain_base_learned() {
+        if (m_config.m_gc_pop_retain_glue == 0)
+            return;
+        bool_vector is_scope_var(num_vars(), false);
+        for (literal lit : m_user_scope_literals)
+            is_scope_var[lit.var()] = true;
+        for (clause* c : m_learned) {
+            if (c->glue() <= m_config.m_gc_tier1_glue || c->glue() > m_config.m_gc_pop_retain_glue)
+                continue;
+            bool is_base = true;
+            for (literal lit : *c)
+                is_base &= !is_scope_var[lit.var()];
+            if (is_base) {
+                c->set_glue(m_config.m_gc_tier1_glue);
+                m_stats.m_pop_frozen_learned++;
+            }
+        }
+    }
+
 #if 0
     void solver::gc_reinit_stack(unsigned num_scopes) {
         SASSERT (!at_base_lvl());
@@ -24,16 +24,17 @@ namespace sat {
     public:
         enum kind { NONE = 0, BINARY = 1, CLAUSE = 2, EXT_JUSTIFICATION = 3};
     private:
-        unsigned m_level;
+        // m_val1 comes first so that the two unsigned fields share a word
         size_t m_val1;
+        unsigned m_level;
         unsigned m_val2; 
-        justification(unsigned lvl, ext_justification_idx idx, kind k):m_level(lvl), m_val1(idx), m_val2(k) {}
+        justification(unsigned lvl, ext_justification_idx idx, kind k):m_val1(idx), m_level(lvl), m_val2(k) {}
         unsigned val1() const { return static_cast<unsigned>(m_val1); }
     public:
-        justification(unsigned lvl):m_level(lvl), m_val1(0), m_val2(NONE) {}
-        explicit justification(unsigned lvl, literal l):m_level(lvl), m_val1(l.to_uint()), m_val2(BINARY) {}
+        justification(unsigned lvl):m_val1(0), m_level(lvl), m_val2(NONE) {}
+        explicit justification(unsigned lvl, literal l):m_val1(l.to_uint()), m_level(lvl), m_val2(BINARY) {}
 
-        explicit justification(unsigned lvl, clause_offset cls_off):m_level(lvl), m_val1(cls_off), m_val2(CLAUSE) {}
+        explicit justification(unsigned lvl, clause_offset cls_off):m_val1(cls_off), m_level(lvl), m_val2(CLAUSE) {}
         static justification mk_ext_justification(unsigned lvl, ext_justification_idx idx) { return justification(lvl, idx, EXT_JUSTIFICATION); }
         
         unsigned level() const { return m_level; }
@@ -25,6 +25,8 @@ Notes:
 #include "sat/sat_lookahead.h"
 #include "sat/sat_scc.h"
 #include "util/union_find.h"
+#include "util/mutex.h"
+#include "util/thread_pool.h"
 
 namespace sat {
     lookahead::scoped_ext::scoped_ext(lookahead& p): p(p) {
@@ -1748,6 +1750,11 @@ namespace sat {
     void lookahead::compute_lookahead_reward() {
         TRACE("sat", display_lookahead(tout); );
         m_delta_decrease = pow(m_config.m_delta_rho, 1.0 / (double)m_lookahead.size());
+        if (!m_workers.empty() && m_search_mode == lookahead_mode::searching) {
+            while (!inconsistent() && compute_lookahead_reward_par())
+                ;
+            return;
+        }
         unsigned base = 2;
         bool change = true;
         literal last_changed = null_literal;
@@ -1824,6 +1831,164 @@ namespace sat {
         TRACE("sat", display_lookahead(tout); );
     }
 
+    struct lookahead::worker {
+        reslimit                            m_limit;
+        scoped_ptr<solver>                  m_solver;
+        scoped_ptr<lookahead>               m_lookahead;
+        svector<std::pair<literal, double>> m_rewards;
+        literal_vector                      m_failed;
+    };
+
+    /**
+       \brief create copies of the solver that evaluate the lookahead
+       candidates of a node in parallel with this lookahead.
+       Extensions are not copied, so there are no workers when the solver
+       has one.
+    */
+    void lookahead::init_workers() {
+        reset_workers();
+        if (m_config.m_threads <= 1 || m_s.m_ext)
+            return;
+        for (unsigned i = 1; i < m_config.m_threads; ++i) {
+            worker* w = alloc(worker);
+            m_s.rlimit().push_child(&w->m_limit);
+            m_workers.push_back(w);
+            w->m_solver = alloc(solver, m_s.params(), w->m_limit);
+            w->m_solver->copy(m_s, m_s.m_config.m_lookahead_use_learned);
+            w->m_lookahead = alloc(lookahead, *w->m_solver);
+            w->m_lookahead->init_search();
+        }
+    }
+
+    void lookahead::reset_workers() {
+        for (worker* w : m_workers) {
+            dealloc(w);
+            m_s.rlimit().pop_child();
+        }
+        m_workers.reset();
+    }
+
+    /**
+       \brief replace the assignment of a worker by the fixed literals of
+       the current node of the cube search.
+    */
+    void lookahead::sync(literal_vector const& fixed) {
+        while (!m_trail_lim.empty())
+            pop();
+        scoped_level _sl(*this, c_fixed_truth);
+        m_search_mode = lookahead_mode::searching;
+        bool first = true;
+        for (literal l : fixed) {
+            if (inconsistent())
+                break;
+            if (!is_undef(l))
+                continue;
+            if (first) {
+                push(l, c_fixed_truth);
+                first = false;
+            }
+            else {
+                assign(l);
+                propagate();
+            }
+        }
+    }
+
+    /**
+       \brief evaluate the candidates start, start + step, ... each in
+       isolation. The rewards are not inherited from the parent literal and
+       there is no double lookahead, so the result does not depend on the
+       other candidates.
+    */
+    void lookahead::evaluate_candidates(literal_vector const& cands, unsigned start, unsigned step, 
+                                        svector<std::pair<literal, double>>& rewards, literal_vector& failed) {
+        unsigned level = 2;
+        for (unsigned i = start; !inconsistent() && i < cands.size(); i += step) {
+            checkpoint();
+            literal lit = cands[i];
+            if (is_fixed_at(lit, c_fixed_truth))
+                continue;
+            if (level + 2 >= c_fixed_truth)
+                break;
+            level += 2;
+            m_lookahead_reward = 0;
+            set_lookahead_reward(lit, 0);
+            unsigned num_units = push_lookahead1(lit, level);
+            update_lookahead_reward(lit, level);
+            bool unsat = inconsistent();
+            pop_lookahead1(lit, num_units);
+            if (unsat)
+                failed.push_back(lit);
+            else
+                rewards.push_back({ lit, get_lookahead_reward(lit) });
+        }
+        lookahead_backtrack();
+    }
+
+    /**
+       \brief evaluate the lookahead candidates on this lookahead and on
+       the workers. The failed literals are asserted afterwards.
+       Return true if a failed literal was found, then the rewards are
+       recomputed for the simplified node.
+    */
+    bool lookahead::compute_lookahead_reward_par() {
+        ++m_stats.m_parallel_rounds;
+        literal_vector fixed, cands;
+        for (literal l : m_trail)
+            if (is_fixed_at(l, c_fixed_truth))
+                fixed.push_back(l);
+        for (auto const& lh : m_lookahead)
+            cands.push_back(lh.m_lit);
+        unsigned n = m_workers.size() + 1;
+        svector<std::pair<literal, double>> rewards;
+        literal_vector failed;
+        mutex mux;
+        std::string ex_msg;
+        bool has_ex = false;
+        thread_pool::run(n, [&](unsigned k) {
+            try {
+                if (k == 0) {
+                    evaluate_candidates(cands, 0, n, rewards, failed);
+                    return;
+                }
+                worker& w = *m_workers[k - 1];
+                w.m_rewards.reset();
+                w.m_failed.reset();
+                w.m_lookahead->sync(fixed);
+                if (!w.m_lookahead->inconsistent())
+                    w.m_lookahead->evaluate_candidates(cands, k, n, w.m_rewards, w.m_failed);
+            }
+            catch (z3_exception& ex) {
+                lock_guard lock(mux);
+                has_ex = true;
+                ex_msg = ex.msg();
+                for (worker* w : m_workers)
+                    w->m_limit.cancel();
+            }
+        });
+        for (worker* w : m_workers)
+            w->m_limit.reset_cancel();
+        if (has_ex)
+            throw solver_exception(ex_msg.c_str());
+        for (worker* w : m_workers) {
+            for (auto const& [lit, r] : w->m_rewards)
+                set_lookahead_reward(lit, r);
+            failed.append(w->m_failed);
+        }
+        bool change = false;
+        for (literal lit : failed) {
+            if (inconsistent())
+                break;
+            if (is_fixed_at(lit, c_fixed_truth))
+                continue;
+            TRACE("sat", tout << "parallel lookahead setting " << ~lit << "\n";);
+            assign(~lit);
+            propagate();
+            change = true;
+        }
+        return change;
+    }
+
     literal lookahead::select_literal() {
         literal l = null_literal;
         double h = 0;
@@ -2151,6 +2316,7 @@ namespace sat {
                 m_select_lookahead_vars.insert(v);
             }
             init_search();
+            init_workers();
             m_model.reset();
             m_cube_state.m_first = false;
         }        
@@ -2588,6 +2754,7 @@ namespace sat {
         m_config.m_cube_psat_var_exp = m_s.m_config.m_lookahead_cube_psat_var_exp;
         m_config.m_cube_psat_clause_base = m_s.m_config.m_lookahead_cube_psat_clause_base;
         m_config.m_cube_psat_trigger = m_s.m_config.m_lookahead_cube_psat_trigger;
+        m_config.m_threads = m_s.m_config.m_lookahead_threads;
     }
 
     void lookahead::collect_statistics(statistics& st) const {
@@ -2601,6 +2768,7 @@ namespace sat {
         st.update("lh windfalls", m_stats.m_windfall_binaries);
         st.update("lh double lookahead propagations", m_stats.m_double_lookahead_propagations);
         st.update("lh double lookahead rounds", m_stats.m_double_lookahead_rounds);
+        st.update("lh parallel rounds", m_stats.m_parallel_rounds);
     }
 
 }
@@ -91,6 +91,7 @@ namespace sat {
             double   m_cube_psat_var_exp;
             double   m_cube_psat_clause_base;
             double   m_cube_psat_trigger;
+            unsigned m_threads;
 
             config() {
                 memset(this, 0, sizeof(*this));
@@ -112,6 +113,7 @@ namespace sat {
                 m_cube_psat_var_exp = 1.0;
                 m_cube_psat_clause_base = 2.0;
                 m_cube_psat_trigger = 5.0;
+                m_threads = 1;
             }
         };
 
@@ -136,6 +138,7 @@ namespace sat {
             unsigned m_windfall_binaries;
             unsigned m_double_lookahead_propagations;
             unsigned m_double_lookahead_rounds;
+            unsigned m_parallel_rounds;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -252,6 +255,10 @@ namespace sat {
         cube_state             m_cube_state;
         unsigned               m_max_ops;       // cap number of operations used to compute lookahead reward.
         //scoped_ptr<extension>  m_ext;
+
+        // copies of the solver that evaluate lookahead candidates in parallel
+        struct worker;
+        ptr_vector<worker>     m_workers;
  
         // ---------------------------------------
         // truth values
@@ -516,6 +523,12 @@ namespace sat {
         literal choose();
         literal choose_base();
         void compute_lookahead_reward();
+        void init_workers();
+        void reset_workers();
+        void sync(literal_vector const& fixed);
+        void evaluate_candidates(literal_vector const& cands, unsigned start, unsigned step, 
+                                 svector<std::pair<literal, double>>& rewards, literal_vector& failed);
+        bool compute_lookahead_reward_par();
         literal select_literal();
         void update_binary_clause_reward(literal l1, literal l2);
         void update_nary_clause_reward(clause const& c);
@@ -580,6 +593,7 @@ namespace sat {
         }
 
         ~lookahead() {
+            reset_workers();
             m_s.rlimit().pop_child();
             for (nary* n : m_nary_clauses) { 
                 m_allocator.deallocate(n->obj_size(), n);
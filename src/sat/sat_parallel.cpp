@@ -22,74 +22,111 @@ Revision History:
 
 namespace sat {
 
-    void parallel::vector_pool::next(unsigned& index) {
-        SASSERT(index < m_size);
-        unsigned n = index + 2 + get_length(index);
-        if (n >= m_size) {
-            index = 0;
-        }
-        else {
-            index = n;
-        }
+    parallel::clause_ring::clause_ring(unsigned capacity): m_capacity(capacity), m_mask(capacity - 1) {
+        SASSERT((capacity & m_mask) == 0);
+        m_data = alloc_vect<std::atomic<unsigned>>(capacity);
     }
 
-    void parallel::vector_pool::reserve(unsigned num_threads, unsigned sz) {
-        m_vectors.reset();
-        m_vectors.resize(sz, 0);
-        m_heads.reset();
-        m_heads.resize(num_threads, 0);
-        m_at_end.reset();
-        m_at_end.resize(num_threads, true);
-        m_tail = 0;
-        m_size = sz;
+    parallel::clause_ring::~clause_ring() {
+        dealloc_vect(m_data, m_capacity);
     }
-    
-    void parallel::vector_pool::begin_add_vector(unsigned owner, unsigned n) {
-        SASSERT(m_tail < m_size);
-        unsigned capacity = n + 2;
-        m_vectors.reserve(m_size + capacity, 0);
-        IF_VERBOSE(3, verbose_stream() << owner << ": begin-add " << n << " tail: " << m_tail << " size: " << m_size << "\n";);
-        for (unsigned i = 0; i < m_heads.size(); ++i) {
-            while (m_tail < m_heads[i] && m_heads[i] < m_tail + capacity) {
-                next(m_heads[i]);
+
+    /**
+       \brief append a clause to the ring. Only the owner of the ring calls push.
+       The reservation is published before the data is overwritten, so that readers
+       that observe stale data also observe the reservation.
+    */
+    bool parallel::clause_ring::push(unsigned n, literal const* lits) {
+        if (n + 1 > m_capacity)
+            return false;
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        uint64_t new_tail = tail + n + 1;
+        m_reserved.store(new_tail, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_data[tail & m_mask].store(n, std::memory_order_relaxed);
+        for (unsigned i = 0; i < n; ++i)
+            m_data[(tail + i + 1) & m_mask].store(lits[i].index(), std::memory_order_relaxed);
+        m_tail.store(new_tail, std::memory_order_release);
+        ++m_num_exported;
+        return true;
+    }
+
+    /**
+       \brief retrieve the next clause after head. Clauses that were overwritten 
+       before they could be read are skipped and counted in num_dropped.
+    */
+    bool parallel::clause_ring::pop(uint64_t& head, literal_vector& lits, unsigned& num_dropped) const {
+        while (true) {
+            uint64_t tail = m_tail.load(std::memory_order_acquire);
+            if (head >= tail)
+                return false;
+            if (tail - head > m_capacity) {
+                ++num_dropped;
+                head = tail;
+                return false;
             }
-            m_at_end[i] = false;
+            unsigned n = m_data[head & m_mask].load(std::memory_order_relaxed);
+            bool ok = n + 1 <= tail - head;
+            lits.reset();
+            for (unsigned i = 0; ok && i < n; ++i)
+                lits.push_back(to_literal(m_data[(head + i + 1) & m_mask].load(std::memory_order_relaxed)));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (!ok || m_reserved.load(std::memory_order_relaxed) - head > m_capacity) {
+                // the producer wrapped around while the record was read.
+                ++num_dropped;
+                head = tail;
+                continue;
+            }
+            head += n + 1;
+            return true;
         }
-        m_vectors[m_tail++] = owner;
-        m_vectors[m_tail++] = n;    
     }
 
-    void parallel::vector_pool::add_vector_elem(unsigned e) {
-        m_vectors[m_tail++] = e;
+    void parallel::clause_pool::reserve(unsigned num_owners, unsigned sz) {
+        unsigned capacity = 1;
+        while (capacity < sz) 
+            capacity *= 2;
+        m_rings.reset();
+        for (unsigned i = 0; i < num_owners; ++i)
+            m_rings.push_back(alloc(clause_ring, capacity));
+        m_heads.reset();
+        m_heads.resize(num_owners * num_owners, 0);
+        m_num_imported.reset();
+        m_num_imported.resize(num_owners, 0);
+        m_num_dropped.reset();
+        m_num_dropped.resize(num_owners, 0);
     }
 
-    void parallel::vector_pool::end_add_vector() {
-        if (m_tail >= m_size) {
-            m_tail = 0;
-        }
+    void parallel::clause_pool::add_vector(unsigned owner, unsigned n, literal const* lits) {
+        m_rings[owner]->push(n, lits);
     }
 
-
-    bool parallel::vector_pool::get_vector(unsigned owner, unsigned& n, unsigned const*& ptr) {
-        unsigned head = m_heads[owner];      
-        unsigned iterations = 0;
-        while (head != m_tail || !m_at_end[owner]) {
-            ++iterations;
-            SASSERT(head < m_size && m_tail < m_size);            
-            bool is_self = owner == get_owner(head);
-            next(m_heads[owner]);
-            IF_VERBOSE(static_cast<unsigned>(iterations > m_size ? 0 : 3), verbose_stream() << owner << ": [" << head << ":" << m_heads[owner] << "] tail: " << m_tail << "\n";);
-            m_at_end[owner] = (m_heads[owner] == m_tail);
-            if (!is_self) {
-                n = get_length(head);
-                ptr = get_ptr(head);
+    bool parallel::clause_pool::get_vector(unsigned consumer, literal_vector& lits) {
+        unsigned num_owners = m_rings.size();
+        for (unsigned owner = 0; owner < num_owners; ++owner) {
+            if (owner == consumer)
+                continue;
+            if (m_rings[owner]->pop(m_heads[consumer * num_owners + owner], lits, m_num_dropped[consumer])) {
+                ++m_num_imported[consumer];
                 return true;
             }
-            head = m_heads[owner];
         }
         return false;
     }
 
+    void parallel::clause_pool::collect_statistics(statistics& st) const {
+        unsigned exported = 0, imported = 0, dropped = 0;
+        for (clause_ring* r : m_rings)
+            exported += r->m_num_exported;
+        for (unsigned n : m_num_imported)
+            imported += n;
+        for (unsigned n : m_num_dropped)
+            dropped += n;
+        st.update("sat par exported clauses", exported);
+        st.update("sat par imported clauses", imported);
+        st.update("sat par dropped clauses", dropped);
+    }
+
     parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
 
     parallel::~parallel() {
@@ -147,52 +184,33 @@ namespace sat {
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        literal lits[2] = { l1, l2 };
+        m_pool.add_vector(s.m_par_id, 2, lits);
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
         if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        unsigned n = c.size();
         unsigned owner = s.m_par_id;
         IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) {
-            m_pool.add_vector_elem(c[i].index());
-        }
-        m_pool.end_add_vector();        
+        m_pool.add_vector(owner, c.size(), c.begin());
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
         _get_clauses(s);        
     }
 
     void parallel::_get_clauses(solver& s) {
-        unsigned n;
-        unsigned const* ptr;
+        literal_vector lits;
         unsigned owner = s.m_par_id;
-        while (m_pool.get_vector(owner, n, ptr)) {
-            m_lits.reset();
-            bool usable_clause = true;
-            for (unsigned i = 0; usable_clause && i < n; ++i) {
-                literal lit(to_literal(ptr[i]));                
-                m_lits.push_back(lit);
-                usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
-            }
-            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
-            SASSERT(n >= 2);
+        while (m_pool.get_vector(owner, lits)) {
+            bool usable_clause = all_of(lits, [&](literal lit) { return lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var()); });
+            IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << lits << "\n";);
+            SASSERT(lits.size() >= 2);
             if (usable_clause) {
-                s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
+                s.mk_clause_core(lits.size(), lits.data(), sat::status::redundant());
             }
         }        
     }
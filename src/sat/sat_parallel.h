@@ -24,28 +24,41 @@ Revision History:
 #include "util/rlimit.h"
 #include "util/scoped_ptr_vector.h"
 #include "util/mutex.h"
+#include "util/statistics.h"
+#include <atomic>
 
 namespace sat {
 
     class parallel {
 
         // shared pool of learned clauses.
-        class vector_pool {
-            unsigned_vector m_vectors;
-            unsigned        m_size{ 0 };
-            unsigned        m_tail{ 0 };
-            unsigned_vector m_heads;
-            bool_vector   m_at_end;
-            void next(unsigned& index);
-            unsigned get_owner(unsigned index) const { return m_vectors[index]; }
-            unsigned get_length(unsigned index) const { return m_vectors[index+1]; }
-            unsigned const* get_ptr(unsigned index) const { return m_vectors.data() + index + 2; }
+        // Each solver owns a ring buffer that only it writes to.
+        // Readers keep their own position into every ring and
+        // detect records that were overwritten while being read.
+        class clause_ring {
+            unsigned                m_capacity;
+            unsigned                m_mask;
+            std::atomic<unsigned>*  m_data;
+            std::atomic<uint64_t>   m_reserved { 0 };
+            std::atomic<uint64_t>   m_tail { 0 };
+        public:
+            unsigned                m_num_exported { 0 };
+            clause_ring(unsigned capacity);
+            ~clause_ring();
+            bool push(unsigned n, literal const* lits);
+            bool pop(uint64_t& head, literal_vector& lits, unsigned& num_dropped) const;
+        };
+
+        class clause_pool {
+            scoped_ptr_vector<clause_ring> m_rings;
+            svector<uint64_t>              m_heads;     // m_heads[consumer * num_owners + owner]
+            unsigned_vector                m_num_imported;
+            unsigned_vector                m_num_dropped;
         public:
             void reserve(unsigned num_owners, unsigned sz);
-            void begin_add_vector(unsigned owner, unsigned n);
-            void end_add_vector();
-            void add_vector_elem(unsigned e);
-            bool get_vector(unsigned owner, unsigned& n, unsigned const*& ptr);
+            void add_vector(unsigned owner, unsigned n, literal const* lits);
+            bool get_vector(unsigned consumer, literal_vector& lits);
+            void collect_statistics(statistics& st) const;
         };
 
         bool enable_add(clause const& c) const;
@@ -58,8 +71,7 @@ namespace sat {
         typedef hashtable<unsigned, u_hash, u_eq> index_set;
         literal_vector m_units;
         index_set      m_unit_set;
-        literal_vector m_lits;
-        vector_pool    m_pool;
+        clause_pool    m_pool;
         mutex          m_mux;
 
         // for exchange with local search:
@@ -108,6 +120,8 @@ namespace sat {
         void to_solver(i_local_search& s);
         
         bool copy_solver(solver& s);
+
+        void collect_statistics(statistics& st) const { m_pool.collect_statistics(st); }
     };
 
 };
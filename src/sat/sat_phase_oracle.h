@@ -0,0 +1,78 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_phase_oracle.h
+
+Abstract:
+
+    Exchange of phases between the SAT solver and a local search
+    running on a thread of its own.
+
+    The oracle is created for a fixed set of variables. The local search
+    publishes its best assignment to them as hints. On every restart the
+    SAT solver takes over new hints as its phases and publishes its own
+    phases, which the local search can start from when it restarts.
+
+--*/
+#pragma once
+
+#include "sat/sat_types.h"
+#include "util/mutex.h"
+
+namespace sat {
+
+    class phase_oracle {
+        bool_var_vector m_vars;
+        mutex           m_mux;
+        bool_vector     m_hints;             // assignment of the local search, guarded by m_mux
+        bool            m_has_hints = false;
+        bool_vector     m_phases;            // phases of the SAT solver, guarded by m_mux
+        bool            m_has_phases = false;
+        unsigned        m_num_hints = 0;
+    public:
+        phase_oracle(bool_var_vector const& vars): m_vars(vars) {}
+
+        bool_var_vector const& vars() const { return m_vars; }
+
+        /**
+           \brief publish an assignment to vars(). The vector is taken over.
+         */
+        void set_hints(bool_vector& hints) {
+            lock_guard lock(m_mux);
+            m_hints.swap(hints);
+            m_has_hints = true;
+        }
+
+        bool get_hints(bool_vector& hints) {
+            lock_guard lock(m_mux);
+            if (!m_has_hints)
+                return false;
+            hints.swap(m_hints);
+            m_has_hints = false;
+            ++m_num_hints;
+            return true;
+        }
+
+        void set_phases(bool_vector& phases) {
+            lock_guard lock(m_mux);
+            m_phases.swap(phases);
+            m_has_phases = true;
+        }
+
+        bool get_phases(bool_vector& phases) {
+            lock_guard lock(m_mux);
+            if (!m_has_phases)
+                return false;
+            phases.swap(m_phases);
+            m_has_phases = false;
+            return true;
+        }
+
+        unsigned num_hints() {
+            lock_guard lock(m_mux);
+            return m_num_hints;
+        }
+    };
+}
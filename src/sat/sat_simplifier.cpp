@@ -24,6 +24,7 @@ Revision History:
 #include "sat/sat_elim_vars.h"
 #include "sat/sat_integrity_checker.h"
 #include "util/stopwatch.h"
+#include "util/thread_pool.h"
 #include "util/trace.h"
 
 namespace sat {
@@ -117,6 +118,10 @@ namespace sat {
     bool simplifier::elim_vars_enabled() const { 
         return !m_incremental_mode && !s.tracking_assumptions() && m_elim_vars && single_threaded(); 
     }    
+    bool simplifier::bva_enabled() const {
+        // fresh variables are not registered with extensions and would not be justified by drat
+        return !m_incremental_mode && !s.tracking_assumptions() && m_bva && single_threaded() && !s.m_ext && !s.m_config.m_drat;
+    }
 
     void simplifier::register_clauses(clause_vector & cs) {
         std::stable_sort(cs.begin(), cs.end(), size_lt());
@@ -192,7 +197,7 @@ namespace sat {
 
         if (s.inconsistent())
             return;
-        if (!m_subsumption && !bce_enabled() && !bca_enabled() && !elim_vars_enabled())
+        if (!m_subsumption && !bce_enabled() && !bca_enabled() && !elim_vars_enabled() && !bva_enabled())
             return;
        
         initialize();
@@ -244,6 +249,10 @@ namespace sat {
             ++count;
         }
         while (!m_sub_todo.empty() && count < 20);
+        if (!learned && bva_enabled())
+            bva();
+        if (s.inconsistent())
+            return;
         bool vars_eliminated = m_num_elim_vars > m_old_num_elim_vars;
 
         if (m_need_cleanup || vars_eliminated) {
@@ -1916,6 +1925,47 @@ namespace sat {
         }
     }
 
+    /**
+       \brief detect a definition x = and(b_1, ..., b_n) given by the binary
+       clauses (~x or b_i) among nxs and a clause (x or ~b_1 or ... or ~b_n)
+       among xs, where xs contains the clauses with x and nxs those with ~x.
+       The clauses of the definition are marked in xg and nxg.
+    */
+    bool simplifier::find_gate(literal x, clause_wrapper_vector const & xs, clause_wrapper_vector const & nxs, svector<bool> & xg, svector<bool> & nxg) {
+        m_gate_bins.reset();
+        for (unsigned i = 0; i < nxs.size(); ++i) {
+            clause_wrapper const& c = nxs[i];
+            if (c.is_binary())
+                m_gate_bins.insert((c[0] == ~x ? c[1] : c[0]).index(), i);
+        }
+        if (m_gate_bins.empty())
+            return false;
+        for (unsigned i = 0; i < xs.size(); ++i) {
+            clause_wrapper const& c = xs[i];
+            if (c.was_removed())
+                continue;
+            bool is_gate = true;
+            for (literal l : c) 
+                if (l != x && !m_gate_bins.contains((~l).index())) {
+                    is_gate = false;
+                    break;
+                }
+            if (!is_gate)
+                continue;
+            xg.reset();
+            xg.resize(xs.size(), false);
+            nxg.reset();
+            nxg.resize(nxs.size(), false);
+            xg[i] = true;
+            for (literal l : c)
+                if (l != x)
+                    nxg[m_gate_bins[(~l).index()]] = true;
+            TRACE("sat_simplifier", tout << "gate " << x << " := " << c << "\n";);
+            return true;
+        }
+        return false;
+    }
+
     bool simplifier::try_eliminate(bool_var v) {
         if (value(v) != l_undef)
             return false;
@@ -1962,11 +2012,21 @@ namespace sat {
         collect_clauses(pos_l, m_pos_cls);
         collect_clauses(neg_l, m_neg_cls);
 
+        // resolvents of two clauses of a gate are tautologies and resolvents
+        // of two clauses outside the gate are implied by the other resolvents.
+        bool gate = m_elim_vars_gates &&
+            (find_gate(pos_l, m_pos_cls, m_neg_cls, m_pos_gate, m_neg_gate) ||
+             find_gate(neg_l, m_neg_cls, m_pos_cls, m_neg_gate, m_pos_gate));
+
         TRACE("sat_simplifier", tout << "collecting number of after_clauses\n";);
         unsigned before_clauses = num_pos + num_neg;
         unsigned after_clauses  = 0;
-        for (clause_wrapper& c1 : m_pos_cls) {
-            for (clause_wrapper& c2 : m_neg_cls) {
+        for (unsigned i = 0; i < m_pos_cls.size(); ++i) {
+            clause_wrapper& c1 = m_pos_cls[i];
+            for (unsigned j = 0; j < m_neg_cls.size(); ++j) {
+                clause_wrapper& c2 = m_neg_cls[j];
+                if (gate && m_pos_gate[i] == m_neg_gate[j])
+                    continue;
                 m_new_cls.reset();
                 if (resolve(c1, c2, pos_l, m_new_cls)) {
                     TRACE("sat_simplifier", tout << c1 << "\n" << c2 << "\n-->\n";
@@ -1993,6 +2053,8 @@ namespace sat {
 
         // eliminate variable
         ++s.m_stats.m_elim_var_res;
+        if (gate)
+            ++m_num_gate_elim;
         VERIFY(!is_external(v));
         model_converter::entry & mc_entry = s.m_mc.mk(model_converter::ELIM_VAR, v);
         save_clauses(mc_entry, m_pos_cls);
@@ -2000,10 +2062,14 @@ namespace sat {
         s.set_eliminated(v, true);
         m_elim_counter -= num_pos * num_neg + before_lits;
 
-        for (auto & c1 : m_pos_cls) {
+        for (unsigned i = 0; i < m_pos_cls.size(); ++i) {
+            clause_wrapper& c1 = m_pos_cls[i];
             if (c1.was_removed() && !c1.contains(pos_l))
                 continue;
-            for (auto & c2 : m_neg_cls) {
+            for (unsigned j = 0; j < m_neg_cls.size(); ++j) {
+                clause_wrapper& c2 = m_neg_cls[j];
+                if (gate && m_pos_gate[i] == m_neg_gate[j])
+                    continue;
                 m_new_cls.reset();
                 if (!resolve(c1, c2, pos_l, m_new_cls))
                     continue;                
@@ -2078,12 +2144,179 @@ namespace sat {
         }
     };
 
+    /**
+       \brief Collect the irredundant clauses and binary clauses containing l.
+       Unlike collect_clauses, the use list is not compressed, so
+       threads can collect clauses concurrently.
+    */
+    void simplifier::collect_irredundant(literal l, clause_wrapper_vector & r) const {
+        m_use_list.get(l).for_each([&](clause& c) {
+            if (!c.is_learned())
+                r.push_back(clause_wrapper(c));
+        });
+        for (auto & w : get_wlist(~l))
+            if (w.is_binary_non_learned_clause())
+                r.push_back(clause_wrapper(l, w.get_literal()));
+    }
+
+    /**
+       \brief check the limits of try_eliminate without modifying the
+       simplifier. It is called concurrently for variables that share no
+       clauses, visited is owned by the calling thread.
+    */
+    bool simplifier::can_eliminate(bool_var v, clause_wrapper_vector & pos, clause_wrapper_vector & neg, bool_vector & visited) const {
+        if (value(v) != l_undef)
+            return false;
+        literal pos_l(v, false);
+        literal neg_l(v, true);
+        pos.reset();
+        neg.reset();
+        collect_irredundant(pos_l, pos);
+        collect_irredundant(neg_l, neg);
+        unsigned num_pos = pos.size();
+        unsigned num_neg = neg.size();
+        if (num_pos >= m_res_occ_cutoff && num_neg >= m_res_occ_cutoff)
+            return false;
+
+        unsigned before_lits = 0;
+        for (auto const& c : pos)
+            before_lits += c.size();
+        for (auto const& c : neg)
+            before_lits += c.size();
+        unsigned num_cls = s.m_clauses.size();
+        if (num_pos >= m_res_occ_cutoff3 && num_neg >= m_res_occ_cutoff3 && before_lits > m_res_lit_cutoff3 && num_cls > m_res_cls_cutoff2)
+            return false;
+        if (num_pos >= m_res_occ_cutoff2 && num_neg >= m_res_occ_cutoff2 && before_lits > m_res_lit_cutoff2 &&
+            num_cls > m_res_cls_cutoff1 && num_cls <= m_res_cls_cutoff2)
+            return false;
+        if (num_pos >= m_res_occ_cutoff1 && num_neg >= m_res_occ_cutoff1 && before_lits > m_res_lit_cutoff1 &&
+            num_cls <= m_res_cls_cutoff1)
+            return false;
+
+        unsigned before_clauses = num_pos + num_neg;
+        unsigned after_clauses = 0;
+        for (auto const& c1 : pos) {
+            for (literal l : c1)
+                visited[l.index()] = true;
+            for (auto const& c2 : neg) {
+                bool tautology = false;
+                for (literal l : c2)
+                    if (l != neg_l && visited[(~l).index()]) {
+                        tautology = true;
+                        break;
+                    }
+                if (!tautology && ++after_clauses > before_clauses)
+                    break;
+            }
+            for (literal l : c1)
+                visited[l.index()] = false;
+            if (after_clauses > before_clauses)
+                return false;
+        }
+        return true;
+    }
+
+    void simplifier::mark_neighbors(bool_var v, bool_vector & marked, bool_var_vector & marked_vars) const {
+        auto mark = [&](literal l) {
+            if (!marked[l.var()]) {
+                marked[l.var()] = true;
+                marked_vars.push_back(l.var());
+            }
+        };
+        for (literal l : { literal(v, false), literal(v, true) }) {
+            mark(l);
+            m_use_list.get(l).for_each([&](clause& c) {
+                for (literal lit : c)
+                    mark(lit);
+            });
+            for (auto & w : get_wlist(~l))
+                if (w.is_binary_clause())
+                    mark(w.get_literal());
+        }
+    }
+
+    /**
+       Eliminate vars in rounds. A round takes the candidates, in the order
+       of their cost, that share no clause with a candidate taken before;
+       the others are deferred to the next round. Eliminating a variable
+       only changes the clauses of its neighbors, so the candidates of a
+       round are checked in parallel against the limits of try_eliminate.
+       The accepted candidates are then eliminated by try_eliminate in
+       order, which checks the limits again.
+    */
+    void simplifier::elim_vars_parallel(bool_var_vector & vars, sat::elim_vars & elim_bdd) {
+#ifdef SINGLE_THREAD
+        unsigned num_threads = 1;
+#else
+        unsigned num_threads = m_elim_vars_threads;
+#endif
+        vector<clause_wrapper_vector> pos(num_threads), neg(num_threads);
+        vector<bool_vector> visited(num_threads);
+        for (auto& vis : visited)
+            vis.resize(2 * s.num_vars(), false);
+        bool_vector marked(s.num_vars(), false), accepted;
+        bool_var_vector marked_vars, batch, deferred;
+        while (!vars.empty() && m_elim_counter >= 0) {
+            batch.reset();
+            deferred.reset();
+            for (bool_var v : vars) {
+                if (is_external(v))
+                    continue;
+                if (marked[v])
+                    deferred.push_back(v);
+                else {
+                    batch.push_back(v);
+                    mark_neighbors(v, marked, marked_vars);
+                }
+            }
+            for (bool_var w : marked_vars)
+                marked[w] = false;
+            marked_vars.reset();
+
+            accepted.reset();
+            accepted.resize(batch.size(), false);
+            auto eval = [&](unsigned k) {
+                for (unsigned i = k; i < batch.size(); i += num_threads) {
+                    try {
+                        accepted[i] = can_eliminate(batch[i], pos[k], neg[k], visited[k]);
+                    }
+                    catch (z3_exception&) {
+                        // out of memory, leave the candidate to try_eliminate
+                        accepted[i] = true;
+                        for (auto& vis : visited[k])
+                            vis = false;
+                    }
+                }
+            };
+#ifdef SINGLE_THREAD
+            eval(0);
+#else
+            thread_pool::run(num_threads, eval);
+#endif
+            for (unsigned i = 0; i < batch.size(); ++i) {
+                checkpoint();
+                if (m_elim_counter < 0)
+                    return;
+                bool_var v = batch[i];
+                if (accepted[i] && try_eliminate(v))
+                    m_num_elim_vars++;
+                else if (elim_vars_bdd_enabled() && elim_bdd(v))
+                    m_num_elim_vars++;
+            }
+            vars.swap(deferred);
+        }
+    }
+
     void simplifier::elim_vars() {
         if (!elim_vars_enabled()) return;
         elim_var_report rpt(*this);
         bool_var_vector vars;
         order_vars_for_elim(vars);
         sat::elim_vars elim_bdd(*this);
+        if (m_elim_vars_threads > 1 && !m_elim_vars_gates) {
+            elim_vars_parallel(vars, elim_bdd);
+            vars.reset();
+        }
         for (bool_var v : vars) {
             checkpoint();
             if (m_elim_counter < 0) 
@@ -2104,6 +2337,199 @@ namespace sat {
         m_new_cls.finalize();
     }
 
+    /**
+       Bounded variable addition (Manthey, Heule and Biere, 2012).
+
+       Given a literal l, find literals l_1 = l, l_2, ..., l_k and clauses
+       C_1, ..., C_m such that every clause (l_i or C_j) is in the formula.
+       The k * m clauses are replaced by the k + m clauses (~x or l_i) and
+       (x or C_j) over a fresh variable x. Resolving on x gives back the
+       replaced clauses, and every model of the original clauses extends to
+       x, so no model conversion is needed.
+    */
+    void simplifier::bva_mark(clause_wrapper const & c, literal l, bool flag) {
+        for (literal a : c)
+            if (a != l)
+                m_visited[a.index()] = flag;
+    }
+
+    /**
+       \brief find the clause (C \ {l}) u {l2} among occs, the clauses that
+       contain the marked literals of c.
+    */
+    bool simplifier::bva_find(clause_wrapper const & c, literal l, literal l2, clause_wrapper_vector & occs, unsigned & idx) {
+        for (idx = 0; idx < occs.size(); ++idx) {
+            clause_wrapper const & d = occs[idx];
+            if (d.size() != c.size() || d.was_removed() || !d.contains(l2))
+                continue;
+            bool found = true;
+            for (literal b : d)
+                if (b != l2 && !is_marked(b)) {
+                    found = false;
+                    break;
+                }
+            if (found)
+                return true;
+        }
+        return false;
+    }
+
+    void simplifier::remove_bin_clause(literal l1, literal l2) {
+        erase_binary_watch(get_wlist(~l1), l2);
+        erase_binary_watch(get_wlist(~l2), l1);
+        m_sub_bin_todo.erase(bin_clause(l1, l2, false));
+        m_sub_bin_todo.erase(bin_clause(l2, l1, false));
+    }
+
+    bool simplifier::bva(literal l) {
+        m_bva_cls.reset();
+        collect_clauses(l, m_bva_cls);
+        if (m_bva_cls.size() < 3)
+            return false;
+        auto reduction = [](int k, int m) { return k * m - k - m; };
+        m_bva_lits.reset();
+        m_bva_lits.push_back(l);
+        clause_wrapper_vector matched;
+        svector<std::pair<unsigned, literal>> pairs;
+        literal_vector touched, seen;
+        while (true) {
+            pairs.reset();
+            for (unsigned i = 0; i < m_bva_cls.size() && m_bva_counter > 0; ++i) {
+                clause_wrapper const & c = m_bva_cls[i];
+                literal lmin = null_literal;
+                unsigned min_occs = UINT_MAX;
+                for (literal a : c) {
+                    if (a == l)
+                        continue;
+                    unsigned n = num_occs(a);
+                    if (n < min_occs)
+                        min_occs = n, lmin = a;
+                }
+                if (lmin == null_literal)
+                    continue;
+                bva_mark(c, l, true);
+                m_bva_occs.reset();
+                collect_clauses(lmin, m_bva_occs);
+                seen.reset();
+                for (clause_wrapper const & d : m_bva_occs) {
+                    m_bva_counter -= d.size();
+                    if (d.size() != c.size() || d.was_removed())
+                        continue;
+                    literal lp = null_literal;
+                    unsigned num_unmarked = 0;
+                    for (literal b : d)
+                        if (!is_marked(b))
+                            lp = b, ++num_unmarked;
+                    if (num_unmarked != 1 || lp.var() == l.var() || m_bva_lits.contains(lp) || seen.contains(lp))
+                        continue;
+                    seen.push_back(lp);
+                    pairs.push_back(std::make_pair(i, lp));
+                    if (m_bva_count[lp.index()]++ == 0)
+                        touched.push_back(lp);
+                }
+                bva_mark(c, l, false);
+            }
+            literal lmax = null_literal;
+            for (literal lp : touched) {
+                if (lmax == null_literal || m_bva_count[lp.index()] > m_bva_count[lmax.index()])
+                    lmax = lp;
+            }
+            unsigned num_lmax = lmax == null_literal ? 0 : m_bva_count[lmax.index()];
+            for (literal lp : touched)
+                m_bva_count[lp.index()] = 0;
+            touched.reset();
+            if (num_lmax == 0 ||
+                reduction(m_bva_lits.size() + 1, num_lmax) <= reduction(m_bva_lits.size(), m_bva_cls.size()))
+                break;
+            m_bva_lits.push_back(lmax);
+            matched.reset();
+            for (auto const& p : pairs)
+                if (p.second == lmax)
+                    matched.push_back(m_bva_cls[p.first]);
+            m_bva_cls.reset();
+            m_bva_cls.append(matched);
+        }
+        if (m_bva_lits.size() < 2 || reduction(m_bva_lits.size(), m_bva_cls.size()) <= 0)
+            return false;
+
+        bool_var x = s.mk_var(false, true);
+        m_use_list.reserve(s.num_vars());
+        if (m_visited.size() <= 2 * x + 1)
+            m_visited.resize(2 * s.num_vars(), false);
+        if (m_bva_count.size() <= 2 * x + 1)
+            m_bva_count.resize(2 * s.num_vars(), 0);
+        TRACE("sat_simplifier", tout << "bva " << x << " lits: " << m_bva_lits << "\n";
+              for (auto const& c : m_bva_cls) tout << c << "\n";);
+        ++m_num_bva;
+        for (clause_wrapper const & c : m_bva_cls) {
+            m_new_cls.reset();
+            m_new_cls.push_back(literal(x, false));
+            for (literal a : c)
+                if (a != l)
+                    m_new_cls.push_back(a);
+            bva_mark(c, l, true);
+            for (literal li : m_bva_lits) {
+                unsigned idx = 0;
+                m_bva_occs.reset();
+                collect_clauses(li, m_bva_occs);
+                if (!bva_find(c, l, li, m_bva_occs, idx))
+                    continue;
+                clause_wrapper const & d = m_bva_occs[idx];
+                if (d.is_binary())
+                    remove_bin_clause(d[0], d[1]);
+                else
+                    remove_clause(*d.get_clause(), true);
+            }
+            bva_mark(c, l, false);
+            if (m_new_cls.size() == 2) {
+                s.m_stats.m_mk_bin_clause++;
+                add_non_learned_binary_clause(m_new_cls[0], m_new_cls[1]);
+            }
+            else {
+                clause * new_c = s.alloc_clause(m_new_cls.size(), m_new_cls.data(), false);
+                s.m_clauses.push_back(new_c);
+                m_use_list.insert(*new_c);
+            }
+        }
+        for (literal li : m_bva_lits) {
+            s.m_stats.m_mk_bin_clause++;
+            add_non_learned_binary_clause(literal(x, true), li);
+        }
+        m_need_cleanup = true;
+        return true;
+    }
+
+    void simplifier::bva() {
+        m_bva_counter = m_bva_limit;
+        m_bva_count.reset();
+        m_bva_count.resize(2 * s.num_vars(), 0);
+        unsigned num_vars = s.num_vars();
+        svector<std::pair<unsigned, literal>> todo;
+        for (bool_var v = 0; v < num_vars; ++v) {
+            if (was_eliminated(v) || value(v) != l_undef)
+                continue;
+            for (literal l : { literal(v, false), literal(v, true) }) {
+                unsigned n = num_occs(l);
+                if (n >= 3)
+                    todo.push_back(std::make_pair(n, l));
+            }
+        }
+        std::stable_sort(todo.begin(), todo.end(), [](auto const& a, auto const& b) { return a.first > b.first; });
+        unsigned num_bva = m_num_bva;
+        for (auto const& p : todo) {
+            checkpoint();
+            if (m_bva_counter <= 0 || s.inconsistent())
+                break;
+            literal l = p.second;
+            while (m_bva_counter > 0 && !was_eliminated(l.var()) && value(l) == l_undef && bva(l))
+                ;
+        }
+        m_bva_cls.finalize();
+        m_bva_occs.finalize();
+        m_bva_count.finalize();
+        IF_VERBOSE(SAT_VB_LVL, verbose_stream() << " (sat-bva :vars " << (m_num_bva - num_bva) << ")\n";);
+    }
+
     void simplifier::updt_params(params_ref const & _p) {
         sat_simplifier_params p(_p);
         m_cce                     = p.cce();
@@ -2131,6 +2557,10 @@ namespace sat {
         m_elim_vars               = p.elim_vars();
         m_elim_vars_bdd           = false && p.elim_vars_bdd(); // buggy?
         m_elim_vars_bdd_delay     = p.elim_vars_bdd_delay();
+        m_elim_vars_gates         = p.elim_vars_gates();
+        m_elim_vars_threads       = p.elim_vars_threads();
+        m_bva                     = p.bva();
+        m_bva_limit               = p.bva_limit();
         m_incremental_mode        = s.get_config().m_incremental && !p.override_incremental();
     }
 
@@ -2148,6 +2578,8 @@ namespace sat {
         st.update("sat abce", m_num_abce);
         st.update("sat bca",  m_num_bca);
         st.update("sat ate",  m_num_ate);
+        st.update("sat gate elim", m_num_gate_elim);
+        st.update("sat bva vars", m_num_bva);
     }
 
     void simplifier::reset_statistics() {
@@ -2161,5 +2593,7 @@ namespace sat {
         m_num_elim_vars = 0;
         m_num_bca = 0;
         m_num_ate = 0;
+        m_num_gate_elim = 0;
+        m_num_bva = 0;
     }
 };
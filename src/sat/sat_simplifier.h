@@ -28,6 +28,7 @@ Revision History:
 #include "sat/sat_watched.h"
 #include "sat/sat_model_converter.h"
 #include "util/heap.h"
+#include "util/map.h"
 #include "util/statistics.h"
 #include "util/params.h"
 
@@ -37,6 +38,7 @@ namespace pb {
 
 namespace sat {
     class solver;
+    class elim_vars;
 
     class use_list {
         vector<clause_use_list> m_use_list;
@@ -105,6 +107,10 @@ namespace sat {
         bool                   m_elim_vars;
         bool                   m_elim_vars_bdd;
         unsigned               m_elim_vars_bdd_delay;
+        bool                   m_elim_vars_gates;
+        unsigned               m_elim_vars_threads;
+        bool                   m_bva;
+        unsigned               m_bva_limit;
 
         // stats
         unsigned               m_num_bce;
@@ -117,6 +123,8 @@ namespace sat {
         unsigned               m_num_elim_vars;
         unsigned               m_num_sub_res;
         unsigned               m_num_elim_lits;
+        unsigned               m_num_gate_elim;
+        unsigned               m_num_bva;
 
         bool                   m_learned_in_use_lists;
         unsigned               m_old_num_elim_vars;
@@ -190,6 +198,7 @@ namespace sat {
         bool bca_enabled()  const;
         bool elim_vars_bdd_enabled() const;
         bool elim_vars_enabled() const;
+        bool bva_enabled() const;
 
         unsigned num_nonlearned_bin(literal l) const;
         unsigned get_to_elim_cost(bool_var v) const;
@@ -203,9 +212,29 @@ namespace sat {
         void add_non_learned_binary_clause(literal l1, literal l2);
         void remove_bin_clauses(literal l);
         void remove_clauses(clause_use_list const & cs, literal l);
+        svector<bool>  m_pos_gate;
+        svector<bool>  m_neg_gate;
+        u_map<unsigned> m_gate_bins;
+        bool find_gate(literal x, clause_wrapper_vector const & xs, clause_wrapper_vector const & nxs, svector<bool> & xg, svector<bool> & nxg);
         bool try_eliminate(bool_var v);
+        void collect_irredundant(literal l, clause_wrapper_vector & r) const;
+        bool can_eliminate(bool_var v, clause_wrapper_vector & pos, clause_wrapper_vector & neg, bool_vector & visited) const;
+        void mark_neighbors(bool_var v, bool_vector & marked, bool_var_vector & marked_vars) const;
+        void elim_vars_parallel(bool_var_vector & vars, sat::elim_vars & elim_bdd);
         void elim_vars();
 
+        int            m_bva_counter;
+        clause_wrapper_vector m_bva_cls;
+        clause_wrapper_vector m_bva_occs;
+        unsigned_vector m_bva_count;
+        literal_vector m_bva_lits;
+        unsigned num_occs(literal l) const { return m_use_list.get(l).num_irredundant() + num_nonlearned_bin(l); }
+        void bva_mark(clause_wrapper const & c, literal l, bool flag);
+        bool bva_find(clause_wrapper const & c, literal l, literal l2, clause_wrapper_vector & occs, unsigned & idx);
+        void remove_bin_clause(literal l1, literal l2);
+        bool bva(literal l);
+        void bva();
+
         struct blocked_cls_report;
         struct subsumption_report;
         struct elim_var_report;
@@ -26,10 +26,13 @@ Revision History:
 #include "util/trace.h"
 #include "util/max_cliques.h"
 #include "util/gparams.h"
+#include "util/numa.h"
+#include "util/thread_pool.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_integrity_checker.h"
 #include "sat/sat_lookahead.h"
 #include "sat/sat_ddfw.h"
+#include "sat/sat_symmetry.h"
 #include "sat/sat_prob.h"
 #include "sat/sat_anf_simplifier.h"
 #include "sat/sat_cut_simplifier.h"
@@ -38,6 +41,17 @@ Revision History:
 #endif
 
 
+#if defined(__GNUC__) || defined(__clang__)
+#define SAT_PREFETCH(p) __builtin_prefetch((const char*)(p))
+#elif !defined(_M_ARM) && !defined(_M_ARM64)
+#define SAT_PREFETCH(p) _mm_prefetch((const char*)(p), _MM_HINT_T1)
+#else
+#define SAT_PREFETCH(p) ((void)0)
+#endif
+
+// number of watches between the watch being processed and the clause that is prefetched.
+#define SAT_PREFETCH_DISTANCE 4u
+
 namespace sat {
 
 
@@ -75,6 +89,7 @@ namespace sat {
         init_reason_unknown();
         updt_params(p);
         m_best_phase_size         = 0;
+        m_target_phase_size       = 0;
         m_conflicts_since_gc      = 0;
         m_conflicts_since_init    = 0;
         m_next_simplify           = 0;
@@ -132,6 +147,7 @@ namespace sat {
         m_mark.reset();
         m_lit_mark.reset();
         m_best_phase.reset();
+        m_target_phase.reset();
         m_phase.reset();
         m_prev_phase.reset();
         m_assigned_since_gc.reset();
@@ -162,6 +178,7 @@ namespace sat {
             }
             m_phase[v] = src.m_phase[v];
             m_best_phase[v] = src.m_best_phase[v];
+            m_target_phase[v] = src.m_target_phase[v];
             m_prev_phase[v] = src.m_prev_phase[v];
 
             // inherit activity:
@@ -267,6 +284,7 @@ namespace sat {
         m_lit_mark[2*v+1] = false;
         m_phase[v] = false;
         m_best_phase[v] = false;
+        m_target_phase[v] = false;
         m_prev_phase[v] = false;
         m_assigned_since_gc[v] = false;
         m_last_conflict[v] = 0;        
@@ -308,6 +326,7 @@ namespace sat {
         m_lit_mark.push_back(false);
         m_phase.push_back(false);
         m_best_phase.push_back(false);
+        m_target_phase.push_back(false);
         m_prev_phase.push_back(false);
         m_assigned_since_gc.push_back(false);
         m_last_conflict.push_back(0);
@@ -656,14 +675,19 @@ namespace sat {
 
     bool solver::should_defrag() {
         if (m_defrag_threshold > 0) --m_defrag_threshold;
-        return m_defrag_threshold == 0 && m_config.m_gc_defrag;
+        if (!m_config.m_gc_defrag)
+            return false;
+        // compact also when more than half of the clause arena is free space.
+        clause_allocator const& ca = cls_allocator();
+        return m_defrag_threshold == 0 || ca.get_reserved_size() > 2 * ca.get_allocation_size();
     }
 
     void solver::defrag_clauses() {
         m_defrag_threshold = 2;
         if (memory_pressure()) return;
         pop(scope_lvl());
-        IF_VERBOSE(2, verbose_stream() << "(sat-defrag)\n");
+        ++m_stats.m_defrag;
+        size_t reserved = cls_allocator().get_reserved_size();
         clause_allocator& alloc = m_cls_allocator[!m_cls_allocator_idx];
         ptr_vector<clause> new_clauses, new_learned;
         for (clause* c : m_clauses) c->unmark_used();
@@ -722,6 +746,8 @@ namespace sat {
 
         cls_allocator().finalize();
         m_cls_allocator_idx = !m_cls_allocator_idx;
+        IF_VERBOSE(2, verbose_stream() << "(sat-defrag :reserved " << reserved << " :live " << cls_allocator().get_allocation_size()
+                   << " :compacted " << cls_allocator().get_reserved_size() << ")\n");
 
         reinit_assumptions();
     }
@@ -919,15 +945,8 @@ namespace sat {
             }
         }
         
-        if (m_config.m_propagate_prefetch) {
-#if defined(__GNUC__) || defined(__clang__)
-            __builtin_prefetch((const char*)((m_watches[l.index()].data())));
-#else
-    #if !defined(_M_ARM) && !defined(_M_ARM64)
-            _mm_prefetch((const char*)((m_watches[l.index()].data())), _MM_HINT_T1);
-    #endif
-#endif
-        }
+        if (m_config.m_propagate_prefetch) 
+            SAT_PREFETCH(m_watches[l.index()].data());
 
         SASSERT(!l.sign() || !m_phase[v]);
         SASSERT(l.sign()  || m_phase[v]);
@@ -1024,12 +1043,20 @@ namespace sat {
         watch_list::iterator it = wlist.begin();
         watch_list::iterator it2 = it;
         watch_list::iterator end = wlist.end();
+        // clause watches are visited in order, so the clause header of a watch 
+        // a few positions ahead is requested while the current one is processed.
+        watch_list::iterator it_pf = m_config.m_propagate_prefetch ? it + std::min(SAT_PREFETCH_DISTANCE, wlist.size()) : end;
 #define CONFLICT_CLEANUP() {                    \
                 for (; it != end; ++it, ++it2)  \
                     *it2 = *it;                 \
                 wlist.set_end(it2);             \
             }
         for (; it != end; ++it) {
+            if (it_pf < end) {
+                if (it_pf->is_clause() && value(it_pf->get_blocked_literal()) != l_true)
+                    SAT_PREFETCH(&get_clause(it_pf->get_clause_offset()));
+                ++it_pf;
+            }
             switch (it->get_kind()) {
             case watched::BINARY:
                 l1 = it->get_literal();
@@ -1246,6 +1273,7 @@ namespace sat {
             return check_par(num_lits, lits);
         }
         flet<bool> _searching(m_searching, true);
+        m_stats_callback.start();
         m_clone = nullptr;
         if (m_mc.empty() && gparams::get_ref().get_bool("model_validate", false)) {
             
@@ -1262,6 +1290,11 @@ namespace sat {
             propagate(false);
             if (check_inconsistent()) return l_false;
             if (m_config.m_force_cleanup) do_cleanup(true);
+            if (should_break_symmetries(num_lits)) {
+                break_symmetries();
+                propagate(false);
+                if (check_inconsistent()) return l_false;
+            }
             TRACE("sat", display(tout););
             TRACE("before_search", display(tout););
 
@@ -1305,6 +1338,18 @@ namespace sat {
         }
     }
 
+    bool solver::should_break_symmetries(unsigned num_lits) const {
+        return m_config.m_symmetry && !m_symmetries_broken && num_lits == 0 &&
+            m_user_scope_literals.empty() && !m_ext && !m_config.m_drat;
+    }
+
+    void solver::break_symmetries() {
+        m_symmetries_broken = true;
+        symmetry sym(*this);
+        m_stats.m_symmetry_generators += sym();
+        m_stats.m_symmetry_clauses += sym.num_clauses_added();
+    }
+
     bool solver::should_cancel() {
         if (limit_reached() || memory_exceeded()) {
             return true;
@@ -1496,13 +1541,17 @@ namespace sat {
             return l_undef;
         }
 
-        vector<std::thread> threads(num_threads);
-        for (int i = 0; i < num_threads; ++i) {
-            threads[i] = std::thread([&, i]() { worker_thread(i); });
-        }
-        for (auto & th : threads) {
-            th.join();
-        }
+        bool affinity = numa::affinity_enabled(m_params);
+        numa::scoped_stats numa_stats(affinity);
+        // the main solver runs on the calling thread and goes first when
+        // the thread pool has no thread left for the other workers.
+        thread_pool::run(num_threads, [&](unsigned k) {
+            int i = static_cast<int>((k + main_solver_offset) % num_threads);
+            numa::scoped_bind _bind(affinity, i);
+            worker_thread(i);
+        });
+        par.collect_statistics(m_aux_stats);
+        numa_stats.collect_statistics(m_aux_stats);
         
         if (IS_AUX_SOLVER(finished_id)) {
             m_stats = par.get_solver(finished_id).m_stats;
@@ -1625,6 +1674,8 @@ namespace sat {
             case PS_SAT_CACHING:
                 if (m_search_state == s_unsat)
                     return m_phase[next];
+                if (m_config.m_phase_target)
+                    return m_target_phase[next];
                 return m_best_phase[next];
             case PS_RANDOM:
                 return (m_rand() % 2) == 0;
@@ -1681,10 +1732,12 @@ namespace sat {
     lbool solver::basic_search() {
         lbool is_sat = l_undef;
         while (is_sat == l_undef && !should_cancel()) {
+            if (m_stats_callback.due()) push_stats();
             if (inconsistent()) is_sat = resolve_conflict_core();
             else if (should_propagate()) propagate(true);
             else if (do_cleanup(false)) continue;
             else if (should_gc()) do_gc();
+            else if (should_reduce_memory()) reduce_memory();
             else if (should_rephase()) do_rephase();
             else if (should_restart()) { if (!m_restart_enabled) return l_undef; do_restart(!m_config.m_restart_fast); }
             else if (should_simplify()) do_simplify();
@@ -1693,6 +1746,12 @@ namespace sat {
         return is_sat;
     }
 
+    void solver::push_stats() {
+        statistics st;
+        collect_statistics(st);
+        m_stats_callback.report(st, m_stats.m_conflict);
+    }
+
     lbool solver::search() {
         if (!m_ext || !m_ext->tracking_assumptions())
             return basic_search();
@@ -1883,8 +1942,10 @@ namespace sat {
         m_search_sat_conflicts    = m_config.m_search_sat_conflicts;
         m_search_next_toggle      = m_search_unsat_conflicts;
         m_best_phase_size         = 0;
+        m_target_phase_size       = 0;
         m_rephase_lim             = 0;
         m_rephase_inc             = 0;
+        m_rephase_count           = 0;
         m_reorder_lim             = m_config.m_reorder_base;
         m_reorder_inc             = 0;
         m_conflicts_since_restart = 0;
@@ -1983,6 +2044,12 @@ namespace sat {
         CASSERT("sat_simplify_bug", check_invariant());
         m_asymm_branch(false);
 
+        if (m_config.m_vivify && !inconsistent()) {
+            m_asymm_branch.vivify(m_config.m_gc_tier2_glue, m_config.m_vivify_budget);
+            CASSERT("sat_missed_prop", check_missed_propagation());
+            CASSERT("sat_simplify_bug", check_invariant());
+        }
+
         if (m_config.m_lookahead_simplify && !m_ext) {
             lookahead lh(*this);
             lh.simplify(true);
@@ -2064,6 +2131,7 @@ namespace sat {
                 m_model[v] = value(v);
                 m_phase[v] = value(v) == l_true;
                 m_best_phase[v] = value(v) == l_true;
+                m_target_phase[v] = value(v) == l_true;
             }
         }
         TRACE("sat_mc_bug", m_mc.display(tout););
@@ -2268,6 +2336,27 @@ namespace sat {
         TRACE("sat", tout << "restart " << restart_level(to_base) << "\n";);
         pop_reinit(restart_level(to_base));
         set_next_restart();        
+        if (m_phase_oracle)
+            exchange_phases();
+    }
+
+    /**
+       \brief publish the current phases to the phase oracle and adopt the
+       assignment of the local search, if it found a new one.
+     */
+    void solver::exchange_phases() {
+        bool_var_vector const& vars = m_phase_oracle->vars();
+        bool_vector phases;
+        for (bool_var v : vars)
+            phases.push_back(v < num_vars() && m_phase[v]);
+        m_phase_oracle->set_phases(phases);
+        if (!m_phase_oracle->get_hints(phases))
+            return;
+        for (unsigned i = 0; i < vars.size() && i < phases.size(); ++i) {
+            bool_var v = vars[i];
+            if (v < num_vars() && !was_eliminated(v))
+                m_target_phase[v] = m_best_phase[v] = m_phase[v] = phases[i];
+        }
     }
 
     unsigned solver::restart_level(bool to_base) {
@@ -2438,6 +2527,8 @@ namespace sat {
             case justification::CLAUSE: {
                 clause & c = get_clause(js);
                 unsigned i = 0;
+                if (c.is_learned())
+                    c.mark_used();
                 if (consequent != null_literal) {
                     SASSERT(c[0] == consequent || c[1] == consequent);
                     if (c[0] == consequent) {
@@ -2840,6 +2931,13 @@ namespace sat {
             TRACE("forget_phase", tout << "forgetting phase of v" << v << "\n";);
             m_phase[v] = m_rand() % 2 == 0;
         }
+        if (m_config.m_phase_target && is_sat_phase() && head > m_target_phase_size) {
+            m_target_phase_size = head;
+            for (unsigned i = 0; i < head; ++i) {
+                bool_var v = m_trail[i].var();
+                m_target_phase[v] = m_phase[v];
+            }
+        }
         if (is_sat_phase() && head >= m_best_phase_size) {
             m_best_phase_size = head;
             IF_VERBOSE(12, verbose_stream() << "sticky trail: " << head << "\n");
@@ -2863,6 +2961,7 @@ namespace sat {
 
         if (is_two_phase()) {
             m_best_phase_size = 0;
+            m_target_phase_size = 0;
             std::swap(m_fast_glue_backup, m_fast_glue_avg);
             std::swap(m_slow_glue_backup, m_slow_glue_avg);
             if (m_search_state == s_sat) {
@@ -2915,7 +3014,9 @@ namespace sat {
             }
             break;
         case PS_SAT_CACHING:
-            if (m_search_state == s_sat) 
+            if (m_config.m_phase_target)
+                do_rephase_target();
+            else if (m_search_state == s_sat) 
                 for (unsigned i = 0; i < m_phase.size(); ++i) 
                     m_phase[i] = m_best_phase[i];                            
             break;
@@ -2930,6 +3031,63 @@ namespace sat {
         m_rephase_lim += m_rephase_inc;
     }
 
+    /**
+       \brief rephase schedule with target phases: the phases are reset to
+       the best phases, to the phases found by a local search walk, to the
+       original and to the inverted phases. The target phases restart from
+       the new phases.
+    */
+    void solver::do_rephase_target() {
+        static char const schedule[] = "bwobwi";
+        char kind = schedule[m_rephase_count++ % 6];
+        if (kind == 'w' && m_config.m_rephase_walk == 0)
+            kind = 'b';
+        switch (kind) {
+        case 'b':
+            for (unsigned i = 0; i < m_phase.size(); ++i) 
+                m_phase[i] = m_best_phase[i];
+            break;
+        case 'w':
+            do_rephase_walk();
+            break;
+        case 'o':
+            for (auto& p : m_phase) p = false;
+            break;
+        default:
+            for (auto& p : m_phase) p = true;
+            break;
+        }
+        IF_VERBOSE(12, verbose_stream() << "(sat.rephase " << kind << ")\n");
+        m_target_phase_size = 0;
+        for (unsigned i = 0; i < m_phase.size(); ++i) 
+            m_target_phase[i] = m_phase[i];
+    }
+
+    /**
+       \brief run ddfw from the current phases for m_rephase_walk flips and
+       use the assignment with the fewest unsatisfied clauses as phases.
+    */
+    void solver::do_rephase_walk() {
+        if (inconsistent())
+            return;
+        ddfw ls;
+        ls.add(*this);
+        ls.updt_params(m_params);
+        ls.set_seed(m_rand());
+        ls.set_initial_phases(m_phase);
+        {
+            scoped_limits scoped_rl(rlimit());
+            scoped_rl.push_child(&ls.rlimit());
+            ls.rlimit().push(m_config.m_rephase_walk);
+            ls.check(0, nullptr, nullptr);
+            ls.rlimit().pop();
+        }
+        m_stats.m_rephase_walk++;
+        for (bool_var v = 0; v < num_vars(); ++v) 
+            if (!was_eliminated(v) && ls.has_best_value(v)) 
+                m_phase[v] = ls.get_best_value(v);
+    }
+
     bool solver::should_reorder() {
         return m_conflicts_since_init > m_reorder_lim;
     }
@@ -3511,6 +3669,7 @@ namespace sat {
         m_lit_mark.shrink(2*v);
         m_phase.shrink(v);
         m_best_phase.shrink(v);
+        m_target_phase.shrink(v);
         m_prev_phase.shrink(v);
         m_assigned_since_gc.shrink(v);
         m_simplifier.reset_todos();
@@ -4140,37 +4299,65 @@ namespace sat {
     }
 
     // Algorithm 7: Corebased Algorithm with Chunking
-
-    static void back_remove(sat::literal_vector& lits, sat::literal l) {
-        for (unsigned i = lits.size(); i > 0; ) {
-            --i;
+    //
+    // The negations of a chunk of candidates are assumed together. A model
+    // refutes every candidate it falsifies. Otherwise the candidates in the
+    // core are set aside, and if the core contains a single candidate, that
+    // candidate is a backbone that depends on the assumptions of the core.
+    // Candidates that were only set aside together are tested one by one.
+
+    static void remove_literal(sat::literal_vector& lits, sat::literal l) {
+        for (unsigned i = lits.size(); i-- > 0; ) {
             if (lits[i] == l) {
                 lits[i] = lits.back();
                 lits.pop_back();
                 return;
             }
         }
-        UNREACHABLE();
     }
 
-    static void brute_force_consequences(sat::solver& s, sat::literal_vector const& asms, sat::literal_vector const& gamma, vector<sat::literal_vector>& conseq) {
+    static void add_consequence(sat::solver& s, sat::literal lit, sat::literal_vector const& core, vector<sat::literal_vector>& conseq) {
+        sat::literal_vector cons;
+        cons.push_back(lit);
+        for (sat::literal c : core) 
+            if (c != ~lit) 
+                cons.push_back(c);
+        conseq.push_back(cons);
+        if (cons.size() == 1) {
+            s.pop_to_base_level();
+            s.mk_clause(1, &lit);
+        }
+    }
+
+    static lbool brute_force_consequences(sat::solver& s, sat::literal_vector const& asms, sat::literal_vector const& gamma, 
+                                          sat::literal_vector& lambda, vector<sat::literal_vector>& conseq) {
         for (literal lit : gamma) {
+            if (!lambda.contains(lit))
+                continue;
             sat::literal_vector asms1(asms);
             asms1.push_back(~lit);
             lbool r = s.check(asms1.size(), asms1.data());
+            if (r == l_undef)
+                return r;
             if (r == l_false) {
-                conseq.push_back(s.get_core());
+                add_consequence(s, lit, s.get_core(), conseq);
+                remove_literal(lambda, lit);
+            }
+            else {
+                prune_unfixed(lambda, s.get_model());
             }
         }
+        return l_true;
     }
 
     static lbool core_chunking(sat::solver& s, model const& m, sat::bool_var_vector const& vars, sat::literal_vector const& asms, vector<sat::literal_vector>& conseq, unsigned K) {
         sat::literal_vector lambda;
         for (bool_var v : vars) {
-            lambda.push_back(sat::literal(v, m[v] == l_false));
+            if (m[v] != l_undef)
+                lambda.push_back(sat::literal(v, m[v] == l_false));
         }
         while (!lambda.empty()) {
-            IF_VERBOSE(1, verbose_stream() << "(sat-backbone-core " << lambda.size() << " " << conseq.size() << ")\n";);
+            IF_VERBOSE(1, verbose_stream() << "(sat.backbone-core :candidates " << lambda.size() << " :fixed " << conseq.size() << ")\n";);
             unsigned k = std::min(K, lambda.size());
             sat::literal_vector gamma, omegaN;
             for (unsigned i = 0; i < k; ++i) {
@@ -4178,43 +4365,39 @@ namespace sat {
                 gamma.push_back(l);
                 omegaN.push_back(~l);
             }
+            bool set_aside = false;
             while (true) {
                 sat::literal_vector asms1(asms);
                 asms1.append(omegaN);
                 lbool r = s.check(asms1.size(), asms1.data());
+                if (r == l_undef) 
+                    return r;
                 if (r == l_true) {
-                    IF_VERBOSE(1, verbose_stream() << "(sat) " << omegaN << "\n";);
                     prune_unfixed(lambda, s.get_model());
                     break;
                 }
-                sat::literal_vector const& core = s.get_core();
+                sat::literal_vector core(s.get_core());
                 sat::literal_vector occurs;
-                IF_VERBOSE(1, verbose_stream() << "(core " << core.size() << ")\n";);
-                for (unsigned i = 0; i < omegaN.size(); ++i) {
-                    if (core.contains(omegaN[i])) {
-                        occurs.push_back(omegaN[i]);
-                    }
+                for (sat::literal l : omegaN) {
+                    if (core.contains(l)) 
+                        occurs.push_back(l);
                 }
+                if (occurs.empty()) 
+                    return l_false;
                 if (occurs.size() == 1) {
-                    sat::literal lit = occurs.back();
-                    sat::literal nlit = ~lit;
-                    conseq.push_back(core);
-                    back_remove(lambda, ~lit);
-                    back_remove(gamma, ~lit);
-                    s.mk_clause(1, &nlit);
+                    sat::literal lit = ~occurs.back();
+                    add_consequence(s, lit, core, conseq);
+                    remove_literal(lambda, lit);
+                    remove_literal(gamma, lit);
                 }
-                for (unsigned i = 0; i < omegaN.size(); ++i) {
-                    if (occurs.contains(omegaN[i])) {
-                        omegaN[i] = omegaN.back();
-                        omegaN.pop_back();
-                        --i;
-                    }
+                else {
+                    set_aside = true;
                 }
-                if (omegaN.empty() && occurs.size() > 1) {
-                    brute_force_consequences(s, asms, gamma, conseq);
-                    for (unsigned i = 0; i < gamma.size(); ++i) {
-                        back_remove(lambda, gamma[i]);
-                    }
+                for (sat::literal l : occurs) 
+                    remove_literal(omegaN, l);
+                if (omegaN.empty()) {
+                    if (set_aside && l_undef == brute_force_consequences(s, asms, gamma, lambda, conseq))
+                        return l_undef;
                     break;
                 }
             }
@@ -4246,8 +4429,8 @@ namespace sat {
             }
         }
 
-        if (false && asms.empty()) {
-            is_sat = core_chunking(*this, mdl, vars, asms, conseq, 100);
+        if (m_config.m_backbone_chunk_size > 0) {
+            is_sat = core_chunking(*this, mdl, vars, asms, conseq, m_config.m_backbone_chunk_size);
         }
         else {
             is_sat = get_consequences(asms, lits, conseq);
@@ -4675,6 +4858,14 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat defrag", m_defrag);
+        st.update("sat memory reductions", m_memory_reductions);
+        st.update("sat rephase walks", m_rephase_walk);
+        st.update("sat pop retained learned", m_pop_retained_learned);
+        st.update("sat pop deleted learned", m_pop_deleted_learned);
+        st.update("sat pop frozen learned", m_pop_frozen_learned);
+        st.update("sat symmetry generators", m_symmetry_generators);
+        st.update("sat symmetry clauses", m_symmetry_clauses);
     }
 
     void stats::reset() {
@@ -23,6 +23,7 @@ Revision History:
 #include "util/params.h"
 #include "util/statistics.h"
 #include "util/stopwatch.h"
+#include "util/stats_callback.h"
 #include "util/ema.h"
 #include "util/trace.h"
 #include "util/rlimit.h"
@@ -45,6 +46,7 @@ Revision History:
 #include "sat/sat_binspr.h"
 #include "sat/sat_drat.h"
 #include "sat/sat_parallel.h"
+#include "sat/sat_phase_oracle.h"
 #include "sat/sat_local_search.h"
 #include "sat/sat_solver_core.h"
 
@@ -79,6 +81,14 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_defrag;
+        unsigned m_memory_reductions;
+        unsigned m_rephase_walk;
+        unsigned m_pop_retained_learned;
+        unsigned m_pop_deleted_learned;
+        unsigned m_pop_frozen_learned;
+        unsigned m_symmetry_generators;
+        unsigned m_symmetry_clauses;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -100,6 +110,7 @@ namespace sat {
         scoped_ptr<extension>   m_ext;
         scoped_ptr<cut_simplifier> m_cut_simplifier;
         parallel*               m_par;
+        phase_oracle*           m_phase_oracle = nullptr;
         drat                    m_drat;          // DRAT for generating proofs
         clause_allocator        m_cls_allocator[2];
         bool                    m_cls_allocator_idx;
@@ -117,6 +128,7 @@ namespace sat {
         binspr                  m_binspr;
         bool                    m_inconsistent;
         bool                    m_searching;
+        bool                    m_symmetries_broken = false;
         // A conflict is usually a single justification. That is, a justification
         // for false. If m_not_l is not null_literal, then m_conflict is a
         // justification for l, and the conflict is union of m_no_l and m_conflict;
@@ -151,6 +163,7 @@ namespace sat {
         // phase
         bool_vector             m_phase; 
         bool_vector             m_best_phase;
+        bool_vector             m_target_phase;      // phases of the longest conflict free trail since the last rephase
         bool_vector             m_prev_phase;
         svector<char>           m_assigned_since_gc;
         search_state            m_search_state; 
@@ -159,8 +172,10 @@ namespace sat {
         unsigned                m_search_next_toggle;
         unsigned                m_phase_counter; 
         unsigned                m_best_phase_size;
+        unsigned                m_target_phase_size;
         unsigned                m_rephase_lim;
         unsigned                m_rephase_inc;
+        unsigned                m_rephase_count;
         unsigned                m_reorder_lim;
         unsigned                m_reorder_inc;
         var_queue               m_case_split_queue;
@@ -187,6 +202,7 @@ namespace sat {
         svector<scope>          m_scopes;
         scoped_limit_trail      m_vars_lim;
         stopwatch               m_stopwatch;
+        stats_callback          m_stats_callback;
         params_ref              m_params;
         no_drat_params          m_no_drat_params;
         scoped_ptr<solver>      m_clone; // for debugging purposes
@@ -237,6 +253,7 @@ namespace sat {
         friend class lut_finder;
         friend class npn3_finder;
         friend class proof_trim;
+        friend class symmetry;
     public:
         solver(params_ref const & p, reslimit& l);
         ~solver() override;
@@ -253,6 +270,12 @@ namespace sat {
         void collect_statistics(statistics & st) const;
         void reset_statistics();
         void display_status(std::ostream & out) const;
+
+        /**
+           \brief push the statistics to eh every interval_ms milliseconds while
+           searching. An interval of 0 removes the callback.
+        */
+        void set_stats_callback(unsigned interval_ms, stats_eh const& eh) { m_stats_callback.set(interval_ms, eh); }
         
         /**
            \brief Copy (non learned) clauses from src to this solver.
@@ -373,7 +396,7 @@ namespace sat {
         bool was_eliminated(bool_var v) const { return m_eliminated[v]; }
         void set_eliminated(bool_var v, bool f) override;
         bool was_eliminated(literal l) const { return was_eliminated(l.var()); }
-        void set_phase(literal l) override { if (l.var() < num_vars()) m_best_phase[l.var()] = m_phase[l.var()] = !l.sign(); }
+        void set_phase(literal l) override { if (l.var() < num_vars()) m_target_phase[l.var()] = m_best_phase[l.var()] = m_phase[l.var()] = !l.sign(); }
         bool get_phase(bool_var b) { return m_phase.get(b, false); }
         void move_to_front(bool_var b);
         unsigned scope_lvl() const { return m_scope_lvl; }
@@ -426,6 +449,8 @@ namespace sat {
             return memory::get_allocation_size() > m_config.m_max_memory;
         }
         
+        void push_stats();
+
         void checkpoint() {
             if (!m_checkpoint_enabled) 
                 return;
@@ -435,6 +460,7 @@ namespace sat {
                 throw solver_exception(Z3_MAX_MEMORY_MSG);                
         }
         void set_par(parallel* p, unsigned id);
+        void set_phase_oracle(phase_oracle* o) { m_phase_oracle = o; }
         bool canceled() { return !m_rlimit.inc(); }
         config const& get_config() const { return m_config; }
         void set_drat(bool d) { m_config.m_drat = d; }
@@ -518,6 +544,7 @@ namespace sat {
         bool check_clauses(model const& m) const;
         bool is_assumption(bool_var v) const;
         void set_activity(bool_var v, unsigned act);
+        unsigned get_activity(bool_var v) const { return m_activity[v]; }
 
         lbool  cube(bool_var_vector& vars, literal_vector& lits, unsigned backtrack_level);
         
@@ -571,11 +598,14 @@ namespace sat {
         void mk_model();
         bool check_model(model const & m) const;
         void do_restart(bool to_base);
+        void exchange_phases();
         svector<size_t> m_last_positions;
         unsigned m_last_position_log;
         unsigned m_restart_logs;
         unsigned restart_level(bool to_base);
         void log_stats();
+        bool should_break_symmetries(unsigned num_lits) const;
+        void break_symmetries();
         bool should_cancel();
         bool should_restart() const;
         void set_next_restart();
@@ -598,6 +628,8 @@ namespace sat {
     protected:
         bool should_gc() const;
         void do_gc();
+        bool should_reduce_memory() const;
+        void reduce_memory();
         void gc_glue();
         void gc_psm();
         void gc_glue_psm();
@@ -668,6 +700,8 @@ namespace sat {
         bool is_two_phase() const;
         bool should_rephase();
         void do_rephase();
+        void do_rephase_target();
+        void do_rephase_walk();
         bool should_reorder();
         void do_reorder();
         svector<char> m_diff_levels;
@@ -709,6 +743,7 @@ namespace sat {
         svector<bin_clause> m_user_bin_clauses;
 
         void gc_vars(bool_var max_var);
+        void retain_base_learned();
 
         // -----------------------
         //
@@ -23,6 +23,8 @@ Notes:
 #include "ast/ast_pp.h"
 #include "ast/ast_translation.h"
 #include "ast/ast_util.h"
+#include "ast/for_each_expr.h"
+#include "ast/rewriter/th_rewriter.h"
 #include "solver/solver.h"
 #include "solver/tactic2solver.h"
 #include "solver/parallel_params.hpp"
@@ -35,6 +37,7 @@ Notes:
 #include "tactic/bv/bit_blaster_tactic.h"
 #include "tactic/core/simplify_tactic.h"
 #include "tactic/bv/bit_blaster_model_converter.h"
+#include "tactic/sls/sls_engine.h"
 #include "model/model_smt2_pp.h"
 #include "model/model_v2_pp.h"
 #include "model/model_evaluator.h"
@@ -45,9 +48,108 @@ Notes:
 #include "sat/tactic/sat2goal.h"
 #include "sat/tactic/sat_tactic.h"
 #include "sat/sat_simplifier_params.hpp"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 // incremental SAT solver.
 class inc_sat_solver : public solver {
+
+    /**
+       \brief word-level local search on a copy of the bit-vector assertions.
+       It runs next to CDCL and exchanges assignments with it through a phase
+       oracle over the bits of the bit-vector and Boolean constants.
+       Constant m_decls[i] corresponds to the oracle variables m_offsets[i]
+       up to m_offsets[i + 1], least significant bit first.
+     */
+    struct sls_worker {
+        scoped_ptr<ast_manager>       m_manager;
+        expr_ref_vector               m_fmls;
+        func_decl_ref_vector          m_decls;
+        unsigned_vector               m_offsets;
+        scoped_ptr<sls_engine>        m_sls;
+        scoped_ptr<sat::phase_oracle> m_oracle;
+#ifndef SINGLE_THREAD
+        std::thread                   m_thread;
+#endif
+        sls_worker(ast_manager& m, params_ref const& p):
+            m_manager(alloc(ast_manager, m, true)), m_fmls(*m_manager), m_decls(*m_manager) {
+            m_sls = alloc(sls_engine, *m_manager, p);
+            m_offsets.push_back(0);
+        }
+
+        ~sls_worker() {
+#ifndef SINGLE_THREAD
+            if (m_thread.joinable()) {
+                m_manager->limit().cancel();
+                m_thread.join();
+            }
+#endif
+        }
+
+        void to_hints(model& mdl, bool_vector& hints) {
+            ast_manager& m = *m_manager;
+            bv_util bv(m);
+            rational val;
+            unsigned sz;
+            hints.reset();
+            for (unsigned i = 0; i < m_decls.size(); ++i) {
+                expr* v = mdl.get_const_interp(m_decls.get(i));
+                unsigned n = m_offsets[i + 1] - m_offsets[i];
+                if (v && m.is_bool(v))
+                    hints.push_back(m.is_true(v));
+                else if (v && bv.is_numeral(v, val, sz))
+                    for (unsigned j = 0; j < n; ++j)
+                        hints.push_back(val.get_bit(j));
+                else
+                    hints.resize(hints.size() + n, false);
+            }
+        }
+
+        model_ref to_model(bool_vector const& phases) {
+            ast_manager& m = *m_manager;
+            bv_util bv(m);
+            model_ref mdl = alloc(model, m);
+            for (unsigned i = 0; i < m_decls.size(); ++i) {
+                func_decl* f = m_decls.get(i);
+                unsigned lo = m_offsets[i], hi = m_offsets[i + 1];
+                if (m.is_bool(f->get_range())) {
+                    mdl->register_decl(f, phases[lo] ? m.mk_true() : m.mk_false());
+                    continue;
+                }
+                rational val(0);
+                for (unsigned j = hi; j-- > lo; )
+                    val = 2 * val + rational(phases[j] ? 1 : 0);
+                mdl->register_decl(f, bv.mk_numeral(val, hi - lo));
+            }
+            return mdl;
+        }
+
+        void run() {
+            try {
+                m_sls->init();
+                unsigned best = UINT_MAX;
+                bool_vector hints, phases;
+                while (m_manager->inc()) {
+                    lbool r = m_sls->search();
+                    unsigned num_unsat = m_sls->get_num_unsat();
+                    if (num_unsat <= best) {
+                        best = num_unsat;
+                        to_hints(*m_sls->get_model(), hints);
+                        m_oracle->set_hints(hints);
+                    }
+                    if (r == l_true || !m_sls->restart())
+                        return;
+                    // start the next round from the phases of CDCL, if it restarted since
+                    if (m_oracle->get_phases(phases) && phases.size() == m_offsets.back())
+                        m_sls->set_model(to_model(phases));
+                }
+            }
+            catch (z3_exception&) {
+            }
+        }
+    };
+
     mutable sat::solver     m_solver;
     stacked_value<bool> m_has_uninterpreted;
     goal2sat        m_goal2sat;
@@ -72,12 +174,15 @@ class inc_sat_solver : public solver {
     mutable obj_hashtable<func_decl>  m_inserted_const2bits;
     mutable ref<sat2goal::mc>   m_sat_mc;
     mutable model_converter_ref m_cached_mc;
+    scoped_ptr<sls_worker> m_sls_worker;
+    unsigned            m_num_sls_hints = 0;
     svector<double>     m_weights;
     std::string         m_unknown;
     // access formulas after they have been pre-processed and handled by the sat solver.
     // this allows to access the internal state of the SAT solver and carry on partial results.
     bool                m_internalized_converted; // have internalized formulas been converted back
     expr_ref_vector     m_internalized_fmls;      // formulas in internalized format
+    expr_ref_vector     m_hints;                  // hints from set_hints, applied by the next check
 
     typedef obj_map<expr, sat::literal> dep2asm_t;
 
@@ -98,7 +203,8 @@ public:
         m_num_scopes(0),
         m_unknown("no reason given"),
         m_internalized_converted(false), 
-        m_internalized_fmls(m) {
+        m_internalized_fmls(m),
+        m_hints(m) {
         updt_params(p);
         m_mcs.push_back(nullptr);
         init_preprocess();
@@ -115,6 +221,14 @@ public:
     }
 
     solver* translate(ast_manager& dst_m, params_ref const& p) override {
+        return clone(dst_m, p, false);
+    }
+
+    solver* fork(params_ref const& p) override {
+        return clone(m, p, true);
+    }
+
+    solver* clone(ast_manager& dst_m, params_ref const& p, bool copy_learned) {
         if (m_num_scopes > 0) {
             throw default_exception("Cannot translate sat solver at non-base level");
         }
@@ -125,10 +239,10 @@ public:
         if (ext) {
             auto& si = result->m_goal2sat.si(dst_m, m_params, result->m_solver, result->m_map, result->m_dep2asm, is_incremental());
             euf::solver::scoped_set_translate st(*ext, dst_m, si);  
-            result->m_solver.copy(m_solver);
+            result->m_solver.copy(m_solver, copy_learned);
         }        
         else {
-            result->m_solver.copy(m_solver);
+            result->m_solver.copy(m_solver, copy_learned);
         }
         result->m_fmls_head = m_fmls_head;
         for (expr* f : m_fmls) result->m_fmls.push_back(tr(f));
@@ -148,6 +262,10 @@ public:
 
     void set_progress_callback(progress_callback * callback) override {}
 
+    void register_stats_callback(unsigned interval_ms, stats_eh const& eh) override {
+        m_solver.set_stats_callback(interval_ms, eh);
+    }
+
     void display_weighted(std::ostream& out, unsigned sz, expr * const * assumptions, unsigned const* weights) {
         if (weights != nullptr) {
             for (unsigned i = 0; i < sz; ++i) m_weights.push_back(weights[i]);
@@ -204,10 +322,12 @@ public:
         if (r != l_true) return r;
         r = internalize_assumptions(sz, _assumptions.data());
         if (r != l_true) return r;
+        apply_hints();
 
         init_reason_unknown();
         m_internalized_converted = false;
         bool reason_set = false;
+        start_sls();
         try {
             // IF_VERBOSE(0, m_solver.display(verbose_stream()));
             r = m_solver.check(m_asms.size(), m_asms.data());
@@ -220,6 +340,7 @@ public:
             }
             r = l_undef;            
         }
+        stop_sls();
         switch (r) {
         case l_true:
             if (m_has_uninterpreted()) {
@@ -372,6 +493,7 @@ public:
     void collect_statistics(statistics & st) const override {
         if (m_preprocess) m_preprocess->collect_statistics(st);
         m_solver.collect_statistics(st);
+        if (m_num_sls_hints > 0) st.update("sat sls hints", m_num_sls_hints);
     }
     void get_unsat_core(expr_ref_vector & r) override {
         r.reset();
@@ -387,6 +509,70 @@ public:
         }
     }
 
+    void get_hints(expr_ref_vector& hints) override {
+        expr_ref_vector lit2expr(m);
+        lit2expr.resize(m_solver.num_vars() * 2);
+        m_map.mk_inv(lit2expr);
+        bool_vector is_unit(m_solver.num_vars(), false);
+        for (unsigned i = 0; i < m_solver.init_trail_size(); ++i) {
+            sat::literal lit = m_solver.trail_literal(i);
+            is_unit[lit.var()] = true;
+            if (lit2expr.get(lit.index()))
+                hints.push_back(lit2expr.get(lit.index()));
+        }
+        sat::bool_var_vector vars;
+        for (sat::bool_var v = 0; v < m_solver.num_vars(); ++v)
+            if (!is_unit[v] && lit2expr.get(sat::literal(v, false).index()))
+                vars.push_back(v);
+        std::stable_sort(vars.begin(), vars.end(), [&](sat::bool_var a, sat::bool_var b) {
+            return m_solver.get_activity(a) > m_solver.get_activity(b); });
+        for (sat::bool_var v : vars)
+            hints.push_back(lit2expr.get(sat::literal(v, !m_solver.get_phase(v)).index()));
+
+        // learned binary and ternary clauses
+        expr_ref_vector lits(m);
+        auto add_clause = [&](unsigned n, sat::literal const* ls) {
+            lits.reset();
+            for (unsigned i = 0; i < n; ++i) {
+                expr* e = lit2expr.get(ls[i].index());
+                if (!e || is_unit[ls[i].var()])
+                    return;
+                lits.push_back(e);
+            }
+            hints.push_back(m.mk_or(lits));
+        };
+        svector<sat::solver::bin_clause> bins;
+        m_solver.collect_bin_clauses(bins, true, true);
+        for (auto const& [l1, l2] : bins) {
+            sat::literal ls[2] = { l1, l2 };
+            add_clause(2, ls);
+        }
+        for (sat::clause* c : m_solver.learned())
+            if (c->size() <= 3)
+                add_clause(c->size(), c->begin());
+    }
+
+    void set_hints(expr_ref_vector const& hints) override {
+        m_hints.reset();
+        m_hints.append(hints);
+    }
+
+    // hints earlier in m_hints are moved to the front last
+    void apply_hints() {
+        for (unsigned i = m_hints.size(); i-- > 0; ) {
+            expr* h = m_hints.get(i);
+            if (m.is_or(h)) {
+                for (expr* arg : *to_app(h))
+                    move_to_front(arg);
+            }
+            else {
+                set_phase(h);
+                move_to_front(h);
+            }
+        }
+        m_hints.reset();
+    }
+
     expr_ref_vector get_trail(unsigned max_level) override {
         expr_ref_vector result(m);
         unsigned sz = m_solver.trail_size();
@@ -609,6 +795,102 @@ public:
         m_internalized_converted = true;
     }
 
+    /**
+       \brief formulas the word-level local search can evaluate.
+     */
+    static bool is_sls_supported(ast_manager& m, expr* f) {
+        bv_util bv(m);
+        basic_op_kind const basic_ops[] = { OP_TRUE, OP_FALSE, OP_AND, OP_OR, OP_NOT, OP_EQ, OP_DISTINCT, OP_ITE };
+        for (expr* e : subterms::ground(expr_ref(f, m))) {
+            if (!is_app(e))
+                return false;
+            app* a = to_app(e);
+            if (is_uninterp_const(a)) {
+                if (!m.is_bool(a) && !bv.is_bv(a))
+                    return false;
+            }
+            else if (a->get_family_id() == m.get_basic_family_id()) {
+                if (std::find(std::begin(basic_ops), std::end(basic_ops), a->get_decl_kind()) == std::end(basic_ops))
+                    return false;
+            }
+            else if (a->get_family_id() == bv.get_family_id()) {
+                switch (a->get_decl_kind()) {
+                case OP_BV_NUM: case OP_CONCAT: case OP_EXTRACT: case OP_BADD: case OP_BSUB: case OP_BMUL: case OP_BNEG:
+                case OP_BSDIV: case OP_BSDIV0: case OP_BSDIV_I: case OP_BUDIV: case OP_BUDIV0: case OP_BUDIV_I:
+                case OP_BSREM: case OP_BSREM0: case OP_BSREM_I: case OP_BUREM: case OP_BUREM0: case OP_BUREM_I:
+                case OP_BSMOD: case OP_BSMOD0: case OP_BSMOD_I: case OP_BAND: case OP_BOR: case OP_BXOR:
+                case OP_BNAND: case OP_BNOR: case OP_BNOT: case OP_ULT: case OP_ULEQ: case OP_UGT: case OP_UGEQ:
+                case OP_SLT: case OP_SLEQ: case OP_SGT: case OP_SGEQ: case OP_BIT2BOOL: case OP_BASHR:
+                case OP_BLSHR: case OP_BSHL: case OP_SIGN_EXT:
+                    break;
+                default:
+                    return false;
+                }
+            }
+            else
+                return false;
+        }
+        return true;
+    }
+
+    /**
+       \brief start word-level local search on the assertions if they are
+       bit-vector formulas that were bit-blasted.
+     */
+    void start_sls() {
+#ifndef SINGLE_THREAD
+        sat_params sp(m_params);
+        if (!sp.bv_sls() || !m_bb_rewriter || m_fmls.empty() || m_solver.get_config().m_num_threads > 1)
+            return;
+        scoped_ptr<sls_worker> w = alloc(sls_worker, m, m_params);
+        ast_manager& wm = *w->m_manager;
+        ast_translation tr(m, wm);
+        th_rewriter rw(wm);
+        expr_ref g(wm);
+        for (expr* f : m_fmls) {
+            rw(tr(f), g);
+            if (!is_sls_supported(wm, g))
+                return;
+            w->m_fmls.push_back(g);
+            w->m_sls->assert_expr(g);
+        }
+        obj_map<func_decl, expr*> const2bits;
+        ptr_vector<func_decl> newbits;
+        m_bb_rewriter->get_translation(const2bits, newbits);
+        sat::bool_var_vector vars;
+        expr* bits = nullptr;
+        for (expr* e : subterms::ground(m_fmls)) {
+            if (!is_uninterp_const(e))
+                continue;
+            func_decl* f = to_app(e)->get_decl();
+            if (m.is_bool(e))
+                vars.push_back(m_map.to_bool_var(e));
+            else if (const2bits.find(f, bits))
+                for (expr* b : *to_app(bits))
+                    vars.push_back(m_map.to_bool_var(b));
+            else
+                continue;
+            w->m_decls.push_back(tr(f));
+            w->m_offsets.push_back(vars.size());
+        }
+        if (vars.empty())
+            return;
+        w->m_oracle = alloc(sat::phase_oracle, vars);
+        m_solver.set_phase_oracle(w->m_oracle.get());
+        sls_worker* _w = w.get();
+        w->m_thread = std::thread([_w]() { _w->run(); });
+        m_sls_worker = w.detach();
+#endif
+    }
+
+    void stop_sls() {
+        if (!m_sls_worker)
+            return;
+        m_solver.set_phase_oracle(nullptr);
+        m_num_sls_hints += m_sls_worker->m_oracle->num_hints();
+        m_sls_worker = nullptr;
+    }
+
     void init_preprocess() {
         if (m_preprocess) {
             m_preprocess->reset();
@@ -688,6 +970,10 @@ public:
     void user_propagate_register_diseq(user_propagator::eq_eh_t& diseq_eh) override {
         ensure_euf()->user_propagate_register_diseq(diseq_eh);
     }
+
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        ensure_euf()->user_propagate_register_batch(batch_eh);
+    }
     
     void user_propagate_register_expr(expr* e) override { 
         ensure_euf()->user_propagate_register_expr(e);
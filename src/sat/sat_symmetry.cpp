@@ -0,0 +1,395 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_symmetry.cpp
+
+Abstract:
+
+    Static symmetry breaking for the clauses of the solver.
+
+--*/
+
+#include <algorithm>
+#include "sat/sat_symmetry.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    symmetry::symmetry(solver& s): s(s) {}
+
+    static uint64_t mix64(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    static bool lex_lt(literal_vector const& a, literal_vector const& b) {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    void symmetry::init_graph() {
+        unsigned num_vars = s.num_vars();
+        m_num_lits = 2 * num_vars;
+        m_clauses.reset();
+        literal_vector lits;
+        auto add = [&]() {
+            std::sort(lits.begin(), lits.end());
+            m_clauses.push_back(lits);
+        };
+        for (unsigned i = 0; i < s.init_trail_size(); ++i) {
+            lits.reset();
+            lits.push_back(s.m_trail[i]);
+            add();
+        }
+        unsigned sz = s.m_watches.size();
+        for (unsigned l_idx = 0; l_idx < sz; ++l_idx) {
+            literal l1 = ~to_literal(l_idx);
+            for (watched const& w : s.m_watches[l_idx]) {
+                if (!w.is_binary_non_learned_clause())
+                    continue;
+                literal l2 = w.get_literal();
+                if (l1.index() > l2.index())
+                    continue;
+                lits.reset();
+                lits.push_back(l1);
+                lits.push_back(l2);
+                add();
+            }
+        }
+        for (clause* c : s.m_clauses) {
+            lits.reset();
+            lits.append(c->size(), c->begin());
+            add();
+        }
+        std::sort(m_clauses.begin(), m_clauses.end(), lex_lt);
+
+        // literals are connected to their negation and to their clauses
+        unsigned num_nodes = m_num_lits + m_clauses.size();
+        unsigned_vector degree(num_nodes, 0u);
+        bool_vector occurs(num_vars, false);
+        unsigned max_size = 0;
+        for (unsigned l = 0; l < m_num_lits; ++l)
+            degree[l] = 1;
+        for (unsigned i = 0; i < m_clauses.size(); ++i) {
+            degree[m_num_lits + i] = m_clauses[i].size();
+            max_size = std::max(max_size, m_clauses[i].size());
+            for (literal lit : m_clauses[i]) {
+                degree[lit.index()]++;
+                occurs[lit.var()] = true;
+            }
+        }
+        m_adj_begin.reset();
+        m_adj_begin.resize(num_nodes + 1, 0);
+        for (unsigned n = 0; n < num_nodes; ++n)
+            m_adj_begin[n + 1] = m_adj_begin[n] + degree[n];
+        m_adj.reset();
+        m_adj.resize(m_adj_begin[num_nodes], 0);
+        unsigned_vector pos(num_nodes, 0u);
+        for (unsigned n = 0; n < num_nodes; ++n)
+            pos[n] = m_adj_begin[n];
+        for (unsigned l = 0; l < m_num_lits; ++l)
+            m_adj[pos[l]++] = l ^ 1;
+        for (unsigned i = 0; i < m_clauses.size(); ++i) {
+            unsigned c = m_num_lits + i;
+            for (literal lit : m_clauses[i]) {
+                m_adj[pos[c]++] = lit.index();
+                m_adj[pos[lit.index()]++] = c;
+            }
+        }
+
+        // clauses are colored by their size, variables that do not occur are fixed
+        m_initial.reset();
+        m_initial.resize(num_nodes, 0);
+        for (bool_var v = 0; v < num_vars; ++v) {
+            if (!occurs[v]) {
+                m_initial[2 * v] = max_size + 1 + 2 * v;
+                m_initial[2 * v + 1] = max_size + 2 + 2 * v;
+            }
+        }
+        for (unsigned i = 0; i < m_clauses.size(); ++i)
+            m_initial[m_num_lits + i] = m_clauses[i].size();
+
+        m_orbit.reset();
+        for (unsigned l = 0; l < m_num_lits; ++l)
+            m_orbit.push_back(l);
+    }
+
+    /**
+       \brief renumber the nodes by the rank of (color, key), so that the
+       colors only depend on the structure of the graph.
+    */
+    unsigned symmetry::rank(unsigned_vector& color, svector<uint64_t> const& key) {
+        unsigned n = color.size();
+        m_order.reset();
+        for (unsigned i = 0; i < n; ++i)
+            m_order.push_back(i);
+        std::sort(m_order.begin(), m_order.end(), [&](unsigned a, unsigned b) {
+            return color[a] < color[b] || (color[a] == color[b] && key[a] < key[b]);
+        });
+        m_new_color.reset();
+        m_new_color.resize(n, 0);
+        unsigned r = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            unsigned a = m_order[i];
+            if (i > 0) {
+                unsigned b = m_order[i - 1];
+                if (color[a] != color[b] || key[a] != key[b])
+                    ++r;
+            }
+            m_new_color[a] = r;
+        }
+        color.swap(m_new_color);
+        return n == 0 ? 0 : r + 1;
+    }
+
+    /**
+       \brief refine the coloring until it is equitable. The key of a node
+       is a hash of the multiset of the colors of its neighbors.
+    */
+    bool symmetry::refine(unsigned_vector& color, unsigned& num_colors) {
+        unsigned n = color.size();
+        while (true) {
+            uint64_t work = n + m_adj.size();
+            if (m_budget < work) {
+                m_budget = 0;
+                return false;
+            }
+            m_budget -= work;
+            m_key.reset();
+            m_key.resize(n, 0);
+            for (unsigned v = 0; v < n; ++v) {
+                uint64_t h = 0;
+                for (unsigned i = m_adj_begin[v]; i < m_adj_begin[v + 1]; ++i)
+                    h += mix64(color[m_adj[i]]);
+                m_key[v] = h;
+            }
+            unsigned k = rank(color, m_key);
+            if (k == num_colors)
+                return true;
+            num_colors = k;
+        }
+    }
+
+    bool symmetry::individualize(unsigned_vector& color, unsigned& num_colors, unsigned node) {
+        color[node] = num_colors++;
+        return refine(color, num_colors);
+    }
+
+    bool symmetry::compatible(unsigned_vector const& left, unsigned_vector const& right, unsigned num_colors) {
+        m_count1.reset();
+        m_count1.resize(num_colors, 0);
+        m_count2.reset();
+        m_count2.resize(num_colors, 0);
+        for (unsigned c : left)
+            m_count1[c]++;
+        for (unsigned c : right)
+            m_count2[c]++;
+        return m_count1 == m_count2;
+    }
+
+    /**
+       \brief first literal node in a cell with several literal nodes, or UINT_MAX.
+    */
+    unsigned symmetry::target_cell(unsigned_vector const& color, unsigned num_colors) {
+        m_count1.reset();
+        m_count1.resize(num_colors, 0);
+        for (unsigned l = 0; l < m_num_lits; ++l)
+            m_count1[color[l]]++;
+        for (unsigned l = 0; l < m_num_lits; ++l)
+            if (m_count1[color[l]] > 1)
+                return l;
+        return UINT_MAX;
+    }
+
+    bool symmetry::complete(unsigned_vector const& left, unsigned_vector const& right, unsigned num_colors) {
+        unsigned a = target_cell(left, num_colors);
+        if (a == UINT_MAX) {
+            unsigned_vector color2node(num_colors, UINT_MAX);
+            for (unsigned l = 0; l < m_num_lits; ++l)
+                color2node[right[l]] = l;
+            unsigned_vector perm;
+            for (unsigned l = 0; l < m_num_lits; ++l) {
+                unsigned r = color2node[left[l]];
+                if (r == UINT_MAX)
+                    return false;
+                perm.push_back(r);
+            }
+            if (!is_symmetry(perm))
+                return false;
+            m_generators.push_back(perm);
+            return true;
+        }
+        unsigned_vector left2(left);
+        unsigned num_colors2 = num_colors;
+        if (!individualize(left2, num_colors2, a))
+            return false;
+        unsigned_vector candidates;
+        if (right[a] == left[a])
+            candidates.push_back(a);
+        for (unsigned l = 0; l < m_num_lits; ++l)
+            if (l != a && right[l] == left[a])
+                candidates.push_back(l);
+        for (unsigned b : candidates) {
+            unsigned_vector right2(right);
+            unsigned num_colors3 = num_colors;
+            if (!individualize(right2, num_colors3, b))
+                return false;
+            if (num_colors2 == num_colors3 && compatible(left2, right2, num_colors2) && complete(left2, right2, num_colors2))
+                return true;
+            if (m_budget == 0)
+                return false;
+        }
+        return false;
+    }
+
+    /**
+       \brief check that the permutation is not the identity, commutes with
+       negation and maps clauses to clauses.
+    */
+    bool symmetry::is_symmetry(unsigned_vector const& perm) {
+        bool is_id = true;
+        for (unsigned l = 0; l < m_num_lits; ++l) {
+            if (perm[l ^ 1] != (perm[l] ^ 1))
+                return false;
+            is_id &= perm[l] == l;
+        }
+        if (is_id)
+            return false;
+        literal_vector image;
+        for (literal_vector const& c : m_clauses) {
+            if (m_budget < c.size()) {
+                m_budget = 0;
+                return false;
+            }
+            m_budget -= c.size();
+            image.reset();
+            for (literal lit : c)
+                image.push_back(to_literal(perm[lit.index()]));
+            std::sort(image.begin(), image.end());
+            if (!std::binary_search(m_clauses.begin(), m_clauses.end(), image, lex_lt))
+                return false;
+        }
+        return true;
+    }
+
+    unsigned symmetry::find(unsigned n) {
+        while (m_orbit[n] != n) {
+            m_orbit[n] = m_orbit[m_orbit[n]];
+            n = m_orbit[n];
+        }
+        return n;
+    }
+
+    void symmetry::merge_orbits(unsigned_vector const& perm) {
+        for (unsigned l = 0; l < m_num_lits; ++l) {
+            unsigned a = find(l), b = find(perm[l]);
+            if (a != b)
+                m_orbit[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    void symmetry::find_generators() {
+        unsigned_vector color(m_initial);
+        m_key.reset();
+        m_key.resize(color.size(), 0);
+        unsigned num_colors = rank(color, m_key);
+        if (!refine(color, num_colors))
+            return;
+        while (m_generators.size() < s.m_config.m_symmetry_max_generators) {
+            unsigned a = target_cell(color, num_colors);
+            if (a == UINT_MAX)
+                return;
+            unsigned_vector left(color);
+            unsigned num_left = num_colors;
+            if (!individualize(left, num_left, a))
+                return;
+            unsigned_vector candidates;
+            for (unsigned l = 0; l < m_num_lits; ++l)
+                if (l != a && color[l] == color[a])
+                    candidates.push_back(l);
+            for (unsigned b : candidates) {
+                if (find(a) == find(b))
+                    continue;
+                unsigned_vector right(color);
+                unsigned num_right = num_colors;
+                if (!individualize(right, num_right, b))
+                    return;
+                if (num_left == num_right && compatible(left, right, num_left) && complete(left, right, num_left)) {
+                    merge_orbits(m_generators.back());
+                    IF_VERBOSE(10, verbose_stream() << "(sat.symmetry :generator " << m_generators.size() << ")\n");
+                }
+                if (m_budget == 0 || m_generators.size() >= s.m_config.m_symmetry_max_generators)
+                    return;
+            }
+            // continue in the stabilizer of a
+            color.swap(left);
+            num_colors = num_left;
+        }
+    }
+
+    void symmetry::add_clause(literal_vector& lits) {
+        s.mk_clause(lits.size(), lits.data(), status::asserted());
+        ++m_num_clauses_added;
+    }
+
+    /**
+       \brief add the lex-leader constraint x <= perm(x) over the support of perm.
+       e_i is implied when the prefix up to position i is equal, and enables
+       the comparison at position i + 1.
+    */
+    void symmetry::break_symmetry(unsigned_vector const& perm) {
+        bool_var_vector support;
+        for (bool_var v = 0; 2 * v < m_num_lits && support.size() < s.m_config.m_symmetry_max_support; ++v)
+            if (perm[2 * v] != 2 * v)
+                support.push_back(v);
+        literal e = null_literal;
+        literal_vector lits;
+        for (unsigned i = 0; i < support.size(); ++i) {
+            literal x(support[i], false);
+            literal y = to_literal(perm[x.index()]);
+            lits.reset();
+            if (e != null_literal)
+                lits.push_back(~e);
+            lits.push_back(~x);
+            if (y == ~x) {
+                add_clause(lits);
+                return;
+            }
+            lits.push_back(y);
+            add_clause(lits);
+            if (i + 1 == support.size())
+                return;
+            literal e2(s.mk_var(false, true), false);
+            lits.reset();
+            if (e != null_literal)
+                lits.push_back(~e);
+            lits.push_back(~x);
+            lits.push_back(e2);
+            add_clause(lits);
+            lits.reset();
+            if (e != null_literal)
+                lits.push_back(~e);
+            lits.push_back(y);
+            lits.push_back(e2);
+            add_clause(lits);
+            e = e2;
+        }
+    }
+
+    unsigned symmetry::operator()() {
+        m_budget = s.m_config.m_symmetry_budget;
+        init_graph();
+        if (m_num_lits == 0 || m_clauses.empty())
+            return 0;
+        find_generators();
+        m_clauses.reset();
+        m_adj.reset();
+        for (unsigned_vector const& perm : m_generators)
+            break_symmetry(perm);
+        IF_VERBOSE(2, verbose_stream() << "(sat.symmetry :generators " << m_generators.size() << " :clauses " << m_num_clauses_added << ")\n");
+        return m_generators.size();
+    }
+}
@@ -0,0 +1,80 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_symmetry.h
+
+Abstract:
+
+    Static symmetry breaking for the clauses of the solver.
+
+    The clauses are turned into a colored graph with a node for each
+    literal and a node for each clause. A literal is connected to its
+    negation and to the clauses it occurs in, clause nodes are colored by
+    the size of the clause. Automorphisms of the graph that respect
+    negation and map clauses to clauses are symmetries of the clauses.
+
+    Generators are searched for in the style of saucy: the coloring is
+    refined to an equitable partition, a node of the first non-trivial
+    cell is individualized on the left, every node of the same cell on the
+    right, and the search continues until the literal nodes are discrete.
+    The resulting permutation is checked against the clauses. Candidates
+    in the orbit of the individualized node under the generators found so
+    far are skipped, and the search continues in the stabilizer of the
+    node. The search is bounded by a work budget.
+
+    For each generator a lex-leader constraint over the variables of its
+    support, in the order of the variables, is added with the compact
+    encoding that introduces one variable per position for the equality of
+    the prefix.
+
+--*/
+#pragma once
+
+#include "sat/sat_types.h"
+
+namespace sat {
+    class solver;
+
+    class symmetry {
+        solver&                 s;
+        unsigned                m_num_lits = 0;      // nodes 0 .. m_num_lits-1 are literals, the rest are clauses
+        unsigned_vector         m_adj_begin;
+        unsigned_vector         m_adj;
+        unsigned_vector         m_initial;           // initial coloring
+        vector<literal_vector>  m_clauses;           // sorted clauses
+        uint64_t                m_budget = 0;
+        vector<unsigned_vector> m_generators;        // permutations of literal indices
+        unsigned_vector         m_orbit;             // union-find over literal nodes
+        unsigned_vector         m_order, m_new_color;
+        svector<uint64_t>       m_key;
+        unsigned_vector         m_count1, m_count2;
+        unsigned                m_num_clauses_added = 0;
+
+        void init_graph();
+        unsigned rank(unsigned_vector& color, svector<uint64_t> const& key);
+        bool refine(unsigned_vector& color, unsigned& num_colors);
+        bool individualize(unsigned_vector& color, unsigned& num_colors, unsigned node);
+        bool compatible(unsigned_vector const& left, unsigned_vector const& right, unsigned num_colors);
+        unsigned target_cell(unsigned_vector const& color, unsigned num_colors);
+        bool complete(unsigned_vector const& left, unsigned_vector const& right, unsigned num_colors);
+        bool is_symmetry(unsigned_vector const& perm);
+        unsigned find(unsigned n);
+        void merge_orbits(unsigned_vector const& perm);
+        void find_generators();
+        void add_clause(literal_vector& lits);
+        void break_symmetry(unsigned_vector const& perm);
+
+    public:
+        symmetry(solver& s);
+
+        /**
+           \brief find generators and add their lex-leader constraints.
+           Returns the number of generators.
+        */
+        unsigned operator()();
+
+        unsigned num_clauses_added() const { return m_num_clauses_added; }
+    };
+};
@@ -119,6 +119,7 @@ namespace sat {
 
     watched* find_binary_watch(watch_list & wlist, literal l);
     watched const* find_binary_watch(watch_list const & wlist, literal l);
+    void erase_binary_watch(watch_list & wlist, literal l);
     bool erase_clause_watch(watch_list & wlist, clause_offset c);
 
     class clause_allocator;
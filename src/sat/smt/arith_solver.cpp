@@ -1146,6 +1146,16 @@ namespace arith {
             IF_VERBOSE(4, verbose_stream() << "cut " << b << "\n");
             literal lit = expr2literal(b);
             assign(lit, m_core, m_eqs, explain(hint_type::bound_h, lit));
+            for (auto const& c : m_lia->additional_cuts()) {
+                ++m_stats.m_gomory_cuts;
+                reset_evidence();
+                for (auto ev : c.m_ex)
+                    set_evidence(ev.ci());
+                b = mk_bound(c.m_t, c.m_k, true);
+                IF_VERBOSE(4, verbose_stream() << "cut " << b << "\n");
+                lit = expr2literal(b);
+                assign(lit, m_core, m_eqs, explain(hint_type::bound_h, lit));
+            }
             lia_check = l_false;
             break;
         }
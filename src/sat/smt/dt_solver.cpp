@@ -46,8 +46,10 @@ namespace dt {
         var_data* d_dst = m_var_data[v];
         var_data* d_src = src.m_var_data[v];
         ctx.attach_th_var(n, this, v);
-        if (d_src->m_constructor && !d_dst->m_constructor)
+        if (d_src->m_constructor && !d_dst->m_constructor) {
             d_dst->m_constructor = src.ctx.copy(ctx, d_src->m_constructor);
+            oc_add_dirty(d_dst->m_constructor);
+        }
         for (auto* r : d_src->m_recognizers)
             d_dst->m_recognizers.push_back(src.ctx.copy(ctx, r));
     }
@@ -218,6 +220,7 @@ namespace dt {
         ctx.attach_th_var(n, this, r);
         if (is_constructor(n)) {
             d->m_constructor = n;
+            oc_add_dirty(n);
             assert_accessor_axioms(n);
         }
         else if (is_update_field(n)) 
@@ -504,6 +507,8 @@ namespace dt {
             }
             d1->m_constructor = con2;
         }
+        if (d1->m_constructor)
+            oc_add_dirty(var2enode(v1));
         for (enode* e : d2->m_recognizers)
             if (e)
                 add_recognizer(v1, e);
@@ -721,11 +726,47 @@ namespace dt {
         return res;
     }
 
+    void solver::oc_add_dirty(enode* n) {
+        if (m_oc_full || !dt.is_recursive(n->get_sort()))
+            return;
+        if (is_constructor(n)) {
+            for (enode* arg : euf::enode_args(n)) {
+                sort* s = arg->get_sort(), * se = nullptr;
+                if ((m_autil.is_array(s) && dt.is_datatype(get_array_range(s))) ||
+                    (m_sutil.is_seq(s, se) && dt.is_datatype(se))) {
+                    m_oc_full = true;
+                    return;
+                }
+            }
+        }
+        m_oc_dirty.push_back(n);
+        ctx.push(push_back_vector<ptr_vector<enode>>(m_oc_dirty));
+    }
+
+    /**
+       \brief occurs check for the classes that gained constructor edges
+       since the last check. Return true if a cycle was found.
+    */
+    bool solver::oc_check_dirty() {
+        for (unsigned i = m_oc_qhead; i < m_oc_dirty.size(); ++i) {
+            enode* n = m_oc_dirty[i];
+            if (!oc_cycle_free(n) && occurs_check(n))
+                return true;
+        }
+        if (m_oc_qhead < m_oc_dirty.size()) {
+            ctx.push(value_trail<unsigned>(m_oc_qhead));
+            m_oc_qhead = m_oc_dirty.size();
+        }
+        return false;
+    }
+
     sat::check_result solver::check() {
         force_push();
         int num_vars = get_num_vars();
         sat::check_result r = sat::check_result::CR_DONE;
         final_check_st _guard(*this);
+        if (!m_oc_full && oc_check_dirty())
+            return sat::check_result::CR_CONTINUE;
         int start = s().rand()();
         for (int i = 0; i < num_vars; i++) {
             theory_var v = (i + start) % num_vars;
@@ -734,7 +775,7 @@ namespace dt {
             enode* node = var2enode(v);
             if (!is_datatype(node))
                 continue;
-            if (dt.is_recursive(node->get_sort()) && !oc_cycle_free(node) && occurs_check(node))
+            if (m_oc_full && dt.is_recursive(node->get_sort()) && !oc_cycle_free(node) && occurs_check(node))
                 return sat::check_result::CR_CONTINUE;
             if (get_config().m_dt_lazy_splits == 0)
                 continue;
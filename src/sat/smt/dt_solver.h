@@ -101,6 +101,16 @@ namespace dt {
         svector<stack_entry>  m_dfs; // stack for DFS for occurs_check
         sat::literal_vector   m_lits;
 
+        // Classes that gained constructor edges, trailed. Backtracking only 
+        // removes edges, so a new cycle passes through a class added after 
+        // the last occurs check, m_oc_qhead. Arguments of array and sequence
+        // type gain edges without merges; they enable checking all classes.
+        ptr_vector<enode>     m_oc_dirty;
+        unsigned              m_oc_qhead = 0;
+        bool                  m_oc_full = false;
+        void oc_add_dirty(enode * n);
+        bool oc_check_dirty();
+
         void clear_mark();
 
         void oc_mark_on_stack(enode * n);
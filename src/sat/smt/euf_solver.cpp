@@ -52,7 +52,8 @@ namespace euf {
         m_clause_visitor(m),
         m_smt_proof_checker(m, p),
         m_clause(m),
-        m_expr_args(m)
+        m_expr_args(m),
+        m_lazy_atoms(m)
     {
         updt_params(p);
         m_relevancy.set_enabled(get_config().m_relevancy_lvl > 2);
@@ -353,8 +354,11 @@ namespace euf {
         if (!e) 
             return;                
         euf::enode* n = m_egraph.find(e);
-        if (!n)
+        if (!n) {
+            if (is_lazy_atom(l.var()))
+                m_lazy_queue.push_back(l);
             return;
+        }
         bool sign = l.sign();
         lbool old_value = n->value();
         lbool new_value = sign ? l_false : l_true;
@@ -403,6 +407,42 @@ namespace euf {
 
 
 
+    void solver::add_lazy_atom(sat::bool_var v, expr* e) {
+        SASSERT(!get_enode(e));
+        m_lazy_atoms.reserve(v + 1);
+        m_lazy_atoms.set(v, e);
+        s().set_external(v);
+        set_bool_var2expr(v, e);
+    }
+
+    /**
+    * Internalize the atoms of assigned relevant literals that were added
+    * lazily and assert the literals again now that they have an enode.
+    */
+    bool solver::internalize_lazy_atoms() {
+        if (m_lazy_queue.empty())
+            return false;
+        sat::literal_vector lits(m_lazy_queue);
+        m_lazy_queue.reset();
+        for (sat::literal lit : lits) {
+            if (s().inconsistent())
+                break;
+            expr* e = m_lazy_atoms.get(lit.var());
+            if (s().value(lit) != l_true || get_enode(e))
+                continue;
+            TRACE("euf", tout << "internalize lazy atom " << lit << " " << mk_bounded_pp(e, m) << "\n");
+            ++m_stats.m_lazy_atoms;
+            m_bool_var2expr[lit.var()] = nullptr;
+            internalize(e, false, false);
+            enode* n = get_enode(e);
+            SASSERT(n && n->bool_var() == lit.var());
+            m_relevancy.mark_relevant(n);
+            if (m_relevancy.is_relevant(lit))
+                asserted(lit);
+        }
+        return true;
+    }
+
     bool solver::unit_propagate() {
         bool propagated = false;
         while (!s().inconsistent()) {
@@ -412,7 +452,7 @@ namespace euf {
                 set_conflict(conflict_constraint().to_index());
                 return true;
             }
-            bool propagated1 = false;
+            bool propagated1 = internalize_lazy_atoms();
             if (m_egraph.propagate()) {
                 propagate_literals();
                 propagate_th_eqs();
@@ -629,9 +669,20 @@ namespace euf {
         scope const & sc = m_scopes[m_scopes.size() - n];
         for (unsigned i = m_var_trail.size(); i-- > sc.m_var_lim; ) {
             bool_var v = m_var_trail[i];
+            if (is_lazy_atom(v)) {
+                // the atom is internalized again when it becomes relevant
+                m_bool_var2expr[v] = m_lazy_atoms.get(v);
+                continue;
+            }
             m_bool_var2expr[v] = nullptr;
             s().set_non_external(v);
         }
+        // the Boolean assignment is undone after the extension is popped
+        unsigned j = 0, new_lvl = s().scope_lvl() - n;
+        for (sat::literal lit : m_lazy_queue)
+            if (s().lvl(lit) <= new_lvl && m_relevancy.is_relevant(lit))
+                m_lazy_queue[j++] = lit;
+        m_lazy_queue.shrink(j);
         m_var_trail.shrink(sc.m_var_lim);        
         m_scopes.shrink(m_scopes.size() - n);
         SASSERT(m_egraph.num_scopes() == m_scopes.size());
@@ -998,6 +1049,7 @@ namespace euf {
         m_smt_proof_checker.collect_statistics(st);
         st.update("euf ackerman", m_stats.m_ackerman);
         st.update("euf final check", m_stats.m_final_checks);
+        st.update("euf lazy atoms", m_stats.m_lazy_atoms);
     }
 
     enode* solver::copy(solver& dst_ctx, enode* src_n) {
@@ -1031,6 +1083,15 @@ namespace euf {
                 IF_VERBOSE(11, verbose_stream() << "set bool_var " << b << " " << r->bpp(n) << " " << mk_bounded_pp(n->get_expr(), m) << "\n");
             }
         }
+        for (unsigned v = 0; v < m_lazy_atoms.size(); ++v) {
+            expr* e = m_lazy_atoms.get(v);
+            if (!e)
+                continue;
+            r->m_lazy_atoms.reserve(v + 1);
+            r->m_lazy_atoms.set(v, e);
+            if (!r->get_enode(e))
+                r->m_bool_var2expr.setx(v, e, nullptr);
+        }
         for (auto* s_orig : m_id2solver) {
             if (s_orig) {
                 auto* s_clone = s_orig->clone(*r);
@@ -92,6 +92,7 @@ namespace euf {
         struct stats {
             unsigned m_ackerman;
             unsigned m_final_checks;
+            unsigned m_lazy_atoms;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -163,6 +164,13 @@ namespace euf {
         expr_ref_vector                  m_clause;
         expr_ref_vector                  m_expr_args;
 
+        // atoms internalized lazily: the Boolean variable exists, the atom is
+        // internalized when it is assigned and relevant, and its enode is
+        // removed again when the scope of the internalization is popped.
+        expr_ref_vector                  m_lazy_atoms;        // bool_var -> atom, or null
+        sat::literal_vector              m_lazy_queue;        // assigned relevant literals of atoms without enode
+        bool internalize_lazy_atoms();
+
 
         // internalization
         bool visit(expr* e) override;
@@ -449,6 +457,9 @@ namespace euf {
         euf::enode* e_internalize(expr* e);
         euf::enode* mk_enode(expr* e, unsigned n, enode* const* args);
         void set_bool_var2expr(sat::bool_var v, expr* e) { m_var_trail.push_back(v);  m_bool_var2expr.setx(v, e, nullptr); }
+        bool is_lazy_atom(sat::bool_var v) const { return v < m_lazy_atoms.size() && m_lazy_atoms.get(v); }
+        bool can_add_lazy_atom() { return m_config.m_relevancy_lazy && relevancy_enabled() && s().scope_lvl() == 0 && !use_drat(); }
+        void add_lazy_atom(sat::bool_var v, expr* e);
         expr* bool_var2expr(sat::bool_var v) const { return m_bool_var2expr.get(v, nullptr); }
         expr_ref literal2expr(sat::literal lit) const { expr* e = bool_var2expr(lit.var()); return (e && lit.sign()) ? expr_ref(mk_not(m, e), m) : expr_ref(e, m); }
         unsigned generation() const { return m_generation; }
@@ -526,6 +537,10 @@ namespace euf {
             check_for_user_propagator();
             m_user_propagator->register_diseq(diseq_eh);
         }
+        void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) {
+            check_for_user_propagator();
+            m_user_propagator->register_batch(batch_eh);
+        }
         void user_propagate_register_created(user_propagator::created_eh_t& ceh) {
             check_for_user_propagator();
             m_user_propagator->register_created(ceh);
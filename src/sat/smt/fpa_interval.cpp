@@ -0,0 +1,245 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    fpa_interval.cpp
+
+Abstract:
+
+    Interval reasoning over floating-point terms.
+
+    Asserted comparisons between terms and numerals bound the values of
+    the terms. Intervals of compound terms are evaluated bottom-up with
+    outward rounding: lower bounds round toward negative, upper bounds
+    toward positive, so the interval contains the result under every
+    rounding mode. Intervals cover the values other than NaN. A term with
+    an empty interval can only be NaN, which the comparisons that bound
+    it exclude; the bounds it depends on are then in conflict. This
+    refutes range checks without building the circuits of lazily
+    converted operations.
+
+--*/
+
+#include "sat/smt/fpa_solver.h"
+
+namespace fpa {
+
+    /**
+       \brief recognize (op t c) and (op c t) where c is a numeral other than NaN.
+     */
+    bool solver::get_bound(expr* e, expr*& t, mpf& c, bool& lower, bool& upper) {
+        if (!is_app(e) || to_app(e)->get_family_id() != get_id() || to_app(e)->get_num_args() != 2)
+            return false;
+        decl_kind k = to_app(e)->get_decl_kind();
+        if (k != OP_FPA_LE && k != OP_FPA_LT && k != OP_FPA_GE && k != OP_FPA_GT && k != OP_FPA_EQ)
+            return false;
+        expr* a = to_app(e)->get_arg(0), *b = to_app(e)->get_arg(1);
+        bool flip = false;
+        if (m_fpa_util.is_numeral(b, c))
+            t = a;
+        else if (m_fpa_util.is_numeral(a, c))
+            t = b, flip = true;
+        else
+            return false;
+        if (m_fpa_util.fm().is_nan(c))
+            return false;
+        lower = k == OP_FPA_EQ || (flip ? (k == OP_FPA_LE || k == OP_FPA_LT) : (k == OP_FPA_GE || k == OP_FPA_GT));
+        upper = k == OP_FPA_EQ || (flip ? (k == OP_FPA_GE || k == OP_FPA_GT) : (k == OP_FPA_LE || k == OP_FPA_LT));
+        return true;
+    }
+
+    void solver::add_bound(sat::literal l) {
+        if (l.sign())
+            return;
+        scoped_mpf c(m_fpa_util.fm());
+        expr* t = nullptr;
+        bool lower, upper;
+        if (!get_bound(ctx.bool_var2expr(l.var()), t, c, lower, upper))
+            return;
+        m_bounds.push_back(l);
+        ctx.push(push_back_vector(m_bounds));
+    }
+
+    bool solver::check_intervals() {
+        if (m_bounds.empty())
+            return false;
+        mpf_manager& fm = m_fpa_util.fm();
+        scoped_mpf_vector lo(fm), hi(fm);
+        vector<sat::literal_vector> deps;
+        obj_map<expr, unsigned> term2iv;
+        obj_map<expr, unsigned_vector> term2bounds;
+        scoped_mpf c(fm), t(fm);
+        expr* e = nullptr;
+        bool lower, upper;
+        for (unsigned i = 0; i < m_bounds.size(); ++i) {
+            VERIFY(get_bound(ctx.bool_var2expr(m_bounds[i].var()), e, c, lower, upper));
+            term2bounds.insert_if_not_there(e, unsigned_vector()).push_back(i);
+        }
+
+        auto set_full = [&](unsigned i, unsigned ebits, unsigned sbits) {
+            fm.mk_ninf(ebits, sbits, lo[i]);
+            fm.mk_pinf(ebits, sbits, hi[i]);
+            deps[i].reset();
+        };
+
+        // extremes of x op y over the corners of two intervals, false if
+        // a corner is NaN.
+        auto corners = [&](unsigned i, decl_kind k, unsigned x, unsigned y, unsigned z) {
+            mpf const* xs[2] = { &lo[x], &hi[x] };
+            mpf const* ys[2] = { &lo[y], &hi[y] };
+            bool first = true;
+            for (mpf const* a : xs) {
+                for (mpf const* b : ys) {
+                    for (auto rm : { MPF_ROUND_TOWARD_NEGATIVE, MPF_ROUND_TOWARD_POSITIVE }) {
+                        if (k == OP_FPA_MUL)
+                            fm.mul(rm, *a, *b, t);
+                        else if (k == OP_FPA_DIV)
+                            fm.div(rm, *a, *b, t);
+                        else
+                            fm.fma(rm, *a, *b, rm == MPF_ROUND_TOWARD_NEGATIVE ? lo[z] : hi[z], t);
+                        if (fm.is_nan(t))
+                            return false;
+                        if (rm == MPF_ROUND_TOWARD_NEGATIVE && (first || fm.lt(t, lo[i])))
+                            fm.set(lo[i], t);
+                        if (rm == MPF_ROUND_TOWARD_POSITIVE && (first || fm.lt(hi[i], t)))
+                            fm.set(hi[i], t);
+                    }
+                    first = false;
+                }
+            }
+            return true;
+        };
+
+        auto eval = [&](app* a, unsigned i) {
+            sort* s = a->get_sort();
+            unsigned ebits = m_fpa_util.get_ebits(s), sbits = m_fpa_util.get_sbits(s);
+            set_full(i, ebits, sbits);
+            if (m_fpa_util.is_numeral(a, t)) {
+                if (!fm.is_nan(t)) {
+                    fm.set(lo[i], t);
+                    fm.set(hi[i], t);
+                }
+                return;
+            }
+            if (a->get_family_id() != get_id())
+                return;
+            auto arg = [&](unsigned j) { return term2iv.find(a->get_arg(j)); };
+            bool ok = true;
+            switch (a->get_decl_kind()) {
+            case OP_FPA_NEG:
+                fm.neg(hi[arg(0)], lo[i]);
+                fm.neg(lo[arg(0)], hi[i]);
+                break;
+            case OP_FPA_ADD:
+            case OP_FPA_SUB: {
+                bool sub = a->get_decl_kind() == OP_FPA_SUB;
+                unsigned x = arg(1), y = arg(2);
+                if (sub) {
+                    fm.sub(MPF_ROUND_TOWARD_NEGATIVE, lo[x], hi[y], lo[i]);
+                    fm.sub(MPF_ROUND_TOWARD_POSITIVE, hi[x], lo[y], hi[i]);
+                }
+                else {
+                    fm.add(MPF_ROUND_TOWARD_NEGATIVE, lo[x], lo[y], lo[i]);
+                    fm.add(MPF_ROUND_TOWARD_POSITIVE, hi[x], hi[y], hi[i]);
+                }
+                ok = !fm.is_nan(lo[i]) && !fm.is_nan(hi[i]);
+                break;
+            }
+            case OP_FPA_MUL:
+                ok = corners(i, OP_FPA_MUL, arg(1), arg(2), 0);
+                break;
+            case OP_FPA_DIV: {
+                unsigned y = arg(2);
+                fm.mk_zero(ebits, sbits, false, t);
+                ok = !fm.le(lo[y], t) || !fm.le(t, hi[y]);
+                ok = ok && corners(i, OP_FPA_DIV, arg(1), y, 0);
+                break;
+            }
+            case OP_FPA_FMA:
+                ok = corners(i, OP_FPA_FMA, arg(1), arg(2), arg(3));
+                break;
+            case OP_FPA_SQRT: {
+                unsigned x = arg(1);
+                fm.mk_zero(ebits, sbits, false, t);
+                ok = fm.le(t, hi[x]);
+                if (ok) {
+                    if (fm.lt(lo[x], t))
+                        fm.set(lo[i], t);
+                    else
+                        fm.sqrt(MPF_ROUND_TOWARD_NEGATIVE, lo[x], lo[i]);
+                    fm.sqrt(MPF_ROUND_TOWARD_POSITIVE, hi[x], hi[i]);
+                }
+                break;
+            }
+            default:
+                return;
+            }
+            if (!ok) {
+                set_full(i, ebits, sbits);
+                return;
+            }
+            unsigned j;
+            for (expr* arg : *a)
+                if (term2iv.find(arg, j))
+                    deps[i].append(deps[j]);
+        };
+
+        auto intersect = [&](expr* n, unsigned i) {
+            auto* bs = term2bounds.find_core(n);
+            if (!bs)
+                return;
+            for (unsigned b : bs->get_data().m_value) {
+                sat::literal l = m_bounds[b];
+                VERIFY(get_bound(ctx.bool_var2expr(l.var()), e, c, lower, upper));
+                bool used = false;
+                if (lower && fm.lt(lo[i], c))
+                    fm.set(lo[i], c), used = true;
+                if (upper && fm.lt(c, hi[i]))
+                    fm.set(hi[i], c), used = true;
+                if (used)
+                    deps[i].push_back(l);
+            }
+        };
+
+        ptr_vector<expr> todo;
+        for (auto const& [root, bs] : term2bounds) {
+            todo.push_back(root);
+            while (!todo.empty()) {
+                expr* n = todo.back();
+                if (term2iv.contains(n)) {
+                    todo.pop_back();
+                    continue;
+                }
+                bool pending = false;
+                if (is_app(n) && to_app(n)->get_family_id() == get_id() && !m_fpa_util.is_numeral(n))
+                    for (expr* arg : *to_app(n))
+                        if (m_fpa_util.is_float(arg) && !term2iv.contains(arg))
+                            todo.push_back(arg), pending = true;
+                if (pending)
+                    continue;
+                todo.pop_back();
+                unsigned i = lo.size();
+                lo.push_back(t);
+                hi.push_back(t);
+                deps.push_back(sat::literal_vector());
+                term2iv.insert(n, i);
+                SASSERT(is_app(n) && m_fpa_util.is_float(n));
+                eval(to_app(n), i);
+                intersect(n, i);
+                if (fm.lt(hi[i], lo[i])) {
+                    sat::literal_vector lits;
+                    for (sat::literal l : deps[i])
+                        if (!lits.contains(~l))
+                            lits.push_back(~l);
+                    TRACE("fp", tout << "interval conflict on " << mk_bounded_pp(n, m) << "\n";);
+                    ++m_num_interval_conflicts;
+                    add_clause(lits);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+}
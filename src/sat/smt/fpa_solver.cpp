@@ -36,6 +36,7 @@ namespace fpa {
         params_ref p;
         p.set_bool("arith_lhs", true);
         m_th_rw.updt_params(p);
+        m_converter.set_lazy(get_config().m_fpa_lazy);
     }
 
     solver::~solver() {
@@ -86,9 +87,41 @@ namespace fpa {
         if (unit_propagate())
             return sat::check_result::CR_CONTINUE;
         SASSERT(m_nodes.size() <= m_nodes_qhead);
+        if (m_lazy_qhead < m_converter.lazy_ops().size() && check_intervals())
+            return sat::check_result::CR_CONTINUE;
+        if (blast_lazy_ops())
+            return sat::check_result::CR_CONTINUE;
         return sat::check_result::CR_DONE;
     }
 
+    /**
+       \brief add the circuits of the operations that were converted lazily.
+       The other constraints are satisfiable when the operations are treated
+       as unconstrained values; only then they are bit-blasted.
+     */
+    bool solver::blast_lazy_ops() {
+        expr_ref_vector const& ops = m_converter.lazy_ops();
+        if (m_lazy_qhead == ops.size())
+            return false;
+        ctx.push(value_trail<unsigned>(m_lazy_qhead));
+        for (; m_lazy_qhead < ops.size(); ++m_lazy_qhead) {
+            expr_ref def(m), lhs(m), rhs(m);
+            m_converter.mk_eager(to_app(ops.get(m_lazy_qhead)), def);
+            m_converter.join_fp(m_converter.lazy_values().get(m_lazy_qhead), lhs);
+            m_converter.join_fp(def, rhs);
+            m_th_rw(rhs);
+            add_unit(eq_internalize(lhs, rhs));
+            add_units(mk_side_conditions());
+            ++m_num_lazy;
+        }
+        return true;
+    }
+
+    void solver::collect_statistics(statistics& st) const {
+        st.update("fpa lazy ops", m_num_lazy);
+        st.update("fpa interval conflicts", m_num_interval_conflicts);
+    }
+
     void solver::attach_new_th_var(enode* n) {
         theory_var v = mk_var(n);
         ctx.attach_th_var(n, this, v);
@@ -315,6 +348,7 @@ namespace fpa {
             conds.push_back(l);
             add_clause(conds);
         }
+        add_bound(l);
     }
 
     void solver::add_value(euf::enode* n, model& mdl, expr_ref_vector& values) {
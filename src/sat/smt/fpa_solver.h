@@ -38,6 +38,10 @@ namespace fpa {
         obj_map<expr, expr*>      m_conversions;
         svector<std::tuple<enode*, bool, bool>> m_nodes;
         unsigned                  m_nodes_qhead = 0;
+        unsigned                  m_lazy_qhead = 0;
+        unsigned                  m_num_lazy = 0;
+        sat::literal_vector       m_bounds;          // asserted comparisons of terms with numerals
+        unsigned                  m_num_interval_conflicts = 0;
 
         bool visit(expr* e) override;
         bool visited(expr* e) override;
@@ -49,6 +53,12 @@ namespace fpa {
         void activate(expr* e);
         void unit_propagate(std::tuple<enode*, bool, bool> const& t);
         void ensure_equality_relation(theory_var x, theory_var y);      
+        bool blast_lazy_ops();
+
+        // fpa_interval.cpp
+        bool get_bound(expr* e, expr*& t, mpf& c, bool& lower, bool& upper);
+        void add_bound(sat::literal l);
+        bool check_intervals();
 
     public:
         solver(euf::solver& ctx);
@@ -72,7 +82,8 @@ namespace fpa {
 
         bool unit_propagate() override;
         void get_antecedents(sat::literal l, sat::ext_justification_idx idx, sat::literal_vector& r, bool probing) override { UNREACHABLE(); }
-      sat::check_result check() override;
+        sat::check_result check() override;
+        void collect_statistics(statistics& st) const override;
 
         euf::th_solver* clone(euf::solver& ctx) override { return alloc(solver, ctx); }
 
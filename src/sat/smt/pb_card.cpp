@@ -38,7 +38,7 @@ namespace pb {
     }
 
     bool card::is_watching(literal l) const {
-        unsigned sz = std::min(k() + 1, size());
+        unsigned sz = is_counting() ? size() : std::min(k() + 1, size());
         for (unsigned i = 0; i < sz; ++i) {
             if ((*this)[i] == l) return true;
         }
@@ -107,7 +107,7 @@ namespace pb {
     void card::clear_watch(solver_interface& s) {
         if (is_clear()) return;
         reset_watch();
-        unsigned sz = std::min(k() + 1, size());
+        unsigned sz = is_counting() ? size() : std::min(k() + 1, size());
         for (unsigned i = 0; i < sz; ++i) 
             unwatch_literal(s, (*this)[i]);        
     }
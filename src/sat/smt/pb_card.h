@@ -24,6 +24,7 @@ Author:
 namespace pb {
 
     class card : public constraint {
+        unsigned       m_counter { UINT_MAX };  // slot of the false literals when watched by counting
         literal        m_lits[0];
     public:
         static size_t get_obj_size(unsigned num_lits) { return sat::constraint_base::obj_size(sizeof(card) + num_lits * sizeof(literal)); }
@@ -34,6 +35,9 @@ namespace pb {
         literal const* end() const { return static_cast<literal const*>(m_lits) + m_size; }
         void negate() override;
         void swap(unsigned i, unsigned j) override { std::swap(m_lits[i], m_lits[j]); }
+        bool is_counting() const { return m_counter != UINT_MAX; }
+        unsigned counter() const { return m_counter; }
+        void set_counter(unsigned c) { m_counter = c; }
         literal_vector literals() const override { return literal_vector(m_size, m_lits); }
         bool is_watching(literal l) const override;
         literal get_lit(unsigned i) const override { return m_lits[i]; }
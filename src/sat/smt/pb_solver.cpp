@@ -1215,12 +1215,35 @@ namespace pb {
         return true;
     }
 
+    /*
+      \brief saturate the resolvent: a coefficient above the bound can
+      be reduced to the bound. Coefficients otherwise keep growing over
+      the resolution steps of cutting planes conflict analysis.
+     */
+    void solver::saturate() {
+        if (m_bound == 0)
+            return;
+        int64_t bound64 = m_bound;
+        for (bool_var v : m_active_vars) {
+            int64_t c = m_coeffs[v];
+            if (c > bound64) 
+                m_coeffs[v] = bound64;
+            else if (c < -bound64) 
+                m_coeffs[v] = -bound64;
+            else 
+                continue;
+            ++m_stats.m_num_saturate;
+        }
+    }
+
     /*
       \brief compute a cut for current resolvent.
      */
 
     void solver::cut() {
 
+        saturate();
+
         // bypass cut if there is a unit coefficient
         for (bool_var v : m_active_vars) {
             if (1 == get_abs_coeff(v)) return;
@@ -1234,16 +1257,6 @@ namespace pb {
             if (coeff == 0) {
                 continue;
             }
-            if (m_bound < coeff) {
-                int64_t bound64 = m_bound;
-                if (get_coeff(v) > 0) {
-                    m_coeffs[v] = bound64;
-                }
-                else {
-                    m_coeffs[v] = -bound64;
-                }
-                coeff = m_bound;
-            }
             SASSERT(0 < coeff && coeff <= m_bound);
             if (g == 0) {
                 g = coeff;
@@ -1423,7 +1436,18 @@ namespace pb {
 
 
     bool solver::init_watch(constraint& c) {
-        return !inconsistent() && c.init_watch(*this);
+        if (inconsistent())
+            return false;
+        if (c.is_card()) {
+            card& cd = c.to_card();
+            if (use_counting(cd))
+                return init_watch_counting(cd);
+            if (cd.is_counting()) {
+                cd.clear_watch(*this);
+                release_counting(cd);
+            }
+        }
+        return c.init_watch(*this);
     }
 
     lbool solver::add_assign(constraint& c, literal l) {
@@ -1695,6 +1719,8 @@ namespace pb {
 
     void solver::clear_watch(constraint& c) {
         c.clear_watch(*this);
+        if (c.is_card() && c.to_card().is_counting())
+            release_counting(c.to_card());
     }
 
     void solver::remove_constraint(constraint& c, char const* reason) {
@@ -1916,8 +1942,111 @@ namespace pb {
     }
 
 
+    /**
+       \brief large cardinality constraints that tolerate few false literals,
+       such as at-most-k constraints over many literals, are watched on all
+       literals. Watching k + 1 literals would then watch almost all of them,
+       and every assignment of a watched literal scans the constraint for it.
+       With counting, an assignment costs the number of false literals the
+       constraint tolerates. Reified constraints keep the watch scheme.
+    */
+    bool solver::use_counting(card const& c) const {
+        unsigned n = get_config().m_card_counting;
+        return n > 0 && c.lit() == sat::null_literal && c.size() >= n && 4 * (c.size() - c.k()) <= c.size();
+    }
+
+    void solver::release_counting(card& c) {
+        m_card_false[c.counter()].reset();
+        m_card_false_free.push_back(c.counter());
+        c.set_counter(UINT_MAX);
+    }
+
+    bool solver::init_watch_counting(card& c) {
+        SASSERT(c.k() < c.size());
+        if (!c.is_counting()) {
+            c.clear_watch(*this);
+            unsigned slot;
+            if (m_card_false_free.empty()) {
+                slot = m_card_false.size();
+                m_card_false.push_back(literal_vector());
+            }
+            else {
+                slot = m_card_false_free.back();
+                m_card_false_free.pop_back();
+            }
+            c.set_counter(slot);
+            for (literal l : c)
+                c.watch_literal(*this, l);
+        }
+        literal_vector& fs = m_card_false[c.counter()];
+        fs.reset();
+        literal alit = sat::null_literal;
+        for (literal l : c) {
+            if (value(l) == l_false) {
+                fs.push_back(l);
+                if (alit == sat::null_literal || lvl(alit) < lvl(l))
+                    alit = l;
+            }
+        }
+        if (fs.size() < c.size() - c.k())
+            return true;
+        propagate_counting(c, alit);
+        return false;
+    }
+
+    lbool solver::add_assign_counting(card& c, literal alit) {
+        literal_vector& fs = m_card_false[c.counter()];
+        unsigned j = 0;
+        bool found = false;
+        for (literal l : fs) {
+            if (value(l) != l_false)
+                continue;
+            found |= l == alit;
+            fs[j++] = l;
+        }
+        fs.shrink(j);
+        if (!found)
+            fs.push_back(alit);
+        if (fs.size() < c.size() - c.k())
+            return l_true;
+        return propagate_counting(c, alit);
+    }
+
+    /**
+       \brief the constraint has at least as many false literals as it
+       tolerates. Arrange the literals as the watch scheme does before
+       propagating, the non-false literals first and the false literals
+       last, so antecedents and conflict resolution read them off the
+       same positions. On a conflict alit, the most recent false literal,
+       is moved just before the false suffix.
+    */
+    lbool solver::propagate_counting(card& c, literal alit) {
+        unsigned sz = c.size(), bound = c.k(), j = 0;
+        for (unsigned i = 0; i < sz; ++i)
+            if (value(c[i]) != l_false && c[i] != alit)
+                c.swap(i, j++);
+        bool conflict = m_card_false[c.counter()].size() > sz - bound;
+        if (conflict) {
+            for (unsigned i = j; i < sz; ++i)
+                if (c[i] == alit) {
+                    c.swap(i, j++);
+                    break;
+                }
+            SASSERT(j <= bound);
+            TRACE("pb", display(tout << "counting conflict " << alit << " ", c, true););
+            set_conflict(c, alit);
+            return l_false;
+        }
+        SASSERT(j == bound);
+        for (unsigned i = 0; i < bound; ++i)
+            assign(c, c[i]);
+        return inconsistent() ? l_false : l_true;
+    }
+
     lbool solver::add_assign(card& c, literal alit) {
         // literal is assigned to false.        
+        if (c.is_counting())
+            return add_assign_counting(c, alit);
         unsigned sz = c.size();
         unsigned bound = c.k();
         TRACE("pb", tout << "assign: " << c.lit() << ": " << ~alit << "@" << lvl(~alit) << " " << c << "\n";);
@@ -3200,6 +3329,7 @@ namespace pb {
         st.update("pb conflicts", m_stats.m_num_conflicts);
         st.update("pb resolves", m_stats.m_num_resolves);
         st.update("pb cuts", m_stats.m_num_cut);
+        st.update("pb saturations", m_stats.m_num_saturate);
         st.update("pb gc", m_stats.m_num_gc);
         st.update("pb overflow", m_stats.m_num_overflow);
         st.update("pb big strengthenings", m_stats.m_num_big_strengthenings);
@@ -53,6 +53,7 @@ namespace pb {
             unsigned m_num_pb_subsumes;
             unsigned m_num_big_strengthenings;
             unsigned m_num_cut;
+            unsigned m_num_saturate;
             unsigned m_num_gc;
             unsigned m_num_overflow;
             unsigned m_num_lemmas;
@@ -92,6 +93,12 @@ namespace pb {
         unsigned               m_constraint_to_reinit_last_sz{ 0 };
         unsigned               m_constraint_id{ 0 };
 
+        // false literals of cardinality constraints watched by counting.
+        // A slot may hold literals that were unassigned since they were
+        // added; they are dropped when the constraint is next visited.
+        vector<literal_vector> m_card_false;
+        unsigned_vector        m_card_false_free;
+
         // conflict resolution
         unsigned          m_num_marks{ 0 };
         unsigned          m_conflict_lvl{ 0 };
@@ -216,6 +223,11 @@ namespace pb {
 
         // cardinality
         lbool add_assign(card& c, literal lit);
+        bool use_counting(card const& c) const;
+        bool init_watch_counting(card& c);
+        void release_counting(card& c);
+        lbool add_assign_counting(card& c, literal alit);
+        lbool propagate_counting(card& c, literal alit);
         void reset_coeffs();
         void reset_marked_literals();
         void get_antecedents(literal l, card const& c, literal_vector & r);
@@ -303,6 +315,7 @@ namespace pb {
         void process_antecedent(literal l, unsigned offset);
         void process_antecedent(literal l) { process_antecedent(l, 1); }
         void process_card(card& c, unsigned offset);
+        void saturate();
         void cut();
         bool create_asserting_lemma();
 
@@ -38,6 +38,10 @@ Done:
 #include "sat/smt/q_solver.h"
 #include "sat/smt/q_mam.h"
 #include "sat/smt/q_ematch.h"
+#include "util/thread_pool.h"
+#ifndef SINGLE_THREAD
+#include <atomic>
+#endif
 
 
 namespace q {
@@ -138,6 +142,8 @@ namespace q {
         for (unsigned i = 0; i < j.m_num_ex; ++i)
             ctx.add_explain(j.m_explain[i]);
         r.push_back(j.m_clause.m_literal);
+        if (!probing && ctx.get_config().m_qi_profile)
+            j.m_clause.m_stat->inc_num_conflicts();
     }
 
     quantifier_ref ematch::nnf_skolem(quantifier* q) {
@@ -324,6 +330,7 @@ namespace q {
         unsigned idx = m_q2clauses[q];
         clause& c = *m_clauses[idx];
         bool new_propagation = false;
+        c.m_stat->inc_num_matches();
         binding* b = alloc_binding(c, pat, _binding, max_generation, min_gen, max_gen);
         if (!b)
             return;
@@ -339,20 +346,35 @@ namespace q {
     }
 
     bool ematch::propagate(bool is_owned, euf::enode* const* binding, unsigned max_generation, clause& c, bool& propagated) {
+        return propagate(is_owned, binding, max_generation, c, propagated, nullptr);
+    }
+
+    /**
+    * Propagate a binding. If r is given, it holds the evaluation of the binding
+    * done by a shared evaluator, otherwise the binding is evaluated here.
+    */
+    bool ematch::propagate(bool is_owned, euf::enode* const* binding, unsigned max_generation, clause& c, bool& propagated, shared_eval const* r) {
         if (!m_enable_propagate)
             return false;
         if (ctx.s().inconsistent())
             return true;
         unsigned idx = UINT_MAX;
         m_evidence.reset();
-        lbool ev = m_eval(binding, c, idx, m_evidence);
+        lbool ev;
+        if (r) {
+            ev = r->m_value;
+            idx = r->m_idx;
+            m_evidence.append(r->m_evidence);
+        }
+        else 
+            ev = m_eval(binding, c, idx, m_evidence);
         if (ev == l_true) {
             ++m_stats.m_num_redundant;
             return true;
         }
         if (ev == l_undef && idx == UINT_MAX) {
             unsigned clause_idx = c.index();
-            for (euf::enode* n : m_eval.get_watch())
+            for (euf::enode* n : (r ? r->m_watch : m_eval.get_watch()))
                 add_watch(n, clause_idx);
             for (unsigned j = c.num_decls(); j-- > 0; )
                 add_watch(binding[j], clause_idx);
@@ -625,7 +647,7 @@ namespace q {
             return;
 
         do {                
-            if (propagate(true, b->m_nodes, b->m_max_generation, c, propagated)) 
+            if (propagate(true, b->m_nodes, b->m_max_generation, c, propagated, get_shared_eval(b))) 
                 to_remove.push_back(b);
             else if (flush) {
                 instantiate(*b);
@@ -645,10 +667,88 @@ namespace q {
     }
 
 
+    void ematch::collect_delayed(clause& c, ptr_vector<binding>& todo) {
+        binding* b = c.m_bindings;
+        if (!b)
+            return;
+        do {
+            todo.push_back(b);
+            b = b->next();
+        }
+        while (b != c.m_bindings);
+    }
+
+    /**
+    * Evaluate the delayed bindings that are about to be propagated on
+    * qi.threads threads. The egraph is not updated while they run, each
+    * thread has its own evaluator, and the main thread consumes the results
+    * through get_shared_eval in the same propagation round. Internalization,
+    * watches and justifications stay on the main thread.
+    */
+    void ematch::evaluate_shared(bool flush) {
+        m_shared_index.reset();
+        m_shared_results.reset();
+#ifndef SINGLE_THREAD
+        unsigned num_threads = ctx.get_config().m_qi_threads;
+        if (num_threads <= 1 || !m_enable_propagate || ctx.s().inconsistent())
+            return;
+        ptr_vector<binding> todo;
+        if (flush) {
+            for (clause* c : m_clauses)
+                collect_delayed(*c, todo);
+        }
+        else {
+            for (unsigned i = m_qhead; i < m_clause_queue.size(); ++i)
+                collect_delayed(*m_clauses[m_clause_queue[i]], todo);
+        }
+        if (todo.size() < m_min_shared_bindings)
+            return;
+        num_threads = std::min(num_threads, todo.size() / (m_min_shared_bindings / 4));
+        while (m_shared_evals.size() < num_threads)
+            m_shared_evals.push_back(alloc(eval, ctx, true));
+        m_shared_results.resize(todo.size());
+        std::atomic<unsigned> next(0);
+        std::atomic<bool> failed(false);
+        auto worker = [&](eval& ev) {
+            try {
+                unsigned i;
+                while (!failed && (i = next++) < todo.size()) {
+                    binding& b = *todo[i];
+                    shared_eval& r = m_shared_results[i];
+                    r.m_value = ev(b.m_nodes, *b.c, r.m_idx, r.m_evidence);
+                    r.m_deferred = ev.deferred();
+                    if (!r.m_deferred && r.m_value == l_undef && r.m_idx == UINT_MAX)
+                        r.m_watch.append(ev.get_watch());
+                }
+            }
+            catch (...) {
+                failed = true;
+            }
+        };
+        thread_pool::run(num_threads, [&](unsigned k) { worker(*m_shared_evals[k]); });
+        if (failed) {
+            m_shared_results.reset();
+            return;
+        }
+        for (unsigned i = 0; i < todo.size(); ++i)
+            if (!m_shared_results[i].m_deferred)
+                m_shared_index.insert(todo[i], i);
+        m_stats.m_num_shared_evals += m_shared_index.size();
+#endif
+    }
+
+    ematch::shared_eval const* ematch::get_shared_eval(binding* b) {
+        unsigned i;
+        if (m_shared_index.empty() || !m_shared_index.find(b, i))
+            return nullptr;
+        return &m_shared_results[i];
+    }
+
     bool ematch::propagate(bool flush) {
         m_mam->propagate();
         bool propagated = flush_prop_queue();
         if (flush) {
+            evaluate_shared(flush);
             for (auto* c : m_clauses)
                 propagate(*c, flush, propagated);
         }
@@ -656,12 +756,15 @@ namespace q {
             if (m_qhead >= m_clause_queue.size())
                 return m_inst_queue.propagate() || propagated;
             ctx.push(value_trail<unsigned>(m_qhead));
+            evaluate_shared(flush);
             for (; m_qhead < m_clause_queue.size() && m.inc(); ++m_qhead) {
                 unsigned idx = m_clause_queue[m_qhead];
                 clause& c = *m_clauses[idx];
                 propagate(c, flush, propagated);
             }
         }
+        m_shared_index.reset();
+        m_shared_results.reset();
         m_clause_in_queue.reset();
         m_node_in_queue.reset();
         m_in_queue_set = true;
@@ -702,6 +805,10 @@ namespace q {
         st.update("q unit propagations",     m_stats.m_num_propagations);
         st.update("q conflicts", m_stats.m_num_conflicts);
         st.update("q delayed bindings", m_stats.m_num_delayed_bindings);
+        st.update("q shared evaluations", m_stats.m_num_shared_evals);
+        if (ctx.get_config().m_qi_profile)
+            for (clause* c : m_clauses)
+                collect_profile(c->q(), *c->m_stat, st);
     }
 
     std::ostream& ematch::display(std::ostream& out) const {
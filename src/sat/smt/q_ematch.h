@@ -17,6 +17,7 @@ Author:
 #pragma once
 
 #include "util/nat_set.h"
+#include "util/scoped_ptr_vector.h"
 #include "ast/quantifier_stat.h"
 #include "ast/pattern/pattern_inference.h"
 #include "ast/normal_forms/nnf.h"
@@ -42,6 +43,7 @@ namespace q {
             unsigned m_num_conflicts;
             unsigned m_num_redundant;
             unsigned m_num_delayed_bindings;
+            unsigned m_num_shared_evals;
             
             stats() { reset(); }
 
@@ -57,6 +59,15 @@ namespace q {
             prop(bool is_conflict, unsigned idx, sat::ext_justification_idx j) : is_conflict(is_conflict), idx(idx), j(j) {}
         };
 
+        // evaluation of a delayed binding by a shared evaluator
+        struct shared_eval {
+            lbool                  m_value = l_undef;
+            unsigned               m_idx = UINT_MAX;
+            bool                   m_deferred = true;
+            euf::enode_pair_vector m_evidence;
+            euf::enode_vector      m_watch;
+        };
+
         struct remove_binding;
         struct insert_binding;
         struct pop_clause;
@@ -90,6 +101,10 @@ namespace q {
         unsigned_vector               m_clause_queue;
         euf::enode_pair_vector        m_evidence;
         bool                          m_enable_propagate = true;
+        scoped_ptr_vector<eval>       m_shared_evals;    // one per thread
+        vector<shared_eval>           m_shared_results;
+        ptr_addr_map<binding, unsigned> m_shared_index;  // binding -> position in m_shared_results
+        unsigned                      m_min_shared_bindings = 256;
 
         euf::enode* const* copy_nodes(clause& c, euf::enode* const* _binding);
         binding* tmp_binding(clause& c, app* pat, euf::enode* const* _binding);
@@ -123,6 +138,11 @@ namespace q {
 
         bool propagate(bool flush);
         void propagate(clause& c, bool flush, bool& propagated);
+        bool propagate(bool is_owned, euf::enode* const* binding, unsigned max_generation, clause& c, bool& propagated, shared_eval const* r);
+
+        void evaluate_shared(bool flush);
+        void collect_delayed(clause& c, ptr_vector<binding>& todo);
+        shared_eval const* get_shared_eval(binding* b);
 
         expr_ref_vector m_new_defs;
         proof_ref_vector m_new_proofs;
@@ -26,19 +26,39 @@ namespace q {
         eval& e;
         scoped_mark_reset(eval& e): e(e) {}
         ~scoped_mark_reset() { 
-            e.m_mark.reset(); 
+            e.reset_marks(); 
             e.m_diseq_undef = euf::enode_pair(); 
         }
     };
 
-    eval::eval(euf::solver& ctx):
+    eval::eval(euf::solver& ctx, bool shared):
         ctx(ctx),
         m(ctx.get_manager())
-    {}
+    {
+        if (shared)
+            m_shared_find = alloc(euf::egraph::shared_find, ctx.get_egraph());
+    }
+
+    void eval::reset_marks() {
+        if (++m_timestamp == 0) {
+            m_mark.fill(0);
+            m_timestamp = 1;
+        }
+    }
+
+    euf::enode* eval::find(expr* e, unsigned n, euf::enode* const* args) {
+        if (!m_shared_find)
+            return ctx.get_egraph().find(e, n, args);
+        euf::enode* r = nullptr;
+        if (!(*m_shared_find)(e, n, args, r))
+            m_deferred = true;
+        return r;
+    }
 
     lbool eval::operator()(euf::enode* const* binding, clause& c, unsigned& idx, euf::enode_pair_vector& evidence) {
         scoped_mark_reset _sr(*this);
         idx = UINT_MAX;
+        m_deferred = false;
         unsigned sz = c.m_lits.size();
         unsigned n = c.num_decls();
         m_indirect_nodes.reset();
@@ -53,13 +73,15 @@ namespace q {
                 m_indirect_nodes.shrink(lim);
                 if (!l.sign)
                     break;
-                c.m_watch = i;
+                if (!m_shared_find)
+                    c.m_watch = i;
                 return l_true;
             case l_true:   
                 m_indirect_nodes.shrink(lim);
                 if (l.sign)
                     break;                
-                c.m_watch = i;
+                if (!m_shared_find)
+                    c.m_watch = i;
                 return l_true;
             case l_undef:
                 if (idx != UINT_MAX) {
@@ -72,7 +94,8 @@ namespace q {
         }
         if (idx == UINT_MAX)
             return l_false;
-        c.m_watch = idx;
+        if (!m_shared_find)
+            c.m_watch = idx;
         return l_undef;
     }
 
@@ -184,7 +207,7 @@ namespace q {
     }
 
     euf::enode* eval::operator()(unsigned n, euf::enode* const* binding, expr* e, euf::enode_pair_vector& evidence) {
-        if (m_mark.is_marked(e))
+        if (is_marked(e))
             return m_eval[e->get_id()];
         if (is_ground(e))
             return ctx.get_egraph().find(e);
@@ -194,7 +217,7 @@ namespace q {
         while (!todo.empty()) {
             expr* t = todo.back();
             SASSERT(!is_ground(t) || ctx.get_egraph().find(t));
-            if (m_mark.is_marked(t)) {
+            if (is_marked(t)) {
                 todo.pop_back();
                 continue;
             }
@@ -202,7 +225,7 @@ namespace q {
                 m_eval.setx(t->get_id(), ctx.get_egraph().find(t), nullptr);                
                 if (!m_eval[t->get_id()])
                     return nullptr;
-                m_mark.mark(t);
+                mark(t);
                 todo.pop_back();
                 continue;
             }
@@ -212,7 +235,7 @@ namespace q {
                 m_eval.setx(t->get_id(), binding[n - 1 - to_var(t)->get_idx()], nullptr);
                 if (!m_eval[t->get_id()])
                     return nullptr;
-                m_mark.mark(t);
+                mark(t);
                 todo.pop_back();
                 continue;
             }
@@ -220,13 +243,13 @@ namespace q {
                 return nullptr;
             args.reset();
             for (expr* arg : *to_app(t)) {
-                if (m_mark.is_marked(arg))
+                if (is_marked(arg))
                     args.push_back(m_eval[arg->get_id()]);
                 else
                     todo.push_back(arg);
             }
             if (args.size() == to_app(t)->get_num_args()) {
-                euf::enode* n = ctx.get_egraph().find(t, args.size(), args.data());
+                euf::enode* n = find(t, args.size(), args.data());
                 if (!n)
                     return nullptr;
                 for (unsigned i = args.size(); i-- > 0; ) {
@@ -244,7 +267,7 @@ namespace q {
                 }
                 m_indirect_nodes.push_back(n);
                 m_eval.setx(t->get_id(), n, nullptr);
-                m_mark.mark(t);
+                mark(t);
                 todo.pop_back();
             }
         }
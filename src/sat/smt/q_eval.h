@@ -17,6 +17,7 @@ Author:
 #pragma once
 
 #include "ast/has_free_vars.h"
+#include "ast/euf/euf_egraph.h"
 #include "sat/smt/q_clause.h"
 
 namespace euf {
@@ -25,29 +26,47 @@ namespace euf {
 
 namespace q {
 
+    /**
+       Evaluation of clauses under a binding.
+
+       A shared evaluator only reads the egraph and the clause, so several
+       of them can run on different threads while the egraph is not updated.
+       It bails out, see deferred(), on lookups that would update the egraph.
+    */
     class eval {
         euf::solver&       ctx;
         ast_manager&       m;
-        expr_fast_mark1    m_mark;
+        unsigned_vector    m_mark;         // expr id -> timestamp of the evaluation that visited it
+        unsigned           m_timestamp = 1;
         euf::enode_vector  m_eval;
         euf::enode_vector  m_indirect_nodes;
         bool               m_freeze_swap = false;
         euf::enode_pair    m_diseq_undef;
         contains_vars      m_contains_vars;
+        scoped_ptr<euf::egraph::shared_find> m_shared_find;
+        bool               m_deferred = false;
 
         struct scoped_mark_reset;
 
+        bool is_marked(expr* e) const { return e->get_id() < m_mark.size() && m_mark[e->get_id()] == m_timestamp; }
+        void mark(expr* e) { m_mark.reserve(e->get_id() + 1, 0); m_mark[e->get_id()] = m_timestamp; }
+        void reset_marks();
+        euf::enode* find(expr* e, unsigned n, euf::enode* const* args);
+
         // compare s, t modulo binding
         lbool compare(unsigned n, euf::enode* const* binding, expr* s, expr* t, euf::enode_pair_vector& evidence);
         lbool compare_rec(unsigned n, euf::enode* const* binding, expr* s, expr* t, euf::enode_pair_vector& evidence);
         
     public:
-        eval(euf::solver& ctx);
+        eval(euf::solver& ctx, bool shared = false);
 
         lbool operator()(euf::enode* const* binding, clause& c, euf::enode_pair_vector& evidence);
         lbool operator()(euf::enode* const* binding, clause& c, unsigned& idx, euf::enode_pair_vector& evidence);
         euf::enode* operator()(unsigned n, euf::enode* const* binding, expr* e, euf::enode_pair_vector& evidence);
 
         euf::enode_vector const& get_watch() { return m_indirect_nodes; }
+
+        // the last evaluation of a shared evaluator was abandoned
+        bool deferred() const { return m_deferred; }
     };
 }
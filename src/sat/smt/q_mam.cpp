@@ -2871,7 +2871,11 @@ namespace q {
             unsigned lbl_id   = lbl->get_small_id();
             m_trees.reserve(lbl_id+1, nullptr);
             if (m_trees[lbl_id] == nullptr) {
-                m_trees[lbl_id] = m_compiler.mk_tree(qa, mp, first_idx, false);
+                // The candidates of a tree accumulate over all the merges and new
+                // enodes seen since the last call to match, and the same enode is
+                // often added several times. Filter them so that each pending enode
+                // is matched once per round.
+                m_trees[lbl_id] = m_compiler.mk_tree(qa, mp, first_idx, true);
                 SASSERT(m_trees[lbl_id]->expected_num_args() == p->get_num_args());
                 DEBUG_CODE(m_trees[lbl_id]->set_egraph(m_egraph););
                 ctx.push(mk_tree_trail(m_trees, lbl_id));
@@ -21,7 +21,11 @@ Author:
 namespace user_solver {
 
     solver::solver(euf::solver& ctx) :
-        th_euf_solver(ctx, symbol("user"), ctx.get_manager().mk_family_id("user"))
+        th_euf_solver(ctx, symbol("user"), ctx.get_manager().mk_family_id("user")),
+        m_batch_fixed(ctx.get_manager()),
+        m_batch_values(ctx.get_manager()),
+        m_batch_lhs(ctx.get_manager()),
+        m_batch_rhs(ctx.get_manager())
     {}
 
     solver::~solver() {
@@ -69,20 +73,36 @@ namespace user_solver {
         m_next_split_phase = phase;
     }
 
+    lbool solver::get_value_cb(expr* e) {
+        euf::enode* n = expr2enode(e);
+        if (!n || n->bool_var() == sat::null_bool_var)
+            return l_undef;
+        return s().value(n->bool_var());
+    }
+
+    void solver::push_trail_cb(trail* t) {
+        force_push();
+        ctx.get_trail_stack().push_ptr(t);
+    }
+
     sat::check_result solver::check() {
         if (!(bool)m_final_eh)
             return  sat::check_result::CR_DONE;
         unsigned sz = m_prop.size();
+        flush_batch();
         m_final_eh(m_user_context, this);
         return sz == m_prop.size() ? sat::check_result::CR_DONE : sat::check_result::CR_CONTINUE;
     }
 
     void solver::new_fixed_eh(euf::theory_var v, expr* value, unsigned num_lits, sat::literal const* jlits) {
-        if (!m_fixed_eh)
+        if (!m_fixed_eh && !m_batch_eh)
             return;
         force_push();
         m_id2justification.setx(v, sat::literal_vector(num_lits, jlits), sat::literal_vector());
-        m_fixed_eh(m_user_context, this, var2expr(v), value);
+        if (m_batch_eh)
+            m_batch_fixed.push_back(var2expr(v)), m_batch_values.push_back(value);
+        else
+            m_fixed_eh(m_user_context, this, var2expr(v), value);
     }
     
     bool solver::decide(sat::bool_var& var, lbool& phase) {
@@ -121,7 +141,7 @@ namespace user_solver {
     }
 
     void solver::asserted(sat::literal lit) {
-        if (!m_fixed_eh)
+        if (!m_fixed_eh && !m_batch_eh)
             return;
         force_push();
         auto* n = bool_var2enode(lit.var());
@@ -129,10 +149,20 @@ namespace user_solver {
         sat::literal_vector lits;
         lits.push_back(lit);
         m_id2justification.setx(v, lits, sat::literal_vector());
-        m_fixed_eh(m_user_context, this, var2expr(v), lit.sign() ? m.mk_false() : m.mk_true());
+        expr* value = lit.sign() ? m.mk_false() : m.mk_true();
+        if (m_batch_eh)
+            m_batch_fixed.push_back(var2expr(v)), m_batch_values.push_back(value);
+        else
+            m_fixed_eh(m_user_context, this, var2expr(v), value);
     }
     
     void solver::new_eq_eh(euf::th_eq const& eq) {
+        if (m_batch_eh) {
+            force_push();
+            m_batch_lhs.push_back(var2expr(eq.v1()));
+            m_batch_rhs.push_back(var2expr(eq.v2()));
+            return;
+        }
         if (!m_eq_eh)
             return;
         force_push();
@@ -153,7 +183,25 @@ namespace user_solver {
         m_push_eh(m_user_context, this);
     }
 
+    /**
+       \brief deliver the pending fixed and equality events in one call,
+       before the solver backtracks over them, before the final check,
+       and at the end of propagation.
+    */
+    void solver::flush_batch() {
+        if (!has_batch())
+            return;
+        expr_ref_vector fixed(m), values(m), lhs(m), rhs(m);
+        fixed.swap(m_batch_fixed);
+        values.swap(m_batch_values);
+        lhs.swap(m_batch_lhs);
+        rhs.swap(m_batch_rhs);
+        ++m_stats.m_num_batches;
+        m_batch_eh(m_user_context, this, fixed.size(), fixed.data(), values.data(), lhs.size(), lhs.data(), rhs.data());
+    }
+
     void solver::pop_core(unsigned num_scopes) {
+        flush_batch();
         th_euf_solver::pop_core(num_scopes);
         unsigned old_sz = m_prop_lim.size() - num_scopes;
         m_prop.shrink(m_prop_lim[old_sz]);
@@ -174,7 +222,7 @@ namespace user_solver {
     }
 
     bool solver::unit_propagate() {
-        if (m_qhead == m_prop.size())
+        if (m_qhead == m_prop.size() && !has_batch())
             return false;
         force_push();
         ctx.push(value_trail<unsigned>(m_qhead));
@@ -186,12 +234,17 @@ namespace user_solver {
             else
                 propagate_new_fixed(prop);
         }       
-        return np < m_stats.m_num_propagations;
+        unsigned sz = m_prop.size();
+        if (!s().inconsistent())
+            flush_batch();
+        return np < m_stats.m_num_propagations || sz < m_prop.size();
     }
 
     void solver::collect_statistics(::statistics& st) const {
         st.update("user-propagations", m_stats.m_num_propagations);
         st.update("user-watched", get_num_vars());
+        if (m_stats.m_num_batches > 0)
+            st.update("user-batches", m_stats.m_num_batches);
     }
 
     sat::justification solver::mk_justification(unsigned prop_idx) {
@@ -52,6 +52,7 @@ namespace user_solver {
 
         struct stats {
             unsigned m_num_propagations;
+            unsigned m_num_batches;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -66,6 +67,7 @@ namespace user_solver {
         user_propagator::eq_eh_t        m_diseq_eh = nullptr;
         user_propagator::created_eh_t   m_created_eh = nullptr;
         user_propagator::decide_eh_t    m_decide_eh = nullptr;
+        user_propagator::batch_eh_t     m_batch_eh = nullptr;
         user_propagator::context_obj*   m_api_context = nullptr;
         unsigned                        m_qhead = 0;
         vector<prop_info>               m_prop;
@@ -78,6 +80,8 @@ namespace user_solver {
         expr*                           m_next_split_expr = nullptr;
         unsigned                        m_next_split_idx;
         lbool                           m_next_split_phase;
+        expr_ref_vector                 m_batch_fixed, m_batch_values;   // fixed events not yet delivered
+        expr_ref_vector                 m_batch_lhs, m_batch_rhs;        // equality events not yet delivered
 
         struct justification {
             unsigned m_propagation_index { 0 };
@@ -97,6 +101,8 @@ namespace user_solver {
 
         void propagate_consequence(prop_info const& prop);
         void propagate_new_fixed(prop_info const& prop);
+        bool has_batch() const { return !m_batch_fixed.empty() || !m_batch_lhs.empty(); }
+        void flush_batch();
 
         void validate_propagation();
 
@@ -131,12 +137,15 @@ namespace user_solver {
         void register_diseq(user_propagator::eq_eh_t& diseq_eh) { m_diseq_eh = diseq_eh; }
         void register_created(user_propagator::created_eh_t& created_eh) { m_created_eh = created_eh; }
         void register_decide(user_propagator::decide_eh_t& decide_eh) { m_decide_eh = decide_eh; }
+        void register_batch(user_propagator::batch_eh_t& batch_eh) { m_batch_eh = batch_eh; }
 
-        bool has_fixed() const { return (bool)m_fixed_eh; }
+        bool has_fixed() const { return (bool)m_fixed_eh || (bool)m_batch_eh; }
 
         void propagate_cb(unsigned num_fixed, expr* const* fixed_ids, unsigned num_eqs, expr* const* lhs, expr* const* rhs, expr* conseq) override;
         void register_cb(expr* e) override;
         void next_split_cb(expr* e, unsigned idx, lbool phase) override;
+        lbool get_value_cb(expr* e) override;
+        void push_trail_cb(trail* t) override;
 
         void new_fixed_eh(euf::theory_var v, expr* value, unsigned num_lits, sat::literal const* jlits);
 
@@ -3,16 +3,17 @@ Copyright (c) 2014 Microsoft Corporation
 
 Module Name:
 
-    xor_solver.h
+    xor_solver.cpp
 
 Abstract:
 
     XOR solver.
-    Interface outline.
+    Gauss-Jordan elimination over xor constraints.
 
 --*/
 
 
+#include "util/mpz.h"
 #include "sat/smt/xor_solver.h"
 #include "sat/sat_simplifier_params.hpp"
 #include "sat/sat_xor_finder.h"
@@ -20,60 +21,474 @@ Abstract:
 namespace xr {
 
     solver::solver(euf::solver& ctx):
-        th_solver(ctx.get_manager(), symbol("xor-solver"), ctx.get_manager().get_family_id("xor-solver"))
+        th_solver(ctx.get_manager(), symbol("xor-solver"), ctx.get_manager().mk_family_id("xor-solver"))
+    {}
+
+    solver::solver(ast_manager& m, euf::theory_id id):
+        th_solver(m, symbol("xor-solver"), id)
     {}
 
     euf::th_solver* solver::clone(euf::solver& ctx) {
-        // and relevant copy internal state
+        // xors are extracted again from the clauses of the new solver
         return alloc(solver, ctx);
     }
 
-    void solver::asserted(sat::literal l) {
+    sat::extension* solver::copy(sat::solver* s) {
+        solver* result = alloc(solver, m, get_id());
+        result->set_solver(s);
+        return result;
+    }
 
+    /**
+       \brief release the matrix. Variables that were made external for
+       the matrix can again be eliminated.
+    */
+    void solver::reset_matrix() {
+        for (sat::bool_var v : m_made_external)
+            if (v < s().num_vars())
+                s().set_non_external(v);
+        m_made_external.reset();
+        m_matrix.reset(0);
+        m_num_cols = 0;
+        m_col2var.reset();
+        m_var2col.reset();
+        m_basic.reset();
+        m_watch1.reset();
+        m_watch2.reset();
+        m_watches.reset();
+        m_assigned.reset();
+        m_true.reset();
+        m_trail.reset();
+        m_col2pos.reset();
+        m_qhead = 0;
+        m_reasons.reset();
+        for (unsigned& lim : m_trail_lim)
+            lim = 0;
+        for (unsigned& lim : m_reasons_lim)
+            lim = 0;
+        m_dirty.reset();
+        m_is_dirty.reset();
+        m_row_visited.reset();
+        m_init = false;
     }
 
-    bool solver::unit_propagate() {
+    void solver::extract_xors(vector<sat::literal_vector>& xors) {
+        bool_vector was_external;
+        for (sat::bool_var v = 0; v < s().num_vars(); ++v)
+            was_external.push_back(s().is_external(v));
+        std::function<void(sat::literal_vector const&)> on_xor = [&](sat::literal_vector const& x) {
+            xors.push_back(x);
+        };
+        // the finder removes the clauses of the xors from the vector it is given
+        sat::clause_vector clauses(s().clauses());
+        sat::xor_finder xf(s());
+        xf.set(on_xor);
+        xf(clauses);
+        for (auto const& x : xors) {
+            for (sat::literal l : x) {
+                if (!was_external[l.var()]) {
+                    was_external[l.var()] = true;
+                    m_made_external.push_back(l.var());
+                }
+            }
+        }
+    }
+
+    /**
+       \brief build the matrix of xors: the xor of the literals of each
+       xor is true. Bring it to reduced form and propagate the assignment
+       at the base level.
+    */
+    void solver::build_matrix(vector<sat::literal_vector> const& xors) {
+        m_var2col.resize(s().num_vars(), UINT_MAX);
+        for (auto const& x : xors) {
+            for (sat::literal l : x) {
+                if (m_var2col[l.var()] == UINT_MAX) {
+                    m_var2col[l.var()] = m_col2var.size();
+                    m_col2var.push_back(l.var());
+                }
+            }
+        }
+        m_num_cols = m_col2var.size();
+        m_matrix.reset(m_num_cols + 1);
+        m_assigned.resize(num_chunks(), 0);
+        m_true.resize(num_chunks(), 0);
+        m_assigned[m_num_cols >> 6] |= 1ull << (m_num_cols & 63);
+        for (auto const& x : xors) {
+            auto row = m_matrix.add_row();
+            bool parity = true;
+            for (sat::literal l : x) {
+                row.set(m_var2col[l.var()]);
+                parity ^= l.sign();
+            }
+            row.set(m_num_cols, parity);
+        }
+        unsigned num_rows = m_matrix.num_rows();
+        m_basic.resize(num_rows, UINT_MAX);
+        m_watch1.resize(num_rows, UINT_MAX);
+        m_watch2.resize(num_rows, UINT_MAX);
+        m_is_dirty.resize(num_rows, false);
+        m_row_visited.resize(num_rows, 0);
+        m_watches.resize(m_num_cols);
+        m_col2pos.resize(m_num_cols, 0);
+
+        for (unsigned r = 0; r < num_rows; ++r) {
+            auto row = m_matrix.get_row(r);
+            auto it = row.begin();
+            if (it == row.end())
+                continue;
+            if (*it == m_num_cols) {
+                s().set_conflict(sat::justification(0));
+                return;
+            }
+            pivot(r, *it);
+        }
+        for (unsigned r : m_dirty)
+            m_is_dirty[r] = false;
+        m_dirty.reset();
+
+        for (unsigned c = 0; c < m_num_cols; ++c) {
+            lbool val = s().value(m_col2var[c]);
+            if (val != l_undef)
+                assign_col(c, val == l_true);
+        }
+        m_qhead = m_trail.size();
+        for (unsigned r = 0; r < num_rows; ++r)
+            if (m_basic[r] != UINT_MAX)
+                ++m_stats.m_num_rows, update_row(r);
+        update_dirty();
+        m_stats.m_num_xors += xors.size();
+        IF_VERBOSE(10, verbose_stream() << "(sat.xor :xors " << xors.size() << " :vars " << m_num_cols << ")\n");
+    }
+
+    void solver::init_matrix() {
+        if (!s().at_base_lvl())
+            s().pop_to_base_level();
+        reset_matrix();
+        m_init = true;
+        if (s().inconsistent() || s().get_config().m_drat)
+            return;
+        vector<sat::literal_vector> xors;
+        extract_xors(xors);
+        if (!xors.empty())
+            build_matrix(xors);
+    }
+
+    void solver::assign_col(unsigned c, bool value) {
+        m_assigned[c >> 6] |= 1ull << (c & 63);
+        if (value)
+            m_true[c >> 6] |= 1ull << (c & 63);
+        m_col2pos[c] = m_trail.size();
+        m_trail.push_back(c);
+    }
+
+    /**
+       \brief make c the basic column of row r and eliminate it from all
+       other rows.
+    */
+    void solver::pivot(unsigned r, unsigned c) {
+        ++m_stats.m_num_pivots;
+        m_basic[r] = c;
+        auto row = m_matrix.get_row(r);
+        for (unsigned r2 = 0; r2 < m_matrix.num_rows(); ++r2) {
+            if (r2 == r)
+                continue;
+            auto row2 = m_matrix.get_row(r2);
+            if (!row2[c])
+                continue;
+            row2 += row;
+            if (!m_is_dirty[r2]) {
+                m_is_dirty[r2] = true;
+                m_dirty.push_back(r2);
+            }
+        }
+    }
+
+    void solver::set_watches(unsigned r, unsigned w1, unsigned w2) {
+        unsigned o1 = m_watch1[r], o2 = m_watch2[r];
+        if (w1 != UINT_MAX && w1 != o1 && w1 != o2)
+            m_watches[w1].push_back(r);
+        if (w2 != UINT_MAX && w2 != o1 && w2 != o2)
+            m_watches[w2].push_back(r);
+        m_watch1[r] = w1;
+        m_watch2[r] = w2;
+    }
+
+    /**
+       \brief the assigned column of the row that was assigned last,
+       other than the given column.
+    */
+    unsigned solver::latest(bit_matrix::row const& row, unsigned other) {
+        uint64_t const* d = row.data();
+        unsigned result = UINT_MAX;
+        for (unsigned k = 0; k < num_chunks(); ++k) {
+            for (uint64_t u = d[k] & m_assigned[k]; u != 0; u &= u - 1) {
+                unsigned c = 64 * k + trailing_zeros(u);
+                if (c == m_num_cols || c == other)
+                    continue;
+                if (result == UINT_MAX || m_col2pos[c] > m_col2pos[result])
+                    result = c;
+            }
+        }
+        return result;
+    }
+
+    /**
+       \brief restore the invariants of row r for the current assignment:
+       a row with two unassigned columns has an unassigned basic column
+       and watches two unassigned columns. Otherwise the row propagates
+       its last unassigned column or is in conflict, and watches the
+       columns that become unassigned first on backtracking.
+    */
+    bool solver::update_row(unsigned r) {
+        unsigned b = m_basic[r];
+        if (b == UINT_MAX)
+            return true;
+        auto row = m_matrix.get_row(r);
+        uint64_t const* d = row.data();
+        unsigned u1 = UINT_MAX, u2 = UINT_MAX;
+        bool parity = row[m_num_cols];
+        for (unsigned k = 0; k < num_chunks(); ++k) {
+            parity ^= (get_num_1bits(d[k] & m_true[k]) & 1) != 0;
+            for (uint64_t u = d[k] & ~m_assigned[k]; u != 0 && u2 == UINT_MAX; u &= u - 1) {
+                unsigned c = 64 * k + trailing_zeros(u);
+                if (u1 == UINT_MAX)
+                    u1 = c;
+                else
+                    u2 = c;
+            }
+        }
+        if (u2 != UINT_MAX) {
+            if (is_assigned(b)) {
+                pivot(r, u1);
+                b = u1;
+            }
+            set_watches(r, b, b == u1 ? u2 : u1);
+            return true;
+        }
+        if (u1 != UINT_MAX) {
+            set_watches(r, u1, latest(row, u1));
+            if (!s().inconsistent())
+                propagate(r, sat::literal(m_col2var[u1], !parity));
+            return true;
+        }
+        unsigned w1 = latest(row, UINT_MAX);
+        set_watches(r, w1, latest(row, w1));
+        if (!parity)
+            return true;
+        if (!s().inconsistent())
+            set_conflict(r, ~true_literal(w1));
         return false;
     }
-    
+
+    void solver::update_dirty() {
+        while (!m_dirty.empty()) {
+            unsigned r = m_dirty.back();
+            m_dirty.pop_back();
+            m_is_dirty[r] = false;
+            update_row(r);
+        }
+    }
+
+    size_t solver::mk_reason(unsigned r) {
+        size_t idx = m_reasons.size();
+        uint64_t const* d = m_matrix.get_row(r).data();
+        for (unsigned k = 0; k < num_chunks(); ++k)
+            m_reasons.push_back(d[k]);
+        return idx;
+    }
+
+    void solver::propagate(unsigned r, sat::literal lit) {
+        switch (s().value(lit)) {
+        case l_true:
+            break;
+        case l_false:
+            set_conflict(r, lit);
+            break;
+        default:
+            ++m_stats.m_num_propagations;
+            if (s().at_base_lvl())
+                s().assign_unit(lit);
+            else
+                s().assign(lit, sat::justification::mk_ext_justification(s().scope_lvl(), mk_reason(r)));
+            break;
+        }
+    }
+
+    /**
+       \brief row r implies lit, which is false.
+    */
+    void solver::set_conflict(unsigned r, sat::literal lit) {
+        ++m_stats.m_num_conflicts;
+        TRACE("xor", tout << "conflict " << lit << " row " << m_matrix.get_row(r) << "\n";);
+        if (s().at_base_lvl())
+            s().set_conflict(sat::justification(0));
+        else
+            s().set_conflict(sat::justification::mk_ext_justification(s().scope_lvl(), mk_reason(r)), ~lit);
+    }
+
+    void solver::asserted(sat::literal l) {
+        sat::bool_var v = l.var();
+        if (v >= m_var2col.size())
+            return;
+        unsigned c = m_var2col[v];
+        if (c == UINT_MAX || is_assigned(c))
+            return;
+        assign_col(c, !l.sign());
+    }
+
+    bool solver::unit_propagate() {
+        if (m_qhead == m_trail.size())
+            return false;
+        while (m_qhead < m_trail.size() && !s().inconsistent()) {
+            unsigned c = m_trail[m_qhead++];
+            if (++m_visited_ts == 0) {
+                m_row_visited.fill(0);
+                m_visited_ts = 1;
+            }
+            auto& ws = m_watches[c];
+            unsigned i = 0, j = 0, sz = ws.size();
+            for (; i < sz && !s().inconsistent(); ++i) {
+                unsigned r = ws[i];
+                if (m_row_visited[r] == m_visited_ts || (m_watch1[r] != c && m_watch2[r] != c))
+                    continue;
+                m_row_visited[r] = m_visited_ts;
+                update_row(r);
+                if (m_watch1[r] == c || m_watch2[r] == c)
+                    ws[j++] = r;
+            }
+            for (; i < sz; ++i)
+                ws[j++] = ws[i];
+            ws.shrink(j);
+            update_dirty();
+        }
+        return true;
+    }
+
     void solver::get_antecedents(sat::literal l, sat::ext_justification_idx idx,
                                  sat::literal_vector & r, bool probing) {
-        
+        uint64_t const* d = m_reasons.data() + idx;
+        for (unsigned k = 0; k < num_chunks(); ++k) {
+            for (uint64_t u = d[k]; u != 0; u &= u - 1) {
+                unsigned c = 64 * k + trailing_zeros(u);
+                if (c == m_num_cols || m_col2var[c] == l.var())
+                    continue;
+                SASSERT(s().value(m_col2var[c]) != l_undef);
+                r.push_back(true_literal(c));
+            }
+        }
     }
-    
+
+    /**
+       \brief rows that were not visited after their last assignment are
+       checked against the final assignment.
+    */
     sat::check_result solver::check() {
+        for (unsigned r = 0; r < m_basic.size(); ++r) {
+            if (m_basic[r] == UINT_MAX)
+                continue;
+            auto row = m_matrix.get_row(r);
+            bool parity = row[m_num_cols], is_assigned = true;
+            unsigned last = UINT_MAX;
+            for (unsigned c : row) {
+                if (c == m_num_cols)
+                    continue;
+                is_assigned &= s().value(m_col2var[c]) != l_undef;
+                parity ^= s().value(m_col2var[c]) == l_true;
+                last = c;
+            }
+            if (is_assigned && parity) {
+                set_conflict(r, ~true_literal(last));
+                return sat::check_result::CR_CONTINUE;
+            }
+        }
         return sat::check_result::CR_DONE;
     }
-    
+
     void solver::push() {
+        m_trail_lim.push_back(m_trail.size());
+        m_reasons_lim.push_back(m_reasons.size());
     }
-    
+
     void solver::pop(unsigned n) {
+        unsigned new_lim = m_trail_lim.size() - n;
+        unsigned new_lvl = s().scope_lvl() - n;
+        unsigned j = m_trail_lim[new_lim];
+        for (unsigned i = j; i < m_trail.size(); ++i) {
+            unsigned c = m_trail[i];
+            sat::bool_var v = m_col2var[c];
+            if (s().value(v) != l_undef && s().lvl(v) <= new_lvl) {
+                // the sat solver replays assignments below the new level
+                m_col2pos[c] = j;
+                m_trail[j++] = c;
+                continue;
+            }
+            m_assigned[c >> 6] &= ~(1ull << (c & 63));
+            m_true[c >> 6] &= ~(1ull << (c & 63));
+        }
+        m_trail.shrink(j);
+        m_qhead = std::min(m_qhead, j);
+        m_trail_lim.shrink(new_lim);
+        m_reasons.shrink(m_reasons_lim[new_lim]);
+        m_reasons_lim.shrink(new_lim);
+    }
+
+    void solver::init_search() {
+        if (!m_init)
+            init_matrix();
+    }
+
+    void solver::gc_vars(unsigned num_vars) {
+        for (sat::bool_var v : m_col2var) {
+            if (v >= num_vars) {
+                reset_matrix();
+                return;
+            }
+        }
     }
 
     // inprocessing
-    // pre_simplify: decompile all xor constraints to allow other in-processing.
-    // simplify: recompile clauses to xor constraints
-    // literals that get added to xor constraints are tagged with the theory.
+    // pre_simplify: release the matrix so the simplifier can eliminate its variables.
+    // simplify: extract the xors again from the simplified clauses.
     void solver::pre_simplify() {
-        
+        reset_matrix();
     }
 
     void solver::simplify() {
-        
+        init_matrix();
     }
 
     std::ostream& solver::display(std::ostream& out) const {
+        for (unsigned r = 0; r < m_basic.size(); ++r) {
+            if (m_basic[r] == UINT_MAX)
+                continue;
+            auto row = const_cast<bit_matrix&>(m_matrix).get_row(r);
+            bool first = true;
+            for (unsigned c : row) {
+                if (c == m_num_cols)
+                    continue;
+                out << (first ? "" : " + ") << (c == m_basic[r] ? "*" : "") << m_col2var[c];
+                first = false;
+            }
+            out << " = " << row[m_num_cols] << "\n";
+        }
         return out;
     }
-    
+
     std::ostream& solver::display_justification(std::ostream& out, sat::ext_justification_idx idx) const  {
-        return out;
+        return out << "xor row";
     }
-    
+
     std::ostream& solver::display_constraint(std::ostream& out, sat::ext_constraint_idx idx) const {
-        return out;
+        return out << "xor row";
     }
-    
-}
 
+    void solver::collect_statistics(statistics& st) const {
+        st.update("xor constraints", m_stats.m_num_xors);
+        st.update("xor rows", m_stats.m_num_rows);
+        st.update("xor propagations", m_stats.m_num_propagations);
+        st.update("xor conflicts", m_stats.m_num_conflicts);
+        st.update("xor pivots", m_stats.m_num_pivots);
+    }
+
+}
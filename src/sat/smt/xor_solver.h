@@ -8,20 +8,92 @@ Module Name:
 Abstract:
 
     XOR solver.
-    Interface outline.
+
+    Gauss-Jordan elimination over the xor constraints that are
+    extracted from the clauses of the sat solver.
+
+    The xors are rows of a bit-matrix, the last column holds their
+    parity. The matrix is kept in reduced form: every non-empty row has
+    a basic column that occurs in no other row. While the row has at
+    least two unassigned variables its basic variable is unassigned;
+    when the basic variable gets assigned, the row pivots on another
+    unassigned column and is added to the rows containing it. A row
+    watches two of its columns, the basic column and a second unassigned
+    column, and propagates its last unassigned variable or a conflict.
+    The explanation of a propagation is a copy of the row at the time of
+    the propagation, since later pivots change the row.
+
+    Rows are linear combinations of the xors, so the matrix is not
+    restored on backtracking.
 
 --*/
 
 #pragma once
 
 #include "sat/smt/euf_solver.h"
+#include "math/simplex/bit_matrix.h"
 
 namespace xr {
     class solver : public euf::th_solver {
+
+        struct stats {
+            unsigned m_num_xors;
+            unsigned m_num_rows;
+            unsigned m_num_propagations;
+            unsigned m_num_conflicts;
+            unsigned m_num_pivots;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
+        bit_matrix              m_matrix;
+        unsigned                m_num_cols = 0;      // column m_num_cols is the parity
+        unsigned_vector         m_col2var;
+        unsigned_vector         m_var2col;
+        sat::bool_var_vector         m_made_external;     // variables that are external only for the matrix
+        unsigned_vector         m_basic;             // row -> basic column, UINT_MAX for empty rows
+        unsigned_vector         m_watch1, m_watch2;  // row -> watched columns
+        vector<unsigned_vector> m_watches;           // column -> rows watching it
+        svector<uint64_t>       m_assigned;          // columns with an assigned variable, includes the parity column
+        svector<uint64_t>       m_true;              // columns with a true variable
+        unsigned_vector         m_trail;             // assigned columns
+        unsigned_vector         m_trail_lim;
+        unsigned_vector         m_col2pos;           // position of assigned column in m_trail
+        unsigned                m_qhead = 0;
+        svector<uint64_t>       m_reasons;           // copies of rows that propagated
+        unsigned_vector         m_reasons_lim;
+        unsigned_vector         m_dirty;             // rows changed by a pivot
+        bool_vector             m_is_dirty;
+        unsigned_vector         m_row_visited;
+        unsigned                m_visited_ts = 0;
+        bool                    m_init = false;      // xors were extracted from the current clauses
+        stats                   m_stats;
+
+        unsigned num_chunks() const { return m_matrix.num_chunks(); }
+        bool is_assigned(unsigned c) const { return (m_assigned[c >> 6] & (1ull << (c & 63))) != 0; }
+        bool is_true(unsigned c) const { return (m_true[c >> 6] & (1ull << (c & 63))) != 0; }
+        sat::literal true_literal(unsigned c) { return sat::literal(m_col2var[c], s().value(m_col2var[c]) == l_false); }
+
+        void reset_matrix();
+        void extract_xors(vector<sat::literal_vector>& xors);
+        void build_matrix(vector<sat::literal_vector> const& xors);
+        void init_matrix();
+        void assign_col(unsigned c, bool value);
+        void pivot(unsigned r, unsigned c);
+        void set_watches(unsigned r, unsigned w1, unsigned w2);
+        bool update_row(unsigned r);
+        void update_dirty();
+        size_t mk_reason(unsigned r);
+        void propagate(unsigned r, sat::literal lit);
+        void set_conflict(unsigned r, sat::literal lit);
+        unsigned latest(bit_matrix::row const& row, unsigned other);
+
     public:
         solver(euf::solver& ctx);
-        
+        solver(ast_manager& m, euf::theory_id id);
+
         th_solver* clone(euf::solver& ctx) override;
+        sat::extension* copy(sat::solver* s) override;
 
         sat::literal internalize(expr* e, bool sign, bool root)  override { UNREACHABLE(); return sat::null_literal; }
 
@@ -35,13 +107,18 @@ namespace xr {
         void pre_simplify() override;
         void simplify() override;
 
+        void init_search() override;
         sat::check_result check() override;
         void push() override;
         void pop(unsigned n) override;
+        void user_push() override {}
+        void user_pop(unsigned n) override { reset_matrix(); }
+        void gc_vars(unsigned num_vars) override;
 
         std::ostream& display(std::ostream& out) const override;
         std::ostream& display_justification(std::ostream& out, sat::ext_justification_idx idx) const override;
         std::ostream& display_constraint(std::ostream& out, sat::ext_constraint_idx idx) const override;
+        void collect_statistics(statistics& st) const override;
 
     };
 
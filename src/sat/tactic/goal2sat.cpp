@@ -44,17 +44,21 @@ Notes:
 #include "sat/smt/pb_solver.h"
 #include "sat/smt/euf_solver.h"
 #include "sat/smt/sat_th.h"
+#include "sat/smt/xor_solver.h"
 #include "sat/sat_params.hpp"
 #include<sstream>
 
 struct goal2sat::imp : public sat::sat_internalizer {
+    // polarities in which a connective occurs
+    static const unsigned pol_pos = 1, pol_neg = 2, pol_both = 3;
     struct frame {
         app *    m_t;
         unsigned m_root:1;
         unsigned m_sign:1;
+        unsigned m_pol:2;
         unsigned m_idx;
-        frame(app * t, bool r, bool s, unsigned idx):
-            m_t(t), m_root(r), m_sign(s), m_idx(idx) {}
+        frame(app * t, bool r, bool s, unsigned idx, unsigned pol):
+            m_t(t), m_root(r), m_sign(s), m_pol(pol), m_idx(idx) {}
     };
     ast_manager &               m;
     pb_util                     pb;
@@ -62,6 +66,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
     svector<sat::literal>       m_result_stack;
     obj_map<app, sat::literal>  m_app2lit;
     u_map<app*>                 m_lit2app;
+    obj_map<app, unsigned>      m_app2pol;     // polarity of cached connectives that are defined in one direction only
     unsigned_vector             m_cache_lim;
     app_ref_vector              m_cache_trail;
     obj_hashtable<expr>         m_interface_vars;
@@ -75,6 +80,8 @@ struct goal2sat::imp : public sat::sat_internalizer {
     func_decl_ref_vector        m_unhandled_funs;
     bool                        m_default_external;
     bool                        m_euf = false;
+    bool                        m_polarity = false;
+    bool                        m_xor_solver = false;
     bool                        m_top_level = false;
     sat::literal_vector         aig_lits;
     
@@ -100,6 +107,31 @@ struct goal2sat::imp : public sat::sat_internalizer {
         m_ite_extra  = p.get_bool("ite_extra", true);
         m_max_memory = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         m_euf = sp.euf();
+        m_polarity = sp.cnf_polarity();
+        m_xor_solver = sp.xor_solver();
+    }
+
+    bool use_polarity() const { return m_polarity && !m_euf; }
+
+    static unsigned flip(unsigned pol) { return ((pol & pol_pos) << 1) | ((pol & pol_neg) >> 1); }
+
+    // polarity of the idx'th argument of t, where t occurs in polarity pol
+    unsigned arg_pol(app* t, unsigned idx, unsigned pol) const {
+        if (pol == pol_both || t->get_family_id() != m.get_basic_family_id())
+            return pol_both;
+        switch (t->get_decl_kind()) {
+        case OP_OR:
+        case OP_AND:
+            return pol;
+        case OP_NOT:
+            return flip(pol);
+        case OP_IMPLIES:
+            return idx == 0 ? flip(pol) : pol;
+        case OP_ITE:
+            return idx == 0 ? pol_both : pol;
+        default:
+            return pol_both;
+        }
     }
 
     void throw_op_not_handled(std::string const& s) {
@@ -252,6 +284,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
             if (m_app2lit.find(t, lit)) {
                 m_app2lit.remove(t);
                 m_lit2app.remove(lit.index());
+                m_app2pol.remove(t);
             }
         }
         m_cache_trail.shrink(k);
@@ -264,6 +297,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         if (m_lit2app.find(lit.index(), t)) {
             m_lit2app.remove(lit.index());
             m_app2lit.remove(t);
+            m_app2pol.remove(t);
         }     
     }
 
@@ -276,6 +310,12 @@ struct goal2sat::imp : public sat::sat_internalizer {
         m_cache_trail.push_back(t);
     }
 
+    void cache(app* t, sat::literal l, unsigned pol) {
+        cache(t, l);
+        if (pol != pol_both)
+            m_app2pol.insert(t, pol);
+    }
+
     bool is_cached(app* t, sat::literal l) const override {
         if (!m_app2lit.contains(t))
             return false;
@@ -338,7 +378,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
 
     bool convert_app(app* t, bool root, bool sign) {
         if (!m_euf && pb.is_pb(t)) {
-            m_frame_stack.push_back(frame(to_app(t), root, sign, 0));
+            m_frame_stack.push_back(frame(to_app(t), root, sign, 0, pol_both));
             return false;
         }
         else {
@@ -347,10 +387,19 @@ struct goal2sat::imp : public sat::sat_internalizer {
         }
     }
 
-    bool process_cached(app* t, bool root, bool sign) {
+    bool process_cached(app* t, bool root, bool sign, unsigned pol = pol_both) {
         sat::literal l = sat::null_literal;
         if (!m_app2lit.find(t, l))
             return false;
+        unsigned cached_pol;
+        if (m_app2pol.find(t, cached_pol) && (pol & ~cached_pol) != 0) {
+            // the definition of l lacks a direction. The clauses that use l
+            // only need the direction it has, so t gets a new definition.
+            m_app2lit.remove(t);
+            m_lit2app.remove(l.index());
+            m_app2pol.remove(t);
+            return false;
+        }
         if (sign)
             l.neg();
         if (root)
@@ -360,13 +409,13 @@ struct goal2sat::imp : public sat::sat_internalizer {
         return true;
     }
 
-    bool visit(expr * t, bool root, bool sign) {
+    bool visit(expr * t, bool root, bool sign, unsigned pol) {
         SASSERT(m.is_bool(t));
         if (!is_app(t)) {
             convert_atom(t, root, sign);
             return true;
         }
-        if (process_cached(to_app(t), root, sign))
+        if (process_cached(to_app(t), root, sign, pol))
             return true;
         if (to_app(t)->get_family_id() != m.get_basic_family_id()) 
             return convert_app(to_app(t), root, sign);   
@@ -377,11 +426,11 @@ struct goal2sat::imp : public sat::sat_internalizer {
         case OP_ITE:
         case OP_XOR:
         case OP_IMPLIES:
-            m_frame_stack.push_back(frame(to_app(t), root, sign, 0));
+            m_frame_stack.push_back(frame(to_app(t), root, sign, 0, pol));
             return false;
         case OP_EQ:            
             if (m.is_bool(to_app(t)->get_arg(1))) {
-                m_frame_stack.push_back(frame(to_app(t), root, sign, 0));
+                m_frame_stack.push_back(frame(to_app(t), root, sign, 0, pol_both));
                 return false;
             }
             else {
@@ -404,7 +453,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         }
     }
 
-    void convert_or(app * t, bool root, bool sign) {
+    void convert_or(app * t, bool root, bool sign, unsigned pol) {
         TRACE("goal2sat", tout << "convert_or:\n" << mk_bounded_pp(t, m, 2) << " root " << root << " stack " << m_result_stack.size() << "\n";);        
         unsigned num = t->get_num_args();
         SASSERT(num <= m_result_stack.size());
@@ -425,27 +474,31 @@ struct goal2sat::imp : public sat::sat_internalizer {
             m_result_stack.shrink(old_sz);
         }
         else {
-            if (process_cached(t, root, sign))
+            if (process_cached(t, root, sign, pol))
                 return;
             SASSERT(num <= m_result_stack.size());
             sat::bool_var k = add_var(false, t);
             sat::literal  l(k, false);
-            cache(t, l);
+            cache(t, l, pol);
             sat::literal * lits = m_result_stack.end() - num;       
-            for (unsigned i = 0; i < num; i++) 
-                mk_clause(~lits[i], l, mk_tseitin(~lits[i], l));
+            if (pol & pol_neg)
+                for (unsigned i = 0; i < num; i++) 
+                    mk_clause(~lits[i], l, mk_tseitin(~lits[i], l));
                        
-            m_result_stack.push_back(~l);
-            lits = m_result_stack.end() - num - 1;
-            if (aig()) {
-                aig_lits.reset();
-                aig_lits.append(num, lits);
+            if (pol & pol_pos) {
+                m_result_stack.push_back(~l);
+                lits = m_result_stack.end() - num - 1;
+                bool use_aig = aig() && pol == pol_both;
+                if (use_aig) {
+                    aig_lits.reset();
+                    aig_lits.append(num, lits);
+                }
+                // remark: mk_clause may perform destructive updated to lits.
+                // I have to execute it after the binary mk_clause above.
+                mk_clause(num+1, lits, mk_tseitin(num+1, lits));
+                if (use_aig) 
+                    aig()->add_or(l, num, aig_lits.data());
             }
-            // remark: mk_clause may perform destructive updated to lits.
-            // I have to execute it after the binary mk_clause above.
-            mk_clause(num+1, lits, mk_tseitin(num+1, lits));
-            if (aig()) 
-                aig()->add_or(l, num, aig_lits.data());
                         
             m_solver.set_phase(~l);               
             m_result_stack.shrink(old_sz);
@@ -455,7 +508,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         }
     }
 
-    void convert_and(app * t, bool root, bool sign) {
+    void convert_and(app * t, bool root, bool sign, unsigned pol) {
         TRACE("goal2sat", tout << "convert_and:\n" << mk_bounded_pp(t, m, 2) << " root: " << root  << " result stack: " << m_result_stack.size() << "\n";);
 
         unsigned num = t->get_num_args();
@@ -476,32 +529,37 @@ struct goal2sat::imp : public sat::sat_internalizer {
             m_result_stack.shrink(old_sz);
         }
         else {
-            if (process_cached(t, root, sign))
+            if (process_cached(t, root, sign, pol))
                 return;
             SASSERT(num <= m_result_stack.size());
             sat::bool_var k = add_var(false, t);
             sat::literal  l(k, false);
-            cache(t, l);
+            cache(t, l, pol);
             sat::literal * lits = m_result_stack.end() - num;
 
             // l => /\ lits
-            for (unsigned i = 0; i < num; i++) {
-                mk_clause(~l, lits[i], mk_tseitin(~l, lits[i]));
+            if (pol & pol_pos) {
+                for (unsigned i = 0; i < num; i++) {
+                    mk_clause(~l, lits[i], mk_tseitin(~l, lits[i]));
+                }
             }
             // /\ lits => l
-            for (unsigned i = 0; i < num; ++i) {
-                m_result_stack[m_result_stack.size() - num + i].neg();
-            }
-            m_result_stack.push_back(l);
-            lits = m_result_stack.end() - num - 1;
-            if (aig()) {
-                aig_lits.reset();
-                aig_lits.append(num, lits);
+            if (pol & pol_neg) {
+                for (unsigned i = 0; i < num; ++i) {
+                    m_result_stack[m_result_stack.size() - num + i].neg();
+                }
+                m_result_stack.push_back(l);
+                lits = m_result_stack.end() - num - 1;
+                bool use_aig = aig() && pol == pol_both;
+                if (use_aig) {
+                    aig_lits.reset();
+                    aig_lits.append(num, lits);
+                }
+                mk_clause(num+1, lits, mk_tseitin(num+1, lits));
+                if (use_aig) {
+                    aig()->add_and(l, num, aig_lits.data());
+                }        
             }
-            mk_clause(num+1, lits, mk_tseitin(num+1, lits));
-            if (aig()) {
-                aig()->add_and(l, num, aig_lits.data());
-            }        
             m_solver.set_phase(l);               
             if (sign)
                 l.neg();
@@ -511,7 +569,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         }
     }
 
-    void convert_ite(app * n, bool root, bool sign) {
+    void convert_ite(app * n, bool root, bool sign, unsigned pol) {
         unsigned sz = m_result_stack.size();
         SASSERT(sz >= 3);
         sat::literal  c = m_result_stack[sz-3];
@@ -530,20 +588,26 @@ struct goal2sat::imp : public sat::sat_internalizer {
             }
         }
         else {
-            if (process_cached(n, root, sign))
+            if (process_cached(n, root, sign, pol))
                 return;
             sat::bool_var k = add_var(false, n);
             sat::literal  l(k, false);
-            cache(n, l);
-            mk_clause(~l, ~c, t, mk_tseitin(~l, ~c, t));
-            mk_clause(~l,  c, e, mk_tseitin(~l, c, e));
-            mk_clause(l,  ~c, ~t, mk_tseitin(l, ~c, ~t));
-            mk_clause(l,   c, ~e, mk_tseitin(l, c, ~e));
+            cache(n, l, pol);
+            if (pol & pol_pos) {
+                mk_clause(~l, ~c, t, mk_tseitin(~l, ~c, t));
+                mk_clause(~l,  c, e, mk_tseitin(~l, c, e));
+            }
+            if (pol & pol_neg) {
+                mk_clause(l,  ~c, ~t, mk_tseitin(l, ~c, ~t));
+                mk_clause(l,   c, ~e, mk_tseitin(l, c, ~e));
+            }
             if (m_ite_extra) {
-                mk_clause(~t, ~e, l, mk_tseitin(~t, ~e, l));
-                mk_clause(t,  e, ~l, mk_tseitin(t, e, ~l));
+                if (pol & pol_neg)
+                    mk_clause(~t, ~e, l, mk_tseitin(~t, ~e, l));
+                if (pol & pol_pos)
+                    mk_clause(t,  e, ~l, mk_tseitin(t, e, ~l));
             }
-            if (aig()) aig()->add_ite(l, c, t, e);
+            if (aig() && pol == pol_both) aig()->add_ite(l, c, t, e);
             if (sign)
                 l.neg();
 
@@ -551,7 +615,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         }
     }
 
-    void convert_not(app* t, bool root, bool sign) {
+    void convert_not(app* t, bool root, bool sign, unsigned pol) {
         SASSERT(t->get_num_args() == 1);
         unsigned sz = m_result_stack.size();
         SASSERT(sz >= 1);
@@ -562,21 +626,23 @@ struct goal2sat::imp : public sat::sat_internalizer {
             mk_root_clause(sign ? lit : ~lit);            
         }
         else {
-            if (process_cached(t, root, sign))
+            if (process_cached(t, root, sign, pol))
                 return;
             sat::bool_var k = add_var(false, t);
             sat::literal  l(k, false);
-            cache(t, l);
+            cache(t, l, pol);
             // l <=> ~lit
-            mk_clause(lit, l, mk_tseitin(lit, l));
-            mk_clause(~lit, ~l, mk_tseitin(~lit, ~l));
+            if (pol & pol_neg)
+                mk_clause(lit, l, mk_tseitin(lit, l));
+            if (pol & pol_pos)
+                mk_clause(~lit, ~l, mk_tseitin(~lit, ~l));
             if (sign)
                 l.neg();
             m_result_stack.push_back(l);
         }
     }
 
-    void convert_implies(app* t, bool root, bool sign) {
+    void convert_implies(app* t, bool root, bool sign, unsigned pol) {
         SASSERT(t->get_num_args() == 2);
         unsigned sz = m_result_stack.size();
         SASSERT(sz >= 2);
@@ -594,15 +660,18 @@ struct goal2sat::imp : public sat::sat_internalizer {
             }            
         }
         else {
-            if (process_cached(t, root, sign))
+            if (process_cached(t, root, sign, pol))
                 return;
             sat::bool_var k = add_var(false, t);
             sat::literal  l(k, false);
-            cache(t, l);
+            cache(t, l, pol);
             // l <=> (l1 => l2)
-            mk_clause(~l, ~l1, l2, mk_tseitin(~l, ~l1, l2));
-            mk_clause(l1, l, mk_tseitin(l1, l));
-            mk_clause(~l2, l, mk_tseitin(~l2, l));
+            if (pol & pol_pos)
+                mk_clause(~l, ~l1, l2, mk_tseitin(~l, ~l1, l2));
+            if (pol & pol_neg) {
+                mk_clause(l1, l, mk_tseitin(l1, l));
+                mk_clause(~l2, l, mk_tseitin(~l2, l));
+            }
             if (sign)
                 l.neg();
             m_result_stack.push_back(l);
@@ -662,7 +731,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         SASSERT(m_euf);
         sat::extension* ext = m_solver.get_extension();
         euf::solver* euf = nullptr;
-        if (!ext) {
+        if (!ext || dynamic_cast<xr::solver*>(ext)) {
             euf = alloc(euf::solver, m, *this);
             m_solver.set_extension(euf);
 #if 0
@@ -680,11 +749,32 @@ struct goal2sat::imp : public sat::sat_internalizer {
         return euf;
     }
 
+    /**
+       \brief the xor solver is the extension of problems that need no
+       other extension. It is replaced by the euf or pb solver when they
+       are needed, and extracts its xors again from the clauses.
+    */
+    void ensure_xor() {
+        if (!m_xor_solver || m_euf || m_solver.get_extension())
+            return;
+        euf::th_solver* th = alloc(xr::solver, m, m.mk_family_id("xor-solver"));
+        m_solver.set_extension(th);
+        th->push_scopes(m_solver.num_scopes());
+    }
+
     void convert_euf(expr* e, bool root, bool sign) {
         SASSERT(m_euf);
         TRACE("goal2sat", tout << "convert-euf " << mk_bounded_pp(e, m, 2) << " root " << root << "\n";);
         euf::solver* euf = ensure_euf();
         sat::literal lit;
+        if (!root && is_app(e) && to_app(e)->get_num_args() > 0 && !m_expr2var_replay &&
+            m_map.to_bool_var(e) == sat::null_bool_var && !euf->get_enode(e) && euf->can_add_lazy_atom()) {
+            // the atom is internalized by euf when it is assigned and relevant
+            sat::bool_var v = mk_bool_var(e);
+            euf->add_lazy_atom(v, e);
+            m_result_stack.push_back(sat::literal(v, sign));
+            return;
+        }
         {
             flet<bool> _top(m_top_level, false);
             lit = euf->internalize(e, sign, root);           
@@ -720,17 +810,17 @@ struct goal2sat::imp : public sat::sat_internalizer {
             m_result_stack.push_back(lit);      
     }
 
-    void convert(app * t, bool root, bool sign) {
+    void convert(app * t, bool root, bool sign, unsigned pol) {
         if (t->get_family_id() == m.get_basic_family_id()) {
             switch (to_app(t)->get_decl_kind()) {
             case OP_OR:
-                convert_or(t, root, sign);
+                convert_or(t, root, sign, pol);
                 break;
             case OP_AND:
-                convert_and(t, root, sign);
+                convert_and(t, root, sign, pol);
                 break;
             case OP_ITE:
-                convert_ite(t, root, sign);
+                convert_ite(t, root, sign, pol);
                 break;
             case OP_EQ:
                 convert_iff(t, root, sign);
@@ -739,10 +829,10 @@ struct goal2sat::imp : public sat::sat_internalizer {
                 convert_iff(t, root, sign);
                 break;
             case OP_IMPLIES:
-                convert_implies(t, root, sign);
+                convert_implies(t, root, sign, pol);
                 break;
             case OP_NOT:
-                convert_not(t, root, sign);
+                convert_not(t, root, sign, pol);
                 break;
             default:
                 UNREACHABLE();
@@ -786,7 +876,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
             << " frame-stack: " << m_frame_stack.size() << "\n";);
         scoped_stack _sc(*this, is_root);
         unsigned sz = m_frame_stack.size();
-        if (visit(n, is_root, false)) 
+        if (visit(n, is_root, false, is_root && use_polarity() ? pol_pos : pol_both)) 
             return;
         
         while (m_frame_stack.size() > sz) {
@@ -800,24 +890,26 @@ struct goal2sat::imp : public sat::sat_internalizer {
             app * t    = _fr.m_t;
             bool root  = _fr.m_root;
             bool sign  = _fr.m_sign;
+            unsigned pol = _fr.m_pol;
             TRACE("goal2sat_bug", tout << "result stack\n";
             tout << "ref-count: " << t->get_ref_count() << "\n";
                   tout << mk_bounded_pp(t, m, 3) << " root: " << root << " sign: " << sign << "\n";
                   tout << m_result_stack << "\n";);
-            if (_fr.m_idx == 0 && process_cached(t, root, sign)) {
+            if (_fr.m_idx == 0 && process_cached(t, root, sign, pol)) {
                 m_frame_stack.pop_back();
                 continue;
             }
             if (m.is_not(t) && (root || (!m.is_not(t->get_arg(0)) && fsz != sz + 1))) {
                 m_frame_stack.pop_back();
-                visit(t->get_arg(0), root, !sign);
+                visit(t->get_arg(0), root, !sign, flip(pol));
                 continue;
             }
             unsigned num = t->get_num_args();
             while (m_frame_stack[fsz-1].m_idx < num) {
-                expr * arg = t->get_arg(m_frame_stack[fsz-1].m_idx);
+                unsigned idx = m_frame_stack[fsz-1].m_idx;
+                expr * arg = t->get_arg(idx);
                 m_frame_stack[fsz - 1].m_idx++;
-                if (!visit(arg, false, false))
+                if (!visit(arg, false, false, arg_pol(t, idx, pol)))
                     goto loop;
                 TRACE("goal2sat_bug", tout << "visit " << mk_bounded_pp(arg, m, 2) << " result stack: " << m_result_stack.size() << "\n";);
             }
@@ -825,7 +917,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
                   tout << mk_bounded_pp(t, m, 2) << " root: " << root << " sign: " << sign << "\n";
                   tout << m_result_stack << "\n";);
             SASSERT(m_frame_stack.size() > sz);
-            convert(t, root, sign);
+            convert(t, root, sign, pol);
             m_frame_stack.pop_back();            
         }
         TRACE("goal2sat", tout 
@@ -927,6 +1019,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         // collect_boolean_interface(g, m_interface_vars);
         for (unsigned i = 0; i < n; ++i) 
             process(fmls[i]);
+        ensure_xor();
     }
 
     void assumptions(unsigned n, expr* const* fmls) {
@@ -982,6 +1075,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         skip_dep:
             ;
         }
+        ensure_xor();
     }
 
     void update_model(model_ref& mdl) {
@@ -276,8 +276,9 @@ struct sat2goal::imp {
             if (ba) {                
                 ba->to_formulas(l2e, fmls);
             }
-            else 
-                dynamic_cast<euf::solver*>(ext)->to_formulas(l2e, fmls);            
+            else if (auto* euf = dynamic_cast<euf::solver*>(ext))
+                euf->to_formulas(l2e, fmls);
+            // the xors of the xor solver are consequences of the clauses
             for (expr* f : fmls)
                 r.assert_expr(f);            
         }
@@ -7,11 +7,13 @@ Copyright (c) 2020 Microsoft Corporation
 #include<fstream>
 #include "util/memory_manager.h"
 #include "util/statistics.h"
+#include "util/thread_pool.h"
 #include "ast/proofs/proof_checker.h"
 #include "ast/reg_decl_plugins.h"
 #include "sat/dimacs.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_drat.h"
+#include "sat/sat_params.hpp"
 #include "shell/drat_frontend.h"
 
 
@@ -51,19 +53,111 @@ class drup_checker {
         exit(0);
     }
 
+    void declare(sat::literal_vector const& lits) {
+        for (sat::literal lit : lits)
+            while (lit.var() >= m_drat.get_solver().num_vars())
+                m_drat.get_solver().mk_var(true);
+    }
+
 public:
     drup_checker(sat::drat& drat): m_drat(drat) {}
 
+    static bool is_lemma(sat::status const& st) {
+        return st.is_redundant() && st.is_sat();
+    }
+
     void add(sat::literal_vector const& lits, sat::status const& st) {
-        for (sat::literal lit : lits)
-            while (lit.var() >= m_drat.get_solver().num_vars())
-                m_drat.get_solver().mk_var(true);
-        if (st.is_sat())
+        declare(lits);
+        if (is_lemma(st))
             check_drup(lits);
         m_drat.add(lits, st);
     }
+
+    /**
+    * Add a clause without checking it.
+    * Lemmas are added as input clauses so that the drat module does not check them again.
+    */
+    void replay(sat::literal_vector const& lits, sat::status const& st) {
+        declare(lits);
+        m_drat.add(lits, is_lemma(st) ? sat::status::input() : st);
+    }
+
+    bool check(sat::literal_vector const& lits) {
+        declare(lits);
+        add_units();
+        drup_units.reset();
+        return m_drat.is_drup(lits.size(), lits.data(), drup_units);
+    }
+
+    bool inconsistent() const { return m_drat.inconsistent(); }
 };
 
+/**
+* Check the lemmas of records[begin..end) against a private copy of the clauses.
+* The records before begin are replayed without checks.
+* Returns the index of the first lemma that does not verify, or UINT_MAX.
+*/
+static unsigned check_lemmas(vector<dimacs::drat_record> const& records, unsigned begin, unsigned end) {
+    params_ref p;
+    reslimit lim;
+    sat::solver solver(p, lim);
+    sat::drat drat_checker(solver);
+    drup_checker checker(drat_checker);
+    for (unsigned i = 0; i < end && !checker.inconsistent(); ++i) {
+        auto const& r = records[i];
+        if (i >= begin && drup_checker::is_lemma(r.m_status) && !checker.check(r.m_lits))
+            return i;
+        checker.replay(r.m_lits, r.m_status);
+    }
+    return UINT_MAX;
+}
+
+/**
+* The lemmas are partitioned into consecutive blocks with the same number of lemmas.
+* Each block is checked by its own thread, which first replays the records before
+* the block. The first lemma that fails to verify is reported.
+*/
+static unsigned check_drat_parallel(vector<dimacs::drat_record> const& records, unsigned num_threads) {
+    unsigned num_lemmas = 0;
+    for (auto const& r : records)
+        if (drup_checker::is_lemma(r.m_status))
+            ++num_lemmas;
+    num_threads = std::max(1u, std::min(num_threads, num_lemmas));
+    unsigned_vector bounds;
+    bounds.push_back(0);
+    unsigned k = 0;
+    for (unsigned i = 0; i < records.size() && bounds.size() < num_threads; ++i) 
+        if (drup_checker::is_lemma(records[i].m_status) && ++k == bounds.size() * num_lemmas / num_threads)
+            bounds.push_back(i + 1);
+    while (bounds.size() <= num_threads)
+        bounds.push_back(records.size());
+
+    unsigned_vector failed(num_threads, UINT_MAX);
+    auto check = [&](unsigned i) {
+        try {
+            failed[i] = check_lemmas(records, bounds[i], bounds[i + 1]);
+        }
+        catch (z3_exception& ex) {
+            std::cerr << ex.msg() << "\n";
+            failed[i] = bounds[i];
+        }
+    };
+#ifdef SINGLE_THREAD
+    for (unsigned i = 0; i < num_threads; ++i)
+        check(i);
+#else
+    thread_pool::run(num_threads, check);
+#endif
+    for (unsigned i = 0; i < num_threads; ++i) {
+        if (failed[i] != UINT_MAX) {
+            std::cout << "did not verify " << records[failed[i]].m_lits << "\n";
+            return 0;
+        }
+    }
+    std::cout << "verified " << num_lemmas << " lemmas using " << num_threads << " threads\n";
+    return 0;
+}
+
 unsigned read_drat(char const* drat_file) {
     ast_manager m;
     reg_decl_plugins(m);
@@ -77,6 +171,13 @@ unsigned read_drat(char const* drat_file) {
         return m.get_family_name(th);
     };
     drat.set_read_theory(read_theory);
+    sat_params sp;
+    if (sp.threads() > 1) {
+        vector<dimacs::drat_record> records;
+        for (auto const& r : drat)
+            records.push_back(r);
+        return check_drat_parallel(records, sp.threads());
+    }
     params_ref p;
     reslimit lim;
     sat::solver solver(p, lim);
@@ -44,7 +44,7 @@ Revision History:
 #include <crtdbg.h>
 #endif
 
-typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_OPB, IN_LP, IN_Z3_LOG, IN_MPS, IN_DRAT } input_kind;
+typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_OPB, IN_LP, IN_Z3_LOG, IN_MPS, IN_DRAT, IN_BINARY, IN_BENCH, IN_WORKER } input_kind;
 
 static char const * g_input_file          = nullptr;
 static char const * g_drat_input_file     = nullptr;
@@ -53,6 +53,8 @@ static input_kind   g_input_kind          = IN_UNSPECIFIED;
 bool                g_display_statistics  = false;
 bool                g_display_model       = false;
 static bool         g_display_istatistics = false;
+static unsigned     g_bench_reps          = 0;
+static bool         g_bench_json          = false;
 
 static void error(const char * msg) {
     std::cerr << "Error: " << msg << "\n";
@@ -85,6 +87,7 @@ void display_usage() {
     std::cout << "  -opb        use parser for PB optimization input format.\n";
     std::cout << "  -lp         use parser for a modest subset of CPLEX LP input format.\n";
     std::cout << "  -log        use parser for Z3 log input format.\n";
+    std::cout << "  -bin        load assertions from binary AST format (see Z3_ast_vector_serialize).\n";
     std::cout << "  -in         read formula from standard input.\n";
     std::cout << "  -model      display model for satisfiable SMT.\n";
     std::cout << "\nMiscellaneous:\n";
@@ -108,6 +111,11 @@ void display_usage() {
     // 
     std::cout << "\nOutput:\n";
     std::cout << "  -st         display statistics.\n";
+    std::cout << "  -bench[:N]  run the SMT 2 input file, or the .smt2 files of the input directory, N times and\n";
+    std::cout << "              display per phase timings as CSV.\n";
+    std::cout << "  -bench_json[:N] same as -bench, but display the timings as JSON.\n";
+    std::cout << "  -worker:dir solve the tasks that the parallel solver writes to dir (parallel.remote_dir=dir).\n";
+    std::cout << "              The worker stops when dir contains a file named stop.\n";
 #if defined(Z3DEBUG) || defined(_TRACE)
     std::cout << "\nDebugging support:\n";
 #endif
@@ -207,6 +215,9 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             else if (strcmp(opt_name, "log") == 0) {
                 g_input_kind = IN_Z3_LOG;
             }
+            else if (strcmp(opt_name, "bin") == 0) {
+                g_input_kind = IN_BINARY;
+            }
             else if (strcmp(opt_name, "st") == 0) {
                 g_display_statistics = true; 
                 gparams::set("stats", "true");
@@ -236,6 +247,19 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
                     error("option argument (-t:timeout) is missing.");
                 gparams::set("timeout", opt_arg);
             }
+            else if (strcmp(opt_name, "bench") == 0 || strcmp(opt_name, "bench_json") == 0) {
+                g_bench_reps = opt_arg ? strtol(opt_arg, nullptr, 10) : 1;
+                g_bench_json = strcmp(opt_name, "bench_json") == 0;
+                g_input_kind = IN_BENCH;
+                if (g_bench_reps == 0)
+                    error("option argument (-bench:N) must be positive.");
+            }
+            else if (strcmp(opt_name, "worker") == 0) {
+                if (!opt_arg)
+                    error("option argument (-worker:dir) is missing.");
+                g_input_kind = IN_WORKER;
+                g_input_file = opt_arg;
+            }
             else if (strcmp(opt_name, "nw") == 0) {
                 enable_warning_messages(false);
             }
@@ -369,6 +393,9 @@ int STD_CALL main(int argc, char ** argv) {
                 else if (strcmp(ext, "smt2") == 0) {
                     g_input_kind = IN_SMTLIB_2;
                 }
+                else if (strcmp(ext, "z3b") == 0) {
+                    g_input_kind = IN_BINARY;
+                }
                 else if (strcmp(ext, "mps") == 0 || strcmp(ext, "sif") == 0 ||
                          strcmp(ext, "MPS") == 0 || strcmp(ext, "SIF") == 0) {
                     g_input_kind = IN_MPS;
@@ -404,6 +431,17 @@ int STD_CALL main(int argc, char ** argv) {
         case IN_DRAT:
             return_value = read_drat(g_drat_input_file);
             break;
+        case IN_BINARY:
+            memory::exit_when_out_of_memory(true, "(error \"out of memory\")");
+            return_value = read_binary_file(g_input_file);
+            break;
+        case IN_BENCH:
+            memory::exit_when_out_of_memory(true, "(error \"out of memory\")");
+            return_value = run_smtlib2_benchmarks(g_input_file, g_bench_reps, g_bench_json);
+            break;
+        case IN_WORKER:
+            return_value = run_parallel_worker(g_input_file);
+            break;
         default:
             UNREACHABLE();
         }
@@ -21,6 +21,9 @@ Revision History:
 #include<iostream>
 #include<time.h>
 #include<signal.h>
+#include<filesystem>
+#include<thread>
+#include<chrono>
 #include "util/timeout.h"
 #include "util/mutex.h"
 #include "parsers/smt2/smt2parser.h"
@@ -32,6 +35,7 @@ Revision History:
 #include "cmd_context/extra_cmds/subpaving_cmds.h"
 #include "smt/smt2_extra_cmds.h"
 #include "smt/smt_solver.h"
+#include "ast/ast_binary.h"
 
 static mutex *display_stats_mux = new mutex;
 
@@ -116,12 +120,7 @@ void help_probes() {
         std::cout << "- " << cmd->get_name() << " " << cmd->get_descr() << "\n";
 }
 
-unsigned read_smtlib2_commands(char const * file_name) {
-    g_start_time = clock();
-    register_on_timeout_proc(on_timeout);
-    signal(SIGINT, on_ctrl_c);
-    cmd_context ctx;
-
+static void init_cmd_context(cmd_context& ctx) {
     ctx.set_solver_factory(mk_smt_strategic_solver_factory());
     install_dl_cmds(ctx);
     install_dbg_cmds(ctx);
@@ -130,13 +129,22 @@ unsigned read_smtlib2_commands(char const * file_name) {
     install_opt_cmds(ctx);
     install_smt2_extra_cmds(ctx);
     install_proof_cmds(ctx);
+}
+
+unsigned read_smtlib2_commands(char const * file_name) {
+    g_start_time = clock();
+    register_on_timeout_proc(on_timeout);
+    signal(SIGINT, on_ctrl_c);
+    cmd_context ctx;
+    init_cmd_context(ctx);
 
     g_cmd_context = &ctx;
     signal(SIGINT, on_ctrl_c);
 
     bool result = true;
     if (file_name) {
-        std::ifstream in(file_name);
+        // binary mode, so that compressed input is read unchanged
+        std::ifstream in(file_name, std::ios::in | std::ios::binary);
         if (in.bad() || in.fail()) {
             std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
             exit(ERR_OPEN_FILE);
@@ -153,3 +161,200 @@ unsigned read_smtlib2_commands(char const * file_name) {
     return result ? 0 : 1;
 }
 
+
+unsigned read_binary_file(char const * file_name) {
+    g_start_time = clock();
+    register_on_timeout_proc(on_timeout);
+    signal(SIGINT, on_ctrl_c);
+    if (!file_name) {
+        std::cerr << "(error \"binary input must be read from a file\")" << std::endl;
+        exit(ERR_CMD_LINE);
+    }
+    cmd_context ctx;
+    ctx.set_solver_factory(mk_smt_strategic_solver_factory());
+    g_cmd_context = &ctx;
+
+    expr_ref_vector fmls(ctx.m());
+    try {
+        ast_binary_read_file(ctx.m(), file_name, fmls);
+    }
+    catch (z3_exception & ex) {
+        std::cerr << "(error \"" << ex.msg() << "\")" << std::endl;
+        exit(ERR_OPEN_FILE);
+    }
+    for (expr * f : fmls)
+        ctx.assert_expr(f);
+    ctx.check_sat(0, nullptr);
+
+    display_statistics();
+    display_model();
+    g_cmd_context = nullptr;
+    return 0;
+}
+
+namespace {
+    struct bench_run {
+        std::string m_file;
+        unsigned    m_rep = 0;
+        char const* m_status = "error";
+        double      m_wall = 0, m_cpu = 0, m_commands = 0;
+        double      m_preprocess = 0, m_internalize = 0, m_search = 0, m_final_check = 0, m_model = 0;
+        double      m_max_memory = 0;
+    };
+
+    double get_time_stat(statistics const& st, char const* key) {
+        double r = 0;
+        for (unsigned i = 0; i < st.size(); ++i)
+            if (!st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+                r += st.get_double_value(i);
+        return r;
+    }
+
+    void run_benchmark(char const* file_name, bench_run& r) {
+        std::ifstream in(file_name, std::ios::in | std::ios::binary);
+        if (in.bad() || in.fail()) {
+            std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
+            return;
+        }
+        std::ostringstream out;
+        clock_t start_cpu = clock();
+        stopwatch sw;
+        sw.start();
+        cmd_context ctx;
+        init_cmd_context(ctx);
+        ctx.set_regular_stream(out);
+        ctx.set_diagnostic_stream(out);
+        bool ok = false;
+        try {
+            ok = parse_smt2_commands(ctx, in);
+        }
+        catch (z3_exception& ex) {
+            std::cerr << "(error \"" << file_name << ": " << ex.msg() << "\")" << std::endl;
+        }
+        sw.stop();
+        r.m_wall = sw.get_seconds();
+        r.m_cpu = static_cast<double>(clock() - start_cpu) / CLOCKS_PER_SEC;
+        r.m_commands = ctx.get_commands_seconds();
+        if (ok) {
+            switch (ctx.cs_state()) {
+            case cmd_context::css_sat: r.m_status = "sat"; break;
+            case cmd_context::css_unsat: r.m_status = "unsat"; break;
+            case cmd_context::css_unknown: r.m_status = "unknown"; break;
+            default: r.m_status = "none"; break;
+            }
+        }
+        statistics st;
+        ctx.collect_solver_statistics(st);
+        r.m_preprocess = get_time_stat(st, "time.smt.preprocess");
+        r.m_internalize = get_time_stat(st, "time.smt.internalize");
+        r.m_search = get_time_stat(st, "time.smt.search");
+        r.m_final_check = get_time_stat(st, "time.smt.final-check");
+        r.m_model = get_time_stat(st, "time.smt.model");
+        r.m_max_memory = static_cast<double>(memory::get_max_used_memory()) / static_cast<double>(1024*1024);
+    }
+
+    void display_csv_header(std::ostream& out) {
+        out << "file,rep,status,wall,cpu,parse,commands,smt.preprocess,smt.internalize,smt.search,smt.final-check,smt.model,max-memory-mb\n";
+    }
+
+    void display_csv(std::ostream& out, bench_run const& r) {
+        out << r.m_file << "," << r.m_rep << "," << r.m_status << ","
+            << r.m_wall << "," << r.m_cpu << "," << std::max(0.0, r.m_wall - r.m_commands) << "," << r.m_commands << ","
+            << r.m_preprocess << "," << r.m_internalize << "," << r.m_search << ","
+            << r.m_final_check << "," << r.m_model << "," << r.m_max_memory << "\n";
+    }
+
+    void display_json(std::ostream& out, bench_run const& r) {
+        out << "  {\"file\": \"" << r.m_file << "\", \"rep\": " << r.m_rep << ", \"status\": \"" << r.m_status << "\""
+            << ", \"wall\": " << r.m_wall << ", \"cpu\": " << r.m_cpu
+            << ", \"parse\": " << std::max(0.0, r.m_wall - r.m_commands) << ", \"commands\": " << r.m_commands
+            << ", \"smt.preprocess\": " << r.m_preprocess << ", \"smt.internalize\": " << r.m_internalize
+            << ", \"smt.search\": " << r.m_search << ", \"smt.final-check\": " << r.m_final_check
+            << ", \"smt.model\": " << r.m_model << ", \"max-memory-mb\": " << r.m_max_memory << "}";
+    }
+}
+
+unsigned run_smtlib2_benchmarks(char const * path, unsigned reps, bool json) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    if (std::filesystem::is_directory(path, ec)) {
+        for (auto const& entry : std::filesystem::recursive_directory_iterator(path, ec))
+            if (entry.is_regular_file() && entry.path().extension() == ".smt2")
+                files.push_back(entry.path().string());
+        std::sort(files.begin(), files.end());
+    }
+    else
+        files.push_back(path);
+    std::ostream& out = std::cout;
+    if (json)
+        out << "[\n";
+    else
+        display_csv_header(out);
+    bool first = true;
+    for (auto const& f : files) {
+        for (unsigned rep = 0; rep < reps; ++rep) {
+            bench_run r;
+            r.m_file = f;
+            r.m_rep = rep;
+            run_benchmark(f.c_str(), r);
+            if (json) {
+                if (!first)
+                    out << ",\n";
+                display_json(out, r);
+            }
+            else
+                display_csv(out, r);
+            first = false;
+            out.flush();
+        }
+    }
+    if (json)
+        out << "\n]\n";
+    return 0;
+}
+
+/**
+   \brief worker for parallel.remote_dir. Tasks task-<id>.smt2 in the directory
+   are claimed by renaming them, solved, and answered by task-<id>.result.
+   The worker stops when the directory contains a file named stop.
+ */
+unsigned run_parallel_worker(char const * dir) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (!fs::is_directory(dir, ec)) {
+        std::cerr << "(error \"worker directory '" << dir << "' does not exist\")" << std::endl;
+        return ERR_OPEN_FILE;
+    }
+    unsigned num_tasks = 0;
+    while (!fs::exists(fs::path(dir) / "stop", ec)) {
+        bool found = false;
+        for (auto const& entry : fs::directory_iterator(dir, ec)) {
+            fs::path task = entry.path();
+            std::string name = task.filename().string();
+            if (task.extension() != ".smt2" || name.rfind("task-", 0) != 0)
+                continue;
+            fs::path claimed = task, result = task, tmp = task;
+            claimed.replace_extension(".running");
+            result.replace_extension(".result");
+            tmp.replace_extension(".result-tmp");
+            fs::rename(task, claimed, ec);
+            if (ec) 
+                continue; // claimed by another worker or withdrawn
+            found = true;
+            bench_run r;
+            run_benchmark(claimed.string().c_str(), r);
+            {
+                std::ofstream out(tmp);
+                out << r.m_status << "\n";
+            }
+            fs::rename(tmp, result, ec);
+            fs::remove(claimed, ec);
+            ++num_tasks;
+            IF_VERBOSE(1, verbose_stream() << "(worker :task " << name << " :status " << r.m_status << " :seconds " << r.m_wall << ")\n");
+        }
+        if (!found)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    IF_VERBOSE(1, verbose_stream() << "(worker :tasks " << num_tasks << ")\n");
+    return 0;
+}
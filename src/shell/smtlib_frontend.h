@@ -20,6 +20,9 @@ Revision History:
 
 unsigned read_smtlib_file(char const * benchmark_file);
 unsigned read_smtlib2_commands(char const * command_file);
+unsigned read_binary_file(char const * file_name);
+unsigned run_smtlib2_benchmarks(char const * path, unsigned reps, bool json);
+unsigned run_parallel_worker(char const * dir);
 void help_tactics();
 void help_probes();
 void help_tactic(char const* name);
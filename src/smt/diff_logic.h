@@ -1382,6 +1382,37 @@ public:
         return find_shortest_path_aux(source, target, timestamp, f, false);
     }
 
+    /**
+       \brief mark the nodes reachable from source by a non-empty path along the 
+       edges followed by find_shortest_reachable_path. The visited nodes are 
+       collected in reached and the caller resets their marks.
+    */
+    void get_reachable(dl_var source, unsigned timestamp, svector<dl_var> & reached, bool_vector & mark) {
+        reached.reset();
+        reached.push_back(source);
+        mark[source] = true;
+        bool source_reached = false;
+        numeral gamma;
+        for (unsigned head = 0; head < reached.size(); ++head) {
+            for (edge_id e_id : m_out_edges[reached[head]]) {
+                edge & e = m_edges[e_id];
+                if (!e.is_enabled())
+                    continue;
+                set_gamma(e, gamma);
+                if (!is_connected(gamma, false, e, timestamp))
+                    continue;
+                dl_var t = e.get_target();
+                if (t == source)
+                    source_reached = true;
+                else if (!mark[t]) {
+                    mark[t] = true;
+                    reached.push_back(t);
+                }
+            }
+        }
+        mark[source] = source_reached;
+    }
+
     template<typename Functor>
     bool find_shortest_path_aux(dl_var source, dl_var target, unsigned timestamp, Functor & f, bool zero_edge) {
         svector<bfs_elem> bfs_todo;
@@ -166,6 +166,43 @@ namespace smt {
         m_context(ctx),
         m(ctx.get_manager()),
         m_params(p) {
+        m_sketch.init(m_params.m_dack_max_candidates);
+        m_triple.m_sketch.init(m_params.m_dack_max_candidates);
+    }
+
+    void dyn_ack_manager::occs_sketch::init(unsigned num_candidates) {
+        unsigned width = 1024;
+        while (width < 4 * num_candidates && width < (1u << 20))
+            width *= 2;
+        m_mask = width - 1;
+        m_counts.reset();
+        m_counts.resize(num_rows * width, 0);
+    }
+
+    /**
+       \brief increment the counters of the key with hash codes h1, h2 and 
+       return the new estimate of its number of occurrences.
+       Only the counters holding the current (minimal) estimate are incremented.
+    */
+    unsigned dyn_ack_manager::occs_sketch::inc(unsigned h1, unsigned h2) {
+        h2 |= 1;
+        unsigned width = m_mask + 1;
+        unsigned est = UINT_MAX;
+        for (unsigned r = 0; r < num_rows; ++r) 
+            est = std::min(est, m_counts[r * width + ((h1 + r * h2) & m_mask)]);
+        if (est == UINT_MAX)
+            return est;
+        for (unsigned r = 0; r < num_rows; ++r) {
+            unsigned & c = m_counts[r * width + ((h1 + r * h2) & m_mask)];
+            if (c == est)
+                c = est + 1;
+        }
+        return est + 1;
+    }
+
+    void dyn_ack_manager::occs_sketch::decay(double f) {
+        for (unsigned & c : m_counts)
+            c = static_cast<unsigned>(c * f);
     }
 
     dyn_ack_manager::~dyn_ack_manager() {
@@ -194,6 +231,9 @@ namespace smt {
         reset_app_triples();
         m_triple.m_to_instantiate.reset();
         m_triple.m_qhead = 0;
+
+        m_sketch.init(m_params.m_dack_max_candidates);
+        m_triple.m_sketch.init(m_params.m_dack_max_candidates);
     }
 
     void dyn_ack_manager::cg_eh(app * n1, app * n2) {
@@ -210,12 +250,19 @@ namespace smt {
             return;
         }
         unsigned num_occs = 0;
+        bool is_new = false;
         if (m_app_pair2num_occs.find(n1, n2, num_occs)) {
             TRACE("dyn_ack", tout << "used_cg_eh:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << num_occs << "\n";);
             num_occs++;
         }
         else {
-            num_occs = 1;
+            // pairs are only stored once their estimated number of uses reaches the threshold
+            unsigned a = n1->get_id(), b = n2->get_id(), c = 0x9e3779b9;
+            mix(a, b, c);
+            num_occs = m_sketch.inc(c, b);
+            if (num_occs < m_params.m_dack_threshold)
+                return;
+            is_new = true;
             m.inc_ref(n1);
             m.inc_ref(n2);
             m_app_pairs.push_back(p);
@@ -226,9 +273,11 @@ namespace smt {
         unsigned num_occs2 = 0;
         SASSERT(m_app_pair2num_occs.find(n1, n2, num_occs2) && num_occs == num_occs2);
 #endif
-        if (num_occs == m_params.m_dack_threshold) {
+        if (is_new) {
             TRACE("dyn_ack", tout << "found candidate:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << num_occs << "\n";);
             m_to_instantiate.push_back(p);
+            if (m_app_pairs.size() > 2 * m_params.m_dack_max_candidates)
+                gc();
         }
     }
 
@@ -245,13 +294,19 @@ namespace smt {
             return;
         }
         unsigned num_occs = 0;
+        bool is_new = false;
         if (m_triple.m_app2num_occs.find(n1, n2, r, num_occs)) {
             TRACE("dyn_ack", tout << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\n"
                   << mk_pp(r, m) << "\n" << "\nnum_occs: " << num_occs << "\n";);
             num_occs++;
         }
         else {
-            num_occs = 1;
+            unsigned a = n1->get_id(), b = n2->get_id(), c = r->get_id();
+            mix(a, b, c);
+            num_occs = m_triple.m_sketch.inc(c, b);
+            if (num_occs < m_params.m_dack_threshold)
+                return;
+            is_new = true;
             m.inc_ref(n1);
             m.inc_ref(n2);
             m.inc_ref(r);
@@ -263,15 +318,21 @@ namespace smt {
         unsigned num_occs2 = 0;
         SASSERT(m_triple.m_app2num_occs.find(n1, n2, r, num_occs2) && num_occs == num_occs2);
 #endif
-        if (num_occs == m_params.m_dack_threshold) {
+        if (is_new) {
             TRACE("dyn_ack", tout << "found candidate:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) 
                   << "\n" << mk_pp(r, m) 
                   << "\nnum_occs: " << num_occs << "\n";);
             m_triple.m_to_instantiate.push_back(tr);
+            if (m_triple.m_apps.size() > 2 * m_params.m_dack_max_candidates)
+                gc_triples();
         }
-        
     }
 
+    /**
+       \brief order candidates by decreasing number of uses.
+       Ties are broken by the ids of the applications, so the order is total 
+       and sorting does not depend on the platform.
+    */
     struct app_pair_lt { 
         typedef std::pair<app *, app *>          app_pair;
         typedef obj_pair_map<app, app, unsigned> app_pair2num_occs;
@@ -288,56 +349,61 @@ namespace smt {
             m_app_pair2num_occs.find(p2.first, p2.second, n2);
             SASSERT(n1 > 0);
             SASSERT(n2 > 0);
-            return n1 > n2;
+            if (n1 != n2)
+                return n1 > n2;
+            if (p1.first != p2.first)
+                return p1.first->get_id() < p2.first->get_id();
+            return p1.second->get_id() < p2.second->get_id();
         }
     };
 
+    /**
+       \brief decay the number of uses of pairs, drop the pairs whose number of uses 
+       fell below the threshold, and keep the m_dack_max_candidates most used pairs.
+    */
     void dyn_ack_manager::gc() {
         TRACE("dyn_ack", tout << "dyn_ack GC\n";);
-        unsigned num_deleted = 0;
         m_to_instantiate.reset();
         m_qhead = 0;
-        svector<app_pair>::iterator it  = m_app_pairs.begin();
-        svector<app_pair>::iterator end = m_app_pairs.end();
-        svector<app_pair>::iterator it2 = it;
-        for (; it != end; ++it) {
-            app_pair & p = *it;
-            if (m_instantiated.contains(p)) {
+        m_sketch.decay(m_params.m_dack_gc_inv_decay);
+        app_pair_set seen;
+        unsigned j = 0;
+        for (app_pair const& p : m_app_pairs) {
+            unsigned num_occs = 0;
+            // p may have been instantiated, or added twice if its instance was deleted.
+            if (m_instantiated.contains(p) || seen.contains(p) || !m_app_pair2num_occs.find(p.first, p.second, num_occs)) {
                 TRACE("dyn_ack", tout << "1) erasing:\n" << mk_pp(p.first, m) << "\n" << mk_pp(p.second, m) << "\n";);
                 m.dec_ref(p.first);
                 m.dec_ref(p.second);
-                SASSERT(!m_app_pair2num_occs.contains(p.first, p.second));
                 continue;
             }
-            unsigned num_occs = 0;
-            m_app_pair2num_occs.find(p.first, p.second, num_occs);
-            // The following invariant is not true. p.first and
-            // p.second may have been instantiated, and removed from
-            // m_app_pair2num_occs, but not from m_app_pairs.
-            //
-            // SASSERT(num_occs > 0);
             num_occs = static_cast<unsigned>(num_occs * m_params.m_dack_gc_inv_decay);
-            if (num_occs <= 1) {
-                num_deleted++;
+            if (num_occs < m_params.m_dack_threshold) {
                 TRACE("dyn_ack", tout << "2) erasing:\n" << mk_pp(p.first, m) << "\n" << mk_pp(p.second, m) << "\n";);
                 m_app_pair2num_occs.erase(p.first, p.second);
                 m.dec_ref(p.first);
                 m.dec_ref(p.second);
                 continue;
             }
-            *it2 = p;
-            ++it2;
-            SASSERT(num_occs > 0);
+            seen.insert(p);
             m_app_pair2num_occs.insert(p.first, p.second, num_occs);
-            if (num_occs >= m_params.m_dack_threshold)
-                m_to_instantiate.push_back(p);
-        }
-        m_app_pairs.set_end(it2);
-        app_pair_lt f(m_app_pair2num_occs);
-        // app_pair_lt is not a total order on pairs of expressions.
-        // So, we should use stable_sort to avoid different behavior in different platforms.
-        std::stable_sort(m_to_instantiate.begin(), m_to_instantiate.end(), f);
-        // IF_VERBOSE(10, if (num_deleted > 0) verbose_stream() << "dynamic ackermann GC: " << num_deleted << "\n";);
+            m_app_pairs[j++] = p;
+        }
+        m_app_pairs.shrink(j);
+        app_pair_lt lt(m_app_pair2num_occs);
+        unsigned k = m_params.m_dack_max_candidates;
+        if (m_app_pairs.size() > k) {
+            std::nth_element(m_app_pairs.begin(), m_app_pairs.begin() + k, m_app_pairs.end(), lt);
+            for (unsigned i = k; i < m_app_pairs.size(); ++i) {
+                app_pair const& p = m_app_pairs[i];
+                m_app_pair2num_occs.erase(p.first, p.second);
+                m.dec_ref(p.first);
+                m.dec_ref(p.second);
+            }
+            m_app_pairs.shrink(k);
+        }
+        m_to_instantiate.append(m_app_pairs);
+        std::sort(m_to_instantiate.begin(), m_to_instantiate.end(), lt);
     }
 
     class dyn_ack_clause_del_eh : public clause_del_eh {
@@ -378,6 +444,7 @@ namespace smt {
         m_num_propagations_since_last_gc++;
         if (m_num_propagations_since_last_gc > m_params.m_dack_gc) {
             gc();
+            gc_triples();
             m_num_propagations_since_last_gc = 0;
         }
         unsigned max_instances  = static_cast<unsigned>(m_context.get_num_conflicts() * m_params.m_dack_factor);
@@ -513,38 +580,36 @@ namespace smt {
             m_app_triple2num_occs.find(p2.first, p2.second, p2.third, n2);
             SASSERT(n1 > 0);
             SASSERT(n2 > 0);
-            return n1 > n2;
+            if (n1 != n2)
+                return n1 > n2;
+            if (p1.first != p2.first)
+                return p1.first->get_id() < p2.first->get_id();
+            if (p1.second != p2.second)
+                return p1.second->get_id() < p2.second->get_id();
+            return p1.third->get_id() < p2.third->get_id();
         }
     };
 
     void dyn_ack_manager::gc_triples() {
         TRACE("dyn_ack", tout << "dyn_ack GC\n";);
-        unsigned num_deleted = 0;
         m_triple.m_to_instantiate.reset();
         m_triple.m_qhead = 0;
-        svector<app_triple>::iterator it  = m_triple.m_apps.begin();
-        svector<app_triple>::iterator end = m_triple.m_apps.end();
-        svector<app_triple>::iterator it2 = it;
-        for (; it != end; ++it) {
-            app_triple & p = *it;
-            if (m_triple.m_instantiated.contains(p)) {
+        m_triple.m_sketch.decay(m_params.m_dack_gc_inv_decay);
+        app_triple_set seen;
+        auto& apps = m_triple.m_apps;
+        unsigned j = 0;
+        for (app_triple const& p : apps) {
+            unsigned num_occs = 0;
+            if (m_triple.m_instantiated.contains(p) || seen.contains(p) || 
+                !m_triple.m_app2num_occs.find(p.first, p.second, p.third, num_occs)) {
                 TRACE("dyn_ack", tout << "1) erasing:\n" << mk_pp(p.first, m) << "\n" << mk_pp(p.second, m) << "\n";);
                 m.dec_ref(p.first);
                 m.dec_ref(p.second);
                 m.dec_ref(p.third);
-                SASSERT(!m_triple.m_app2num_occs.contains(p.first, p.second, p.third));
                 continue;
             }
-            unsigned num_occs = 0;
-            m_triple.m_app2num_occs.find(p.first, p.second, p.third, num_occs);
-            // The following invariant is not true. p.first and
-            // p.second may have been instantiated, and removed from
-            // m_app_triple2num_occs, but not from m_app_triples.
-            //
-            // SASSERT(num_occs > 0);
             num_occs = static_cast<unsigned>(num_occs * m_params.m_dack_gc_inv_decay);
-            if (num_occs <= 1) {
-                num_deleted++;
+            if (num_occs < m_params.m_dack_threshold) {
                 TRACE("dyn_ack", tout << "2) erasing:\n" << mk_pp(p.first, m) << "\n" << mk_pp(p.second, m) << "\n";);
                 m_triple.m_app2num_occs.erase(p.first, p.second, p.third);
                 m.dec_ref(p.first);
@@ -552,22 +617,28 @@ namespace smt {
                 m.dec_ref(p.third);
                 continue;
             }
-            *it2 = p;
-            ++it2;
-            SASSERT(num_occs > 0);
+            seen.insert(p);
             m_triple.m_app2num_occs.insert(p.first, p.second, p.third, num_occs);
-            if (num_occs >= m_params.m_dack_threshold)
-                m_triple.m_to_instantiate.push_back(p);
-        }
-        m_triple.m_apps.set_end(it2);
-        app_triple_lt f(m_triple.m_app2num_occs);
-        // app_triple_lt is not a total order
-        std::stable_sort(m_triple.m_to_instantiate.begin(), m_triple.m_to_instantiate.end(), f);
-        // IF_VERBOSE(10, if (num_deleted > 0) verbose_stream() << "dynamic ackermann GC: " << num_deleted << "\n";);
+            apps[j++] = p;
+        }
+        apps.shrink(j);
+        app_triple_lt lt(m_triple.m_app2num_occs);
+        unsigned k = m_params.m_dack_max_candidates;
+        if (apps.size() > k) {
+            std::nth_element(apps.begin(), apps.begin() + k, apps.end(), lt);
+            for (unsigned i = k; i < apps.size(); ++i) {
+                app_triple const& p = apps[i];
+                m_triple.m_app2num_occs.erase(p.first, p.second, p.third);
+                m.dec_ref(p.first);
+                m.dec_ref(p.second);
+                m.dec_ref(p.third);
+            }
+            apps.shrink(k);
+        }
+        m_triple.m_to_instantiate.append(apps);
+        std::sort(m_triple.m_to_instantiate.begin(), m_triple.m_to_instantiate.end(), lt);
     }
 
-
-
 #ifdef Z3DEBUG
     bool dyn_ack_manager::check_invariant() const {
         for (auto const& kv : m_clause2app_pair) {
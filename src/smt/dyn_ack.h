@@ -30,6 +30,23 @@ namespace smt {
     class context;
 
     class dyn_ack_manager {
+
+        /**
+           \brief count-min sketch with conservative update.
+           Approximates the number of uses of pairs and triples that are not 
+           candidates yet, using a fixed number of counters. Estimates are never 
+           smaller than the actual count.
+        */
+        class occs_sketch {
+            static const unsigned num_rows = 4;
+            unsigned        m_mask = 0;
+            unsigned_vector m_counts;
+        public:
+            void init(unsigned num_candidates);
+            unsigned inc(unsigned h1, unsigned h2);
+            void decay(double f);
+        };
+
         typedef std::pair<app *, app *>           app_pair;
         typedef obj_pair_map<app, app, unsigned>  app_pair2num_occs;
         typedef svector<app_pair>                 app_pair_vector;
@@ -53,6 +70,7 @@ namespace smt {
         unsigned                                   m_num_propagations_since_last_gc;
         app_pair_set                               m_instantiated;
         clause2app_pair                            m_clause2app_pair;
+        occs_sketch                                m_sketch;
 
         struct _triple {
             app_triple2num_occs                    m_app2num_occs;
@@ -63,6 +81,7 @@ namespace smt {
             unsigned                               m_num_propagations_since_last_gc;
             app_triple_set                         m_instantiated;
             clause2app_triple                      m_clause2apps;
+            occs_sketch                            m_sketch;
         };
         _triple                                    m_triple;
         
@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 #include <algorithm>
+#include <chrono>
 
 #include "util/pool.h"
 #include "util/trail.h"
@@ -2912,7 +2913,11 @@ namespace {
             unsigned lbl_id   = lbl->get_small_id();
             m_trees.reserve(lbl_id+1, nullptr);
             if (m_trees[lbl_id] == nullptr) {
-                m_trees[lbl_id] = m_compiler.mk_tree(qa, mp, first_idx, false);
+                // The candidates of a tree accumulate over all the merges and new
+                // enodes seen since the last call to match, and the same enode is
+                // often added several times. Filter them so that each pending enode
+                // is matched once per round.
+                m_trees[lbl_id] = m_compiler.mk_tree(qa, mp, first_idx, true);
                 SASSERT(m_trees[lbl_id]->expected_num_args() == p->get_num_args());
                 DEBUG_CODE(m_trees[lbl_id]->set_context(m_context););
                 m_trail_stack.push(mk_tree_trail(m_trees, lbl_id));
@@ -3088,6 +3093,8 @@ namespace {
     protected:
         ast_manager &               m;
         bool                        m_use_filters;
+        bool                        m_profile = false;   // qi.profile: attribute matching time to quantifiers
+        std::chrono::steady_clock::time_point m_last_match;
         trail_stack                 m_trail_stack;
         label_hasher                m_lbl_hasher;
         code_tree_manager           m_ct_manager;
@@ -3887,12 +3894,16 @@ namespace {
 
         void match() override {
             TRACE("trigger_bug", tout << "match\n"; display(tout););
+            flet<bool> _profile(m_profile, m_context.get_fparams().m_qi_profile);
             for (code_tree* t : m_to_match) {
                 SASSERT(t->has_candidates());
+                if (m_profile)
+                    m_last_match = std::chrono::steady_clock::now();
                 if (!m_interpreter.execute(t))
                     return;
                 t->reset_candidates();
             }
+            m_profile = false;
             m_to_match.reset();
             if (!m_new_patterns.empty()) {
                 match_new_patterns();
@@ -3944,6 +3955,12 @@ namespace {
                 SASSERT(bindings[i]->get_generation() <= max_generation);
             }
 #endif
+            if (m_profile) {
+                // attribute the time since the tree started, or since its previous match, to qa
+                auto now = std::chrono::steady_clock::now();
+                m_context.add_quantifier_match_time(qa, std::chrono::duration<double>(now - m_last_match).count());
+                m_last_match = now;
+            }
             unsigned min_gen = 0, max_gen = 0;
             m_interpreter.get_min_max_top_generation(min_gen, max_gen);
             m_context.add_instance(qa, pat, num_bindings, bindings, nullptr, max_generation, min_gen, max_gen, used_enodes);
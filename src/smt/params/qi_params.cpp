@@ -37,6 +37,7 @@ void qi_params::updt_params(params_ref const & _p) {
     m_qi_cost = p.qi_cost();
     m_qi_max_eager_multipatterns = p.qi_max_multi_patterns();
     m_qi_quick_checker = static_cast<quick_checker_mode>(p.qi_quick_checker());
+    m_qi_threads = p.qi_threads();
 }
 
 #define DISPLAY_PARAM(X) out << #X"=" << X << std::endl;
@@ -54,6 +55,7 @@ void qi_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_qi_lazy_quick_checker);
     DISPLAY_PARAM(m_qi_promote_unsat);
     DISPLAY_PARAM(m_qi_max_instances);
+    DISPLAY_PARAM(m_qi_threads);
     DISPLAY_PARAM(m_qi_lazy_instantiation);
     DISPLAY_PARAM(m_qi_conservative_final_check);
     DISPLAY_PARAM(m_mbqi);
@@ -26,6 +26,7 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_auto_config = p.auto_config() && gparams::get_value("auto_config") == "true"; // auto-config is not scoped by smt in gparams.
     m_random_seed = p.random_seed();
     m_relevancy_lvl = p.relevancy();
+    m_relevancy_lazy = p.relevancy_lazy();
     m_ematching   = p.ematching();
     m_induction   = p.induction();
     m_clause_proof = p.clause_proof();
@@ -41,13 +42,23 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_theory_aware_branching = p.theory_aware_branching();
     m_delay_units = p.delay_units();
     m_delay_units_threshold = p.delay_units_threshold();
+    m_backtrack_scopes = p.backtrack_scopes();
+    m_backtrack_conflicts = p.backtrack_conflicts();
     m_preprocess = _p.get_bool("preprocess", true); // hidden parameter
     m_max_conflicts = p.max_conflicts();
+    m_core_minimize_fast = p.core_minimize_fast();
+    m_core_minimize_fast_conflicts = p.core_minimize_fast_conflicts();
     m_restart_max   = p.restart_max();
     m_cube_depth    = p.cube_depth();
     m_threads       = p.threads();
     m_threads_max_conflicts  = p.threads_max_conflicts();
     m_threads_cube_frequency = p.threads_cube_frequency();
+    m_lemma_cache = p.lemma_cache();
+    m_lemma_cache_max_size = p.lemma_cache_max_size();
+    m_recfun_eval_steps = p.recfun_eval_steps();
+    m_phase_profile = p.phase_profile();
+    m_phase_profile_file = p.phase_profile_file();
+    m_fpa_lazy = p.fpa_lazy();
     m_core_validate = p.core_validate();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
@@ -106,6 +117,7 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_binary_clause_opt);
     DISPLAY_PARAM(m_relevancy_lvl);
     DISPLAY_PARAM(m_relevancy_lemma);
+    DISPLAY_PARAM(m_relevancy_lazy);
     DISPLAY_PARAM(m_random_seed);
     DISPLAY_PARAM(m_random_var_freq);
     DISPLAY_PARAM(m_inv_decay);
@@ -118,6 +130,12 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_max_conflicts);
     DISPLAY_PARAM(m_cube_depth);
     DISPLAY_PARAM(m_threads);
+    DISPLAY_PARAM(m_lemma_cache);
+    DISPLAY_PARAM(m_lemma_cache_max_size);
+    DISPLAY_PARAM(m_recfun_eval_steps);
+    DISPLAY_PARAM(m_phase_profile);
+    DISPLAY_PARAM(m_phase_profile_file);
+    DISPLAY_PARAM(m_fpa_lazy);
     DISPLAY_PARAM(m_threads_max_conflicts);
     DISPLAY_PARAM(m_threads_cube_frequency);
     DISPLAY_PARAM(m_simplify_clauses);
@@ -135,6 +153,8 @@ void smt_params::display(std::ostream & out) const {
 
     DISPLAY_PARAM(m_delay_units);
     DISPLAY_PARAM(m_delay_units_threshold);
+    DISPLAY_PARAM(m_backtrack_scopes);
+    DISPLAY_PARAM(m_backtrack_conflicts);
 
     DISPLAY_PARAM(m_theory_resolve);
 
@@ -173,6 +193,8 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_progress_sampling_freq);
 
     DISPLAY_PARAM(m_core_validate);
+    DISPLAY_PARAM(m_core_minimize_fast);
+    DISPLAY_PARAM(m_core_minimize_fast_conflicts);
 
     DISPLAY_PARAM(m_preprocess);
     DISPLAY_PARAM(m_user_theory_preprocess_axioms);
@@ -69,7 +69,8 @@ enum case_split_strategy {
     CS_RELEVANCY, // case split based on relevancy
     CS_RELEVANCY_ACTIVITY, // case split based on relevancy and activity
     CS_RELEVANCY_GOAL, // based on relevancy and the current goal
-    CS_ACTIVITY_THEORY_AWARE_BRANCHING // activity-based case split, but theory solvers can manipulate activity
+    CS_ACTIVITY_THEORY_AWARE_BRANCHING, // activity-based case split, but theory solvers can manipulate activity
+    CS_CONFLICT_HISTORY // case split based on conflict history (CHB), theory solvers can add priorities
 };
 
 struct smt_params : public preprocessor_params,
@@ -90,6 +91,7 @@ struct smt_params : public preprocessor_params,
     bool             m_binary_clause_opt = true;
     unsigned         m_relevancy_lvl = 2;
     bool             m_relevancy_lemma = false;
+    bool             m_relevancy_lazy = false;
     unsigned         m_random_seed = 0;
     double           m_random_var_freq = 0.01;
     double           m_inv_decay = 1.052;
@@ -100,11 +102,19 @@ struct smt_params : public preprocessor_params,
     unsigned         m_phase_caching_off = 100;
     bool             m_minimize_lemmas = true;
     unsigned         m_max_conflicts = UINT_MAX;
+    bool             m_core_minimize_fast = false;
+    unsigned         m_core_minimize_fast_conflicts = 1000;
     unsigned         m_restart_max;
     unsigned         m_cube_depth = 1;
     unsigned         m_threads = 1;
     unsigned         m_threads_max_conflicts = UINT_MAX;
     unsigned         m_threads_cube_frequency = 2;
+    bool             m_lemma_cache = false;
+    bool             m_fpa_lazy = false;
+    unsigned         m_lemma_cache_max_size = 32;
+    unsigned         m_recfun_eval_steps = 100000;
+    bool             m_phase_profile = false;
+    symbol           m_phase_profile_file;
     bool             m_simplify_clauses = true;
     unsigned         m_tick = 1000;
     bool             m_display_features = false;
@@ -133,6 +143,14 @@ struct smt_params : public preprocessor_params,
     bool             m_delay_units = false;
     unsigned         m_delay_units_threshold = 32;
 
+    // -----------------------------------
+    //
+    // Chronological backtracking
+    //
+    // -----------------------------------
+    unsigned         m_backtrack_scopes = 100;
+    unsigned         m_backtrack_conflicts = 4000;
+
     // -----------------------------------
     //
     // Conflict resolution
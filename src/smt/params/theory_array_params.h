@@ -35,6 +35,7 @@ struct theory_array_params {
     bool            m_array_extensional = true;
     unsigned        m_array_laziness = 1;
     bool            m_array_delay_exp_axiom = true;
+    bool            m_array_lazy_axioms = false;       // instantiate read-over-write axioms at final check, only if the e-graph violates them
     bool            m_array_cg = false;
     bool            m_array_always_prop_upward = true;
     bool            m_array_lazy_ieq = false;
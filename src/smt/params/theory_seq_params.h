@@ -23,6 +23,10 @@ struct theory_seq_params {
      * Enable splitting guided by length constraints
      */
     bool m_split_w_len = false;
+    /*
+     * Add the lengths of both sides of word equations when they are asserted
+     */
+    bool m_seq_eager_length = false;
     bool m_seq_validate = false;
     unsigned m_seq_max_unfolding = UINT_MAX/4;
     unsigned m_seq_min_unfolding = 1;
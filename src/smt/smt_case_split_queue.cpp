@@ -1243,6 +1243,156 @@ namespace {
 
         }
     };
+
+    /**
+       \brief Case split queue based on conflict history (CHB).
+
+       The score of a variable is an exponential moving average of the
+       rewards it receives when it is assigned or takes part in conflict
+       resolution. The reward is higher the more recently the variable took
+       part in a conflict, so the score estimates the rate at which deciding
+       on the variable leads to learned clauses. The step size decays from
+       0.4 to 0.06 with the number of conflicts.
+
+       Theories contribute to the score through add_theory_aware_branching_info:
+       the priority is added to the score and the phase is used when the
+       variable is chosen.
+    */
+    class chb_case_split_queue : public case_split_queue {
+        context &               m_context;
+        smt_params &            m_params;
+        svector<double>         m_score;
+        unsigned_vector         m_last_conflict;    // number of conflicts when the variable last took part in one
+        theory_var_priority_map m_theory_var_priority;
+        map<bool_var, lbool, int_hash, default_eq<bool_var> > m_theory_var_phase;
+        theory_aware_act_queue  m_queue;
+        double                  m_step = 0.4;
+        unsigned                m_num_conflicts = 0; // conflicts seen at the last update
+
+        void update(bool_var v, double multiplier) {
+            unsigned num_conflicts = m_context.get_num_conflicts();
+            if (num_conflicts != m_num_conflicts) {
+                m_step -= 1e-6 * (num_conflicts - m_num_conflicts);
+                if (m_step < 0.06)
+                    m_step = 0.06;
+                m_num_conflicts = num_conflicts;
+            }
+            double reward = multiplier / (num_conflicts - m_last_conflict[v] + 1);
+            double old_score = m_score[v];
+            m_score[v] = (1.0 - m_step) * old_score + m_step * reward;
+            if (m_queue.contains(v)) {
+                if (m_score[v] > old_score)
+                    m_queue.decreased(v);
+                else
+                    m_queue.increased(v);
+            }
+        }
+
+    public:
+        chb_case_split_queue(context & ctx, smt_params & p):
+            m_context(ctx),
+            m_params(p),
+            m_queue(1024, theory_aware_act_lt(m_score, m_theory_var_priority)) {
+        }
+
+        void activity_increased_eh(bool_var v) override {
+            // v takes part in the resolution of the current conflict
+            m_last_conflict[v] = m_context.get_num_conflicts();
+            update(v, 1.0);
+        }
+
+        void activity_decreased_eh(bool_var v) override {}
+
+        void mk_var_eh(bool_var v) override {
+            m_score.reserve(v+1, 0.0);
+            m_last_conflict.reserve(v+1, 0);
+            m_score[v] = 0.0;
+            m_last_conflict[v] = m_context.get_num_conflicts();
+            m_queue.reserve(v+1);
+            if (!m_queue.contains(v))
+                m_queue.insert(v);
+        }
+
+        void del_var_eh(bool_var v) override {
+            if (m_queue.contains(v))
+                m_queue.erase(v);
+        }
+
+        void assign_lit_eh(literal l) override {
+            // assignments that follow a conflict are rewarded fully
+            update(l.var(), m_context.get_num_conflicts() != m_num_conflicts ? 1.0 : 0.9);
+        }
+
+        void unassign_var_eh(bool_var v) override {
+            if (!m_queue.contains(v))
+                m_queue.insert(v);
+        }
+
+        void relevant_eh(expr * n) override {}
+
+        void init_search_eh() override {}
+
+        void end_search_eh() override {}
+
+        void reset() override {
+            m_queue.reset();
+        }
+
+        void push_scope() override {}
+
+        void pop_scope(unsigned num_scopes) override {}
+
+        void next_case_split(bool_var & next, lbool & phase) override {
+            phase = l_undef;
+
+            if (m_context.get_random_value() < static_cast<int>(m_params.m_random_var_freq * random_gen::max_value())) {
+                next = m_context.get_random_value() % m_context.get_num_b_internalized();
+                TRACE("random_split", tout << "next: " << next << " get_assignment(next): " << m_context.get_assignment(next) << "\n";);
+                if (m_context.get_assignment(next) == l_undef)
+                    return;
+            }
+
+            while (!m_queue.empty()) {
+                next = m_queue.erase_min();
+                if (m_context.get_assignment(next) == l_undef) {
+                    if (!m_theory_var_phase.find(next, phase))
+                        phase = l_undef;
+                    return;
+                }
+            }
+
+            next = null_bool_var;
+        }
+
+        void add_theory_aware_branching_info(bool_var v, double priority, lbool phase) override {
+            TRACE("theory_aware_branching", tout << "Add theory-aware branching information for l#" << v << ": priority=" << priority << "\n";);
+            double old_priority = 0.0;
+            m_theory_var_priority.find(v, old_priority);
+            m_theory_var_priority.insert(v, priority);
+            m_theory_var_phase.insert(v, phase);
+            if (m_queue.contains(v)) {
+                if (priority > old_priority)
+                    m_queue.decreased(v);
+                else
+                    m_queue.increased(v);
+            }
+        }
+
+        void display(std::ostream & out) override {
+            bool first = true;
+            for (unsigned v : m_queue) {
+                if (m_context.get_assignment(v) == l_undef) {
+                    if (first) {
+                        out << "remaining case-splits:\n";
+                        first = false;
+                    }
+                    out << "#" << m_context.bool_var2expr(v)->get_id() << ":" << m_score[v] << " ";
+                }
+            }
+            if (!first)
+                out << "\n";
+        }
+    };
 }
 
 namespace smt {
@@ -1270,6 +1420,8 @@ namespace smt {
             return alloc(rel_goal_case_split_queue, ctx, p);
         case CS_ACTIVITY_THEORY_AWARE_BRANCHING:
             return alloc(theory_aware_branching_queue, ctx, p);
+        case CS_CONFLICT_HISTORY:
+            return alloc(chb_case_split_queue, ctx, p);
         default:
             return alloc(act_case_split_queue, ctx, p);
         }
@@ -482,6 +482,18 @@ namespace smt {
             mk_conflict_proof(conflict, not_l);
     }
 
+    /**
+       \brief Instance clauses of a quantifier q contain the literal ~q.
+       Attribute the use of cls in the conflict to those quantifiers.
+    */
+    void conflict_resolution::update_quantifier_profile(clause const & cls) {
+        for (literal l : cls) {
+            expr * e = m_ctx.bool_var2expr(l.var());
+            if (l.sign() && e && is_quantifier(e))
+                m_ctx.inc_quantifier_conflicts(to_quantifier(e));
+        }
+    }
+
     bool conflict_resolution::resolve(b_justification conflict, literal not_l) {
         b_justification js;
         literal consequent;
@@ -523,6 +535,8 @@ namespace smt {
                 TRACE("conflict_smt2", m_ctx.display_clause_smt2(tout, *cls););
                 if (cls->is_lemma())
                     cls->inc_clause_activity();
+                if (m_params.m_qi_profile)
+                    update_quantifier_profile(*cls);
                 unsigned num_lits = cls->get_num_literals();
                 unsigned i        = 0;
                 if (consequent != false_literal) {
@@ -738,6 +752,7 @@ namespace smt {
        assigned in the base levels.
     */
     void conflict_resolution::minimize_lemma() {
+        phase_profiler::scope _ph(m_ctx.get_phase_profiler(), phase_profiler::PH_MINIMIZE);
         m_unmark.reset();
 
         m_lvl_set   = get_lemma_approx_level_set();
@@ -177,6 +177,7 @@ namespace smt {
         unsigned get_max_lvl(literal consequent, b_justification js);
         unsigned skip_literals_above_conflict_level();
         void process_antecedent(literal antecedent, unsigned & num_marks);
+        void update_quantifier_profile(clause const & cls);
         void process_justification(literal consequent, justification * js, unsigned & num_marks);
 
         bool_var_vector m_unmark;
@@ -70,7 +70,9 @@ namespace smt {
         m_l_internalized_stack(m),
         m_final_check_idx(0),
         m_cg_table(m),
+        m_lemma_cache(m),
         m_units_to_reassert(m),
+        m_hints(m),
         m_conflict(null_b_justification),
         m_not_l(null_literal),
         m_conflict_resolution(mk_conflict_resolution(m, *this, m_dyn_ack_manager, p, m_assigned_literals, m_watches)),
@@ -119,7 +121,7 @@ namespace smt {
         return std::min(m_relevancy_lvl, m_fparams.m_relevancy_lvl);
     }
 
-    void context::copy(context& src_ctx, context& dst_ctx, bool override_base) {
+    void context::copy(context& src_ctx, context& dst_ctx, bool override_base, bool copy_learned) {
         ast_manager& dst_m = dst_ctx.get_manager();
         ast_manager& src_m = src_ctx.get_manager();
         src_ctx.pop_to_base_lvl();
@@ -173,6 +175,9 @@ namespace smt {
 
         dst_ctx.setup_context(dst_ctx.m_fparams.m_auto_config);
         dst_ctx.internalize_assertions();
+
+        if (copy_learned && !src_m.proofs_enabled()) 
+            copy_lemmas(src_ctx, dst_ctx, tr);
         
         dst_ctx.copy_user_propagator(src_ctx, true);
 
@@ -181,6 +186,30 @@ namespace smt {
               dst_ctx.display(tout););
     }
 
+    void context::copy_lemmas(context& src_ctx, context& dst_ctx, ast_translation& tr) {
+        ast_manager& src_m = src_ctx.get_manager();
+        literal_vector lits;
+        for (clause* cls : src_ctx.m_lemmas) {
+            lits.reset();
+            bool safe = true;
+            for (literal lit : *cls) {
+                bool_var_data const & d = src_ctx.get_bdata(lit.var());
+                if (d.is_theory_atom() && !src_ctx.m_theories.get_plugin(d.get_theory())->is_safe_to_copy(lit.var())) {
+                    safe = false;
+                    break;
+                }
+                expr_ref e(src_ctx.bool_var2expr(lit.var()), src_m);
+                expr* de = tr(e.get());
+                dst_ctx.internalize(de, true);
+                literal dl = dst_ctx.get_literal(de);
+                lits.push_back(lit.sign() ? ~dl : dl);
+            }
+            if (safe && !dst_ctx.inconsistent())
+                dst_ctx.mk_clause(lits.size(), lits.data(), nullptr, CLS_TH_LEMMA);
+        }
+        TRACE("smt_context", tout << "copied " << src_ctx.m_lemmas.size() << " lemmas\n";);
+    }
+
     context::~context() {
         flush();
         m_asserted_formulas.finalize();
@@ -1124,7 +1153,6 @@ namespace smt {
             m.dec_ref(m_is_diseq_tmp->get_expr());
             app * eq = m.mk_eq(n1->get_expr(), n2->get_expr());
             m.inc_ref(eq);
-            m_is_diseq_tmp->m_func_decl_id = UINT_MAX;
             m_is_diseq_tmp->m_owner = eq;
         }
         m_is_diseq_tmp->m_args[0] = n1;
@@ -1696,14 +1724,18 @@ namespace smt {
      */
     bool context::propagate() {
         TRACE("propagate", tout << "propagating... " << m_qhead << ":" << m_assigned_literals.size() << "\n";);
+        phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_PROPAGATE);
         while (true) {
             if (inconsistent())
                 return false;
             unsigned qhead = m_qhead;
             {
                 scoped_suspend_rlimit _suspend_cancel(m.limit(), at_base_level());
-                if (!bcp())
-                    return false;
+                {
+                    phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_BCP);
+                    if (!bcp())
+                        return false;
+                }
                 if (!propagate_th_case_split(qhead))
                     return false;
                 SASSERT(!inconsistent());
@@ -1718,11 +1750,13 @@ namespace smt {
                 propagate_th_diseqs();
                 if (inconsistent())
                     return false;
+                phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_THEORY_PROPAGATE);
                 if (!propagate_theories())
                     return false;
             }
             if (!get_cancel_flag()) {
 //                scoped_suspend_rlimit _suspend_cancel(m.limit(), at_base_level());
+                phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_QUANTIFIERS);
                 m_qmanager->propagate();
             }
             if (inconsistent())
@@ -1839,6 +1873,7 @@ namespace smt {
        more case splits to be performed.
     */
     bool context::decide() {
+        phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_DECIDE);
 
         if (at_search_level() && !m_tmp_clauses.empty()) {
             switch (decide_clause()) {
@@ -2423,6 +2458,16 @@ namespace smt {
 
             if (new_lvl < m_base_lvl) {
                 base_scope & bs = m_base_scopes[new_lvl];
+                if (m_fparams.m_lemma_cache) {
+                    for (unsigned i = bs.m_lemmas_lim; i < m_lemmas.size(); ++i) {
+                        clause* cls = m_lemmas[i];
+                        if (cls->is_th_lemma() && !cls->deleted())
+                            cache_lemma(cls->get_num_literals(), cls->begin(), false);
+                    }
+                    for (unsigned& lvl : m_lemma_cache_lvl)
+                        if (lvl != UINT_MAX && lvl > new_lvl)
+                            lvl = UINT_MAX;
+                }
                 del_clauses(m_lemmas, bs.m_lemmas_lim);
                 m_simp_qhead = bs.m_simp_qhead_lim;
                 if (!bs.m_inconsistent) {
@@ -2656,6 +2701,7 @@ namespace smt {
         // Remark: when assumptions are used m_scope_lvl >= m_search_lvl > m_base_lvl. Therefore, no simplification is performed.
         if (m_scope_lvl > m_base_lvl)
             return;
+        phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_SIMPLIFY);
 
         unsigned sz = m_assigned_literals.size();
         SASSERT(m_simp_qhead <= sz);
@@ -2785,6 +2831,30 @@ namespace smt {
         IF_VERBOSE(2, verbose_stream() << " :num-deleted-clauses " << num_del_cls << ")" << std::endl;);
     }
 
+    /**
+       \brief The memory governor reports pressure when the allocated memory
+       approaches the memory limit. Inactive lemmas are then deleted four
+       times as often, and under the highest pressure the rewriter caches are
+       flushed as well.
+    */
+    bool context::should_reduce_memory() const {
+        return
+            m_num_conflicts_since_lemma_gc > m_lemma_gc_threshold / 4 &&
+            memory::get_pressure() != memory::NO_PRESSURE;
+    }
+
+    void context::reduce_memory() {
+        memory::pressure p = memory::get_pressure();
+        IF_VERBOSE(2, verbose_stream() << "(smt.reduce-memory :memory " << mem_stat() << ")\n";);
+        m_stats.m_num_memory_reductions++;
+        del_inactive_lemmas1();
+        m_num_conflicts_since_lemma_gc = 0;
+        if (p == memory::EVICT_PRESSURE) {
+            m_rewriter.reset();
+            m_asserted_formulas.flush_cache();
+        }
+    }
+
     /**
        \brief More sophisticated version of del_inactive_lemmas. Here the lemmas are divided in two
        groups (old and new) based on the value of m_new_old_ratio parameter.
@@ -2910,6 +2980,15 @@ namespace smt {
         register_plugin(m_user_propagator);
     }
 
+    void context::user_propagate_register_native(user_propagator::native* p) {
+        setup_context(false);
+        m_user_propagator = alloc(theory_user_propagator, *this);
+        m_user_propagator->register_native(p);
+        for (unsigned i = m_scopes.size(); i-- > 0; ) 
+            m_user_propagator->push_scope_eh();
+        register_plugin(m_user_propagator);
+    }
+
     bool context::watches_fixed(enode* n) const {
         return m_user_propagator && m_user_propagator->has_fixed() && n->get_th_var(m_user_propagator->get_family_id()) != null_theory_var;
     }
@@ -2981,6 +3060,58 @@ namespace smt {
         SASSERT(m_base_lvl <= m_scope_lvl);
     }
 
+    void context::cache_lemma(unsigned num_lits, literal const* lits, bool active) {
+        if (!m_fparams.m_lemma_cache || m.proofs_enabled() || num_lits > m_fparams.m_lemma_cache_max_size)
+            return;
+        expr_ref_vector disj(m);
+        for (unsigned i = 0; i < num_lits; ++i) {
+            expr_ref e(m);
+            literal2expr(lits[i], e);
+            disj.push_back(e);
+        }
+        std::sort(disj.data(), disj.data() + disj.size(), ast_lt_proc());
+        expr_ref fml = mk_or(disj);
+        if (m_lemma_cache_set.contains(fml))
+            return;
+        m_lemma_cache_set.insert(fml);
+        m_lemma_cache.push_back(fml);
+        m_lemma_cache_lvl.push_back(active ? m_base_lvl : UINT_MAX);
+    }
+
+    /**
+       \brief Re-add cached theory lemmas whose atoms are all internalized.
+    */
+    void context::reinject_cached_lemmas() {
+        if (!m_fparams.m_lemma_cache)
+            return;
+        literal_vector lits;
+        unsigned num_added = 0;
+        for (unsigned i = 0; i < m_lemma_cache.size() && !inconsistent(); ++i) {
+            if (m_lemma_cache_lvl[i] != UINT_MAX)
+                continue;
+            expr* fml = m_lemma_cache.get(i);
+            bool is_disj = m.is_or(fml);
+            unsigned n = is_disj ? to_app(fml)->get_num_args() : 1;
+            expr* const* args = is_disj ? to_app(fml)->get_args() : &fml;
+            lits.reset();
+            for (unsigned j = 0; j < n; ++j) {
+                expr* a = args[j];
+                bool sign = m.is_not(a, a);
+                if (!b_internalized(a))
+                    break;
+                literal l = get_literal(a);
+                lits.push_back(sign ? ~l : l);
+            }
+            if (lits.size() != n)
+                continue;
+            m_lemma_cache_lvl[i] = m_base_lvl;
+            mk_clause(lits.size(), lits.data(), nullptr, CLS_TH_LEMMA);
+            ++num_added;
+        }
+        m_stats.m_num_cached_lemmas += num_added;
+        IF_VERBOSE(10, if (num_added > 0) verbose_stream() << "(smt.lemma-cache :added " << num_added << " :size " << m_lemma_cache.size() << ")\n";);
+    }
+
     void context::pop(unsigned num_scopes) {
         SASSERT (num_scopes > 0);
         if (num_scopes > m_scope_lvl) return;
@@ -3036,6 +3167,13 @@ namespace smt {
         assert_expr_core(e, pr);
     }
 
+    void context::assert_expr(unsigned n, expr * const * es) {
+        timeit tt(get_verbosity_level() >= 100, "smt.simplifying");
+        if (get_cancel_flag()) return;
+        pop_to_base_lvl();
+        m_asserted_formulas.assert_expr(n, es);
+    }
+
     class case_split_insert_trail : public trail {
         context& ctx;
         literal l;
@@ -3154,6 +3292,7 @@ namespace smt {
     void context::reduce_assertions() {
         if (!m_asserted_formulas.inconsistent()) {
             // SASSERT(at_base_level());
+            scoped_watch _sw(m_phase_watches.m_preprocess);
             m_asserted_formulas.reduce();
         }
     }
@@ -3213,6 +3352,7 @@ namespace smt {
             }
             qhead = m_asserted_formulas.get_qhead();
             unsigned sz = m_asserted_formulas.get_num_formulas();
+            scoped_watch _sw(m_phase_watches.m_internalize);
             while (qhead < sz) {
                 if (get_cancel_flag()) {
                     m_asserted_formulas.commit(qhead);
@@ -3617,6 +3757,7 @@ namespace smt {
             pop_to_base_lvl();
             expr_ref_vector asms(m, num_assumptions, assumptions);
             internalize_assertions();
+            reinject_cached_lemmas();
             add_theory_assumptions(asms);                
             TRACE("unsat_core_bug", tout << asms << "\n";);        
             init_assumptions(asms);
@@ -3626,9 +3767,62 @@ namespace smt {
         }
         while (should_research(r));
         r = check_finalize(r);
+        if (r == l_false && m_fparams.m_core_minimize_fast && !m_trimming_core && m_unsat_core.size() > 1)
+            trim_unsat_core();
         return r;
     }
 
+    /**
+       \brief deletion based trimming of the unsat core. Each assumption
+       of the core is dropped in turn and the others are checked with a
+       conflict budget, in this context so that the lemmas learned while
+       finding the core are reused. When the check is unsat, its core
+       replaces the remaining candidates, otherwise the assumption is
+       kept. Assumptions whose check ran out of budget are kept as well.
+    */
+    void context::trim_unsat_core() {
+        flet<bool> _trimming(m_trimming_core, true);
+        flet<unsigned> _max_conflicts(m_fparams.m_max_conflicts, std::min(m_fparams.m_max_conflicts, m_fparams.m_core_minimize_fast_conflicts));
+        failure last_failure = m_last_search_failure;
+        expr_ref_vector keep(m), todo(m_unsat_core), asms(m), core(m);
+        unsigned old_size = todo.size();
+        while (!todo.empty() && m.inc()) {
+            expr_ref a(todo.back(), m);
+            todo.pop_back();
+            asms.reset();
+            asms.append(keep);
+            asms.append(todo);
+            lbool r = check(asms.size(), asms.data(), false);
+            if (r != l_false) {
+                keep.push_back(a);
+                continue;
+            }
+            core.reset();
+            core.append(m_unsat_core);
+            expr_mark in_core;
+            for (expr* e : core)
+                in_core.mark(e);
+            unsigned j = 0;
+            for (expr* e : keep)
+                if (in_core.is_marked(e))
+                    keep[j++] = e;
+            keep.shrink(j);
+            j = 0;
+            for (expr* e : todo)
+                if (in_core.is_marked(e))
+                    todo[j++] = e;
+            todo.shrink(j);
+        }
+        pop_to_base_lvl();
+        m_unsat_core.reset();
+        m_unsat_core.append(keep);
+        m_unsat_core.append(todo);
+        std::sort(m_unsat_core.data(), m_unsat_core.data() + m_unsat_core.size(), ast_lt_proc());
+        m_last_search_failure = last_failure;
+        m_stats.m_num_core_trimmed += old_size - m_unsat_core.size();
+        IF_VERBOSE(2, verbose_stream() << "(smt.trim-core :before " << old_size << " :after " << m_unsat_core.size() << ")\n");
+    }
+
     lbool context::check(expr_ref_vector const& cube, vector<expr_ref_vector> const& clauses) {
         if (!check_preamble(true)) return l_undef;
         TRACE("before_search", display(tout););
@@ -3638,6 +3832,7 @@ namespace smt {
             pop_to_base_lvl();
             expr_ref_vector asms(cube);
             internalize_assertions();
+            reinject_cached_lemmas();
             add_theory_assumptions(asms);
             // introducing proxies: if (!validate_assumptions(asms)) return l_undef;
             for (auto const& clause : clauses) if (!validate_assumptions(clause)) return l_undef;
@@ -3674,6 +3869,7 @@ namespace smt {
         m_phase_default                = false;
         m_case_split_queue             ->init_search_eh();
         m_next_progress_sample         = 0;
+        apply_hints();
         TRACE("literal_occ", display_literal_num_occs(tout););
     }
 
@@ -3723,11 +3919,15 @@ namespace smt {
         if (get_cancel_flag())
             return l_undef;
         timeit tt(get_verbosity_level() >= 100, "smt.stats");
+        scoped_watch _sw(m_phase_watches.m_search);
+        m_phase_profiler.set_enabled(m_fparams.m_phase_profile);
+        phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_SEARCH);
         reset_model();
         SASSERT(at_search_level());
         TRACE("search", display(tout); display_enodes_lbls(tout););
         TRACE("search_detail", m_asserted_formulas.display(tout););
         init_search();
+        m_stats_callback.start();
         flet<bool> l(m_searching, true);
         TRACE("after_init_search", display(tout););
         IF_VERBOSE(2, verbose_stream() << "(smt.searching)\n";);
@@ -3759,6 +3959,7 @@ namespace smt {
 
     bool context::restart(lbool& status, unsigned curr_lvl) {
         SASSERT(status != l_true || !inconsistent());
+        phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_RESTART);
 
         reset_model();
 
@@ -3890,6 +4091,9 @@ namespace smt {
                     (m_fparams.m_lemma_gc_strategy == LGC_FIXED || m_fparams.m_lemma_gc_strategy == LGC_GEOMETRIC)) {
                     del_inactive_lemmas();
                 }
+                else if (should_reduce_memory()) {
+                    reduce_memory();
+                }
 
                 m_dyn_ack_manager.propagate_eh();
                 CASSERT("dyn_ack", check_clauses(m_lemmas) && check_clauses(m_aux_clauses));
@@ -3934,6 +4138,12 @@ namespace smt {
             if (m_last_search_failure != OK)
                 return true;
 
+            if (m_stats_callback.due()) {
+                ::statistics st;
+                collect_statistics(st);
+                m_stats_callback.report(st, m_stats.m_num_conflicts);
+            }
+
             if (get_cancel_flag()) {
                 m_last_search_failure = CANCELED;
                 return true;
@@ -3963,6 +4173,8 @@ namespace smt {
 
     final_check_status context::final_check() {
         TRACE("final_check", tout << "final_check inconsistent: " << inconsistent() << "\n"; display(tout); display_normalized_enodes(tout););
+        scoped_watch _sw(m_phase_watches.m_final_check);
+        phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_FINAL_CHECK);
         CASSERT("relevancy", check_relevancy());
         
         if (m_fparams.m_model_on_final_check) {
@@ -3974,7 +4186,11 @@ namespace smt {
         m_stats.m_num_final_checks++;
         TRACE("final_check_stats", tout << "m_stats.m_num_final_checks = " << m_stats.m_num_final_checks << "\n";);
 
-        final_check_status ok = m_qmanager->final_check_eh(false);
+        final_check_status ok;
+        {
+            phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_QUANTIFIERS);
+            ok = m_qmanager->final_check_eh(false);
+        }
         if (ok != FC_DONE)
             return ok;
 
@@ -3992,6 +4208,8 @@ namespace smt {
             if (m_final_check_idx < num_th) {
                 theory * th = m_theory_set[m_final_check_idx];
                 IF_VERBOSE(100, verbose_stream() << "(smt.final-check \"" << th->get_name() << "\")\n";);
+                unsigned ph = m_phase_profiler.enabled() ? m_phase_profiler.mk_phase(th->get_name()) : 0;
+                phase_profiler::scope _ph(m_phase_profiler, ph);
                 ok = th->final_check_eh();
                 TRACE("final_check_step", tout << "final check '" << th->get_name() << " ok: " << ok << " inconsistent " << inconsistent() << "\n";);
                 if (ok == FC_GIVEUP) {
@@ -4000,6 +4218,7 @@ namespace smt {
                 }
             }
             else {
+                phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_QUANTIFIERS);
                 ok = m_qmanager->final_check_eh(true);
                 TRACE("final_check_step", tout << "quantifier  ok: " << ok << " " << "inconsistent " << inconsistent() << "\n";);
             }
@@ -4058,7 +4277,23 @@ namespace smt {
     }
 
 
+    /**
+       \brief Return true if the conflict should be resolved by backtracking
+       chronologically to the level below the conflict level instead of
+       backjumping to new_lvl. Theory solvers with expensive re-propagation
+       benefit from keeping the trail when the backjump is long.
+    */
+    bool context::use_chronological_backtracking(unsigned num_lits, unsigned conflict_lvl, unsigned new_lvl) const {
+        return 
+            num_lits > 1 &&
+            m_num_conflicts > m_fparams.m_backtrack_conflicts &&
+            conflict_lvl > new_lvl + 1 &&
+            conflict_lvl - new_lvl > m_fparams.m_backtrack_scopes &&
+            !m.proofs_enabled();
+    }
+
     bool context::resolve_conflict() {
+        phase_profiler::scope _ph(m_phase_profiler, phase_profiler::PH_CONFLICT);
         m_stats.m_num_conflicts++;
         m_num_conflicts ++;
         m_num_conflicts_since_restart ++;
@@ -4105,6 +4340,13 @@ namespace smt {
             if (delay_forced_restart) {
                 new_lvl = conflict_lvl - 1;
             }
+            else if (use_chronological_backtracking(num_lits, conflict_lvl, new_lvl)) {
+                // Undo only the conflict level. The asserting literal is then assigned
+                // above its implication level, and the lemma is put on the reinit stack
+                // by mk_clause so that it propagates again when that level is backtracked.
+                new_lvl = conflict_lvl - 1;
+                m_stats.m_num_backtracks++;
+            }
 
             // Some of the literals/enodes of the conflict clause will be destroyed during
             // backtracking, and will need to be recreated. However, I want to keep
@@ -4587,6 +4829,7 @@ namespace smt {
         }     
         else if (m_fparams.m_model || m_fparams.m_model_on_final_check || 
                  (m_qmanager->has_quantifiers() && m_qmanager->model_based())) {
+            scoped_watch _sw(m_phase_watches.m_model);
             m_model_generator->reset();
             m_proto_model = m_model_generator->mk_model();
             m_qmanager->adjust_model(m_proto_model.get());
@@ -4670,6 +4913,80 @@ namespace smt {
     }
 
 
+    void context::get_hints(expr_ref_vector& result) {
+        expr_ref_vector units(m);
+        get_units(units);
+        result.append(units);
+        expr_mark is_unit;
+        for (expr* u : units) {
+            m.is_not(u, u);
+            is_unit.mark(u);
+        }
+        bool_var_vector vars;
+        for (bool_var v = 0; v < static_cast<bool_var>(get_num_bool_vars()); ++v) {
+            expr* e = bool_var2expr(v);
+            if (e && !is_unit.is_marked(e))
+                vars.push_back(v);
+        }
+        std::stable_sort(vars.begin(), vars.end(), [&](bool_var a, bool_var b) { return m_activity[a] > m_activity[b]; });
+        for (bool_var v : vars) {
+            bool_var_data const& d = get_bdata(v);
+            bool phase = d.m_phase_available ? d.m_phase : m_phase_default;
+            result.push_back(literal2expr(literal(v, !phase)));
+        }
+        // short lemmas over atoms that are not units
+        expr_ref_vector lits(m);
+        for (clause* cls : m_lemmas) {
+            if (cls->get_num_literals() > 3)
+                continue;
+            lits.reset();
+            for (literal l : *cls) {
+                expr* e = bool_var2expr(l.var());
+                if (!e || is_unit.is_marked(e))
+                    break;
+                lits.push_back(literal2expr(l));
+            }
+            if (lits.size() == cls->get_num_literals())
+                result.push_back(m.mk_or(lits));
+        }
+    }
+
+    /**
+       \brief set the phase of the atoms of literal hints and prefer the atoms of
+       all hints for case splits, atoms of earlier hints are preferred most.
+    */
+    void context::apply_hints() {
+        if (m_hints.empty())
+            return;
+        double act = 0;
+        for (double a : m_activity)
+            act = std::max(act, a);
+        auto prefer = [&](expr* e) {
+            if (!b_internalized(e))
+                return null_bool_var;
+            bool_var v = get_bool_var(e);
+            act += 1;
+            set_activity(v, act);
+            activity_changed(v, true);
+            return v;
+        };
+        for (unsigned i = m_hints.size(); i-- > 0; ) {
+            expr* h = m_hints.get(i);
+            if (m.is_or(h)) {
+                for (expr* arg : *to_app(h)) {
+                    m.is_not(arg, arg);
+                    prefer(arg);
+                }
+                continue;
+            }
+            bool is_neg = m.is_not(h, h);
+            bool_var v = prefer(h);
+            if (v != null_bool_var)
+                force_phase(v, !is_neg);
+        }
+        m_hints.reset();
+    }
+
     failure context::get_last_search_failure() const {
         return m_last_search_failure;
     }
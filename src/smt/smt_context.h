@@ -31,6 +31,7 @@ Revision History:
 #include "smt/smt_theory.h"
 #include "smt/smt_quantifier.h"
 #include "smt/smt_statistics.h"
+#include "smt/smt_phase_profiler.h"
 #include "smt/smt_conflict_resolution.h"
 #include "smt/smt_relevancy.h"
 #include "smt/smt_case_split_queue.h"
@@ -44,6 +45,7 @@ Revision History:
 #include "util/ref.h"
 #include "util/timer.h"
 #include "util/statistics.h"
+#include "util/stats_callback.h"
 #include "smt/fingerprints.h"
 #include "smt/proto_model/proto_model.h"
 #include "smt/theory_user_propagator.h"
@@ -74,6 +76,7 @@ namespace smt {
         void set_reason_unknown(char const* msg) { m_unknown = msg; }
         void set_progress_callback(progress_callback *callback);
 
+        void set_stats_callback(unsigned interval_ms, stats_eh const& eh) { m_stats_callback.set(interval_ms, eh); }
 
     protected:
         ast_manager &               m;
@@ -83,6 +86,13 @@ namespace smt {
         setup                       m_setup;
         unsigned                    m_relevancy_lvl;
         timer                       m_timer;
+        // time spent in the phases of check, search includes final checks.
+        struct phase_watches {
+            stopwatch m_preprocess, m_internalize, m_search, m_final_check, m_model;
+        };
+        phase_watches               m_phase_watches;
+        phase_profiler              m_phase_profiler;
+        stats_callback              m_stats_callback;
         asserted_formulas           m_asserted_formulas;
         th_rewriter                 m_rewriter;
         scoped_ptr<quantifier_manager>   m_qmanager;
@@ -174,8 +184,12 @@ namespace smt {
         svector<double>             m_activity;
         clause_vector               m_aux_clauses;
         clause_vector               m_lemmas;
+        expr_ref_vector             m_lemma_cache;      //!< theory lemmas retained across pop (smt.lemma_cache)
+        obj_hashtable<expr>         m_lemma_cache_set;
+        unsigned_vector             m_lemma_cache_lvl;  //!< base level where the cached lemma was re-added, UINT_MAX if inactive
         vector<clause_vector>       m_clauses_to_reinit;
         expr_ref_vector             m_units_to_reassert;
+        expr_ref_vector             m_hints;            //!< hints from set_hints, applied by the next search
         svector<char>               m_units_to_reassert_sign;
         literal_vector              m_assigned_literals;
         typedef std::pair<clause*, literal_vector> tmp_clause;
@@ -261,6 +275,10 @@ namespace smt {
             return m_params;
         }
 
+        phase_profiler & get_phase_profiler() {
+            return m_phase_profiler;
+        }
+
         void updt_params(params_ref const& p);
 
         bool get_cancel_flag();
@@ -329,6 +347,14 @@ namespace smt {
 
         clause_vector const& get_lemmas() const { return m_lemmas; }
 
+        /**
+           \brief Retain a theory lemma so that it can be re-added after the scopes of its 
+           atoms are popped and the atoms are internalized again. Only used with smt.lemma_cache.
+           If active is set, the lemma is present in the current context until the current
+           base level is popped.
+        */
+        void cache_lemma(unsigned num_lits, literal const* lits, bool active);
+
         literal get_literal(expr * n) const;
 
         bool has_enode(bool_var v) const {
@@ -676,6 +702,8 @@ namespace smt {
 
         void reinit_clauses(unsigned num_scopes, unsigned num_bool_vars);
 
+        void reinject_cached_lemmas();
+
         void reassert_units(unsigned units_to_reassert_lim);
 
     public:
@@ -1061,6 +1089,13 @@ namespace smt {
 
         void set_global_generation(unsigned generation) { m_generation = generation; }
 
+        /**
+           \brief Quantifier profile (qi.profile): time spent matching the patterns of q,
+           and use of an instance of q in a conflict.
+        */
+        void add_quantifier_match_time(quantifier * q, double seconds) { m_qmanager->get_stat(q)->add_match_time(seconds); }
+        void inc_quantifier_conflicts(quantifier * q) { m_qmanager->inc_conflicts(q); }
+
 #ifdef Z3DEBUG
         bool slow_contains_instance(quantifier const * q, unsigned num_bindings, enode * const * bindings) const {
             return m_fingerprints.slow_contains(q, q->get_id(), num_bindings, bindings);
@@ -1204,6 +1239,10 @@ namespace smt {
 
         void del_inactive_lemmas2();
 
+        bool should_reduce_memory() const;
+
+        void reduce_memory();
+
         bool more_than_k_unassigned_literals(clause * cls, unsigned k);
 
 
@@ -1224,6 +1263,10 @@ namespace smt {
         void add_theory_assumptions(expr_ref_vector & theory_assumptions);
 
         lbool mk_unsat_core(lbool result);
+
+        bool m_trimming_core = false;
+
+        void trim_unsat_core();
         
         bool should_research(lbool result);
 
@@ -1249,6 +1292,8 @@ namespace smt {
 
         void forget_phase_of_vars_in_current_level();
 
+        bool use_chronological_backtracking(unsigned num_lits, unsigned conflict_lvl, unsigned new_lvl) const;
+
         virtual bool resolve_conflict();
 
 
@@ -1606,7 +1651,13 @@ namespace smt {
         */
         context * mk_fresh(symbol const * l = nullptr,  smt_params * smtp = nullptr, params_ref const & p = params_ref());
 
-        static void copy(context& src, context& dst, bool override_base = false);
+        /**
+           \brief Copy the base-level state of src into dst.
+           If copy_learned is set, lemmas learned by src are copied as well.
+        */
+        static void copy(context& src, context& dst, bool override_base = false, bool copy_learned = false);
+
+        static void copy_lemmas(context& src, context& dst, ast_translation& tr);
 
         /**
            \brief Translate context to use new manager m.
@@ -1622,6 +1673,8 @@ namespace smt {
 
         void assert_expr(expr * e, proof * pr);
 
+        void assert_expr(unsigned n, expr * const * es);
+
         void internalize_assertions();
 
         void push();
@@ -1706,6 +1759,14 @@ namespace smt {
 
         void get_units(expr_ref_vector& result);
 
+        void get_hints(expr_ref_vector& result);
+
+        void set_hints(expr_ref_vector const& hints) { m_hints.reset(); m_hints.append(hints); }
+
+    protected:
+        void apply_hints();
+
+    public:
         bool clause_proof_active() const { return m_clause_proof.is_enabled(); }
 
         clause_proof& get_clause_proof() { return m_clause_proof; }
@@ -1723,6 +1784,8 @@ namespace smt {
             user_propagator::pop_eh_t&     pop_eh,
             user_propagator::fresh_eh_t&   fresh_eh);
 
+        void user_propagate_register_native(user_propagator::native* p);
+
         void user_propagate_register_final(user_propagator::final_eh_t& final_eh) {
             if (!m_user_propagator) 
                 throw default_exception("user propagator must be initialized");
@@ -1747,6 +1810,12 @@ namespace smt {
             m_user_propagator->register_diseq(diseq_eh);
         }
 
+        void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) {
+            if (!m_user_propagator) 
+                throw default_exception("user propagator must be initialized");
+            m_user_propagator->register_batch(batch_eh);
+        }
+
         void user_propagate_register_expr(expr* e) {
             if (!m_user_propagator) 
                 throw default_exception("user propagator must be initialized");
@@ -417,12 +417,29 @@ namespace smt {
         st.update("mk clause", m_stats.m_num_mk_clause);
         st.update("mk clause binary", m_stats.m_num_mk_bin_clause);        
         st.update("del clause", m_stats.m_num_del_clause);
+        st.update("memory reductions", m_stats.m_num_memory_reductions);
         st.update("dyn ack", m_stats.m_num_dyn_ack);
         st.update("interface eqs", m_stats.m_num_interface_eqs);
         st.update("max generation", m_stats.m_max_generation);
         st.update("minimized lits", m_stats.m_num_minimized_lits);
         st.update("num checks", m_stats.m_num_checks);
+        if (m_stats.m_num_backtracks > 0)
+            st.update("chronological backtracks", m_stats.m_num_backtracks);
+        if (m_stats.m_num_cached_lemmas > 0)
+            st.update("cached lemmas", m_stats.m_num_cached_lemmas);
+        if (m_stats.m_num_core_trimmed > 0)
+            st.update("core trimmed", m_stats.m_num_core_trimmed);
         st.update("mk bool var", m_stats.m_num_mk_bool_var ? m_stats.m_num_mk_bool_var - 1 : 0);
+        auto update_time = [&](char const* key, stopwatch const& sw) {
+            if (sw.get_seconds() != 0)
+                st.update(key, sw.get_seconds());
+        };
+        update_time("time.smt.preprocess", m_phase_watches.m_preprocess);
+        update_time("time.smt.internalize", m_phase_watches.m_internalize);
+        update_time("time.smt.search", m_phase_watches.m_search);
+        update_time("time.smt.final-check", m_phase_watches.m_final_check);
+        update_time("time.smt.model", m_phase_watches.m_model);
+        m_phase_profiler.collect_statistics(st);
         m_qmanager->collect_statistics(st);
         m_asserted_formulas.collect_statistics(st);
         for (theory* th : m_theory_set) {
@@ -16,6 +16,8 @@ Author:
 Revision History:
 
 --*/
+#include <fstream>
+#include "util/warning.h"
 #include "smt/smt_context.h"
 #include "ast/ast_pp.h"
 
@@ -144,5 +146,15 @@ namespace smt {
     void context::display_profile(std::ostream & out) const {
         if (m_fparams.m_profile_res_sub)
             display_profile_res_sub(out);
+        if (m_phase_profiler.enabled()) {
+            IF_VERBOSE(2, m_phase_profiler.display_histogram(out););
+            if (m_fparams.m_phase_profile_file != symbol("")) {
+                std::ofstream folded(m_fparams.m_phase_profile_file.str());
+                if (folded)
+                    m_phase_profiler.display_folded(folded);
+                else
+                    warning_msg("could not open %s to write the phase profile", m_fparams.m_phase_profile_file.str().c_str());
+            }
+        }
     }
 };
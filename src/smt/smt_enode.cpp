@@ -36,7 +36,6 @@ namespace smt {
         n->m_cg               = nullptr;
         n->m_class_size       = 1;
         n->m_generation       = generation;
-        n->m_func_decl_id     = UINT_MAX;
         n->m_mark             = false;
         n->m_mark2            = false;
         n->m_interpreted      = false;
@@ -350,16 +349,12 @@ namespace smt {
         n->m_next          = n;
         n->m_class_size    = 1;
         n->m_cgc_enabled   = true;
-        n->m_func_decl_id  = UINT_MAX;
     }
 
     enode * tmp_enode::set(func_decl * f, unsigned num_args, enode * const * args) {
         if (num_args > m_capacity)
             set_capacity(num_args * 2);
         enode * r = get_enode();
-        if (m_app.get_app()->get_decl() != f) {
-            r->m_func_decl_id = UINT_MAX;
-        }
         m_app.set_decl(f);
         m_app.set_num_args(num_args);
         r->m_commutative  = num_args == 2 && f->is_commutative();
@@ -367,9 +362,5 @@ namespace smt {
         return r;
     }
 
-    void tmp_enode::reset() {
-        get_enode()->m_func_decl_id = UINT_MAX;
-    }
-
 };
 
@@ -66,8 +66,6 @@ namespace smt {
         unsigned            m_class_size;    //!< Size of the equivalence class if the enode is the root.
         unsigned            m_generation; //!< Tracks how many quantifier instantiation rounds were needed to generate this enode.
 
-        unsigned            m_func_decl_id; //!< Id generated by the congruence table for fast indexing.
-
         unsigned            m_mark:1;        //!< Multi-purpose auxiliary mark. 
         unsigned            m_mark2:1;       //!< Multi-purpose auxiliary mark. 
         unsigned            m_interpreted:1; //!< True if the node is an interpreted constant.
@@ -148,14 +146,6 @@ namespace smt {
         
         static void del_dummy(enode * n) { dealloc_svect(reinterpret_cast<char*>(n)); }
 
-        unsigned get_func_decl_id() const {
-            return m_func_decl_id;
-        }
-
-        void set_func_decl_id(unsigned id) {
-            m_func_decl_id = id;
-        }
-
         void mark_as_interpreted() {
             SASSERT(!m_interpreted);
             SASSERT(m_class_size == 1);
@@ -449,7 +439,6 @@ namespace smt {
         tmp_enode();
         ~tmp_enode();
         enode * set(func_decl * f, unsigned num_args, enode * const * args);
-        void reset();
     };
 
     inline mk_pp pp(enode* n, ast_manager& m) { return mk_pp(n->get_expr(), m); }
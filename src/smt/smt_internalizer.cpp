@@ -1491,7 +1491,8 @@ namespace smt {
                 }
                 else if (get_assignment(cls->get_literal(1)) == l_false) {
                     assign(cls->get_literal(0), b_justification(cls));
-                    if (k == CLS_TH_LEMMA && m_scope_lvl > m_base_lvl) {
+                    // learned clauses are asserted out of order after chronological backtracking.
+                    if ((k == CLS_TH_LEMMA || get_assign_level(cls->get_literal(1)) < m_scope_lvl) && m_scope_lvl > m_base_lvl) {
                         reinit     = true;
                         iscope_lvl = m_scope_lvl;
                     }
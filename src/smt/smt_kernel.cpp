@@ -63,8 +63,8 @@ namespace smt {
         return m_imp->m_kernel.get_manager();
     }
 
-    void  kernel::copy(kernel& src, kernel& dst) {
-        context::copy(src.m_imp->m_kernel, dst.m_imp->m_kernel);
+    void  kernel::copy(kernel& src, kernel& dst, bool copy_learned) {
+        context::copy(src.m_imp->m_kernel, dst.m_imp->m_kernel, false, copy_learned);
     }
 
     bool kernel::set_logic(symbol logic) {
@@ -75,6 +75,10 @@ namespace smt {
         m_imp->m_kernel.set_progress_callback(callback);
     }
 
+    void kernel::set_stats_callback(unsigned interval_ms, stats_eh const& eh) {
+        m_imp->m_kernel.set_stats_callback(interval_ms, eh);
+    }
+
     void kernel::assert_expr(expr * e) {
         m_imp->m_kernel.assert_expr(e);
     }
@@ -84,6 +88,10 @@ namespace smt {
             m_imp->m_kernel.assert_expr(es[i]);
     }
 
+    void kernel::assert_expr(unsigned n, expr * const * es) {
+        m_imp->m_kernel.assert_expr(n, es);
+    }
+
     void kernel::assert_expr(expr * e, proof * pr) {
         m_imp->m_kernel.assert_expr(e, pr);
     }
@@ -181,6 +189,14 @@ namespace smt {
     void kernel::get_units(expr_ref_vector & result) {
         m_imp->m_kernel.get_units(result);
     }    
+
+    void kernel::get_hints(expr_ref_vector & result) {
+        m_imp->m_kernel.get_hints(result);
+    }
+
+    void kernel::set_hints(expr_ref_vector const & hints) {
+        m_imp->m_kernel.set_hints(hints);
+    }
         
     void kernel::get_relevant_labels(expr * cnstr, buffer<symbol> & result) {
         m_imp->m_kernel.get_relevant_labels(cnstr, result);
@@ -280,6 +296,14 @@ namespace smt {
         m_imp->m_kernel.user_propagate_register_diseq(diseq_eh);
     }
 
+    void kernel::user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) {
+        m_imp->m_kernel.user_propagate_register_batch(batch_eh);
+    }
+
+    void kernel::user_propagate_register_native(user_propagator::native* p) {
+        m_imp->m_kernel.user_propagate_register_native(p);
+    }
+
     void kernel::user_propagate_register_expr(expr* e) {
         m_imp->m_kernel.user_propagate_register_expr(e);
     }        
@@ -50,7 +50,7 @@ namespace smt {
 
         ~kernel();
 
-        static void copy(kernel& src, kernel& dst);
+        static void copy(kernel& src, kernel& dst, bool copy_learned = false);
 
         ast_manager & m() const;
         
@@ -65,6 +65,11 @@ namespace smt {
         */
         void set_progress_callback(progress_callback * callback);
 
+        /**
+           \brief Push the statistics to eh every interval_ms milliseconds during search.
+        */
+        void set_stats_callback(unsigned interval_ms, stats_eh const& eh);
+
         /**
            \brief Assert the given assetion into the logical context.
            This method uses the "asserted" proof as a justification for e.
@@ -72,6 +77,8 @@ namespace smt {
         void assert_expr(expr * e);
 
         void assert_expr(expr_ref_vector const& es);
+
+        void assert_expr(unsigned n, expr * const * es);
         /**
            \brief Assert the given assertion with the given proof as a justification.
         */
@@ -208,6 +215,13 @@ namespace smt {
            \brief Return units assigned by the kernel.
         */
         void get_units(expr_ref_vector& result);
+
+        /**
+           \brief hints for warm starting a context on a similar problem, see solver::get_hints.
+        */
+        void get_hints(expr_ref_vector& result);
+
+        void set_hints(expr_ref_vector const& hints);
         
         /**
            \brief Return the set of relevant labels in the last check command.
@@ -309,6 +323,10 @@ namespace smt {
         
         void user_propagate_register_diseq(user_propagator::eq_eh_t& diseq_eh);
 
+        void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh);
+
+        void user_propagate_register_native(user_propagator::native* p);
+
         void user_propagate_register_expr(expr* e);
         
         void user_propagate_register_created(user_propagator::created_eh_t& r);
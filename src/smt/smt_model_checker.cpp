@@ -33,6 +33,7 @@ Revision History:
 #include "smt/smt_context.h"
 #include "smt/smt_model_finder.h"
 #include "model/model_pp.h"
+#include <algorithm>
 #include <tuple>
 
 namespace smt {
@@ -49,6 +50,7 @@ namespace smt {
         m_iteration_idx(0),
         m_curr_model(nullptr),
         m_fresh_exprs(m),
+        m_satisfied_pinned(m),
         m_pinned_exprs(m) {
     }
 
@@ -157,20 +159,14 @@ namespace smt {
     }
 
     /**
-       \brief Assert the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
+       \brief Assert the negation of q, where body is the body of q after applying the interpretation 
+       in m_curr_model to the uninterpreted symbols in q.
 
        The variables are replaced by skolem constants. These constants are stored in sks.
     */
 
-    bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
-        expr_ref tmp(m);
-        
-        TRACE("model_checker", tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
-
-        if (!m_curr_model->eval(q->get_expr(), tmp, true)) {
-            return false;
-        }
-        TRACE("model_checker", tout << "q after applying interpretation:\n" << mk_ismt2_pp(tmp, m) << "\n";);
+    void model_checker::assert_neg_q_m(quantifier * q, expr * body, expr_ref_vector & sks) {
+        TRACE("model_checker", tout << "q after applying interpretation:\n" << mk_ismt2_pp(body, m) << "\n";);
         ptr_buffer<expr> subst_args;
         unsigned num_decls = q->get_num_decls();
         subst_args.resize(num_decls, nullptr);
@@ -186,12 +182,50 @@ namespace smt {
         }
 
         var_subst s(m);
-        expr_ref sk_body = s(tmp, subst_args.size(), subst_args.data());
+        expr_ref sk_body = s(body, subst_args.size(), subst_args.data());
         expr_ref r(m);
         r = m.mk_not(sk_body);
         TRACE("model_checker", tout << "mk_neg_q_m:\n" << mk_ismt2_pp(r, m) << "\n";);
         m_aux_context->assert_expr(r);
-        return true;
+    }
+
+    /**
+       \brief the universes of the finite sorts of the variables of q, 
+       separated by null pointers.
+    */
+    void model_checker::get_universe_key(quantifier * q, ptr_vector<expr> & key) {
+        key.reset();
+        for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+            sort * s = q->get_decl_sort(i);
+            if (m_curr_model->is_finite(s)) {
+                unsigned sz = key.size();
+                for (expr * e : m_curr_model->get_known_universe(s))
+                    key.push_back(e);
+                std::sort(key.begin() + sz, key.end(), [](expr * a, expr * b) { return a->get_id() < b->get_id(); });
+            }
+            key.push_back(nullptr);
+        }
+    }
+
+    bool model_checker::was_satisfied(quantifier * q, expr * body, ptr_vector<expr> const & key) const {
+        auto * e = m_satisfied.find_core(q);
+        return e && e->get_data().m_value.m_body == body && e->get_data().m_value.m_universe == key;
+    }
+
+    void model_checker::set_satisfied(quantifier * q, expr * body, ptr_vector<expr> const & key) {
+        // entries that were replaced remain pinned, start over once they add up.
+        if (m_satisfied_pinned.size() > 4 * (m_satisfied.size() + 1024)) {
+            m_satisfied.reset();
+            m_satisfied_pinned.reset();
+        }
+        m_satisfied_pinned.push_back(q);
+        m_satisfied_pinned.push_back(body);
+        for (expr * e : key)
+            if (e)
+                m_satisfied_pinned.push_back(e);
+        satisfied_check & c = m_satisfied.insert_if_not_there(q, satisfied_check());
+        c.m_body = body;
+        c.m_universe = key;
     }
 
     bool model_checker::add_instance(quantifier * q, model * cex, expr_ref_vector & sks, bool use_inv) {
@@ -344,14 +378,23 @@ namespace smt {
 
     bool model_checker::check(quantifier * q) {
         SASSERT(!m_aux_context->relevancy());
-        scoped_ctx_push _push(m_aux_context.get());
 
         quantifier * flat_q = get_flat_quantifier(q);
-        TRACE("model_checker", tout << "model checking:\n" << expr_ref(flat_q->get_expr(), m) << "\n";);
-        expr_ref_vector sks(m);
-
-        if (!assert_neg_q_m(flat_q, sks))
+        TRACE("model_checker", tout << "model checking:\n" << expr_ref(flat_q->get_expr(), m) << "\n";
+              tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
+        expr_ref body(m);
+        if (!m_curr_model->eval(flat_q->get_expr(), body, true))
             return false;
+        ptr_vector<expr> key;
+        get_universe_key(flat_q, key);
+        if (was_satisfied(flat_q, body, key)) {
+            TRACE("model_checker", tout << "satisfied in a previous round\n";);
+            return true;
+        }
+
+        scoped_ctx_push _push(m_aux_context.get());
+        expr_ref_vector sks(m);
+        assert_neg_q_m(flat_q, body, sks);
         TRACE("model_checker", tout << "skolems:\n" << sks << "\n";);
 
         flet<bool> l(m_aux_context->get_fparams().m_array_fake_support, true);
@@ -359,6 +402,8 @@ namespace smt {
         
         TRACE("model_checker", tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
         if (r != l_true) {
+            if (r == l_false) 
+                set_satisfied(flat_q, body, key);
             return r == l_false; // quantifier is satisfied by m_curr_model
         }
 
@@ -54,6 +54,22 @@ namespace smt {
         obj_map<expr, expr *>                       m_value2expr;
         expr_ref_vector                             m_fresh_exprs;
 
+        // Quantifiers found satisfied by the model of a previous round.
+        // The check of a quantifier only depends on its body under the
+        // model and on the universes of the finite sorts of its variables,
+        // so it is skipped while both are unchanged. This avoids asserting
+        // and internalizing the same function interpretations in the
+        // auxiliary context on every round.
+        struct satisfied_check {
+            expr *           m_body = nullptr;
+            ptr_vector<expr> m_universe;
+        };
+        obj_map<quantifier, satisfied_check>        m_satisfied;
+        expr_ref_vector                             m_satisfied_pinned;
+        void get_universe_key(quantifier * q, ptr_vector<expr> & key);
+        bool was_satisfied(quantifier * q, expr * body, ptr_vector<expr> const & key) const;
+        void set_satisfied(quantifier * q, expr * body, ptr_vector<expr> const & key);
+
         friend class model_instantiation_set;
 
         void init_aux_context();
@@ -62,7 +78,7 @@ namespace smt {
         expr * get_type_compatible_term(expr * val);
         expr_ref replace_value_from_ctx(expr * e);
         void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe);
-        bool assert_neg_q_m(quantifier * q, expr_ref_vector & sks);
+        void assert_neg_q_m(quantifier * q, expr * body, expr_ref_vector & sks);
         bool add_blocking_clause(model * cex, expr_ref_vector & sks);
         bool check(quantifier * q);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
@@ -17,6 +17,8 @@ Author:
 
 
 #include "util/scoped_ptr_vector.h"
+#include "util/numa.h"
+#include "util/thread_pool.h"
 #include "ast/ast_util.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -36,8 +38,34 @@ namespace smt {
 #else
 
 #include <thread>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
 
 namespace smt {
+
+    /**
+       Cube-and-conquer with work stealing.
+
+       Every worker owns a deque of cubes. A worker pops cubes from the back
+       of its own deque (depth first) and, when it runs dry, steals the
+       oldest cube from the front of another worker's deque. A cube that is
+       not decided within its conflict budget is either retried with a larger
+       budget or split by lookahead into two sub-cubes that are pushed on the
+       owner's deque. Units learned at base level are exchanged
+       asynchronously after each check, so there is no round barrier.
+
+       Cubes and shared units are stored over the manager of the main context.
+       It is only touched while holding the exchange mutex; workers translate
+       cubes into their own manager before solving them.
+    */
+
+    struct parallel_cube {
+        expr_ref_vector m_lits;
+        unsigned        m_budget;
+        unsigned        m_timeouts = 0;
+        parallel_cube(expr_ref_vector const& lits, unsigned budget): m_lits(lits), m_budget(budget) {}
+    };
     
     lbool parallel::operator()(expr_ref_vector const& asms) {
 
@@ -46,6 +74,7 @@ namespace smt {
         flet<unsigned> _nt(ctx.m_fparams.m_threads, 1);
         unsigned thread_max_conflicts = ctx.get_fparams().m_threads_max_conflicts;
         unsigned max_conflicts = ctx.get_fparams().m_max_conflicts;
+        unsigned cube_frequency = std::max(1u, ctx.get_fparams().m_threads_cube_frequency);
 
         // try first sequential with a low conflict budget to make super easy problems cheap
         unsigned max_c = std::min(thread_max_conflicts, 40u);
@@ -72,7 +101,6 @@ namespace smt {
         par_exception_kind ex_kind = DEFAULT_EX;
         unsigned error_code = 0;
         bool done = false;
-        unsigned num_rounds = 0;
         if (m.has_trace_stream())
             throw default_exception("trace streams have to be off in parallel mode");
 
@@ -80,156 +108,269 @@ namespace smt {
         for (unsigned i = 0; i < num_threads; ++i) {
             smt_params.push_back(ctx.get_fparams());
         }
-        for (unsigned i = 0; i < num_threads; ++i) {
-            ast_manager* new_m = alloc(ast_manager, m, true);
-            pms.push_back(new_m);
-            pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
-            context& new_ctx = *pctxs.back();
-            context::copy(ctx, new_ctx, true);
+        // with affinity, the context of worker i is cloned on a thread pinned
+        // like worker i, so its memory is allocated on the node of the worker.
+        bool affinity = numa::affinity_enabled(ctx.get_params());
+        numa::scoped_stats numa_stats(affinity);
+        // Clone the main context in rounds. In every round the main context and
+        // each of the worker contexts created so far serve as the source of one
+        // new worker, so the number of clones doubles per round and setup takes
+        // a logarithmic number of sequential deep copies.
+        pms.resize(num_threads);
+        pctxs.resize(num_threads);
+        auto clone = [&](context& src, unsigned i) {
+            ast_manager* new_m = alloc(ast_manager, src.m, true);
+            pms.set(i, new_m);
+            pctxs.set(i, alloc(context, *new_m, smt_params[i], ctx.get_params()));
+            context& new_ctx = *pctxs[i];
+            context::copy(src, new_ctx, true);
             new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
-            ast_translation tr(m, *new_m);
+        };
+        for (unsigned num_cloned = 0; num_cloned < num_threads; ) {
+            unsigned num_new = std::min(num_cloned + 1, num_threads - num_cloned);
+            std::string clone_ex;
+            std::mutex clone_mux;
+            thread_pool::run(num_new, [&](unsigned j) {
+                numa::scoped_bind _bind(affinity, num_cloned + j);
+                try {
+                    clone(j == 0 ? ctx : *pctxs[j - 1], num_cloned + j);
+                }
+                catch (z3_exception& ex) {
+                    std::lock_guard<std::mutex> lock(clone_mux);
+                    clone_ex = ex.msg();
+                }
+            });
+            if (!clone_ex.empty())
+                throw default_exception(std::move(clone_ex));
+            num_cloned += num_new;
+        }
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_translation tr(m, *pms[i]);
             pasms.push_back(tr(asms));
-            sl.push_child(&(new_m->limit()));
+            sl.push_child(&(pms[i]->limit()));
         }
 
-        auto cube = [](context& ctx, expr_ref_vector& lasms, expr_ref& c) {
-            lookahead lh(ctx);
-            c = lh.choose();
-            if (c) {
-                if ((ctx.get_random_value() % 2) == 0) 
-                    c = c.get_manager().mk_not(c);
-                lasms.push_back(c);
+        // state shared between workers, guarded by mux.
+        std::mutex mux;
+        std::condition_variable cond;
+        vector<std::deque<parallel_cube>> deques(num_threads);
+        unsigned num_open = 1;            // cubes that are queued or being solved
+        unsigned num_conflicts = 0;       // conflicts spent by all workers
+        unsigned num_steals = 0, num_splits = 0;
+        obj_hashtable<expr> core_set;
+        expr_ref_vector core(m);
+        obj_hashtable<expr> unit_set;
+        expr_ref_vector unit_trail(m);
+        unsigned_vector unit_lim(num_threads, 0u), export_lim(num_threads, 0u);
+
+        deques[0].push_back(parallel_cube(expr_ref_vector(m), thread_max_conflicts));
+
+        auto cancel_all = [&](unsigned i) {
+            // mux is held by caller
+            if (!done) {
+                done = true;
+                for (unsigned j = 0; j < num_threads; ++j) 
+                    if (j != i) pms[j]->limit().cancel();
             }
+            cond.notify_all();
         };
 
-        obj_hashtable<expr> unit_set;
-        expr_ref_vector unit_trail(ctx.m);
-        unsigned_vector unit_lim;
-        for (unsigned i = 0; i < num_threads; ++i) unit_lim.push_back(0);
+        auto finish = [&](unsigned i, lbool r) {
+            // mux is held by caller
+            if (finished_id == UINT_MAX || (r != l_undef && result == l_undef)) {
+                finished_id = i;
+                result = r;
+            }
+            cancel_all(i);
+        };
 
-        std::function<void(void)> collect_units = [&,this]() {
-            for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
-                pctx.pop_to_base_lvl();
-                ast_translation tr(pctx.m, ctx.m);
+        // retrieve the next cube for worker i, stealing when the own deque is empty.
+        auto get_cube = [&](unsigned i, expr_ref_vector& lits, unsigned& budget, unsigned& timeouts) {
+            std::unique_lock<std::mutex> lock(mux);
+            while (!done) {
+                if (!deques[i].empty()) {
+                    parallel_cube& c = deques[i].back();
+                    ast_translation tr(m, *pms[i]);
+                    lits.reset();
+                    for (expr* e : c.m_lits) 
+                        lits.push_back(tr(e));
+                    budget = c.m_budget;
+                    timeouts = c.m_timeouts;
+                    deques[i].pop_back();
+                    return true;
+                }
+                unsigned start = pctxs[i]->get_random_value();
+                for (unsigned k = 0; k < num_threads; ++k) {
+                    unsigned j = (start + k) % num_threads;
+                    if (j == i || deques[j].empty()) 
+                        continue;
+                    deques[i].push_back(std::move(deques[j].front()));
+                    deques[j].pop_front();
+                    ++num_steals;
+                    break;
+                }
+                if (deques[i].empty()) 
+                    cond.wait(lock);
+            }
+            return false;
+        };
+
+        auto push_cube = [&](unsigned i, expr_ref_vector const& lits, unsigned budget, unsigned timeouts) {
+            // mux is held by caller
+            ast_translation tr(*pms[i], m);
+            parallel_cube c(tr(lits), budget);
+            c.m_timeouts = timeouts;
+            deques[i].push_back(std::move(c));
+            cond.notify_one();
+        };
+
+        // exchange units learned at base level with the other workers.
+        auto share_units = [&](unsigned i) {
+            context& pctx = *pctxs[i];
+            pctx.pop_to_base_lvl();            
+            std::lock_guard<std::mutex> lock(mux);
+            {
+                ast_translation tr(pctx.m, m);
                 unsigned sz = pctx.assigned_literals().size();
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
+                for (unsigned j = export_lim[i]; j < sz; ++j) {
                     literal lit = pctx.assigned_literals()[j];
                     expr_ref e(pctx.bool_var2expr(lit.var()), pctx.m);
+                    if (!e) continue;
                     if (lit.sign()) e = pctx.m.mk_not(e);
-                    expr_ref ce(tr(e.get()), ctx.m);
+                    expr_ref ce(tr(e.get()), m);
                     if (!unit_set.contains(ce)) {
                         unit_set.insert(ce);
                         unit_trail.push_back(ce);
                     }
                 }
+                export_lim[i] = sz;
             }
-
+            ast_translation tr(m, pctx.m);
             unsigned sz = unit_trail.size();
-            for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
-                ast_translation tr(ctx.m, pctx.m);
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
-                    expr_ref src(ctx.m), dst(pctx.m);
-                    dst = tr(unit_trail.get(j));
-                    pctx.assert_expr(dst);
-                }
-                unit_lim[i] = sz;
-            }
-            IF_VERBOSE(1, verbose_stream() << "(smt.thread :units " << sz << ")\n");
+            for (unsigned j = unit_lim[i]; j < sz; ++j) 
+                pctx.assert_expr(tr(unit_trail.get(j)));
+            unit_lim[i] = sz;
         };
 
-        std::mutex mux;
-
         auto worker_thread = [&](int i) {
             try {
                 context& pctx = *pctxs[i];
                 ast_manager& pm = *pms[i];
-                expr_ref_vector lasms(pasms[i]);
-                expr_ref c(pm);
-
-                pctx.get_fparams().m_max_conflicts = std::min(thread_max_conflicts, max_conflicts);
-                if (num_rounds > 0 && (pctx.get_fparams().m_threads_cube_frequency % num_rounds) == 0) 
-                    cube(pctx, lasms, c);
-                IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i; 
-                           if (num_rounds > 0) verbose_stream() << " :round " << num_rounds;
-                           if (c) verbose_stream() << " :cube " << mk_bounded_pp(c, pm, 3);
-                           verbose_stream() << ")\n";);
-                lbool r = pctx.check(lasms.size(), lasms.data());
-                
-                if (r == l_undef && pctx.m_num_conflicts >= max_conflicts) 
-                    ; // no-op
-                else if (r == l_undef && pctx.m_num_conflicts >= thread_max_conflicts) 
-                    return;
-                else if (r == l_false && pctx.unsat_core().contains(c)) {
-                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :learn " << mk_bounded_pp(c, pm, 3) << ")");
-                    pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
-                    return;
-                } 
-                
-
-                bool first = false;
-                {
-                    std::lock_guard<std::mutex> lock(mux);
-                    if (finished_id == UINT_MAX) {
-                        finished_id = i;
-                        first = true;
-                        result = r;
-                        done = true;
+                expr_ref_vector cube(pm), lasms(pm);
+                unsigned budget = 0, timeouts = 0;
+
+                while (get_cube(i, cube, budget, timeouts)) {
+                    lasms.reset();
+                    lasms.append(pasms[i]);
+                    lasms.append(cube);
+                    {
+                        std::lock_guard<std::mutex> lock(mux);
+                        pctx.get_fparams().m_max_conflicts = std::min(budget, max_conflicts - std::min(max_conflicts, num_conflicts));
                     }
-                    if (!first && r != l_undef && result == l_undef) {
-                        finished_id = i;
-                        result = r;                        
+                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :budget " << budget;
+                               if (!cube.empty()) verbose_stream() << " :cube " << mk_bounded_pp(mk_and(cube), pm, 3);
+                               verbose_stream() << ")\n";);
+                    lbool r = pctx.check(lasms.size(), lasms.data());
+
+                    if (r == l_false) {
+                        bool in_cube = any_of(pctx.unsat_core(), [&](expr* e) { return cube.contains(e); });
+                        if (in_cube) {
+                            IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :learn " << mk_bounded_pp(mk_and(cube), pm, 3) << ")\n");
+                            pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
+                        }
+                        std::lock_guard<std::mutex> lock(mux);
+                        num_conflicts += pctx.m_num_conflicts;
+                        if (!in_cube) {
+                            finish(i, l_false);
+                            return;
+                        }
+                        ast_translation tr(pm, m);
+                        for (expr* e : pctx.unsat_core()) {
+                            if (cube.contains(e))
+                                continue;
+                            expr* ce = tr(e);
+                            if (!core_set.contains(ce)) {
+                                core_set.insert(ce);
+                                core.push_back(ce);
+                            }
+                        }
+                        if (--num_open == 0) {
+                            finish(i, l_false);
+                            return;
+                        }
                     }
-                    else if (!first) return;
-                }
-
-                for (ast_manager* m : pms) {
-                    if (m != &pm) m->limit().cancel();
+                    else if (r == l_true || pm.limit().is_canceled() || pctx.get_last_search_failure() != NUM_CONFLICTS) {
+                        std::lock_guard<std::mutex> lock(mux);
+                        num_conflicts += pctx.m_num_conflicts;
+                        finish(i, r);
+                        return;
+                    }
+                    else {
+                        expr_ref c(pm);
+                        if ((timeouts + 1) % cube_frequency == 0) {
+                            lookahead lh(pctx);
+                            c = lh.choose();
+                        }
+                        std::lock_guard<std::mutex> lock(mux);
+                        num_conflicts += pctx.m_num_conflicts;
+                        if (num_conflicts >= max_conflicts) {
+                            finish(i, l_undef);
+                            return;
+                        }
+                        if (c) {
+                            ++num_splits;
+                            ++num_open;
+                            cube.push_back(c);
+                            push_cube(i, cube, budget, 0);
+                            cube[cube.size() - 1] = pm.mk_not(c);
+                            push_cube(i, cube, budget, 0);
+                        }
+                        else {
+                            push_cube(i, cube, 2 * budget, timeouts + 1);
+                        }
+                    }
+                    share_units(i);
                 }
-
             }
             catch (z3_error & err) {
+                std::lock_guard<std::mutex> lock(mux);
                 if (finished_id == UINT_MAX) {
                     error_code = err.error_code();
                     ex_kind = ERROR_EX;
-                    done = true;
                 }
+                cancel_all(i);
             }
             catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
                 if (finished_id == UINT_MAX) {
                     ex_msg = ex.msg();
                     ex_kind = DEFAULT_EX;
-                    done = true;
                 }
+                cancel_all(i);
             }
             catch (...) {
+                std::lock_guard<std::mutex> lock(mux);
                 if (finished_id == UINT_MAX) {
                     ex_msg = "unknown exception";
                     ex_kind = ERROR_EX;
-                    done = true;
                 }
+                cancel_all(i);
             }
         };
 
         // for debugging:  num_threads = 1;
 
-        while (true) {
-            vector<std::thread> threads(num_threads);
-            for (unsigned i = 0; i < num_threads; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
-            for (auto & th : threads) {
-                th.join();
-            }
-            if (done) break;
-
-            collect_units();
-            ++num_rounds;
-            max_conflicts = (max_conflicts < thread_max_conflicts) ? 0 : (max_conflicts - thread_max_conflicts);
-            thread_max_conflicts *= 2;            
-        }
-
+        thread_pool::run(num_threads, [&](unsigned i) {
+            numa::scoped_bind _bind(affinity, i);
+            worker_thread(i);
+        });
+        numa_stats.collect_statistics(ctx.m_aux_stats);
+
+        IF_VERBOSE(1, verbose_stream() << "(smt.thread :splits " << num_splits << " :steals " << num_steals 
+                   << " :units " << unit_trail.size() << ")\n");
+        ctx.m_aux_stats.update("parallel cube splits", num_splits);
+        ctx.m_aux_stats.update("parallel cube steals", num_steals);
+        ctx.m_aux_stats.update("parallel shared units", unit_trail.size());
         for (context* c : pctxs) {
             c->collect_statistics(ctx.m_aux_stats);
         }
@@ -252,8 +393,18 @@ namespace smt {
             break;
         case l_false:
             ctx.m_unsat_core.reset();
-            for (expr* e : pctx.unsat_core()) 
-                ctx.m_unsat_core.push_back(tr(e));
+            for (expr* e : pctx.unsat_core()) {
+                expr* ce = tr(e);
+                if (!core_set.contains(ce)) {
+                    core_set.insert(ce);
+                    core.push_back(ce);
+                }
+            }
+            // the union of the cores of all refuted cubes, restricted to the assumptions,
+            // is a core for the original query.
+            for (expr* e : core)
+                if (asms.contains(e))
+                    ctx.m_unsat_core.push_back(e);
             break;
         default:
             break;
@@ -0,0 +1,150 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt_phase_profiler.cpp
+
+Abstract:
+
+    Time spent by smt::context in the phases of search.
+
+--*/
+
+#include <algorithm>
+#include "smt/smt_phase_profiler.h"
+
+namespace smt {
+
+    static char const* fixed_phase_names[phase_profiler::PH_NUM_FIXED] = {
+        "search", "propagate", "bcp", "theory-propagate", "quantifiers",
+        "conflict", "decide", "restart", "simplify", "final-check", "minimize"
+    };
+
+    phase_profiler::phase_profiler() {
+        for (char const* n : fixed_phase_names)
+            mk_phase(n);
+        reset();
+    }
+
+    void phase_profiler::set_enabled(bool f) {
+        if (f && !m_enabled && m_ticks0 == 0) {
+            m_ticks0 = now();
+            m_time0 = std::chrono::steady_clock::now();
+        }
+        m_enabled = f;
+    }
+
+    void phase_profiler::reset() {
+        SASSERT(m_starts.empty());
+        m_paths.reset();
+        m_paths.push_back(path(UINT_MAX, UINT_MAX));
+        m_current = 0;
+        for (auto& ph : m_phases) {
+            ph.m_total = 0;
+            ph.m_count = 0;
+            std::fill(ph.m_buckets, ph.m_buckets + num_buckets, 0);
+        }
+    }
+
+    unsigned phase_profiler::mk_phase(char const* name) {
+        for (unsigned i = 0; i < m_phases.size(); ++i)
+            if (m_phases[i].m_name == name)
+                return i;
+        m_phases.push_back(phase_info());
+        m_phases.back().m_name = name;
+        m_phases.back().m_key = symbol((std::string("time.smt.phase.") + name).c_str());
+        return m_phases.size() - 1;
+    }
+
+    void phase_profiler::enter(unsigned ph) {
+        uint64_t t = now();
+        if (!m_starts.empty())
+            m_paths[m_current].m_self += t - m_last;
+        m_last = t;
+        m_starts.push_back(t);
+        unsigned next = UINT_MAX;
+        for (unsigned c : m_paths[m_current].m_children)
+            if (m_paths[c].m_phase == ph) {
+                next = c;
+                break;
+            }
+        if (next == UINT_MAX) {
+            next = m_paths.size();
+            m_paths.push_back(path(m_current, ph));
+            m_paths[m_current].m_children.push_back(next);
+        }
+        m_current = next;
+    }
+
+    void phase_profiler::leave() {
+        uint64_t t = now();
+        path& p = m_paths[m_current];
+        p.m_self += t - m_last;
+        m_last = t;
+        uint64_t d = t - m_starts.back();
+        m_starts.pop_back();
+        phase_info& ph = m_phases[p.m_phase];
+        ph.m_total += d;
+        ph.m_count++;
+        unsigned b = 0;
+        while (d > 1 && b + 1 < num_buckets)
+            d >>= 1, ++b;
+        ph.m_buckets[b]++;
+        m_current = p.m_parent;
+    }
+
+    double phase_profiler::ticks_per_second() const {
+#ifdef Z3_PHASE_PROFILER_TSC
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_time0).count();
+        uint64_t ticks = now() - m_ticks0;
+        if (m_ticks0 == 0 || secs <= 0 || ticks == 0)
+            return 1e9;
+        return static_cast<double>(ticks) / secs;
+#else
+        return 1e9;
+#endif
+    }
+
+    void phase_profiler::collect_statistics(::statistics& st) const {
+        if (m_paths.size() <= 1)
+            return;
+        double freq = ticks_per_second();
+        for (auto const& ph : m_phases) {
+            if (ph.m_count == 0)
+                continue;
+            st.update(ph.m_key.bare_str(), static_cast<double>(ph.m_total) / freq);
+        }
+    }
+
+    void phase_profiler::display_path(std::ostream& out, unsigned p) const {
+        if (m_paths[p].m_parent != 0)
+            display_path(out, m_paths[p].m_parent), out << ";";
+        out << m_phases[m_paths[p].m_phase].m_name;
+    }
+
+    void phase_profiler::display_folded(std::ostream& out) const {
+        double per_us = ticks_per_second() / 1e6;
+        for (unsigned p = 1; p < m_paths.size(); ++p) {
+            auto w = static_cast<unsigned long long>(static_cast<double>(m_paths[p].m_self) / per_us);
+            if (w == 0)
+                continue;
+            display_path(out, p);
+            out << " " << w << "\n";
+        }
+    }
+
+    void phase_profiler::display_histogram(std::ostream& out) const {
+        out << "(smt.phase-histogram";
+        for (auto const& ph : m_phases) {
+            if (ph.m_count == 0)
+                continue;
+            out << "\n  (" << ph.m_name << " :count " << ph.m_count << " :log2-ticks";
+            for (unsigned b = 0; b < num_buckets; ++b)
+                if (ph.m_buckets[b] > 0)
+                    out << " " << b << ":" << ph.m_buckets[b];
+            out << ")";
+        }
+        out << ")\n";
+    }
+}
@@ -0,0 +1,127 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt_phase_profiler.h
+
+Abstract:
+
+    Time spent by smt::context in the phases of search.
+
+    Phases are entered and left with scoped markers. Time is read from the
+    time stamp counter where available, so a marker costs a few dozen
+    cycles and the profiler can stay enabled. Nested phases form a tree of
+    call paths: each path accumulates the time spent in it, not counting
+    the phases nested below it, which gives the folded stacks of flame
+    graph tools, one line per path
+
+        search;propagate;quantifiers 1234
+
+    where the weight is in microseconds. Every phase also counts its
+    invocations by the power of two of their duration in cycles.
+
+--*/
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include "util/statistics.h"
+#include "util/symbol.h"
+#include "util/vector.h"
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define Z3_PHASE_PROFILER_TSC
+#endif
+
+namespace smt {
+
+    class phase_profiler {
+    public:
+        enum phase {
+            PH_SEARCH,
+            PH_PROPAGATE,
+            PH_BCP,
+            PH_THEORY_PROPAGATE,
+            PH_QUANTIFIERS,
+            PH_CONFLICT,
+            PH_DECIDE,
+            PH_RESTART,
+            PH_SIMPLIFY,
+            PH_FINAL_CHECK,
+            PH_MINIMIZE,
+            PH_NUM_FIXED
+        };
+
+        static const unsigned num_buckets = 48;
+
+    private:
+        struct path {
+            unsigned        m_parent;
+            unsigned        m_phase;
+            unsigned_vector m_children;
+            uint64_t        m_self = 0;     // ticks in this path, excluding nested paths
+            path(unsigned parent, unsigned ph): m_parent(parent), m_phase(ph) {}
+        };
+
+        struct phase_info {
+            std::string m_name;
+            symbol      m_key;             // statistics keep the key pointer
+            uint64_t    m_total = 0;       // ticks, including nested phases
+            unsigned    m_count = 0;
+            unsigned    m_buckets[num_buckets] = {};
+        };
+
+        bool                m_enabled = false;
+        vector<path>        m_paths;        // m_paths[0] is the root
+        vector<phase_info>  m_phases;
+        unsigned            m_current = 0;
+        uint64_t            m_last = 0;     // last time self time was charged
+        svector<uint64_t>   m_starts;       // start of the active phases
+        uint64_t            m_ticks0 = 0;
+        std::chrono::steady_clock::time_point m_time0;
+
+        static uint64_t now() {
+#ifdef Z3_PHASE_PROFILER_TSC
+            return __rdtsc();
+#else
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+        }
+
+        void enter(unsigned ph);
+        void leave();
+        void display_path(std::ostream& out, unsigned p) const;
+
+    public:
+        phase_profiler();
+
+        bool enabled() const { return m_enabled; }
+        void set_enabled(bool f);
+        void reset();
+
+        /**
+           \brief id of the phase with the given name, such as the final
+           check of a theory. Phases are created on first use.
+        */
+        unsigned mk_phase(char const* name);
+
+        double ticks_per_second() const;
+
+        void collect_statistics(::statistics& st) const;
+        void display_folded(std::ostream& out) const;
+        void display_histogram(std::ostream& out) const;
+
+        class scope {
+            phase_profiler& m_p;
+            bool            m_active;
+        public:
+            scope(phase_profiler& p, unsigned ph): m_p(p), m_active(p.m_enabled) { if (m_active) m_p.enter(ph); }
+            ~scope() { if (m_active) m_p.leave(); }
+        };
+    };
+}
@@ -158,6 +158,12 @@ namespace smt {
             return get_stat(q)->get_generation();
         }
 
+        void inc_conflicts(quantifier * q) {
+            q::quantifier_stat * s = nullptr;
+            if (m_quantifier_stat.find(q, s))
+                s->inc_num_conflicts();
+        }
+
         void add(quantifier * q, unsigned generation) {
             q::quantifier_stat * stat = m_qstat_gen(q, generation);
             m_quantifier_stat.insert(q, stat);
@@ -300,6 +306,7 @@ namespace smt {
             if (m_num_instances > m_params.m_qi_max_instances) {
                 return false;
             }
+            get_stat(q)->inc_num_matches();
             get_stat(q)->update_max_generation(max_generation);
             fingerprint * f = m_context.add_fingerprint(q, q->get_id(), num_bindings, bindings, def);
             if (f) {
@@ -468,6 +475,10 @@ namespace smt {
         return m_imp->get_generation(q);
     }
 
+    void quantifier_manager::inc_conflicts(quantifier * q) {
+        m_imp->inc_conflicts(q);
+    }
+
     bool quantifier_manager::add_instance(quantifier * q, app * pat,
                                           unsigned num_bindings,
                                           enode * const * bindings,
@@ -564,6 +575,9 @@ namespace smt {
 
     void quantifier_manager::collect_statistics(::statistics & st) const {
         m_imp->m_qi_queue.collect_statistics(st);
+        if (m_imp->m_params.m_qi_profile)
+            for (quantifier * q : m_imp->m_quantifiers)
+                q::collect_profile(q, *m_imp->get_stat(q), st);
     }
 
     void quantifier_manager::reset_statistics() {
@@ -54,6 +54,9 @@ namespace smt {
         q::quantifier_stat * get_stat(quantifier * q) const;
         unsigned get_generation(quantifier * q) const;
 
+        // record that an instance of q was used to derive a conflict, q may be unknown to the manager
+        void inc_conflicts(quantifier * q);
+
         static void log_justification_to_root(std::ostream & log, enode *en, obj_hashtable<enode> &already_visited, context &ctx, ast_manager &m);
 
         bool add_instance(quantifier * q, app * pat,
@@ -85,18 +85,30 @@ namespace {
         }
 
         solver * translate(ast_manager & m, params_ref const & p) override {
+            return clone(m, p, false);
+        }
+
+        solver * fork(params_ref const & p) override {
+            return clone(get_manager(), p, true);
+        }
+
+        solver * clone(ast_manager & m, params_ref const & p, bool copy_learned) {
             ast_translation translator(get_manager(), m);
 
             smt_solver * result = alloc(smt_solver, m, p, m_logic);
-            smt::kernel::copy(m_context, result->m_context);
+            smt::kernel::copy(m_context, result->m_context, copy_learned);
 
             if (mc0()) 
                 result->set_model_converter(mc0()->translate(translator));
 
-            for (auto & kv : m_name2assertion) { 
-                expr* val = translator(kv.m_value);
-                expr* key = translator(kv.m_key);
-                result->assert_expr(val, key);
+            // While the core is minimized the names are not assumed, and
+            // the copied context already has the implications they guard.
+            if (!m_minimizing_core) {
+                for (auto & kv : m_name2assertion) { 
+                    expr* val = translator(kv.m_value);
+                    expr* key = translator(kv.m_key);
+                    result->assert_expr(val, key);
+                }
             }
 
             return result;
@@ -158,6 +170,10 @@ namespace {
         void assert_expr_core(expr * t) override {
             m_context.assert_expr(t);
         }
+
+        void assert_exprs_core(unsigned n, expr * const * ts) override {
+            m_context.assert_expr(n, ts);
+        }
         void set_phase(expr* e) override { m_context.set_phase(e); }
         phase* get_phase() override { return m_context.get_phase(); }
         void set_phase(phase* p) override { m_context.set_phase(p); }
@@ -240,6 +256,14 @@ namespace {
             m_context.user_propagate_register_diseq(diseq_eh);
         }
 
+        void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+            m_context.user_propagate_register_batch(batch_eh);
+        }
+
+        void user_propagate_register_native(user_propagator::native* p) override {
+            m_context.user_propagate_register_native(p);
+        }
+
         void user_propagate_register_expr(expr* e) override { 
             m_context.user_propagate_register_expr(e);
         }
@@ -272,9 +296,11 @@ namespace {
                 r.push_back(m_context.get_unsat_core_expr(i));
             }
 
-            if (!m_minimizing_core && smt_params_helper(get_params()).core_minimize()) {
+            smt_params_helper sp(get_params());
+            if (!m_minimizing_core && sp.core_minimize()) {
                 scoped_minimize_core scm(*this);
                 mus mus(*this);
+                mus.set_num_threads(sp.core_minimize_threads());
                 mus.add_soft(r.size(), r.data());
                 expr_ref_vector r2(m);
                 if (l_true == mus.get_mus(r2)) {
@@ -317,6 +343,10 @@ namespace {
             m_context.set_progress_callback(callback);
         }
 
+        void register_stats_callback(unsigned interval_ms, stats_eh const& eh) override {
+            m_context.set_stats_callback(interval_ms, eh);
+        }
+
         unsigned get_num_assertions() const override {
             return m_context.size();
         }
@@ -330,6 +360,14 @@ namespace {
             m_context.get_units(units);
         }
 
+        void get_hints(expr_ref_vector& hints) override {
+            m_context.get_hints(hints);
+        }
+
+        void set_hints(expr_ref_vector const& hints) override {
+            m_context.set_hints(hints);
+        }
+
         expr_ref_vector cube(expr_ref_vector& vars, unsigned cutoff) override {
             ast_manager& m = get_manager();
             if (!m_cuber) {
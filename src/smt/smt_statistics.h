@@ -45,6 +45,10 @@ namespace smt {
         unsigned m_num_checks;
         unsigned m_num_simplifications;
         unsigned m_num_del_clauses;
+        unsigned m_num_cached_lemmas;
+        unsigned m_num_backtracks;
+        unsigned m_num_memory_reductions;
+        unsigned m_num_core_trimmed;
         statistics() {
             reset();
         }
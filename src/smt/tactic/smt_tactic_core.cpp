@@ -321,6 +321,8 @@ public:
     user_propagator::final_eh_t m_final_eh;
     user_propagator::eq_eh_t    m_eq_eh;
     user_propagator::eq_eh_t    m_diseq_eh;
+    user_propagator::batch_eh_t m_batch_eh;
+    user_propagator::native*    m_native = nullptr;
     user_propagator::created_eh_t m_created_eh;
     user_propagator::decide_eh_t m_decide_eh;
     void* m_on_clause_ctx = nullptr;
@@ -332,6 +334,12 @@ public:
     }
 
     void user_propagate_delay_init() {
+        if (m_native) {
+            m_ctx->user_propagate_register_native(m_native);
+            for (expr* v : m_vars) 
+                m_ctx->user_propagate_register_expr(v);
+            return;
+        }
         if (!m_user_ctx)
             return;
         m_ctx->user_propagate_init(m_user_ctx, m_push_eh, m_pop_eh, m_fresh_eh);
@@ -339,6 +347,7 @@ public:
         if (m_final_eh)   m_ctx->user_propagate_register_final(m_final_eh);
         if (m_eq_eh)      m_ctx->user_propagate_register_eq(m_eq_eh);
         if (m_diseq_eh)   m_ctx->user_propagate_register_diseq(m_diseq_eh);
+        if (m_batch_eh)   m_ctx->user_propagate_register_batch(m_batch_eh);
         if (m_created_eh) m_ctx->user_propagate_register_created(m_created_eh);
         if (m_decide_eh) m_ctx->user_propagate_register_decide(m_decide_eh);
 
@@ -353,6 +362,8 @@ public:
         m_final_eh = nullptr;
         m_eq_eh = nullptr;
         m_diseq_eh = nullptr;
+        m_batch_eh = nullptr;
+        m_native = nullptr;
         m_created_eh = nullptr;
         m_decide_eh = nullptr;
         m_on_clause_eh = nullptr;
@@ -392,6 +403,15 @@ public:
         m_diseq_eh = diseq_eh;
     }
 
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        m_batch_eh = batch_eh;
+    }
+
+    void user_propagate_register_native(user_propagator::native* p) override {
+        user_propagate_clear();
+        m_native = p;
+    }
+
     void user_propagate_register_expr(expr* e) override {
         m_vars.push_back(e);
     }
@@ -91,8 +91,9 @@ namespace smt {
         d->m_parent_selects.push_back(s);
         TRACE("array", tout << v << " " << mk_pp(s->get_expr(), m) << " " << mk_pp(get_enode(v)->get_expr(), m) << "\n";);
         m_trail_stack.push(push_back_trail<enode *, false>(d->m_parent_selects));
-        for (enode* n : d->m_stores) 
-            instantiate_axiom2a(s, n);
+        if (!m_params.m_array_lazy_axioms)
+            for (enode* n : d->m_stores) 
+                instantiate_axiom2a(s, n);
 
         if (!m_params.m_array_delay_exp_axiom && d->m_prop_upward) {
             for (enode* store : d->m_parent_stores) {
@@ -187,9 +188,11 @@ namespace smt {
         }
         d->m_stores.push_back(s);
         m_trail_stack.push(push_back_trail<enode *, false>(d->m_stores));
-        for (enode * n : d->m_parent_selects) {
-            SASSERT(is_select(n));
-            instantiate_axiom2a(n, s);
+        if (!m_params.m_array_lazy_axioms) {
+            for (enode * n : d->m_parent_selects) {
+                SASSERT(is_select(n));
+                instantiate_axiom2a(n, s);
+            }
         }
         if (m_params.m_array_always_prop_upward || lambda_equiv_class_size >= 1) 
             set_prop_upward(s);
@@ -398,7 +401,46 @@ namespace smt {
         return r;
     }
 
+    bool theory_array::instantiate_violated_axiom2(enode * select, enode * store, unsigned& counter) {
+        if (is_store_axiom2_sat(store, select)) {
+            m_stats.m_num_axiom2_sat++;
+            return false;
+        }
+        if (!assert_store_axiom2(store, select))
+            return false;
+        counter++;
+        return true;
+    }
+
+    /**
+       \brief Instantiate axiom 2 for the pairs of selects and stores that the
+       current equivalence classes violate. Used by array.lazy_axioms instead
+       of instantiating every pair when it is created.
+    */
+    bool theory_array::instantiate_violated_axioms2() {
+        bool result = false;
+        unsigned num_vars = get_num_vars();
+        for (theory_var v = 0; v < static_cast<theory_var>(num_vars); v++) {
+            if (!is_root(v))
+                continue;
+            var_data * d = m_var_data[v];
+            for (enode * select : d->m_parent_selects) {
+                for (enode * store : d->m_stores)
+                    if (instantiate_violated_axiom2(select, store, m_stats.m_num_axiom2a))
+                        result = true;
+                if (!d->m_prop_upward)
+                    continue;
+                for (enode * store : d->m_parent_stores)
+                    if (instantiate_violated_axiom2(select, store, m_stats.m_num_axiom2b))
+                        result = true;
+            }
+        }
+        return result;
+    }
+
     final_check_status theory_array::assert_delayed_axioms() {
+        if (m_params.m_array_lazy_axioms)
+            return instantiate_violated_axioms2() ? FC_CONTINUE : FC_DONE;
         if (!m_params.m_array_delay_exp_axiom)
             return FC_DONE;
         final_check_status r = FC_DONE;
@@ -469,6 +511,7 @@ namespace smt {
         st.update("array ax1", m_stats.m_num_axiom1);
         st.update("array ax2", m_stats.m_num_axiom2a);
         st.update("array exp ax2", m_stats.m_num_axiom2b);
+        st.update("array ax2 sat", m_stats.m_num_axiom2_sat);
         st.update("array ext ax", m_stats.m_num_extensionality);
         st.update("array splits", m_stats.m_num_eq_splits);
     }
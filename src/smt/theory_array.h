@@ -29,6 +29,7 @@ namespace smt {
         unsigned   m_num_map_axiom, m_num_default_map_axiom;
         unsigned   m_num_select_const_axiom, m_num_default_store_axiom, m_num_default_const_axiom, m_num_default_as_array_axiom;
         unsigned   m_num_select_as_array_axiom, m_num_default_lambda_axiom;
+        unsigned   m_num_axiom2_sat;
         void reset() { memset(this, 0, sizeof(theory_array_stats)); }
         theory_array_stats() { reset(); }
     };
@@ -87,6 +88,8 @@ namespace smt {
         void instantiate_extensionality(enode * a1, enode * a2);
         void instantiate_congruent(enode * a1, enode * a2);
         bool instantiate_axiom2b_for(theory_var v);
+        bool instantiate_violated_axiom2(enode * select, enode * store, unsigned& counter);
+        bool instantiate_violated_axioms2();
         
         virtual final_check_status assert_delayed_axioms();
         final_check_status mk_interface_eqs_at_final_check();
@@ -239,6 +239,28 @@ namespace smt {
 
 
 
+    /**
+       \brief Return true if the equivalence classes satisfy axiom 2 for store and select.
+       That is, the indices are equal, or select(store, is) and select(a, is) both exist
+       and are equal.
+    */
+    bool theory_array_base::is_store_axiom2_sat(enode * store, enode * select) {
+        unsigned num_args = select->get_num_args();
+        unsigned        i = 1;
+        for (; i < num_args; i++) 
+            if (store->get_arg(i)->get_root() != select->get_arg(i)->get_root())
+                break;
+        if (i == num_args)
+            return true;
+        ptr_buffer<enode> args;
+        args.push_back(store);
+        args.append(num_args - 1, select->get_args() + 1);
+        enode * sel1 = ctx.get_enode_eq_to(select->get_decl(), args.size(), args.data());
+        args[0] = store->get_arg(0);
+        enode * sel2 = ctx.get_enode_eq_to(select->get_decl(), args.size(), args.data());
+        return sel1 && sel2 && sel1->get_root() == sel2->get_root();
+    }
+
     func_decl_ref_vector * theory_array_base::register_sort(sort * s_array) {
         unsigned dimension = get_dimension(s_array);
         func_decl_ref_vector * ext_skolems = nullptr;
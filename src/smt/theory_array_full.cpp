@@ -797,7 +797,7 @@ namespace smt {
 
     final_check_status theory_array_full::assert_delayed_axioms() {        
         final_check_status r = FC_DONE;
-        if (!m_params.m_array_delay_exp_axiom) {
+        if (!m_params.m_array_delay_exp_axiom && !m_params.m_array_lazy_axioms) {
             r = FC_DONE;
         }
         else { 
@@ -893,6 +893,10 @@ namespace smt {
         if (approximate_term(term)) {
             return false;
         }
+        if (should_delay(term)) {
+            internalize_delayed(term);
+            return true;
+        }
         switch (term->get_decl_kind()) {
         case OP_BV_NUM:         internalize_num(term); return true;
         case OP_BADD:           internalize_add(term); return true;
@@ -951,6 +955,133 @@ namespace smt {
         }
     }
 
+    /**
+       \brief Multipliers, dividers and shifts are not bit-blasted eagerly when bv.delay is set.
+       Small terms and terms with at most one non-constant argument are always blasted.
+    */
+    bool theory_bv::should_delay(app * n) const {
+        if (!params().m_bv_delay)
+            return false;
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:
+        case OP_BSDIV_I:
+        case OP_BUDIV_I:
+        case OP_BSREM_I:
+        case OP_BUREM_I:
+        case OP_BSMOD_I:
+        case OP_BSHL:
+        case OP_BLSHR:
+        case OP_BASHR:
+            break;
+        default:
+            return false;
+        }
+#if ENABLE_QUOT_REM_ENCODING
+        if (n->get_decl_kind() == OP_BUDIV_I)
+            return false;
+#endif
+        if (get_bv_size(n) <= 12)
+            return false;
+        unsigned num_vars = 0;
+        for (expr * arg : *n)
+            if (!m.is_value(arg))
+                ++num_vars;
+        return num_vars > 1;
+    }
+
+    /**
+       \brief Treat n as an uninterpreted term with fresh bits. 
+       The bits are tied to the circuit in final_check_eh if the current
+       assignment violates the semantics of n.
+    */
+    void theory_bv::internalize_delayed(app * n) {
+        process_args(n);
+        enode * e = mk_enode(n);
+        for (unsigned i = 0; i < n->get_num_args(); ++i)
+            get_arg_var(e, i);
+        mk_bits(e->get_th_var(get_id()));
+        m_delayed.push_back(n);
+        m_trail_stack.push(push_back_vector<ptr_vector<app>>(m_delayed));
+        ++m_stats.m_num_delayed;
+    }
+
+    /**
+       \brief Return true if the bits of n agree with the value of the operation applied to the values of its arguments.
+    */
+    bool theory_bv::check_delayed(app * n) {
+        enode * e = ctx.get_enode(n);
+        numeral val;
+        if (!get_fixed_value(e->get_th_var(get_id()), val))
+            return false;
+        expr_ref_vector args(m);
+        for (unsigned i = 0; i < n->get_num_args(); ++i) {
+            numeral arg_val;
+            if (!get_fixed_value(get_arg_var(e, i), arg_val))
+                return false;
+            args.push_back(m_util.mk_numeral(arg_val, get_bv_size(to_app(n->get_arg(i)))));
+        }
+        expr_ref r(m.mk_app(n->get_decl(), args), m);
+        ctx.get_rewriter()(r);
+        numeral r_val;
+        return m_util.is_numeral(r, r_val) && r_val == val;
+    }
+
+    void theory_bv::blast_delayed(app * n) {
+        enode * e = ctx.get_enode(n);
+        theory_var v = e->get_th_var(get_id());
+        expr_ref_vector bits(m), arg1_bits(m), arg2_bits(m);
+        unsigned i = n->get_num_args() - 1;
+        get_arg_bits(e, i, bits);
+        while (i > 0) {
+            --i;
+            arg1_bits.reset();
+            get_arg_bits(e, i, arg1_bits);
+            arg2_bits.reset();
+            unsigned sz = bits.size();
+            switch (n->get_decl_kind()) {
+            case OP_BMUL:    m_bb.mk_multiplier(sz, arg1_bits.data(), bits.data(), arg2_bits); break;
+            case OP_BSDIV_I: m_bb.mk_sdiv(sz, arg1_bits.data(), bits.data(), arg2_bits); break;
+            case OP_BUDIV_I: m_bb.mk_udiv(sz, arg1_bits.data(), bits.data(), arg2_bits); break;
+            case OP_BSREM_I: m_bb.mk_srem(sz, arg1_bits.data(), bits.data(), arg2_bits); break;
+            case OP_BUREM_I: m_bb.mk_urem(sz, arg1_bits.data(), bits.data(), arg2_bits); break;
+            case OP_BSMOD_I: m_bb.mk_smod(sz, arg1_bits.data(), bits.data(), arg2_bits); break;
+            case OP_BSHL:    m_bb.mk_shl(sz, arg1_bits.data(), bits.data(), arg2_bits); break;
+            case OP_BLSHR:   m_bb.mk_lshr(sz, arg1_bits.data(), bits.data(), arg2_bits); break;
+            case OP_BASHR:   m_bb.mk_ashr(sz, arg1_bits.data(), bits.data(), arg2_bits); break;
+            default: UNREACHABLE(); break;
+            }
+            bits.swap(arg2_bits);
+        }
+        ctx.internalize(bits.data(), bits.size(), true);
+        literal_vector const & n_bits = m_bits[v];
+        for (unsigned j = 0; j < bits.size(); ++j) {
+            literal def = ctx.get_literal(bits.get(j));
+            literal b   = n_bits[j];
+            ctx.mark_as_relevant(def);
+            ctx.mk_th_axiom(get_id(), ~b, def);
+            ctx.mk_th_axiom(get_id(), b, ~def);
+        }
+        m_delayed_blasted.insert(n);
+        m_trail_stack.push(insert_obj_trail<app>(m_delayed_blasted, n));
+        ++m_stats.m_num_delayed_blasts;
+    }
+
+    /**
+       \brief Bit-blast the relevant delayed terms whose value is inconsistent with the current assignment.
+    */
+    final_check_status theory_bv::check_delayed() {
+        bool blasted = false;
+        for (unsigned i = 0; i < m_delayed.size(); ++i) {
+            app * n = m_delayed[i];
+            if (m_delayed_blasted.contains(n) || !ctx.is_relevant(n) || check_delayed(n))
+                continue;
+            TRACE("bv", tout << "blast delayed " << mk_bounded_pp(n, m) << "\n";);
+            blast_delayed(n);
+            blasted = true;
+        }
+        return blasted ? FC_CONTINUE : FC_DONE;
+    }
+
     bool theory_bv::internalize_term(app * term) {
         scoped_suspend_rlimit _suspend_cancel(m.limit());
         try {
@@ -1453,7 +1584,7 @@ namespace smt {
         if (m_approximates_large_bvs) {
             return FC_GIVEUP;
         }
-        return FC_DONE;
+        return check_delayed();
     }
 
     void theory_bv::reset_eh() {
@@ -1866,6 +1997,8 @@ namespace smt {
         st.update("bv bit2core", m_stats.m_num_bit2core);
         st.update("bv->core eq", m_stats.m_num_th2core_eq);
         st.update("bv dynamic eqs", m_stats.m_num_eq_dynamic);
+        st.update("bv delayed", m_stats.m_num_delayed);
+        st.update("bv delayed blasts", m_stats.m_num_delayed_blasts);
     }
 
     theory_bv::var_enode_pos theory_bv::get_bv_with_theory(bool_var v, theory_id id) const {
@@ -30,7 +30,7 @@ namespace smt {
     
     struct theory_bv_stats {
         unsigned   m_num_diseq_static, m_num_diseq_dynamic, m_num_bit2core, m_num_th2core_eq, m_num_conflicts;
-        unsigned   m_num_eq_dynamic;
+        unsigned   m_num_eq_dynamic, m_num_delayed, m_num_delayed_blasts;
         void reset() { memset(this, 0, sizeof(theory_bv_stats)); }
         theory_bv_stats() { reset(); }
     };
@@ -138,6 +138,8 @@ namespace smt {
         literal_vector           m_tmp_literals;
         svector<var_pos>         m_prop_queue;
         bool                     m_approximates_large_bvs;
+        ptr_vector<app>          m_delayed;          // terms whose bit-blasting is delayed (bv.delay)
+        obj_hashtable<app>       m_delayed_blasted;  // delayed terms that have been bit-blasted in the current scope
 
         theory_var find(theory_var v) const { return m_find.find(v); }
         theory_var next(theory_var v) const { return m_find.next(v); }
@@ -179,6 +181,11 @@ namespace smt {
         void add_fixed_eq(theory_var v1, theory_var v2);
         bool get_fixed_value(theory_var v, numeral & result) const;
         bool internalize_term_core(app * term);
+        bool should_delay(app * n) const;
+        void internalize_delayed(app * n);
+        bool check_delayed(app * n);
+        void blast_delayed(app * n);
+        final_check_status check_delayed();
         void internalize_num(app * n);
         void internalize_add(app * n);
         void internalize_sub(app * n);
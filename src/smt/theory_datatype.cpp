@@ -269,6 +269,7 @@ namespace smt {
         ctx.attach_th_var(n, this, r);
         if (is_constructor(n)) {
             d->m_constructor = n;
+            oc_add_dirty(n);
             assert_accessor_axioms(n);
         }
         else if (is_update_field(n)) {
@@ -476,18 +477,54 @@ namespace smt {
         SASSERT(m_find.get_num_vars() == get_num_vars());
     }
 
+    void theory_datatype::oc_add_dirty(enode * n) {
+        if (m_oc_full || !m_util.is_recursive(n->get_sort()))
+            return;
+        if (is_constructor(n)) {
+            for (enode * arg : enode::args(n)) {
+                sort * s = arg->get_sort(), * se = nullptr;
+                if ((m_autil.is_array(s) && m_util.is_datatype(get_array_range(s))) || 
+                    (m_sutil.is_seq(s, se) && m_util.is_datatype(se))) {
+                    m_oc_full = true;
+                    return;
+                }
+            }
+        }
+        m_oc_dirty.push_back(n);
+        m_trail_stack.push(push_back_vector<ptr_vector<enode>>(m_oc_dirty));
+    }
+
+    /**
+       \brief occurs check for the classes that gained constructor edges 
+       since the last check. Return true if a cycle was found.
+    */
+    bool theory_datatype::oc_check_dirty() {
+        for (unsigned i = m_oc_qhead; i < m_oc_dirty.size(); ++i) {
+            enode * n = m_oc_dirty[i];
+            if (!oc_cycle_free(n) && occurs_check(n))
+                return true;
+        }
+        if (m_oc_qhead < m_oc_dirty.size()) {
+            m_trail_stack.push(value_trail<unsigned>(m_oc_qhead));
+            m_oc_qhead = m_oc_dirty.size();
+        }
+        return false;
+    }
+
     final_check_status theory_datatype::final_check_eh() {
         force_push();
         int num_vars = get_num_vars();
         final_check_status r = FC_DONE;
         final_check_st _guard(this); 
+        if (!m_oc_full && oc_check_dirty())
+            return FC_CONTINUE;
         for (int v = 0; v < num_vars; v++) {
             if (v == static_cast<int>(m_find.find(v))) {
                 enode * node = get_enode(v);
                 sort* s = node->get_sort();
                 if (!m_util.is_datatype(s))
                     continue;
-                if (m_util.is_recursive(s) && !oc_cycle_free(node) && occurs_check(node)) {
+                if (m_oc_full && m_util.is_recursive(s) && !oc_cycle_free(node) && occurs_check(node)) {
                     // conflict was detected... 
                     // return...
                     return FC_CONTINUE;
@@ -740,6 +777,9 @@ namespace smt {
         m_trail_stack.reset();
         std::for_each(m_var_data.begin(), m_var_data.end(), delete_proc<var_data>());
         m_var_data.reset();
+        m_oc_dirty.reset();
+        m_oc_qhead = 0;
+        m_oc_full = false;
         theory::reset_eh();
         m_util.reset();
         m_stats.reset();
@@ -874,6 +914,8 @@ namespace smt {
                 d1->m_constructor = d2->m_constructor;
             }
         }
+        if (d1->m_constructor != nullptr)
+            oc_add_dirty(get_enode(v1));
         for (enode* e : d2->m_recognizers) 
             if (e)
                 add_recognizer(v1, e);
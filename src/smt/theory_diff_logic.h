@@ -51,6 +51,7 @@ namespace smt {
         unsigned   m_num_core2th_eqs;
         unsigned   m_num_core2th_diseqs;
         unsigned   m_num_core2th_new_diseqs;
+        unsigned   m_num_implied_atoms;
         void reset() {
             memset(this, 0, sizeof(*this));
         }
@@ -88,6 +89,23 @@ namespace smt {
 
         typedef ptr_vector<atom> atoms;
         typedef u_map<atom*>     bool_var2atom;
+
+        // atom implied by an asserted edge; the path that implies it
+        // is only searched for when the atom takes part in a conflict.
+        class implied_atom_justification : public justification {
+            theory_diff_logic& m_th;
+            edge_id            m_bridge_edge;
+            edge_id            m_subsumed_edge;
+        public:
+            implied_atom_justification(theory_diff_logic& th, edge_id bridge, edge_id subsumed):
+                m_th(th), m_bridge_edge(bridge), m_subsumed_edge(subsumed) {}
+            void get_antecedents(conflict_resolution & cr) override {
+                m_th.get_implied_bound_antecedents(m_bridge_edge, m_subsumed_edge, cr);
+            }
+            theory_id get_from_theory() const override { return m_th.get_id(); }
+            proof * mk_proof(conflict_resolution & cr) override { UNREACHABLE(); return nullptr; }
+            char const * get_name() const override { return "dl-implied-atom"; }
+        };
               
 
         // Auxiliary info for propagating cheap equalities
@@ -193,6 +211,7 @@ namespace smt {
         arith_factory *                m_factory;
         rational                       m_delta;
         nc_functor                     m_nc_functor;   
+        svector<edge_id>               m_subsumed;
 
         // For optimization purpose
         typedef vector <std::pair<theory_var, rational> > objective_term;
@@ -334,6 +353,8 @@ namespace smt {
 
         bool propagate_atom(atom* a);
 
+        void propagate_implied_atoms(edge_id id);
+
         theory_var mk_term(app* n);
 
         theory_var mk_num(app* n, rational const& r);
@@ -350,6 +371,8 @@ namespace smt {
 
         bool propagate_eqs() const { return m_params.m_arith_propagate_eqs; }
 
+        unsigned dl_propagation() const { return m.proofs_enabled() ? 0 : m_params.m_arith_dl_propagation; }
+
         theory_var expand(bool pos, theory_var v, rational & k);
 
         void new_eq_or_diseq(bool is_eq, theory_var v1, theory_var v2, justification& eq_just);
@@ -329,6 +329,7 @@ void theory_diff_logic<Ext>::collect_statistics(::statistics & st) const {
     st.update("dl asserts", m_stats.m_num_assertions);
     st.update("core->dl eqs", m_stats.m_num_core2th_eqs);
     st.update("core->dl diseqs", m_stats.m_num_core2th_diseqs);
+    st.update("dl implied atoms", m_stats.m_num_implied_atoms);
     m_arith_eq_adapter.collect_statistics(st);
     m_graph.collect_statistics(st);
 }
@@ -589,9 +590,35 @@ bool theory_diff_logic<Ext>::propagate_atom(atom* a) {
         
         return false;
     }
+    if (dl_propagation() > 0)
+        propagate_implied_atoms(edge_id);
     return true;
 }
 
+/**
+   \brief assign the atoms whose edges are implied by the enabled edge id.
+   The enabled edges keep the potential feasible, so the search for
+   subsumed edges does not revisit the rest of the graph. Explanations
+   are computed lazily from the edges enabled before id.
+*/
+template<typename Ext>
+void theory_diff_logic<Ext>::propagate_implied_atoms(edge_id id) {
+    m_subsumed.reset();
+    switch (dl_propagation()) {
+    case 1:  m_graph.find_subsumed1(id, m_subsumed); break;
+    case 2:  m_graph.find_subsumed2(id, m_subsumed); break;
+    default: m_graph.find_subsumed(id, m_subsumed); break;
+    }
+    for (edge_id e : m_subsumed) {
+        literal l = m_graph.get_explanation(e);
+        if (l == null_literal || ctx.get_assignment(l) != l_undef)
+            continue;
+        TRACE("arith", tout << "implied " << l << " by edge " << id << "\n";);
+        ++m_stats.m_num_implied_atoms;
+        ctx.assign(l, new (ctx.get_region()) implied_atom_justification(*this, id, e));
+    }
+}
+
 template<typename Ext>
 void theory_diff_logic<Ext>::new_edge(dl_var src, dl_var dst, unsigned num_edges, edge_id const* edges) {
 
@@ -292,6 +292,7 @@ class theory_lra::imp {
             m_nla->settings().grobner_number_of_conflicts_to_report = prms.arith_nl_grobner_cnfl_to_report();
             m_nla->settings().grobner_quota =               prms.arith_nl_gr_q();
             m_nla->settings().grobner_frequency =           prms.arith_nl_grobner_frequency();
+            m_nla->settings().grobner_threads =             prms.arith_nl_grobner_threads();
             m_nla->settings().expensive_patching  =         false;
         }
     }
@@ -1959,6 +1960,15 @@ public:
                   ctx().display_lemma_as_smt_problem(tout << "new cut:\n", m_core.size(), m_core.data(), m_eqs.size(), m_eqs.data(), lit);
                   display(tout););
             assign(lit, m_core, m_eqs, m_params);
+            for (auto const& c : m_lia->additional_cuts()) {
+                ++m_stats.m_gomory_cuts;
+                reset_evidence();
+                for (auto ev : c.m_ex)
+                    set_evidence(ev.ci(), m_core, m_eqs);
+                b = mk_bound(c.m_t, c.m_k, true);
+                IF_VERBOSE(4, verbose_stream() << "cut " << b << "\n");
+                assign(literal(ctx().get_bool_var(b), false), m_core, m_eqs, m_params);
+            }
             lia_check = l_false;
             break;
         }
@@ -3201,6 +3211,12 @@ public:
         
         // SASSERT(validate_conflict(m_core, m_eqs));
         if (is_conflict) {
+            if (m_eqs.empty() && ctx().get_fparams().m_lemma_cache) {
+                literal_vector lemma;
+                for (literal c : m_core)
+                    lemma.push_back(~c);
+                ctx().cache_lemma(lemma.size(), lemma.data(), true);
+            }
             ctx().set_conflict(
                 ctx().mk_justification(
                     ext_theory_conflict_justification(
@@ -21,6 +21,7 @@ Revision History:
 #include "ast/ast_util.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/for_each_expr.h"
+#include "ast/rewriter/th_rewriter.h"
 #include "smt/theory_recfun.h"
 
 
@@ -34,7 +35,8 @@ namespace smt {
           m_util(m_plugin.u()), 
           m_disabled_guards(m),
           m_enabled_guards(m),
-          m_preds(m) {
+          m_preds(m),
+          m_eval_pinned(m) {
         }
 
     theory_recfun::~theory_recfun() {
@@ -92,6 +94,8 @@ namespace smt {
         for (auto & kv : m_guard2pending) 
             dealloc(kv.m_value);
         m_guard2pending.reset();
+        m_eval_cache.reset();
+        m_eval_pinned.reset();
     }
 
     /*
@@ -312,6 +316,7 @@ namespace smt {
         ++m_stats.m_case_expansions;
         TRACEFN("assert_case_axioms " << e
                 << " with " << e.m_def->get_cases().size() << " cases");
+        assert_eval_axiom(e);
         SASSERT(e.m_def->is_fun_defined());
         // add case-axioms for all case-paths
         // assert this was not defined before.
@@ -350,6 +355,70 @@ namespace smt {
         ctx.mk_th_axiom(get_id(), preds);       
     }
 
+    /**
+     * Evaluate a call on values by rewriting, bounded by recfun.eval_steps.
+     * Return the value of the call, or null if it does not reduce to a value.
+     */
+    expr* theory_recfun::eval_call(app* call) {
+        expr* r = nullptr;
+        if (m_eval_cache.find(call, r)) {
+            ++m_stats.m_eval_cache_hits;
+            return r;
+        }
+        params_ref p;
+        p.set_uint("max_steps", ctx.get_fparams().m_recfun_eval_steps);
+        th_rewriter rw(m, p);
+        expr_ref result(m);
+        try {
+            rw(call, result);
+        }
+        catch (rewriter_exception &) {
+            result = nullptr;
+        }
+        if (result && m.is_value(result)) {
+            ++m_stats.m_evaluations;
+            r = result;
+            m_eval_pinned.push_back(r);
+        }
+        m_eval_pinned.push_back(call);
+        m_eval_cache.insert(call, r);
+        TRACEFN("eval " << mk_pp(call, m) << " := " << (r ? mk_pp(r, m) : mk_pp(call, m)));
+        return r;
+    }
+
+    /**
+     * For an occurrence f(args) where args are equal to values vals, 
+     * assert args = vals => f(args) = f(vals), where f(vals) is computed 
+     * by evaluation. Case expansion proceeds as usual, the axiom short-cuts 
+     * the unfolding of f below the current depth.
+     */
+    void theory_recfun::assert_eval_axiom(recfun::case_expansion & e) {
+        if (ctx.get_fparams().m_recfun_eval_steps == 0)
+            return;
+        expr_ref_vector vals(m);
+        for (expr* arg : e.m_args) {
+            if (!ctx.e_internalized(arg))
+                return;
+            expr* v = ctx.get_enode(arg)->get_root()->get_expr();
+            if (!m.is_value(v))
+                return;
+            vals.push_back(v);
+        }
+        app_ref call(u().mk_fun_defined(*e.m_def, vals), m);
+        expr* val = eval_call(call);
+        if (!val)
+            return;
+        literal_vector clause;
+        for (unsigned i = 0; i < vals.size(); ++i) 
+            if (e.m_args.get(i) != vals.get(i))
+                clause.push_back(~mk_eq_lit(e.m_args.get(i), vals.get(i)));
+        clause.push_back(mk_eq_lit(e.m_lhs, val));
+        TRACEFN("eval axiom " << pp_lits(ctx, clause));
+        std::function<literal_vector(void)> fn = [&]() { return clause; };
+        scoped_trace_stream _tr(*this, fn);
+        ctx.mk_th_axiom(get_id(), clause);
+    }
+
     void theory_recfun::activate_guard(expr* pred_applied, expr_ref_vector const& guards) {
         literal concl = mk_literal(pred_applied);
         literal_vector lguards;
@@ -485,6 +554,8 @@ namespace smt {
         st.update("recfun macro expansion", m_stats.m_macro_expansions);
         st.update("recfun case expansion", m_stats.m_case_expansions);
         st.update("recfun body expansion", m_stats.m_body_expansions);
+        st.update("recfun evaluations", m_stats.m_evaluations);
+        st.update("recfun evaluation cache hits", m_stats.m_eval_cache_hits);
     }
 
 }
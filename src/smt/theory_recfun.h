@@ -29,6 +29,7 @@ namespace smt {
     class theory_recfun : public theory {
         struct stats {
             unsigned m_case_expansions, m_body_expansions, m_macro_expansions;
+            unsigned m_evaluations, m_eval_cache_hits;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -46,6 +47,11 @@ namespace smt {
         unsigned_vector          m_preds_lim;
         unsigned                 m_num_rounds { 0 };
 
+        // values of calls on value arguments, null if evaluation failed.
+        // Definitions do not change, so the cache is kept across checks.
+        obj_map<app, expr*>      m_eval_cache;
+        expr_ref_vector          m_eval_pinned;
+
         typedef recfun::propagation_item propagation_item;
 
         scoped_ptr_vector<propagation_item> m_propagation_queue;
@@ -73,6 +79,8 @@ namespace smt {
         void assert_macro_axiom(recfun::case_expansion & e);
         void assert_case_axioms(recfun::case_expansion & e);
         void assert_body_axiom(recfun::body_expansion & e);
+        expr* eval_call(app* call);
+        void assert_eval_axiom(recfun::case_expansion & e);
         void block_core(expr_ref_vector const& core);
         literal mk_literal(expr* e);
 
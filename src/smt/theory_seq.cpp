@@ -1905,6 +1905,7 @@ void theory_seq::collect_statistics(::statistics & st) const {
     st.update("seq fixed length", m_stats.m_fixed_length);
     st.update("seq int.to.str", m_stats.m_int_string);
     st.update("seq str.from_ubv", m_stats.m_ubv_string);
+    st.update("seq eager length", m_stats.m_eager_length);
 }
 
 void theory_seq::init_search_eh() {
@@ -3180,6 +3181,8 @@ void theory_seq::new_eq_eh(dependency* deps, enode* n1, enode* n2) {
         m_eqs.push_back(mk_eqdep(o1, o2, deps));
         solve_eqs(m_eqs.size()-1);
         enforce_length_coherence(n1, n2);
+        if (get_fparams().m_seq_eager_length && (!has_length(o1) || !has_length(o2)) && add_length_to_eqc(o1))
+            ++m_stats.m_eager_length;
     }
     else if (n1 != n2 && m_util.is_re(e1)) {
         UNREACHABLE();
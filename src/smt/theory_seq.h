@@ -319,6 +319,7 @@ namespace smt {
             unsigned m_propagate_contains;
             unsigned m_int_string;
             unsigned m_ubv_string;
+            unsigned m_eager_length;
         };
         typedef hashtable<rational, rational::hash_proc, rational::eq_proc> rational_set;
 
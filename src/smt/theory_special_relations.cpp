@@ -72,6 +72,7 @@ namespace smt {
         ensure_var(v2);
         literal_vector ls;
         ls.push_back(l);
+        ++m_version;
         return m_graph.add_non_strict_edge(v1, v2, ls) && m_graph.add_non_strict_edge(v2, v1, ls);
     }
 
@@ -424,6 +425,7 @@ namespace smt {
                 TRACE("special_relations", tout << "added edge\n";);
                 r.m_explanation.push_back(a.explanation());
                 literal_vector const& lits = r.m_explanation;
+                ++r.m_version;
                 if (!r.m_graph.add_non_strict_edge(a.v2(), a.v1(), lits)) {
                     set_neg_cycle_conflict(r);
                     return l_false;
@@ -579,23 +581,42 @@ namespace smt {
         return l_true;
     }
 
+    /**
+       \brief check that v1 !-> v2 is not contradicted by a path v1 -> v3 -> v4 -> v2 
+       for the asserted negative atoms. The atoms are grouped by source so that one 
+       search from a source answers reachability of all its targets. The search is 
+       skipped if no atom was asserted and no edge was added since the last check.
+    */
     lbool theory_special_relations::final_check_po(relation& r) {
-        for (atom* ap : r.m_asserted_atoms) {
-            atom& a = *ap;
-            if (!a.phase() && r.m_uf.find(a.v1()) == r.m_uf.find(a.v2())) {
-                // v1 !-> v2
-                // find v1 -> v3 -> v4 -> v2 path
+        if (r.m_version == r.m_po_version)
+            return l_true;
+        m_po_atoms.reset();
+        for (atom* ap : r.m_asserted_atoms) 
+            if (!ap->phase() && r.m_uf.find(ap->v1()) == r.m_uf.find(ap->v2())) 
+                m_po_atoms.push_back(ap);
+        std::stable_sort(m_po_atoms.begin(), m_po_atoms.end(), [](atom* a, atom* b) { return a->v1() < b->v1(); });
+        unsigned timestamp = r.m_graph.get_timestamp();
+        m_reached_mark.reserve(r.m_graph.get_num_nodes(), false);
+        for (unsigned i = 0; i < m_po_atoms.size(); ) {
+            theory_var src = m_po_atoms[i]->v1();
+            r.m_graph.get_reachable(src, timestamp, m_reached, m_reached_mark);
+            atom* conflict = nullptr;
+            for (; i < m_po_atoms.size() && m_po_atoms[i]->v1() == src; ++i) 
+                if (!conflict && m_reached_mark[m_po_atoms[i]->v2()])
+                    conflict = m_po_atoms[i];
+            for (dl_var v : m_reached)
+                m_reached_mark[v] = false;
+            if (conflict) {
+                atom& a = *conflict;
                 r.m_explanation.reset();
-                unsigned timestamp = r.m_graph.get_timestamp();
-                bool found_path = r.m_graph.find_shortest_reachable_path(a.v1(), a.v2(), timestamp, r);
-                if (found_path) {
-                    TRACE("special_relations", tout << "check po conflict\n";);
-                    r.m_explanation.push_back(a.explanation());
-                    set_conflict(r);
-                    return l_false;
-                }
+                VERIFY(r.m_graph.find_shortest_reachable_path(a.v1(), a.v2(), timestamp, r));
+                TRACE("special_relations", tout << "check po conflict\n";);
+                r.m_explanation.push_back(a.explanation());
+                set_conflict(r);
+                return l_false;
             }
         }
+        r.m_po_version = r.m_version;
         return l_true;
     }
 
@@ -649,6 +670,7 @@ namespace smt {
         atom* a = m_bool_var2atom[v];
         a->set_phase(is_true);
         a->get_relation().m_asserted_atoms.push_back(a);
+        ++a->get_relation().m_version;
         m_can_propagate = true;
     }
 
@@ -64,6 +64,7 @@ namespace smt {
             literal explanation() const { return literal(m_bvar, !m_phase); }
             bool enable() {
                 edge_id edge = m_phase?m_pos:m_neg;
+                ++m_relation.m_version;
                 return m_relation.m_graph.enable_edge(edge);
             }
         };
@@ -102,6 +103,12 @@ namespace smt {
             union_find_default_ctx m_ufctx;
             union_find_t           m_uf;
             literal_vector         m_explanation;
+            // incremented when atoms are asserted or edges are added, not 
+            // restored on backtracking. Backtracking only removes edges, so
+            // a final check that found no path remains valid while the 
+            // version is unchanged.
+            unsigned               m_version = 0;
+            unsigned               m_po_version = UINT_MAX;
 
             relation(sr_property p, func_decl* d, ast_manager& m): m(m), m_next(m), m_property(p), m_decl(d), m_asserted_qhead(0), m_uf(m_ufctx) {}
 
@@ -134,6 +141,9 @@ namespace smt {
         obj_map<func_decl, relation*>  m_relations;
         bool_var2atom                  m_bool_var2atom;
         bool                           m_can_propagate;
+        ptr_vector<atom>               m_po_atoms;
+        svector<dl_var>                m_reached;
+        bool_vector                    m_reached_mark;
         
 
         void del_atoms(unsigned old_size);
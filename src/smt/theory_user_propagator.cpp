@@ -28,7 +28,11 @@ theory_user_propagator::theory_user_propagator(context& ctx):
     theory(ctx, ctx.get_manager().mk_family_id(user_propagator::plugin::name())),
     m_var2expr(ctx.get_manager()),
     m_push_popping(false),
-    m_to_add(ctx.get_manager())
+    m_to_add(ctx.get_manager()),
+    m_batch_fixed(ctx.get_manager()),
+    m_batch_values(ctx.get_manager()),
+    m_batch_lhs(ctx.get_manager()),
+    m_batch_rhs(ctx.get_manager())
 {}
 
 theory_user_propagator::~theory_user_propagator() {
@@ -41,7 +45,10 @@ void theory_user_propagator::force_push() {
         theory::push_scope_eh();
         m_prop_lim.push_back(m_prop.size());
         m_to_add_lim.push_back(m_to_add.size());
-        m_push_eh(m_user_context, this);
+        if (m_native)
+            m_native->push(*this);
+        else
+            m_push_eh(m_user_context, this);
     }
 }
 
@@ -115,7 +122,27 @@ void theory_user_propagator::next_split_cb(expr* e, unsigned idx, lbool phase) {
     m_next_split_phase = phase;
 }
 
+lbool theory_user_propagator::get_value_cb(expr* e) {
+    if (!ctx.b_internalized(e))
+        return l_undef;
+    return ctx.get_assignment(e);
+}
+
+void theory_user_propagator::push_trail_cb(trail* t) {
+    force_push();
+    ctx.push_trail_ptr(t);
+}
+
 theory * theory_user_propagator::mk_fresh(context * new_ctx) {
+    if (m_native) {
+        user_propagator::native* p = m_native->fresh(new_ctx->get_manager());
+        if (!p)
+            throw default_exception("native user propagator cannot be copied");
+        auto* th = alloc(theory_user_propagator, *new_ctx);
+        th->m_owned_native.reset(p);
+        th->register_native(p);
+        return th;
+    }
     auto* th = alloc(theory_user_propagator, *new_ctx);
     void* ctx;
     try {
@@ -131,17 +158,22 @@ theory * theory_user_propagator::mk_fresh(context * new_ctx) {
     if ((bool)m_diseq_eh) th->register_diseq(m_diseq_eh);
     if ((bool)m_created_eh) th->register_created(m_created_eh);
     if ((bool)m_decide_eh) th->register_decide(m_decide_eh);
+    if ((bool)m_batch_eh) th->register_batch(m_batch_eh);
     return th;
 }
 
 final_check_status theory_user_propagator::final_check_eh() {
-    if (!(bool)m_final_eh)
+    if (!(bool)m_final_eh && !m_native)
         return FC_DONE;
     force_push();
     unsigned sz1 = m_prop.size();
     unsigned sz2 = m_expr2var.size();
+    flush_batch();
     try {
-        m_final_eh(m_user_context, this);
+        if (m_native)
+            m_native->final(*this);
+        else
+            m_final_eh(m_user_context, this);
     }
     catch (...) {
       throw default_exception("Exception thrown in \"final\"-callback");
@@ -155,7 +187,7 @@ final_check_status theory_user_propagator::final_check_eh() {
 }
 
 void theory_user_propagator::new_fixed_eh(theory_var v, expr* value, unsigned num_lits, literal const* jlits) {
-    if (!m_fixed_eh)
+    if (!m_fixed_eh && !m_batch_eh && !m_native)
         return;
     force_push();
     if (m_fixed.contains(v))
@@ -163,14 +195,64 @@ void theory_user_propagator::new_fixed_eh(theory_var v, expr* value, unsigned nu
     m_fixed.insert(v);
     ctx.push_trail(insert_map<uint_set, unsigned>(m_fixed, v));
     m_id2justification.setx(v, literal_vector(num_lits, jlits), literal_vector());
+    if (m_batch_eh) {
+        m_batch_fixed.push_back(var2expr(v));
+        m_batch_values.push_back(value);
+        return;
+    }
     try {
-         m_fixed_eh(m_user_context, this, var2expr(v), value);
+        if (m_native)
+            m_native->fixed(*this, var2expr(v), value);
+        else
+            m_fixed_eh(m_user_context, this, var2expr(v), value);
      }
      catch (...) {
         throw default_exception("Exception thrown in \"fixed\"-callback");
      }
 }
 
+void theory_user_propagator::new_eq_eh(theory_var v1, theory_var v2) {
+    if (m_batch_eh) {
+        m_batch_lhs.push_back(var2expr(v1));
+        m_batch_rhs.push_back(var2expr(v2));
+    }
+    else if (m_native)
+        force_push(), m_native->eq(*this, var2expr(v1), var2expr(v2));
+    else if (m_eq_eh)
+        force_push(), m_eq_eh(m_user_context, this, var2expr(v1), var2expr(v2));
+}
+
+void theory_user_propagator::new_diseq_eh(theory_var v1, theory_var v2) {
+    if (m_native)
+        force_push(), m_native->diseq(*this, var2expr(v1), var2expr(v2));
+    else if (m_diseq_eh)
+        force_push(), m_diseq_eh(m_user_context, this, var2expr(v1), var2expr(v2));
+}
+
+/**
+   \brief deliver the pending fixed and equality events in one call.
+   Events are delivered before the solver backtracks over them, before
+   the final check, and at the end of propagation, so the client sees
+   the same events at the same scopes as with one call per event.
+*/
+void theory_user_propagator::flush_batch() {
+    if (!has_batch())
+        return;
+    force_push();
+    expr_ref_vector fixed(m), values(m), lhs(m), rhs(m);
+    fixed.swap(m_batch_fixed);
+    values.swap(m_batch_values);
+    lhs.swap(m_batch_lhs);
+    rhs.swap(m_batch_rhs);
+    ++m_stats.m_num_batches;
+    try {
+        m_batch_eh(m_user_context, this, fixed.size(), fixed.data(), values.data(), lhs.size(), lhs.data(), rhs.data());
+    }
+    catch (...) {
+        throw default_exception("Exception thrown in \"batch\"-callback");
+    }
+}
+
 bool_var theory_user_propagator::enode_to_bool(enode* n, unsigned bit) {
     if (n->is_bool()) {
         // expression is a boolean
@@ -278,6 +360,7 @@ void theory_user_propagator::push_scope_eh() {
 }
 
 void theory_user_propagator::pop_scope_eh(unsigned num_scopes) {
+    flush_batch();
     flet<bool> _popping(m_push_popping, true);
     unsigned n = std::min(num_scopes, m_num_scopes);
     m_num_scopes -= n;
@@ -291,11 +374,14 @@ void theory_user_propagator::pop_scope_eh(unsigned num_scopes) {
     old_sz = m_to_add_lim.size() - num_scopes;
     m_to_add.shrink(m_to_add_lim[old_sz]);
     m_to_add_lim.shrink(old_sz);
-    m_pop_eh(m_user_context, this, num_scopes);
+    if (m_native)
+        m_native->pop(*this, num_scopes);
+    else
+        m_pop_eh(m_user_context, this, num_scopes);
 }
 
 bool theory_user_propagator::can_propagate() {
-    return m_qhead < m_prop.size() || m_to_add_qhead < m_to_add.size();
+    return m_qhead < m_prop.size() || m_to_add_qhead < m_to_add.size() || has_batch();
 }
 
 void theory_user_propagator::propagate_consequence(prop_info const& prop) {
@@ -365,7 +451,7 @@ void theory_user_propagator::propagate_new_fixed(prop_info const& prop) {
 
 
 void theory_user_propagator::propagate() {
-    if (m_qhead == m_prop.size() && m_to_add_qhead == m_to_add.size())
+    if (m_qhead == m_prop.size() && m_to_add_qhead == m_to_add.size() && !has_batch())
         return;
     TRACE("user_propagate", tout << "propagating queue head: " << m_qhead << " prop queue: " << m_prop.size() << "\n");
     force_push();
@@ -390,6 +476,8 @@ void theory_user_propagator::propagate() {
     }
     ctx.push_trail(value_trail<unsigned>(m_qhead));
     m_qhead = qhead;
+    if (!ctx.inconsistent())
+        flush_batch();
 }
 
 
@@ -404,6 +492,11 @@ bool theory_user_propagator::internalize_term(app* term)  {
         ctx.mk_enode(term, true, false, true);
     
     add_expr(term, false);
+
+    if (m_native) {
+        m_native->created(*this, term);
+        return true;
+    }
     
     if (!m_created_eh)
         throw default_exception("You have to register a created event handler for new terms if you track them");
@@ -421,6 +514,8 @@ bool theory_user_propagator::internalize_term(app* term)  {
 void theory_user_propagator::collect_statistics(::statistics & st) const {
     st.update("user-propagations", m_stats.m_num_propagations);
     st.update("user-watched",      get_num_vars());
+    if (m_stats.m_num_batches > 0)
+        st.update("user-batches",  m_stats.m_num_batches);
 }
 
 
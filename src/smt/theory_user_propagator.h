@@ -22,6 +22,7 @@ Notes:
 
 #pragma once
 
+#include <memory>
 #include "util/uint_set.h"
 #include "smt/smt_theory.h"
 #include "solver/solver.h"
@@ -52,6 +53,7 @@ namespace smt {
 
         struct stats {
             unsigned m_num_propagations;
+            unsigned m_num_batches;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -66,6 +68,9 @@ namespace smt {
         user_propagator::eq_eh_t        m_diseq_eh;
         user_propagator::created_eh_t   m_created_eh;
         user_propagator::decide_eh_t    m_decide_eh;
+        user_propagator::batch_eh_t     m_batch_eh;
+        user_propagator::native*        m_native = nullptr;
+        std::unique_ptr<user_propagator::native> m_owned_native;   // copy made by mk_fresh
 
         user_propagator::context_obj*   m_api_context = nullptr;
         unsigned               m_qhead = 0;
@@ -86,6 +91,8 @@ namespace smt {
         expr*                  m_next_split_expr = nullptr;
         unsigned               m_next_split_idx;
         lbool                  m_next_split_phase;
+        expr_ref_vector        m_batch_fixed, m_batch_values;   // fixed events not yet delivered
+        expr_ref_vector        m_batch_lhs, m_batch_rhs;        // equality events not yet delivered
 
         expr* var2expr(theory_var v) { return m_var2expr.get(v); }
         theory_var expr2var(expr* e) { check_defined(e); return m_expr2var[e->get_id()]; }
@@ -98,6 +105,8 @@ namespace smt {
 
         void propagate_consequence(prop_info const& prop);
         void propagate_new_fixed(prop_info const& prop);
+        bool has_batch() const { return !m_batch_fixed.empty() || !m_batch_lhs.empty(); }
+        void flush_batch();
         
         bool_var enode_to_bool(enode* n, unsigned bit);
 
@@ -128,12 +137,16 @@ namespace smt {
         void register_diseq(user_propagator::eq_eh_t& diseq_eh) { m_diseq_eh = diseq_eh; }
         void register_created(user_propagator::created_eh_t& created_eh) { m_created_eh = created_eh; }
         void register_decide(user_propagator::decide_eh_t& decide_eh) { m_decide_eh = decide_eh; }
+        void register_batch(user_propagator::batch_eh_t& batch_eh) { m_batch_eh = batch_eh; }
+        void register_native(user_propagator::native* p) { m_native = p; }
 
-        bool has_fixed() const { return (bool)m_fixed_eh; }
+        bool has_fixed() const { return (bool)m_fixed_eh || (bool)m_batch_eh || m_native; }
         
         void propagate_cb(unsigned num_fixed, expr* const* fixed_ids, unsigned num_eqs, expr* const* lhs, expr* const* rhs, expr* conseq) override;
         void register_cb(expr* e) override;
         void next_split_cb(expr* e, unsigned idx, lbool phase) override;
+        lbool get_value_cb(expr* e) override;
+        void push_trail_cb(trail* t) override;
 
         void new_fixed_eh(theory_var v, expr* value, unsigned num_lits, literal const* jlits);
         void decide(bool_var& var, bool& is_pos);
@@ -143,9 +156,9 @@ namespace smt {
         char const* get_name() const override { return "user_propagate"; }
         bool internalize_atom(app* atom, bool gate_ctx) override;
         bool internalize_term(app* term) override;
-        void new_eq_eh(theory_var v1, theory_var v2) override { if (m_eq_eh) force_push(), m_eq_eh(m_user_context, this, var2expr(v1), var2expr(v2)); }
-        void new_diseq_eh(theory_var v1, theory_var v2) override { if (m_diseq_eh) force_push(), m_diseq_eh(m_user_context, this, var2expr(v1), var2expr(v2)); }
-        bool use_diseqs() const override { return ((bool)m_diseq_eh); }
+        void new_eq_eh(theory_var v1, theory_var v2) override;
+        void new_diseq_eh(theory_var v1, theory_var v2) override;
+        bool use_diseqs() const override { return m_native ? m_native->use_diseqs() : (bool)m_diseq_eh; }
         bool build_models() const override { return false; }
         final_check_status final_check_eh() override;
         void reset_eh() override {}
@@ -184,6 +184,31 @@ void asserted_formulas::assert_expr(expr * e) {
     assert_expr(e, m.proofs_enabled() ? m.mk_asserted(e) : nullptr);
 }
 
+void asserted_formulas::assert_expr(unsigned n, expr * const * es) {
+    if (m.proofs_enabled()) {
+        for (unsigned i = 0; i < n; ++i)
+            assert_expr(es[i]);
+        return;
+    }
+    force_push();
+    if (inconsistent())
+        return;
+    if (m_smt_params.m_preprocess)
+        set_eliminate_and(false);
+    expr_ref r(m);
+    proof_ref pr(m);
+    for (unsigned i = 0; i < n && !inconsistent(); ++i) {
+        expr* e = es[i];
+        SASSERT(m.is_bool(e));
+        r = e;
+        if (m_smt_params.m_preprocess)
+            m_rewriter(e, r, pr);
+        m_has_quantifiers |= ::has_quantifiers(e);
+        push_assertion(r, nullptr, m_formulas);
+    }
+    TRACE("asserted_formulas_bug", tout << "after assert_expr\n"; display(tout););
+}
+
 void asserted_formulas::get_assertions(ptr_vector<expr> & result) const {
     for (justified_expr const& je : m_formulas) result.push_back(je.get_fml());
 }
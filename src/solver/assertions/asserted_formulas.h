@@ -241,7 +241,6 @@ class asserted_formulas {
     void apply_quasi_macros();
     void nnf_cnf();
     void reduce_and_solve();
-    void flush_cache() { m_rewriter.reset(); m_rewriter.set_substitution(&m_substitution); }
     void set_eliminate_and(bool flag);
     void propagate_values();
     unsigned propagate_values(unsigned i);
@@ -262,12 +261,14 @@ public:
     void setup();
     void assert_expr(expr * e, proof * in_pr);
     void assert_expr(expr * e);
+    void assert_expr(unsigned n, expr * const * es);
     void reset();
     void push_scope();
     void pop_scope(unsigned num_scopes);
     bool inconsistent() const { return m_inconsistent; }
     proof * get_inconsistency_proof() const;
     void reduce();
+    void flush_cache() { m_rewriter.reset(); m_rewriter.set_substitution(&m_substitution); }
     unsigned get_num_formulas() const { return m_formulas.size(); }
     unsigned get_formulas_last_level() const;
     unsigned get_qhead() const { return m_qhead; }
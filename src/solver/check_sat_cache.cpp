@@ -0,0 +1,151 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    check_sat_cache.cpp
+
+Abstract:
+
+    Process wide cache of the results of satisfiability checks.
+
+--*/
+#include <algorithm>
+#include "util/mutex.h"
+#include "ast/ast_translation.h"
+#include "ast/ast_util.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "solver/check_sat_cache.h"
+
+namespace {
+    struct cache_entry {
+        lbool     m_status = l_undef;
+        model_ref m_model;
+        unsigned  m_stamp = 0;
+    };
+
+    struct cache_state {
+        ast_manager                 m;
+        obj_map<expr, cache_entry*> m_entries;
+        unsigned                    m_stamp = 0;
+
+        ~cache_state() {
+            for (auto const& kv : m_entries) {
+                dealloc(kv.m_value);
+                m.dec_ref(kv.m_key);
+            }
+        }
+
+        void evict() {
+            expr* oldest = nullptr;
+            unsigned stamp = UINT_MAX;
+            for (auto const& kv : m_entries)
+                if (kv.m_value->m_stamp < stamp)
+                    oldest = kv.m_key, stamp = kv.m_value->m_stamp;
+            if (!oldest)
+                return;
+            dealloc(m_entries[oldest]);
+            m_entries.remove(oldest);
+            m.dec_ref(oldest);
+        }
+    };
+}
+
+static cache_state* g_cache = nullptr;
+static mutex g_cache_mux;
+
+check_sat_cache::check_sat_cache(ast_manager& m, expr_ref_vector const& fmls):
+    m(m),
+    m_fmls(m) {
+    th_rewriter rw(m);
+    expr_ref r(m);
+    for (expr* e : fmls) {
+        rw(e, r);
+        if (!m.is_true(r))
+            m_fmls.push_back(r);
+    }
+}
+
+/**
+   \brief translation into the manager of the cache creates the families
+   of the query that are missing. It requires that the families the
+   managers have in common have the same ids.
+*/
+bool check_sat_cache::compatible() const {
+    ast_manager& cm = g_cache->m;
+    for (family_id fid = 0; !m.get_family_name(fid).is_null(); ++fid) {
+        symbol const& n = m.get_family_name(fid);
+        symbol const& cn = cm.get_family_name(fid);
+        if (cn.is_null() ? cm.get_family_id(n) != null_family_id : cn != n)
+            return false;
+    }
+    return true;
+}
+
+expr* check_sat_cache::mk_key(ast_translation& tr) {
+    ast_manager& cm = g_cache->m;
+    expr_ref_vector args(cm);
+    for (expr* e : m_fmls)
+        args.push_back(tr(e));
+    std::sort(args.data(), args.data() + args.size(), [](expr* a, expr* b) { return a->get_id() < b->get_id(); });
+    unsigned j = 0;
+    for (unsigned i = 0; i < args.size(); ++i)
+        if (j == 0 || args.get(i) != args.get(j - 1))
+            args[j++] = args.get(i);
+    args.shrink(j);
+    expr* key = mk_and(cm, args.size(), args.data());
+    cm.inc_ref(key);
+    return key;
+}
+
+bool check_sat_cache::find(lbool& r, model_ref& mdl) {
+    lock_guard lock(g_cache_mux);
+    if (!g_cache || !compatible())
+        return false;
+    ast_manager& cm = g_cache->m;
+    ast_translation tr(m, cm);
+    expr* key = mk_key(tr);
+    cache_entry* e = nullptr;
+    bool found = g_cache->m_entries.find(key, e);
+    cm.dec_ref(key);
+    if (!found)
+        return false;
+    e->m_stamp = ++g_cache->m_stamp;
+    r = e->m_status;
+    mdl = nullptr;
+    if (e->m_model) {
+        ast_translation tr2(cm, m);
+        mdl = e->m_model->translate(tr2);
+    }
+    return true;
+}
+
+void check_sat_cache::insert(lbool r, model* mdl, unsigned capacity) {
+    if (r == l_undef || capacity == 0)
+        return;
+    lock_guard lock(g_cache_mux);
+    if (!g_cache)
+        g_cache = alloc(cache_state);
+    if (!compatible())
+        return;
+    ast_manager& cm = g_cache->m;
+    ast_translation tr(m, cm);
+    expr* key = mk_key(tr);
+    cache_entry* e = nullptr;
+    if (g_cache->m_entries.find(key, e))
+        cm.dec_ref(key);
+    else {
+        while (g_cache->m_entries.size() >= capacity)
+            g_cache->evict();
+        e = alloc(cache_entry);
+        g_cache->m_entries.insert(key, e);
+    }
+    e->m_status = r;
+    e->m_model = (r == l_true && mdl) ? mdl->translate(tr) : nullptr;
+    e->m_stamp = ++g_cache->m_stamp;
+}
+
+void check_sat_cache::finalize() {
+    dealloc(g_cache);
+    g_cache = nullptr;
+}
@@ -0,0 +1,59 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    check_sat_cache.h
+
+Abstract:
+
+    Process wide cache of the results of satisfiability checks.
+
+    A query is keyed by its assertions after rewriting with th_rewriter,
+    translated into a manager owned by the cache. Since terms are hash
+    consed, two queries get the same key when their rewritten assertions
+    are the same set of terms, independent of their order and of the
+    manager they were created in. The cache keeps the status of sat and
+    unsat results together with the model of sat results, and evicts the
+    least recently used entry when it is full.
+
+    The cache is shared by all threads and protected by a mutex.
+
+--*/
+#pragma once
+
+#include "util/lbool.h"
+#include "ast/ast.h"
+#include "model/model.h"
+
+class check_sat_cache {
+    ast_manager&    m;
+    expr_ref_vector m_fmls;
+
+    expr* mk_key(ast_translation& tr);
+    bool  compatible() const;
+
+public:
+    /**
+       \brief prepare the lookup of the conjunction of fmls.
+    */
+    check_sat_cache(ast_manager& m, expr_ref_vector const& fmls);
+
+    /**
+       \brief retrieve a cached result. r is l_true or l_false, mdl is the
+       cached model of a sat result translated into the manager of the
+       query, or null if the result was stored without a model.
+    */
+    bool find(lbool& r, model_ref& mdl);
+
+    /**
+       \brief store r, and mdl for a sat result, keeping at most capacity entries.
+    */
+    void insert(lbool r, model* mdl, unsigned capacity);
+
+    static void finalize();
+};
+
+/*
+  ADD_FINALIZER('check_sat_cache::finalize();')
+*/
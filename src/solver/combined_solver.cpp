@@ -129,6 +129,15 @@ public:
         TRACE("solver", tout << "translate\n";);
         solver* s1 = m_solver1->translate(m, p);
         solver* s2 = m_solver2->translate(m, p);
+        return mk_clone(s1, s2, p);
+    }
+
+    solver* fork(params_ref const& p) override {
+        TRACE("solver", tout << "fork\n";);
+        return mk_clone(m_solver1->fork(p), m_solver2->fork(p), p);
+    }
+
+    solver* mk_clone(solver* s1, solver* s2, params_ref const& p) {
         combined_solver* r = alloc(combined_solver, s1, s2, p);
         r->m_inc_mode = m_inc_mode;
         r->m_check_sat_executed = m_check_sat_executed;
@@ -166,6 +175,13 @@ public:
         m_solver2->assert_expr(t);
     }
 
+    void assert_exprs_core(unsigned n, expr * const * ts) override {
+        if (m_check_sat_executed)
+            switch_inc_mode();
+        m_solver1->assert_expr(n, ts);
+        m_solver2->assert_expr(n, ts);
+    }
+
     void assert_expr_core2(expr * t, expr * a) override {
         if (m_check_sat_executed)
             switch_inc_mode();
@@ -257,6 +273,11 @@ public:
         m_solver1->set_progress_callback(callback);
         m_solver2->set_progress_callback(callback);
     }
+
+    void register_stats_callback(unsigned interval_ms, stats_eh const& eh) override {
+        m_solver1->register_stats_callback(interval_ms, eh);
+        m_solver2->register_stats_callback(interval_ms, eh);
+    }
     
     unsigned get_num_assertions() const override {
         return m_solver1->get_num_assertions();
@@ -319,6 +340,18 @@ public:
             return m_solver2->get_trail(max_level);
     }
 
+    void get_hints(expr_ref_vector& hints) override {
+        if (m_use_solver1_results)
+            m_solver1->get_hints(hints);
+        else
+            m_solver2->get_hints(hints);
+    }
+
+    void set_hints(expr_ref_vector const& hints) override {
+        m_solver1->set_hints(hints);
+        m_solver2->set_hints(hints);
+    }
+
     proof * get_proof_core() override {
         if (m_use_solver1_results)
             return m_solver1->get_proof_core();
@@ -374,6 +407,14 @@ public:
     void user_propagate_register_diseq(user_propagator::eq_eh_t& diseq_eh) override {
         m_solver2->user_propagate_register_diseq(diseq_eh);
     }
+
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        m_solver2->user_propagate_register_batch(batch_eh);
+    }
+
+    void user_propagate_register_native(user_propagator::native* p) override {
+        m_solver2->user_propagate_register_native(p);
+    }
     
     void user_propagate_register_expr(expr* e) override {
         m_solver2->user_propagate_register_expr(e);
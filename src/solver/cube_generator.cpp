@@ -0,0 +1,152 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cube_generator.cpp
+
+Abstract:
+
+    Streaming cube generator for cube-and-conquer.
+
+--*/
+
+#include "ast/ast_translation.h"
+#include "solver/cube_generator.h"
+
+cube_generator::cube_generator(solver& s, expr_ref_vector const& vars):
+    m(s.get_manager()),
+    m_solver(s),
+    m_vars(vars),
+    m_trail(m) {
+    m_nodes.push_back(node(UINT_MAX, nullptr));
+}
+
+unsigned cube_generator::mk_child(unsigned n, expr* lit) {
+    for (auto const& [l, c] : m_nodes[n].m_children)
+        if (l == lit)
+            return c;
+    unsigned c = m_nodes.size();
+    m_trail.push_back(lit);
+    m_nodes.push_back(node(n, lit));
+    m_nodes[n].m_children.push_back({ lit, c });
+    return c;
+}
+
+/**
+   \brief length of the shortest prefix of cube that ends in a closed node,
+   UINT_MAX if there is none.
+ */
+unsigned cube_generator::closed_prefix(expr_ref_vector const& cube) const {
+    unsigned n = 0;
+    if (m_nodes[n].m_closed)
+        return 0;
+    for (unsigned i = 0; i < cube.size(); ++i) {
+        unsigned c = UINT_MAX;
+        for (auto const& [l, ch] : m_nodes[n].m_children)
+            if (l == cube.get(i))
+                c = ch;
+        if (c == UINT_MAX)
+            return UINT_MAX;
+        n = c;
+        if (m_nodes[n].m_closed)
+            return i + 1;
+    }
+    return UINT_MAX;
+}
+
+/**
+   \brief close n, and close the parents whose cube is refuted by a literal
+   and its negation below them.
+ */
+void cube_generator::close(unsigned n) {
+    while (n != UINT_MAX && !m_nodes[n].m_closed) {
+        m_nodes[n].m_closed = true;
+        unsigned p = m_nodes[n].m_parent;
+        if (p == UINT_MAX)
+            return;
+        bool closed = false;
+        for (auto const& [l, c] : m_nodes[p].m_children)
+            if (c != n && m_nodes[c].m_closed && m.is_complement(l, m_nodes[n].m_lit))
+                closed = true;
+        if (!closed)
+            return;
+        n = p;
+    }
+}
+
+lbool cube_generator::next(ast_manager& dst, expr_ref_vector& cube) {
+    lock_guard lock(m_mux);
+    cube.reset();
+    while (m_status == l_undef && !m_nodes[0].m_closed) {
+        unsigned backtrack = m_backtrack;
+        m_backtrack = UINT_MAX;
+        expr_ref_vector c = m_solver.cube(m_vars, backtrack);
+        if (c.size() == 1 && m.is_false(c.get(0))) {
+            m_status = l_false;
+            break;
+        }
+        if (c.size() == 1 && m.is_true(c.get(0))) {
+            m_status = l_true;
+            break;
+        }
+        unsigned k = closed_prefix(c);
+        if (k != UINT_MAX) {
+            // backtrack above the closed node and ask for the next cube
+            ++m_stats.m_num_pruned;
+            m_backtrack = k;
+            continue;
+        }
+        if (c.empty())
+            m_status = l_false;
+        unsigned n = 0;
+        for (expr* lit : c)
+            n = mk_child(n, lit);
+        ++m_stats.m_num_cubes;
+        ast_translation tr(m, dst);
+        for (expr* lit : c)
+            cube.push_back(tr(lit));
+        return l_undef;
+    }
+    return m_status == l_true ? l_true : l_false;
+}
+
+void cube_generator::refuted(ast_manager& src, expr_ref_vector const& cube) {
+    lock_guard lock(m_mux);
+    ++m_stats.m_num_refuted;
+    ast_translation tr(src, m);
+    unsigned n = 0;
+    for (expr* lit : cube) {
+        if (m_nodes[n].m_closed)
+            return;
+        n = mk_child(n, tr(lit));
+    }
+    close(n);
+}
+
+bool cube_generator::is_done() {
+    lock_guard lock(m_mux);
+    if (m_nodes[0].m_closed || m_status == l_true)
+        return true;
+    if (m_status == l_undef)
+        return false;
+    // the cuber refuted all cubes it did not hand out. A node is closed
+    // if it was refuted or all cubes handed out below it were.
+    for (unsigned n = m_nodes.size(); n-- > 0; ) {
+        auto& nd = m_nodes[n];
+        if (nd.m_closed || nd.m_children.empty())
+            continue;
+        bool all_closed = true;
+        for (auto const& [l, c] : nd.m_children)
+            all_closed &= m_nodes[c].m_closed;
+        nd.m_closed = all_closed;
+    }
+    return m_nodes[0].m_closed;
+}
+
+void cube_generator::collect_statistics(statistics& st) {
+    lock_guard lock(m_mux);
+    st.update("cubes", m_stats.m_num_cubes);
+    st.update("cubes refuted", m_stats.m_num_refuted);
+    st.update("cubes pruned", m_stats.m_num_pruned);
+}
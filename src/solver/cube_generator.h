@@ -0,0 +1,88 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cube_generator.h
+
+Abstract:
+
+    Streaming cube generator for cube-and-conquer.
+
+    Cubes produced by the lookahead cuber of a solver are handed out one at
+    a time to any number of clients. Clients may report cubes, or prefixes
+    of cubes, they refuted. The generator keeps the tree of cubes that were
+    handed out. A node is closed when it was refuted, or when both the
+    literal and its negation below it are closed. Cubes below a closed node
+    are not handed out; the cuber backtracks above the closed node instead,
+    so the clients do not track backtrack levels.
+
+    The generator is thread safe. Cubes are translated into the manager
+    of the caller, so clients with ast_managers of their own can share one
+    generator.
+
+--*/
+#pragma once
+
+#include "solver/solver.h"
+#include "util/mutex.h"
+#include "util/statistics.h"
+
+class cube_generator {
+    struct node {
+        unsigned                              m_parent;
+        expr*                                 m_lit;       // literal extending the cube of the parent, null for the root
+        svector<std::pair<expr*, unsigned>>   m_children;  // literal -> child
+        bool                                  m_closed = false;
+        node(unsigned p, expr* lit): m_parent(p), m_lit(lit) {}
+    };
+
+    struct stats {
+        unsigned m_num_cubes = 0;
+        unsigned m_num_refuted = 0;
+        unsigned m_num_pruned = 0;
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+
+    ast_manager&          m;
+    solver&               m_solver;
+    expr_ref_vector       m_vars;
+    expr_ref_vector       m_trail;
+    vector<node>          m_nodes;                  // m_nodes[0] is the empty cube
+    unsigned              m_backtrack = UINT_MAX;
+    lbool                 m_status = l_undef;       // l_false if no cubes remain, l_true if the cuber found a model
+    stats                 m_stats;
+    mutex                 m_mux;
+
+    unsigned mk_child(unsigned n, expr* lit);
+    unsigned closed_prefix(expr_ref_vector const& cube) const;
+    void     close(unsigned n);
+
+public:
+
+    /**
+       \brief generate cubes for the assertions of s over the variables vars.
+       An empty set of variables lets the cuber choose among all variables.
+       The generator uses the cube state of s, so s should not be used for
+       other queries while cubes are handed out.
+     */
+    cube_generator(solver& s, expr_ref_vector const& vars);
+
+    /**
+       \brief produce the next open cube in the manager dst.
+       Return l_undef if cube is a cube to solve, which may be empty if the
+       cuber cannot split, l_false if no cubes remain and l_true if the
+       cuber found the assertions satisfiable.
+     */
+    lbool next(ast_manager& dst, expr_ref_vector& cube);
+
+    /**
+       \brief report that the conjunction of cube, given in the manager src,
+       is unsatisfiable together with the assertions.
+     */
+    void refuted(ast_manager& src, expr_ref_vector const& cube);
+
+    bool is_done();
+
+    void collect_statistics(statistics& st);
+};
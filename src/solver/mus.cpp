@@ -18,10 +18,13 @@ Notes:
 
 --*/
 
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
 #include "solver/solver.h"
 #include "solver/mus.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
+#include "ast/ast_translation.h"
 #include "model/model_evaluator.h"
 
 
@@ -38,6 +41,7 @@ struct mus::imp {
     expr_ref_vector          m_soft;
     vector<rational>         m_weights;
     rational                 m_weight;
+    unsigned                 m_num_threads = 1;
 
     imp(solver& s): 
         m_solver(s), m(s.get_manager()), m_lit2expr(m),  m_assumptions(m), m_soft(m)
@@ -74,9 +78,178 @@ struct mus::imp {
             mus.push_back(m_lit2expr.back());
             return l_true;
         }
+        if (m_num_threads > 1 && m_lit2expr.size() >= 4 * m_num_threads) 
+            return get_mus_par(mus);
         return get_mus1(mus);
     }
 
+    /**
+       \brief copy of the solver on a thread of its own. The soft
+       constraints are referred to by their index.
+    */
+    struct worker {
+        ast_manager             m;
+        ref<solver>             m_solver;
+        expr_ref_vector         m_lits;
+        expr_ref_vector         m_assumptions;
+        obj_map<expr, unsigned> m_lit2idx;
+        lbool                   m_result = l_undef;
+        unsigned_vector         m_core;    // soft constraints in the core
+        unsigned_vector         m_false;   // soft constraints of the chunk that are not true in the model
+
+        worker(ast_manager& src, solver& s, params_ref const& p, expr_ref_vector const& lits, expr_ref_vector const& asms):
+            m(src, true), m_lits(m), m_assumptions(m) {
+            ast_translation tr(src, m);
+            m_solver = s.translate(m, p);
+            for (unsigned i = 0; i < lits.size(); ++i) {
+                m_lits.push_back(tr(lits.get(i)));
+                m_lit2idx.insert(m_lits.back(), i);
+            }
+            for (expr* a : asms)
+                m_assumptions.push_back(tr(a));
+        }
+
+        // check the soft constraints in mus and unknown, except unknown[lo..hi)
+        void check(unsigned_vector const& mus, unsigned_vector const& unknown, unsigned lo, unsigned hi) {
+            m_core.reset();
+            m_false.reset();
+            try {
+                expr_ref_vector asms(m_assumptions);
+                for (unsigned i : mus)
+                    asms.push_back(m_lits.get(i));
+                for (unsigned i = 0; i < unknown.size(); ++i)
+                    if (i < lo || hi <= i)
+                        asms.push_back(m_lits.get(unknown[i]));
+                m_result = m_solver->check_sat(asms);
+                if (m_result == l_false) {
+                    expr_ref_vector core(m);
+                    m_solver->get_unsat_core(core);
+                    unsigned idx;
+                    for (expr* c : core)
+                        if (m_lit2idx.find(c, idx))
+                            m_core.push_back(idx);
+                }
+                else if (m_result == l_true) {
+                    model_ref mdl;
+                    m_solver->get_model(mdl);
+                    for (unsigned i = lo; i < hi; ++i)
+                        if (!mdl || !mdl->is_true(m_lits.get(unknown[i])))
+                            m_false.push_back(unknown[i]);
+                }
+            }
+            catch (z3_exception&) {
+                m_result = l_undef;
+            }
+        }
+    };
+
+    /**
+       \brief parallel deletion based extraction.
+
+       Every round tests up to one chunk of the unknown soft constraints per
+       worker for removal. Let S be the soft constraints in mus and unknown,
+       which are unsatisfiable together with the assumptions. If S minus a
+       chunk is unsatisfiable, the chunk is dropped and unknown is reduced to
+       the unsat core; only the first such chunk of a round is used, since
+       the removals of two chunks cannot be combined. Otherwise the model
+       falsifies a constraint of the chunk, and if it falsifies only one,
+       that constraint is necessary (model rotation). Necessary constraints
+       stay necessary when S shrinks, so they are all collected. The chunk
+       size doubles after a successful removal and halves when a round makes
+       no progress, down to single constraints.
+    */
+    lbool get_mus_par(expr_ref_vector& mus) {
+        unsigned num_threads = std::min(m_num_threads, thread_pool::max_threads());
+        params_ref p(m_solver.get_params());
+        p.set_bool("core.minimize", false);
+        scoped_ptr_vector<worker> ws;
+        scoped_limits sl(m.limit());
+        try {
+            for (unsigned i = 0; i < num_threads; ++i) {
+                ws.push_back(alloc(worker, m, m_solver, p, m_lit2expr, m_assumptions));
+                sl.push_child(&(ws.back()->m.limit()));
+            }
+        }
+        catch (z3_exception& ex) {
+            IF_VERBOSE(1, verbose_stream() << "(mus sequential: " << ex.msg() << ")\n";);
+            return get_mus1(mus);
+        }
+        unsigned_vector core, unknown, next;
+        bool_vector in_core;
+        for (unsigned i = m_lit2expr.size(); i-- > 0; )
+            unknown.push_back(i);
+        unsigned chunk = std::max(1u, unknown.size() / (2 * num_threads));
+        while (!unknown.empty()) {
+            if (!m.inc())
+                return l_undef;
+            IF_VERBOSE(12, verbose_stream() << "(mus reducing core: " << unknown.size() << " new core: " << core.size() << " chunk: " << chunk << ")\n";);
+            chunk = std::min(chunk, unknown.size());
+            unsigned n = std::min(num_threads, (unknown.size() + chunk - 1) / chunk);
+            unsigned sz = unknown.size();
+            auto lo = [&](unsigned j) { return sz > (j + 1) * chunk ? sz - (j + 1) * chunk : 0; };
+            auto hi = [&](unsigned j) { return sz - j * chunk; };
+            thread_pool::run(n, [&](unsigned j) { ws[j]->check(core, unknown, lo(j), hi(j)); });
+
+            in_core.reset();
+            in_core.resize(m_lit2expr.size(), false);
+            unsigned removed = UINT_MAX;
+            for (unsigned j = 0; j < n; ++j) {
+                if (ws[j]->m_result == l_undef)
+                    return l_undef;
+                if (ws[j]->m_result == l_false && removed == UINT_MAX) 
+                    removed = j;
+            }
+            bool progress = false;
+            for (unsigned j = 0; j < n; ++j) {
+                if (ws[j]->m_result != l_true)
+                    continue;
+                if (ws[j]->m_false.empty()) {
+                    // S is satisfiable: every soft constraint is needed.
+                    for (unsigned i : unknown)
+                        core.push_back(i);
+                    unknown.reset();
+                    break;
+                }
+                if (ws[j]->m_false.size() == 1) {
+                    in_core[ws[j]->m_false[0]] = true;
+                    progress = true;
+                }
+            }
+            if (unknown.empty())
+                break;
+            if (removed != UINT_MAX) {
+                // unknown := (unknown \ chunk) intersected with the core
+                bool_vector in_unsat_core(m_lit2expr.size(), false);
+                for (unsigned i : ws[removed]->m_core)
+                    in_unsat_core[i] = true;
+                next.reset();
+                for (unsigned i = 0; i < sz; ++i) {
+                    unsigned u = unknown[i];
+                    if (in_core[u] && in_unsat_core[u])
+                        core.push_back(u);
+                    else if (in_unsat_core[u] && (i < lo(removed) || hi(removed) <= i))
+                        next.push_back(u);
+                }
+                unknown.swap(next);
+                chunk *= 2;
+                continue;
+            }
+            next.reset();
+            for (unsigned u : unknown) {
+                if (in_core[u])
+                    core.push_back(u);
+                else
+                    next.push_back(u);
+            }
+            unknown.swap(next);
+            if (!progress)
+                chunk = std::max(1u, chunk / 2);
+        }
+        for (unsigned i : core)
+            mus.push_back(m_lit2expr.get(i));
+        return l_true;
+    }
+
     lbool get_mus1(expr_ref_vector& mus) {
         ptr_vector<expr> unknown(m_lit2expr.size(), m_lit2expr.data());
         expr_ref_vector core_exprs(m);
@@ -369,6 +542,10 @@ lbool mus::get_mus(expr_ref_vector& mus) {
     return m_imp->get_mus(mus);
 }
 
+void mus::set_num_threads(unsigned n) {
+    m_imp->m_num_threads = n;
+}
+
 void mus::reset() {
     m_imp->reset();
 }
@@ -47,6 +47,13 @@ class mus {
     void add_assumption(expr* lit);
 
     lbool get_mus(expr_ref_vector& mus);
+
+    /**
+       Use up to n threads for the extraction. With more than one thread,
+       chunks of soft constraints are tested for removal at the same time
+       on copies of the solver. The solver must then support translate.
+    */
+    void set_num_threads(unsigned n);
     
     void reset();
     
@@ -25,19 +25,32 @@ Notes:
   3. Cube using the parameter settings prescribed in m_params.
   4. Optionally pass the cubes as assumptions and solve each sub-cube with a prescribed resource bound.
   5. Assemble cubes that could not be solved and create a cube state.
+
+ With parallel.remote_dir set, a state that remains undetermined after its first
+ simplification is also written as a task to the directory, and the thread waits
+ for a worker to solve it. A task is the SMT-LIB2 script task-<id>.smt2 with the
+ assertions, the asserted cubes and the units learned so far. A worker, such as
+ z3 -worker:<dir> on a machine that shares the directory, claims a task by
+ renaming it and answers with task-<id>.result whose first line is sat, unsat
+ or unknown. Unsat closes the branch, otherwise the state is solved locally.
  
 --*/
 
 #include "util/scoped_ptr_vector.h"
+#include "util/numa.h"
+#include "util/thread_pool.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 #include "ast/ast_translation.h"
+#include "ast/ast_pp_util.h"
 #include "solver/solver.h"
 #include "solver/solver2tactic.h"
 #include "tactic/tactic.h"
 #include "tactic/tactical.h"
 #include "solver/parallel_tactic.h"
 #include "solver/parallel_params.hpp"
+#include <cstdio>
+#include <fstream>
 
 
 class non_parallel_tactic : public tactic {
@@ -68,6 +81,7 @@ tactic * mk_parallel_tactic(solver* s, params_ref const& p) {
 #include <mutex>
 #include <cmath>
 #include <condition_variable>
+#include <chrono>
 
 class parallel_tactic : public tactic {
 
@@ -266,6 +280,23 @@ class parallel_tactic : public tactic {
 
         vector<cube_var> const& cubes() const { return m_cubes; }
 
+        /**
+           \brief write the state as a self-contained SMT-LIB2 task.
+         */
+        void display_task(std::ostream& out) {
+            expr_ref_vector fmls(m()), units(get_solver().get_units());
+            get_solver().get_assertions(fmls);
+            ast_pp_util visitor(m());
+            visitor.collect(fmls);
+            visitor.collect(units);
+            out << "; parallel.tactic task :depth " << m_depth << " :width " << m_width << "\n";
+            visitor.display_decls(out);
+            visitor.display_asserts(out, fmls, true);
+            out << "; learned units\n";
+            visitor.display_asserts(out, units, true);
+            out << "(check-sat)\n";
+        }
+
         // remove up to n cubes from list of cubes.
         vector<cube_var> split_cubes(unsigned n) {
             vector<cube_var> result;
@@ -395,6 +426,9 @@ private:
     int           m_exn_code;
     std::string   m_exn_msg;
     std::string   m_reason_undef;
+    std::string   m_remote_dir;
+    std::atomic<unsigned> m_num_tasks;
+    unsigned      m_num_remote_unsat;
 
     void init() {
         parallel_params pp(m_params);
@@ -407,6 +441,9 @@ private:
         m_last_depth = 0;
         m_backtrack_frequency = pp.conquer_backtrack_frequency();
         m_conquer_delay = pp.conquer_delay();
+        m_remote_dir = pp.remote_dir().str();
+        m_num_tasks = 0;
+        m_num_remote_unsat = 0;
         m_exn_code = 0;
         m_params.set_bool("override_incremental", true);
         m_core.reset();
@@ -544,6 +581,20 @@ private:
         }
         if (canceled(s)) return;
         if (s.giveup()) { report_undef(s, s.get_solver().reason_unknown()); return; }
+
+        if (num_simplifications == 1 && !m_remote_dir.empty() && !s.has_assumptions()) {
+            switch (solve_remote(s)) {
+            case l_false: 
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    ++m_num_remote_unsat;
+                }
+                report_unsat(s); 
+                return;
+            default: 
+                break;
+            }
+        }
         
         if (memory_pressure()) {
             goto simplify_again;
@@ -629,6 +680,41 @@ private:
         }                
     }
 
+    /**
+       \brief pass the state to a worker through the remote directory and wait for its answer.
+       The task is withdrawn if the search is canceled before a worker claimed it.
+     */
+    lbool solve_remote(solver_state& s) {
+        std::string base = m_remote_dir + "/task-" + std::to_string(m_num_tasks++);
+        std::string task = base + ".smt2", result = base + ".result";
+        {
+            std::ofstream out(base + ".tmp");
+            s.display_task(out);
+            if (!out)
+                return l_undef;
+        }
+        if (std::rename((base + ".tmp").c_str(), task.c_str()) != 0)
+            return l_undef;
+        IF_VERBOSE(2, verbose_stream() << "(tactic.parallel :remote-task " << task << ")\n");
+        std::string status;
+        while (!canceled(s)) {
+            std::ifstream in(result);
+            if (in && (in >> status)) {
+                in.close();
+                std::remove(result.c_str());
+                IF_VERBOSE(2, verbose_stream() << "(tactic.parallel :remote-result " << task << " " << status << ")\n");
+                if (status == "unsat")
+                    return l_false;
+                if (status == "sat")
+                    return l_true;
+                return l_undef;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        std::remove(task.c_str());
+        return l_undef;
+    }
+
     void spawn_cubes(solver_state& s, unsigned width, vector<cube_var>& cubes) {
         if (cubes.empty()) return;
         add_branches(cubes.size());
@@ -728,12 +814,14 @@ private:
 
     lbool solve(model_ref& mdl) {        
         add_branches(1);
-        vector<std::thread> threads;
-        for (unsigned i = 0; i < m_num_threads; ++i) 
-            threads.push_back(std::thread([this]() { run_solver(); }));
-        for (std::thread& t : threads) 
-            t.join();
+        bool affinity = parallel_params(m_params).affinity();
+        numa::scoped_stats numa_stats(affinity);
+        thread_pool::run(m_num_threads, [&](unsigned i) {
+            numa::scoped_bind _bind(affinity, i);
+            run_solver();
+        });
         m_queue.stats(m_stats);
+        numa_stats.collect_statistics(m_stats);
         m_manager.limit().reset_cancel();
         if (m_exn_code == -1) 
             throw default_exception(std::move(m_exn_msg));
@@ -842,11 +930,13 @@ public:
         m_params.copy(p);
         parallel_params pp(p);
         m_conquer_delay = pp.conquer_delay();
+        m_remote_dir = pp.remote_dir().str();
     }
 
     void collect_statistics(statistics & st) const override {
         st.copy(m_stats);
         st.update("par unsat", m_num_unsat);
+        if (m_num_remote_unsat > 0) st.update("par remote unsat", m_num_remote_unsat);
         st.update("par models", m_models.size());
         st.update("par progress", m_progress);
     }
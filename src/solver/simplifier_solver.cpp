@@ -0,0 +1,223 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    simplifier_solver.cpp
+
+Abstract:
+
+    Incremental preprocessing for a solver.
+
+--*/
+
+#include "ast/ast_translation.h"
+#include "solver/solver_na2as.h"
+#include "solver/simplifier_solver.h"
+
+
+class simplifier_solver : public solver_na2as {
+
+    struct dep_expr_state : public dependent_expr_state {
+        simplifier_solver&         s;
+        model_reconstruction_trail m_reconstruction_trail;
+        dep_expr_state(simplifier_solver& s) : s(s), m_reconstruction_trail(s.m, m_trail) {}
+        unsigned size() const override { return s.m_fmls.size(); }
+        dependent_expr const& operator[](unsigned i) override { return s.m_fmls[i]; }
+        void update(unsigned i, dependent_expr const& j) override {
+            s.m_fmls[i] = j;
+            s.m_inconsistent |= s.m.is_false(j.fml());
+        }
+        void add(dependent_expr const& j) override {
+            s.m_fmls.push_back(j);
+            s.m_inconsistent |= s.m.is_false(j.fml());
+        }
+        bool inconsistent() override { return s.m_inconsistent; }
+        model_reconstruction_trail& model_trail() override { return m_reconstruction_trail; }
+    };
+
+    struct scope {
+        unsigned m_assertions_lim;
+        unsigned m_fmls_lim;
+        bool     m_inconsistent;
+    };
+
+    ref<solver>                             s;
+    ref<dependent_expr_simplifier_factory>  m_factory;
+    expr_ref_vector                         m_assertions;   // assertions as they were asserted
+    vector<dependent_expr>                  m_fmls;         // simplified assertions
+    dep_expr_state                          m_preprocess_state;
+    scoped_ptr<dependent_expr_simplifier>   m_preprocess;
+    unsigned                                m_qhead = 0;    // formulas before m_qhead were passed on to s
+    bool                                    m_inconsistent = false;
+    svector<scope>                          m_scopes;
+
+    /**
+       \brief simplify the formulas asserted since the last flush and pass them on to s.
+       Unless the formulas were replayed already, the symbols they use that were
+       eliminated before are replaced, or the formulas they were removed from are
+       brought back.
+     */
+    void flush(bool replay = true) {
+        if (m_qhead == m_fmls.size())
+            return;
+        if (replay) {
+            vector<dependent_expr> added, fmls;
+            for (unsigned i = m_qhead; i < m_fmls.size(); ++i) {
+                added.reset();
+                m_preprocess_state.model_trail().replay(m_fmls[i], added);
+                fmls.append(added);
+            }
+            m_fmls.shrink(m_qhead);
+            m_fmls.append(fmls);
+        }
+        if (!m_inconsistent)
+            m_preprocess->reduce();
+        if (!m.inc())
+            return;
+        for (; m_qhead < m_fmls.size(); ++m_qhead) {
+            expr* f = m_fmls[m_qhead].fml();
+            s->assert_expr(f);
+            m_preprocess_state.freeze(f);
+        }
+    }
+
+public:
+
+    simplifier_solver(solver* s, dependent_expr_simplifier_factory* f):
+        solver_na2as(s->get_manager()),
+        s(s),
+        m_factory(f),
+        m_assertions(m),
+        m_preprocess_state(*this) {
+        m_preprocess = f->mk(m, s->get_params(), m_preprocess_state);
+        updt_params(s->get_params());
+    }
+
+    solver* translate(ast_manager& dst_m, params_ref const& p) override {
+        flush();
+        // The translated solver keeps the simplified formulas of s. The
+        // original assertions are added to it, so that the eliminated
+        // symbols are constrained without translating the reconstruction trail.
+        ast_translation tr(m, dst_m);
+        solver* s1 = s->translate(dst_m, p);
+        simplifier_solver* r = alloc(simplifier_solver, s1, m_factory.get());
+        for (expr* a : m_assertions) {
+            expr* f = tr(a);
+            s1->assert_expr(f);
+            r->m_assertions.push_back(f);
+            r->m_preprocess_state.freeze(f);
+        }
+        return r;
+    }
+
+    void assert_expr_core(expr* t) override {
+        m_assertions.push_back(t);
+        m_fmls.push_back(dependent_expr(m, t, nullptr));
+        m_inconsistent |= m.is_false(t);
+    }
+
+    void push_core() override {
+        flush();
+        m_scopes.push_back({ m_assertions.size(), m_fmls.size(), m_inconsistent });
+        m_preprocess_state.push();
+        m_preprocess->push();
+        s->push();
+    }
+
+    void pop_core(unsigned n) override {
+        n = std::min(n, m_scopes.size());
+        if (n == 0)
+            return;
+        s->pop(n);
+        m_preprocess->pop(n);
+        m_preprocess_state.pop(n);
+        scope const& sc = m_scopes[m_scopes.size() - n];
+        m_assertions.shrink(sc.m_assertions_lim);
+        m_fmls.shrink(sc.m_fmls_lim);
+        m_qhead = sc.m_fmls_lim;
+        m_inconsistent = sc.m_inconsistent;
+        m_scopes.shrink(m_scopes.size() - n);
+    }
+
+    void assert_expr_core2(expr* t, expr* a) override {
+        m_preprocess_state.freeze(a);
+        solver_na2as::assert_expr_core2(t, a);
+    }
+
+    lbool check_sat_core2(unsigned num_assumptions, expr* const* assumptions) override {
+        // assumptions are passed on unchanged, so that cores need no
+        // translation. An assumption over eliminated symbols is tied to
+        // its replayed version by an equivalence.
+        flush();
+        vector<dependent_expr> added;
+        for (unsigned i = 0; i < num_assumptions; ++i) {
+            expr* a = assumptions[i];
+            added.reset();
+            m_preprocess_state.model_trail().replay(dependent_expr(m, a, nullptr), added);
+            if (added[0].fml() != a)
+                m_fmls.push_back(dependent_expr(m, m.mk_eq(a, added[0].fml()), added[0].dep()));
+            for (unsigned j = 1; j < added.size(); ++j)
+                m_fmls.push_back(added[j]);
+            m_preprocess_state.freeze(a);
+        }
+        flush(false);
+        return s->check_sat(num_assumptions, assumptions);
+    }
+
+    void get_model_core(model_ref& mdl) override {
+        s->get_model(mdl);
+        if (!mdl)
+            return;
+        model_converter_ref mc = m_preprocess_state.model_trail().get_model_converter();
+        if (mc)
+            (*mc)(mdl);
+    }
+
+    void updt_params(params_ref const& p) override {
+        solver::updt_params(p);
+        s->updt_params(p);
+        m_preprocess->updt_params(p);
+    }
+
+    void collect_param_descrs(param_descrs& r) override {
+        s->collect_param_descrs(r);
+        m_preprocess->collect_param_descrs(r);
+    }
+
+    void collect_statistics(statistics& st) const override {
+        s->collect_statistics(st);
+        m_preprocess->collect_statistics(st);
+    }
+
+    unsigned get_num_assertions() const override { return m_assertions.size(); }
+    expr* get_assertion(unsigned idx) const override { return m_assertions.get(idx); }
+
+    expr_ref_vector cube(expr_ref_vector& vars, unsigned backtrack_level) override {
+        for (expr* v : vars)
+            m_preprocess_state.freeze(v);
+        flush();
+        return s->cube(vars, backtrack_level);
+    }
+
+    void get_unsat_core(expr_ref_vector& r) override { s->get_unsat_core(r); }
+    proof* get_proof_core() override { return s->get_proof_core(); }
+    std::string reason_unknown() const override { return s->reason_unknown(); }
+    void set_reason_unknown(char const* msg) override { s->set_reason_unknown(msg); }
+    void get_labels(svector<symbol>& r) override { s->get_labels(r); }
+    void set_progress_callback(progress_callback* callback) override { s->set_progress_callback(callback); }
+    void register_stats_callback(unsigned interval_ms, stats_eh const& eh) override { s->register_stats_callback(interval_ms, eh); }
+    void set_phase(expr* e) override { s->set_phase(e); }
+    phase* get_phase() override { return s->get_phase(); }
+    void set_phase(phase* p) override { s->set_phase(p); }
+    void move_to_front(expr* e) override { s->move_to_front(e); }
+    void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) override { s->get_levels(vars, depth); }
+    expr_ref_vector get_trail(unsigned max_level) override { return s->get_trail(max_level); }
+    void get_hints(expr_ref_vector& hints) override { s->get_hints(hints); }
+    void set_hints(expr_ref_vector const& hints) override { s->set_hints(hints); }
+    ast_manager& get_manager() const override { return m; }
+};
+
+solver* mk_simplifier_solver(solver* s, dependent_expr_simplifier_factory* f) {
+    return alloc(simplifier_solver, s, f);
+}
@@ -0,0 +1,25 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    simplifier_solver.h
+
+Abstract:
+
+    Incremental preprocessing for a solver.
+
+    Assertions are simplified by a dependent_expr_simplifier before they
+    are passed on to the wrapped solver. Only formulas asserted since the
+    last check are simplified. The symbols of formulas that were passed
+    on and of assumptions are frozen, so later simplifications do not
+    eliminate them. Model reconstruction entries and frozen symbols are
+    scoped and undone on pop.
+
+--*/
+#pragma once
+
+#include "solver/solver.h"
+#include "ast/simplifiers/dependent_expr_state.h"
+
+solver* mk_simplifier_solver(solver* s, dependent_expr_simplifier_factory* f);
@@ -22,6 +22,7 @@ Notes:
 #include "solver/check_sat_result.h"
 #include "solver/progress_callback.h"
 #include "util/params.h"
+#include "util/stats_callback.h"
 
 class solver;
 class model_converter;
@@ -59,6 +60,13 @@ public:
     */
     virtual solver* translate(ast_manager& m, params_ref const& p) = 0;
 
+    /**
+       \brief Creates a clone of the solver over the same manager.
+       Solvers that can do so retain learned state (lemmas, phases, activities)
+       in the clone, so it does not have to relearn what this solver already knows.
+    */
+    virtual solver* fork(params_ref const& p) { return translate(get_manager(), p); }
+
     /**
        \brief Update the solver internal settings. 
     */
@@ -106,8 +114,19 @@ public:
 
     virtual void assert_expr_core(expr * t) = 0;
 
+    /**
+       \brief Add the formulas ts[0], ..., ts[n-1] to the assertion stack.
+       The formulas must be referenced by the caller.
+    */
+    void assert_expr(unsigned n, expr * const * ts) { assert_exprs_core(n, ts); }
+
+    virtual void assert_exprs_core(unsigned n, expr * const * ts) {
+        for (unsigned i = 0; i < n; ++i)
+            assert_expr_core(ts[i]);
+    }
+
     void assert_expr(expr_ref_vector const& ts) { 
-        for (expr* e : ts) assert_expr(e);
+        assert_exprs_core(ts.size(), ts.data());
     }
 
     virtual void set_phase(expr* e) = 0;
@@ -181,6 +200,13 @@ public:
        This is essentially for backward compatibility and integration with VCC tools.
     */
     virtual void set_progress_callback(progress_callback * callback) = 0;
+
+    /**
+       \brief Push the statistics of a running check to eh every interval_ms
+       milliseconds. The callback runs on the thread of the check. Solvers
+       that do not search with the SAT or SMT core ignore it.
+    */
+    virtual void register_stats_callback(unsigned interval_ms, stats_eh const& eh) {}
     
     /**
        \brief Return the number of assertions in the assertion stack.
@@ -268,6 +294,24 @@ public:
     
     virtual void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) = 0;
 
+    /**
+       \brief retrieve hints for starting a solver on a similar problem from the
+       state of this solver. The hints are the learned units, then literals of
+       the Boolean atoms in their saved phase in decreasing order of activity,
+       then short learned clauses.
+    */
+    virtual void get_hints(expr_ref_vector& hints) {}
+
+    /**
+       \brief use hints retrieved from a solver on a similar problem. They are
+       applied to the atoms that are known to the solver when satisfiability
+       is checked next. A literal sets the phase of its atom and atoms of earlier
+       hints are preferred for case splits. Clauses only prefer their atoms;
+       neither units nor clauses are asserted, since they need not follow from
+       the current assertions.
+    */
+    virtual void set_hints(expr_ref_vector const& hints) {}
+
     class scoped_push {
         solver& s;
         bool    m_nopop;
@@ -21,6 +21,7 @@ Notes:
 #include "solver/solver_na2as.h"
 #include "ast/proofs/proof_utils.h"
 #include "ast/ast_util.h"
+#include "util/memory_manager.h"
 
 class pool_solver : public solver_na2as {
     solver_pool&       m_pool;
@@ -35,11 +36,12 @@ class pool_solver : public solver_na2as {
     bool               m_dump_benchmarks;
     double             m_dump_threshold;
     unsigned           m_dump_counter;
+    unsigned           m_index;
 
 
     bool is_virtual() const { return !m.is_true(m_pred); }
 public:
-    pool_solver(solver* b, solver_pool& pool, app_ref& pred):
+    pool_solver(solver* b, solver_pool& pool, app_ref& pred, unsigned index):
         solver_na2as(pred.get_manager()),
         m_pool(pool),
         m_pred(pred),
@@ -52,7 +54,8 @@ public:
         m_in_delayed_scope(false),
         m_dump_benchmarks(false),
         m_dump_threshold(5.0),
-        m_dump_counter(0) {
+        m_dump_counter(0),
+        m_index(index) {
         if (is_virtual()) {
             solver_na2as::assert_expr_core2(m.mk_true(), pred);
         }
@@ -68,6 +71,9 @@ public:
     }
 
     solver* base_solver() { return m_base.get(); }
+    unsigned pool_index() const { return m_index; }
+    app* get_pred() const { return m_pred; }
+    bool is_pushed() const { return m_pushed; }
     void set_phase(expr* e) override { m_base->set_phase(e); }
     phase* get_phase() override { return m_base->get_phase(); }
     void set_phase(phase* p) override { m_base->set_phase(p); }
@@ -131,6 +137,14 @@ public:
         return m_base->get_trail(max_level);
     }
 
+    void get_hints(expr_ref_vector& hints) override {
+        m_base->get_hints(hints);
+    }
+
+    void set_hints(expr_ref_vector const& hints) override {
+        m_base->set_hints(hints);
+    }
+
     lbool check_sat_core2(unsigned num_assumptions, expr * const * assumptions) override {
         SASSERT(!m_pushed || get_scope_level() > 0);
         m_proof.reset();
@@ -259,6 +273,7 @@ public:
     void set_reason_unknown(char const* msg) override { return m_base->set_reason_unknown(msg); }
     void get_labels(svector<symbol> & r) override { return m_base->get_labels(r); }
     void set_progress_callback(progress_callback * callback) override { m_base->set_progress_callback(callback); }
+    void register_stats_callback(unsigned interval_ms, stats_eh const& eh) override { m_base->register_stats_callback(interval_ms, eh); }
 
     expr_ref_vector cube(expr_ref_vector& vars, unsigned ) override { return expr_ref_vector(m); }
 
@@ -274,7 +289,18 @@ public:
         SASSERT(!m_pushed);
         m_head = 0;
         m_assertions.reset();
-        m_pool.refresh(m_base.get());
+        m_pool.retire(this);
+    }
+
+    /**
+       \brief disable the clauses of the current frame in the base solver
+       and guard the next frame by pred.
+    */
+    void retire(app* pred) {
+        SASSERT(!m_pushed && is_virtual());
+        m_base->assert_expr(m.mk_not(m_pred));
+        m_pred = pred;
+        m_assumptions.set(0, pred);
     }
 
 private:
@@ -333,30 +359,21 @@ private:
 solver_pool::solver_pool(solver* base_solver, unsigned num_pools):
     m_base_solver(base_solver),
     m_num_pools(num_pools),
-    m_current_pool(0)
+    m_current_pool(0),
+    m_max_retired(1000),
+    m_num_preds(0),
+    m_retired_preds(base_solver->get_manager()),
+    m_free_preds(base_solver->get_manager())
 {
     SASSERT(num_pools > 0);
 }
 
-
-ptr_vector<solver> solver_pool::get_base_solvers() const {
-    ptr_vector<solver> solvers;
-    for (solver* s0 : m_solvers) {
-        pool_solver* s = dynamic_cast<pool_solver*>(s0);
-        if (!solvers.contains(s->base_solver())) {
-            solvers.push_back(s->base_solver());
-        }
-    }
-    return solvers;
-}
-
 void solver_pool::updt_params(const params_ref &p) {
     m_base_solver->updt_params(p);
     for (solver *s : m_solvers) s->updt_params(p);
 }
 void solver_pool::collect_statistics(statistics &st) const {
-    ptr_vector<solver> solvers = get_base_solvers();
-    for (solver* s : solvers) s->collect_statistics(st);
+    for (solver* s : m_base_solvers) s->collect_statistics(st);
     st.update("time.pool_solver.smt.total", m_check_watch.get_seconds());
     st.update("time.pool_solver.smt.total.sat", m_check_sat_watch.get_seconds());
     st.update("time.pool_solver.smt.total.undef", m_check_undef_watch.get_seconds());
@@ -364,12 +381,13 @@ void solver_pool::collect_statistics(statistics &st) const {
     st.update("pool_solver.checks", m_stats.m_num_checks);
     st.update("pool_solver.checks.sat", m_stats.m_num_sat_checks);
     st.update("pool_solver.checks.undef", m_stats.m_num_undef_checks);
+    st.update("pool_solver.retired", m_stats.m_num_retired);
+    st.update("pool_solver.refreshes", m_stats.m_num_refreshes);
 }
 
 void solver_pool::reset_statistics() {
 #if 0
-    ptr_vector<solver> solvers = get_base_solvers();
-    for (solver* s : solvers) {
+    for (solver* s : m_base_solvers) {
         s->reset_statistics();
     }
 #endif
@@ -388,19 +406,19 @@ void solver_pool::reset_statistics() {
    among the first num_pools.
 */
 solver* solver_pool::mk_solver() {
-    ref<solver> base_solver;
+    collect_garbage();
     ast_manager& m = m_base_solver->get_manager();
-    if (m_solvers.size() < m_num_pools) {
-        base_solver = m_base_solver->translate(m, m_base_solver->get_params());
+    unsigned pool;
+    if (m_base_solvers.size() < m_num_pools) {
+        pool = m_base_solvers.size();
+        m_base_solvers.push_back(m_base_solver->translate(m, m_base_solver->get_params()));
+        m_num_retired.push_back(0);
     }
     else {
-        solver* s = m_solvers[(m_current_pool++) % m_num_pools];
-        base_solver = dynamic_cast<pool_solver*>(s)->base_solver();
+        pool = (m_current_pool++) % m_num_pools;
     }
-    std::stringstream name;
-    name << "vsolver#" << m_solvers.size();
-    app_ref pred(m.mk_const(symbol(name.str()), m.mk_bool_sort()), m);
-    pool_solver* solver = alloc(pool_solver, base_solver.get(), *this, pred);
+    app_ref pred = mk_pred();
+    pool_solver* solver = alloc(pool_solver, m_base_solvers.get(pool), *this, pred, pool);
     m_solvers.push_back(solver);
     return solver;
 }
@@ -411,13 +429,105 @@ void solver_pool::reset_solver(solver* s) {
     if (ps) ps->reset();
 }
 
-void solver_pool::refresh(solver* base_solver) {
+/**
+   \brief Activation literal for a new frame. Literals of retired frames
+   are reused once the base solver they were retired in has been refreshed,
+   since no base solver knows them anymore.
+*/
+app_ref solver_pool::mk_pred() {
+    ast_manager& m = m_base_solver->get_manager();
+    app_ref pred(m);
+    if (!m_free_preds.empty()) {
+        pred = m_free_preds.back();
+        m_free_preds.pop_back();
+        return pred;
+    }
+    std::stringstream name;
+    name << "vsolver#" << (m_num_preds++);
+    pred = m.mk_const(symbol(name.str()), m.mk_bool_sort());
+    return pred;
+}
+
+void solver_pool::retire_pred(unsigned pool, app* pred) {
+    m_retired_preds.push_back(pred);
+    m_retired_pools.push_back(pool);
+    m_num_retired[pool]++;
+    m_stats.m_num_retired++;
+}
+
+void solver_pool::retire(pool_solver* s) {
+    unsigned pool = s->pool_index();
+    retire_pred(pool, s->get_pred());
+    s->retire(mk_pred());
+    maybe_refresh(pool);
+}
+
+/**
+   \brief Retire the frames of the solvers that are only referenced by the
+   pool. Their destructor disables their clauses in the base solver.
+*/
+void solver_pool::collect_garbage() {
+    unsigned j = 0;
+    unsigned sz = m_solvers.size();
+    for (unsigned i = 0; i < sz; ++i) {
+        pool_solver* s = dynamic_cast<pool_solver*>(m_solvers.get(i));
+        if (s->get_ref_count() == 1)
+            retire_pred(s->pool_index(), s->get_pred());
+        else
+            m_solvers.set(j++, s);
+    }
+    if (j == sz)
+        return;
+    m_solvers.shrink(j);
+    for (unsigned pool = 0; pool < m_base_solvers.size(); ++pool)
+        maybe_refresh(pool);
+}
+
+/**
+   \brief Refresh the base solver of a pool once it has accumulated
+   max_retired retired frames, or a sixteenth of them when memory is under
+   pressure. The refresh is postponed while a solver of the pool has pushed
+   scopes into the base solver.
+*/
+void solver_pool::maybe_refresh(unsigned pool) {
+    unsigned n = m_num_retired[pool];
+    if (n == 0)
+        return;
+    bool full = m_max_retired > 0 && n >= m_max_retired;
+    bool pressure = 16 * n >= m_max_retired && memory::get_pressure() != memory::NO_PRESSURE;
+    if (!full && !pressure)
+        return;
+    for (solver* s0 : m_solvers) {
+        pool_solver* s = dynamic_cast<pool_solver*>(s0);
+        if (s->pool_index() == pool && s->is_pushed())
+            return;
+    }
+    refresh(pool);
+}
+
+void solver_pool::refresh(unsigned pool) {
     ast_manager& m = m_base_solver->get_manager();
     ref<solver> new_base = m_base_solver->translate(m, m_base_solver->get_params());
     for (solver* s0 : m_solvers) {
         pool_solver* s = dynamic_cast<pool_solver*>(s0);
-        if (base_solver == s->base_solver()) {
+        if (s->pool_index() == pool) {
             s->refresh(new_base.get());
         }
     }
+    m_base_solvers.set(pool, new_base.get());
+    unsigned j = 0;
+    for (unsigned i = 0; i < m_retired_preds.size(); ++i) {
+        if (m_retired_pools[i] == pool) {
+            m_free_preds.push_back(m_retired_preds.get(i));
+        }
+        else {
+            m_retired_pools[j] = m_retired_pools[i];
+            m_retired_preds.set(j++, m_retired_preds.get(i));
+        }
+    }
+    m_retired_preds.shrink(j);
+    m_retired_pools.shrink(j);
+    m_num_retired[pool] = 0;
+    m_stats.m_num_refreshes++;
+    IF_VERBOSE(2, verbose_stream() << "(solver-pool.refresh :pool " << pool << ")\n";);
 }
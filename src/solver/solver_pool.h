@@ -21,6 +21,15 @@ Notes:
     by Arie Gurfinkel
     Use this module as a replacement for spacer_smt_context_manager.
 
+    Every solver of the pool guards its assertions in a shared base
+    solver by an activation literal. When a solver is reset or released
+    by its clients, its frame is retired: the negated activation literal
+    is asserted, which makes the guarded clauses satisfied. Once a base
+    solver has accumulated max_retired retired frames, or memory is
+    under pressure, it is replaced by a fresh copy of the background
+    solver, which drops the clauses of all retired frames, and the
+    activation literals of these frames are recycled.
+
 --*/
 #pragma once
 
@@ -37,6 +46,8 @@ class solver_pool {
         unsigned m_num_checks;
         unsigned m_num_sat_checks;
         unsigned m_num_undef_checks;
+        unsigned m_num_retired;
+        unsigned m_num_refreshes;
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
     };
@@ -44,7 +55,14 @@ class solver_pool {
     ref<solver>         m_base_solver;
     unsigned            m_num_pools;
     unsigned            m_current_pool;
+    unsigned            m_max_retired;
+    unsigned            m_num_preds;
+    sref_vector<solver> m_base_solvers;     // base solver of every pool
+    unsigned_vector     m_num_retired;      // retired frames per pool
     sref_vector<solver> m_solvers;
+    app_ref_vector      m_retired_preds;    // activation literals of retired frames
+    unsigned_vector     m_retired_pools;    // pool of every retired literal
+    app_ref_vector      m_free_preds;       // activation literals unknown to every base solver
     stats               m_stats;
 
     stopwatch m_check_watch;
@@ -52,13 +70,23 @@ class solver_pool {
     stopwatch m_check_undef_watch;
     stopwatch m_proof_watch;
 
-    void refresh(solver* s);
+    void refresh(unsigned pool);
+    void retire(pool_solver* s);
+    void retire_pred(unsigned pool, app* pred);
+    void maybe_refresh(unsigned pool);
+    void collect_garbage();
+    app_ref mk_pred();
 
-    ptr_vector<solver> get_base_solvers() const;
-  
 public:
     solver_pool(solver* base_solver, unsigned num_pools);
 
+    /**
+       \brief number of retired frames of a pool after which its base
+       solver is refreshed, if 0 then base solvers are only refreshed under
+       memory pressure.
+    */
+    void set_max_retired(unsigned n) { m_max_retired = n; }
+
     void collect_statistics(statistics &st) const;
     void reset_statistics();
 
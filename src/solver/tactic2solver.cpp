@@ -25,6 +25,8 @@ Notes:
 #include "solver/tactic2solver.h"
 #include "solver/solver_na2as.h"
 #include "solver/mus.h"
+#include "solver/check_sat_cache.h"
+#include "params/solver_params.hpp"
 
 /**
    \brief Simulates the incremental solver interface using a tactic.
@@ -112,6 +114,14 @@ public:
         m_tactic->user_propagate_register_diseq(diseq_eh);
     }
 
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        m_tactic->user_propagate_register_batch(batch_eh);
+    }
+
+    void user_propagate_register_native(user_propagator::native* p) override {
+        m_tactic->user_propagate_register_native(p);
+    }
+
     void user_propagate_register_expr(expr* e) override {
         m_tactic->user_propagate_register_expr(e);
     }
@@ -229,13 +239,35 @@ lbool tactic2solver::check_sat_core2(unsigned num_assumptions, expr * const * as
     std::string         reason_unknown = "unknown";
     labels_vec labels;
     TRACE("tactic", g->display(tout););
+
+    // results with proofs or cores depend on the run and are not cached
+    unsigned cache_size = solver_params(get_params()).cache_size();
+    scoped_ptr<check_sat_cache> cache;
+    if (cache_size > 0 && num_assumptions == 0 && !m_produce_proofs && !m_produce_unsat_cores) {
+        cache = alloc(check_sat_cache, m, m_assertions);
+        lbool r;
+        if (cache->find(r, md) && (r == l_false || md || !m_produce_models)) {
+            IF_VERBOSE(10, verbose_stream() << "(tactic2solver :cached-result " << r << ")\n");
+            m_stats.update("solver cache hits", 1u);
+            m_result->set_status(r);
+            m_result->m_model = md;
+            m_mc = nullptr;
+            return r;
+        }
+        md = nullptr;
+    }
+
     try {
         switch (::check_sat(*m_tactic, g, md, labels, pr, core, reason_unknown)) {
         case l_true: 
             m_result->set_status(l_true);
+            if (cache)
+                cache->insert(l_true, md.get(), cache_size);
             break;
         case l_false: 
             m_result->set_status(l_false);
+            if (cache)
+                cache->insert(l_false, nullptr, cache_size);
             break;
         default: 
             m_result->set_status(l_undef);
@@ -20,6 +20,7 @@ Notes:
 #include "tactic/goal.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_util.h"
+#include "sat/sat_solver.h"
 
 #define USE_TWO_LEVEL_RULES
 #define FIRST_NODE_ID (UINT_MAX/2)
@@ -1545,6 +1546,288 @@ public:
         proc(r, result);
     }
 
+    /**
+       \brief Functionally reduced AIG construction (FRAIG sweeping).
+
+       Nodes are simulated on 64*NUM_WORDS random input patterns and grouped by
+       signature (modulo complementation). Candidate equivalences between a node
+       and the first node of its class (in topological order) are then checked
+       with a SAT solver under a conflict budget. Counterexamples are added to
+       the simulation patterns of the next round. Finally the graph is rebuilt
+       bottom-up, replacing every node by its proven representative.
+    */
+    struct fraig_proc {
+        static const unsigned NUM_WORDS  = 4;
+        static const unsigned MAX_ROUNDS = 8;
+        imp &                  m;
+        unsigned               m_max_conflicts;
+        ptr_vector<aig>        m_nodes;     // topologically sorted, m_nodes[0] is the constant true
+        u_map<unsigned>        m_id2idx;
+        svector<uint64_t>      m_sim;       // NUM_WORDS words per node
+        unsigned_vector        m_repr;      // m_repr[i] == i if i has no proven representative
+        bool_vector            m_phase;     // i is equivalent to m_repr[i] xor m_phase[i]
+        vector<bool_vector>    m_cex;       // counterexamples, indexed by node index of variables
+        uint64_t               m_seed { 0x9e3779b97f4a7c15ull };
+        reslimit               m_rlimit;
+        sat::solver            m_solver;
+        unsigned               m_num_merged { 0 };
+        unsigned               m_num_checks { 0 };
+
+        fraig_proc(imp & _m, unsigned max_conflicts):
+            m(_m),
+            m_max_conflicts(max_conflicts),
+            m_solver(mk_params(max_conflicts), m_rlimit) {
+        }
+
+        static params_ref mk_params(unsigned max_conflicts) {
+            params_ref p;
+            p.set_uint("max_conflicts", max_conflicts);
+            p.set_bool("elim_vars", false);
+            return p;
+        }
+
+        uint64_t random_word() {
+            // xorshift64
+            m_seed ^= m_seed << 13;
+            m_seed ^= m_seed >> 7;
+            m_seed ^= m_seed << 17;
+            return m_seed;
+        }
+
+        unsigned idx(aig * n) const { return m_id2idx[n->m_id]; }
+
+        void collect(aig_lit const & r) {
+            aig * t = m.m_true.ptr();
+            t->m_mark = true;
+            m_id2idx.insert(t->m_id, 0);
+            m_nodes.push_back(t);
+            ptr_vector<aig> todo;
+            todo.push_back(r.ptr());
+            while (!todo.empty()) {
+                aig * n = todo.back();
+                if (n->m_mark) {
+                    todo.pop_back();
+                    continue;
+                }
+                bool visited = true;
+                if (!is_var(n)) {
+                    for (unsigned i = 0; i < 2; ++i) {
+                        aig * c = n->m_children[i].ptr();
+                        if (!c->m_mark) {
+                            todo.push_back(c);
+                            visited = false;
+                        }
+                    }
+                }
+                if (!visited)
+                    continue;
+                todo.pop_back();
+                n->m_mark = true;
+                m_id2idx.insert(n->m_id, m_nodes.size());
+                m_nodes.push_back(n);
+            }
+            unmark(m_nodes.size(), m_nodes.data());
+        }
+
+        uint64_t child_word(aig_lit const & c, unsigned w) const {
+            uint64_t v = m_sim[idx(c.ptr()) * NUM_WORDS + w];
+            return c.is_inverted() ? ~v : v;
+        }
+
+        void simulate() {
+            unsigned sz = m_nodes.size();
+            m_sim.reset();
+            m_sim.resize(sz * NUM_WORDS, 0);
+            for (unsigned i = 0; i < sz; ++i) {
+                aig * n = m_nodes[i];
+                for (unsigned w = 0; w < NUM_WORDS; ++w) {
+                    uint64_t & v = m_sim[i * NUM_WORDS + w];
+                    if (i == 0)
+                        v = ~static_cast<uint64_t>(0);
+                    else if (is_var(n)) 
+                        v = random_word();
+                    else 
+                        v = child_word(n->m_children[0], w) & child_word(n->m_children[1], w);
+                }
+                if (i > 0 && is_var(n)) {
+                    // the most recent counterexamples occupy the low lanes.
+                    unsigned num_cex = std::min(m_cex.size(), 64 * NUM_WORDS);
+                    for (unsigned k = 0; k < num_cex; ++k) {
+                        bool_vector const & cex = m_cex[m_cex.size() - 1 - k];
+                        uint64_t bit = static_cast<uint64_t>(1) << (k % 64);
+                        uint64_t & v = m_sim[i * NUM_WORDS + k / 64];
+                        if (cex[i])
+                            v |= bit;
+                        else
+                            v &= ~bit;
+                    }
+                }
+            }
+        }
+
+        bool sim_phase(unsigned i) const { return (m_sim[i * NUM_WORDS] & 1) != 0; }
+
+        uint64_t sim_word(unsigned i, unsigned w) const {
+            uint64_t v = m_sim[i * NUM_WORDS + w];
+            return sim_phase(i) ? ~v : v;
+        }
+
+        bool sim_lt(unsigned i, unsigned j) const {
+            for (unsigned w = 0; w < NUM_WORDS; ++w) {
+                uint64_t a = sim_word(i, w), b = sim_word(j, w);
+                if (a != b)
+                    return a < b;
+            }
+            return i < j;
+        }
+
+        bool sim_eq(unsigned i, unsigned j) const {
+            for (unsigned w = 0; w < NUM_WORDS; ++w)
+                if (sim_word(i, w) != sim_word(j, w))
+                    return false;
+            return true;
+        }
+
+        void encode() {
+            unsigned sz = m_nodes.size();
+            for (unsigned i = 0; i < sz; ++i)
+                m_solver.mk_var(true, true);
+            sat::literal t = lit(0, false);
+            m_solver.mk_clause(1, &t);
+            for (unsigned i = 1; i < sz; ++i) {
+                aig * n = m_nodes[i];
+                if (is_var(n))
+                    continue;
+                sat::literal v = lit(i, false);
+                sat::literal a = lit(n->m_children[0]);
+                sat::literal b = lit(n->m_children[1]);
+                m_solver.mk_clause(~v, a);
+                m_solver.mk_clause(~v, b);
+                m_solver.mk_clause(v, ~a, ~b);
+            }
+        }
+
+        sat::literal lit(unsigned i, bool sign) const { return sat::literal(i, sign); }
+        sat::literal lit(aig_lit const & c) const { return lit(idx(c.ptr()), c.is_inverted()); }
+
+        // return l_true if a => b is valid, l_false if a counterexample was found.
+        lbool implies(sat::literal a, sat::literal b) {
+            sat::literal asms[2] = { a, ~b };
+            ++m_num_checks;
+            lbool r = m_solver.check(2, asms);
+            if (r == l_true) {
+                bool_vector cex;
+                for (unsigned i = 0; i < m_nodes.size(); ++i)
+                    cex.push_back(m_solver.get_model()[i] == l_true);
+                m_cex.push_back(cex);
+                return l_false;
+            }
+            if (r == l_false)
+                return l_true;
+            return l_undef;
+        }
+
+        bool check_equiv(unsigned i, unsigned r, bool phase) {
+            sat::literal li = lit(i, false), lr = lit(r, phase);
+            if (implies(li, lr) != l_true || implies(lr, li) != l_true)
+                return false;
+            m_solver.mk_clause(~li, lr);
+            m_solver.mk_clause(li, ~lr);
+            return true;
+        }
+
+        // one round of candidate equivalence checking. Returns true if new counterexamples were found.
+        bool sweep() {
+            simulate();
+            unsigned sz = m_nodes.size();
+            unsigned_vector order;
+            for (unsigned i = 0; i < sz; ++i)
+                if (m_repr[i] == i)
+                    order.push_back(i);
+            std::sort(order.begin(), order.end(), [&](unsigned i, unsigned j) { return sim_lt(i, j); });
+            unsigned num_cex = m_cex.size();
+            for (unsigned k = 0; k < order.size(); ) {
+                unsigned e = k + 1;
+                while (e < order.size() && sim_eq(order[k], order[e]))
+                    ++e;
+                unsigned r = order[k];
+                for (unsigned j = k + 1; j < e; ++j) {
+                    m.checkpoint();
+                    unsigned i = order[j];
+                    bool phase = sim_phase(i) != sim_phase(r);
+                    if (check_equiv(i, r, phase)) {
+                        m_repr[i]  = r;
+                        m_phase[i] = phase;
+                        ++m_num_merged;
+                    }
+                    else if (m_cex.size() - num_cex >= 64 * NUM_WORDS) 
+                        break;
+                }
+                k = e;
+            }
+            return num_cex < m_cex.size();
+        }
+
+        aig_lit rebuild(aig_lit const & r) {
+            unsigned sz = m_nodes.size();
+            svector<aig_lit> new_lits;
+            for (unsigned i = 0; i < sz; ++i) {
+                aig * n = m_nodes[i];
+                aig_lit l;
+                if (m_repr[i] != i) {
+                    l = new_lits[m_repr[i]];
+                    if (m_phase[i])
+                        l.invert();
+                }
+                else if (is_var(n)) 
+                    l = aig_lit(n);
+                else {
+                    aig_lit c[2];
+                    for (unsigned j = 0; j < 2; ++j) {
+                        aig_lit const & ch = n->m_children[j];
+                        c[j] = new_lits[idx(ch.ptr())];
+                        if (ch.is_inverted())
+                            c[j].invert();
+                    }
+                    l = m.mk_node(c[0], c[1]);
+                }
+                m.inc_ref(l);
+                new_lits.push_back(l);
+            }
+            aig_lit result = new_lits[idx(r.ptr())];
+            if (r.is_inverted())
+                result.invert();
+            m.inc_ref(result);
+            for (aig_lit const & l : new_lits)
+                m.dec_ref(l);
+            m.dec_ref_result(result);
+            return result;
+        }
+
+        aig_lit operator()(aig_lit const & r) {
+            if (is_var(r))
+                return r;
+            collect(r);
+            unsigned sz = m_nodes.size();
+            for (unsigned i = 0; i < sz; ++i) 
+                m_repr.push_back(i);
+            m_phase.resize(sz, false);
+            encode();
+            for (unsigned round = 0; round < MAX_ROUNDS && sweep(); ++round)
+                ;
+            IF_VERBOSE(10, verbose_stream() << "(aig-fraig :nodes " << sz << " :merged " << m_num_merged 
+                       << " :checks " << m_num_checks << " :cex " << m_cex.size() << ")\n";);
+            if (m_num_merged == 0)
+                return r;
+            return rebuild(r);
+        }
+    };
+
+    aig_lit fraig(aig_lit const & r, unsigned max_conflicts) {
+        fraig_proc p(*this, max_conflicts);
+        return p(r);
+    }
+
     aig_lit max_sharing(aig_lit l) {
         max_sharing_proc p(*this);
         return p(l);
@@ -1732,6 +2015,10 @@ void aig_manager::max_sharing(aig_ref & r) {
 }
 
 
+void aig_manager::fraig(aig_ref & r, unsigned max_conflicts) {
+    r = aig_ref(*this, m_imp->fraig(aig_lit(r), max_conflicts));
+}
+
 void aig_manager::to_formula(aig_ref const & r, expr_ref & res) {
     return m_imp->to_formula(aig_lit(r), res);
 }
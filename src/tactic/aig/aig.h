@@ -67,6 +67,8 @@ public:
     aig_ref mk_iff(aig_ref const & r1, aig_ref const & r2);
     aig_ref mk_ite(aig_ref const & r1, aig_ref const & r2, aig_ref const & r3);
     void max_sharing(aig_ref & r);
+    // merge functionally equivalent nodes (found by random simulation, proved by SAT).
+    void fraig(aig_ref & r, unsigned max_conflicts);
     void to_formula(aig_ref const & r, expr_ref & result);
     void to_formula(aig_ref const & r, goal & result);
     void display(std::ostream & out, aig_ref const & r) const;
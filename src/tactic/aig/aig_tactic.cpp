@@ -27,6 +27,8 @@ class aig_manager;
 class aig_tactic : public tactic {
     unsigned long long m_max_memory;
     bool               m_aig_gate_encoding;
+    bool               m_fraig;
+    unsigned           m_fraig_conflicts;
     aig_manager *      m_aig_manager;
 
     struct mk_aig_manager {
@@ -54,16 +56,28 @@ public:
         aig_tactic * t = alloc(aig_tactic);
         t->m_max_memory = m_max_memory;
         t->m_aig_gate_encoding = m_aig_gate_encoding;
+        t->m_fraig = m_fraig;
+        t->m_fraig_conflicts = m_fraig_conflicts;
         return t;
     }
 
     void updt_params(params_ref const & p) override {
         m_max_memory        = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         m_aig_gate_encoding = p.get_bool("aig_default_gate_encoding", true);
+        m_fraig             = p.get_bool("aig_fraig", false);
+        m_fraig_conflicts   = p.get_uint("aig_fraig_conflicts", 100);
     }
 
     void collect_param_descrs(param_descrs & r) override {
         insert_max_memory(r);
+        r.insert("aig_fraig", CPK_BOOL, "(default: false) merge equivalent AIG nodes using random simulation and SAT sweeping.");
+        r.insert("aig_fraig_conflicts", CPK_UINT, "(default: 100) conflict budget for each equivalence check during SAT sweeping.");
+    }
+
+    void simplify(aig_ref & r) {
+        m_aig_manager->max_sharing(r);
+        if (m_fraig)
+            m_aig_manager->fraig(r, m_fraig_conflicts);
     }
 
     void operator()(goal_ref const & g) {
@@ -80,7 +94,7 @@ public:
             }
             else {
                 aig_ref r = m_aig_manager->mk_aig(g->form(i));
-                m_aig_manager->max_sharing(r);
+                simplify(r);
                 expr_ref new_f(m);
                 m_aig_manager->to_formula(r, new_f);
                 unsigned old_sz = get_num_exprs(g->form(i));
@@ -93,7 +107,7 @@ public:
         if (!nodeps.empty()) {
             expr_ref conj(::mk_and(nodeps));
             aig_ref r = m_aig_manager->mk_aig(conj);
-            m_aig_manager->max_sharing(r);
+            simplify(r);
             expr_ref new_f(m);
             m_aig_manager->to_formula(r, new_f);
             unsigned old_sz = get_num_exprs(conj);
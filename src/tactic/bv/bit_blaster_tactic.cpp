@@ -15,6 +15,11 @@ Author:
 
 Notes:
 
+    With blast_threads > 1 the goal is split into cones of formulas that
+    share no sub-terms. Cones are bit-blasted concurrently in private
+    managers and translated back in a fixed order, so the result does
+    not depend on thread scheduling.
+
 --*/
 #include "tactic/tactical.h"
 #include "tactic/bv/bit_blaster_model_converter.h"
@@ -22,6 +27,10 @@ Notes:
 #include "ast/ast_pp.h"
 #include "model/model_pp.h"
 #include "ast/rewriter/rewriter_types.h"
+#include "ast/ast_translation.h"
+#include "util/union_find.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
 
 class bit_blaster_tactic : public tactic {
 
@@ -31,6 +40,8 @@ class bit_blaster_tactic : public tactic {
         bit_blaster_rewriter*  m_rewriter;    
         unsigned               m_num_steps;
         bool                   m_blast_quant;
+        unsigned               m_threads;
+        params_ref             m_params;
 
         imp(ast_manager & m, bit_blaster_rewriter* rw, params_ref const & p):
             m_base_rewriter(m, p),
@@ -40,6 +51,8 @@ class bit_blaster_tactic : public tactic {
 
         void updt_params_core(params_ref const & p) {
             m_blast_quant = p.get_bool("blast_quant", false);
+            m_threads     = p.get_uint("blast_threads", 1);
+            m_params.copy(p);
         }
 
         void updt_params(params_ref const & p) {
@@ -61,6 +74,14 @@ class bit_blaster_tactic : public tactic {
             
             TRACE("before_bit_blaster", g->display(tout););
             m_num_steps = 0;
+
+            if (m_threads > 1 && !proofs_enabled && !m_blast_quant && m_rewriter == &m_base_rewriter && 
+                !g->inconsistent() && par_blast(g)) {
+                g->inc_depth();
+                result.push_back(g.get());
+                TRACE("after_bit_blaster", g->display(tout); if (g->mc()) g->mc()->display(tout); tout << "\n";);
+                return;
+            }
             
             m_rewriter->start_rewrite();
             expr_ref   new_curr(m());
@@ -97,6 +118,205 @@ class bit_blaster_tactic : public tactic {
         }
         
         unsigned get_num_steps() const { return m_num_steps; }
+
+        /**
+           \brief Partition the formulas of g into cones that share no sub-expressions.
+           cones[i] lists formula indices in increasing order; the cones are sorted by 
+           decreasing size (ties broken by first formula).
+        */
+        void mk_cones(goal const & g, vector<unsigned_vector> & cones, unsigned_vector & sizes) {
+            unsigned sz = g.size();
+            basic_union_find uf;
+            for (unsigned i = 0; i < sz; ++i)
+                uf.mk_var();
+            obj_map<expr, unsigned> owner;
+            unsigned_vector weight(sz, 0u);
+            ptr_vector<expr> todo;
+            for (unsigned i = 0; i < sz; ++i) {
+                todo.push_back(g.form(i));
+                while (!todo.empty()) {
+                    expr * e = todo.back();
+                    todo.pop_back();
+                    unsigned j;
+                    if (owner.find(e, j)) {
+                        uf.merge(i, j);
+                        continue;
+                    }
+                    owner.insert(e, i);
+                    ++weight[i];
+                    if (is_app(e)) 
+                        for (expr * arg : *to_app(e))
+                            todo.push_back(arg);
+                    else if (is_quantifier(e))
+                        todo.push_back(to_quantifier(e)->get_expr());
+                }
+            }
+            u_map<unsigned> root2cone;
+            for (unsigned i = 0; i < sz; ++i) {
+                unsigned r = uf.find(i), c;
+                if (!root2cone.find(r, c)) {
+                    c = cones.size();
+                    root2cone.insert(r, c);
+                    cones.push_back(unsigned_vector());
+                    sizes.push_back(0);
+                }
+                cones[c].push_back(i);
+                sizes[c] += weight[i];
+            }
+            unsigned_vector order;
+            for (unsigned c = 0; c < cones.size(); ++c)
+                order.push_back(c);
+            std::stable_sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return sizes[a] > sizes[b]; });
+            vector<unsigned_vector> sorted_cones;
+            unsigned_vector sorted_sizes;
+            for (unsigned c : order) {
+                sorted_cones.push_back(cones[c]);
+                sorted_sizes.push_back(sizes[c]);
+            }
+            cones.swap(sorted_cones);
+            sizes.swap(sorted_sizes);
+        }
+
+        /**
+           \brief Bit-blast the cones of g on separate threads.
+           Return false if the goal has a single cone; g is then left unchanged.
+        */
+        bool par_blast(goal_ref const & g) {
+#ifdef SINGLE_THREAD
+            return false;
+#else
+            vector<unsigned_vector> cones;
+            unsigned_vector sizes;
+            mk_cones(*g, cones, sizes);
+            if (cones.size() <= 1)
+                return false;
+
+            // assign cones to workers, largest first, to the least loaded worker.
+            unsigned num_workers = std::min(m_threads, cones.size());
+            vector<unsigned_vector> jobs(num_workers);
+            unsigned_vector load(num_workers, 0u);
+            for (unsigned c = 0; c < cones.size(); ++c) {
+                unsigned w = 0;
+                for (unsigned k = 1; k < num_workers; ++k)
+                    if (load[k] < load[w])
+                        w = k;
+                load[w] += sizes[c];
+                for (unsigned idx : cones[c])
+                    jobs[w].push_back(idx);
+            }
+            for (auto & job : jobs)
+                std::sort(job.begin(), job.end());
+
+            IF_VERBOSE(10, verbose_stream() << "(bit-blaster :cones " << cones.size() << " :threads " << num_workers << ")\n");
+
+            struct worker {
+                scoped_ptr<ast_manager>      m;
+                scoped_ptr<bit_blaster_rewriter> rw;
+                expr_ref_vector*             fmls { nullptr };
+                expr_ref_vector*             results { nullptr };
+                unsigned                     num_steps { 0 };
+                bool                         failed { false };
+                bool                         rewriter_failed { false };
+                std::string                  msg;
+                ~worker() { 
+                    dealloc(fmls); 
+                    dealloc(results); 
+                    rw = nullptr; 
+                }
+            };
+            scoped_limits scl(m().limit());
+            scoped_ptr_vector<worker> owned;
+            for (unsigned w = 0; w < num_workers; ++w) {
+                worker * wk = alloc(worker);
+                owned.push_back(wk);
+                wk->m = alloc(ast_manager, m(), true);
+                ast_translation tr(m(), *wk->m, false);
+                wk->fmls = alloc(expr_ref_vector, *wk->m);
+                wk->results = alloc(expr_ref_vector, *wk->m);
+                for (unsigned idx : jobs[w])
+                    wk->fmls->push_back(tr(g->form(idx)));
+                wk->rw = alloc(bit_blaster_rewriter, *wk->m, m_params);
+                scl.push_child(&wk->m->limit());
+            }
+
+            auto run = [&](worker & wk) {
+                try {
+                    wk.rw->start_rewrite();
+                    expr_ref r(*wk.m);
+                    proof_ref pr(*wk.m);
+                    for (expr * f : *wk.fmls) {
+                        (*wk.rw)(f, r, pr);
+                        wk.num_steps += wk.rw->get_num_steps();
+                        wk.results->push_back(r);
+                    }
+                }
+                catch (rewriter_exception & ex) {
+                    wk.failed = true;
+                    wk.rewriter_failed = true;
+                    wk.msg = ex.msg();
+                }
+                catch (z3_exception & ex) {
+                    wk.failed = true;
+                    wk.msg = ex.msg();
+                }
+                if (wk.failed)
+                    for (worker * other : owned)
+                        other->m->limit().cancel();
+            };
+
+            thread_pool::run(num_workers, [&](unsigned w) { run(*owned[w]); });
+
+            // report the failure of the first worker that did not just observe a cancellation.
+            for (worker * wk : owned) 
+                if (wk->rewriter_failed)
+                    throw rewriter_exception(std::move(wk->msg));
+            for (worker * wk : owned) 
+                if (wk->failed)
+                    throw tactic_exception(std::move(wk->msg));
+
+            // translate results back in worker order. The fresh bits of each worker
+            // are replaced by fresh constants of the main manager, since fresh names
+            // are only unique within a manager.
+            bool change = false;
+            obj_map<func_decl, expr*> const2bits;
+            ptr_vector<func_decl> newbits;
+            expr_ref_vector trail(m());
+            for (unsigned w = 0; w < num_workers; ++w) {
+                worker & wk = *owned[w];
+                m_num_steps += wk.num_steps;
+                obj_map<func_decl, expr*> w_const2bits;
+                ptr_vector<func_decl> w_newbits;
+                wk.rw->end_rewrite(w_const2bits, w_newbits);
+                ast_translation tr(*wk.m, m(), false);
+                expr_ref_vector w_bits(*wk.m);
+                for (func_decl * f : w_newbits) {
+                    app * b = wk.m->mk_const(f);
+                    w_bits.push_back(b);
+                    app * nb = m().mk_fresh_const(nullptr, m().mk_bool_sort());
+                    trail.push_back(nb);
+                    newbits.push_back(nb->get_decl());
+                    tr.insert(b, nb);
+                    tr.insert(f, nb->get_decl());
+                }
+                for (unsigned i = 0; i < jobs[w].size(); ++i) {
+                    unsigned idx = jobs[w][i];
+                    expr_ref new_curr(tr(wk.results->get(i)), m());
+                    if (new_curr != g->form(idx)) {
+                        change = true;
+                        g->update(idx, new_curr, nullptr, g->dep(idx));
+                    }
+                }
+                for (auto const & kv : w_const2bits) {
+                    expr * v = tr(kv.m_value);
+                    trail.push_back(v);
+                    const2bits.insert(tr(kv.m_key), v);
+                }
+            }
+            if (change && g->models_enabled()) 
+                g->add(mk_bit_blaster_model_converter(m(), const2bits, newbits));
+            return true;
+#endif
+        }
     };
 
     imp *      m_imp;
@@ -131,7 +351,9 @@ public:
         insert_max_steps(r);
         r.insert("blast_mul", CPK_BOOL, "(default: true) bit-blast multipliers (and dividers, remainders).");
         r.insert("blast_add", CPK_BOOL, "(default: true) bit-blast adders.");
+        r.insert("blast_mul_tree_size", CPK_UINT, "(default: 4294967295) use Wallace tree multipliers for bit-vectors of at least this width.");
         r.insert("blast_quant", CPK_BOOL, "(default: false) bit-blast quantified variables.");
+        r.insert("blast_threads", CPK_UINT, "(default: 1) number of threads used to bit-blast independent parts of the goal.");
         r.insert("blast_full", CPK_BOOL, "(default: false) bit-blast any term with bit-vector sort, this option will make E-matching ineffective in any pattern containing bit-vector terms.");
     }
      
@@ -0,0 +1,29 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bv_known_bits_tactic.cpp
+
+Abstract:
+
+    Tactic for simplifying with known bits of bit-vector terms
+
+--*/
+
+#include "ast/simplifiers/bv_known_bits.h"
+#include "tactic/tactic.h"
+#include "tactic/dependent_expr_state_tactic.h"
+#include "tactic/bv/bv_known_bits_tactic.h"
+
+
+class bv_known_bits_factory : public dependent_expr_simplifier_factory {
+public:
+    dependent_expr_simplifier* mk(ast_manager& m, params_ref const& p, dependent_expr_state& s) override {
+        return alloc(bv::known_bits, m, s);
+    }
+};
+
+tactic* mk_bv_known_bits_tactic(ast_manager& m, params_ref const& p) {
+    return alloc(dependent_expr_state_tactic, m, p, alloc(bv_known_bits_factory), "bv-known-bits");
+}
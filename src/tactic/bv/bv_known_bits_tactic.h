@@ -0,0 +1,23 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bv_known_bits_tactic.h
+
+Abstract:
+
+    Tactic for simplifying with known bits of bit-vector terms
+
+--*/
+#pragma once
+
+#include "util/params.h"
+class ast_manager;
+class tactic;
+
+tactic * mk_bv_known_bits_tactic(ast_manager & m, params_ref const & p = params_ref());
+
+/*
+  ADD_TACTIC("bv-known-bits", "simplify using the known bits of bit-vector terms.", "mk_bv_known_bits_tactic(m, p)")
+*/
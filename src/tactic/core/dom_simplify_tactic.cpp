@@ -97,8 +97,11 @@ bool expr_dominators::compute_dominators() {
               });
 
         SASSERT(m_post2expr.empty() || m_post2expr.back() == e);
-        for (unsigned i = 0; i + 1 < m_post2expr.size(); ++i) {
-            expr * child = m_post2expr[i];
+        // visit parents before children, so that on the acyclic graph of
+        // expressions the first pass computes the dominators and the second
+        // pass only confirms them.
+        for (unsigned i = m_post2expr.size(); i-- > 1; ) {
+            expr * child = m_post2expr[i - 1];
             ptr_vector<expr> const& p = m_parents[child];
             expr * new_idom = nullptr, *idom2 = nullptr;
 
@@ -193,10 +196,43 @@ void dom_simplify_tactic::operator()(goal_ref const & in, goal_ref_buffer & resu
 void dom_simplify_tactic::cleanup() {
     m_trail.reset();
     m_args.reset();
-    m_result.reset();
+    reset_cache();
+    m_subexpr_cache.reset();
     m_dominators.reset();
 }
 
+/**
+   \brief cache the simplification of t.
+   The result is valid as long as the scopes of the assumptions it was 
+   simplified under are not popped.
+*/
+void dom_simplify_tactic::cache(expr* t, expr* r) {
+    expr* old = nullptr;
+    m_result.find(t, old);
+    m_cache_trail.push_back({ t, old, scope_level() });
+    m_result.insert(t, r);
+    m_trail.push_back(r);
+}
+
+void dom_simplify_tactic::reset_cache() {
+    m_result.reset();
+    m_cache_trail.reset();
+}
+
+void dom_simplify_tactic::pop(unsigned n) {
+    SASSERT(n <= m_simplifier->scope_level());
+    m_simplifier->pop(n);
+    unsigned lvl = scope_level();
+    while (!m_cache_trail.empty() && m_cache_trail.back().m_level > lvl) {
+        auto const& [t, old, l] = m_cache_trail.back();
+        if (old)
+            m_result.insert(t, old);
+        else
+            m_result.remove(t);
+        m_cache_trail.pop_back();
+    }
+}
+
 expr_ref dom_simplify_tactic::simplify_ite(app * ite) {
     expr_ref r(m);
     expr * c = nullptr, *t = nullptr, *e = nullptr;
@@ -214,17 +250,16 @@ expr_ref dom_simplify_tactic::simplify_ite(app * ite) {
             if (is_subexpr(child, t) && !is_subexpr(child, e)) 
                 simplify_rec(child);            
         
-        pop(scope_level() - old_lvl);
         expr_ref new_t = simplify_arg(t);
-        reset_cache();
+        pop(scope_level() - old_lvl);
         if (!assert_expr(new_c, true)) {
             return new_t;
         }
         for (expr * child : tree(ite)) 
             if (is_subexpr(child, e) && !is_subexpr(child, t)) 
                 simplify_rec(child);
-        pop(scope_level() - old_lvl);
         expr_ref new_e = simplify_arg(e);
+        pop(scope_level() - old_lvl);
 
         if (c == new_c && t == new_t && e == new_e) {
             r = ite;
@@ -237,7 +272,6 @@ expr_ref dom_simplify_tactic::simplify_ite(app * ite) {
             r = m.mk_ite(new_c, new_t, new_e);
         }        
     }
-    reset_cache();
     return r;
 }
 
@@ -256,9 +290,13 @@ expr_ref dom_simplify_tactic::simplify_rec(expr * e0) {
     expr_ref r(m);
     expr* e = nullptr;
 
-    if (!m_result.find(e0, e)) {
-        e = e0;
+    // a cached result was simplified under a subset of the current assumptions
+    if (m_result.find(e0, e)) {
+        r = e;
+        (*m_simplifier)(r);
+        return r;
     }
+    e = e0;
     
     ++m_depth;
     if (m_depth > m_max_depth) {
@@ -302,7 +340,6 @@ expr_ref dom_simplify_tactic::simplify_rec(expr * e0) {
     cache(e0, r);
     CTRACE("simplify", e0 != r, tout << "depth: " << m_depth << " " << mk_pp(e0, m) << " -> " << r << "\n";);
     --m_depth;
-    m_subexpr_cache.reset();
     return r;
 }
 
@@ -333,7 +370,6 @@ expr_ref dom_simplify_tactic::simplify_and_or(bool is_and, app * e) {
         if (!assert_expr(r, !is_and)) {                     
             pop(scope_level() - old_lvl);                   
             r = is_and ? m.mk_false() : m.mk_true();        
-            reset_cache();
             return true;
         }                     
         return false;
@@ -354,7 +390,6 @@ expr_ref dom_simplify_tactic::simplify_and_or(bool is_and, app * e) {
     }
     
     pop(scope_level() - old_lvl);
-    reset_cache();
     return { is_and ? mk_and(args) : mk_or(args), m };
 }
 
@@ -364,7 +399,6 @@ expr_ref dom_simplify_tactic::simplify_not(app * e) {
     unsigned old_lvl = scope_level();
     expr_ref t = simplify_rec(ee);
     pop(scope_level() - old_lvl);
-    reset_cache();
     return mk_not(t);
 }
 
@@ -374,8 +408,9 @@ bool dom_simplify_tactic::init(goal& g) {
     unsigned sz = g.size();
     for (unsigned i = 0; i < sz; ++i) args.push_back(g.form(i));
     expr_ref fml = mk_and(args);
-    m_result.reset();
+    reset_cache();
     m_trail.reset();
+    m_subexpr_cache.reset();
     return m_dominators.compile(fml);
 }
 
@@ -408,9 +443,9 @@ void dom_simplify_tactic::simplify_goal(goal& g) {
         }
         pop(scope_level());
 
-        // go backwards
+        // go backwards, the dominators are still valid if the goal did not change
         m_forward = false;
-        if (!init(g)) return;
+        if (change && !init(g)) return;
         sz = g.size();
         for (unsigned i = sz; !g.inconsistent() && i > 0; ) {
             --i;
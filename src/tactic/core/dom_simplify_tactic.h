@@ -87,11 +87,17 @@ class dom_simplifier {
 };
 
 class dom_simplify_tactic : public tactic {
+    struct cache_entry {
+        expr*    m_expr;
+        expr*    m_old;
+        unsigned m_level;
+    };
     ast_manager&         m;
     dom_simplifier*      m_simplifier;
     params_ref           m_params;
     expr_ref_vector      m_trail, m_args;
     obj_map<expr, expr*> m_result;
+    svector<cache_entry> m_cache_trail;    // undo trail of m_result by scope level
     expr_dominators      m_dominators;
     unsigned             m_depth;
     unsigned             m_max_depth;
@@ -111,14 +117,14 @@ class dom_simplify_tactic : public tactic {
     bool is_subexpr(expr * a, expr * b);
 
     expr_ref get_cached(expr* t) { expr* r = nullptr; if (!m_result.find(t, r)) r = t; return expr_ref(r, m); }
-    void cache(expr *t, expr* r) { m_result.insert(t, r); m_trail.push_back(r); }
-    void reset_cache() { m_result.reset(); }
+    void cache(expr *t, expr* r);
+    void reset_cache();
 
     ptr_vector<expr> const & tree(expr * e);
     expr* idom(expr *e) const { return m_dominators.idom(e); }
 
     unsigned scope_level() { return m_simplifier->scope_level(); }
-    void pop(unsigned n) { SASSERT(n <= m_simplifier->scope_level()); m_simplifier->pop(n); }
+    void pop(unsigned n);
     bool assert_expr(expr* f, bool sign) { return m_simplifier->assert_expr(f, sign); }
 
     bool init(goal& g);
@@ -0,0 +1,43 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    simplify_components_tactic.h
+
+Abstract:
+
+    Tactic for running solve-eqs, elim-uncnstr2 and propagate-values2
+    on the independent components of a goal.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+#include "tactic/tactic.h"
+#include "tactic/dependent_expr_state_tactic.h"
+#include "tactic/core/solve_eqs_tactic.h"
+#include "tactic/core/elim_uncnstr2_tactic.h"
+#include "tactic/core/propagate_values2_tactic.h"
+#include "ast/simplifiers/component_simplifier.h"
+
+
+class simplify_components_tactic_factory : public dependent_expr_simplifier_factory {
+public:
+    dependent_expr_simplifier* mk(ast_manager& m, params_ref const& p, dependent_expr_state& s) override {
+        dependent_expr_simplifier_factory* fs[3] = {
+            alloc(solve_eqs_tactic_factory),
+            alloc(elim_uncnstr2_tactic_factory),
+            alloc(propagate_values2_tactic_factory)
+        };
+        return alloc(component_simplifier, m, p, s, 3, fs);
+    }
+};
+
+inline tactic * mk_simplify_components_tactic(ast_manager& m, params_ref const& p = params_ref()) {
+    return alloc(dependent_expr_state_tactic, m, p, alloc(simplify_components_tactic_factory), "simplify-components");
+}
+
+/*
+  ADD_TACTIC("simplify-components", "solve for variables, eliminate unconstrained variables and propagate values on the independent components of a goal.", "mk_simplify_components_tactic(m, p)")
+*/
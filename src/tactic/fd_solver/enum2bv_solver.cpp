@@ -85,6 +85,7 @@ public:
     void collect_param_descrs(param_descrs & r) override { m_solver->collect_param_descrs(r); }    
     void set_produce_models(bool f) override { m_solver->set_produce_models(f); }
     void set_progress_callback(progress_callback * callback) override { m_solver->set_progress_callback(callback);  }
+    void register_stats_callback(unsigned interval_ms, stats_eh const& eh) override { m_solver->register_stats_callback(interval_ms, eh); }
     void collect_statistics(statistics & st) const override { m_solver->collect_statistics(st); }
     void get_unsat_core(expr_ref_vector & r) override { m_solver->get_unsat_core(r); }
     void set_phase(expr* e) override { m_solver->set_phase(e); }
@@ -191,6 +192,14 @@ public:
         return m_solver->get_trail(max_level);
     }
 
+    void get_hints(expr_ref_vector& hints) override {
+        m_solver->get_hints(hints);
+    }
+
+    void set_hints(expr_ref_vector const& hints) override {
+        m_solver->set_hints(hints);
+    }
+
     unsigned get_num_assertions() const override {
         return m_solver->get_num_assertions();
     }
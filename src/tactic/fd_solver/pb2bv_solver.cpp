@@ -82,6 +82,7 @@ public:
     void collect_param_descrs(param_descrs & r) override { m_solver->collect_param_descrs(r); m_rewriter.collect_param_descrs(r);}    
     void set_produce_models(bool f) override { m_solver->set_produce_models(f); }
     void set_progress_callback(progress_callback * callback) override { m_solver->set_progress_callback(callback);  }
+    void register_stats_callback(unsigned interval_ms, stats_eh const& eh) override { m_solver->register_stats_callback(interval_ms, eh); }
     void collect_statistics(statistics & st) const override { 
         m_rewriter.collect_statistics(st);
         m_solver->collect_statistics(st); 
@@ -107,6 +108,14 @@ public:
         return m_solver->get_trail(max_level);
     }
 
+    void get_hints(expr_ref_vector& hints) override {
+        m_solver->get_hints(hints);
+    }
+
+    void set_hints(expr_ref_vector const& hints) override {
+        m_solver->set_hints(hints);
+    }
+
     model_converter* external_model_converter() const{
         return concat(mc0(), local_model_converter());
     }
@@ -115,6 +115,14 @@ void goal::copy_to(goal & target) const {
     target.m_dc                   = m_dc.get();
 }
 
+void goal::move_from(goal & src) {
+    if (this == &src)
+        return;
+    src.copy_to(*this);
+    src.reset_core();
+    src.m_inconsistent = false;
+}
+
 void goal::push_back(expr * f, proof * pr, expr_dependency * d) {
     SASSERT(!proofs_enabled() || pr);
     if (m().is_true(f))
@@ -287,6 +295,9 @@ void goal::get_formulas(expr_ref_vector & result) const {
 void goal::update(unsigned i, expr * f, proof * pr, expr_dependency * d) {
     if (m_inconsistent)
         return;
+    // leave the arrays untouched when nothing changes, copies of the goal keep sharing them.
+    if (f == form(i) && (!proofs_enabled() || pr == this->pr(i)) && (!unsat_core_enabled() || d == dep(i)))
+        return;
     if (proofs_enabled()) {
         SASSERT(pr);
         if (!pr)
@@ -110,6 +110,8 @@ public:
 
     void copy_to(goal & target) const;
     void copy_from(goal const & src) { src.copy_to(*this); }
+    // copy the assertions of src and reset src, so the two goals do not share their arrays.
+    void move_from(goal & src);
 
     void assert_expr(expr * f, proof * pr, expr_dependency * d);
     void assert_expr(expr * f, expr_dependency * d);
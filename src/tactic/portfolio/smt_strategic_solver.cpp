@@ -20,6 +20,7 @@ Notes:
 #include "cmd_context/cmd_context.h"
 #include "solver/combined_solver.h"
 #include "solver/tactic2solver.h"
+#include "solver/simplifier_solver.h"
 #include "tactic/smtlogics/qfbv_tactic.h"
 #include "tactic/smtlogics/qflia_tactic.h"
 #include "tactic/smtlogics/qfnia_tactic.h"
@@ -33,11 +34,13 @@ Notes:
 #include "tactic/smtlogics/qfidl_tactic.h"
 #include "tactic/smtlogics/nra_tactic.h"
 #include "tactic/portfolio/default_tactic.h"
+#include "tactic/portfolio/strategy_selector_tactic.h"
 #include "tactic/fd_solver/fd_solver.h"
 #include "tactic/fd_solver/smtfd_solver.h"
 #include "tactic/ufbv/ufbv_tactic.h"
 #include "tactic/fpa/qffp_tactic.h"
 #include "muz/fp/horn_tactic.h"
+#include "tactic/core/simplify_components_tactic.h"
 #include "smt/smt_solver.h"
 #include "sat/sat_solver/inc_sat_solver.h"
 #include "ast/rewriter/bv_rewriter.h"
@@ -45,7 +48,10 @@ Notes:
 #include "solver/parallel_tactic.h"
 #include "solver/parallel_params.hpp"
 #include "params/tactic_params.hpp"
+#include "params/solver_params.hpp"
 #include "parsers/smt2/smt2parser.h"
+#include "cmd_context/tactic_cmds.h"
+#include <fstream>
 
 
 
@@ -123,9 +129,53 @@ static solver* mk_solver_for_logic(ast_manager & m, params_ref const & p, symbol
         s = mk_inc_sat_solver(m, p);
     if (!s) 
         s = mk_smt_solver(m, p, logic);
+    solver_params sp(p);
+    if (sp.incremental_preprocess() && !m.proofs_enabled())
+        s = mk_simplifier_solver(s, alloc(simplify_components_tactic_factory));
     return s;
 }
 
+/**
+   \brief create a tactic that selects the strategy of a goal using the
+   rules of a strategy model file, see strategy_selector_tactic.h.
+*/
+static tactic* mk_strategy_model_tactic(cmd_context& ctx, char const* file_name, params_ref const& p, tactic* fallback) {
+    tactic_ref f(fallback);
+    std::ifstream in(file_name);
+    if (in.bad() || in.fail())
+        throw default_exception(std::string("could not open strategy model ") + file_name);
+    std::stringstream buffer;
+    buffer << "(" << in.rdbuf() << "\n)";
+    sexpr_ref se = parse_sexpr(ctx, buffer, p, file_name);
+    if (!se)
+        throw default_exception(std::string("could not parse strategy model ") + file_name);
+    vector<strategy_rule> rules;
+    for (unsigned i = 0; i < se->get_num_children(); ++i) {
+        sexpr* r = se->get_child(i);
+        if (!r->is_composite() || r->get_num_children() < 2 ||
+            !r->get_child(0)->is_symbol() || r->get_child(0)->get_symbol() != "rule")
+            throw default_exception("invalid strategy model, (rule <tactic> (<feature> <value>)*) expected");
+        strategy_rule rule;
+        rule.m_tactic = sexpr2tactic(ctx, r->get_child(1));
+        for (unsigned j = 2; j < r->get_num_children(); ++j) {
+            sexpr* ft = r->get_child(j);
+            if (!ft->is_composite() || ft->get_num_children() != 2 ||
+                !ft->get_child(0)->is_symbol() || !ft->get_child(1)->is_numeral())
+                throw default_exception("invalid strategy model, (<feature> <value>) expected");
+            symbol name = ft->get_child(0)->get_symbol();
+            if (!is_strategy_feature(name)) {
+                std::ostringstream strm;
+                strm << "unknown feature " << name << " in strategy model, the features are:";
+                display_strategy_features(strm);
+                throw default_exception(strm.str());
+            }
+            rule.m_features.push_back({ name, ft->get_child(1)->get_numeral().get_double() });
+        }
+        rules.push_back(rule);
+    }
+    return mk_strategy_selector_tactic(ctx.m(), rules, f.get());
+}
+
 class smt_strategic_solver_factory : public solver_factory {
     symbol m_logic;
 public:
@@ -158,6 +208,11 @@ public:
         }
         if (!t) {
             t = mk_tactic_for_logic(m, p, l);
+            symbol model = tp.strategy_model();
+            if (model != symbol::null && !model.is_numerical() && model.str()[0]) {
+                cmd_context ctx(false, &m, l);
+                t = mk_strategy_model_tactic(ctx, model.str().c_str(), p, t.get());
+            }
         }
         return mk_combined_solver(mk_tactic2solver(m, t.get(), p, proofs_enabled, models_enabled, unsat_core_enabled, l),
                                   mk_solver_for_logic(m, p, l), 
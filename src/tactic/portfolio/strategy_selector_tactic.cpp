@@ -0,0 +1,179 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    strategy_selector_tactic.cpp
+
+Abstract:
+
+    Tactic that selects a strategy from the static features of a goal.
+
+--*/
+#include <cmath>
+#include "ast/static_features.h"
+#include "tactic/portfolio/strategy_selector_tactic.h"
+
+namespace {
+
+    typedef double (*feature_fn)(static_features const&);
+
+    struct feature_info {
+        char const* m_name;
+        feature_fn  m_fn;
+    };
+
+#define SF(_name_, _field_) { _name_, [](static_features const& sf) { return static_cast<double>(sf._field_); } }
+
+    feature_info const g_features[] = {
+        SF("exprs", m_num_exprs),
+        SF("roots", m_num_roots),
+        SF("quantifiers", m_num_quantifiers),
+        SF("clauses", m_num_clauses),
+        SF("bin-clauses", m_num_bin_clauses),
+        SF("units", m_num_units),
+        SF("bool-exprs", m_num_bool_exprs),
+        SF("bool-constants", m_num_bool_constants),
+        SF("ite-terms", m_num_ite_terms),
+        SF("ands", m_num_ands),
+        SF("ors", m_num_ors),
+        SF("eqs", m_num_eqs),
+        SF("uninterpreted-constants", m_num_uninterpreted_constants),
+        SF("uninterpreted-functions", m_num_uninterpreted_functions),
+        SF("interpreted-constants", m_num_interpreted_constants),
+        SF("arith-terms", m_num_arith_terms),
+        SF("arith-eqs", m_num_arith_eqs),
+        SF("arith-ineqs", m_num_arith_ineqs),
+        SF("diff-terms", m_num_diff_terms),
+        SF("diff-ineqs", m_num_diff_ineqs),
+        SF("simple-eqs", m_num_simple_eqs),
+        SF("simple-ineqs", m_num_simple_ineqs),
+        SF("non-linear", m_num_non_linear),
+        SF("theories", m_num_theories),
+        SF("has-int", m_has_int),
+        SF("has-real", m_has_real),
+        SF("has-bv", m_has_bv),
+        SF("has-fpa", m_has_fpa),
+        SF("has-arrays", m_has_arrays),
+        SF("has-str", m_has_str),
+    };
+
+#undef SF
+
+    feature_info const* find_feature(symbol const& name) {
+        for (auto const& f : g_features)
+            if (name == f.m_name)
+                return &f;
+        return nullptr;
+    }
+
+    class strategy_selector_tactic : public tactic {
+        ast_manager&          m;
+        vector<strategy_rule> m_rules;
+        tactic_ref            m_fallback;
+        unsigned_vector       m_num_selected;   // rule -> number of goals it was selected for
+
+        unsigned select(goal const& g) {
+            static_features sf(m);
+            ptr_vector<expr> fmls;
+            g.get_formulas(fmls);
+            sf.collect(fmls.size(), fmls.data());
+            unsigned best = UINT_MAX;
+            double best_dist = 0;
+            for (unsigned i = 0; i < m_rules.size(); ++i) {
+                double dist = 0;
+                for (auto const& [name, value] : m_rules[i].m_features) {
+                    double d = std::log1p(std::max(0.0, find_feature(name)->m_fn(sf))) - std::log1p(std::max(0.0, value));
+                    dist += d * d;
+                }
+                if (best == UINT_MAX || dist < best_dist)
+                    best = i, best_dist = dist;
+            }
+            IF_VERBOSE(2, verbose_stream() << "(strategy-selector :rule " << best << " :distance " << best_dist << ")\n");
+            return best;
+        }
+
+    public:
+        strategy_selector_tactic(ast_manager& m, vector<strategy_rule> const& rules, tactic* fallback):
+            m(m), m_rules(rules), m_fallback(fallback) {
+            m_num_selected.resize(rules.size(), 0);
+            DEBUG_CODE(for (auto const& r : rules) for (auto const& [name, v] : r.m_features) SASSERT(find_feature(name)););
+        }
+
+        char const* name() const override { return "strategy_selector"; }
+
+        void operator()(goal_ref const& in, goal_ref_buffer& result) override {
+            unsigned i = select(*in.get());
+            if (i == UINT_MAX) {
+                (*m_fallback)(in, result);
+                return;
+            }
+            m_num_selected[i]++;
+            (*m_rules[i].m_tactic)(in, result);
+        }
+
+        void updt_params(params_ref const& p) override {
+            for (auto& r : m_rules)
+                r.m_tactic->updt_params(p);
+            m_fallback->updt_params(p);
+        }
+
+        void collect_param_descrs(param_descrs& r) override {
+            m_fallback->collect_param_descrs(r);
+        }
+
+        void collect_statistics(statistics& st) const override {
+            for (auto const& r : m_rules)
+                r.m_tactic->collect_statistics(st);
+            m_fallback->collect_statistics(st);
+            for (unsigned i = 0; i < m_num_selected.size(); ++i)
+                if (m_num_selected[i] > 0)
+                    st.update(("strategy-selector-rule-" + std::to_string(i)).c_str(), m_num_selected[i]);
+        }
+
+        void reset_statistics() override {
+            for (auto& r : m_rules)
+                r.m_tactic->reset_statistics();
+            m_fallback->reset_statistics();
+            m_num_selected.fill(0);
+        }
+
+        void cleanup() override {
+            for (auto& r : m_rules)
+                r.m_tactic->cleanup();
+            m_fallback->cleanup();
+        }
+
+        void set_logic(symbol const& l) override {
+            for (auto& r : m_rules)
+                r.m_tactic->set_logic(l);
+            m_fallback->set_logic(l);
+        }
+
+        void set_progress_callback(progress_callback* callback) override {
+            for (auto& r : m_rules)
+                r.m_tactic->set_progress_callback(callback);
+            m_fallback->set_progress_callback(callback);
+        }
+
+        tactic* translate(ast_manager& dst) override {
+            vector<strategy_rule> rules(m_rules);
+            for (auto& r : rules)
+                r.m_tactic = r.m_tactic->translate(dst);
+            return alloc(strategy_selector_tactic, dst, rules, m_fallback->translate(dst));
+        }
+    };
+}
+
+bool is_strategy_feature(symbol const& name) {
+    return find_feature(name) != nullptr;
+}
+
+void display_strategy_features(std::ostream& out) {
+    for (auto const& f : g_features)
+        out << " " << f.m_name;
+}
+
+tactic * mk_strategy_selector_tactic(ast_manager & m, vector<strategy_rule> const& rules, tactic* fallback) {
+    return alloc(strategy_selector_tactic, m, rules, fallback);
+}
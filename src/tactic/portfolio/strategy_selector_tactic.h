@@ -0,0 +1,44 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    strategy_selector_tactic.h
+
+Abstract:
+
+    Tactic that selects a strategy from the static features of a goal.
+
+    A strategy model is a list of rules. Each rule pairs a tactic with the
+    values of some static features, typically the features of the
+    benchmarks the tactic was fastest on. A goal is solved by the tactic
+    of the rule whose features are closest to its own, where features are
+    compared on a logarithmic scale.
+
+    A model file contains rules of the form
+
+        (rule <tactic> (<feature> <value>) ... (<feature> <value>))
+
+    where <tactic> uses the syntax of the tactic language.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+#include "util/symbol.h"
+#include "util/vector.h"
+#include "tactic/tactic.h"
+
+struct strategy_rule {
+    tactic_ref                        m_tactic;
+    vector<std::pair<symbol, double>> m_features;
+};
+
+/**
+   \brief true if name is a static feature that can be used in a rule.
+*/
+bool is_strategy_feature(symbol const& name);
+
+void display_strategy_features(std::ostream& out);
+
+tactic * mk_strategy_selector_tactic(ast_manager & m, vector<strategy_rule> const& rules, tactic* fallback);
@@ -556,11 +556,31 @@ void sls_engine::operator()(goal_ref const & g, model_converter_ref & mc) {
         mc = nullptr;
 }
 
-lbool sls_engine::operator()() {    
+void sls_engine::init() {
     m_tracker.initialize(m_assertions);
     m_tracker.reset(m_assertions);
     if (m_restart_init)
         m_tracker.randomize(m_assertions);
+}
+
+bool sls_engine::restart() {
+    if (m_restart_init)
+        m_tracker.randomize(m_assertions);
+    else
+        m_tracker.reset(m_assertions);
+    return m_stats.m_restarts++ < m_max_restarts;
+}
+
+unsigned sls_engine::get_num_unsat() {
+    unsigned n = 0;
+    for (expr* a : m_assertions)
+        if (!m_mpz_manager.is_one(m_tracker.get_value(a)))
+            ++n;
+    return n;
+}
+
+lbool sls_engine::operator()() {    
+    init();
 
     lbool res = l_undef;
 
@@ -569,15 +589,7 @@ lbool sls_engine::operator()() {
 
         report_tactic_progress("Searching... restarts left:", m_max_restarts - m_stats.m_restarts);
         res = search();
-
-        if (res == l_undef)
-        {
-            if (m_restart_init)
-                m_tracker.randomize(m_assertions);
-            else
-                m_tracker.reset(m_assertions);
-        }
-    } while (res != l_true && m_stats.m_restarts++ < m_max_restarts);
+    } while (res != l_true && restart());
 
     verbose_stream() << "(restarts: " << m_stats.m_restarts << " flips: " << m_stats.m_moves << " fps: " << (m_stats.m_moves / m_stats.m_stopwatch.get_current_seconds()) << ")" << std::endl;
     
@@ -110,6 +110,20 @@ public:
 
     lbool search();
 
+    /**
+       \brief prepare the tracker for the asserted formulas and set an initial assignment.
+     */
+    void init();
+
+    /**
+       \brief move to a new initial assignment, return false if the restarts are used up.
+     */
+    bool restart();
+
+    model_ref get_model() { return m_tracker.get_model(); }
+    void set_model(model_ref const& mdl) { m_tracker.set_model(mdl); }
+    unsigned get_num_unsat();
+
     lbool operator()();
     void operator()(goal_ref const & g, model_converter_ref & mc);
 
@@ -97,6 +97,10 @@ static tactic * mk_qfbv_tactic(ast_manager& m, params_ref const & p, tactic* sat
     params_ref solver_p;
     solver_p.set_bool("preprocess", false); // preprocessor of smt::context is not needed.
 
+    // merge functionally equivalent gates of the bit-blasted circuit before CNF conversion.
+    params_ref aig_p;
+    aig_p.set_bool("aig_fraig", true);
+
     tactic* preamble_st = mk_qfbv_preamble(m, p);
     tactic * st = main_p(and_then(preamble_st,
                                   // If the user sets HI_DIV0=false, then the formula may contain uninterpreted function
@@ -111,7 +115,7 @@ static tactic * mk_qfbv_tactic(ast_manager& m, params_ref const & p, tactic* sat
                                                           and_then(using_params(and_then(mk_simplify_tactic(m),
                                                                                          mk_solve_eqs_tactic(m)),
                                                                                 local_ctx_p),
-                                                                   if_no_proofs(mk_aig_tactic()))),
+                                                                   if_no_proofs(mk_aig_tactic(aig_p)))),
                                                      sat),
                                             smt))));
 
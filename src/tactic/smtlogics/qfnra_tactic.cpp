@@ -21,6 +21,7 @@ Notes:
 #include "tactic/core/propagate_values_tactic.h"
 #include "tactic/arith/nla2bv_tactic.h"
 #include "nlsat/tactic/qfnra_nlsat_tactic.h"
+#include "math/subpaving/tactic/subpaving_tactic.h"
 #include "tactic/smtlogics/smt_tactic.h"
 
 static tactic * mk_qfnra_sat_solver(ast_manager& m, params_ref const& p, unsigned bv_size) {
@@ -44,6 +45,7 @@ tactic * mk_qfnra_tactic(ast_manager & m, params_ref const& p) {
 
     return and_then(mk_simplify_tactic(m, p), 
                     mk_propagate_values_tactic(m, p),
+                    mk_icp_tactic(m, p),
                     or_else(try_for(mk_qfnra_nlsat_tactic(m, p0), 5000),
                             try_for(mk_qfnra_nlsat_tactic(m, p1), 10000),
                             mk_qfnra_sat_solver(m, p, 4),
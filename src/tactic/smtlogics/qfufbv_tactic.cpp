@@ -182,14 +182,29 @@ tactic * mk_qfufbv_tactic(ast_manager & m, params_ref const & p) {
     main_p.set_bool("elim_and", true);
     main_p.set_bool("blast_distinct", true);
 
-    tactic * const preamble_st = mk_qfufbv_preamble(m, p);
-
-    tactic * st = using_params(
-        and_then(preamble_st,
-                 cond(mk_is_qfbv_probe(), 
-                      mk_qfbv_tactic(m), 
-                      mk_smt_tactic(m, p))),
-        main_p);
+    tactic * st = nullptr;
+    if (qfufbv_tactic_params(p).lazy()) {
+        // lackr refines the abstraction with the lemmas violated by its
+        // candidate models, the smt tactic takes over if it gives up.
+        params_ref lazy_p = p;
+        lazy_p.set_bool("eager", false);
+        tactic * const ackr_st = if_no_proofs(if_no_unsat_cores(alloc(qfufbv_ackr_tactic, m, lazy_p)));
+        st = using_params(
+            and_then(mk_qfufbv_preamble1(m, p),
+                     cond(mk_is_qfufbv_probe(), 
+                          and_then(ackr_st, mk_smt_tactic(m, p)),
+                          mk_smt_tactic(m, p))),
+            main_p);
+    }
+    else {
+        tactic * const preamble_st = mk_qfufbv_preamble(m, p);
+        st = using_params(
+            and_then(preamble_st,
+                     cond(mk_is_qfbv_probe(), 
+                          mk_qfbv_tactic(m), 
+                          mk_smt_tactic(m, p))),
+            main_p);
+    }
 
     st->updt_params(p);
     return st;
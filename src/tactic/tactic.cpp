@@ -19,8 +19,10 @@ Notes:
 #include<iomanip>
 #include "tactic/tactic.h"
 #include "tactic/probe.h"
+#include "tactic/tactic_profiler.h"
 #include "util/stopwatch.h"
 #include "model/model_v2_pp.h"
+#include "params/tactic_params.hpp"
 
 
 struct tactic_report::imp {
@@ -161,8 +163,10 @@ tactic * mk_fail_if_undecided_tactic() {
 
 void exec(tactic & t, goal_ref const & in, goal_ref_buffer & result) {
     t.reset_statistics();
+    tactic_params tp;
+    tactic_profiler::session _profile(tp.profile(), tp.profile_format());
     try {
-        t(in, result);
+        tactic_profiler::apply(t, in, result);
         t.cleanup();
     }
     catch (tactic_exception & ex) {
@@ -0,0 +1,212 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    tactic_profiler.cpp
+
+Abstract:
+
+    Profile of the tactic invocations of a tactic pipeline.
+
+--*/
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include "util/mutex.h"
+#include "util/warning.h"
+#include "tactic/tactic_profiler.h"
+
+namespace {
+
+    struct profile_node {
+        std::string m_name;
+        unsigned    m_parent;
+        unsigned    m_thread;
+        double      m_start = 0;          // seconds since the start of the profile
+        double      m_time = 0;           // seconds
+        double      m_memory = 0;         // change of allocated memory in megabytes
+        unsigned    m_size_before = 0;    // expressions of the input goal
+        unsigned    m_size_after = 0;     // expressions of the subgoals
+        unsigned    m_goals = 0;
+        bool        m_failed = true;      // cleared when the tactic returns
+    };
+
+    typedef std::chrono::steady_clock clock;
+
+    mutex                       g_mux;
+    std::atomic<bool>           g_enabled(false);
+    unsigned                    g_session = 0;
+    unsigned                    g_num_threads = 0;
+    unsigned                    g_main_current = UINT_MAX;   // innermost node of the thread that started the profile
+    clock::time_point           g_start;
+    vector<profile_node>        g_nodes;
+
+    thread_local unsigned       t_session = 0;
+    thread_local unsigned       t_thread = 0;
+    thread_local unsigned       t_current = UINT_MAX;
+
+    double elapsed() {
+        return std::chrono::duration<double>(clock::now() - g_start).count();
+    }
+
+    double allocated_mb() {
+        return static_cast<double>(memory::get_allocation_size()) / static_cast<double>(1024 * 1024);
+    }
+
+    // g_mux is held by caller.
+    void attach_thread() {
+        if (t_session == g_session)
+            return;
+        t_session = g_session;
+        t_thread = g_num_threads++;
+        t_current = UINT_MAX;
+    }
+
+    class scoped_node {
+        unsigned m_idx;
+        unsigned m_prev;        // innermost node of the thread before this one
+        double   m_memory;
+    public:
+        scoped_node(tactic & t, goal const & g): m_memory(allocated_mb()) {
+            unsigned size = g.num_exprs();
+            lock_guard lock(g_mux);
+            attach_thread();
+            m_idx = g_nodes.size();
+            m_prev = t_current;
+            profile_node n;
+            n.m_name = t.name();
+            n.m_parent = t_thread == 0 || t_current != UINT_MAX ? t_current : g_main_current;
+            n.m_thread = t_thread;
+            n.m_start = elapsed();
+            n.m_size_before = size;
+            g_nodes.push_back(n);
+            t_current = m_idx;
+            if (t_thread == 0)
+                g_main_current = m_idx;
+        }
+
+        void done(goal_ref_buffer const & result) {
+            unsigned size = 0;
+            for (goal* g : result)
+                size += g->num_exprs();
+            lock_guard lock(g_mux);
+            profile_node & n = g_nodes[m_idx];
+            n.m_size_after = size;
+            n.m_goals = result.size();
+            n.m_failed = false;
+        }
+
+        ~scoped_node() {
+            double memory = allocated_mb();
+            lock_guard lock(g_mux);
+            profile_node & n = g_nodes[m_idx];
+            n.m_time = elapsed() - n.m_start;
+            n.m_memory = memory - m_memory;
+            t_current = m_prev;
+            if (n.m_thread == 0)
+                g_main_current = m_prev;
+        }
+    };
+
+    void display_fields(std::ostream & out, profile_node const & n) {
+        out << "\"memory\": " << n.m_memory
+            << ", \"size-before\": " << n.m_size_before
+            << ", \"size-after\": " << n.m_size_after
+            << ", \"goals\": " << n.m_goals
+            << ", \"failed\": " << (n.m_failed ? "true" : "false");
+    }
+
+    void display_json(std::ostream & out) {
+        vector<unsigned_vector> children(g_nodes.size() + 1);
+        for (unsigned i = 0; i < g_nodes.size(); ++i) {
+            unsigned p = g_nodes[i].m_parent;
+            children[p == UINT_MAX ? g_nodes.size() : p].push_back(i);
+        }
+        std::function<void(unsigned, unsigned)> display_node = [&](unsigned i, unsigned indent) {
+            profile_node const & n = g_nodes[i];
+            std::string pad(indent, ' ');
+            out << pad << "{\"name\": \"" << n.m_name << "\", \"thread\": " << n.m_thread
+                << ", \"start\": " << n.m_start << ", \"time\": " << n.m_time << ", ";
+            display_fields(out, n);
+            out << ", \"children\": [";
+            auto const & cs = children[i];
+            for (unsigned j = 0; j < cs.size(); ++j) {
+                out << (j == 0 ? "\n" : ",\n");
+                display_node(cs[j], indent + 2);
+            }
+            if (!cs.empty())
+                out << "\n" << pad;
+            out << "]}";
+        };
+        out << "{\"tactics\": [";
+        auto const & roots = children.back();
+        for (unsigned j = 0; j < roots.size(); ++j) {
+            out << (j == 0 ? "\n" : ",\n");
+            display_node(roots[j], 2);
+        }
+        out << "\n]}\n";
+    }
+
+    void display_chrome_trace(std::ostream & out) {
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        for (unsigned i = 0; i < g_nodes.size(); ++i) {
+            profile_node const & n = g_nodes[i];
+            out << (i == 0 ? "\n" : ",\n");
+            out << "{\"name\": \"" << n.m_name << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << n.m_thread
+                << ", \"ts\": " << static_cast<unsigned long long>(n.m_start * 1000000)
+                << ", \"dur\": " << static_cast<unsigned long long>(n.m_time * 1000000) << ", \"args\": {";
+            display_fields(out, n);
+            out << "}}";
+        }
+        out << "\n]}\n";
+    }
+}
+
+void tactic_profiler::apply(tactic & t, goal_ref const & in, goal_ref_buffer & result) {
+    if (!g_enabled) {
+        t(in, result);
+        return;
+    }
+    scoped_node n(t, *in);
+    t(in, result);
+    n.done(result);
+}
+
+tactic_profiler::session::session(symbol const & file, symbol const & format) {
+    if (file.is_null() || file == symbol(""))
+        return;
+    if (format != "json" && format != "chrome")
+        throw default_exception("unknown tactic profile format " + format.str() + ", expected json or chrome");
+    lock_guard lock(g_mux);
+    if (g_enabled)
+        return;
+    m_active = true;
+    m_file = file.str();
+    m_format = format;
+    g_nodes.clear();
+    ++g_session;
+    g_num_threads = 0;
+    g_main_current = UINT_MAX;
+    attach_thread();
+    g_start = clock::now();
+    g_enabled = true;
+}
+
+tactic_profiler::session::~session() {
+    if (!m_active)
+        return;
+    lock_guard lock(g_mux);
+    g_enabled = false;
+    std::ofstream out(m_file);
+    if (!out) {
+        warning_msg("could not open %s to write the tactic profile", m_file.c_str());
+        return;
+    }
+    if (m_format == "chrome")
+        display_chrome_trace(out);
+    else
+        display_json(out);
+}
@@ -0,0 +1,52 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    tactic_profiler.h
+
+Abstract:
+
+    Profile of the tactic invocations of a tactic pipeline.
+
+    With tactic.profile set to a file name, exec records a tree of the
+    tactics it runs: every application of a tactic to a goal, including
+    the applications by the combinators of tactical.cpp, is a node with
+    the wall time, the change of allocated memory, and the size of the
+    goal before and of the subgoals after the application. The tree is
+    written to the file when the outermost exec returns, either as JSON
+    or, with tactic.profile_format=chrome, in the Chrome trace event
+    format.
+
+    Applications on the threads of parallel tacticals are children of
+    the innermost application running on the thread that started the
+    profile. Allocated memory is counted for the whole process, so the
+    memory change of parallel applications includes their siblings.
+
+--*/
+#pragma once
+
+#include "tactic/tactic.h"
+
+class tactic_profiler {
+public:
+    /**
+       \brief apply t to in, recording the application if a profile is
+       being recorded.
+    */
+    static void apply(tactic & t, goal_ref const & in, goal_ref_buffer & result);
+
+    /**
+       \brief record a profile while the session is alive, if file is not
+       empty and no other profile is being recorded, and write it to file
+       on destruction.
+    */
+    class session {
+        bool        m_active = false;
+        std::string m_file;
+        symbol      m_format;
+    public:
+        session(symbol const & file, symbol const & format);
+        ~session();
+    };
+};
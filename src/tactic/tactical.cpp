@@ -19,6 +19,8 @@ Notes:
 #include "util/scoped_timer.h"
 #include "util/cancel_eh.h"
 #include "util/scoped_ptr_vector.h"
+#include "util/thread_pool.h"
+#include "tactic/tactic_profiler.h"
 #include "tactic/tactical.h"
 #include "tactic/goal_proof_converter.h"
 #ifndef SINGLE_THREAD
@@ -110,7 +112,7 @@ public:
 
         ast_manager & m = in->m();                                                                         
         goal_ref_buffer r1;
-        m_t1->operator()(in, r1);
+        tactic_profiler::apply(*m_t1, in, r1);
         unsigned r1_size = r1.size();                                                                       
         SASSERT(r1_size > 0);  
         if (r1_size == 1) {                                                                                 
@@ -119,14 +121,14 @@ public:
                 return;
             }                                                                                               
             goal_ref r1_0 = r1[0];      
-            m_t2->operator()(r1_0, result);
+            tactic_profiler::apply(*m_t2, r1_0, result);
         }
         else {
             goal_ref_buffer r2;
             for (unsigned i = 0; i < r1_size; i++) {                                                        
                 goal_ref g = r1[i];                                                                       
                 r2.reset();
-                m_t2->operator()(g, r2);
+                tactic_profiler::apply(*m_t2, g, r2);
                 if (is_decided(r2)) {
                     SASSERT(r2.size() == 1);
                     if (is_decided_sat(r2)) {                                                          
@@ -195,6 +197,14 @@ public:
         m_t2->user_propagate_register_diseq(diseq_eh);
     }
 
+    void user_propagate_register_batch(user_propagator::batch_eh_t& batch_eh) override {
+        m_t2->user_propagate_register_batch(batch_eh);
+    }
+
+    void user_propagate_register_native(user_propagator::native* p) override {
+        m_t2->user_propagate_register_native(p);
+    }
+
     void user_propagate_register_expr(expr* e) override {
         m_t1->user_propagate_register_expr(e);
         m_t2->user_propagate_register_expr(e);
@@ -339,7 +349,7 @@ public:
             SASSERT(sz > 0);
             if (i < sz - 1) {
                 try {
-                    t->operator()(in, result);
+                    tactic_profiler::apply(*t, in, result);
                     return;
                 }
                 catch (tactic_exception &) {
@@ -369,11 +379,14 @@ public:
                 }
             }
             else {
-                t->operator()(in, result);
+                tactic_profiler::apply(*t, in, result);
                 return;
             }
             in->reset_all();
-            in->copy_from(orig);
+            if (i + 2 < sz)
+                in->copy_from(orig);
+            else
+                in->move_from(orig);    // orig is not needed for the last alternative
         }
     }
 
@@ -453,6 +466,15 @@ enum par_exception_kind {
     ERROR_EX
 };
 
+// the workers of parallel tacticals share the manager of the input read-only.
+class scoped_freeze {
+    ast_manager& m;
+    bool         m_frozen;
+public:
+    scoped_freeze(ast_manager& m): m(m), m_frozen(m.is_frozen()) { m.freeze(true); }
+    ~scoped_freeze() { m.freeze(m_frozen); }
+};
+
 class par_tactical : public or_else_tactical {
 
 	std::string        ex_msg;
@@ -481,14 +503,11 @@ public:
 
         scoped_ptr_vector<ast_manager> managers;
         scoped_limits scl(m.limit());
-        goal_ref_vector                in_copies;
         tactic_ref_vector              ts;
         unsigned sz = m_ts.size();
         for (unsigned i = 0; i < sz; i++) {
             ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
             managers.push_back(new_m);
-            ast_translation translator(m, *new_m);
-            in_copies.push_back(in->translate(translator));
             ts.push_back(m_ts.get(i)->translate(*new_m));
             scl.push_child(&new_m->limit());
         }
@@ -497,14 +516,31 @@ public:
         par_exception_kind ex_kind = DEFAULT_EX;
 
         std::mutex         mux;
+        vector<goal_ref>   in_copies(sz);
+        scoped_ptr_vector<goal_ref_buffer> results;
+        results.resize(sz);
+
+        // translating dependencies marks them, so goals with dependencies
+        // are copied before the workers run.
+        if (in->unsat_core_enabled()) {
+            for (unsigned i = 0; i < sz; ++i) {
+                ast_translation translator(m, *(managers[i]));
+                in_copies[i] = in->translate(translator);
+            }
+        }
 
+        // the workers only read m: each copies the goal into its own manager.
         auto worker_thread = [&](unsigned i) {
             goal_ref_buffer     _result;                        
-            goal_ref in_copy = in_copies[i];
             tactic & t = *(ts.get(i));
             
             try {
-                t(in_copy, _result);
+                if (!in_copies[i]) {
+                    ast_translation translator(m, *(managers[i]));
+                    in_copies[i] = in->translate(translator);
+                }
+                goal_ref in_copy = in_copies[i];
+                tactic_profiler::apply(t, in_copy, _result);
                 bool first = false;
                 {
                     std::lock_guard<std::mutex> lock(mux);
@@ -519,13 +555,9 @@ public:
                             managers[j]->limit().cancel();
                         }
                     }
-                    
-                    ast_translation translator(*(managers[i]), m, false);
-                    for (goal* g : _result) {
-                        result.push_back(g->translate(translator));
-                    }
-                    goal_ref in2(in_copy->translate(translator));
-                    in->copy_from(*(in2.get()));
+                    goal_ref_buffer * r = alloc(goal_ref_buffer);
+                    r->append(_result.size(), _result.data());
+                    results.set(i, r);
                 }
             }
             catch (tactic_exception & ex) {
@@ -548,15 +580,21 @@ public:
             }
         };
 
-        vector<std::thread> threads(sz);
-
-        for (unsigned i = 0; i < sz; ++i) {
-            threads[i] = std::thread([&, i]() { worker_thread(i); });
-        }
-        for (unsigned i = 0; i < sz; ++i) {
-            threads[i].join();
+        {
+            scoped_freeze _freeze(m);
+            thread_pool::run(sz, worker_thread);
         }
         
+        if (finished_id != UINT_MAX) {
+            ast_translation translator(*(managers[finished_id]), m, false);
+            for (goal* g : *results[finished_id]) 
+                result.push_back(g->translate(translator));
+            goal_ref in2(in_copies[finished_id]->translate(translator));
+            in->move_from(*(in2.get()));
+        }
+        results.reset();
+        in_copies.reset();
+
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
             case ERROR_EX: throw z3_error(error_code);
@@ -631,7 +669,7 @@ public:
 
         ast_manager & m = in->m();                                                                          
         goal_ref_buffer r1;
-        m_t1->operator()(in, r1);                
+        tactic_profiler::apply(*m_t1, in, r1);                
         unsigned r1_size = r1.size();                                                                               
         SASSERT(r1_size > 0);                                                                               
         if (r1_size == 1) {                                                                                 
@@ -641,20 +679,24 @@ public:
                 return;
             }                                                                                               
             goal_ref r1_0 = r1[0];                                                                          
-            m_t2->operator()(r1_0, result);
+            tactic_profiler::apply(*m_t2, r1_0, result);
         }                                                                                     
         else {                                                                                              
 
             scoped_ptr_vector<ast_manager> managers;
             tactic_ref_vector              ts2;
-            goal_ref_vector                g_copies;
+            vector<goal_ref>               g_copies(r1_size);
 
             for (unsigned i = 0; i < r1_size; i++) {
                 ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
                 managers.push_back(new_m);
-                ast_translation translator(m, *new_m);
-                g_copies.push_back(r1[i]->translate(translator));
                 ts2.push_back(m_t2->translate(*new_m));
+                // translating dependencies marks them, so goals with
+                // dependencies are copied before the workers run.
+                if (cores_enabled) {
+                    ast_translation translator(m, *new_m);
+                    g_copies[i] = r1[i]->translate(translator);
+                }
             }
 
             scoped_ptr_vector<expr_dependency_ref> core_buffer;
@@ -664,22 +706,27 @@ public:
             goals_vect.resize(r1_size);
 
             bool found_solution = false;
+            unsigned solution_id = UINT_MAX;
             bool failed         = false;
             par_exception_kind ex_kind = DEFAULT_EX;
             unsigned error_code = 0;
             std::string  ex_msg;
             std::mutex mux;
 
+            // the workers only read m: each copies its subgoal into its own manager.
             auto worker_thread = [&](unsigned i) {
                 ast_manager & new_m = *(managers[i]);
-                goal_ref new_g = g_copies[i];
-
                 goal_ref_buffer r2;
                 
                 bool curr_failed = false;
 
                 try {
-                    ts2[i]->operator()(new_g, r2);                  
+                    if (!g_copies[i]) {
+                        ast_translation translator(m, new_m);
+                        g_copies[i] = r1[i]->translate(translator);
+                    }
+                    goal_ref new_g = g_copies[i];
+                    tactic_profiler::apply(*ts2[i], new_g, r2);                  
                 }
                 catch (tactic_exception & ex) {
                     {
@@ -733,6 +780,7 @@ public:
                                 if (!found_solution) {
                                     failed         = false;
                                     found_solution = true;
+                                    solution_id    = i;
                                     first          = true;
                                 }
                             }
@@ -742,9 +790,10 @@ public:
                                         managers[j]->limit().cancel();
                                     }
                                 }
-                                ast_translation translator(new_m, m, false);
                                 SASSERT(r2.size() == 1);
-                                result.push_back(r2[0]->translate(translator));                                
+                                goal_ref_buffer * new_r2 = alloc(goal_ref_buffer);
+                                goals_vect.set(i, new_r2);
+                                new_r2->push_back(r2[0]);
                             }       
                         }                                                     
                         else {                                                                                  
@@ -761,12 +810,6 @@ public:
                         goal_ref_buffer * new_r2 = alloc(goal_ref_buffer);
                         goals_vect.set(i, new_r2);
                         new_r2->append(r2.size(), r2.data());
-                        dependency_converter* dc = r1[i]->dc();                           
-                        if (cores_enabled && dc) {
-                            expr_dependency_ref * new_dep = alloc(expr_dependency_ref, new_m);
-                            *new_dep = (*dc)();
-                            core_buffer.set(i, new_dep);
-                        }
                     }                                                                                           
                 }
             };
@@ -774,12 +817,9 @@ public:
             if (m.has_trace_stream())
                 throw default_exception("threads and trace are incompatible");
 
-            vector<std::thread> threads(r1_size);
-            for (unsigned i = 0; i < r1_size; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
-            for (unsigned i = 0; i < r1_size; ++i) {
-                threads[i].join();
+            {
+                scoped_freeze _freeze(m);
+                thread_pool::run(r1_size, worker_thread);
             }
             
             if (failed) {
@@ -791,13 +831,19 @@ public:
                 }
             }
 
-            if (found_solution)
+            if (found_solution) {
+                ast_translation translator(*(managers[solution_id]), m, false);
+                result.push_back((*goals_vect[solution_id])[0]->translate(translator));
                 return;
+            }
             
             expr_dependency_ref core(m);
             for (unsigned i = 0; i < r1_size; i++) {
                 ast_translation translator(*(managers[i]), m, false);
                 goal_ref_buffer * r = goals_vect[i];
+                dependency_converter* dc = r1[i]->dc();
+                if (cores_enabled && dc && r != nullptr) 
+                    core = m.mk_join((*dc)(), core);
                 unsigned j = result.size();
                 if (r != nullptr) {
                     for (unsigned k = 0; k < r->size(); k++) {
@@ -871,7 +917,7 @@ public:
     }
 
     void operator()(goal_ref const & in, goal_ref_buffer& result) override { 
-        m_t->operator()(in, result);
+        tactic_profiler::apply(*m_t, in, result);
     }
    
     void cleanup(void) override { m_t->cleanup(); }
@@ -919,7 +965,7 @@ class repeat_tactical : public unary_tactical {
         {
             goal orig_in(g->m(), proofs_enabled, models_enabled, cores_enabled);
             orig_in.copy_from(*(g.get()));
-            m_t->operator()(g, r1);                                                            
+            tactic_profiler::apply(*m_t, g, r1);                                                            
             if (r1.size() == 1 && is_equal(orig_in, *(r1[0]))) {
                 result.push_back(r1[0]);
                 return;                                                                                     
@@ -1005,7 +1051,7 @@ public:
     char const* name() const override { return "fail_if_branching"; }
 
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
-        m_t->operator()(in, result);
+        tactic_profiler::apply(*m_t, in, result);
         if (result.size() > m_threshold) {
             result.reset(); // assumes in is not strenthened to one of the branches
             throw tactic_exception("failed-if-branching tactical");
@@ -1029,7 +1075,7 @@ public:
     char const* name() const override { return "cleanup"; }
 
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
-        m_t->operator()(in, result);
+        tactic_profiler::apply(*m_t, in, result);
         m_t->cleanup();
     }    
 
@@ -1054,7 +1100,7 @@ public:
         cancel_eh<reslimit> eh(in->m().limit());
         { 
             scoped_timer timer(m_timeout, &eh);
-            m_t->operator()(in, result);            
+            tactic_profiler::apply(*m_t, in, result);            
         }
     }
 
@@ -1119,7 +1165,7 @@ public:
     
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
         scope _scope(m_name);
-        m_t->operator()(in, result);
+        tactic_profiler::apply(*m_t, in, result);
     }
 
     tactic * translate(ast_manager & m) override { 
@@ -1148,9 +1194,9 @@ public:
     
     void operator()(goal_ref const & in, goal_ref_buffer & result) override {
         if (m_p->operator()(*(in.get())).is_true()) 
-            m_t1->operator()(in, result);
+            tactic_profiler::apply(*m_t1, in, result);
         else
-            m_t2->operator()(in, result);
+            tactic_profiler::apply(*m_t2, in, result);
     }
 
     tactic * translate(ast_manager & m) override {
@@ -1211,7 +1257,7 @@ public:
             result.push_back(in.get());
         }
         else {
-            m_t->operator()(in, result);
+            tactic_profiler::apply(*m_t, in, result);
         }
     }
 
@@ -1229,7 +1275,7 @@ public:
             result.push_back(in.get());
         }
         else {
-            m_t->operator()(in, result);
+            tactic_profiler::apply(*m_t, in, result);
         }
     }
 
@@ -1247,7 +1293,7 @@ public:
             result.push_back(in.get());
         }
         else {
-            m_t->operator()(in, result);
+            tactic_profiler::apply(*m_t, in, result);
         }
     }
 
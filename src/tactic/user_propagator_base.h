@@ -3,6 +3,7 @@
 
 #include "ast/ast.h"
 #include "util/lbool.h"
+#include "util/trail.h"
 
 namespace user_propagator {
 
@@ -12,6 +13,43 @@ namespace user_propagator {
         virtual void propagate_cb(unsigned num_fixed, expr* const* fixed_ids, unsigned num_eqs, expr* const* eq_lhs, expr* const* eq_rhs, expr* conseq) = 0;
         virtual void register_cb(expr* e) = 0;
         virtual void next_split_cb(expr* e, unsigned idx, lbool phase) = 0;
+
+        /**
+           \brief current truth value of a registered Boolean expression.
+        */
+        virtual lbool get_value_cb(expr* e) { return l_undef; }
+
+        /**
+           \brief push an undo action on the trail of the solver. It is undone
+           when the solver backtracks over the current scope; the object is owned
+           by the caller and must stay alive until then.
+        */
+        virtual void push_trail_cb(trail* t) {}
+    };
+
+    /**
+       \brief propagator implemented in C++ and linked into the process.
+       
+       The solver invokes the virtual methods directly instead of going
+       through the callbacks of the C API, and the methods receive the
+       callback interface of the solver for propagation, registration,
+       the assignment of registered Booleans and the trail.
+       The propagator is owned by the caller; copies made by fresh are
+       owned by the solver that requested them.
+    */
+    class native {
+    public:
+        virtual ~native() = default;
+        virtual void push(callback& cb) {}
+        virtual void pop(callback& cb, unsigned num_scopes) {}
+        virtual void fixed(callback& cb, expr* t, expr* value) {}
+        virtual void eq(callback& cb, expr* s, expr* t) {}
+        virtual void diseq(callback& cb, expr* s, expr* t) {}
+        virtual void final(callback& cb) {}
+        virtual void created(callback& cb, expr* t) {}
+        virtual bool use_diseqs() const { return false; }
+        // propagator for a solver on a different manager, nullptr if it cannot be copied.
+        virtual native* fresh(ast_manager& m) { return nullptr; }
     };
     
     class context_obj {
@@ -28,6 +66,7 @@ namespace user_propagator {
     typedef std::function<void(void*, callback*, expr*)>                     created_eh_t;
     typedef std::function<void(void*, callback*, expr**, unsigned*, lbool*)> decide_eh_t;
     typedef std::function<void(void*, expr*, unsigned, expr* const*)>        on_clause_eh_t;
+    typedef std::function<void(void*, callback*, unsigned, expr* const*, expr* const*, unsigned, expr* const*, expr* const*)> batch_eh_t;
 
     class plugin : public decl_plugin {
     public:
@@ -79,11 +118,24 @@ namespace user_propagator {
         virtual void user_propagate_register_diseq(eq_eh_t& diseq_eh) {
             throw default_exception("user-propagators are only supported on the SMT solver");
         }
+
+        /**
+           \brief deliver the fixed and equality events collected since the
+           last delivery in one call, instead of one call per event.
+           The batch replaces the fixed and eq callbacks.
+        */
+        virtual void user_propagate_register_batch(batch_eh_t& batch_eh) {
+            throw default_exception("user-propagators are only supported on the SMT solver");
+        }
         
         virtual void user_propagate_register_expr(expr* e) { 
             throw default_exception("user-propagators are only supported on the SMT solver");
         }
 
+        virtual void user_propagate_register_native(native* p) {
+            throw default_exception("native user-propagators are only supported on the SMT solver");
+        }
+
         virtual void user_propagate_register_created(created_eh_t& r) {
             throw default_exception("user-propagators are only supported on the SMT solver");
         }
@@ -106,8 +106,113 @@ static void test_mk_distinct() {
     
 }
 
+static void test_assert_vector() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_sort int_sort = Z3_mk_int_sort(ctx);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), int_sort);
+    Z3_ast_vector v = Z3_mk_ast_vector(ctx);
+    Z3_ast_vector_inc_ref(ctx, v);
+    for (int i = 0; i < 100; ++i)
+        Z3_ast_vector_push(ctx, v, Z3_mk_gt(ctx, x, Z3_mk_int(ctx, i, int_sort)));
+    Z3_solver_assert_vector(ctx, s, v);
+    Z3_ast_vector fmls = Z3_solver_get_assertions(ctx, s);
+    Z3_ast_vector_inc_ref(ctx, fmls);
+    ENSURE(Z3_ast_vector_size(ctx, fmls) == 100);
+    Z3_ast_vector_dec_ref(ctx, fmls);
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+    Z3_ast_vector_push(ctx, v, Z3_mk_lt(ctx, x, Z3_mk_int(ctx, 50, int_sort)));
+    Z3_solver_assert_vector(ctx, s, v);
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_FALSE);
+    Z3_ast_vector_dec_ref(ctx, v);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_config(cfg);
+    Z3_del_context(ctx);
+}
+
+static void test_bulk_export() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_sort int_sort = Z3_mk_int_sort(ctx);
+    for (int i = 0; i < 10; ++i) {
+        Z3_ast x = Z3_mk_const(ctx, Z3_mk_int_symbol(ctx, i), int_sort);
+        Z3_solver_assert(ctx, s, Z3_mk_eq(ctx, x, Z3_mk_int(ctx, i, int_sort)));
+    }
+    Z3_ast_vector fmls = Z3_solver_get_assertions(ctx, s);
+    Z3_ast_vector_inc_ref(ctx, fmls);
+    Z3_ast asts[10];
+    Z3_ast_vector_to_array(ctx, fmls, 10, asts);
+    for (unsigned i = 0; i < 10; ++i)
+        ENSURE(asts[i] == Z3_ast_vector_get(ctx, fmls, i));
+    Z3_ast_vector_dec_ref(ctx, fmls);
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+    Z3_model m = Z3_solver_get_model(ctx, s);
+    Z3_model_inc_ref(ctx, m);
+    unsigned n = Z3_model_get_num_consts(ctx, m);
+    ENSURE(n == 10);
+    Z3_func_decl decls[10];
+    Z3_ast values[10];
+    Z3_model_get_const_interps(ctx, m, n, decls, values);
+    for (unsigned i = 0; i < n; ++i) {
+        ENSURE(decls[i] == Z3_model_get_const_decl(ctx, m, i));
+        ENSURE(values[i] == Z3_model_get_const_interp(ctx, m, decls[i]));
+    }
+    uint64_t nums[10];
+    ENSURE(Z3_model_eval_to_uint64_array(ctx, m, n, values, true, nums));
+    Z3_ast consts[2] = { Z3_mk_const(ctx, Z3_mk_int_symbol(ctx, 3), int_sort), Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "y"), int_sort) };
+    ENSURE(!Z3_model_eval_to_uint64_array(ctx, m, 2, consts, false, nums));
+    ENSURE(nums[0] == 3 && nums[1] == 0);
+    Z3_model_dec_ref(ctx, m);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_config(cfg);
+    Z3_del_context(ctx);
+}
+
+static void test_hints() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_sort bool_sort = Z3_mk_bool_sort(ctx);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), bool_sort);
+    Z3_ast y = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "y"), bool_sort);
+    Z3_ast x_or_y[2] = { x, y };
+    Z3_solver s = Z3_mk_simple_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_solver_assert(ctx, s, x);
+    Z3_solver_assert(ctx, s, Z3_mk_not(ctx, y));
+    ENSURE(Z3_solver_check(ctx, s) == Z3_L_TRUE);
+    Z3_ast_vector hints = Z3_solver_export_hints(ctx, s);
+    Z3_ast_vector_inc_ref(ctx, hints);
+    ENSURE(Z3_ast_vector_size(ctx, hints) > 0);
+
+    // a modified problem starts from the phases of the first one
+    Z3_solver t = Z3_mk_simple_solver(ctx);
+    Z3_solver_inc_ref(ctx, t);
+    Z3_solver_assert(ctx, t, Z3_mk_or(ctx, 2, x_or_y));
+    Z3_solver_import_hints(ctx, t, hints);
+    ENSURE(Z3_solver_check(ctx, t) == Z3_L_TRUE);
+    Z3_model m = Z3_solver_get_model(ctx, t);
+    Z3_model_inc_ref(ctx, m);
+    Z3_ast v = nullptr;
+    ENSURE(Z3_model_eval(ctx, m, x, true, &v));
+    std::cout << "x = " << Z3_ast_to_string(ctx, v) << "\n";
+    Z3_model_dec_ref(ctx, m);
+
+    Z3_ast_vector_dec_ref(ctx, hints);
+    Z3_solver_dec_ref(ctx, t);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_config(cfg);
+    Z3_del_context(ctx);
+}
+
 void tst_api() {
     test_apps();
     test_bvneg();
     test_mk_distinct();
+    test_assert_vector();
+    test_bulk_export();
+    test_hints();
 }
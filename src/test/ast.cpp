@@ -17,6 +17,8 @@ Revision History:
 
 --*/
 #include "ast/ast.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
 
 static void tst1() {
     ast_manager m;
@@ -131,6 +133,51 @@ static void tst5() {
     m.del(arr3);
 }
 
+static void tst6() {
+    ast_manager m;
+    sort_ref b(m.mk_bool_sort(), m);
+    expr_ref a(m.mk_const(symbol("a"), b.get()), m);
+    unsigned num_asts = m.get_num_asts();
+    {
+        scoped_ast_generation g(m);
+        expr* n1 = nullptr;
+        {
+            expr_ref t(m.mk_not(a), m);
+            n1 = t;
+        }
+        // the released node is kept and found again
+        expr_ref t(m.mk_not(a), m);
+        ENSURE(t.get() == n1);
+        t = nullptr;
+        {
+            scoped_ast_generation g2(m);
+            expr_ref u(m.mk_and(a, m.mk_not(a)), m);
+        }
+        ENSURE(m.get_num_asts() == num_asts + 1);
+    }
+    ENSURE(m.get_num_asts() == num_asts);
+}
+
+static void tst7() {
+    ast_manager m;
+    reg_decl_plugins(m, true);
+    family_id bv_fid = m.get_family_id("bv");
+    family_id seq_fid = m.get_family_id("seq");
+    ENSURE(bv_fid != null_family_id && seq_fid != null_family_id);
+    unsigned num_asts = m.get_num_asts();
+    bv_util bv(m);
+    // bv_util requests the bv plugin, which creates its sorts and decls
+    ENSURE(m.get_num_asts() > num_asts);
+    num_asts = m.get_num_asts();
+    expr_ref x(m.mk_const(symbol("x"), bv.mk_sort(8)), m);
+    expr_ref t(bv.mk_bv_add(x, bv.mk_numeral(1, 8)), m);
+    ENSURE(bv.is_bv_add(t));
+    ast_manager m2(m, false);
+    ENSURE(m2.get_family_id("bv") == bv_fid);
+    ENSURE(m2.get_family_id("seq") == seq_fid);
+    ENSURE(m.has_plugin(seq_fid) && m2.has_plugin(seq_fid));
+    ENSURE(m.get_num_asts() > num_asts);
+}
 
 struct foo {
     unsigned       m_id; 
@@ -153,5 +200,7 @@ void tst_ast() {
     tst3();
     tst4();
     tst5();
+    tst6();
+    tst7();
 }
 
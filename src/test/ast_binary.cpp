@@ -0,0 +1,95 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+--*/
+
+#include "ast/ast_binary.h"
+#include "ast/ast_pp.h"
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include <iostream>
+#include <sstream>
+
+static void parse_fmls(ast_manager& m, char const* str, expr_ref_vector& result) {
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::istringstream is(str);
+    VERIFY(parse_smt2_commands(ctx, is));
+    for (expr* e : ctx.assertions())
+        result.push_back(e);
+}
+
+static char const* example =
+    "(declare-sort U 0)\n"
+    "(declare-fun f (U Int) U)\n"
+    "(declare-const u U)\n"
+    "(declare-const x Int)\n"
+    "(declare-const r Real)\n"
+    "(declare-const b (_ BitVec 8))\n"
+    "(declare-const s String)\n"
+    "(declare-const a (Array Int Real))\n"
+    "(assert (= (f u x) (f (f u 3) (- x 1))))\n"
+    "(assert (distinct u (f u 0) (f u 1)))\n"
+    "(assert (< (select a x) (/ 1 3)))\n"
+    "(assert (or (bvult b #x0a) (= ((_ extract 3 0) b) #b0101)))\n"
+    "(assert (= s (str.++ \"ab\\u{1F600}\" s)))\n"
+    "(assert (not (= r 2.5)))\n"
+    "(assert (forall ((y Int) (v U)) (! (=> (> y x) (= (f v y) v)) :pattern ((f v y)) :qid q1)))\n"
+    "(assert (exists ((y Int)) (and (> y 0) (< (* y y) x))))\n";
+
+static void tst_round_trip() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector fmls(m), loaded(m);
+    parse_fmls(m, example, fmls);
+    std::ostringstream out;
+    ast_binary_write(m, fmls.size(), fmls.data(), out);
+    std::string buffer = out.str();
+    ENSURE(is_ast_binary(buffer.data(), buffer.size()));
+
+    // the same manager must produce the identical (hash-consed) expressions.
+    ast_binary_read(m, buffer.data(), buffer.size(), loaded);
+    ENSURE(loaded.size() == fmls.size());
+    for (unsigned i = 0; i < fmls.size(); ++i)
+        ENSURE(loaded.get(i) == fmls.get(i));
+
+    // a fresh manager must produce structurally equal expressions.
+    ast_manager m2;
+    reg_decl_plugins(m2);
+    expr_ref_vector loaded2(m2);
+    ast_binary_read(m2, buffer.data(), buffer.size(), loaded2);
+    ENSURE(loaded2.size() == fmls.size());
+    for (unsigned i = 0; i < fmls.size(); ++i) {
+        std::ostringstream s1, s2;
+        s1 << mk_pp(fmls.get(i), m);
+        s2 << mk_pp(loaded2.get(i), m2);
+        ENSURE(s1.str() == s2.str());
+    }
+}
+
+static void tst_malformed() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector fmls(m);
+    parse_fmls(m, example, fmls);
+    std::ostringstream out;
+    ast_binary_write(m, fmls.size(), fmls.data(), out);
+    std::string buffer = out.str();
+    for (size_t len : { (size_t)0, (size_t)3, buffer.size() / 2, buffer.size() - 1 }) {
+        expr_ref_vector loaded(m);
+        bool failed = false;
+        try {
+            ast_binary_read(m, buffer.data(), len, loaded);
+        }
+        catch (default_exception&) {
+            failed = true;
+        }
+        ENSURE(failed);
+    }
+}
+
+void tst_ast_binary() {
+    tst_round_trip();
+    tst_malformed();
+}
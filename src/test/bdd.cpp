@@ -391,6 +391,27 @@ public:
         }
     }
 
+    static void test_auto_reorder() {
+        std::cout << "test_auto_reorder\n";
+        // (x0 & x8) | (x1 & x9) | ... has exponential size in the initial order
+        unsigned const n = 8;
+        bdd_manager m(2 * n);
+        m.set_auto_reorder(true, 64);
+        bdd f = m.mk_false();
+        for (unsigned i = 0; i < n; ++i)
+            f = f || (m.mk_var(i) && m.mk_var(i + n));
+        bdd g = m.mk_false();
+        for (unsigned i = n; i-- > 0; )
+            g = g || (m.mk_var(i + n) && m.mk_var(i));
+        VERIFY(f == g);
+        for (unsigned i = 0; i < n; ++i)
+            VERIFY(f.cofactor(m.mk_var(i) && m.mk_var(i + n)).is_true());
+        statistics st;
+        m.collect_statistics(st);
+        st.display(std::cout);
+        VERIFY(m.m_stats.m_num_reorders > 0);
+    }
+
     static void test_fdd_twovars() {
         std::cout << "test_fdd_twovars\n";
         bdd_manager m(6);
@@ -527,6 +548,7 @@ void tst_bdd() {
     dd::test_bdd::test_fdd3();
     dd::test_bdd::test_fdd4();
     dd::test_bdd::test_fdd_reorder();
+    dd::test_bdd::test_auto_reorder();
     dd::test_bdd::test_fdd_twovars();
     dd::test_bdd::test_fdd_find_hint();
     dd::test_bdd::test_cofactor();
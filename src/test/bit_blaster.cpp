@@ -188,6 +188,30 @@ void tst_multiplier(ast_manager & m, bit_blaster & blaster) {
     ENSURE_INT(mdl, c, 7); // b111 * b001
 }
 
+static void tst_tree_multiplier(ast_manager & m, bit_blaster & blaster) {
+    unsigned const sz = 4;
+    expr_ref_vector a(m), b(m), c(m), c2(m), c3(m);
+    mk_bits(m, "a", sz, a);
+    mk_bits(m, "b", sz, b);
+    blaster.set_mul_tree_size(2);
+    blaster.mk_multiplier(sz, a.data(), b.data(), c);
+    // the circuit is shared between occurrences, also modulo commutativity.
+    blaster.mk_multiplier(sz, a.data(), b.data(), c2);
+    blaster.mk_multiplier(sz, b.data(), a.data(), c3);
+    ENSURE(c == c2 && c == c3);
+    blaster.set_mul_tree_size(UINT_MAX);
+    model mdl(m);
+    for (unsigned x = 0; x < (1u << sz); ++x) {
+        for (unsigned y = 0; y < (1u << sz); ++y) {
+            for (unsigned i = 0; i < sz; ++i) {
+                mdl.register_decl(to_app(a.get(i))->get_decl(), (x & (1 << i)) ? m.mk_true() : m.mk_false());
+                mdl.register_decl(to_app(b.get(i))->get_decl(), (y & (1 << i)) ? m.mk_true() : m.mk_false());
+            }
+            ENSURE_INT(mdl, c, (x * y) % (1u << sz));
+        }
+    }
+}
+
 void tst_le(ast_manager & m, unsigned sz) {
 //     expr_ref_vector a(m);
 //     expr_ref_vector b(m);
@@ -239,6 +263,7 @@ void tst_bit_blaster() {
 
     tst_adder(m, blaster);
     tst_multiplier(m, blaster);
+    tst_tree_multiplier(m, blaster);
     tst_le(m, 4);
     tst_eqs(m, 8);
     tst_sh(m, 4);
@@ -0,0 +1,56 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    canonical_hash.cpp
+
+Abstract:
+
+    Test the canonical hash of expressions.
+
+--*/
+#include "ast/canonical_hash.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+
+// f(x + 1) <= y in a fresh manager, with names and declaration order as given
+static hash128 hash_of(char const* f_name, char const* x_name, char const* y_name, bool y_first, bool swap, int k) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort* int_s = a.mk_int();
+    app_ref x(m), y(m);
+    if (y_first) {
+        y = m.mk_const(symbol(y_name), int_s);
+        x = m.mk_const(symbol(x_name), int_s);
+    }
+    else {
+        x = m.mk_const(symbol(x_name), int_s);
+        y = m.mk_const(symbol(y_name), int_s);
+    }
+    func_decl_ref f(m.mk_func_decl(symbol(f_name), int_s, int_s), m);
+    expr_ref fx(m.mk_app(f, a.mk_add(x, a.mk_int(k))), m);
+    expr_ref e(swap ? a.mk_le(y, fx) : a.mk_le(fx, y), m);
+    canonical_hash ch(m);
+    return ch(e);
+}
+
+void tst_canonical_hash() {
+    hash128 h = hash_of("f", "x", "y", false, false, 1);
+    ENSURE(h == hash_of("g", "u", "v", false, false, 1));
+    ENSURE(h == hash_of("f", "x", "y", true, false, 1));
+    ENSURE(h != hash_of("f", "x", "y", false, true, 1));
+    ENSURE(h != hash_of("f", "x", "y", false, false, 2));
+
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    canonical_hash ch1(m), ch2(m);
+    // x + y and y + x differ, their structure is the same
+    ENSURE(ch1(a.mk_add(x, y)) == ch2(a.mk_add(y, x)));
+    // within one object, x and y keep their numbers
+    ENSURE(ch1(a.mk_add(y, x)) != ch1(a.mk_add(x, y)));
+}
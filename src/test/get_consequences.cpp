@@ -109,7 +109,37 @@ void test2() {
 
 }
 
+// the core based backbone algorithm finds the same consequences as probing.
+static void test3() {
+    for (unsigned chunk : { 0u, 1u, 3u }) {
+        ast_manager m;
+        reg_decl_plugins(m);
+        params_ref p;
+        p.set_uint("backbone.chunk_size", chunk);
+        ref<solver> solver = mk_inc_sat_solver(m, p);
+        expr_ref a = mk_bool(m, "a"), b = mk_bool(m, "b"), c = mk_bool(m, "c");
+        expr_ref d = mk_bool(m, "d"), e = mk_bool(m, "e"), f = mk_bool(m, "f"), g = mk_bool(m, "g");
+        solver->assert_expr(m.mk_implies(a, b));
+        solver->assert_expr(m.mk_implies(b, c));
+        solver->assert_expr(m.mk_or(c, d));
+        solver->assert_expr(m.mk_or(m.mk_not(e), f));
+        solver->assert_expr(m.mk_not(g));
+        expr_ref_vector asms(m), vars(m), conseq(m);
+        asms.push_back(a);
+        vars.push_back(b);
+        vars.push_back(c);
+        vars.push_back(d);
+        vars.push_back(e);
+        vars.push_back(f);
+        vars.push_back(g);
+        VERIFY(l_true == solver->get_consequences(asms, vars, conseq));
+        std::cout << "chunk " << chunk << ": " << conseq << "\n";
+        ENSURE(conseq.size() == 3);
+    }
+}
+
 void tst_get_consequences() {
     test1();
     test2();
+    test3();
 }
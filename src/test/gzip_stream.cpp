@@ -0,0 +1,72 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    gzip_stream.cpp
+
+Abstract:
+
+    Test decompression of gzip compressed input streams.
+
+--*/
+#include "util/gzip_stream.h"
+#include "util/debug.h"
+#include <sstream>
+#ifdef Z3_ZLIB
+#include <zlib.h>
+#include <cstring>
+#endif
+
+#ifdef Z3_ZLIB
+static std::string gzip(std::string const & s) {
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    VERIFY(deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+    std::string out(deflateBound(&zs, static_cast<uLong>(s.size())), '\0');
+    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(s.data()));
+    zs.avail_in = static_cast<uInt>(s.size());
+    zs.next_out = reinterpret_cast<Bytef *>(&out[0]);
+    zs.avail_out = static_cast<uInt>(out.size());
+    VERIFY(deflate(&zs, Z_FINISH) == Z_STREAM_END);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+static std::string read_all(std::istream & in) {
+    std::ostringstream out;
+    out << in.rdbuf();
+    return out.str();
+}
+
+static void tst_roundtrip() {
+    std::string text;
+    for (unsigned i = 0; i < 20000; ++i)
+        text += "(assert (> x" + std::to_string(i) + " 0))\n";
+    // two concatenated members, read with small blocks
+    std::istringstream in(gzip(text) + gzip(text));
+    ENSURE(is_gzip_stream(in));
+    gzip_istream gis(in, 100);
+    ENSURE(read_all(gis) == text + text);
+    ENSURE(gis.error().empty());
+
+    std::string truncated = gzip(text);
+    truncated.resize(truncated.size() / 2);
+    std::istringstream tin(truncated);
+    gzip_istream tgis(tin);
+    ENSURE(read_all(tgis).size() < text.size());
+    ENSURE(!tgis.error().empty());
+}
+#endif
+
+void tst_gzip_stream() {
+    std::istringstream plain("(check-sat)");
+    ENSURE(!is_gzip_stream(plain));
+#ifdef Z3_ZLIB
+    ENSURE(gzip_supported());
+    tst_roundtrip();
+#else
+    ENSURE(!gzip_supported());
+#endif
+}
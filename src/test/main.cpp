@@ -156,6 +156,9 @@ int main(int argc, char ** argv) {
     TST(rational);
     TST(inf_rational);
     TST(ast);
+    TST(ast_binary);
+    TST(canonical_hash);
+    TST(gzip_stream);
     TST(optional);
     TST(bit_vector);
     TST(fixed_bit_vector);
@@ -164,9 +167,11 @@ int main(int argc, char ** argv) {
     TST(udoc_relation);
     TST(string_buffer);
     TST(map);
+    TST(swiss_map);
     TST(diff_logic);
     TST(uint_set);
     TST_ARGV(expr_rand);
+    TST_ARGV(rewriter_bench);
     TST(list);
     TST(small_object_allocator);
     TST(timeout);
@@ -215,6 +220,7 @@ int main(int argc, char ** argv) {
     TST(prime_generator);
     TST(permutation);
     TST(nlsat);
+    TST(nnf);
     TST(zstring);
     if (test_all) return 0;
     TST(ext_numeral);
@@ -261,6 +267,7 @@ int main(int argc, char ** argv) {
     TST(pdd_solver);
     TST(scoped_timer);
     TST(solver_pool);
+    TST(mus);
     //TST_ARGV(hs);
     TST(finder);
     TST(totalizer);
@@ -1,12 +1,131 @@
 #include "model/model.h"
 #include "model/model_evaluator.h"
+#include "model/model_batch_evaluator.h"
 #include "model/model_pp.h"
+#include "model/model_scratch.h"
 #include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
 #include "ast/reg_decl_plugins.h"
 #include "ast/ast_pp.h"
 #include <iostream>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
+
+// compare the compiled evaluation with the model evaluator
+static void tst_batch_evaluator() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    bv_util bv(m);
+    random_gen r(3);
+    expr_ref x(m.mk_const(symbol("x"), bv.mk_sort(8)), m);
+    expr_ref y(m.mk_const(symbol("y"), bv.mk_sort(8)), m);
+    expr_ref z(m.mk_const(symbol("z"), a.mk_int()), m);
+    expr_ref p(m.mk_const(symbol("p"), m.mk_bool_sort()), m);
+    expr_ref_vector es(m);
+    es.push_back(bv.mk_concat(bv.mk_bv_add(x, bv.mk_bv_mul(y, y)), bv.mk_extract(3, 0, bv.mk_bv_ashr(x, y))));
+    es.push_back(m.mk_ite(p, bv.mk_bv_udiv(x, y), bv.mk_bv_urem(x, y)));
+    es.push_back(m.mk_and(bv.mk_slt(x, y), m.mk_or(p, a.mk_le(a.mk_mul(z, z), a.mk_add(z, a.mk_int(7))))));
+    es.push_back(a.mk_sub(a.mk_mul(a.mk_int(3), z), a.mk_uminus(z)));
+    es.push_back(bv.mk_sign_extend(4, bv.mk_bv_shl(bv.mk_bv_not(x), y)));
+    unsigned const n = 100;
+    sref_vector<model> mdls;
+    ptr_vector<model> ms;
+    for (unsigned i = 0; i < n; ++i) {
+        model* mdl = alloc(model, m);
+        mdls.push_back(mdl);
+        ms.push_back(mdl);
+        mdl->register_decl(to_app(x)->get_decl(), bv.mk_numeral(r(256), 8));
+        mdl->register_decl(to_app(y)->get_decl(), bv.mk_numeral(r(10), 8));
+        mdl->register_decl(to_app(p)->get_decl(), r(2) ? m.mk_true() : m.mk_false());
+        // leave z unassigned in some models, they use the model evaluator
+        if (i % 10 != 0)
+            mdl->register_decl(to_app(z)->get_decl(), a.mk_int(static_cast<int>(r(2000)) - 1000));
+    }
+    for (expr* e : es) {
+        model_batch_evaluator ev(m, e);
+        ENSURE(ev.is_compiled());
+        expr_ref_vector vals(m);
+        ev(n, ms.data(), true, vals);
+        ENSURE(vals.size() == n);
+        for (unsigned i = 0; i < n; ++i) {
+            expr_ref v = (*ms[i])(e);
+            if (v != vals.get(i))
+                std::cout << mk_pp(e, m) << "\n" << v << " " << mk_pp(vals.get(i), m) << "\n";
+            ENSURE(v == vals.get(i));
+        }
+    }
+}
+
+static void tst_scratch_evaluator() {
+#ifndef SINGLE_THREAD
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    expr_ref e(a.mk_add(a.mk_mul(x, x), y), m);
+    model_ref mdl = alloc(model, m);
+    mdl->register_decl(to_app(x)->get_decl(), a.mk_int(3));
+    mdl->register_decl(to_app(y)->get_decl(), a.mk_int(4));
+    m.freeze(true);
+    bool_vector ok(4, false);
+    vector<std::thread> threads;
+    for (unsigned i = 0; i < ok.size(); ++i)
+        threads.push_back(std::thread([&, i]() {
+            model_scratch s(*mdl);
+            arith_util sa(s.get_manager());
+            rational r;
+            bool all = true;
+            for (unsigned j = 0; j < 50; ++j) {
+                expr_ref v = s.eval(e);
+                all &= sa.is_numeral(v, r) && r == 13;
+            }
+            ok[i] = all;
+        }));
+    for (auto& t : threads)
+        t.join();
+    m.freeze(false);
+    for (bool b : ok)
+        ENSURE(b);
+#endif
+}
+
+// lookups in a large interpretation go through the entry index
+static void tst_func_interp_index() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort* sI = a.mk_int();
+    expr_ref x(m.mk_const(symbol("x"), sI), m);
+    func_interp fi(m, 2);
+    for (int i = 0; i < 100; ++i) {
+        expr* args[2] = { a.mk_int(i), a.mk_int(i + 1) };
+        fi.insert_new_entry(args, a.mk_int(2 * i));
+    }
+    expr* args2[2] = { a.mk_int(7), a.mk_int(8) };
+    ENSURE(fi.get_entry(args2) && fi.get_entry(args2)->get_result() == a.mk_int(14));
+    expr* args3[2] = { a.mk_int(7), a.mk_int(9) };
+    ENSURE(!fi.get_entry(args3));
+    ENSURE(fi.has_no_entry(args3) && !fi.has_no_entry(args2));
+    // entries with arguments that are not values are found by the scan
+    expr* args4[2] = { x, a.mk_int(3) };
+    fi.insert_new_entry(args4, a.mk_int(-1));
+    ENSURE(fi.get_entry(args4) && fi.get_entry(args4)->get_result() == a.mk_int(-1));
+    ENSURE(!fi.has_no_entry(args3));
+    fi.insert_entry(args2, a.mk_int(0));
+    ENSURE(fi.get_entry(args2)->get_result() == a.mk_int(0));
+    ENSURE(fi.num_entries() == 101);
+    fi.del_entry(0);
+    expr* args5[2] = { a.mk_int(99), a.mk_int(100) };
+    ENSURE(fi.get_entry(args5) && fi.get_entry(args5)->get_result() == a.mk_int(198));
+}
 
 void tst_model_evaluator() {
+    tst_batch_evaluator();
+    tst_func_interp_index();
+    tst_scratch_evaluator();
     ast_manager m;
     reg_decl_plugins(m);
     arith_util a(m);
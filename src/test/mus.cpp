@@ -0,0 +1,63 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    mus.cpp
+
+Abstract:
+
+    Test MUS extraction, sequential and parallel.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/ast_util.h"
+#include "ast/ast_pp.h"
+#include "solver/solver.h"
+#include "solver/mus.h"
+#include "smt/smt_solver.h"
+#include <iostream>
+
+static bool is_minimal(solver& s, expr_ref_vector const& core) {
+    if (s.check_sat(core) != l_false)
+        return false;
+    for (unsigned i = 0; i < core.size(); ++i) {
+        expr_ref_vector sub(core.get_manager());
+        for (unsigned j = 0; j < core.size(); ++j)
+            if (i != j)
+                sub.push_back(core.get(j));
+        if (s.check_sat(sub) != l_true)
+            return false;
+    }
+    return true;
+}
+
+static void tst_mus(unsigned num_threads) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    ref<solver> s = mk_smt_solver(m, p, symbol::null);
+    expr_ref_vector lits(m);
+    for (unsigned i = 0; i < 60; ++i)
+        lits.push_back(m.mk_fresh_const("a", m.mk_bool_sort()));
+    // two overlapping conflicts and some noise
+    s->assert_expr(m.mk_or(mk_not(m, lits.get(3)), mk_not(m, lits.get(17)), mk_not(m, lits.get(42))));
+    s->assert_expr(m.mk_or(mk_not(m, lits.get(42)), mk_not(m, lits.get(51))));
+    s->assert_expr(m.mk_or(lits.get(7), lits.get(8)));
+    s->assert_expr(m.mk_implies(lits.get(20), lits.get(21)));
+
+    mus ms(*s);
+    ms.set_num_threads(num_threads);
+    ms.add_soft(lits.size(), lits.data());
+    expr_ref_vector core(m);
+    ENSURE(ms.get_mus(core) == l_true);
+    std::cout << "threads " << num_threads << " mus " << core << "\n";
+    ENSURE(core.size() == 2 || core.size() == 3);
+    ENSURE(is_minimal(*s, core));
+}
+
+void tst_mus() {
+    tst_mus(1);
+    tst_mus(4);
+}
@@ -10,6 +10,7 @@
 #include "tactic/tactic.h"
 #include "tactic/bv/bit_blaster_tactic.h"
 #include <iostream>
+#include <sstream>
 
 namespace dd {
     void print_eqs(ptr_vector<solver::equation> const& eqs) {
@@ -144,7 +145,7 @@ namespace dd {
     }
 
     void add_def(unsigned_vector const& id2var, app* e, ast_manager& m, pdd_manager& p, solver& g) {
-        expr* a, *b;
+        expr* a, *b, *c;
         pdd v1 = p.mk_var(id2var[e->get_id()]);
         pdd q(p);
         if (m.is_and(e)) {
@@ -171,6 +172,18 @@ namespace dd {
             pdd v3 = p.mk_var(id2var[b->get_id()]);
             q = v1 - (v2 ^ v3);
         }
+        else if (m.is_ite(e, c, a, b)) {
+            pdd v2 = p.mk_var(id2var[c->get_id()]);
+            pdd v3 = p.mk_var(id2var[a->get_id()]);
+            pdd v4 = p.mk_var(id2var[b->get_id()]);
+            q = v1 - (v2*v3 + (1 - v2)*v4);
+        }
+        else if (m.is_true(e)) {
+            q = v1 - 1;
+        }
+        else if (m.is_false(e)) {
+            q = v1;
+        }
         else if (is_uninterp_const(e)) {
             return;
         }
@@ -202,6 +215,10 @@ namespace dd {
         collect_id2var(id2var, fmls);
         pdd_manager p(id2var.size(), use_mod2 ? pdd_manager::mod2_e : pdd_manager::zero_one_vars_e);
         solver g(m.limit(), p);
+        // saturating multiplier circuits does not finish in reasonable time.
+        solver::config cfg;
+        cfg.m_max_steps = 10;
+        g.set(cfg);
 
         for (expr* e : subterms::ground(fmls)) {
             add_def(id2var, to_app(e), m, p, g);
@@ -219,7 +236,6 @@ namespace dd {
         g.simplify();
         g.display(std::cout);
         if (use_mod2) {
-            solver::config cfg;
             cfg.m_enable_exlin = true;
             g.set(cfg);
             g.simplify();
@@ -233,11 +249,12 @@ namespace dd {
         ast_manager m;
         reg_decl_plugins(m);
         bv_util bv(m);
-        expr_ref x(m.mk_const("x", bv.mk_sort(3)), m);
-        expr_ref y(m.mk_const("y", bv.mk_sort(3)), m);
-        expr_ref xy(bv.mk_bv_mul(x, y), m);
-        expr_ref yx(bv.mk_bv_mul(y, x), m);
-        expr_ref eq(m.mk_not(m.mk_eq(xy,yx)), m);
+        expr_ref x(m.mk_const("x", bv.mk_sort(2)), m);
+        expr_ref y(m.mk_const("y", bv.mk_sort(2)), m);
+        // x*y and y*x share a circuit and would blast to true, use x*(y+1) = x*y + x instead.
+        expr_ref xy1(bv.mk_bv_mul(x, bv.mk_bv_add(y, bv.mk_numeral(1, 2))), m);
+        expr_ref xyx(bv.mk_bv_add(bv.mk_bv_mul(x, y), x), m);
+        expr_ref eq(m.mk_not(m.mk_eq(xy1, xyx)), m);
         goal_ref g = alloc(goal, m);
         g->assert_expr(eq);
         goal_ref_buffer res;
@@ -253,9 +270,36 @@ namespace dd {
         test_simplify(fmls, false);
         
     }
+
+    void saturate_eqs(unsigned threads, std::ostream& out) {
+        unsigned const n = 40;
+        pdd_manager m(n);
+        reslimit lim;
+        solver gb(lim, m);
+        solver::config cfg;
+        cfg.m_max_steps = 200;
+        cfg.m_threads = threads;
+        gb.set(cfg);
+        for (unsigned i = 0; i < n; ++i) {
+            pdd x = m.mk_var(i), y = m.mk_var((i + 3) % n), z = m.mk_var((i + 7) % n);
+            gb.add(x*y + z - i);
+            gb.add(x - 2*y + z*z);
+        }
+        gb.adjust_cfg();
+        gb.saturate();
+        gb.display(out);
+    }
+
+    void test_parallel() {
+        std::ostringstream seq, par;
+        saturate_eqs(1, seq);
+        saturate_eqs(4, par);
+        VERIFY(seq.str() == par.str());
+    }
 }
 
 void tst_pdd_solver() {
     dd::test1();
+    dd::test_parallel();
     dd::test2();
 }
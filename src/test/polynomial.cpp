@@ -1305,6 +1305,37 @@ static void tst_p25() {
 }
 #endif
 
+static void tst_mul(polynomial_ref const & p, polynomial_ref const & q) {
+    polynomial::manager & m = p.m();
+    polynomial_ref r(m), expected(m), t(m);
+    r = p * q;
+    expected = m.mk_zero();
+    for (unsigned i = 0; i < m.size(p); i++) {
+        t = m.mul(m.coeff(p, i), m.get_monomial(p, i), q);
+        expected = expected + t;
+    }
+    std::cout << "size(p): " << m.size(p) << " size(q): " << m.size(q) << " size(p*q): " << m.size(r) << "\n";
+    ENSURE(eq(r, expected));
+}
+
+static void tst_mul() {
+    reslimit rl;
+    polynomial::numeral_manager nm;
+    polynomial::manager m(rl, nm);
+    polynomial_ref x0(m), x1(m), x2(m), x3(m);
+    x0 = m.mk_polynomial(m.mk_var());
+    x1 = m.mk_polynomial(m.mk_var());
+    x2 = m.mk_polynomial(m.mk_var());
+    x3 = m.mk_polynomial(m.mk_var());
+    // dense
+    tst_mul((x0 + x1 + x2 + 1)^4, (x0 - 2*x1 + x3)^5);
+    tst_mul((x0 - x1)^9, (x0 + x1)^9);
+    // sparse
+    tst_mul((x0^100) + (x1^50)*x2 + 3*(x3^70)*x0 + (x2^90) + (x1^33) - 7 + x0*x1*x2*x3 + (x3^2) - (x2^81),
+            (x0^120) - (x1^60)*(x2^3) + 2*(x3^17) + (x2^91)*x1 + 5 - (x0^40)*(x3^40) + (x1^77) + x2);
+    tst_mul((x0 + 1)^30, (x0 - 1)^30);
+}
+
 static void tst_mm() {
     unsynch_mpq_manager qm;
     // pm1 and pm2 share the same monomial manager
@@ -1822,6 +1853,7 @@ void tst_polynomial() {
     enable_trace("Lazard");
     // enable_trace("eval_bug");
     // enable_trace("mgcd");
+    tst_mul();
     tst_psc();
     return;
     tst_eval();
@@ -466,6 +466,22 @@ static void tst12() {
         std::cout << i << ": " << r.get_bit(i) << "\n";
 }
 
+static void tst13() {
+    // small integer arithmetic that leaves the machine int range
+    rational a(INT_MAX), b(INT_MIN);
+    ENSURE(a + a == rational("4294967294"));
+    ENSURE(b - a == rational("-4294967295"));
+    ENSURE(b * b == rational("4611686018427387904"));
+    rational c(3);
+    c.addmul(b, b);
+    ENSURE(c == rational("4611686018427387907"));
+    c.submul(b, b);
+    ENSURE(c == rational(3));
+    ENSURE(c.is_small_int());
+    rational d(1, 2);
+    d += rational(1);
+    ENSURE(d == rational(3, 2));
+}
 
 void tst_rational() {
     TRACE("rational", tout << "starting rational test...\n";);
@@ -492,4 +508,5 @@ void tst_rational() {
     tst10(true);
     tst10(false);
     tst12();
+    tst13();
 }
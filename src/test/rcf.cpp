@@ -163,9 +163,33 @@ static void tst_denominators() {
     std::cout << "---->\n" << n << "\n" << d << "\n";
 }
 
+static void tst_compare() {
+    unsynch_mpq_manager qm;
+    reslimit rl;
+    rcmanager m(rl, qm);
+    scoped_rcnumeral pi(m), e(m), eps(m), a(m), b(m);
+    m.mk_pi(pi);
+    m.mk_e(e);
+    m.mk_infinitesimal(eps);
+    scoped_mpq q(qm);
+    qm.set(q, 355, 113);
+    m.set(a, q);
+    // the initial intervals of pi and 355/113 overlap
+    ENSURE(pi < a);
+    ENSURE(a > pi);
+    ENSURE(pi + eps > pi);
+    ENSURE(pi - eps < pi);
+    b = pi * 2 - pi;
+    ENSURE(b == pi);
+    b = e + pi;
+    ENSURE(b - pi == e);
+    ENSURE(e < pi);
+}
+
 void tst_rcf() {
     enable_trace("rcf_clean");
     enable_trace("rcf_clean_bug");
+    tst_compare();
     tst_denominators();
     tst1();
     tst2();
@@ -0,0 +1,226 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    rewriter_bench.cpp
+
+Abstract:
+
+    Micro-benchmark for th_rewriter and the theory rewriters it dispatches to.
+
+    Usage: test-z3 rewriter_bench [file.smt2 ...]
+
+    Without files, formulas of the families bool, arith, bv and seq are
+    generated from a fixed seed, so runs are reproducible. Every formula
+    is rewritten by fresh rewriters and the rewrite steps per second, the
+    cache hit rate and the allocations per step are printed as JSON.
+    The z3-bench target runs it on the generated families.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/seq_decl_plugin.h"
+#include "ast/for_each_expr.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "util/stopwatch.h"
+#include "util/error_codes.h"
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+    /**
+       \brief Generate a formula of a family. New terms combine random earlier
+       terms, so the formula is a DAG with shared sub-terms.
+     */
+    class bench_gen {
+        ast_manager&    m;
+        random_gen      m_rand;
+        arith_util      a;
+        bv_util         bv;
+        seq_util        seq;
+        expr_ref_vector m_terms;
+        expr_ref_vector m_atoms;
+
+        expr* pick() { return m_terms.get(m_rand(m_terms.size())); }
+
+        void mk_bool(unsigned n) {
+            for (unsigned i = 0; i < 16; ++i)
+                m_terms.push_back(m.mk_const(symbol(("p" + std::to_string(i)).c_str()), m.mk_bool_sort()));
+            m_terms.push_back(m.mk_true());
+            for (unsigned i = 0; i < n; ++i) {
+                expr* x = pick(), *y = pick();
+                switch (m_rand(5)) {
+                case 0: m_terms.push_back(m.mk_and(x, y)); break;
+                case 1: m_terms.push_back(m.mk_or(x, m.mk_not(y))); break;
+                case 2: m_terms.push_back(m.mk_ite(x, y, pick())); break;
+                case 3: m_terms.push_back(m.mk_implies(x, y)); break;
+                default: m_terms.push_back(m.mk_eq(x, y)); break;
+                }
+                if (m_rand(4) == 0)
+                    m_atoms.push_back(m_terms.back());
+            }
+        }
+
+        void mk_arith(unsigned n) {
+            sort* s = a.mk_int();
+            for (unsigned i = 0; i < 8; ++i)
+                m_terms.push_back(m.mk_const(symbol(("x" + std::to_string(i)).c_str()), s));
+            for (unsigned i = 0; i < n; ++i) {
+                expr* x = pick(), *y = pick();
+                switch (m_rand(4)) {
+                case 0: m_terms.push_back(a.mk_add(x, y, a.mk_int(m_rand(10)))); break;
+                case 1: m_terms.push_back(a.mk_mul(a.mk_int(m_rand(5) + 1), x)); break;
+                case 2: m_terms.push_back(a.mk_sub(x, y)); break;
+                default: m_terms.push_back(a.mk_add(a.mk_mul(x, y), a.mk_uminus(x))); break;
+                }
+                if (m_rand(4) == 0)
+                    m_atoms.push_back(m_rand(2) ? a.mk_le(m_terms.back(), pick()) : m.mk_eq(m_terms.back(), a.mk_int(0)));
+            }
+        }
+
+        void mk_bv(unsigned n) {
+            for (unsigned i = 0; i < 8; ++i)
+                m_terms.push_back(m.mk_const(symbol(("b" + std::to_string(i)).c_str()), bv.mk_sort(32)));
+            for (unsigned i = 0; i < n; ++i) {
+                expr* x = pick(), *y = pick();
+                switch (m_rand(6)) {
+                case 0: m_terms.push_back(bv.mk_bv_add(x, y)); break;
+                case 1: m_terms.push_back(bv.mk_bv_mul(bv.mk_numeral(m_rand(7) + 1, 32), x)); break;
+                case 2: m_terms.push_back(bv.mk_bv_and(x, bv.mk_bv_or(y, bv.mk_numeral(0xff, 32)))); break;
+                case 3: m_terms.push_back(bv.mk_bv_xor(x, y)); break;
+                case 4: m_terms.push_back(bv.mk_concat(bv.mk_extract(15, 0, x), bv.mk_extract(31, 16, y))); break;
+                default: m_terms.push_back(bv.mk_bv_sub(x, bv.mk_bv_neg(y))); break;
+                }
+                if (m_rand(4) == 0)
+                    m_atoms.push_back(bv.mk_ule(m_terms.back(), pick()));
+            }
+        }
+
+        void mk_seq(unsigned n) {
+            for (unsigned i = 0; i < 8; ++i)
+                m_terms.push_back(m.mk_const(symbol(("s" + std::to_string(i)).c_str()), seq.str.mk_string_sort()));
+            m_terms.push_back(seq.str.mk_string(zstring("ab")));
+            m_terms.push_back(seq.str.mk_string(zstring("")));
+            for (unsigned i = 0; i < n; ++i) {
+                expr* x = pick(), *y = pick();
+                switch (m_rand(3)) {
+                case 0: m_terms.push_back(seq.str.mk_concat(x, y)); break;
+                case 1: m_terms.push_back(seq.str.mk_concat(x, seq.str.mk_string(zstring("c")), y)); break;
+                default: m_terms.push_back(seq.str.mk_concat(seq.str.mk_string(zstring("")), x)); break;
+                }
+                switch (m_rand(6)) {
+                case 0: m_atoms.push_back(seq.str.mk_prefix(x, m_terms.back())); break;
+                case 1: m_atoms.push_back(a.mk_le(seq.str.mk_length(m_terms.back()), a.mk_int(m_rand(20)))); break;
+                case 2: m_atoms.push_back(m.mk_eq(m_terms.back(), y)); break;
+                default: break;
+                }
+            }
+        }
+
+    public:
+        bench_gen(ast_manager& m, unsigned seed): m(m), m_rand(seed), a(m), bv(m), seq(m), m_terms(m), m_atoms(m) {}
+
+        expr_ref operator()(char const* family, unsigned n) {
+            m_terms.reset();
+            m_atoms.reset();
+            if (strcmp(family, "bool") == 0)
+                mk_bool(n);
+            else if (strcmp(family, "arith") == 0)
+                mk_arith(n);
+            else if (strcmp(family, "bv") == 0)
+                mk_bv(n);
+            else
+                mk_seq(n);
+            return expr_ref(m.mk_and(m_atoms), m);
+        }
+    };
+
+    struct bench_result {
+        unsigned long long m_steps = 0;
+        unsigned long long m_cache_checks = 0;
+        unsigned long long m_cache_hits = 0;
+        unsigned long long m_allocs = 0;
+        double             m_seconds = 0;
+    };
+
+    bench_result run_bench(ast_manager& m, expr* fml, unsigned reps) {
+        bench_result r;
+        stopwatch sw;
+        for (unsigned i = 0; i < reps; ++i) {
+            expr_ref result(m);
+            unsigned long long allocs = memory::get_allocation_count();
+            sw.start();
+            {
+                th_rewriter rw(m);
+                rw(fml, result);
+                r.m_steps += rw.get_num_steps();
+                r.m_cache_checks += rw.get_num_cache_checks();
+                r.m_cache_hits += rw.get_num_cache_hits();
+            }
+            sw.stop();
+            r.m_allocs += memory::get_allocation_count() - allocs;
+        }
+        r.m_seconds = sw.get_seconds();
+        return r;
+    }
+
+    void display_json(std::ostream& out, char const* name, expr* fml, bench_result const& r) {
+        double steps = static_cast<double>(r.m_steps);
+        out << "    {\"name\": \"" << name << "\""
+            << ", \"size\": " << get_num_exprs(fml)
+            << ", \"rewrites\": " << r.m_steps
+            << ", \"seconds\": " << r.m_seconds
+            << ", \"rewrites_per_sec\": " << (r.m_seconds > 0 ? steps / r.m_seconds : 0)
+            << ", \"cache_hit_rate\": " << (r.m_cache_checks > 0 ? static_cast<double>(r.m_cache_hits) / r.m_cache_checks : 0)
+            << ", \"allocations_per_rewrite\": " << (steps > 0 ? r.m_allocs / steps : 0)
+            << "}";
+    }
+
+    expr_ref parse_file(ast_manager& m, char const* file_name) {
+        cmd_context ctx(false, &m);
+        ctx.set_ignore_check(true);
+        std::ifstream in(file_name);
+        if (in.bad() || in.fail()) {
+            std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
+            exit(ERR_OPEN_FILE);
+        }
+        VERIFY(parse_smt2_commands(ctx, in));
+        return expr_ref(m.mk_and(ctx.assertions()), m);
+    }
+}
+
+void tst_rewriter_bench(char** argv, int argc, int& i) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    unsigned const reps = 5;
+    std::ostream& out = std::cout;
+    out << "{\"benchmarks\": [\n";
+    bool first = true;
+    auto bench = [&](char const* name, expr* fml) {
+        if (!first)
+            out << ",\n";
+        first = false;
+        display_json(out, name, fml, run_bench(m, fml, reps));
+    };
+    if (i + 1 < argc && argv[i + 1][0] != '/' && argv[i + 1][0] != '-') {
+        while (i + 1 < argc && argv[i + 1][0] != '/' && argv[i + 1][0] != '-') {
+            char const* file_name = argv[++i];
+            expr_ref fml = parse_file(m, file_name);
+            bench(file_name, fml);
+        }
+    }
+    else {
+        bench_gen gen(m, 17);
+        for (char const* family : { "bool", "arith", "bv", "seq" }) {
+            expr_ref fml = gen(family, 20000);
+            bench(family, fml);
+        }
+    }
+    out << "\n]}\n";
+}
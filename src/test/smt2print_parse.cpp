@@ -8,7 +8,10 @@ Copyright (c) 2015 Microsoft Corporation
 // for SMT-LIB2.
 
 #include "api/z3.h"
+#include "util/debug.h"
+#include <cstring>
 #include <iostream>
+#include <string>
 
 void test_print(Z3_context ctx, Z3_ast_vector av) {
     Z3_set_ast_print_mode(ctx, Z3_PRINT_SMTLIB2_COMPLIANT);
@@ -87,6 +90,37 @@ void test_eval(Z3_context ctx, Z3_string spec, bool shouldFail) {
     }
 }
 
+// print the assertions with the stream printer and parse them back.
+// The parser expands the lets, so it has to return the same term.
+void test_stream_print(char const* spec) {
+    Z3_global_param_set("pp.stream_size", "1");
+    Z3_global_param_set("pp.min_alias_size", "3");
+    Z3_context ctx = Z3_mk_context(nullptr);
+    std::string decls;
+    for (char const* line = spec; *line; ) {
+        char const* end = strchr(line, '\n');
+        std::string l(line, end ? end : line + strlen(line));
+        if (l.compare(0, 8, "(assert ") != 0)
+            decls += l + "\n";
+        line = end ? end + 1 : line + l.size();
+    }
+    Z3_ast_vector a = Z3_parse_smtlib2_string(ctx, spec, 0, nullptr, nullptr, 0, nullptr, nullptr);
+    Z3_ast_vector_inc_ref(ctx, a);
+    for (unsigned i = 0; i < Z3_ast_vector_size(ctx, a); ++i) {
+        Z3_ast f = Z3_ast_vector_get(ctx, a, i);
+        std::string txt = decls + "(assert " + Z3_ast_to_string(ctx, f) + ")\n";
+        std::cout << txt;
+        Z3_ast_vector b = Z3_parse_smtlib2_string(ctx, txt.c_str(), 0, nullptr, nullptr, 0, nullptr, nullptr);
+        Z3_ast_vector_inc_ref(ctx, b);
+        ENSURE(Z3_ast_vector_size(ctx, b) == 1);
+        ENSURE(Z3_is_eq_ast(ctx, f, Z3_ast_vector_get(ctx, b, 0)));
+        Z3_ast_vector_dec_ref(ctx, b);
+    }
+    Z3_ast_vector_dec_ref(ctx, a);
+    Z3_del_context(ctx);
+    Z3_global_param_reset_all();
+}
+
 void throwError(Z3_context c, Z3_error_code e) {
     throw std::runtime_error(Z3_get_error_msg(c, e));
 }
@@ -218,6 +252,19 @@ void tst_smt2print_parse() {
 
     test_parseprint(spec6);
 
+    // Test the printer that streams large terms
+    char const* spec7 =
+        "(declare-const x (_ BitVec 8))\n"
+        "(declare-const y Int)\n"
+        "(declare-const a (Array Int Int))\n"
+        "(define-fun t1 () (_ BitVec 8) (bvmul (bvadd x #x0f) (bvadd x (bvneg #x01))))\n"
+        "(define-fun t2 () (_ BitVec 8) (bvxor (bvor t1 x) (bvand t1 #xf0)))\n"
+        "(define-fun s1 () Int (+ (* 2 y) (select (store a 1 (- 3)) y) (div y 7)))\n"
+        "(assert (bvule (concat ((_ extract 3 0) t2) ((_ extract 7 4) t2)) (bvudiv t2 t1)))\n"
+        "(assert (or (> s1 (- s1 1)) (= (str.len \"a\\u{62}\") s1) (= ((as const (Array Int Int)) 0) a)))\n";
+
+    test_stream_print(spec7);
+
     // Test ?
 
     test_repeated_eval();
@@ -3,7 +3,7 @@
 #include "smt/smt_solver.h"
 #include <iostream>
 
-void tst_solver_pool() {
+static void tst_solver_pool_basic() {
     ast_manager m;
     reg_decl_plugins(m);
     params_ref p;
@@ -40,3 +40,46 @@ void tst_solver_pool() {
     std::cout << *s2;
     std::cout << *base;
 }
+
+// retired frames must not constrain later frames, also after their
+// activation literals are recycled by a refresh of the base solver.
+static void tst_solver_pool_recycle() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    ref<solver> base = mk_smt_solver(m, p, symbol::null);
+    expr_ref a(m.mk_const(symbol("a"), m.mk_bool_sort()), m);
+    expr_ref b(m.mk_const(symbol("b"), m.mk_bool_sort()), m);
+    base->assert_expr(m.mk_or(a, b));
+
+    solver_pool pool(base.get(), 1);
+    pool.set_max_retired(2);
+    ref<solver> s = pool.mk_solver();
+    for (unsigned i = 0; i < 6; ++i) {
+        s->assert_expr(i % 2 == 0 ? m.mk_not(a) : m.mk_not(b));
+        ENSURE(s->check_sat(0, nullptr) == l_true);
+        pool.reset_solver(s.get());
+    }
+    s->assert_expr(m.mk_not(a));
+    s->assert_expr(m.mk_not(b));
+    ENSURE(s->check_sat(0, nullptr) == l_false);
+    pool.reset_solver(s.get());
+    ENSURE(s->check_sat(0, nullptr) == l_true);
+
+    // solvers released by their clients are retired by the next mk_solver.
+    for (unsigned i = 0; i < 6; ++i) {
+        ref<solver> t = pool.mk_solver();
+        t->assert_expr(i % 2 == 0 ? m.mk_not(a) : m.mk_not(b));
+        ENSURE(t->check_sat(0, nullptr) == l_true);
+    }
+    ENSURE(s->check_sat(0, nullptr) == l_true);
+
+    statistics st;
+    pool.collect_statistics(st);
+    st.display(std::cout);
+}
+
+void tst_solver_pool() {
+    tst_solver_pool_basic();
+    tst_solver_pool_recycle();
+}
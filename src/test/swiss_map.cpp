@@ -0,0 +1,167 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    swiss_map.cpp
+
+Abstract:
+
+    Test swiss_map against u_map, and compare the time of both on the
+    access patterns of a rewriter cache and of internalization.
+
+--*/
+#include <iostream>
+#include <unordered_map>
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "util/map.h"
+#include "util/obj_hashtable.h"
+#include "util/stopwatch.h"
+#include "util/swiss_map.h"
+
+static void tst_random() {
+    random_gen r(0);
+    u_swiss_map<unsigned> m;
+    std::unordered_map<unsigned, unsigned> ref;
+    for (unsigned i = 0; i < 200000; ++i) {
+        unsigned k = r() % 5000;
+        switch (r() % 4) {
+        case 0:
+        case 1:
+            m.insert(k, i);
+            ref[k] = i;
+            break;
+        case 2:
+            m.erase(k);
+            ref.erase(k);
+            break;
+        default: {
+            unsigned v = 0;
+            bool found = m.find(k, v);
+            ENSURE(found == (ref.count(k) > 0));
+            ENSURE(!found || v == ref[k]);
+            break;
+        }
+        }
+        ENSURE(m.size() == ref.size());
+    }
+    unsigned n = 0;
+    for (auto const & kv : m) {
+        ENSURE(ref.count(kv.m_key) > 0 && ref[kv.m_key] == kv.m_value);
+        ++n;
+    }
+    ENSURE(n == ref.size());
+    for (auto const & kv : ref)
+        m.remove(kv.first);
+    ENSURE(m.empty());
+    ENSURE(m.begin() == m.end());
+}
+
+static void tst_basic() {
+    u_swiss_map<unsigned> m;
+    ENSURE(!m.contains(3));
+    ENSURE(m.insert_if_not_there(3, 4) == 4);
+    ENSURE(m.insert_if_not_there(3, 5) == 4);
+    m.insert(3, 6);
+    ENSURE(m.find(3) == 6);
+    ENSURE(m.find_iterator(3)->m_value == 6);
+    ENSURE(m.find_iterator(7) == m.end());
+    // keys with the same home slot
+    for (unsigned i = 0; i < 1000; ++i)
+        m.insert(i << 20, i);
+    for (unsigned i = 0; i < 1000; i += 3)
+        m.erase(i << 20);
+    for (unsigned i = 0; i < 1000; ++i)
+        ENSURE(m.contains(i << 20) == (i % 3 != 0));
+    u_swiss_map<unsigned> m2(m);
+    m.reset();
+    ENSURE(m.empty() && !m.contains(3));
+    ENSURE(m2.size() == 1 + 666);
+    m.swap(m2);
+    ENSURE(m.contains(3) && m2.empty());
+}
+
+template<typename Map>
+static double bench_u(unsigned n) {
+    stopwatch sw;
+    sw.start();
+    Map m;
+    unsigned sum = 0;
+    for (unsigned round = 0; round < 20; ++round) {
+        for (unsigned i = 0; i < n; ++i)
+            m.insert(i * 7, i);
+        for (unsigned i = 0; i < 4 * n; ++i) {
+            unsigned v;
+            if (m.find(i * 3, v))
+                sum += v;
+        }
+        for (unsigned i = 0; i < n; i += 2)
+            m.erase(i * 7);
+    }
+    sw.stop();
+    std::cout << "(checksum " << sum << ")\n";
+    return sw.get_seconds();
+}
+
+// a rewriter cache maps every subterm to its result, an internalizer maps
+// every term to its variable while most lookups are hits.
+template<typename Map>
+static double bench_obj(ptr_vector<app> const & terms) {
+    stopwatch sw;
+    sw.start();
+    unsigned sum = 0;
+    for (unsigned round = 0; round < 20; ++round) {
+        Map cache;
+        for (app* t : terms) {
+            app* r = nullptr;
+            for (expr* arg : *t)
+                if (is_app(arg) && cache.find(to_app(arg), r))
+                    ++sum;
+            cache.insert(t, t);
+        }
+        for (app* t : terms) {
+            app* r = nullptr;
+            if (cache.find(t, r))
+                sum += r == t;
+        }
+    }
+    sw.stop();
+    std::cout << "(checksum " << sum << ")\n";
+    return sw.get_seconds();
+}
+
+static void tst_bench() {
+    unsigned n = 100000;
+    double t1 = bench_u<u_map<unsigned>>(n);
+    double t2 = bench_u<u_swiss_map<unsigned>>(n);
+    std::cout << "unsigned keys: u_map " << t1 << "s u_swiss_map " << t2 << "s\n";
+
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    random_gen r(0);
+    app_ref_vector pinned(m);
+    ptr_vector<app> terms;
+    for (unsigned i = 0; i < 100; ++i) {
+        app* c = m.mk_const(symbol(i), a.mk_int());
+        pinned.push_back(c);
+        terms.push_back(c);
+    }
+    for (unsigned i = 0; i < n; ++i) {
+        app* x = terms[r() % terms.size()];
+        app* y = terms[r() % terms.size()];
+        app* t = i % 2 == 0 ? a.mk_add(x, y) : a.mk_mul(x, y);
+        pinned.push_back(t);
+        terms.push_back(t);
+    }
+    t1 = bench_obj<obj_map<app, app*>>(terms);
+    t2 = bench_obj<obj_swiss_map<app, app*>>(terms);
+    std::cout << "term keys: obj_map " << t1 << "s obj_swiss_map " << t2 << "s\n";
+}
+
+void tst_swiss_map() {
+    tst_basic();
+    tst_random();
+    tst_bench();
+}
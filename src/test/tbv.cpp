@@ -5,6 +5,7 @@ Copyright (c) 2015 Microsoft Corporation
 --*/
 
 #include "util/tbv.h"
+#include "util/util.h"
 #include <iostream>
 
 static void tst1(unsigned num_bits) {
@@ -75,6 +76,40 @@ static void tst2(unsigned num_bits) {
     }
 }
 
+// complement and intersect against the tbits
+static void tst3(unsigned num_bits) {
+    tbv_manager m(num_bits);
+    random_gen r(num_bits);
+    for (unsigned k = 0; k < 200; ++k) {
+        tbv_ref a(m, m.allocateX()), b(m, m.allocateX()), c(m, m.allocate());
+        for (unsigned i = 0; i < num_bits; ++i) {
+            m.set(*a, i, (tbit)(1 + r(3)));
+            m.set(*b, i, (tbit)(1 + r(3)));
+        }
+        ptr_vector<tbv> result;
+        m.complement(*a, result);
+        unsigned j = 0;
+        for (unsigned i = 0; i < num_bits; ++i) {
+            if ((*a)[i] == BIT_x)
+                continue;
+            ENSURE(j < result.size());
+            ENSURE((*result[j])[i] == neg((*a)[i]));
+            m.set(*result[j], i, (*a)[i]);
+            ENSURE(m.equals(*result[j], *a));
+            ++j;
+        }
+        ENSURE(j == result.size());
+        for (tbv* t : result)
+            m.deallocate(t);
+        bool ok = true;
+        for (unsigned i = 0; i < num_bits; ++i)
+            ok &= ((*a)[i] & (*b)[i]) != BIT_z;
+        ENSURE(m.intersect(*a, *b, *c) == ok);
+        for (unsigned i = 0; i < num_bits; ++i)
+            ENSURE((*c)[i] == ((*a)[i] & (*b)[i]));
+    }
+}
+
 #if 0
 // prints all don't care pareto fronts for 8-bit multiplier.
 static void test_dc() {
@@ -151,4 +186,9 @@ void tst_tbv() {
     tst2(15);
     tst2(16);
     tst2(17);
+
+    tst3(15);
+    tst3(16);
+    tst3(70);
+    tst3(130);
 }
@@ -19,4 +19,22 @@ void tst_totalizer() {
     }
     for (auto& clause : tot.clauses()) 
         std::cout << clause << "\n";
+
+    // encoding a large bound first, then extending the tree, only adds
+    // clauses for the outputs that are new.
+    opt::totalizer tot2(lits);
+    std::cout << "at least 5 " << mk_pp(tot2.at_least(5), m) << "\n";
+    ENSURE(tot2.num_encoded() == 5);
+    unsigned num_clauses = tot2.clauses().size();
+    tot2.clauses().reset();
+    ENSURE(tot2.at_least(3) && tot2.clauses().empty());
+    expr_ref_vector lits2(m);
+    for (unsigned i = 0; i < 3; ++i)
+        lits2.push_back(m.mk_fresh_const("b", m.mk_bool_sort()));
+    tot2.add_literals(lits2);
+    ENSURE(tot2.size() == 8 && tot2.num_encoded() == 0);
+    tot2.at_least(5);
+    std::cout << "clauses " << num_clauses << " extension " << tot2.clauses().size() << "\n";
+    ENSURE(tot2.num_encoded() == 5);
+    ENSURE(m.is_false(tot2.at_least(9)));
 }
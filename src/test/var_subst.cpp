@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 #include "ast/rewriter/var_subst.h"
+#include "ast/rewriter/cached_var_subst.h"
 #include "ast/ast_pp.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -99,8 +100,39 @@ void tst_subst(ast_manager& m) {
 
 }
 
+// instances of cached_var_subst agree with var_subst
+static void tst_cached_subst(ast_manager& m) {
+    arith_util a(m);
+    sort* int_s = a.mk_int();
+    sort* ss[2] = { int_s, int_s };
+    symbol names[2] = { symbol("x"), symbol("y") };
+    func_decl_ref f(m.mk_func_decl(symbol("f"), 2, ss, int_s), m);
+    expr_ref x(m.mk_var(0, int_s), m), y(m.mk_var(1, int_s), m), c(m.mk_const(symbol("c"), int_s), m);
+    expr_ref g(m.mk_app(f, c.get(), a.mk_int(1)), m);
+    expr_ref body(m.mk_and(a.mk_le(m.mk_app(f, x.get(), g.get()), y), a.mk_ge(a.mk_add(x, g), a.mk_int(0))), m);
+    quantifier_ref q(m.mk_forall(2, ss, names, body), m);
+    var_subst subst(m);
+    cached_var_subst cached(m);
+    for (int i = 0; i < 5; ++i) {
+        expr* bindings[2] = { a.mk_int(i), m.mk_app(f, c.get(), a.mk_int(i)) };
+        expr_ref_vector pin(m);
+        pin.append(2, bindings);
+        expr** slots = cached(q, 2);
+        slots[0] = bindings[0];
+        slots[1] = bindings[1];
+        expr_ref r1 = cached();
+        expr_ref r2 = subst(body, 2, bindings);
+        ENSURE(r1 == r2);
+        slots = cached(q, 2);
+        slots[0] = bindings[0];
+        slots[1] = bindings[1];
+        ENSURE(cached() == r1);
+    }
+}
+
 void tst_var_subst() {
     ast_manager m;
     reg_decl_plugins(m);
     tst_subst(m);
+    tst_cached_subst(m);
 }
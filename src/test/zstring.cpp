@@ -21,6 +21,28 @@ static void tst_ascii_roundtrip() {
     }
 }
 
+// Substrings and concatenations of narrow and wide strings.
+static void tst_shared() {
+    zstring ab("ab");
+    zstring wide(0x1F600u);
+    zstring s = ab + wide + ab;
+    ENSURE(s.length() == 5);
+    ENSURE(s[2] == 0x1F600u);
+    zstring t = s.extract(3, 2);
+    ENSURE(t == ab);
+    ENSURE(t.hash() == ab.hash());
+    ENSURE(s.extract(1, 3) == zstring("b") + wide + zstring("a"));
+    ENSURE(s.extract(5, 1).empty());
+    zstring u = t;
+    u = u + zstring("c");
+    ENSURE(t == ab);
+    ENSURE(u == zstring("abc"));
+    ENSURE(zstring("xaby").extract(1, 2) == ab);
+    ENSURE(s.reverse().reverse() == s);
+    ENSURE(s.replace(wide, zstring("c")) == zstring("abcab"));
+}
+
 void tst_zstring() {
     tst_ascii_roundtrip();
+    tst_shared();
 }
@@ -20,6 +20,7 @@ Revision History:
 
 #include "util/vector.h"
 #include "util/region.h"
+#include "util/map.h"
 
 template<typename C>
 class dependency_manager {
@@ -29,14 +30,16 @@ public:
     typedef typename C::allocator     allocator;
 
     class dependency { 
-        unsigned  m_ref_count:30;
+        unsigned  m_ref_count:29;
         unsigned  m_mark:1;
         unsigned  m_leaf:1;
+        unsigned  m_memo:1;     // the leaves of the join are memoized in m_memo
         friend class dependency_manager;
         dependency(bool leaf):
             m_ref_count(0),
             m_mark(false),
-            m_leaf(leaf) {
+            m_leaf(leaf),
+            m_memo(false) {
         }
         bool is_marked() const { return m_mark == 1; }
         void mark() { m_mark = true; }
@@ -70,6 +73,20 @@ private:
     value_manager &         m_vmanager;
     allocator  &            m_allocator;
     ptr_vector<dependency>  m_todo;
+    ptr_vector<dependency>  m_leaves;
+    bool                    m_memoize;
+    ptr_addr_map<dependency, ptr_vector<dependency>*> m_memo;
+
+    // minimal number of joins a linearization has to expand before its leaves are memoized
+    static const unsigned memo_threshold = 256;
+
+    void del_memo(dependency * d) {
+        ptr_vector<dependency> * leaves = nullptr;
+        m_memo.find(d, leaves);
+        m_memo.erase(d);
+        dealloc(leaves);
+        d->m_memo = false;
+    }
 
     void inc_ref(value const & v) {
         if (C::ref_count)
@@ -93,6 +110,8 @@ private:
                 m_allocator.deallocate(sizeof(leaf), to_leaf(d));
             }
             else {
+                if (d->m_memo)
+                    del_memo(d);
                 for (unsigned i = 0; i < 2; i++) {
                     dependency * c = to_join(d)->m_children[i];
                     SASSERT(c->m_ref_count > 0);
@@ -117,9 +136,21 @@ private:
 
 public:
     
-    dependency_manager(value_manager & m, allocator & a):
+    /**
+       \brief when memoize is set, the leaves of large joins are stored
+       when they are linearized, so later linearizations of the join, or
+       of joins that contain it, do not traverse it again. Memoization
+       requires that dependencies are only freed through dec_ref.
+    */
+    dependency_manager(value_manager & m, allocator & a, bool memoize = false):
         m_vmanager(m),
-        m_allocator(a) {
+        m_allocator(a),
+        m_memoize(memoize) {
+    }
+
+    ~dependency_manager() {
+        for (auto const& kv : m_memo)
+            dealloc(kv.m_value);
     }
 
     void inc_ref(dependency * d) {
@@ -195,7 +226,10 @@ public:
 
     void linearize(dependency * d, vector<value, false> & vs) {
         if (d) {
+            dependency * root = d;
+            unsigned num_joins = 0;
             m_todo.reset();
+            m_leaves.reset();
             d->mark();
             m_todo.push_back(d);
             unsigned qhead = 0;
@@ -203,9 +237,18 @@ public:
                 d = m_todo[qhead];
                 qhead++;
                 if (d->is_leaf()) {
-                    vs.push_back(to_leaf(d)->m_value);
+                    m_leaves.push_back(d);
+                }
+                else if (d->m_memo) {
+                    for (dependency * l : *m_memo[d]) {
+                        if (!l->is_marked()) {
+                            m_todo.push_back(l);
+                            l->mark();
+                        }
+                    }
                 }
                 else {
+                    ++num_joins;
                     for (unsigned i = 0; i < 2; i++) {
                         dependency * child = to_join(d)->m_children[i];
                         if (!child->is_marked()) {
@@ -215,6 +258,16 @@ public:
                     }
                 }
             }
+            for (dependency * l : m_leaves)
+                vs.push_back(to_leaf(l)->m_value);
+            // memoize when the traversal expanded a good share of the leaves,
+            // so the memoized prefixes of a growing chain of joins stay linear in size.
+            if (m_memoize && !root->is_leaf() && !root->m_memo &&
+                num_joins >= memo_threshold && 4 * num_joins >= m_leaves.size()) {
+                m_memo.insert(root, alloc(ptr_vector<dependency>, m_leaves));
+                root->m_memo = true;
+            }
+            m_leaves.reset();
             unmark_todo();
         }
     }
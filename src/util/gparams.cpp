@@ -16,6 +16,7 @@ Author:
 Notes:
 
 --*/
+#include <atomic>
 #include "util/gparams.h"
 #include "util/str_hashtable.h"
 #include "util/trace.h"
@@ -25,6 +26,9 @@ Notes:
 
 static DECLARE_MUTEX(gparams_mux);
 
+// incremented whenever the global or module parameters change
+static std::atomic<unsigned> g_generation(0);
+
 extern void gparams_register_modules();
 
 static char const * g_old_params_names[] = {
@@ -181,6 +185,7 @@ public:
 
     void reset() {
         lock_guard lock(*gparams_mux);
+        ++g_generation;
         m_params.reset();
         for (auto & kv : m_module_params) {
             dealloc(kv.m_value);
@@ -393,6 +398,7 @@ public:
         std::string m, p;
         normalize(name, m, p);
         lock_guard lock(*gparams_mux);
+        ++g_generation;
         if (!m[0]) {
             validate_type(p, value, get_param_descrs());
             set(get_param_descrs(), p, value, m);
@@ -638,6 +644,17 @@ params_ref gparams::get_module(char const * module_name) {
     return g_imp->get_module(module_name);
 }
 
+params_ref const & gparams::get_module(module_snapshot & s, char const * module_name) {
+    SASSERT(g_imp);
+    // read the generation first: a change during the lookup refreshes s again next time
+    unsigned gen = g_generation;
+    if (s.m_generation != gen) {
+        s.m_params.set(g_imp->get_module(module_name));
+        s.m_generation = gen;
+    }
+    return s.m_params;
+}
+
 
 params_ref const& gparams::get_ref() {
     TRACE("gparams", tout << "gparams::get_ref()\n";);
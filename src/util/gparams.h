@@ -105,6 +105,19 @@ public:
        params_ref const & p = get_module_params("pp")
     */
     static params_ref get_module(char const * module_name);
+
+    /**
+       \brief Copy of the parameters of a module that is only refreshed
+       when the global parameters were modified after it was taken.
+       The generated parameter helpers keep a snapshot per thread and
+       module, so creating them does not lock and search the global table.
+    */
+    struct module_snapshot {
+        unsigned   m_generation = UINT_MAX;
+        params_ref m_params;
+    };
+
+    static params_ref const & get_module(module_snapshot & s, char const * module_name);
     /**
        \brief Return the global parameter set (i.e., parameters that are not associated with any particular module).
     */
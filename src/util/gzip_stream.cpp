@@ -0,0 +1,147 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    gzip_stream.cpp
+
+Abstract:
+
+    Input stream that decompresses a gzip compressed source.
+
+--*/
+
+#include "util/gzip_stream.h"
+#include "util/memory_manager.h"
+#ifdef Z3_ZLIB
+#include <zlib.h>
+#include <cstring>
+#include <vector>
+#endif
+
+bool gzip_supported() {
+#ifdef Z3_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool is_gzip_stream(std::istream & in) {
+    return in.peek() == 0x1f;
+}
+
+#ifdef Z3_ZLIB
+
+struct gzip_streambuf::imp {
+    std::istream &    m_in;
+    z_stream          m_zs;
+    std::vector<char> m_in_buf;
+    std::vector<char> m_out_buf;
+    bool              m_member_end = false;   // the last inflated gzip member is complete
+
+    imp(std::istream & in, unsigned block_size):
+        m_in(in),
+        m_in_buf(block_size),
+        m_out_buf(block_size) {
+        memset(&m_zs, 0, sizeof(m_zs));
+    }
+
+    ~imp() { inflateEnd(&m_zs); }
+
+    bool init(std::string & error) {
+        // 16 + MAX_WBITS selects the gzip wrapper
+        if (inflateInit2(&m_zs, 16 + MAX_WBITS) != Z_OK) {
+            error = "failed to initialize zlib";
+            return false;
+        }
+        return true;
+    }
+
+    /**
+       \brief inflate the next block of output, return its size, 0 at the
+       end of the input or on errors.
+    */
+    size_t inflate_block(std::string & error) {
+        while (true) {
+            if (m_zs.avail_in == 0) {
+                m_in.read(m_in_buf.data(), m_in_buf.size());
+                size_t n = static_cast<size_t>(m_in.gcount());
+                if (n == 0) {
+                    if (!m_member_end)
+                        error = "unexpected end of gzip compressed input";
+                    return 0;
+                }
+                m_zs.next_in = reinterpret_cast<Bytef *>(m_in_buf.data());
+                m_zs.avail_in = static_cast<uInt>(n);
+            }
+            if (m_member_end) {
+                // the input continues with another gzip member
+                if (inflateReset(&m_zs) != Z_OK) {
+                    error = "failed to reset zlib";
+                    return 0;
+                }
+                m_member_end = false;
+            }
+            m_zs.next_out = reinterpret_cast<Bytef *>(m_out_buf.data());
+            m_zs.avail_out = static_cast<uInt>(m_out_buf.size());
+            int r = inflate(&m_zs, Z_NO_FLUSH);
+            if (r == Z_STREAM_END)
+                m_member_end = true;
+            else if (r != Z_OK && r != Z_BUF_ERROR) {
+                error = m_zs.msg ? m_zs.msg : "invalid gzip compressed input";
+                return 0;
+            }
+            size_t produced = m_out_buf.size() - m_zs.avail_out;
+            if (produced > 0)
+                return produced;
+        }
+    }
+};
+
+gzip_streambuf::gzip_streambuf(std::istream & in, unsigned block_size) {
+    setg(nullptr, nullptr, nullptr);
+    m_imp = alloc(imp, in, block_size == 0 ? 1 : block_size);
+    if (!m_imp->init(m_error)) {
+        dealloc(m_imp);
+        m_imp = nullptr;
+    }
+}
+
+gzip_streambuf::~gzip_streambuf() {
+    dealloc(m_imp);
+}
+
+gzip_streambuf::int_type gzip_streambuf::underflow() {
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+    if (!m_imp)
+        return traits_type::eof();
+    size_t n = m_imp->inflate_block(m_error);
+    if (n == 0) {
+        setg(nullptr, nullptr, nullptr);
+        dealloc(m_imp);
+        m_imp = nullptr;
+        return traits_type::eof();
+    }
+    char * b = m_imp->m_out_buf.data();
+    setg(b, b, b + n);
+    return traits_type::to_int_type(*gptr());
+}
+
+#else
+
+struct gzip_streambuf::imp {};
+
+gzip_streambuf::gzip_streambuf(std::istream & in, unsigned block_size):
+    m_error("gzip compressed input is not supported, build Z3 with Z3_USE_LIB_ZLIB") {
+    setg(nullptr, nullptr, nullptr);
+}
+
+gzip_streambuf::~gzip_streambuf() {}
+
+gzip_streambuf::int_type gzip_streambuf::underflow() {
+    return traits_type::eof();
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    gzip_stream.h
+
+Abstract:
+
+    Input stream that decompresses a gzip compressed source.
+
+    The source is inflated block by block as the consumer reads, so
+    neither the compressed nor the decompressed input is held in
+    memory as a whole. Concatenated gzip members are read as one
+    stream. Decompression uses zlib and is only available when Z3 is
+    built with Z3_ZLIB; otherwise gzip_supported() returns false.
+
+--*/
+#pragma once
+
+#include <istream>
+#include <streambuf>
+#include <string>
+
+class gzip_streambuf : public std::streambuf {
+    struct imp;
+    imp *       m_imp = nullptr;
+    std::string m_error;
+
+protected:
+    int_type underflow() override;
+
+public:
+    gzip_streambuf(std::istream & in, unsigned block_size = 1 << 16);
+    ~gzip_streambuf() override;
+
+    /**
+       \brief description of the error that stopped decompression, empty if
+       the input was decompressed completely.
+    */
+    std::string const & error() const { return m_error; }
+};
+
+class gzip_istream : public std::istream {
+    gzip_streambuf m_buf;
+public:
+    gzip_istream(std::istream & in, unsigned block_size = 1 << 16):
+        std::istream(nullptr),
+        m_buf(in, block_size) {
+        rdbuf(&m_buf);
+    }
+
+    std::string const & error() const { return m_buf.error(); }
+};
+
+/**
+   \brief return true if Z3 was built with gzip support.
+*/
+bool gzip_supported();
+
+/**
+   \brief return true if the next bytes of in are the gzip magic number.
+   Only the first byte is inspected, it never starts SMT-LIB or DIMACS text.
+*/
+bool is_gzip_stream(std::istream & in);
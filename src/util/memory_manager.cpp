@@ -52,15 +52,19 @@ out_of_memory_error::out_of_memory_error():z3_error(ERR_MEMOUT) {
 }
 
 
-static DECLARE_INIT_MUTEX(g_memory_mux);
+// The global counters are only updated in batches from the thread local
+// counters, see synchronize_counters. They are atomic so that independent
+// threads never serialize on a lock to account for memory.
 static atomic<bool> g_memory_out_of_memory(false);
 static bool       g_memory_initialized       = false;
-static long long  g_memory_alloc_size        = 0;
+static atomic<long long> g_memory_alloc_size(0);
 static long long  g_memory_max_size          = 0;
-static long long  g_memory_max_used_size     = 0;
+static atomic<long long> g_memory_max_used_size(0);
 static long long  g_memory_watermark         = 0;
-static long long  g_memory_alloc_count       = 0;
+static atomic<long long> g_memory_alloc_count(0);
 static long long  g_memory_max_alloc_count   = 0;
+static unsigned   g_memory_reduce_percent    = 75;
+static unsigned   g_memory_evict_percent     = 90;
 static bool       g_exit_when_out_of_memory  = false;
 static char const * g_out_of_memory_msg      = "ERROR: out of memory";
 
@@ -130,7 +134,6 @@ void memory::set_high_watermark(size_t watermark) {
 bool memory::above_high_watermark() {
     if (g_memory_watermark == 0)
         return false;
-    lock_guard lock(*g_memory_mux);
     return g_memory_watermark < g_memory_alloc_size;
 }
 
@@ -145,15 +148,33 @@ void memory::set_max_alloc_count(size_t max_count) {
     g_memory_max_alloc_count = max_count;
 }
 
+void memory::set_governor(unsigned reduce_percent, unsigned evict_percent) {
+    g_memory_reduce_percent = reduce_percent;
+    g_memory_evict_percent  = evict_percent;
+}
+
+memory::pressure memory::get_pressure(unsigned long long max_size) {
+    unsigned long long limit = max_size;
+    if (g_memory_max_size != 0 && (limit == 0 || static_cast<unsigned long long>(g_memory_max_size) < limit))
+        limit = g_memory_max_size;
+    if (g_memory_watermark != 0 && (limit == 0 || static_cast<unsigned long long>(g_memory_watermark) < limit))
+        limit = g_memory_watermark;
+    if (limit == 0)
+        return NO_PRESSURE;
+    unsigned long long used = get_allocation_size();
+    if (g_memory_evict_percent != 0 && used >= limit / 100 * g_memory_evict_percent)
+        return EVICT_PRESSURE;
+    if (g_memory_reduce_percent != 0 && used >= limit / 100 * g_memory_reduce_percent)
+        return REDUCE_PRESSURE;
+    return NO_PRESSURE;
+}
+
 static bool g_finalizing = false;
 
 void memory::finalize(bool shutdown) {
     if (g_memory_initialized) {
         g_finalizing = true;
         mem_finalize();
-        // we leak the mutex since we need it to be always live since memory may
-        // be reinitialized again
-        //delete g_memory_mux;
         g_memory_initialized = false;
         g_finalizing = false;
 
@@ -164,23 +185,14 @@ void memory::finalize(bool shutdown) {
 }
 
 unsigned long long memory::get_allocation_size() {
-    long long r;
-    {
-        lock_guard lock(*g_memory_mux);
-        r = g_memory_alloc_size;
-    }
+    long long r = g_memory_alloc_size;
     if (r < 0)
         r = 0;
     return r;
 }
 
 unsigned long long memory::get_max_used_memory() {
-    unsigned long long r;
-    {
-        lock_guard lock(*g_memory_mux);
-        r = g_memory_max_used_size;
-    }
-    return r;
+    return g_memory_max_used_size;
 }
 
 #if defined(_WINDOWS)
@@ -251,20 +263,15 @@ static void synchronize_counters(bool allocating) {
     g_synch_counter++;
 #endif
 
-    bool out_of_mem = false;
-    bool counts_exceeded = false;
-    {
-        lock_guard lock(*g_memory_mux);
-        g_memory_alloc_size += g_memory_thread_alloc_size;
-        g_memory_alloc_count += g_memory_thread_alloc_count;
-        if (g_memory_alloc_size > g_memory_max_used_size)
-            g_memory_max_used_size = g_memory_alloc_size;
-        if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
-            out_of_mem = true;
-        if (g_memory_max_alloc_count != 0 && g_memory_alloc_count > g_memory_max_alloc_count)
-            counts_exceeded = true;
-    }
-    g_memory_thread_alloc_size = 0;
+    long long alloc_size  = g_memory_alloc_size.fetch_add(g_memory_thread_alloc_size) + g_memory_thread_alloc_size;
+    long long alloc_count = g_memory_alloc_count.fetch_add(g_memory_thread_alloc_count) + g_memory_thread_alloc_count;
+    long long max_used    = g_memory_max_used_size;
+    while (alloc_size > max_used && !g_memory_max_used_size.compare_exchange_weak(max_used, alloc_size))
+        ;
+    bool out_of_mem      = g_memory_max_size != 0 && alloc_size > g_memory_max_size;
+    bool counts_exceeded = g_memory_max_alloc_count != 0 && alloc_count > g_memory_max_alloc_count;
+    g_memory_thread_alloc_size  = 0;
+    g_memory_thread_alloc_count = 0;
     if (out_of_mem && allocating) {
         throw_out_of_memory();
     }
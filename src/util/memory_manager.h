@@ -55,6 +55,20 @@ public:
     static bool above_high_watermark();
     static void set_max_size(size_t max_size);
     static void set_max_alloc_count(size_t max_count);
+
+    /**
+       \brief Level of memory pressure reported by the memory governor.
+       Solvers shrink their learned clauses under REDUCE_PRESSURE and also
+       evict their caches under EVICT_PRESSURE, so that a run degrades
+       before it reaches the memory limit.
+    */
+    enum pressure { NO_PRESSURE, REDUCE_PRESSURE, EVICT_PRESSURE };
+    static void set_governor(unsigned reduce_percent, unsigned evict_percent);
+    /**
+       \brief pressure relative to the smallest of the memory limit, the high
+       watermark and max_size, where 0 means no limit.
+    */
+    static pressure get_pressure(unsigned long long max_size = 0);
     static void finalize(bool shutdown = true);
     static void display_max_usage(std::ostream& os);
     static void display_i_max_usage(std::ostream& os);
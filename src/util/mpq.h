@@ -127,6 +127,11 @@ public:
 
     static bool is_small(mpq const & a) { return is_small(a.m_num) && is_small(a.m_den); }    
 
+    // a is an integer stored in a machine int, so sums and products of two of them fit in an int64_t
+    static bool is_small_int(mpq const & a) { return is_small(a.m_num) && is_one(a.m_den); }
+
+    static int64_t get_small_int(mpq const & a) { SASSERT(is_small_int(a)); return a.m_num.m_val; }
+
     static mpq mk_q(int v) { return mpq(v); }
 
     mpq mk_q(int n, int d) { mpq r; set(r, n, d); return r; }
@@ -185,6 +185,40 @@ mpz_manager<SYNCH>::~mpz_manager() {
 }
 
 #ifndef _MP_GMP
+#ifndef SINGLE_THREAD
+namespace {
+    // A synchronized manager is shared between threads and cannot use its
+    // small_object_allocator. Most of its cells are short lived temporaries of
+    // the initial capacity, they are recycled through a cache owned by the
+    // calling thread instead of going back to the heap each time.
+    // A cell may be released by a different thread than the one that
+    // allocated it, it then simply moves to the cache of the releasing thread.
+    class mpz_cell_cache {
+        static const unsigned max_cells = 1024;
+        void *   m_cells[max_cells];
+        unsigned m_size = 0;
+        bool     m_finalized = false; // numerals released during static destruction bypass the cache
+    public:
+        ~mpz_cell_cache() {
+            while (m_size > 0)
+                memory::deallocate(m_cells[--m_size]);
+            m_finalized = true;
+        }
+        void * allocate() {
+            return m_size > 0 ? m_cells[--m_size] : nullptr;
+        }
+        bool deallocate(void * p) {
+            if (m_size == max_cells || m_finalized)
+                return false;
+            m_cells[m_size++] = p;
+            return true;
+        }
+    };
+
+    thread_local mpz_cell_cache g_mpz_cell_cache;
+}
+#endif
+
 template<bool SYNCH>
 mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     SASSERT(capacity >= m_init_cell_capacity);
@@ -193,7 +227,11 @@ mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
 #else
     if (SYNCH) {
-        cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
+        cell = nullptr;
+        if (capacity == m_init_cell_capacity)
+            cell = reinterpret_cast<mpz_cell*>(g_mpz_cell_cache.allocate());
+        if (!cell)
+            cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
     }
     else {
         cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
@@ -212,7 +250,8 @@ void mpz_manager<SYNCH>::deallocate(bool is_heap, mpz_cell * ptr) {
         m_allocator.deallocate(cell_size(ptr->m_capacity), ptr); 
 #else
         if (SYNCH) {
-            memory::deallocate(ptr);
+            if (ptr->m_capacity != m_init_cell_capacity || !g_mpz_cell_cache.deallocate(ptr))
+                memory::deallocate(ptr);
         }
         else {
             m_allocator.deallocate(cell_size(ptr->m_capacity), ptr);        
@@ -319,11 +358,10 @@ void mpz_manager<SYNCH>::set_big_i64(mpz & c, int64_t v) {
         _v   = v;
     }
     mpz_set_ui(*c.m_ptr, static_cast<unsigned>(_v));
-    MPZ_BEGIN_CRITICAL();
-    mpz_set_ui(m_tmp,    static_cast<unsigned>(_v >> 32));
-    mpz_mul(m_tmp, m_tmp, m_two32);
-    mpz_add(*c.m_ptr, *c.m_ptr, m_tmp);
-    MPZ_END_CRITICAL();
+    scratch_mpz_t tmp(m_tmp);
+    mpz_set_ui(tmp(),    static_cast<unsigned>(_v >> 32));
+    mpz_mul(tmp(), tmp(), m_two32);
+    mpz_add(*c.m_ptr, *c.m_ptr, tmp());
     if (sign)
         mpz_neg(*c.m_ptr, *c.m_ptr);
 #endif
@@ -360,11 +398,10 @@ void mpz_manager<SYNCH>::set_big_ui64(mpz & c, uint64_t v) {
     }
     c.m_kind = mpz_large;
     mpz_set_ui(*c.m_ptr, static_cast<unsigned>(v));
-    MPZ_BEGIN_CRITICAL();
-    mpz_set_ui(m_tmp,    static_cast<unsigned>(v >> 32));
-    mpz_mul(m_tmp, m_tmp, m_two32);
-    mpz_add(*c.m_ptr, *c.m_ptr, m_tmp);
-    MPZ_END_CRITICAL();
+    scratch_mpz_t tmp(m_tmp);
+    mpz_set_ui(tmp(),    static_cast<unsigned>(v >> 32));
+    mpz_mul(tmp(), tmp(), m_two32);
+    mpz_add(*c.m_ptr, *c.m_ptr, tmp());
 #endif
 }
 
@@ -487,14 +524,13 @@ void mpz_manager<SYNCH>::set_digits(mpz & target, unsigned sz, digit_t const * d
         mpz_set_ui(*target.m_ptr, digits[sz - 1]);
         SASSERT(sz > 0);
         unsigned i = sz - 1;
-        MPZ_BEGIN_CRITICAL();
+        scratch_mpz_t tmp(m_tmp);
         while (i > 0) {
             --i;
             mpz_mul_2exp(*target.m_ptr, *target.m_ptr, 32);
-            mpz_set_ui(m_tmp, digits[i]);
-            mpz_add(*target.m_ptr, *target.m_ptr, m_tmp);
+            mpz_set_ui(tmp(), digits[i]);
+            mpz_add(*target.m_ptr, *target.m_ptr, tmp());
         }
-        MPZ_END_CRITICAL();
 #endif        
     }
 }
@@ -1625,15 +1661,11 @@ uint64_t mpz_manager<SYNCH>::get_uint64(mpz const & a) const {
         return mpz_get_ui(*a.m_ptr);
     }
     else {
-        MPZ_BEGIN_CRITICAL();
-        mpz_manager * _this = const_cast<mpz_manager*>(this);
-        mpz_set(_this->m_tmp, *a.m_ptr);
-        mpz_mod(_this->m_tmp, m_tmp, m_two32);
-        uint64_t r = static_cast<uint64_t>(mpz_get_ui(m_tmp));
-        mpz_set(_this->m_tmp, *a.m_ptr);
-        mpz_div(_this->m_tmp, m_tmp, m_two32);
-        r += static_cast<uint64_t>(mpz_get_ui(m_tmp)) << static_cast<uint64_t>(32);
-        MPZ_END_CRITICAL();
+        scratch_mpz_t tmp(m_tmp);
+        mpz_mod(tmp(), *a.m_ptr, m_two32);
+        uint64_t r = static_cast<uint64_t>(mpz_get_ui(tmp()));
+        mpz_div(tmp(), *a.m_ptr, m_two32);
+        r += static_cast<uint64_t>(mpz_get_ui(tmp())) << static_cast<uint64_t>(32);
         return r;
     }
 #endif
@@ -1658,13 +1690,11 @@ int64_t mpz_manager<SYNCH>::get_int64(mpz const & a) const {
         return mpz_get_si(*a.m_ptr);
     }
     else {
-        MPZ_BEGIN_CRITICAL();
-        mpz_manager * _this = const_cast<mpz_manager*>(this);
-        mpz_mod(_this->m_tmp, *a.m_ptr, m_two32);
-        int64_t r = static_cast<int64_t>(mpz_get_ui(m_tmp));
-        mpz_div(_this->m_tmp, *a.m_ptr, m_two32);
-        r += static_cast<int64_t>(mpz_get_si(m_tmp)) << static_cast<int64_t>(32);
-        MPZ_END_CRITICAL();
+        scratch_mpz_t tmp(m_tmp);
+        mpz_mod(tmp(), *a.m_ptr, m_two32);
+        int64_t r = static_cast<int64_t>(mpz_get_ui(tmp()));
+        mpz_div(tmp(), *a.m_ptr, m_two32);
+        r += static_cast<int64_t>(mpz_get_si(tmp())) << static_cast<int64_t>(32);
         return r;
     }
 #endif
@@ -2097,11 +2127,10 @@ void mpz_manager<SYNCH>::machine_div2k(mpz & a, unsigned k) {
     normalize(a);
 #else
     ensure_mpz_t a1(a);
-    MPZ_BEGIN_CRITICAL();
-    mpz_tdiv_q_2exp(m_tmp, a1(), k);
+    scratch_mpz_t tmp(m_tmp);
+    mpz_tdiv_q_2exp(tmp(), a1(), k);
     mk_big(a);
-    mpz_swap(*a.m_ptr, m_tmp);
-    MPZ_END_CRITICAL();
+    mpz_swap(*a.m_ptr, tmp());
 #endif    
 }
 
@@ -2269,10 +2298,9 @@ unsigned mpz_manager<SYNCH>::mlog2(mpz const & a) {
     else
         return (sz - 1)*32 + ::log2(static_cast<unsigned>(ds[sz-1]));
 #else
-    MPZ_BEGIN_CRITICAL();
-    mpz_neg(m_tmp, *a.m_ptr);
-    unsigned r = mpz_sizeinbase(m_tmp, 2);
-    MPZ_END_CRITICAL();
+    scratch_mpz_t tmp(m_tmp);
+    mpz_neg(tmp(), *a.m_ptr);
+    unsigned r = mpz_sizeinbase(tmp(), 2);
     SASSERT(r > 0);
     return r - 1;
 #endif
@@ -2456,16 +2484,14 @@ bool mpz_manager<SYNCH>::decompose(mpz const & a, svector<digit_t> & digits) {
         return a.m_val < 0;
 #else
     bool r = is_neg(a);
-    MPZ_BEGIN_CRITICAL();
-    mpz_set(m_tmp, *a.m_ptr);
-    mpz_abs(m_tmp, m_tmp);
-    while (mpz_sgn(m_tmp) != 0) {
-      mpz_tdiv_r_2exp(m_tmp2, m_tmp, 32);
-      unsigned v = mpz_get_ui(m_tmp2);
+    scratch_mpz_t tmp(m_tmp), tmp2(m_tmp2);
+    mpz_abs(tmp(), *a.m_ptr);
+    while (mpz_sgn(tmp()) != 0) {
+      mpz_tdiv_r_2exp(tmp2(), tmp(), 32);
+      unsigned v = mpz_get_ui(tmp2());
       digits.push_back(v);
-      mpz_tdiv_q_2exp(m_tmp, m_tmp, 32);
+      mpz_tdiv_q_2exp(tmp(), tmp(), 32);
     }
-    MPZ_END_CRITICAL();
     return r;
 #endif
     }
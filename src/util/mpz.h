@@ -136,14 +136,6 @@ inline void swap(mpz & m1, mpz & m2) { m1.swap(m2); }
 template<bool SYNCH = true>
 class mpz_manager {
     mutable small_object_allocator  m_allocator;
-#ifndef SINGLE_THREAD
-    mutable std::recursive_mutex    m_lock;
-#define MPZ_BEGIN_CRITICAL() if (SYNCH) m_lock.lock()
-#define MPZ_END_CRITICAL()   if (SYNCH) m_lock.unlock()
-#else
-#define MPZ_BEGIN_CRITICAL() {}
-#define MPZ_END_CRITICAL()   {}
-#endif
     mutable mpn_manager             m_mpn_manager;
 
 #ifndef _MP_GMP
@@ -340,6 +332,18 @@ class mpz_manager {
         ~ensure_mpz_t();
         mpz_t& operator()() { return *m_result; }
     };
+
+    // The shared temporary m_tmp (or m_tmp2) of an unsynchronized manager, or a
+    // local one for a synchronized manager, so that threads sharing a manager
+    // do not serialize on a lock around the temporaries.
+    class scratch_mpz_t {
+        mpz_t  m_local;
+        mpz_t* m_result;
+    public:
+        scratch_mpz_t(mpz_t& shared): m_result(SYNCH ? &m_local : &shared) { if (SYNCH) mpz_init(m_local); }
+        ~scratch_mpz_t() { if (SYNCH) mpz_clear(m_local); }
+        mpz_t& operator()() { return *m_result; }
+    };
     
     void mk_big(mpz & a) {
         if (a.m_ptr == nullptr) {
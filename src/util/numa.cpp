@@ -0,0 +1,169 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    numa.cpp
+
+Abstract:
+
+    Placement of worker threads of the parallel modes on NUMA nodes.
+
+    Nodes and their CPUs are read from /sys/devices/system/node, so there
+    is no dependency on libnuma.
+
+--*/
+
+#include "util/numa.h"
+#include "util/gparams.h"
+#include "util/mutex.h"
+#include "util/vector.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#if defined(__linux__) && !defined(SINGLE_THREAD)
+#include <pthread.h>
+#include <sched.h>
+#define Z3_NUMA_LINUX
+#endif
+
+namespace numa {
+
+    bool affinity_enabled(params_ref const& p) {
+        return p.get_bool("affinity", gparams::get_module("parallel"), false);
+    }
+
+#ifdef Z3_NUMA_LINUX
+
+    static char const* node_dir = "/sys/devices/system/node/node";
+
+    /**
+       \brief parse a list of CPU ranges, such as 0-3,8-11.
+     */
+    static void parse_cpulist(std::string const& s, unsigned_vector& cpus) {
+        std::istringstream in(s);
+        std::string range;
+        while (std::getline(in, range, ',')) {
+            if (range.empty() || range[0] < '0' || range[0] > '9')
+                continue;
+            size_t dash = range.find('-');
+            unsigned lo = std::stoul(range.substr(0, dash));
+            unsigned hi = dash == std::string::npos ? lo : std::stoul(range.substr(dash + 1));
+            for (unsigned c = lo; c <= hi; ++c)
+                cpus.push_back(c);
+        }
+    }
+
+    /**
+       \brief CPUs of the nodes that have CPUs. Computed on first use.
+     */
+    static vector<unsigned_vector> const& node_cpus() {
+        static vector<unsigned_vector> nodes;
+        static bool initialized = false;
+        static mutex mux;
+        lock_guard lock(mux);
+        if (initialized)
+            return nodes;
+        initialized = true;
+        for (unsigned n = 0; ; ++n) {
+            std::ifstream in(node_dir + std::to_string(n) + "/cpulist");
+            if (!in)
+                break;
+            std::string line;
+            std::getline(in, line);
+            unsigned_vector cpus;
+            parse_cpulist(line, cpus);
+            if (!cpus.empty())
+                nodes.push_back(cpus);
+        }
+        return nodes;
+    }
+
+    unsigned num_nodes() {
+        return node_cpus().size();
+    }
+
+    bool bind_worker(unsigned worker_id) {
+        auto const& nodes = node_cpus();
+        if (nodes.size() <= 1)
+            return false;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (unsigned c : nodes[worker_id % nodes.size()])
+            if (c < CPU_SETSIZE)
+                CPU_SET(c, &set);
+        return 0 == pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    scoped_bind::scoped_bind(bool enabled, unsigned worker_id) {
+        if (!enabled)
+            return;
+        cpu_set_t* saved = alloc(cpu_set_t);
+        if (0 != pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), saved) || !bind_worker(worker_id)) {
+            dealloc(saved);
+            return;
+        }
+        m_saved = saved;
+    }
+
+    scoped_bind::~scoped_bind() {
+        if (!m_saved)
+            return;
+        cpu_set_t* saved = static_cast<cpu_set_t*>(m_saved);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), saved);
+        dealloc(saved);
+    }
+
+    counters get_counters() {
+        counters r;
+        for (unsigned n = 0; ; ++n) {
+            std::ifstream in(node_dir + std::to_string(n) + "/numastat");
+            if (!in)
+                break;
+            std::string key;
+            unsigned long long value;
+            while (in >> key >> value) {
+                if (key == "local_node")
+                    r.m_local += value;
+                else if (key == "other_node")
+                    r.m_remote += value;
+            }
+        }
+        return r;
+    }
+
+#else
+
+    unsigned num_nodes() {
+        return 1;
+    }
+
+    bool bind_worker(unsigned worker_id) {
+        return false;
+    }
+
+    scoped_bind::scoped_bind(bool enabled, unsigned worker_id) {}
+
+    scoped_bind::~scoped_bind() {}
+
+    counters get_counters() {
+        return counters();
+    }
+
+#endif
+
+    scoped_stats::scoped_stats(bool enabled): m_enabled(enabled) {
+        if (m_enabled)
+            m_start = get_counters();
+    }
+
+    void scoped_stats::collect_statistics(statistics& st) const {
+        if (!m_enabled)
+            return;
+        counters c = get_counters();
+        unsigned long long local = c.m_local - m_start.m_local;
+        unsigned long long remote = c.m_remote - m_start.m_remote;
+        if (local + remote > 0)
+            st.update("numa remote ratio", static_cast<double>(remote) / static_cast<double>(local + remote));
+    }
+}
@@ -0,0 +1,78 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    numa.h
+
+Abstract:
+
+    Placement of worker threads of the parallel modes on NUMA nodes.
+
+    With parallel.affinity enabled, worker i is pinned to the CPUs of
+    node i mod the number of nodes. Workers that allocate their own state
+    after they are pinned get it on their local node by first-touch
+    placement of the operating system. The counters of local and remote
+    node allocations let the parallel modes report the fraction of
+    allocations that ended up on a remote node.
+
+    Placement is supported on Linux. Elsewhere, and when compiled with
+    SINGLE_THREAD, the functions do nothing.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+#include "util/statistics.h"
+
+namespace numa {
+
+    /**
+       \brief true if parallel.affinity is set in p or in the global
+       parameters of the parallel module.
+     */
+    bool affinity_enabled(params_ref const& p);
+
+    unsigned num_nodes();
+
+    /**
+       \brief pin the calling thread to the CPUs of the node of worker_id.
+       Return false if the thread was not pinned.
+     */
+    bool bind_worker(unsigned worker_id);
+
+    /**
+       \brief pin the calling thread like worker_id, if enabled, and restore
+       its previous CPUs on destruction. Threads of the shared thread pool
+       are bound for the duration of one task only.
+     */
+    class scoped_bind {
+        void* m_saved = nullptr;
+    public:
+        scoped_bind(bool enabled, unsigned worker_id);
+        ~scoped_bind();
+    };
+
+    struct counters {
+        unsigned long long m_local = 0;    // pages allocated on the node of the allocating thread
+        unsigned long long m_remote = 0;   // pages allocated on a different node
+    };
+
+    /**
+       \brief node allocation counters, summed over all nodes.
+       The counters are system wide.
+     */
+    counters get_counters();
+
+    /**
+       \brief take the counters at construction and report the fraction
+       of remote allocations since then as "numa remote ratio".
+     */
+    class scoped_stats {
+        bool     m_enabled;
+        counters m_start;
+    public:
+        scoped_stats(bool enabled);
+        void collect_statistics(statistics& st) const;
+    };
+}
@@ -36,6 +36,7 @@ class params_ref {
     void init();
     void copy_core(params const * p);
     void set(params_ref const& p);
+    friend class gparams;
 public:
     params_ref():m_params(nullptr) {}
     params_ref(params_ref const & p);
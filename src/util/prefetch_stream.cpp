@@ -0,0 +1,101 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    prefetch_stream.cpp
+
+Abstract:
+
+    Input stream that reads its source on a background thread.
+
+--*/
+
+#include "util/prefetch_stream.h"
+
+prefetch_streambuf::prefetch_streambuf(std::istream & in, unsigned block_size, unsigned max_blocks):
+    m_in(in),
+    m_block_size(block_size == 0 ? 1 : block_size),
+    m_max_blocks(max_blocks == 0 ? 1 : max_blocks) {
+    setg(nullptr, nullptr, nullptr);
+#ifndef SINGLE_THREAD
+    m_reader = std::thread([this]() { read_loop(); });
+#endif
+}
+
+prefetch_streambuf::~prefetch_streambuf() {
+#ifndef SINGLE_THREAD
+    {
+        std::lock_guard<std::mutex> lock(m_mux);
+        m_cancel = true;
+    }
+    m_cv.notify_all();
+    m_reader.join();
+#endif
+}
+
+/**
+   \brief Fill blk with the next block of the source.
+   Return false if the end of the source was reached.
+*/
+bool prefetch_streambuf::read_block(std::string & blk) {
+    blk.resize(m_block_size);
+    m_in.read(&blk[0], m_block_size);
+    blk.resize(static_cast<size_t>(m_in.gcount()));
+    return !blk.empty() && m_in.good();
+}
+
+void prefetch_streambuf::read_loop() {
+#ifndef SINGLE_THREAD
+    bool more = true;
+    while (more) {
+        std::string blk;
+        {
+            std::unique_lock<std::mutex> lock(m_mux);
+            m_cv.wait(lock, [&] { return m_cancel || m_full.size() < m_max_blocks; });
+            if (m_cancel)
+                return;
+            if (!m_free.empty()) {
+                blk.swap(m_free.back());
+                m_free.pop_back();
+            }
+        }
+        more = read_block(blk);
+        {
+            std::lock_guard<std::mutex> lock(m_mux);
+            if (!blk.empty())
+                m_full.push_back(std::move(blk));
+            m_eof = !more;
+        }
+        m_cv.notify_all();
+    }
+#endif
+}
+
+prefetch_streambuf::int_type prefetch_streambuf::underflow() {
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+#ifndef SINGLE_THREAD
+    {
+        std::unique_lock<std::mutex> lock(m_mux);
+        if (m_curr.capacity() > 0)
+            m_free.push_back(std::move(m_curr));
+        m_curr.clear();
+        m_cv.wait(lock, [&] { return !m_full.empty() || m_eof; });
+        if (m_full.empty())
+            return traits_type::eof();
+        m_curr = std::move(m_full.front());
+        m_full.pop_front();
+    }
+    m_cv.notify_all();
+#else
+    if (m_eof)
+        return traits_type::eof();
+    m_eof = !read_block(m_curr);
+    if (m_curr.empty())
+        return traits_type::eof();
+#endif
+    char * b = &m_curr[0];
+    setg(b, b, b + m_curr.size());
+    return traits_type::to_int_type(*gptr());
+}
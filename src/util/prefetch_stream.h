@@ -0,0 +1,66 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    prefetch_stream.h
+
+Abstract:
+
+    Input stream that reads its source on a background thread.
+
+    Blocks of the source stream are read ahead into a bounded queue,
+    so that I/O overlaps with the work done by the consumer. Memory
+    use is bounded by block_size * max_blocks, independently of the
+    size of the input. When compiled with SINGLE_THREAD, blocks are
+    read synchronously.
+
+--*/
+#pragma once
+
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <deque>
+#include <vector>
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+class prefetch_streambuf : public std::streambuf {
+    std::istream &           m_in;
+    unsigned                 m_block_size;
+    unsigned                 m_max_blocks;
+    std::deque<std::string>  m_full;  // blocks read ahead, in input order
+    std::vector<std::string> m_free;  // consumed blocks, recycled by the reader
+    std::string              m_curr;  // block exposed through the get area
+    bool                     m_eof = false;
+#ifndef SINGLE_THREAD
+    bool                     m_cancel = false;
+    std::mutex               m_mux;
+    std::condition_variable  m_cv;
+    std::thread              m_reader;
+#endif
+
+    bool read_block(std::string & blk);
+    void read_loop();
+
+protected:
+    int_type underflow() override;
+
+public:
+    prefetch_streambuf(std::istream & in, unsigned block_size = 1 << 20, unsigned max_blocks = 4);
+    ~prefetch_streambuf() override;
+};
+
+class prefetch_istream : public std::istream {
+    prefetch_streambuf m_buf;
+public:
+    prefetch_istream(std::istream & in, unsigned block_size = 1 << 20, unsigned max_blocks = 4):
+        std::istream(nullptr),
+        m_buf(in, block_size, max_blocks) {
+        rdbuf(&m_buf);
+    }
+};
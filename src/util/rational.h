@@ -158,8 +158,17 @@ public:
         return result;
     }
     
+    // Arithmetic on small integers is done inline on int64_t, set() moves the
+    // result to a big number if it leaves the small range.
+    bool is_small_int() const { return synch_mpq_manager::is_small_int(m_val); }
+
+    int64_t get_small_int() const { return synch_mpq_manager::get_small_int(m_val); }
+
     rational & operator+=(rational const & r) { 
-        m().add(m_val, r.m_val, m_val);
+        if (is_small_int() && r.is_small_int())
+            m().set(m_val, get_small_int() + r.get_small_int());
+        else
+            m().add(m_val, r.m_val, m_val);
         return *this; 
     }
 
@@ -169,7 +178,10 @@ public:
     }
 
     rational & operator-=(rational const & r) { 
-        m().sub(m_val, r.m_val, m_val);
+        if (is_small_int() && r.is_small_int())
+            m().set(m_val, get_small_int() - r.get_small_int());
+        else
+            m().sub(m_val, r.m_val, m_val);
         return *this; 
     }
 
@@ -179,7 +191,10 @@ public:
     }
 
     rational & operator*=(rational const & r) {
-        m().mul(m_val, r.m_val, m_val);
+        if (is_small_int() && r.is_small_int())
+            m().set(m_val, get_small_int() * r.get_small_int());
+        else
+            m().mul(m_val, r.m_val, m_val);
         return *this; 
     }    
 
@@ -367,7 +382,9 @@ public:
     }
 
     void addmul(rational const & c, rational const & k) {
-        if (c.is_one())
+        if (is_small_int() && c.is_small_int() && k.is_small_int())
+            m().set(m_val, get_small_int() + c.get_small_int() * k.get_small_int());
+        else if (c.is_one())
             operator+=(k);
         else if (c.is_minus_one())
             operator-=(k);
@@ -384,7 +401,9 @@ public:
 
     // Perform:  this -= c * k
     void submul(const rational & c, const rational & k) {
-        if (c.is_one())
+        if (is_small_int() && c.is_small_int() && k.is_small_int())
+            m().set(m_val, get_small_int() - c.get_small_int() * k.get_small_int());
+        else if (c.is_one())
             operator-=(k);
         else if (c.is_minus_one())
             operator+=(k);
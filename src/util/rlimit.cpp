@@ -34,6 +34,7 @@ void finalize_rlimit() {
 reslimit::reslimit():
     m_cancel(0),
     m_suspend(false),
+    m_poll(1),
     m_count(0),
     m_limit(std::numeric_limits<uint64_t>::max()) {
 }
@@ -42,16 +43,6 @@ uint64_t reslimit::count() const {
     return m_count;
 }
 
-bool reslimit::inc() {
-    ++m_count;
-    return not_canceled();
-}
-
-bool reslimit::inc(unsigned offset) {
-    m_count += offset;
-    return not_canceled();
-}
-
 void reslimit::push(unsigned delta_limit) {
     uint64_t new_limit = delta_limit ? delta_limit + m_count : std::numeric_limits<uint64_t>::max();
     if (new_limit <= m_count) {
@@ -60,6 +51,7 @@ void reslimit::push(unsigned delta_limit) {
     m_limits.push_back(m_limit);
     m_limit = std::min(new_limit, m_limit);
     m_cancel = 0;
+    m_poll = 1;
 }
 
 void reslimit::pop() {
@@ -69,6 +61,7 @@ void reslimit::pop() {
     m_limit = m_limits.back();
     m_limits.pop_back();
     m_cancel = 0;
+    m_poll = 1;
 }
 
 char const* reslimit::get_cancel_msg() const {
@@ -29,8 +29,12 @@ void finalize_rlimit();
 */
 
 class reslimit {
+    // the cancellation flag is shared with other threads and is polled
+    // only every m_poll_period calls to inc(); the resource count is exact.
+    static const unsigned m_poll_period = 64;
     std::atomic<unsigned> m_cancel;
     bool            m_suspend;
+    unsigned        m_poll;
     uint64_t        m_count;
     uint64_t        m_limit;
     svector<uint64_t> m_limits;
@@ -46,8 +50,16 @@ public:
     void push_child(reslimit* r);
     void pop_child();
 
-    bool inc();
-    bool inc(unsigned offset);
+    inline bool inc() { return inc(1); }
+    inline bool inc(unsigned offset) {
+        m_count += offset;
+        if (m_count > m_limit)
+            return m_suspend;
+        if (--m_poll > 0)
+            return true;
+        m_poll = m_poll_period;
+        return m_cancel.load(std::memory_order_relaxed) == 0 || m_suspend;
+    }
     uint64_t count() const;
 
     bool suspended() const { return m_suspend;  }
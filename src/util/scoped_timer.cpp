@@ -16,13 +16,18 @@ Author:
 Revision History:
 
     Nuno Lopes (nlopes) 2019-02-04  - use C++11 goodies
+    
+    All timers are served by one thread that keeps the pending
+    deadlines in a heap. Disarming a timer only bumps its generation 
+    number; stale heap entries are discarded when they surface or when 
+    they start to dominate the heap.
 
 --*/
 
 #include "util/scoped_timer.h"
 #include "util/mutex.h"
 #include "util/util.h"
-#include <atomic>
+#include <algorithm>
 #include <chrono>
 #include <climits>
 #include <condition_variable>
@@ -33,81 +38,115 @@ Revision History:
 #include <pthread.h>
 #endif
 
-enum scoped_timer_work_state { IDLE = 0, WORKING = 1, EXITING = 2 };
+typedef std::chrono::steady_clock::time_point timer_deadline;
 
 struct scoped_timer_state {
-    std::thread m_thread;
-    std::timed_mutex m_mutex;
-    event_handler * eh;
-    unsigned ms;
-    std::atomic<scoped_timer_work_state> work;
-    std::condition_variable_any cv;
+    event_handler * eh = nullptr;
+    unsigned        generation = 0;
+    bool            armed = false;
 };
 
-static std::vector<scoped_timer_state*> available_workers;
-static std::mutex workers;
-static atomic<unsigned> num_workers(0);
-
-static void thread_func(scoped_timer_state *s) {
-    workers.lock();
-    while (true) {
-        s->cv.wait(workers, [=]{ return s->work != IDLE; });
-        workers.unlock();
+struct timer_entry {
+    timer_deadline       end;
+    scoped_timer_state * s;
+    unsigned             generation;
+    bool operator<(timer_entry const& other) const { return end > other.end; } // min-heap on deadline
+};
 
-        if (s->work == EXITING)
-            return;
+static std::mutex                        timer_mux;
+// the thread and the condition variables it waits on are not static objects:
+// they must outlive static destruction when the process exits without finalize.
+static std::condition_variable &         timer_cv = *new std::condition_variable;  // new earliest deadline or exit request
+static std::condition_variable &         fired_cv = *new std::condition_variable;  // a handler has finished running
+static std::vector<timer_entry>          timer_heap;
+static std::vector<scoped_timer_state*>  free_states;
+static std::thread *                     timer_thread = nullptr;
+static scoped_timer_state *              firing = nullptr;
+static unsigned                          num_armed = 0;
+static bool                              timer_running = false;
+static bool                              timer_exiting = false;
+
+static bool is_stale(timer_entry const& e) {
+    return !e.s->armed || e.s->generation != e.generation;
+}
 
-        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(s->ms);
+// remove disarmed entries once they make up most of the heap.
+static void compact_heap() {
+    if (timer_heap.size() < 64 || timer_heap.size() < 4 * num_armed)
+        return;
+    timer_heap.erase(std::remove_if(timer_heap.begin(), timer_heap.end(), is_stale), timer_heap.end());
+    std::make_heap(timer_heap.begin(), timer_heap.end());
+}
 
-        while (!s->m_mutex.try_lock_until(end)) {
-            if (std::chrono::steady_clock::now() >= end) {
-                s->eh->operator()(TIMEOUT_EH_CALLER);
-                goto next;
-            }
+static void thread_func() {
+    std::unique_lock<std::mutex> lock(timer_mux);
+    while (true) {
+        while (!timer_heap.empty() && is_stale(timer_heap.front())) {
+            std::pop_heap(timer_heap.begin(), timer_heap.end());
+            timer_heap.pop_back();
         }
-
-        s->m_mutex.unlock();
-
-    next:
-        s->work = IDLE;
-        workers.lock();
+        if (timer_exiting && num_armed == 0)
+            return;
+        if (timer_heap.empty()) {
+            timer_cv.wait(lock);
+            continue;
+        }
+        timer_entry e = timer_heap.front();
+        if (std::chrono::steady_clock::now() < e.end) {
+            timer_cv.wait_until(lock, e.end);
+            continue;
+        }
+        std::pop_heap(timer_heap.begin(), timer_heap.end());
+        timer_heap.pop_back();
+        firing = e.s;
+        lock.unlock();
+        e.s->eh->operator()(TIMEOUT_EH_CALLER);
+        lock.lock();
+        firing = nullptr;
+        // the timer fired, it stays armed until the owner destroys it.
+        fired_cv.notify_all();
     }
 }
 
-
 scoped_timer::scoped_timer(unsigned ms, event_handler * eh) {
     if (ms == 0 || ms == UINT_MAX)
         return;
-
-    workers.lock();
-    if (available_workers.empty()) {
-        // start new thead
-        workers.unlock();
+    timer_deadline end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    std::lock_guard<std::mutex> lock(timer_mux);
+    if (free_states.empty()) {
         s = new scoped_timer_state;
-        ++num_workers;
-        init_state(ms, eh);
-        s->m_thread = std::thread(thread_func, s);
     }
     else {
-        // re-use existing thread
-        s = available_workers.back();
-        available_workers.pop_back();
-        init_state(ms, eh);
-        workers.unlock();
-        s->cv.notify_one();
+        s = free_states.back();
+        free_states.pop_back();
+    }
+    init_state(ms, eh);
+    ++num_armed;
+    timer_heap.push_back({ end, s, s->generation });
+    std::push_heap(timer_heap.begin(), timer_heap.end());
+    if (!timer_running) {
+        timer_running = true;
+        timer_exiting = false;
+        timer_thread = new std::thread(thread_func);
+    }
+    else if (timer_heap.front().s == s) {
+        timer_cv.notify_one();
     }
 }
     
 scoped_timer::~scoped_timer() {
     if (!s)
         return;
-
-    s->m_mutex.unlock();
-    while (s->work == WORKING)
-        std::this_thread::yield();
-    workers.lock();
-    available_workers.push_back(s);
-    workers.unlock();
+    std::unique_lock<std::mutex> lock(timer_mux);
+    while (firing == s)
+        fired_cv.wait(lock);
+    s->armed = false;
+    ++s->generation;
+    --num_armed;
+    free_states.push_back(s);
+    compact_heap();
+    if (timer_exiting && num_armed == 0)
+        timer_cv.notify_one();
 }
 
 void scoped_timer::initialize() {
@@ -121,30 +160,27 @@ void scoped_timer::initialize() {
 }
 
 void scoped_timer::finalize() {
-    unsigned deleted = 0;
-    while (deleted < num_workers) {
-        workers.lock();
-        for (auto w : available_workers) {
-            w->work = EXITING;
-            w->cv.notify_one();
-        }
-        decltype(available_workers) cleanup_workers;
-        std::swap(available_workers, cleanup_workers);
-        workers.unlock();
-
-        for (auto w : cleanup_workers) {
-            ++deleted;
-            w->m_thread.join();
-            delete w;
-        }
+    // the timer thread exits once all armed timers have been destroyed.
+    {
+        std::lock_guard<std::mutex> lock(timer_mux);
+        if (!timer_running)
+            return;
+        timer_exiting = true;
+        timer_cv.notify_one();
     }
-    num_workers = 0;
-    available_workers.clear();
+    timer_thread->join();
+    std::lock_guard<std::mutex> lock(timer_mux);
+    delete timer_thread;
+    timer_thread = nullptr;
+    timer_running = false;
+    timer_exiting = false;
+    timer_heap.clear();
+    for (auto st : free_states)
+        delete st;
+    free_states.clear();
 }
 
 void scoped_timer::init_state(unsigned ms, event_handler * eh) {
-    s->ms = ms;
     s->eh = eh;
-    s->m_mutex.lock();
-    s->work = WORKING;
+    s->armed = true;
 }
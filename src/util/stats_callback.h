@@ -0,0 +1,74 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    stats_callback.h
+
+Abstract:
+
+    Periodic push of the statistics of a running check.
+
+    A solver polls due() from its search loop. The clock is only read
+    every few polls, so polling is cheap; when the interval has passed,
+    the solver collects its statistics and passes them to report(),
+    which adds the elapsed time, the memory in use and the conflict rate
+    since the previous report, and invokes the callback on the thread of
+    the solver.
+
+--*/
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include "util/statistics.h"
+
+typedef std::function<void(statistics const&)> stats_eh;
+
+class stats_callback {
+    typedef std::chrono::steady_clock clock;
+    stats_eh          m_eh;
+    unsigned          m_interval_ms = 0;
+    unsigned          m_polls = 0;
+    clock::time_point m_start, m_last, m_next;
+    unsigned          m_last_conflicts = 0;
+
+public:
+    void set(unsigned interval_ms, stats_eh const& eh) {
+        m_interval_ms = interval_ms;
+        m_eh = interval_ms > 0 ? eh : stats_eh();
+    }
+
+    bool enabled() const { return static_cast<bool>(m_eh); }
+
+    /**
+       \brief start the clock at the beginning of a check.
+    */
+    void start() {
+        if (!enabled())
+            return;
+        m_start = m_last = clock::now();
+        m_next = m_start + std::chrono::milliseconds(m_interval_ms);
+        m_last_conflicts = 0;
+        m_polls = 0;
+    }
+
+    bool due() {
+        if (!m_eh || (++m_polls & 0x3f) != 0)
+            return false;
+        return clock::now() >= m_next;
+    }
+
+    void report(statistics& st, unsigned num_conflicts) {
+        clock::time_point now = clock::now();
+        double elapsed = std::chrono::duration<double>(now - m_last).count();
+        if (elapsed > 0 && num_conflicts >= m_last_conflicts)
+            st.update("conflicts per second", static_cast<double>(num_conflicts - m_last_conflicts) / elapsed);
+        st.update("time", std::chrono::duration<double>(now - m_start).count());
+        get_memory_statistics(st);
+        m_last = now;
+        m_next = now + std::chrono::milliseconds(m_interval_ms);
+        m_last_conflicts = num_conflicts;
+        m_eh(st);
+    }
+};
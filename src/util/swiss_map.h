@@ -0,0 +1,360 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    swiss_map.h
+
+Abstract:
+
+    Open addressing map with a byte of control information per slot.
+
+    The control byte of a used slot holds 7 bits of the hash of its key,
+    the control byte of a free slot has the high bit set. A lookup
+    compares the control bytes of 16 consecutive slots at once, with SSE2
+    where available, and only compares the keys of the slots whose
+    control byte matches. Slots are probed linearly from the home slot of
+    the key, and erase shifts the following entries of the probe sequence
+    back, so there are no deleted markers and lookups never degrade after
+    many erasures.
+
+    The interface follows obj_map and u_map: obj_swiss_map and
+    u_swiss_map can replace them where the map is not searched through
+    find_core entries that outlive an insertion.
+
+--*/
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include "util/debug.h"
+#include "util/hash.h"
+#include "util/map.h"
+#include "util/memory_manager.h"
+#include "util/util.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define Z3_SWISS_MAP_SSE2
+#endif
+
+template<typename Key, typename Value, typename HashProc, typename EqProc>
+class swiss_map : private HashProc, private EqProc {
+public:
+    struct key_data {
+        Key   m_key;
+        Value m_value;
+        key_data(Key const & k, Value const & v): m_key(k), m_value(v) {}
+        key_data(Key const & k, Value && v): m_key(k), m_value(std::move(v)) {}
+        key_data & get_data() { return *this; }
+        key_data const & get_data() const { return *this; }
+    };
+    typedef key_data entry;
+
+    static const unsigned group_size = 16;
+
+private:
+    static const uint8_t ctrl_free = 0x80;
+
+    uint8_t *  m_ctrl = nullptr;      // m_capacity + group_size bytes, the last group mirrors the first
+    key_data * m_slots = nullptr;
+    unsigned   m_capacity = 0;
+    unsigned   m_size = 0;
+
+    unsigned hash_of(Key const & k) const { return HashProc::operator()(k) * 0x9E3779B1u; }
+    unsigned home(unsigned h) const { return (h >> 7) & (m_capacity - 1); }
+    static uint8_t h2(unsigned h) { return static_cast<uint8_t>(h & 0x7f); }
+    bool is_used(unsigned i) const { return m_ctrl[i] < ctrl_free; }
+
+    void set_ctrl(unsigned i, uint8_t c) {
+        m_ctrl[i] = c;
+        if (i < group_size)
+            m_ctrl[m_capacity + i] = c;
+    }
+
+    // bit i is set if the control byte at g[i] equals c
+    static unsigned match(uint8_t const * g, uint8_t c) {
+#ifdef Z3_SWISS_MAP_SSE2
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(g));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(c)))));
+#else
+        unsigned r = 0;
+        for (unsigned i = 0; i < group_size; ++i)
+            if (g[i] == c)
+                r |= (1u << i);
+        return r;
+#endif
+    }
+
+    static unsigned match_free(uint8_t const * g) {
+#ifdef Z3_SWISS_MAP_SSE2
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(g))));
+#else
+        unsigned r = 0;
+        for (unsigned i = 0; i < group_size; ++i)
+            if (g[i] & ctrl_free)
+                r |= (1u << i);
+        return r;
+#endif
+    }
+
+    static unsigned lowest_bit(unsigned m) {
+        unsigned i = 0;
+        while ((m & 1) == 0)
+            m >>= 1, ++i;
+        return i;
+    }
+
+    /**
+       \brief index of the slot of k, or UINT_MAX. If k is not in the map,
+       free is set to the slot where it would be inserted.
+    */
+    unsigned find_slot(Key const & k, unsigned h, unsigned & free) const {
+        unsigned mask = m_capacity - 1;
+        unsigned pos = home(h);
+        uint8_t c = h2(h);
+        while (true) {
+            uint8_t const * g = m_ctrl + pos;
+            unsigned m = match(g, c);
+            unsigned f = match_free(g);
+            if (f != 0)
+                m &= (f & (0 - f)) - 1;     // slots past the first free slot are not in the probe sequence
+            for (; m != 0; m &= m - 1) {
+                unsigned i = (pos + lowest_bit(m)) & mask;
+                if (EqProc::operator()(m_slots[i].m_key, k))
+                    return i;
+            }
+            if (f != 0) {
+                free = (pos + lowest_bit(f)) & mask;
+                return UINT_MAX;
+            }
+            pos = (pos + group_size) & mask;
+        }
+    }
+
+    unsigned find_index(Key const & k) const {
+        if (m_size == 0)
+            return UINT_MAX;
+        unsigned free;
+        return find_slot(k, hash_of(k), free);
+    }
+
+    void alloc_table(unsigned capacity) {
+        m_capacity = capacity;
+        m_ctrl = static_cast<uint8_t *>(memory::allocate(capacity + group_size));
+        memset(m_ctrl, ctrl_free, capacity + group_size);
+        m_slots = static_cast<key_data *>(memory::allocate(sizeof(key_data) * capacity));
+    }
+
+    void destroy_table() {
+        if (!m_ctrl)
+            return;
+        for (unsigned i = 0; i < m_capacity; ++i)
+            if (is_used(i))
+                m_slots[i].~key_data();
+        memory::deallocate(m_ctrl);
+        memory::deallocate(m_slots);
+        m_ctrl = nullptr;
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+    }
+
+    void expand_table() {
+        uint8_t * old_ctrl = m_ctrl;
+        key_data * old_slots = m_slots;
+        unsigned old_capacity = m_capacity;
+        alloc_table(old_capacity == 0 ? group_size : 2 * old_capacity);
+        unsigned mask = m_capacity - 1;
+        for (unsigned i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] >= ctrl_free)
+                continue;
+            unsigned h = hash_of(old_slots[i].m_key);
+            unsigned pos = home(h);
+            unsigned f;
+            while ((f = match_free(m_ctrl + pos)) == 0)
+                pos = (pos + group_size) & mask;
+            unsigned j = (pos + lowest_bit(f)) & mask;
+            new (m_slots + j) key_data(std::move(old_slots[i]));
+            old_slots[i].~key_data();
+            set_ctrl(j, h2(h));
+        }
+        if (old_ctrl) {
+            memory::deallocate(old_ctrl);
+            memory::deallocate(old_slots);
+        }
+    }
+
+    // keep at least one free slot in every probe sequence: load factor at most 7/8
+    bool needs_expand() const { return 8 * (m_size + 1) > 7 * m_capacity; }
+
+    template<typename V>
+    key_data & insert_core(Key const & k, V && v, bool overwrite) {
+        if (needs_expand())
+            expand_table();
+        unsigned h = hash_of(k);
+        unsigned free;
+        unsigned i = find_slot(k, h, free);
+        if (i != UINT_MAX) {
+            if (overwrite)
+                m_slots[i].m_value = std::forward<V>(v);
+            return m_slots[i];
+        }
+        new (m_slots + free) key_data(k, std::forward<V>(v));
+        set_ctrl(free, h2(h));
+        ++m_size;
+        return m_slots[free];
+    }
+
+    void erase_index(unsigned i) {
+        unsigned mask = m_capacity - 1;
+        m_slots[i].~key_data();
+        // shift back the entries whose home slot is not between the hole and themselves
+        for (unsigned j = (i + 1) & mask; is_used(j); j = (j + 1) & mask) {
+            unsigned hj = home(hash_of(m_slots[j].m_key));
+            if (((j - hj) & mask) < ((j - i) & mask))
+                continue;
+            new (m_slots + i) key_data(std::move(m_slots[j]));
+            m_slots[j].~key_data();
+            set_ctrl(i, m_ctrl[j]);
+            i = j;
+        }
+        set_ctrl(i, ctrl_free);
+        --m_size;
+    }
+
+public:
+    class iterator {
+        swiss_map const * m_map;
+        unsigned          m_idx;
+        void move_to_used() {
+            while (m_idx < m_map->m_capacity && !m_map->is_used(m_idx))
+                ++m_idx;
+        }
+    public:
+        iterator(swiss_map const * m, unsigned idx): m_map(m), m_idx(idx) { move_to_used(); }
+        key_data & operator*() const { return m_map->m_slots[m_idx]; }
+        key_data * operator->() const { return m_map->m_slots + m_idx; }
+        iterator & operator++() { ++m_idx; move_to_used(); return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+        bool operator==(iterator const & it) const { return m_idx == it.m_idx; }
+        bool operator!=(iterator const & it) const { return m_idx != it.m_idx; }
+    };
+
+    swiss_map(HashProc const & h = HashProc(), EqProc const & e = EqProc()): HashProc(h), EqProc(e) {}
+
+    swiss_map(swiss_map && other) noexcept:
+        HashProc(other), EqProc(other),
+        m_ctrl(other.m_ctrl), m_slots(other.m_slots), m_capacity(other.m_capacity), m_size(other.m_size) {
+        other.m_ctrl = nullptr;
+        other.m_slots = nullptr;
+        other.m_capacity = 0;
+        other.m_size = 0;
+    }
+
+    swiss_map(swiss_map const & other): HashProc(other), EqProc(other) {
+        for (key_data const & kd : other)
+            insert(kd.m_key, kd.m_value);
+    }
+
+    swiss_map & operator=(swiss_map const & other) {
+        if (this != &other) {
+            reset();
+            for (key_data const & kd : other)
+                insert(kd.m_key, kd.m_value);
+        }
+        return *this;
+    }
+
+    ~swiss_map() { destroy_table(); }
+
+    void reset() {
+        if (m_size == 0)
+            return;
+        for (unsigned i = 0; i < m_capacity; ++i)
+            if (is_used(i))
+                m_slots[i].~key_data();
+        memset(m_ctrl, ctrl_free, m_capacity + group_size);
+        m_size = 0;
+    }
+
+    void finalize() { destroy_table(); }
+
+    bool empty() const { return m_size == 0; }
+
+    unsigned size() const { return m_size; }
+
+    unsigned capacity() const { return m_capacity; }
+
+    iterator begin() const { return iterator(this, 0); }
+
+    iterator end() const { return iterator(this, m_capacity); }
+
+    void insert(Key const & k, Value const & v) { insert_core(k, v, true); }
+
+    void insert(Key const & k, Value && v) { insert_core(k, std::move(v), true); }
+
+    Value & insert_if_not_there(Key const & k, Value const & v) { return insert_core(k, v, false).m_value; }
+
+    /**
+       \brief entry of k or nullptr. The entry is invalidated by the next
+       insertion or erasure.
+    */
+    entry * find_core(Key const & k) const {
+        unsigned i = find_index(k);
+        return i == UINT_MAX ? nullptr : m_slots + i;
+    }
+
+    bool find(Key const & k, Value & v) const {
+        unsigned i = find_index(k);
+        if (i == UINT_MAX)
+            return false;
+        v = m_slots[i].m_value;
+        return true;
+    }
+
+    Value const & find(Key const & k) const {
+        unsigned i = find_index(k);
+        SASSERT(i != UINT_MAX);
+        return m_slots[i].m_value;
+    }
+
+    Value & find(Key const & k) {
+        unsigned i = find_index(k);
+        SASSERT(i != UINT_MAX);
+        return m_slots[i].m_value;
+    }
+
+    Value const & operator[](Key const & k) const { return find(k); }
+
+    Value & operator[](Key const & k) { return find(k); }
+
+    iterator find_iterator(Key const & k) const {
+        unsigned i = find_index(k);
+        return i == UINT_MAX ? end() : iterator(this, i);
+    }
+
+    bool contains(Key const & k) const { return find_index(k) != UINT_MAX; }
+
+    void erase(Key const & k) {
+        unsigned i = find_index(k);
+        if (i != UINT_MAX)
+            erase_index(i);
+    }
+
+    void remove(Key const & k) { erase(k); }
+
+    void swap(swiss_map & other) noexcept {
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+    }
+};
+
+template<typename Key, typename Value>
+using obj_swiss_map = swiss_map<Key *, Value, obj_ptr_hash<Key>, ptr_eq<Key>>;
+
+template<typename Value>
+using u_swiss_map = swiss_map<unsigned, Value, u_hash, u_eq>;
@@ -20,6 +20,17 @@ Revision History:
 
 #include "util/tbv.h"
 #include "util/hashtable.h"
+#include "util/util.h"
+
+// the odd bits of the tbits of w that are BIT_z
+static inline unsigned z_bits(unsigned w) {
+    return ~(w | (w << 1) | 0x55555555);
+}
+
+// the even bits of the tbits of w that are not BIT_x
+static inline unsigned non_x_bits(unsigned w) {
+    return ~(w & (w >> 1)) & 0x55555555;
+}
 
 
 static bool s_debug_alloc = false;
@@ -207,43 +218,61 @@ tbv& tbv_manager::set_or(tbv& dst,  tbv const& src) const {
     return dst;
 }
 bool tbv_manager::set_and(tbv& dst,  tbv const& src) const {
-    m.set_and(dst, src); 
-    return is_well_formed(dst);
+    return intersect(src, dst, dst);
 }
 
-bool tbv_manager::is_well_formed(tbv const& dst) const {
+/**
+   \brief dst := a & b, in the same pass as the check that no tbit became BIT_z.
+   The loops are free of branches on the data, so they vectorize.
+*/
+bool tbv_manager::intersect(tbv const& a, tbv const& b, tbv& dst) const {
     unsigned nw = m.num_words();
-    unsigned w;
+    if (nw == 0) return true;
+    unsigned z = 0;
     for (unsigned i = 0; i + 1 < nw; ++i) {
-        w = dst.get_word(i);
-        w = w | (w << 1) | 0x55555555;
-        if (w != 0xFFFFFFFF) return false;
+        unsigned w = a.m_data[i] & b.m_data[i];
+        dst.m_data[i] = w;
+        z |= z_bits(w);
     }
-    if (nw > 0) {        
-        w = m.last_word(dst);
-        w = w | (w << 1) | 0x55555555 | ~m.get_mask();
-        if (w != 0xFFFFFFFF) return false;
-    }
-    return true;
+    unsigned w = a.m_data[nw - 1] & b.m_data[nw - 1];
+    dst.m_data[nw - 1] = w;
+    z |= z_bits(w) & m.get_mask();
+    return z == 0;
+}
+
+bool tbv_manager::is_well_formed(tbv const& dst) const {
+    unsigned nw = m.num_words();
+    if (nw == 0) return true;
+    unsigned z = 0;
+    for (unsigned i = 0; i + 1 < nw; ++i) 
+        z |= z_bits(dst.m_data[i]);
+    z |= z_bits(dst.m_data[nw - 1]) & m.get_mask();
+    return z == 0;
 }
 
 void tbv_manager::complement(tbv const& src, ptr_vector<tbv>& result) {
     tbv* r;
-    unsigned n = num_tbits();
-    for (unsigned i = 0; i < n; ++i) {
-        switch (src.get(i)) {
-        case BIT_0:
-            r = allocate(src);
-            set(*r, i, BIT_1);
-            result.push_back(r);
-            break;
-        case BIT_1:
-            r = allocate(src);
-            set(*r, i, BIT_0);
-            result.push_back(r);
-            break;
-        default:
-            break;
+    unsigned nw = m.num_words();
+    for (unsigned j = 0; j < nw; ++j) {
+        // skip the BIT_x tbits a word at a time
+        unsigned nx = non_x_bits(src.m_data[j]);
+        if (j + 1 == nw) nx &= m.get_mask();
+        for (; nx != 0; nx &= nx - 1) {
+            unsigned i = (32 * j + get_num_1bits((nx & (0 - nx)) - 1)) / 2;
+            switch (src.get(i)) {
+            case BIT_0:
+                r = allocate(src);
+                set(*r, i, BIT_1);
+                result.push_back(r);
+                break;
+            case BIT_1:
+                r = allocate(src);
+                set(*r, i, BIT_0);
+                result.push_back(r);
+                break;
+            default:
+                break;
+            }
         }
     }
 }
@@ -268,11 +297,6 @@ bool tbv_manager::contains(tbv const& a, unsigned_vector const& colsa,
     return true;
 }
 
-bool tbv_manager::intersect(tbv const& a, tbv const& b, tbv& result) {
-    copy(result, a);
-    return set_and(result, b);
-}
-
 std::ostream& tbv_manager::display(std::ostream& out, tbv const& b, unsigned hi, unsigned lo) const {
     SASSERT(lo <= hi && hi < num_tbits());
     for (unsigned i = hi+1; i-- > lo; ) {
@@ -74,7 +74,7 @@ public:
     bool contains(tbv const& a, tbv const& b) const;
     bool contains(tbv const& a, unsigned_vector const& colsa,
                   tbv const& b, unsigned_vector const& colsb) const;
-    bool intersect(tbv const& a, tbv const& b, tbv& result);
+    bool intersect(tbv const& a, tbv const& b, tbv& result) const;
     std::ostream& display(std::ostream& out, tbv const& b) const;
     std::ostream& display(std::ostream& out, tbv const& b, unsigned hi, unsigned lo) const;
     tbv* project(bit_vector const& to_delete, tbv const& src);
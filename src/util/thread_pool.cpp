@@ -0,0 +1,193 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    thread_pool.cpp
+
+Abstract:
+
+    Process wide pool of threads shared by the parallel modes.
+
+    The tasks of a batch that are not yet claimed are kept in a queue of
+    open batches. Threads that finish a task take the next unclaimed task
+    of the oldest open batch before they go back to the idle list.
+
+--*/
+
+#include "util/thread_pool.h"
+#ifndef SINGLE_THREAD
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifndef _WINDOWS
+#include <pthread.h>
+#endif
+
+namespace {
+    struct pool_batch {
+        std::function<void(unsigned)> const& m_fn;
+        unsigned                m_size;
+        unsigned                m_next = 1;      // next task that is not claimed
+        unsigned                m_pending;       // tasks other than 0 that are not done
+        std::condition_variable m_done;
+        pool_batch(std::function<void(unsigned)> const& fn, unsigned n): m_fn(fn), m_size(n), m_pending(n - 1) {}
+    };
+
+    struct pool_worker {
+        std::thread             m_thread;
+        pool_batch*             m_batch = nullptr;
+        unsigned                m_index = 0;
+        std::condition_variable m_cv;
+    };
+}
+
+static std::mutex                 pool_mux;
+static std::vector<pool_worker*>  pool_workers;
+static std::vector<pool_worker*>  idle_workers;
+static std::deque<pool_batch*>    open_batches;
+static unsigned                   pool_max_threads = 0;
+static bool                       pool_exiting = false;
+
+static unsigned pool_capacity() {
+    if (pool_max_threads > 0)
+        return pool_max_threads;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// claim the next task of an open batch, pool_mux is held by caller.
+static bool claim_open_task(pool_batch*& b, unsigned& i) {
+    if (open_batches.empty())
+        return false;
+    b = open_batches.front();
+    i = b->m_next++;
+    if (b->m_next == b->m_size)
+        open_batches.pop_front();
+    return true;
+}
+
+// pool_mux is held by caller.
+static void task_done(pool_batch* b) {
+    // notify under the lock: the waiter owns the batch
+    if (--b->m_pending == 0)
+        b->m_done.notify_one();
+}
+
+static void worker_loop(pool_worker* w) {
+    std::unique_lock<std::mutex> lock(pool_mux);
+    while (true) {
+        w->m_cv.wait(lock, [&]() { return w->m_batch || pool_exiting; });
+        if (!w->m_batch)
+            return;
+        pool_batch* b = w->m_batch;
+        unsigned i = w->m_index;
+        do {
+            lock.unlock();
+            b->m_fn(i);
+            lock.lock();
+            task_done(b);
+        }
+        while (claim_open_task(b, i));
+        w->m_batch = nullptr;
+        idle_workers.push_back(w);
+    }
+}
+
+void thread_pool::run(unsigned n, std::function<void(unsigned)> const& fn) {
+    if (n == 0)
+        return;
+    pool_batch b(fn, n);
+    {
+        std::lock_guard<std::mutex> lock(pool_mux);
+        while (b.m_next < n) {
+            pool_worker* w;
+            if (!idle_workers.empty()) {
+                w = idle_workers.back();
+                idle_workers.pop_back();
+            }
+            else if (pool_workers.size() < pool_capacity()) {
+                w = new pool_worker;
+                pool_workers.push_back(w);
+                w->m_thread = std::thread(worker_loop, w);
+            }
+            else
+                break;
+            w->m_batch = &b;
+            w->m_index = b.m_next++;
+            w->m_cv.notify_one();
+        }
+        if (b.m_next < n)
+            open_batches.push_back(&b);
+    }
+    fn(0);
+    std::unique_lock<std::mutex> lock(pool_mux);
+    // run the tasks of the batch that no thread has claimed.
+    while (b.m_next < n) {
+        unsigned i = b.m_next++;
+        if (b.m_next == n)
+            open_batches.erase(std::find(open_batches.begin(), open_batches.end(), &b));
+        lock.unlock();
+        fn(i);
+        lock.lock();
+        --b.m_pending;
+    }
+    b.m_done.wait(lock, [&]() { return b.m_pending == 0; });
+}
+
+void thread_pool::set_max_threads(unsigned n) {
+    std::lock_guard<std::mutex> lock(pool_mux);
+    pool_max_threads = n;
+}
+
+unsigned thread_pool::max_threads() {
+    std::lock_guard<std::mutex> lock(pool_mux);
+    return pool_capacity();
+}
+
+void thread_pool::initialize() {
+#ifndef _WINDOWS
+    static bool pthread_atfork_set = false;
+    if (!pthread_atfork_set) {
+        pthread_atfork(finalize, nullptr, nullptr);
+        pthread_atfork_set = true;
+    }
+#endif
+}
+
+void thread_pool::finalize() {
+    std::vector<pool_worker*> workers;
+    {
+        std::lock_guard<std::mutex> lock(pool_mux);
+        pool_exiting = true;
+        for (pool_worker* w : pool_workers)
+            w->m_cv.notify_one();
+        workers.swap(pool_workers);
+    }
+    for (pool_worker* w : workers) {
+        w->m_thread.join();
+        delete w;
+    }
+    std::lock_guard<std::mutex> lock(pool_mux);
+    idle_workers.clear();
+    pool_exiting = false;
+}
+
+#else
+
+void thread_pool::run(unsigned n, std::function<void(unsigned)> const& fn) {
+    for (unsigned i = 0; i < n; ++i)
+        fn(i);
+}
+
+void thread_pool::set_max_threads(unsigned n) {}
+
+unsigned thread_pool::max_threads() { return 1; }
+
+void thread_pool::initialize() {}
+
+void thread_pool::finalize() {}
+
+#endif
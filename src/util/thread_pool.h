@@ -0,0 +1,52 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    thread_pool.h
+
+Abstract:
+
+    Process wide pool of threads shared by the parallel modes.
+
+    A batch of tasks runs on the calling thread and on the threads of the
+    pool. The pool holds at most max_threads() threads. Tasks of a batch
+    that find no thread are queued; they are taken by threads that become
+    idle and by the calling thread once it is done with its own task. A
+    batch therefore never waits for another batch to finish, and nested
+    batches, such as a parallel SAT check inside a branch of a parallel
+    tactical, run on the threads that are left instead of oversubscribing
+    the machine. When no thread is left, the tasks of a batch run one
+    after the other on the calling thread.
+
+    The tasks of a batch must not require each other to run concurrently
+    to make progress.
+
+--*/
+#pragma once
+
+#include <functional>
+
+class thread_pool {
+public:
+    /**
+       \brief run fn(0), ..., fn(n-1) and wait for all of them.
+       fn(0) runs on the calling thread. The tasks must not throw.
+    */
+    static void run(unsigned n, std::function<void(unsigned)> const& fn);
+
+    /**
+       \brief set the maximal number of threads of the pool.
+       0 stands for the number of hardware threads.
+    */
+    static void set_max_threads(unsigned n);
+    static unsigned max_threads();
+
+    static void initialize();
+    static void finalize();
+};
+
+/*
+  ADD_INITIALIZER('thread_pool::initialize();')
+  ADD_FINALIZER('thread_pool::finalize();')
+*/
@@ -0,0 +1,114 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    writeback_stream.cpp
+
+Abstract:
+
+    Output stream that writes to its target on a background thread.
+
+--*/
+
+#include "util/writeback_stream.h"
+
+writeback_streambuf::writeback_streambuf(std::ostream & out, unsigned block_size, unsigned max_blocks):
+    m_out(out),
+    m_block_size(block_size == 0 ? 1 : block_size),
+    m_max_blocks(max_blocks == 0 ? 1 : max_blocks) {
+    reset_put_area();
+#ifndef SINGLE_THREAD
+    m_writer = std::thread([this]() { write_loop(); });
+#endif
+}
+
+writeback_streambuf::~writeback_streambuf() {
+    sync();
+#ifndef SINGLE_THREAD
+    {
+        std::lock_guard<std::mutex> lock(m_mux);
+        m_cancel = true;
+    }
+    m_cv.notify_all();
+    m_writer.join();
+#endif
+}
+
+void writeback_streambuf::reset_put_area() {
+    m_curr.resize(m_block_size);
+    char * b = &m_curr[0];
+    setp(b, b + m_curr.size());
+}
+
+/**
+   \brief Hand the filled part of the put area to the writer and
+   start a new block.
+*/
+void writeback_streambuf::write_block() {
+    m_curr.resize(static_cast<size_t>(pptr() - pbase()));
+    if (m_curr.empty()) {
+        reset_put_area();
+        return;
+    }
+#ifndef SINGLE_THREAD
+    {
+        std::unique_lock<std::mutex> lock(m_mux);
+        m_cv.wait(lock, [&] { return m_full.size() < m_max_blocks; });
+        m_full.push_back(std::move(m_curr));
+        m_curr.clear();
+        if (!m_free.empty()) {
+            m_curr.swap(m_free.back());
+            m_free.pop_back();
+        }
+    }
+    m_cv.notify_all();
+#else
+    m_out.write(m_curr.data(), m_curr.size());
+#endif
+    reset_put_area();
+}
+
+void writeback_streambuf::write_loop() {
+#ifndef SINGLE_THREAD
+    while (true) {
+        std::string blk;
+        {
+            std::unique_lock<std::mutex> lock(m_mux);
+            m_cv.wait(lock, [&] { return m_cancel || !m_full.empty(); });
+            if (m_full.empty())
+                return;
+            blk = std::move(m_full.front());
+            m_full.pop_front();
+            m_writing = true;
+        }
+        m_out.write(blk.data(), blk.size());
+        {
+            std::lock_guard<std::mutex> lock(m_mux);
+            m_writing = false;
+            blk.clear();
+            m_free.push_back(std::move(blk));
+        }
+        m_cv.notify_all();
+    }
+#endif
+}
+
+writeback_streambuf::int_type writeback_streambuf::overflow(int_type ch) {
+    write_block();
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+        return traits_type::not_eof(ch);
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+int writeback_streambuf::sync() {
+    write_block();
+#ifndef SINGLE_THREAD
+    std::unique_lock<std::mutex> lock(m_mux);
+    m_cv.wait(lock, [&] { return m_full.empty() && !m_writing; });
+#endif
+    m_out.flush();
+    return m_out.good() ? 0 : -1;
+}
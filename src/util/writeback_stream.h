@@ -0,0 +1,69 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    writeback_stream.h
+
+Abstract:
+
+    Output stream that writes to its target on a background thread.
+
+    Output is collected in blocks. Full blocks are queued and written to
+    the target stream by a writer thread, so the producer does not wait
+    for the file system. At most max_blocks blocks are queued; a producer
+    that gets ahead of the writer by more waits for it. Flushing the
+    stream waits until all output was written and the target is flushed.
+    When compiled with SINGLE_THREAD, blocks are written synchronously.
+
+--*/
+#pragma once
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <deque>
+#include <vector>
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+class writeback_streambuf : public std::streambuf {
+    std::ostream &           m_out;
+    unsigned                 m_block_size;
+    unsigned                 m_max_blocks;
+    std::deque<std::string>  m_full;  // blocks to be written, in output order
+    std::vector<std::string> m_free;  // written blocks, recycled by the producer
+    std::string              m_curr;  // block exposed through the put area
+#ifndef SINGLE_THREAD
+    bool                     m_cancel = false;
+    bool                     m_writing = false;
+    std::mutex               m_mux;
+    std::condition_variable  m_cv;
+    std::thread              m_writer;
+#endif
+
+    void reset_put_area();
+    void write_block();
+    void write_loop();
+
+protected:
+    int_type overflow(int_type ch) override;
+    int sync() override;
+
+public:
+    writeback_streambuf(std::ostream & out, unsigned block_size = 1 << 20, unsigned max_blocks = 4);
+    ~writeback_streambuf() override;
+};
+
+class writeback_ostream : public std::ostream {
+    writeback_streambuf m_buf;
+public:
+    writeback_ostream(std::ostream & out, unsigned block_size = 1 << 20, unsigned max_blocks = 4):
+        std::ostream(nullptr),
+        m_buf(out, block_size, max_blocks) {
+        rdbuf(&m_buf);
+    }
+};
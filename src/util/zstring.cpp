@@ -71,17 +71,92 @@ bool zstring::is_escape_char(char const *& s, unsigned& result) {
     return false;
 }
 
+zstring::rep* zstring::mk_rep(unsigned sz, bool wide) {
+    void* mem = memory::allocate(sizeof(rep) + sz * (wide ? sizeof(uint32_t) : sizeof(uint8_t)));
+    rep* r = static_cast<rep*>(mem);
+    new (&r->m_ref) atomic<unsigned>(1);
+    r->m_size = sz;
+    r->m_wide = wide;
+    return r;
+}
+
+void zstring::init(unsigned sz, uint32_t const* s) {
+    SASSERT(!m_rep);
+    m_offset = 0;
+    m_length = sz;
+    if (sz == 0)
+        return;
+    bool wide = false;
+    for (unsigned i = 0; !wide && i < sz; ++i)
+        wide = s[i] > 255;
+    m_rep = mk_rep(sz, wide);
+    if (wide)
+        memcpy(m_rep->wide(), s, sz * sizeof(uint32_t));
+    else
+        for (unsigned i = 0; i < sz; ++i)
+            m_rep->narrow()[i] = static_cast<uint8_t>(s[i]);
+}
+
+void zstring::copy_to(rep* r, unsigned offset) const {
+    if (m_length == 0)
+        return;
+    if (r->m_wide && m_rep->m_wide)
+        memcpy(r->wide() + offset, m_rep->wide() + m_offset, m_length * sizeof(uint32_t));
+    else if (!r->m_wide && !m_rep->m_wide)
+        memcpy(r->narrow() + offset, m_rep->narrow() + m_offset, m_length);
+    else if (r->m_wide)
+        for (unsigned i = 0; i < m_length; ++i)
+            r->wide()[offset + i] = (*this)[i];
+    else
+        for (unsigned i = 0; i < m_length; ++i)
+            r->narrow()[offset + i] = static_cast<uint8_t>((*this)[i]);
+}
+
+void zstring::dec_ref() {
+    if (m_rep && --m_rep->m_ref == 0) {
+        m_rep->m_ref.~atomic<unsigned>();
+        memory::deallocate(m_rep);
+    }
+    m_rep = nullptr;
+}
+
+zstring& zstring::operator=(zstring const& other) {
+    if (this != &other) {
+        if (other.m_rep)
+            ++other.m_rep->m_ref;
+        dec_ref();
+        m_rep = other.m_rep;
+        m_offset = other.m_offset;
+        m_length = other.m_length;
+    }
+    return *this;
+}
+
+zstring& zstring::operator=(zstring&& other) noexcept {
+    if (this != &other) {
+        dec_ref();
+        m_rep = other.m_rep;
+        m_offset = other.m_offset;
+        m_length = other.m_length;
+        other.m_rep = nullptr;
+        other.m_length = 0;
+    }
+    return *this;
+}
+
 zstring::zstring(char const* s) {
+    buffer<uint32_t> chars;
     while (*s) {
         unsigned ch = 0;
         if (is_escape_char(s, ch)) {
-            m_buffer.push_back(ch);
+            chars.push_back(ch);
         }
         else {
-            m_buffer.push_back(*s);
+            chars.push_back(*s);
             ++s;
         }
     }
+    init(chars.size(), chars.data());
     SASSERT(well_formed());
 }
 
@@ -96,7 +171,8 @@ string_encoding zstring::get_encoding() {
 }
 
 bool zstring::well_formed() const {
-    for (unsigned ch : m_buffer) {
+    for (unsigned i = 0; i < length(); ++i) {
+        unsigned ch = (*this)[i];
         if (ch > max_char()) {
             IF_VERBOSE(0, verbose_stream() << "large character: " << ch << "\n";);
             return false;
@@ -105,20 +181,16 @@ bool zstring::well_formed() const {
     return true;
 }
 
-zstring::zstring(unsigned ch) {
-    m_buffer.push_back(ch);
-}
-
 zstring zstring::reverse() const {
-    zstring result;
+    buffer<uint32_t> result;
     for (unsigned i = length(); i-- > 0; ) {
-        result.m_buffer.push_back(m_buffer[i]);
+        result.push_back((*this)[i]);
     }
-    return result;
+    return zstring(result.size(), result.data());
 }
 
 zstring zstring::replace(zstring const& src, zstring const& dst) const {
-    zstring result;
+    buffer<uint32_t> result;
     if (length() < src.length()) {
         return zstring(*this);
     }
@@ -129,18 +201,19 @@ zstring zstring::replace(zstring const& src, zstring const& dst) const {
     for (unsigned i = 0; i < length(); ++i) {
         bool eq = !found && i + src.length() <= length();
         for (unsigned j = 0; eq && j < src.length(); ++j) {
-            eq = m_buffer[i+j] == src[j];
+            eq = (*this)[i+j] == src[j];
         }
         if (eq) {
-            result.m_buffer.append(dst.m_buffer);
+            for (unsigned j = 0; j < dst.length(); ++j)
+                result.push_back(dst[j]);
             found = true;
             i += src.length() - 1;
         }
         else {
-            result.m_buffer.push_back(m_buffer[i]);
+            result.push_back((*this)[i]);
         }
     }
-    return result;
+    return zstring(result.size(), result.data());
 }
 
 std::string zstring::encode() const {
@@ -148,9 +221,9 @@ std::string zstring::encode() const {
     char buffer[100];
     unsigned offset = 0;
 #define _flush() if (offset > 0) { buffer[offset] = 0; strm << buffer; offset = 0; }
-    for (unsigned i = 0; i < m_buffer.size(); ++i) {
-        unsigned ch = m_buffer[i];
-        if (ch < 32 || ch >= 128 || ('\\' == ch && i + 1 < m_buffer.size() && 'u' == m_buffer[i+1])) {
+    for (unsigned i = 0; i < length(); ++i) {
+        unsigned ch = (*this)[i];
+        if (ch < 32 || ch >= 128 || ('\\' == ch && i + 1 < length() && 'u' == (*this)[i+1])) {
             _flush();
             strm << "\\u{" << std::hex << ch << std::dec << "}";
         }
@@ -168,7 +241,7 @@ bool zstring::suffixof(zstring const& other) const {
     if (length() > other.length()) return false;
     bool suffix = true;
     for (unsigned i = 0; suffix && i < length(); ++i) {
-        suffix = m_buffer[length()-i-1] == other[other.length()-i-1];
+        suffix = (*this)[length()-i-1] == other[other.length()-i-1];
     }
     return suffix;
 }
@@ -177,7 +250,7 @@ bool zstring::prefixof(zstring const& other) const {
     if (length() > other.length()) return false;
     bool prefix = true;
     for (unsigned i = 0; prefix && i < length(); ++i) {
-        prefix = m_buffer[i] == other[i];
+        prefix = (*this)[i] == other[i];
     }
     return prefix;
 }
@@ -189,7 +262,7 @@ bool zstring::contains(zstring const& other) const {
     for (unsigned i = 0; !cont && i <= last; ++i) {
         cont = true;
         for (unsigned j = 0; cont && j < other.length(); ++j) {
-            cont = other[j] == m_buffer[j+i];
+            cont = other[j] == (*this)[j+i];
         }
     }
     return cont;
@@ -204,7 +277,7 @@ int zstring::indexofu(zstring const& other, unsigned offset) const {
     for (unsigned i = offset; i <= last; ++i) {
         bool prefix = true;
         for (unsigned j = 0; prefix && j < other.length(); ++j) {
-            prefix = m_buffer[i + j] == other[j];
+            prefix = (*this)[i + j] == other[j];
         }
         if (prefix) {
             return static_cast<int>(i);
@@ -219,7 +292,7 @@ int zstring::last_indexof(zstring const& other) const {
     for (unsigned last = length() - other.length() + 1; last-- > 0; ) {
         bool suffix = true;
         for (unsigned j = 0; suffix && j < other.length(); ++j) {
-            suffix = m_buffer[last + j] == other[j];
+            suffix = (*this)[last + j] == other[j];
         }
         if (suffix) {
             return static_cast<int>(last);
@@ -228,23 +301,40 @@ int zstring::last_indexof(zstring const& other) const {
     return -1;
 }
 
+/**
+   \brief the substring shares the characters of this string.
+*/
 zstring zstring::extract(unsigned offset, unsigned len) const {
     zstring result;
     if (offset + len < offset) return result;
-    int last = std::min(offset+len, length());
-    for (int i = offset; i < last; ++i) {
-        result.m_buffer.push_back(m_buffer[i]);
-    }
+    unsigned last = std::min(offset+len, length());
+    if (offset >= last) return result;
+    result.m_rep = m_rep;
+    result.inc_ref();
+    result.m_offset = m_offset + offset;
+    result.m_length = last - offset;
     return result;
 }
 
 unsigned zstring::hash() const {
-    return unsigned_ptr_hash(m_buffer.data(), m_buffer.size(), 23);
+    if (m_length > 0 && m_rep->m_wide)
+        return unsigned_ptr_hash(m_rep->wide() + m_offset, m_length, 23);
+    buffer<uint32_t> chars;
+    for (unsigned i = 0; i < length(); ++i)
+        chars.push_back((*this)[i]);
+    return unsigned_ptr_hash(chars.data(), chars.size(), 23);
 }
 
 zstring zstring::operator+(zstring const& other) const {
-    zstring result(*this);
-    result.m_buffer.append(other.m_buffer);
+    if (other.empty())
+        return *this;
+    if (empty())
+        return other;
+    zstring result;
+    result.m_rep = mk_rep(length() + other.length(), m_rep->m_wide || other.m_rep->m_wide);
+    result.m_length = length() + other.length();
+    copy_to(result.m_rep, 0);
+    other.copy_to(result.m_rep, length());
     return result;
 }
 
@@ -254,8 +344,14 @@ bool zstring::operator==(const zstring& other) const {
     if (length() != other.length()) {
         return false;
     }
+    if (length() == 0 || (m_rep == other.m_rep && m_offset == other.m_offset)) {
+        return true;
+    }
+    if (!m_rep->m_wide && !other.m_rep->m_wide) {
+        return memcmp(m_rep->narrow() + m_offset, other.m_rep->narrow() + other.m_offset, length()) == 0;
+    }
     for (unsigned i = 0; i < length(); ++i) {
-        if (m_buffer[i] != other[i]) {
+        if ((*this)[i] != other[i]) {
             return false;
         }
     }
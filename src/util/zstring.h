@@ -7,7 +7,8 @@ Module Name:
 
 Abstract:
 
-    String wrapper for unicode/ascii internal strings as vectors
+    String wrapper for unicode/ascii internal strings as vectors.
+    Copies and substrings share the characters of the string.
 
 Author:
 
@@ -20,6 +21,7 @@ Author:
 #include <string>
 #include "util/buffer.h"
 #include "util/rational.h"
+#include "util/mutex.h"
 
 enum class string_encoding {
   ascii, // exactly 8 bits
@@ -29,7 +31,27 @@ enum class string_encoding {
 
 class zstring {
 private:
-    buffer<uint32_t> m_buffer;
+    // the characters are kept in a reference counted buffer that is shared
+    // by copies and substrings. Buffers whose characters are all below 256
+    // use one byte per character.
+    struct rep {
+        atomic<unsigned> m_ref;
+        unsigned         m_size;
+        bool             m_wide;
+        uint8_t const*  narrow() const { return reinterpret_cast<uint8_t const*>(this + 1); }
+        uint32_t const* wide() const { return reinterpret_cast<uint32_t const*>(this + 1); }
+        uint8_t*  narrow() { return reinterpret_cast<uint8_t*>(this + 1); }
+        uint32_t* wide() { return reinterpret_cast<uint32_t*>(this + 1); }
+    };
+    rep*     m_rep = nullptr;
+    unsigned m_offset = 0;
+    unsigned m_length = 0;
+
+    static rep* mk_rep(unsigned sz, bool wide);
+    void init(unsigned sz, uint32_t const* s);
+    void copy_to(rep* r, unsigned offset) const;
+    void inc_ref() { if (m_rep) ++m_rep->m_ref; }
+    void dec_ref();
     bool well_formed() const;
     bool is_escape_char(char const *& s, unsigned& result);
 public:
@@ -66,14 +88,22 @@ public:
     zstring(char const* s);
     zstring(const std::string &str) : zstring(str.c_str()) {}
     zstring(rational const& r): zstring(r.to_string()) {}
-    zstring(unsigned sz, unsigned const* s) { m_buffer.append(sz, s); SASSERT(well_formed()); }
-    zstring(unsigned ch);
+    zstring(unsigned sz, unsigned const* s) { init(sz, s); SASSERT(well_formed()); }
+    zstring(unsigned ch) { init(1, &ch); }
+    zstring(zstring const& other): m_rep(other.m_rep), m_offset(other.m_offset), m_length(other.m_length) { inc_ref(); }
+    zstring(zstring&& other) noexcept: m_rep(other.m_rep), m_offset(other.m_offset), m_length(other.m_length) { other.m_rep = nullptr; other.m_length = 0; }
+    ~zstring() { dec_ref(); }
+    zstring& operator=(zstring const& other);
+    zstring& operator=(zstring&& other) noexcept;
     zstring replace(zstring const& src, zstring const& dst) const;
     zstring reverse() const;
     std::string encode() const;
-    unsigned length() const { return m_buffer.size(); }
-    unsigned operator[](unsigned i) const { return m_buffer[i]; }
-    bool empty() const { return m_buffer.empty(); }
+    unsigned length() const { return m_length; }
+    unsigned operator[](unsigned i) const {
+        SASSERT(i < m_length);
+        return m_rep->m_wide ? m_rep->wide()[m_offset + i] : m_rep->narrow()[m_offset + i];
+    }
+    bool empty() const { return m_length == 0; }
     bool suffixof(zstring const& other) const;
     bool prefixof(zstring const& other) const;
     bool contains(zstring const& other) const;